@@ -0,0 +1,229 @@
+#pragma once
+#include "Exception/OException.h"
+#include "Time/OTimer.h"
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class PackArchive;
+
+// Loads assets in the background while the game runs. Requests wait in a
+// priority queue for one of the I/O threads, go on to a second queue for
+// the decode threads and end up ready for the render thread, which takes
+// them in Pump, one asset at a time and in priority order, until the bytes
+// per frame budget is used up; an asset larger than the budget goes alone
+// in a frame. Priorities can change at any point up to the upload, which
+// moves the request within whatever queue it is in, and Cancel drops it
+// there or, mid read or decode, as soon as that returns.
+// Each asset reserves what the sizer says it takes at most, read or
+// decoded, and its read only starts once that fits in the memory budget
+// next to everything read and not uploaded yet; an asset larger than the
+// whole budget is read alone. The budget holds as long as the sizer does
+// not under-report, a decode that grows past its reservation counts in
+// full and holds back further reads. All public functions are thread safe.
+class AssetStreamer
+{
+public:
+	class Exception : public OException
+	{
+	public:
+		Exception(int line, const char* file, std::string note) noexcept;
+		const char* what() const noexcept override;
+		const char* GetType() const noexcept override;
+		const std::string& GetNote() const noexcept;
+	private:
+		std::string note;
+	};
+	// 0 is never handed out
+	using Handle = uint64_t;
+	// lower goes first: everything visible before anything that is not,
+	// nearer before farther
+	struct Priority
+	{
+		bool visible = true;
+		float distance = 0.0f;
+		bool operator<(const Priority& other) const noexcept;
+	};
+	enum class State
+	{
+		Queued,
+		Reading,
+		Decoding,
+		Ready,
+		// uploaded, cancelled, failed or never requested
+		None,
+	};
+	struct Asset
+	{
+		Handle handle;
+		const std::string& name;
+		// what the decoder left, the uploader may move it out
+		std::vector<std::byte>& data;
+		// empty unless the read or decode failed
+		const std::string& error;
+	};
+	// called on the render thread from Pump, also for assets that failed
+	using Uploader = std::function<void(const Asset& asset)>;
+	// false if there is no such asset; runs on an I/O thread
+	using Reader = std::function<bool(const std::string& name, std::vector<std::byte>& data)>;
+	// turns the bytes read into what gets uploaded, in place; throws on
+	// bad data. Runs on a decode thread.
+	using Decoder = std::function<void(const std::string& name, std::vector<std::byte>& data)>;
+	// bytes the asset takes at most, read or decoded, 0 if it does not
+	// exist; runs in Request on the caller's thread
+	using Sizer = std::function<size_t(const std::string& name)>;
+	struct Config
+	{
+		// empty reads whole files
+		Reader reader;
+		// empty hands the bytes over as they were read
+		Decoder decoder;
+		// empty takes the file size, which only fits the default reader and
+		// decoders that do not grow the data; a custom reader needs one
+		Sizer sizer;
+		unsigned int ioThreads = 1u;
+		// 0 for one per core beyond the I/O threads; none without a decoder
+		unsigned int decodeThreads = 0u;
+		size_t uploadBytesPerFrame = 4u << 20;
+		size_t memoryBudget = 64u << 20;
+	};
+	static constexpr size_t latencyWindow = 512u;
+	struct Stats
+	{
+		// queue depths
+		size_t queued = 0u;
+		size_t reading = 0u;
+		// waiting for a decode thread or in one
+		size_t decoding = 0u;
+		size_t ready = 0u;
+		// reserved for reads in flight, read or decoded, not uploaded yet
+		size_t residentBytes = 0u;
+		// the most residentBytes has been since the start
+		size_t peakResidentBytes = 0u;
+		// every request ends in one of uploads, cancels and failures
+		uint64_t requests = 0u;
+		uint64_t uploads = 0u;
+		uint64_t cancels = 0u;
+		uint64_t failures = 0u;
+		uint64_t bytesUploaded = 0u;
+		// the last Pump
+		size_t frameUploads = 0u;
+		size_t frameBytes = 0u;
+		// request to upload over the last latencyWindow uploads
+		size_t latencyCount = 0u;
+		float p50Ms = 0.0f;
+		float p95Ms = 0.0f;
+		float p99Ms = 0.0f;
+		float maxMs = 0.0f;
+	};
+public:
+	// reads files on one thread, nothing to decode
+	AssetStreamer();
+	explicit AssetStreamer(Config config);
+	// stops the threads, whatever has not been uploaded is dropped
+	~AssetStreamer();
+	AssetStreamer(const AssetStreamer&) = delete;
+	AssetStreamer& operator=(const AssetStreamer&) = delete;
+	Handle Request(std::string name, Priority priority, Uploader upload);
+	// false once the asset is past Pump or cancelled
+	bool SetPriority(Handle handle, Priority priority);
+	// false once the asset is past Pump or cancelled
+	bool Cancel(Handle handle);
+	State GetState(Handle handle) const;
+	// on the render thread once a frame, returns the assets uploaded
+	size_t Pump();
+	// percentiles are computed here, call it at overlay rate
+	Stats GetStats() const;
+	// reads a pack entry by name instead of a file, the archive has to outlive the streamer
+	static Reader MakePackReader(const PackArchive& archive);
+	// unpacked size of a pack entry, for decoders that do not grow it
+	static Sizer MakePackSizer(const PackArchive& archive);
+	static bool ReadFile(const std::string& path, std::vector<std::byte>& data);
+	static size_t GetFileSize(const std::string& path);
+private:
+	struct Item
+	{
+		std::string name;
+		Priority priority;
+		State state;
+		// moves in the queues leave stale entries behind, only those with
+		// the current version count
+		uint32_t version;
+		// an I/O or decode thread has it
+		bool busy;
+		bool cancelled;
+		OTimer::Ticks requested;
+		// what the sizer said, taken from the budget when the read starts
+		size_t reserved;
+		// counted in residentBytes, the larger of reserved and the data
+		size_t resident;
+		Uploader upload;
+		std::vector<std::byte> data;
+		std::string error;
+	};
+	struct Entry
+	{
+		Priority priority;
+		uint64_t sequence;
+		Handle handle;
+		uint32_t version;
+	};
+	// binary heap of entries, the best on top
+	class Queue
+	{
+	public:
+		void Push(const Entry& entry);
+		const Entry& Top() const noexcept;
+		void Pop();
+		bool IsEmpty() const noexcept;
+		size_t GetSize() const noexcept;
+		// drops the entries pred says are stale
+		template<typename F>
+		void Compact(F&& pred);
+	private:
+		static bool After(const Entry& a, const Entry& b) noexcept;
+	private:
+		std::vector<Entry> entries;
+	};
+private:
+	void Stop() noexcept;
+	void IoLoop() noexcept;
+	void DecodeLoop() noexcept;
+	// pops stale entries, false if none that count are left
+	bool Peek(Queue& queue, State state);
+	void Push(Queue& queue, Handle handle, Item& item);
+	Queue& QueueOf(State state) noexcept;
+	void SetState(Item& item, State state) noexcept;
+	// the top of the I/O queue fits in the memory budget
+	bool CanRead() const;
+	void SetResident(Item& item, size_t bytes) noexcept;
+	// back from a read or decode, on to the next queue
+	void Finish(Handle handle, Item& item, std::string error);
+	void Drop(std::unordered_map<Handle, Item>::iterator it) noexcept;
+private:
+	Config config;
+	mutable std::mutex mtx;
+	std::condition_variable cvIo;
+	std::condition_variable cvDecode;
+	std::vector<std::thread> threads;
+	bool stopping = false;
+	Handle nextHandle = 1u;
+	uint64_t sequence = 0u;
+	std::unordered_map<Handle, Item> items;
+	Queue ioQueue;
+	Queue decodeQueue;
+	Queue readyQueue;
+	// items in each State but None
+	std::array<size_t, 4> depths = {};
+	std::array<float, latencyWindow> latencies = {};
+	size_t latencyNext = 0u;
+	size_t latencyCount = 0u;
+	Stats stats;
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+
+// LZ4 block format, compatible with the reference implementation's
+// LZ4_compress_default/LZ4_decompress_safe: greedy matching through a hash
+// of 4-byte sequences, a 64KB window, no entropy stage. Decompression checks
+// every length and offset against both buffers, so damaged input fails
+// instead of reading or writing out of bounds.
+namespace Lz4
+{
+	// worst case output size for size input bytes
+	constexpr size_t CompressBound(size_t size) noexcept
+	{
+		return size + size / 255u + 16u;
+	}
+	// bytes written, 0 if capacity is too small
+	size_t Compress(const std::byte* pSource, size_t size, std::byte* pDestination, size_t capacity) noexcept;
+	// true when the input decodes to exactly size bytes
+	bool Decompress(const std::byte* pSource, size_t sourceSize, std::byte* pDestination, size_t size) noexcept;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only view of a whole file through the OS page cache: CreateFileMapping
+// on Windows, mmap elsewhere. Pages are read on first touch, so opening is
+// cheap no matter the size.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	// false if the file cannot be opened or mapped
+	bool Open(const std::string& path);
+	void Close() noexcept;
+	bool IsOpen() const noexcept;
+	// null for an empty file
+	const std::byte* GetData() const noexcept;
+	size_t GetSize() const noexcept;
+private:
+	const std::byte* pData = nullptr;
+	size_t size = 0u;
+	bool open = false;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include "Asset/MappedFile.h"
+#include "Asset/PackFormat.h"
+#include "Exception/OException.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Reader for archives written by PackWriter. The file is memory mapped and
+// the table of contents used where it lies, so opening costs a few page
+// faults and one hash over the table; entries that were stored without
+// compression are handed out as views into the mapping. Thread safe, the
+// archive is never written after the constructor.
+class PackArchive
+{
+public:
+	class Exception : public OException
+	{
+	public:
+		Exception(int line, const char* file, std::string note) noexcept;
+		const char* what() const noexcept override;
+		const char* GetType() const noexcept override;
+		const std::string& GetNote() const noexcept;
+	private:
+		std::string note;
+	};
+	struct Entry
+	{
+		std::string_view name;
+		uint64_t size;
+		uint64_t storedSize;
+		Pack::Compression compression;
+	};
+	static constexpr size_t npos = size_t(-1);
+public:
+	// throws if the file is missing, truncated or not an archive
+	explicit PackArchive(const std::string& path);
+	// over memory the caller keeps alive and unchanged
+	PackArchive(const std::byte* pData, size_t size);
+	size_t GetEntryCount() const noexcept;
+	Entry GetEntry(size_t index) const noexcept;
+	// index of the named entry, npos if there is none
+	size_t Find(std::string_view name) const noexcept;
+	// the stored bytes can be used as they are
+	bool IsDirect(size_t index) const noexcept;
+	// the entry's bytes: a view into the archive for direct entries,
+	// otherwise decompressed into scratch. Throws on damaged data.
+	std::span<const std::byte> Read(size_t index, std::vector<std::byte>& scratch) const;
+	// into memory of exactly GetEntry(index).size bytes
+	void ReadInto(size_t index, std::span<std::byte> destination) const;
+	// compares the data against the content hash written by the packer
+	bool Verify(size_t index) const;
+private:
+	void Validate();
+	const Pack::TocEntry& GetToc(size_t index) const noexcept;
+private:
+	MappedFile file;
+	const std::byte* pData = nullptr;
+	size_t size = 0u;
+	const Pack::Header* pHeader = nullptr;
+	const Pack::TocEntry* pToc = nullptr;
+	const char* pNames = nullptr;
+};
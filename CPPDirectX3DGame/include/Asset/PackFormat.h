@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// On-disk layout of a .pak archive, little endian throughout:
+//   Header            64 bytes at offset 0
+//   TocEntry[count]   64 bytes each, right after the header, sorted by nameHash
+//   names             UTF-8, not terminated, referenced by the entries
+//   entry data        each at a multiple of the header's alignment
+// Stored entries can be used in place from a mapping of the file.
+namespace Pack
+{
+	constexpr char magic[4] = { 'O', 'P', 'A', 'K' };
+	constexpr uint32_t version = 1u;
+
+	enum class Compression : uint32_t
+	{
+		None,
+		Lz4,
+	};
+
+	struct Header
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t entryCount;
+		// of every entry's data, a power of two
+		uint32_t alignment;
+		uint64_t namesOffset;
+		uint64_t namesSize;
+		uint64_t fileSize;
+		// ContentHash of the entries and names, checked on open
+		uint64_t tocHash;
+		uint64_t reserved[2];
+	};
+	static_assert(sizeof(Header) == 64u);
+
+	struct TocEntry
+	{
+		uint64_t nameHash;
+		uint32_t nameOffset;
+		uint32_t nameSize;
+		uint64_t offset;
+		// bytes in the archive, size when not compressed
+		uint64_t storedSize;
+		uint64_t size;
+		// ContentHash of the uncompressed data
+		uint64_t hashHi;
+		uint64_t hashLo;
+		Compression compression;
+		uint32_t reserved;
+	};
+	static_assert(sizeof(TocEntry) == 64u);
+
+	// FNV-1a, names are compared in full after a hash match
+	constexpr uint64_t HashName(std::string_view name) noexcept
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (const char c : name)
+		{
+			hash ^= uint64_t(uint8_t(c));
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+}
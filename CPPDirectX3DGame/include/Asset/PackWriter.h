@@ -0,0 +1,54 @@
+#pragma once
+#include "Asset/PackFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Builds .pak archives, see PackFormat.h for the layout. Entries are added
+// under names that use '/' as separator; each one is compressed with LZ4
+// unless it asks not to be or compression does not save enough.
+class PackWriter
+{
+public:
+	struct Options
+	{
+		// of each entry's data in the file, a power of two
+		uint32_t alignment = 16u;
+		bool compress = true;
+		// compressed data is kept only below this fraction of the original
+		float maxRatio = 0.9f;
+	};
+	struct Stats
+	{
+		size_t entries = 0u;
+		size_t compressed = 0u;
+		uint64_t bytes = 0u;
+		uint64_t storedBytes = 0u;
+		uint64_t fileSize = 0u;
+	};
+public:
+	PackWriter() = default;
+	explicit PackWriter(Options options);
+	// throws PackArchive::Exception if the name is taken
+	void Add(std::string name, std::vector<std::byte> data, bool compress = true);
+	// throws PackArchive::Exception if the file cannot be read
+	void AddFile(std::string name, const std::string& path, bool compress = true);
+	size_t GetEntryCount() const noexcept;
+	// the whole archive in memory
+	std::vector<std::byte> Build(Stats* pStats = nullptr) const;
+	// throws PackArchive::Exception if the file cannot be written
+	Stats Write(const std::string& path) const;
+private:
+	struct Pending
+	{
+		std::string name;
+		std::vector<std::byte> data;
+		bool compress;
+	};
+private:
+	Options options;
+	std::vector<Pending> pending;
+	std::unordered_set<std::string> names;
+};
@@ -0,0 +1,99 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Minimal benchmark harness for the Benchmark project. Benchmarks register
+// themselves with O_BENCHMARK, the runner picks an iteration count that
+// fills the minimum run time and reports the median over a few repetitions.
+// Results are written as JSON and can be compared against a stored baseline.
+namespace Bench
+{
+	class State
+	{
+	public:
+		State(uint64_t iterations) noexcept;
+		uint64_t GetIterations() const noexcept;
+		// excludes everything before the call, for setup inside the benchmark
+		void ResetTimer() noexcept;
+		void PauseTiming() noexcept;
+		void ResumeTiming() noexcept;
+		// reported time is divided by iterations * items
+		void SetItemsPerIteration(uint64_t items) noexcept;
+		uint64_t GetItemsPerIteration() const noexcept;
+		double GetElapsedSeconds() const noexcept;
+	private:
+		using Clock = std::chrono::steady_clock;
+		uint64_t iterations;
+		uint64_t itemsPerIteration = 1u;
+		Clock::time_point start;
+		Clock::duration elapsed = Clock::duration::zero();
+		bool running = true;
+	};
+
+	using Function = void(*)(State& state);
+
+	struct Result
+	{
+		std::string name;
+		uint64_t iterations = 0u;
+		unsigned int repetitions = 0u;
+		// per iteration (or per item), median over the repetitions
+		double nsPerOp = 0.0;
+		double minNsPerOp = 0.0;
+		double maxNsPerOp = 0.0;
+	};
+
+	struct Options
+	{
+		// substring match on the benchmark name, empty runs everything
+		std::string filter;
+		double minSeconds = 0.1;
+		unsigned int repetitions = 5u;
+	};
+
+	struct Comparison
+	{
+		std::string name;
+		double baselineNs = 0.0;
+		double currentNs = 0.0;
+		// positive means slower than the baseline
+		double deltaPercent = 0.0;
+		bool regressed = false;
+	};
+
+	bool Register(const char* name, Function function);
+	std::vector<std::string> GetNames();
+	std::vector<Result> Run(const Options& options);
+	void WriteJson(std::ostream& out, const std::vector<Result>& results);
+	// reads the format written by WriteJson, throws std::runtime_error when unreadable
+	std::vector<Result> ReadJson(const std::string& path);
+	// benchmarks missing from either side are skipped
+	std::vector<Comparison> Compare(const std::vector<Result>& baseline, const std::vector<Result>& current, double thresholdPercent);
+
+	// keeps the compiler from removing a computation whose result is unused
+	template<typename T>
+	inline void DoNotOptimize(const T& value) noexcept
+	{
+#if defined(_MSC_VER)
+		static const void* volatile sink;
+		sink = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+}
+
+#define O_BENCH_CONCAT_(a, b) a##b
+#define O_BENCH_CONCAT(a, b) O_BENCH_CONCAT_(a, b)
+#define O_BENCHMARK(name, function) \
+	static const bool O_BENCH_CONCAT(benchRegistered, __LINE__) = Bench::Register(name, function)
+// for benchmarks registered from code, e.g. one per variant
+#define O_BENCHMARK_REGISTER(expression) \
+	static const bool O_BENCH_CONCAT(benchRegistered, __LINE__) = (expression)
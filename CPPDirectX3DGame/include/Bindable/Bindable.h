@@ -0,0 +1,13 @@
+#pragma once
+#include "Render/GraphicsResource.h"
+
+namespace Bind
+{
+	class Bindable : public GraphicsResource
+	{
+	public:
+		// only while gfx has a device, D3D11RenderContext checks before replaying
+		virtual void Bind(Graphics& gfx) noexcept = 0;
+		virtual ~Bindable() = default;
+	};
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Bind
+{
+	// Global cache of bindables. Each type exposes a static GenerateKey taking the
+	// same arguments as its constructor; identical descriptors resolve to one
+	// shared instance, so every distinct D3D state object is created only once.
+	class Codex
+	{
+	public:
+		struct Stats
+		{
+			size_t lookups = 0u;
+			size_t hits = 0u;
+			size_t created = 0u;
+			float HitRate() const noexcept
+			{
+				return lookups > 0u ? float(hits) / float(lookups) : 0.0f;
+			}
+		};
+	public:
+		template<class T, typename...Params>
+		static std::shared_ptr<T> Resolve(Graphics& gfx, Params&&...p)
+		{
+			static_assert(std::is_base_of<Bindable, T>::value, "Can only resolve classes derived from Bindable");
+			return Get().Resolve_<T>(gfx, std::forward<Params>(p)...);
+		}
+		// totals over all bindable types
+		static Stats GetStats() noexcept;
+		// per bindable type, keyed by type name
+		static std::vector<std::pair<std::string, Stats>> GetTypeStats();
+		static size_t GetSize() noexcept;
+		static void ResetStats() noexcept;
+		// drop all cached bindables, e.g. before recreating the device
+		static void Clear() noexcept;
+	private:
+		template<class T, typename...Params>
+		std::shared_ptr<T> Resolve_(Graphics& gfx, Params&&...p)
+		{
+			const auto key = T::GenerateKey(std::as_const(p)...);
+			std::lock_guard<std::mutex> lock(mtx);
+			Stats& typeStats = stats[std::type_index(typeid(T))];
+			typeStats.lookups++;
+			const auto i = binds.find(key);
+			if (i != binds.end())
+			{
+				typeStats.hits++;
+				return std::static_pointer_cast<T>(i->second);
+			}
+			auto bind = std::make_shared<T>(gfx, std::forward<Params>(p)...);
+			binds[key] = bind;
+			typeStats.created++;
+			return bind;
+		}
+		static Codex& Get();
+	private:
+		mutable std::mutex mtx;
+		std::unordered_map<std::string, std::shared_ptr<Bindable>> binds;
+		std::unordered_map<std::type_index, Stats> stats;
+	};
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include <string>
+
+namespace Bind
+{
+	class Blender : public Bindable
+	{
+	public:
+		Blender(Graphics& gfx, const D3D11_BLEND_DESC& desc);
+		void Bind(Graphics& gfx) noexcept override;
+		static std::string GenerateKey(const D3D11_BLEND_DESC& desc);
+		// opaque, or straight alpha blending on render target 0
+		static D3D11_BLEND_DESC DefaultDesc(bool blending) noexcept;
+	protected:
+		Microsoft::WRL::ComPtr<ID3D11BlendState> pBlender;
+	};
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include "Bindable/DescriptorKey.h"
+#include "Render/GraphicsThrowMacros.h"
+#include <string>
+#include <cstring>
+#include <typeinfo>
+
+namespace Bind
+{
+	template<typename C>
+	class ConstantBuffer : public Bindable
+	{
+	public:
+		void Update(Graphics& gfx, const C& consts)
+		{
+			INFOMAN(gfx);
+
+			D3D11_MAPPED_SUBRESOURCE msr;
+			GFX_THROW_INFO(GetContext(gfx)->Map(
+				pConstantBuffer.Get(), 0u,
+				D3D11_MAP_WRITE_DISCARD, 0u,
+				&msr
+			));
+			memcpy(msr.pData, &consts, sizeof(consts));
+			GetContext(gfx)->Unmap(pConstantBuffer.Get(), 0u);
+		}
+		ConstantBuffer(Graphics& gfx, const C& consts, UINT slot = 0u)
+			:
+			slot(slot)
+		{
+			INFOMAN(gfx);
+
+			D3D11_BUFFER_DESC cbd = Desc();
+			D3D11_SUBRESOURCE_DATA csd = {};
+			csd.pSysMem = &consts;
+			GFX_THROW_INFO(GetDevice(gfx)->CreateBuffer(&cbd, &csd, &pConstantBuffer));
+		}
+		ConstantBuffer(Graphics& gfx, UINT slot = 0u)
+			:
+			slot(slot)
+		{
+			INFOMAN(gfx);
+
+			D3D11_BUFFER_DESC cbd = Desc();
+			GFX_THROW_INFO(GetDevice(gfx)->CreateBuffer(&cbd, nullptr, &pConstantBuffer));
+		}
+	protected:
+		// shared per constant layout and slot, contents are updated per use
+		template<class B>
+		static std::string GenerateKey(UINT slot)
+		{
+			return DescriptorKey(typeid(B).name()).Add(slot).Release();
+		}
+	private:
+		static D3D11_BUFFER_DESC Desc() noexcept
+		{
+			static_assert(sizeof(C) % 16 == 0, "Constant buffer size must be a multiple of 16 bytes");
+			D3D11_BUFFER_DESC cbd = {};
+			cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+			cbd.Usage = D3D11_USAGE_DYNAMIC;
+			cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+			cbd.MiscFlags = 0u;
+			cbd.ByteWidth = sizeof(C);
+			cbd.StructureByteStride = 0u;
+			return cbd;
+		}
+	protected:
+		UINT slot;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
+	};
+
+	template<typename C>
+	class VertexConstantBuffer : public ConstantBuffer<C>
+	{
+		using ConstantBuffer<C>::pConstantBuffer;
+		using ConstantBuffer<C>::slot;
+		using Bindable::GetContext;
+	public:
+		using ConstantBuffer<C>::ConstantBuffer;
+		void Bind(Graphics& gfx) noexcept override
+		{
+			GetContext(gfx)->VSSetConstantBuffers(slot, 1u, pConstantBuffer.GetAddressOf());
+		}
+		static std::string GenerateKey(const C&, UINT slot = 0u)
+		{
+			return GenerateKey(slot);
+		}
+		static std::string GenerateKey(UINT slot = 0u)
+		{
+			return ConstantBuffer<C>::template GenerateKey<VertexConstantBuffer>(slot);
+		}
+	};
+
+	template<typename C>
+	class PixelConstantBuffer : public ConstantBuffer<C>
+	{
+		using ConstantBuffer<C>::pConstantBuffer;
+		using ConstantBuffer<C>::slot;
+		using Bindable::GetContext;
+	public:
+		using ConstantBuffer<C>::ConstantBuffer;
+		void Bind(Graphics& gfx) noexcept override
+		{
+			GetContext(gfx)->PSSetConstantBuffers(slot, 1u, pConstantBuffer.GetAddressOf());
+		}
+		static std::string GenerateKey(const C&, UINT slot = 0u)
+		{
+			return GenerateKey(slot);
+		}
+		static std::string GenerateKey(UINT slot = 0u)
+		{
+			return ConstantBuffer<C>::template GenerateKey<PixelConstantBuffer>(slot);
+		}
+	};
+}
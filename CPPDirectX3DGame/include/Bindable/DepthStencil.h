@@ -0,0 +1,20 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include <string>
+
+namespace Bind
+{
+	// depth/stencil state object (not the depth buffer itself)
+	class DepthStencil : public Bindable
+	{
+	public:
+		DepthStencil(Graphics& gfx, const D3D11_DEPTH_STENCIL_DESC& desc, UINT stencilRef = 0u);
+		void Bind(Graphics& gfx) noexcept override;
+		static std::string GenerateKey(const D3D11_DEPTH_STENCIL_DESC& desc, UINT stencilRef = 0u);
+		// depth test less-equal with writes, stencil off
+		static D3D11_DEPTH_STENCIL_DESC DefaultDesc() noexcept;
+	protected:
+		UINT stencilRef;
+		Microsoft::WRL::ComPtr<ID3D11DepthStencilState> pDepthStencil;
+	};
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <type_traits>
+
+namespace Bind
+{
+	// 64-bit FNV-1a, used to fold bulk payloads (vertex data, bytecode) into a key
+	uint64_t HashBytes(const void* pData, size_t size, uint64_t seed = 14695981039346656037ull) noexcept;
+
+	// Builds the codex key for a creation descriptor. Fields are appended one at
+	// a time so struct padding never ends up in the key, and the type name is
+	// the prefix so two bindable types can never share an entry.
+	class DescriptorKey
+	{
+	public:
+		explicit DescriptorKey(const char* typeName)
+			:
+			key(typeName)
+		{
+			key.push_back('#');
+		}
+		template<typename T>
+		DescriptorKey& Add(const T& field)
+		{
+			static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Add descriptor fields one scalar at a time");
+			key.append(reinterpret_cast<const char*>(&field), sizeof(T));
+			return *this;
+		}
+		DescriptorKey& Add(const std::string& text)
+		{
+			Add(uint64_t(text.size()));
+			key.append(text);
+			return *this;
+		}
+		DescriptorKey& Add(const char* text)
+		{
+			return Add(std::string(text ? text : ""));
+		}
+		DescriptorKey& AddBytes(const void* pData, size_t size)
+		{
+			Add(uint64_t(size));
+			return Add(HashBytes(pData, size));
+		}
+		std::string Release() noexcept
+		{
+			return std::move(key);
+		}
+	private:
+		std::string key;
+	};
+}
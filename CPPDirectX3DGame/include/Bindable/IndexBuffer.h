@@ -0,0 +1,19 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include <string>
+#include <vector>
+
+namespace Bind
+{
+	class IndexBuffer : public Bindable
+	{
+	public:
+		IndexBuffer(Graphics& gfx, const std::string& tag, const std::vector<unsigned short>& indices);
+		void Bind(Graphics& gfx) noexcept override;
+		UINT GetCount() const noexcept;
+		static std::string GenerateKey(const std::string& tag, const std::vector<unsigned short>& indices);
+	protected:
+		UINT count;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> pIndexBuffer;
+	};
+}
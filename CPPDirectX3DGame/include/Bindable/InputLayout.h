@@ -0,0 +1,17 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include <string>
+#include <vector>
+
+namespace Bind
+{
+	class InputLayout : public Bindable
+	{
+	public:
+		InputLayout(Graphics& gfx, const std::vector<D3D11_INPUT_ELEMENT_DESC>& layout, ID3DBlob* pVertexShaderBytecode);
+		void Bind(Graphics& gfx) noexcept override;
+		static std::string GenerateKey(const std::vector<D3D11_INPUT_ELEMENT_DESC>& layout, ID3DBlob* pVertexShaderBytecode);
+	protected:
+		Microsoft::WRL::ComPtr<ID3D11InputLayout> pInputLayout;
+	};
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include <string>
+
+namespace Bind
+{
+	// Dynamic vertex buffer holding per-instance data, rewritten every frame
+	// and bound as a second vertex stream. Grows to the largest frame seen.
+	class InstanceBuffer : public Bindable
+	{
+	public:
+		InstanceBuffer(Graphics& gfx, const std::string& tag, UINT stride, UINT capacity = 1024u, UINT slot = 1u);
+		// replaces the contents with count instances of stride bytes
+		void Update(Graphics& gfx, const void* pInstances, UINT count);
+		void Bind(Graphics& gfx) noexcept override;
+		UINT GetCapacity() const noexcept;
+		// one buffer per tag and layout, contents belong to whoever updates it
+		static std::string GenerateKey(const std::string& tag, UINT stride, UINT capacity = 1024u, UINT slot = 1u);
+	private:
+		void Create(Graphics& gfx, UINT newCapacity);
+	private:
+		UINT stride;
+		UINT capacity = 0u;
+		UINT slot;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> pInstanceBuffer;
+	};
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include <string>
+
+namespace Bind
+{
+	class Rasterizer : public Bindable
+	{
+	public:
+		Rasterizer(Graphics& gfx, const D3D11_RASTERIZER_DESC& desc);
+		void Bind(Graphics& gfx) noexcept override;
+		static std::string GenerateKey(const D3D11_RASTERIZER_DESC& desc);
+		// solid fill, back face culling unless two sided
+		static D3D11_RASTERIZER_DESC DefaultDesc(bool twoSided) noexcept;
+	protected:
+		Microsoft::WRL::ComPtr<ID3D11RasterizerState> pRasterizer;
+	};
+}
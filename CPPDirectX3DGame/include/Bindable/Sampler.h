@@ -0,0 +1,19 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include <string>
+
+namespace Bind
+{
+	class Sampler : public Bindable
+	{
+	public:
+		Sampler(Graphics& gfx, const D3D11_SAMPLER_DESC& desc, UINT slot = 0u);
+		void Bind(Graphics& gfx) noexcept override;
+		static std::string GenerateKey(const D3D11_SAMPLER_DESC& desc, UINT slot = 0u);
+		// trilinear wrap, the common case
+		static D3D11_SAMPLER_DESC DefaultDesc() noexcept;
+	protected:
+		UINT slot;
+		Microsoft::WRL::ComPtr<ID3D11SamplerState> pSampler;
+	};
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include <string>
+
+namespace Bind
+{
+	class Topology : public Bindable
+	{
+	public:
+		Topology(Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY type = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		void Bind(Graphics& gfx) noexcept override;
+		static std::string GenerateKey(D3D11_PRIMITIVE_TOPOLOGY type = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	protected:
+		D3D11_PRIMITIVE_TOPOLOGY type;
+	};
+}
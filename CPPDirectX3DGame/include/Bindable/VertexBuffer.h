@@ -0,0 +1,29 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include <string>
+#include <vector>
+
+namespace Bind
+{
+	class VertexBuffer : public Bindable
+	{
+	public:
+		template<class V>
+		VertexBuffer(Graphics& gfx, const std::string& tag, const std::vector<V>& vertices)
+			:
+			VertexBuffer(gfx, tag, vertices.data(), UINT(sizeof(V)), UINT(vertices.size()))
+		{
+		}
+		VertexBuffer(Graphics& gfx, const std::string& tag, const void* pVertices, UINT stride, UINT count);
+		void Bind(Graphics& gfx) noexcept override;
+		template<class V>
+		static std::string GenerateKey(const std::string& tag, const std::vector<V>& vertices)
+		{
+			return GenerateKey(tag, vertices.data(), UINT(sizeof(V)), UINT(vertices.size()));
+		}
+		static std::string GenerateKey(const std::string& tag, const void* pVertices, UINT stride, UINT count);
+	protected:
+		UINT stride;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> pVertexBuffer;
+	};
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "Bindable/Bindable.h"
+#include "Render/Shader/ShaderCache.h"
+#include <string>
+
+namespace Bind
+{
+	class VertexShader : public Bindable
+	{
+	public:
+		VertexShader(Graphics& gfx, const std::string& path);
+		// compiled from HLSL through the cache
+		VertexShader(Graphics& gfx, ShaderCache& cache, const ShaderDesc& desc);
+		void Bind(Graphics& gfx) noexcept override;
+		ID3DBlob* GetBytecode() const noexcept;
+		static std::string GenerateKey(const std::string& path);
+		// keyed by content, so an edited shader is a different bindable
+		static std::string GenerateKey(const ShaderCache& cache, const ShaderDesc& desc);
+	protected:
+		Microsoft::WRL::ComPtr<ID3DBlob> pBytecodeBlob;
+		Microsoft::WRL::ComPtr<ID3D11VertexShader> pVertexShader;
+	};
+}
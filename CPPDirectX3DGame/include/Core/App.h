@@ -1,18 +1,110 @@
 #pragma once
-#include "Window/Window.h"
+#include "Platform/Platform.h"
+#include "Asset/AssetStreamer.h"
+#include "Ecs/World.h"
+#include "Job/JobSystem.h"
+#include "Memory/AllocationCounter.h"
+#include "Memory/FrameArenas.h"
 #include "Time/OTimer.h"
+#include "Time/OClock.h"
+#include "Core/FrameSnapshot.h"
+#include "Core/StageTimings.h"
+#include "Core/TripleBuffer.h"
+#include "Profile/FrameStats.h"
+#include "Input/InputRecorder.h"
+#include "Input/InputReplay.h"
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 class App
 {
 public:
-	App();
+	enum class LoopMode
+	{
+		// messages, input, simulation and rendering one after another
+		Serial,
+		// simulation on the main thread, rendering on its own thread
+		Pipelined,
+	};
+public:
+	App(std::unique_ptr<Platform> pPlatform, LoopMode mode = LoopMode::Serial);
 	~App();
 	// master frame / message loop
 	int Start();
+	// stop with exit code 0 once this many frames have been simulated and
+	// presented, 0 runs until the platform asks to quit
+	void SetFrameLimit(uint64_t frames) noexcept;
+	// frames simulated so far
+	uint64_t GetFrameCount() const noexcept;
+	const StageTimings& GetStageTimings() const noexcept;
+	// step size, time scale, pause and deterministic mode
+	OClock& GetClock() noexcept;
+	const FrameStats& GetFrameStats() const noexcept;
+	Platform& GetPlatform() noexcept;
+	// game objects, systems run on it from Step
+	Ecs::World& GetWorld() noexcept;
+	// loads in the background, finished assets reach their uploaders
+	// from Render, on the render thread in pipelined mode
+	AssetStreamer& GetStreamer() noexcept;
+	// one thread per core for per-frame work, used from the main thread,
+	// from inside its own jobs and by the renderer, which joins it as a
+	// guest when it draws on the render thread
+	JobSystem& GetJobs() noexcept;
+	// transient memory for Simulate and Step, anything taken from it stays
+	// valid until the end of the next frame
+	Memory::FrameArenas& GetFrameMemory() noexcept;
+	// heap and frame arena allocations of each frame
+	const Memory::AllocationCounter& GetAllocations() const noexcept;
+	// write all input from the next frame on into the recorder
+	void RecordInput(InputRecorder& recorder) noexcept;
+	// feed the replay in lockstep from the next frame on, with the clock
+	// deterministic at the recorded frame time
+	void ReplayInput(InputReplay& replay) noexcept;
+private:
+	static constexpr size_t frameMemoryCapacity = 1u << 20;
 private:
+	int RunSerial();
+	int RunPipelined();
+	void RenderLoop() noexcept;
+	void StopRenderThread() noexcept;
 	void HandleInput(float dt);
-	void DoFrame(float dt);
+	void DoFrame();
+	void Simulate(FrameSnapshot& snapshot);
+	void Step(float dt);
+	void Render(const FrameSnapshot& snapshot);
 private:
-	Window window;
-	OTimer timer;
-};
\ No newline at end of file
+	std::unique_ptr<Platform> pPlatform;
+	// a guest slot for the render thread; made before the world, which runs
+	// its parallel queries on it
+	JobSystem jobs{ 0u, 1u };
+	Ecs::World world{ &jobs };
+	AssetStreamer streamer;
+	Memory::FrameArenas frameMemory;
+	Memory::AllocationCounter allocations;
+	OClock clock;
+	LoopMode mode;
+	StageTimings timings;
+	uint64_t frameIndex = 0u;
+	uint64_t frameLimit = 0u;
+	FrameStats frameStats;
+	std::array<char, 192> title = {};
+	InputRecorder* pRecorder = nullptr;
+	InputReplay* pReplay = nullptr;
+	// frame the recording or replay started at
+	uint64_t inputFrameBase = 0u;
+	// pipelined mode
+	TripleBuffer<FrameSnapshot> snapshots;
+	std::thread renderThread;
+	std::mutex pipeMtx;
+	std::condition_variable pipeCv;
+	uint64_t published = 0u;
+	uint64_t consumed = 0u;
+	// last frame the renderer presented
+	uint64_t rendered = 0u;
+	bool renderStop = false;
+	std::exception_ptr renderError;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+// x64 configurations define IS_DEBUG on the command line, derive it for the rest
+#ifndef IS_DEBUG
+#ifdef NDEBUG
+#define IS_DEBUG false
+#else
+#define IS_DEBUG true
+#endif
+#endif
+
+// no-throw in release, may throw info exceptions in debug
+#define noxnd noexcept(!IS_DEBUG)
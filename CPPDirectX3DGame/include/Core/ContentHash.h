@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// 128-bit hash of a sequence of fields, for cache keys and asset content.
+// Two 64-bit lanes with different constants, mixed together at the end; not
+// meant to stand up to crafted collisions, only to tell apart inputs.
+// Strings are added with their length so field boundaries are part of the
+// hash.
+class ContentHash
+{
+public:
+	void Add(const void* pData, size_t size) noexcept
+	{
+		const unsigned char* p = static_cast<const unsigned char*>(pData);
+		while (size >= 8u)
+		{
+			uint64_t word;
+			std::memcpy(&word, p, 8u);
+			Mix(word);
+			p += 8u;
+			size -= 8u;
+		}
+		if (size > 0u)
+		{
+			uint64_t word = 0u;
+			std::memcpy(&word, p, size);
+			Mix(word ^ (uint64_t(size) << 56));
+		}
+	}
+	void Add(uint64_t value) noexcept
+	{
+		Mix(value);
+	}
+	void Add(const std::string& text) noexcept
+	{
+		Add(uint64_t(text.size()));
+		Add(text.data(), text.size());
+	}
+	void Finish(uint64_t& hi, uint64_t& lo) const noexcept
+	{
+		const uint64_t x = Final(a ^ Rotl(b, 17));
+		const uint64_t y = Final(b + x);
+		hi = x ^ count;
+		lo = y;
+	}
+private:
+	static uint64_t Rotl(uint64_t x, int r) noexcept
+	{
+		return (x << r) | (x >> (64 - r));
+	}
+	// murmur3 finalizer
+	static uint64_t Final(uint64_t x) noexcept
+	{
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdull;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ull;
+		x ^= x >> 33;
+		return x;
+	}
+	void Mix(uint64_t word) noexcept
+	{
+		a = Rotl(a ^ (word * 0x87c37b91114253d5ull), 31) * 0x4cf5ad432745937full;
+		b = Rotl(b + (word * 0x9e3779b97f4a7c15ull), 29) * 0xc2b2ae3d27d4eb4full + a;
+		count++;
+	}
+private:
+	uint64_t a = 0x243f6a8885a308d3ull;
+	uint64_t b = 0x13198a2e03707344ull;
+	uint64_t count = 0u;
+};
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+
+// Everything the renderer needs to draw one simulated frame. Produced by the
+// simulation, never modified once published.
+struct FrameSnapshot
+{
+	uint64_t frameIndex = 0u;
+	// frame time and interpolation factor from the simulation clock
+	float dt = 0.0f;
+	float alpha = 0.0f;
+	double elapsedTime = 0.0;
+	float clearColor[3] = { 0.0f, 0.0f, 0.0f };
+};
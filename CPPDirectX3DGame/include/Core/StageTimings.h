@@ -0,0 +1,26 @@
+#pragma once
+#include <array>
+#include <atomic>
+
+// Last measured duration (seconds) of each main loop stage. Each stage is
+// written by the thread that runs it and can be read from any thread.
+class StageTimings
+{
+public:
+	enum class Stage
+	{
+		Messages,
+		Input,
+		Simulate,
+		Render,
+		Present,
+		Count,
+	};
+public:
+	StageTimings() noexcept;
+	void Set(Stage stage, float seconds) noexcept;
+	float Get(Stage stage) const noexcept;
+	static const char* GetName(Stage stage) noexcept;
+private:
+	std::array<std::atomic<float>, size_t(Stage::Count)> times;
+};
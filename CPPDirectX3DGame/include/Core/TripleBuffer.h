@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Single producer / single consumer handoff of whole values. The producer
+// fills GetWriteBuffer() and publishes it, the consumer picks up the newest
+// published value. Neither side ever blocks or copies; values published
+// while the consumer is busy are simply superseded by newer ones.
+template<typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() = default;
+	TripleBuffer(const TripleBuffer&) = delete;
+	TripleBuffer& operator=(const TripleBuffer&) = delete;
+	// producer side
+	T& GetWriteBuffer() noexcept
+	{
+		return slots[writeIndex].value;
+	}
+	void Publish() noexcept
+	{
+		// the written slot becomes the newest, take back whichever slot was parked there
+		const uint8_t prev = middle.exchange(uint8_t(writeIndex | freshBit), std::memory_order_acq_rel);
+		writeIndex = prev & indexMask;
+	}
+	// consumer side, returns true when a newer value was picked up
+	bool Acquire() noexcept
+	{
+		if ((middle.load(std::memory_order_relaxed) & freshBit) == 0u)
+		{
+			return false;
+		}
+		const uint8_t prev = middle.exchange(uint8_t(readIndex), std::memory_order_acq_rel);
+		readIndex = prev & indexMask;
+		return true;
+	}
+	const T& GetReadBuffer() const noexcept
+	{
+		return slots[readIndex].value;
+	}
+private:
+	// keep producer and consumer slots off each other's cache lines
+	struct alignas(64) Slot
+	{
+		T value = {};
+	};
+	static constexpr uint8_t indexMask = 0x3u;
+	static constexpr uint8_t freshBit = 0x4u;
+	std::array<Slot, 3> slots;
+	uint8_t writeIndex = 0u;
+	uint8_t readIndex = 1u;
+	std::atomic<uint8_t> middle = 2u;
+};
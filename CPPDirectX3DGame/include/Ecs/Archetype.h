@@ -0,0 +1,72 @@
+#pragma once
+#include "Ecs/Component.h"
+#include "Ecs/Entity.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Ecs
+{
+	// All entities with exactly the same set of components. They are stored
+	// in fixed size chunks, each chunk holding one array per component
+	// (structure of arrays) plus the entity handles. Rows are kept packed:
+	// removing one moves the archetype's last row into the hole, so only
+	// the last chunk in use is ever partly filled.
+	class Archetype
+	{
+	public:
+		static constexpr size_t chunkBytes = 16u * 1024u;
+		// column starts, one cache line so arrays never share one
+		static constexpr size_t columnAlign = 64u;
+		struct Slot
+		{
+			uint32_t chunk;
+			uint32_t row;
+		};
+	public:
+		explicit Archetype(ComponentMask mask);
+		~Archetype();
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+		ComponentMask GetMask() const noexcept;
+		bool Has(ComponentId id) const noexcept;
+		// rows per chunk
+		uint32_t GetCapacity() const noexcept;
+		size_t GetEntityCount() const noexcept;
+		// chunks holding at least one entity
+		size_t GetChunkCount() const noexcept;
+		uint32_t GetChunkSize(size_t chunk) const noexcept;
+		Entity* GetEntities(size_t chunk) noexcept;
+		// start of the component's array in the chunk, nullptr if not part of this archetype
+		void* GetColumn(size_t chunk, ComponentId id) noexcept;
+		// appends a zeroed row
+		Slot Append(Entity entity);
+		// fills the hole with the last row and returns the entity that moved
+		// there, a null entity when the removed row was the last one
+		Entity RemoveSwap(Slot slot) noexcept;
+		// copies the components both archetypes have from one row to the other
+		static void CopyRow(Archetype& from, Slot fromSlot, Archetype& to, Slot toSlot) noexcept;
+		// archetype reached by adding or removing a component, -1 until known
+		int32_t GetAddEdge(ComponentId id) const noexcept;
+		int32_t GetRemoveEdge(ComponentId id) const noexcept;
+		void SetAddEdge(ComponentId id, int32_t archetype) noexcept;
+		void SetRemoveEdge(ComponentId id, int32_t archetype) noexcept;
+	private:
+		struct Column
+		{
+			ComponentId id;
+			size_t offset;
+			size_t size;
+		};
+	private:
+		ComponentMask mask;
+		uint32_t capacity;
+		std::vector<Column> columns;
+		// column index per component id, -1 if absent
+		std::array<int8_t, maxComponents> columnOf;
+		std::vector<std::byte*> chunks;
+		size_t count = 0u;
+		std::array<int32_t, maxComponents> addEdges;
+		std::array<int32_t, maxComponents> removeEdges;
+	};
+}
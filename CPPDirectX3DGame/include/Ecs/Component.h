@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <typeinfo>
+
+namespace Ecs
+{
+	using ComponentId = uint32_t;
+	// one bit per component type, an archetype is identified by its mask
+	using ComponentMask = uint64_t;
+	constexpr ComponentId maxComponents = 64u;
+
+	struct ComponentInfo
+	{
+		size_t size;
+		size_t align;
+		const char* name;
+	};
+
+	// ids are handed out in order of first use, throws World::Exception once
+	// all maxComponents are taken
+	ComponentId RegisterComponent(size_t size, size_t align, const char* name);
+	const ComponentInfo& GetComponentInfo(ComponentId id) noexcept;
+
+	// Components are plain data: chunks move them with memcpy and never run
+	// constructors or destructors.
+	template<typename T>
+	ComponentId GetComponentId()
+	{
+		if constexpr (std::is_const_v<T>)
+		{
+			// read-only access shares the id
+			return GetComponentId<std::remove_const_t<T>>();
+		}
+		else
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "components must be trivially copyable");
+			static const ComponentId id = RegisterComponent(sizeof(T), alignof(T), typeid(T).name());
+			return id;
+		}
+	}
+
+	template<typename... Ts>
+	ComponentMask GetComponentMask()
+	{
+		return (ComponentMask(0u) | ... | (ComponentMask(1u) << GetComponentId<Ts>()));
+	}
+}
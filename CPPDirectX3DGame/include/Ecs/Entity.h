@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+namespace Ecs
+{
+	// Handle to an entity. The generation changes every time an index is
+	// reused, so handles to destroyed entities never alias a new one.
+	struct Entity
+	{
+		static constexpr uint32_t nullIndex = 0xFFFFFFFFu;
+		uint32_t index = nullIndex;
+		uint32_t generation = 0u;
+
+		bool IsNull() const noexcept
+		{
+			return index == nullIndex;
+		}
+		bool operator==(const Entity& other) const noexcept
+		{
+			return index == other.index && generation == other.generation;
+		}
+		bool operator!=(const Entity& other) const noexcept
+		{
+			return !(*this == other);
+		}
+	};
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "Ecs/World.h"
+#include <cstddef>
+#include <vector>
+
+namespace Ecs
+{
+	// Structural changes recorded while queries iterate and applied in
+	// recording order by Playback. Components are copied into the buffer, so
+	// the values passed in need not outlive the call. Not thread safe, use
+	// one buffer per worker in parallel queries. Commands on entities that
+	// died before playback are skipped.
+	class EntityCommandBuffer
+	{
+	public:
+		template<typename... Ts>
+		void Create(const Ts&... components)
+		{
+			Record(Op::Create, {}, 0u, GetComponentMask<Ts...>(), nullptr, 0u);
+			(Record(Op::SetCreated, {}, GetComponentId<Ts>(), 0u, &components, sizeof(Ts)), ...);
+		}
+		void Destroy(Entity entity);
+		template<typename T>
+		void Add(Entity entity, const T& value = T{})
+		{
+			Record(Op::Add, entity, GetComponentId<T>(), 0u, &value, sizeof(T));
+		}
+		template<typename T>
+		void Remove(Entity entity)
+		{
+			Record(Op::Remove, entity, GetComponentId<T>(), 0u, nullptr, 0u);
+		}
+		// applies and clears everything recorded
+		void Playback(World& world);
+		void Clear() noexcept;
+		size_t GetCommandCount() const noexcept;
+		bool IsEmpty() const noexcept;
+	private:
+		enum class Op : uint8_t
+		{
+			Create,
+			// component value for the entity made by the last Create
+			SetCreated,
+			Destroy,
+			Add,
+			Remove,
+		};
+		struct Command
+		{
+			Op op;
+			ComponentId id;
+			Entity entity;
+			ComponentMask mask;
+			// offset of the component value in data
+			size_t offset;
+		};
+	private:
+		void Record(Op op, Entity entity, ComponentId id, ComponentMask mask, const void* pValue, size_t size);
+	private:
+		std::vector<Command> commands;
+		std::vector<std::byte> data;
+	};
+}
@@ -0,0 +1,292 @@
+#pragma once
+#include "Exception/OException.h"
+#include "Ecs/Archetype.h"
+#include "Ecs/Component.h"
+#include "Ecs/Entity.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class JobSystem;
+
+namespace Ecs
+{
+	// Owns all entities and their components, grouped by archetype.
+	// Creating, destroying and adding or removing components are structural
+	// changes: they move rows between chunks and are refused while a query
+	// is iterating. Record them into an EntityCommandBuffer and play it back after.
+	class World
+	{
+	public:
+		class Exception : public OException
+		{
+		public:
+			Exception(int line, const char* file, std::string note) noexcept;
+			const char* what() const noexcept override;
+			const char* GetType() const noexcept override;
+			const std::string& GetNote() const noexcept;
+		private:
+			std::string note;
+		};
+		// counts the world as iterating while alive
+		class IterationScope
+		{
+		public:
+			explicit IterationScope(World& world) noexcept;
+			~IterationScope();
+			IterationScope(const IterationScope&) = delete;
+			IterationScope& operator=(const IterationScope&) = delete;
+		private:
+			World& world;
+		};
+	public:
+		// parallel queries run on the job system, or on the calling thread
+		// without one; it has to outlive the world
+		explicit World(JobSystem* pJobs = nullptr);
+		~World();
+		World(const World&) = delete;
+		World& operator=(const World&) = delete;
+		template<typename... Ts>
+		Entity Create(const Ts&... components)
+		{
+			const Entity entity = CreateWithMask(GetComponentMask<Ts...>());
+			(Set(entity, components), ...);
+			return entity;
+		}
+		void Destroy(Entity entity);
+		bool IsAlive(Entity entity) const noexcept;
+		template<typename T>
+		void Add(Entity entity, const T& value = T{})
+		{
+			AddRaw(entity, GetComponentId<T>(), &value);
+		}
+		template<typename T>
+		void Remove(Entity entity)
+		{
+			RemoveRaw(entity, GetComponentId<T>());
+		}
+		template<typename T>
+		bool Has(Entity entity) const
+		{
+			return GetArchetypeOf(entity).Has(GetComponentId<T>());
+		}
+		// throws if the entity is dead or lacks the component
+		template<typename T>
+		T& Get(Entity entity)
+		{
+			return *static_cast<T*>(GetRaw(entity, GetComponentId<T>()));
+		}
+		template<typename T>
+		void Set(Entity entity, const T& value)
+		{
+			Get<T>(entity) = value;
+		}
+		Entity CreateWithMask(ComponentMask mask);
+		void AddRaw(Entity entity, ComponentId id, const void* pValue);
+		void RemoveRaw(Entity entity, ComponentId id);
+		void* GetRaw(Entity entity, ComponentId id);
+		size_t GetEntityCount() const noexcept;
+		size_t GetArchetypeCount() const noexcept;
+		Archetype& GetArchetype(size_t index) noexcept;
+		bool IsIterating() const noexcept;
+		// threads a parallel query runs on, the calling thread included
+		unsigned int GetWorkerCount() const noexcept;
+		// calls fn(context, index, worker) for every index below count, spread
+		// over the job system with the calling thread helping; worker is the
+		// job system's index of the thread the call runs on
+		void ParallelFor(size_t count, void(*fn)(void*, size_t, unsigned int), void* context);
+	private:
+		struct Record
+		{
+			uint32_t generation = 0u;
+			int32_t archetype = -1;
+			Archetype::Slot slot = {};
+		};
+	private:
+		const Record& GetRecord(Entity entity) const;
+		const Archetype& GetArchetypeOf(Entity entity) const;
+		int32_t GetOrCreateArchetype(ComponentMask mask);
+		void CheckStructural() const;
+		// moves the entity to another archetype keeping the shared components
+		void MoveEntity(Entity entity, int32_t target);
+	private:
+		std::vector<std::unique_ptr<Archetype>> archetypes;
+		std::unordered_map<ComponentMask, int32_t> archetypeOf;
+		std::vector<Record> records;
+		std::vector<uint32_t> freeIndices;
+		size_t entityCount = 0u;
+		std::atomic<int> iterating = 0;
+		JobSystem* pJobs;
+	};
+
+	// One chunk of an archetype as seen by a query
+	class ChunkView
+	{
+	public:
+		ChunkView(Archetype& archetype, size_t chunk) noexcept
+			:
+			archetype(archetype),
+			chunk(chunk)
+		{
+		}
+		uint32_t GetCount() const noexcept
+		{
+			return archetype.GetChunkSize(chunk);
+		}
+		const Entity* GetEntities() const noexcept
+		{
+			return archetype.GetEntities(chunk);
+		}
+		// array of GetCount() components, nullptr if the archetype lacks it
+		template<typename T>
+		T* Get() const
+		{
+			return static_cast<T*>(archetype.GetColumn(chunk, GetComponentId<T>()));
+		}
+	private:
+		Archetype& archetype;
+		size_t chunk;
+	};
+
+	// Iterates every entity that has all of Ts (and none of the excluded
+	// components) chunk by chunk. Matching archetypes are cached and only
+	// archetypes created since the last run are checked again. Declare
+	// components that are only read as const.
+	template<typename... Ts>
+	class Query
+	{
+	public:
+		explicit Query(World& world)
+			:
+			world(world),
+			include(GetComponentMask<Ts...>())
+		{
+		}
+		template<typename T>
+		Query& Without()
+		{
+			exclude |= GetComponentMask<T>();
+			matches.clear();
+			checked = 0u;
+			return *this;
+		}
+		// fn(Ts&...) or fn(Entity, Ts&...) for every entity
+		template<typename F>
+		void ForEach(F&& fn)
+		{
+			ForEachChunk([&fn](const ChunkView& view)
+			{
+				RunChunk(fn, view);
+			});
+		}
+		// fn(const ChunkView&) for every non-empty chunk
+		template<typename F>
+		void ForEachChunk(F&& fn)
+		{
+			Update();
+			World::IterationScope scope(world);
+			for (Archetype* pArchetype : matches)
+			{
+				const size_t chunks = pArchetype->GetChunkCount();
+				for (size_t c = 0; c < chunks; c++)
+				{
+					fn(ChunkView(*pArchetype, c));
+				}
+			}
+		}
+		// fn(const ChunkView&, worker) for every non-empty chunk, chunks run
+		// concurrently on the world's workers; worker is below
+		// World::GetWorkerCount, for per thread command buffers and scratch
+		template<typename F>
+		void ForEachChunkParallel(F&& fn)
+		{
+			Update();
+			chunkList.clear();
+			for (Archetype* pArchetype : matches)
+			{
+				const size_t chunks = pArchetype->GetChunkCount();
+				for (size_t c = 0; c < chunks; c++)
+				{
+					chunkList.push_back({ pArchetype, c });
+				}
+			}
+			World::IterationScope scope(world);
+			struct Context
+			{
+				F& fn;
+				const std::vector<std::pair<Archetype*, size_t>>& chunks;
+			} context = { fn, chunkList };
+			world.ParallelFor(chunkList.size(), [](void* p, size_t index, unsigned int worker)
+			{
+				Context& c = *static_cast<Context*>(p);
+				c.fn(ChunkView(*c.chunks[index].first, c.chunks[index].second), worker);
+			}, &context);
+		}
+		// fn(Ts&...) or fn(Entity, Ts&...) for every entity, in parallel by chunk
+		template<typename F>
+		void ForEachParallel(F&& fn)
+		{
+			ForEachChunkParallel([&fn](const ChunkView& view, unsigned int)
+			{
+				RunChunk(fn, view);
+			});
+		}
+		size_t Count()
+		{
+			Update();
+			size_t n = 0u;
+			for (const Archetype* pArchetype : matches)
+			{
+				n += pArchetype->GetEntityCount();
+			}
+			return n;
+		}
+	private:
+		template<typename F>
+		static void RunChunk(F& fn, const ChunkView& view)
+		{
+			const uint32_t n = view.GetCount();
+			const std::tuple<Ts*...> columns = { view.Get<Ts>()... };
+			if constexpr (std::is_invocable_v<F&, Entity, Ts&...>)
+			{
+				const Entity* entities = view.GetEntities();
+				for (uint32_t i = 0; i < n; i++)
+				{
+					std::apply([&](Ts*... arrays) { fn(entities[i], arrays[i]...); }, columns);
+				}
+			}
+			else
+			{
+				for (uint32_t i = 0; i < n; i++)
+				{
+					std::apply([&](Ts*... arrays) { fn(arrays[i]...); }, columns);
+				}
+			}
+		}
+		void Update()
+		{
+			const size_t total = world.GetArchetypeCount();
+			for (; checked < total; checked++)
+			{
+				Archetype& archetype = world.GetArchetype(checked);
+				const ComponentMask mask = archetype.GetMask();
+				if ((mask & include) == include && (mask & exclude) == 0u)
+				{
+					matches.push_back(&archetype);
+				}
+			}
+		}
+	private:
+		World& world;
+		ComponentMask include;
+		ComponentMask exclude = 0u;
+		size_t checked = 0u;
+		std::vector<Archetype*> matches;
+		std::vector<std::pair<Archetype*, size_t>> chunkList;
+	};
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+// Fixed-capacity single producer / single consumer queue. The window thread
+// pushes, the simulation thread pops, neither blocks and nothing allocates
+// after construction. A full ring rejects the new event and counts it
+// instead of silently throwing away older ones.
+template<typename T>
+class EventRing
+{
+public:
+	// capacity is rounded up to a power of two
+	explicit EventRing(size_t capacity)
+		:
+		items(std::make_unique<T[]>(std::bit_ceil(capacity < 2u ? size_t(2u) : capacity))),
+		mask(std::bit_ceil(capacity < 2u ? size_t(2u) : capacity) - 1u)
+	{}
+	EventRing(const EventRing&) = delete;
+	EventRing& operator=(const EventRing&) = delete;
+	// producer side
+	bool Push(const T& item) noexcept
+	{
+		const size_t h = head.load(std::memory_order_relaxed);
+		if (h - tail.load(std::memory_order_acquire) > mask)
+		{
+			overflows.fetch_add(1u, std::memory_order_relaxed);
+			return false;
+		}
+		items[h & mask] = item;
+		head.store(h + 1u, std::memory_order_release);
+		return true;
+	}
+	// consumer side
+	std::optional<T> Pop() noexcept
+	{
+		const size_t t = tail.load(std::memory_order_relaxed);
+		if (t == head.load(std::memory_order_acquire))
+		{
+			return std::nullopt;
+		}
+		T item = items[t & mask];
+		tail.store(t + 1u, std::memory_order_release);
+		return item;
+	}
+	// consumer side, drops everything pushed so far
+	void Clear() noexcept
+	{
+		tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+	}
+	bool IsEmpty() const noexcept
+	{
+		return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+	}
+	size_t GetSize() const noexcept
+	{
+		const size_t t = tail.load(std::memory_order_acquire);
+		return head.load(std::memory_order_acquire) - t;
+	}
+	size_t GetCapacity() const noexcept
+	{
+		return mask + 1u;
+	}
+	// events rejected because the ring was full
+	uint64_t GetOverflowCount() const noexcept
+	{
+		return overflows.load(std::memory_order_relaxed);
+	}
+private:
+	std::unique_ptr<T[]> items;
+	const size_t mask;
+	alignas(64) std::atomic<size_t> head = 0u;
+	alignas(64) std::atomic<size_t> tail = 0u;
+	std::atomic<uint64_t> overflows = 0u;
+};
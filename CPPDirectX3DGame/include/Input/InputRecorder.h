@@ -0,0 +1,65 @@
+#pragma once
+#include "Time/OTimer.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Serializes every input event Keyboard and Mouse receive, tagged with the
+// frame it arrived in and its time since recording started, into a compact
+// binary stream InputReplay can feed back.
+//
+// Stream layout: magic "OINP", u16 version, u16 reserved, f64 frame seconds,
+// then one record per event: u8 type, varint frame delta, varint time delta
+// (ns), and zig-zag varint payload fields depending on the type.
+class InputRecorder
+{
+public:
+	enum class Type : uint8_t
+	{
+		KeyPress,
+		KeyRelease,
+		Char,
+		// focus lost, all keys released
+		KeyClear,
+		MouseMove,
+		MouseEnter,
+		MouseLeave,
+		LPress,
+		LRelease,
+		RPress,
+		RRelease,
+		Wheel,
+		RawDelta,
+		Count,
+	};
+	static constexpr char magic[4] = { 'O', 'I', 'N', 'P' };
+	static constexpr uint16_t version = 1u;
+	static constexpr size_t headerSize = 16u;
+	// payload fields per type
+	static unsigned int GetFieldCount(Type type) noexcept;
+public:
+	// frameSeconds is the fixed frame time replays run at
+	InputRecorder(double frameSeconds = 1.0 / 60.0);
+	InputRecorder(const InputRecorder&) = delete;
+	InputRecorder& operator=(const InputRecorder&) = delete;
+	// events recorded from now on belong to this frame
+	void BeginFrame(uint64_t frameIndex) noexcept;
+	// timestamp is the one given to the event, OTimer::Now based
+	void Record(Type type, OTimer::Ticks timestamp, int a = 0, int b = 0);
+	const std::vector<uint8_t>& GetData() const noexcept;
+	size_t GetRecordCount() const noexcept;
+	// false if the file could not be written
+	bool Save(const std::string& path) const;
+	void Reset();
+private:
+	void WriteVarint(uint64_t value);
+private:
+	OTimer::Ticks start;
+	double frameSeconds;
+	std::atomic<uint64_t> frame = 0u;
+	uint64_t lastFrame = 0u;
+	OTimer::Ticks lastTime = 0;
+	size_t records = 0u;
+	std::vector<uint8_t> data;
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include "Exception/OException.h"
+#include "Input/InputRecorder.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Keyboard;
+class Mouse;
+
+// Plays an InputRecorder stream back into Keyboard and Mouse without a
+// window. Call Feed once per frame with frames counted from the start of the
+// replay, run the clock deterministic at GetFrameSeconds, and every run of
+// the same stream sees the same events with the same timestamps.
+class InputReplay
+{
+public:
+	class Exception : public OException
+	{
+	public:
+		Exception(int line, const char* file, std::string note) noexcept;
+		const char* what() const noexcept override;
+		const char* GetType() const noexcept override;
+		const std::string& GetNote() const noexcept;
+	private:
+		std::string note;
+	};
+public:
+	explicit InputReplay(std::vector<uint8_t> data);
+	static InputReplay Load(const std::string& path);
+	// deliver every event recorded up to and including frameIndex, returns how many
+	size_t Feed(uint64_t frameIndex, Keyboard& kbd, Mouse& mouse);
+	bool IsFinished() const noexcept;
+	double GetFrameSeconds() const noexcept;
+	size_t GetReplayedCount() const noexcept;
+	// back to the first event
+	void Rewind();
+private:
+	uint64_t ReadVarint();
+	int ReadField();
+	void ReadNext();
+private:
+	std::vector<uint8_t> data;
+	size_t offset = 0u;
+	double frameSeconds = 0.0;
+	size_t replayed = 0u;
+	// decoded event waiting for its frame
+	bool hasNext = false;
+	InputRecorder::Type nextType = InputRecorder::Type::Count;
+	uint64_t nextFrame = 0u;
+	OTimer::Ticks nextTime = 0;
+	int nextA = 0;
+	int nextB = 0;
+};
@@ -1,11 +1,18 @@
 #pragma once
-#include <queue>
-#include <bitset>
+#include "Input/EventRing.h"
+#include "Input/InputRecorder.h"
+#include "Time/OTimer.h"
+#include <array>
+#include <atomic>
 #include <optional>
 
+// Events are produced by the window procedure and may be consumed from
+// another thread, key state can be queried from anywhere.
 class Keyboard
 {
 	friend class Window;
+	friend class InputReplay;
+	friend class InputBench;
 public:
 	class Event
 	{
@@ -15,10 +22,12 @@ public:
 			Press,
 			Release,
 		};
-		Event(Type type, unsigned char code) noexcept
+		Event() noexcept = default;
+		Event(Type type, unsigned char code, OTimer::Ticks timestamp = OTimer::Now()) noexcept
 			:
 			type(type),
-			code(code)
+			code(code),
+			timestamp(timestamp)
 		{
 		}
 		bool IsPress() const noexcept
@@ -33,12 +42,41 @@ public:
 		{
 			return code;
 		}
+		// OTimer::Now when the window received the event
+		OTimer::Ticks GetTimestamp() const noexcept
+		{
+			return timestamp;
+		}
+	private:
+		Type type = Type::Press;
+		unsigned char code = 0u;
+		OTimer::Ticks timestamp = 0;
+	};
+	class CharEvent
+	{
+	public:
+		CharEvent() noexcept = default;
+		CharEvent(char character, OTimer::Ticks timestamp = OTimer::Now()) noexcept
+			:
+			character(character),
+			timestamp(timestamp)
+		{
+		}
+		char GetChar() const noexcept
+		{
+			return character;
+		}
+		// OTimer::Now when the window received the event
+		OTimer::Ticks GetTimestamp() const noexcept
+		{
+			return timestamp;
+		}
 	private:
-		Type type;
-		unsigned char code;
+		char character = 0;
+		OTimer::Ticks timestamp = 0;
 	};
 public:
-	Keyboard() = default;
+	explicit Keyboard(size_t capacity = defaultCapacity);
 	Keyboard(const Keyboard&) = delete;
 	Keyboard& operator=(const Keyboard&) = delete;
 	// key event stuff
@@ -48,25 +86,34 @@ public:
 	void FlushKey() noexcept;
 	// char event stuff
 	std::optional<char> ReadChar() noexcept;
+	// the same queue as ReadChar, with the time each character arrived
+	std::optional<CharEvent> ReadCharEvent() noexcept;
 	bool IsCharEmpty() const noexcept;
 	void FlushChar() noexcept;
 	void Flush() noexcept;
+	// events lost because the consumer fell behind
+	uint64_t GetOverflowCount() const noexcept;
 	// autorepeat control
 	void EnableAutorepeat() noexcept;
 	void DisableAutorepeat() noexcept;
 	bool IsAutorepeatEnabled() const noexcept;
+	// every event received is also written to the recorder, nullptr stops
+	void SetRecorder(InputRecorder* pRecorder) noexcept;
 private:
 	void OnKeyPressed(unsigned char keycode) noexcept;
 	void OnKeyReleased(unsigned char keycode) noexcept;
 	void OnChar(char character) noexcept;
 	void ClearState() noexcept;
-	template<typename T>
-	static void TrimBuffer(std::queue<T>& buffer) noexcept;
+	OTimer::Ticks Now() const noexcept;
 private:
 	static constexpr unsigned int nKeys = 256u;
-	static constexpr unsigned int bufferSize = 16u;
-	bool autorepeatEnabled = false;
-	std::bitset<nKeys> keystates;
-	std::queue<Event> keybuffer;
-	std::queue<char> charbuffer;
-};
\ No newline at end of file
+	static constexpr size_t defaultCapacity = 64u;
+	std::atomic<bool> autorepeatEnabled = false;
+	// one bit per key, 64 keys per word
+	std::array<std::atomic<uint64_t>, nKeys / 64u> keystates = {};
+	EventRing<Event> keybuffer;
+	EventRing<CharEvent> charbuffer;
+	InputRecorder* pRecorder = nullptr;
+	// set while replaying so events get their recorded time
+	std::optional<OTimer::Ticks> timeOverride;
+};
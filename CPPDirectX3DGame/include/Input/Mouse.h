@@ -1,15 +1,23 @@
 #pragma once
-#include <queue>
+#include "Input/EventRing.h"
+#include "Input/InputRecorder.h"
+#include "Input/RawDeltaAccumulator.h"
+#include "Time/OTimer.h"
+#include <atomic>
 #include <optional>
+#include <utility>
+
+// Events are produced by the window procedure and may be consumed from
+// another thread, the current position and button state can be queried
+// from anywhere.
 
 class Mouse
 {
 	friend class Window;
+	friend class InputReplay;
+	friend class InputBench;
 public:
-	struct RawDelta
-	{
-		int x, y;
-	};
+	using RawDelta = RawDeltaAccumulator::Delta;
 	class Event
 	{
 	public:
@@ -26,19 +34,32 @@ public:
 			Leave,
 		};
 	private:
-		Type type;
-		bool leftIsPressed;
-		bool rightIsPressed;
-		int x;
-		int y;
+		Type type = Type::Move;
+		bool leftIsPressed = false;
+		bool rightIsPressed = false;
+		int x = 0;
+		int y = 0;
+		OTimer::Ticks timestamp = 0;
 	public:
-		Event(Type type, const Mouse& parent) noexcept
+		Event() noexcept = default;
+		Event(Type type, const Mouse& parent, OTimer::Ticks timestamp = OTimer::Now()) noexcept
 			:
 			type(type),
 			leftIsPressed(parent.leftIsPressed),
 			rightIsPressed(parent.rightIsPressed),
-			x(parent.x),
-			y(parent.y)
+			x(parent.GetPosX()),
+			y(parent.GetPosY()),
+			timestamp(timestamp)
+		{
+		}
+		Event(Type type, int x, int y, bool leftIsPressed, bool rightIsPressed, OTimer::Ticks timestamp) noexcept
+			:
+			type(type),
+			leftIsPressed(leftIsPressed),
+			rightIsPressed(rightIsPressed),
+			x(x),
+			y(y),
+			timestamp(timestamp)
 		{
 		}
 		Type GetType() const noexcept
@@ -65,27 +86,40 @@ public:
 		{
 			return rightIsPressed;
 		}
+		// OTimer::Now when the window received the event
+		OTimer::Ticks GetTimestamp() const noexcept
+		{
+			return timestamp;
+		}
 	};
 public:
-	Mouse() = default;
+	explicit Mouse(size_t capacity = defaultCapacity);
 	Mouse(const Mouse&) = delete;
 	Mouse& operator=(const Mouse&) = delete;
 	std::pair<int, int> GetPos() const noexcept;
+	// individual raw reports, only recorded while raw samples are enabled
 	std::optional<RawDelta> ReadRawDelta() noexcept;
+	// sum of all raw reports since the last call, read once per frame
+	RawDelta ReadRawFrameDelta() noexcept;
 	int GetPosX() const noexcept;
 	int GetPosY() const noexcept;
 	bool IsInWindow() const noexcept;
 	bool IsLeftPressed() const noexcept;
 	bool IsRightPressed() const noexcept;
 	std::optional<Mouse::Event> Read() noexcept;
-	bool IsEmpty() const noexcept
-	{
-		return buffer.empty();
-	}
+	bool IsEmpty() const noexcept;
 	void Flush() noexcept;
+	// events lost because the consumer fell behind
+	uint64_t GetOverflowCount() const noexcept;
+	// Move events folded into a later Move instead of taking buffer space
+	uint64_t GetCoalescedMoveCount() const noexcept;
 	void EnableRaw() noexcept;
 	void DisableRaw() noexcept;
 	bool RawEnabled() const noexcept;
+	void EnableRawSamples() noexcept;
+	void DisableRawSamples() noexcept;
+	// every event received is also written to the recorder, nullptr stops
+	void SetRecorder(InputRecorder* pRecorder) noexcept;
 private:
 	void OnMouseMove(int x, int y) noexcept;
 	void OnMouseLeave() noexcept;
@@ -97,18 +131,44 @@ private:
 	void OnRightReleased(int x, int y) noexcept;
 	void OnWheelUp(int x, int y) noexcept;
 	void OnWheelDown(int x, int y) noexcept;
-	void TrimBuffer() noexcept;
-	void TrimRawInputBuffer() noexcept;
 	void OnWheelDelta(int x, int y, int delta) noexcept;
+	void SetPos(int x, int y) noexcept;
+	void Push(const Event& e) noexcept;
+	void Record(InputRecorder::Type type, OTimer::Ticks timestamp, int a = 0, int b = 0) noexcept;
+	OTimer::Ticks Now() const noexcept;
+	// window thread only
+	void StorePendingMove(OTimer::Ticks timestamp) noexcept;
+	// the held back move as of state, only valid if ClaimPendingMove(state) succeeds
+	Event LoadPendingMove() const noexcept;
+	// false if the move was replaced or taken since state was loaded
+	bool ClaimPendingMove(uint64_t state) noexcept;
 private:
-	static constexpr unsigned int bufferSize = 16u;
-	int x;
-	int y;
-	bool leftIsPressed = false;
-	bool rightIsPressed = false;
-	bool isInWindow = false;
+	static constexpr size_t defaultCapacity = 64u;
+	// x in the low and y in the high half so readers never see a torn position
+	std::atomic<uint64_t> pos = 0u;
+	std::atomic<bool> leftIsPressed = false;
+	std::atomic<bool> rightIsPressed = false;
+	std::atomic<bool> isInWindow = false;
 	int wheelDeltaCarry = 0;
-	bool rawEnabled = false;
-	std::queue<Event> buffer;
-	std::queue<RawDelta> rawDeltaBuffer;
+	std::atomic<bool> rawEnabled = false;
+	EventRing<Event> buffer;
+	// the newest Move is held back here until another event or the consumer
+	// needs it, so runs of moves collapse into one and buttons keep the
+	// buffer. Published like a seqlock: the window thread sets writing,
+	// stores the fields and bumps the sequence, and whoever clears hasMove
+	// on an unchanged state owns the fields it read before. Nobody waits,
+	// a consumer that finds a write in progress sees no move yet.
+	static constexpr uint64_t hasMove = 1u;
+	static constexpr uint64_t writing = 2u;
+	static constexpr uint64_t sequenceStep = 4u;
+	std::atomic<uint64_t> pendingState = 0u;
+	std::atomic<uint64_t> pendingPos = 0u;
+	std::atomic<OTimer::Ticks> pendingTime = 0;
+	// left in bit 0, right in bit 1
+	std::atomic<uint8_t> pendingButtons = 0u;
+	std::atomic<uint64_t> coalescedMoves = 0u;
+	RawDeltaAccumulator rawDelta;
+	InputRecorder* pRecorder = nullptr;
+	// set while replaying so events get their recorded time
+	std::optional<OTimer::Ticks> timeOverride;
 };
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+#include "Input/EventRing.h"
+#include "Time/OTimer.h"
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+// Coalesces raw mouse reports into one summed delta per frame. High polling
+// rate mice send thousands of reports a second, the simulation only needs
+// their sum. Individual reports can optionally be kept as sub-frame samples.
+// Add is called from the window thread, Take and PopSample from the
+// simulation thread. No platform code, so it can be fed synthetic streams.
+class RawDeltaAccumulator
+{
+public:
+	struct Delta
+	{
+		int x = 0;
+		int y = 0;
+		// newest report that contributed
+		OTimer::Ticks timestamp = 0;
+	};
+public:
+	explicit RawDeltaAccumulator(size_t sampleCapacity = 256u);
+	RawDeltaAccumulator(const RawDeltaAccumulator&) = delete;
+	RawDeltaAccumulator& operator=(const RawDeltaAccumulator&) = delete;
+	void Add(int dx, int dy, OTimer::Ticks timestamp = OTimer::Now()) noexcept;
+	// sum of everything added since the last call
+	Delta Take() noexcept;
+	std::optional<Delta> PopSample() noexcept;
+	void EnableSamples() noexcept;
+	void DisableSamples() noexcept;
+	bool SamplesEnabled() const noexcept;
+	// raw reports seen in total
+	uint64_t GetReportCount() const noexcept;
+	// sub-frame samples lost because nobody popped them
+	uint64_t GetOverflowCount() const noexcept;
+	void Clear() noexcept;
+private:
+	// x in the low half, y * 2^32 on top, so one fetch_add updates both and
+	// one exchange takes both; valid as long as |x| < 2^31 per frame
+	std::atomic<uint64_t> sum = 0u;
+	std::atomic<OTimer::Ticks> lastTimestamp = 0;
+	std::atomic<uint64_t> reports = 0u;
+	std::atomic<bool> samplesEnabled = false;
+	EventRing<Delta> samples;
+};
@@ -0,0 +1,139 @@
+#pragma once
+#include "Exception/OException.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+template<typename T, size_t capacity>
+class WorkStealingDeque;
+
+// Fine grained jobs on one thread per core. Each thread, the one that made
+// the system included, has a work-stealing deque it pushes to and pops from
+// newest first, and steals the oldest job of a random other thread when its
+// own is empty; idle workers sleep until something is pushed.
+// Jobs come from a ring per thread and are recycled once finished, so a
+// handle stays valid until its thread has made jobsPerThread more. A job
+// finishes when its function and every child made with it as parent have
+// returned; it starts once it was Run and every prerequisite given with
+// AddDependency has finished. Wait runs other jobs until the one waited on
+// has finished, so the calling thread is never idle while there is work.
+// Jobs are made, run and waited on from the thread that made the system,
+// from inside jobs, or from another thread while it holds a Guest.
+class JobSystem
+{
+public:
+	class Exception : public OException
+	{
+	public:
+		Exception(int line, const char* file, std::string note) noexcept;
+		const char* what() const noexcept override;
+		const char* GetType() const noexcept override;
+		const std::string& GetNote() const noexcept;
+	private:
+		std::string note;
+	};
+	// Gives a thread the system did not start one of the guest deques while
+	// alive, so it can make, run and wait on jobs too, as the render thread
+	// does. Does nothing on threads that already belong to the system.
+	class Guest
+	{
+	public:
+		explicit Guest(JobSystem& system);
+		~Guest();
+		Guest(const Guest&) = delete;
+		Guest& operator=(const Guest&) = delete;
+	private:
+		// null when the thread belonged to the system already
+		JobSystem* pSystem = nullptr;
+		unsigned int index = 0u;
+		JobSystem* pPreviousSystem = nullptr;
+		unsigned int previousIndex = 0u;
+	};
+	using Function = void(*)(void* context);
+	// fn(context, begin, end) for one chunk of a ParallelFor
+	using RangeFunction = void(*)(void* context, size_t begin, size_t end);
+	static constexpr size_t jobsPerThread = 4096u;
+	static constexpr size_t maxDependents = 4u;
+	struct Job;
+	using Handle = Job*;
+	struct Stats
+	{
+		uint64_t jobs = 0u;
+		uint64_t steals = 0u;
+		// steals that found nothing or lost the race
+		uint64_t failedSteals = 0u;
+		uint64_t sleeps = 0u;
+	};
+public:
+	// threads including the caller, 0 for one per core, and how many other
+	// threads may hold a Guest at the same time
+	explicit JobSystem(unsigned int threads = 0u, unsigned int guests = 0u);
+	// jobs that have not run by then are dropped
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+	// does not start before Run; a parent, not finished yet, waits for it too
+	Handle Create(Function fn, void* context, Handle parent = nullptr);
+	// neither may have been Run yet, at most maxDependents per prerequisite
+	void AddDependency(Handle job, Handle prerequisite);
+	void Run(Handle job);
+	// rethrows the first exception the job or one of its children threw
+	void Wait(Handle job);
+	bool IsFinished(Handle job) const noexcept;
+	// fn for every index below count in chunks of at least minChunk, the
+	// caller helping until all are done. A chunk hands half of what is left
+	// to a new job whenever its thread has nothing queued, which happens
+	// only while others are idle, so ranges split as far as the load needs.
+	void ParallelFor(size_t count, RangeFunction fn, void* context, size_t minChunk = 1u);
+	// fn(begin, end)
+	template<typename F>
+	void ParallelFor(size_t count, F&& fn, size_t minChunk = 1u)
+	{
+		ParallelFor(count, [](void* p, size_t begin, size_t end)
+		{
+			(*static_cast<std::remove_reference_t<F>*>(p))(begin, end);
+		}, &fn, minChunk);
+	}
+	// the calling thread and the guest deques count as one each
+	unsigned int GetThreadCount() const noexcept;
+	// below GetThreadCount and fixed while the thread belongs to the system,
+	// for per thread scratch; throws on threads outside it
+	unsigned int GetThreadIndex() const;
+	// summed over threads, read while jobs run it is approximate
+	Stats GetStats() const noexcept;
+	void ResetStats() noexcept;
+private:
+	struct Worker;
+	void Stop() noexcept;
+	// throws when the slot the ring is at next has not finished yet
+	Job* Make(unsigned int index, Function fn, void* context, Job* parent);
+	void Push(unsigned int index, Job* pJob) noexcept;
+	Job* Find(unsigned int index) noexcept;
+	void Execute(unsigned int index, Job* pJob) noexcept;
+	void Finish(unsigned int index, Job* pJob) noexcept;
+	void Sleep(unsigned int index);
+	void WorkerLoop(unsigned int index) noexcept;
+	static void RunRange(void* context);
+private:
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::vector<std::thread> threads;
+	// deques from here on are for guests
+	unsigned int firstGuest = 0u;
+	std::atomic<bool> stopping = false;
+	std::atomic<unsigned int> sleepers = 0u;
+	std::mutex sleepMtx;
+	std::condition_variable sleepCv;
+	uint64_t wakeGeneration = 0u;
+	std::mutex errorMtx;
+	// what the constructing thread was bound to before, back in the destructor
+	JobSystem* pPreviousSystem = nullptr;
+	unsigned int previousIndex = 0u;
+};
@@ -0,0 +1,89 @@
+#pragma once
+#include "Math/OMath.h"
+#include <cstddef>
+
+// Transforms for thousands of objects at once with one matrix per call,
+// typically world-view-projection. Inputs and outputs are structure of
+// arrays so every lane of a SIMD register is a different object; the
+// kernels run on the best instruction set the CPU supports unless one is
+// picked with SetIsa, which the benchmarks use to compare them.
+// Outputs may alias inputs of the same layout.
+namespace OMath::Batch
+{
+	enum class Isa
+	{
+		Scalar,
+		SSE,
+		AVX2,
+		NEON,
+		Count,
+	};
+
+	// positions, or centers of bounding volumes
+	struct Float3Array
+	{
+		float* x;
+		float* y;
+		float* z;
+	};
+
+	struct ConstFloat3Array
+	{
+		const float* x;
+		const float* y;
+		const float* z;
+		ConstFloat3Array(const float* x, const float* y, const float* z) noexcept : x(x), y(y), z(z) {}
+		ConstFloat3Array(const Float3Array& a) noexcept : x(a.x), y(a.y), z(a.z) {}
+	};
+
+	// homogeneous clip space positions
+	struct Float4Array
+	{
+		float* x;
+		float* y;
+		float* z;
+		float* w;
+	};
+
+	// m[row][column] points at that element of every matrix
+	struct MatrixArray
+	{
+		float* m[4][4];
+	};
+
+	struct ConstMatrixArray
+	{
+		const float* m[4][4];
+		ConstMatrixArray() = default;
+		ConstMatrixArray(const MatrixArray& a) noexcept
+		{
+			for (int r = 0; r < 4; r++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					m[r][c] = a.m[r][c];
+				}
+			}
+		}
+	};
+
+	const char* GetIsaName(Isa isa) noexcept;
+	bool IsSupported(Isa isa) noexcept;
+	// widest instruction set compiled in and supported by this CPU
+	Isa GetBestIsa() noexcept;
+	// unsupported choices fall back to the best one, returns the isa in use
+	Isa SetIsa(Isa isa) noexcept;
+	Isa GetIsa() noexcept;
+
+	// (x, y, z, 1) * m
+	void TransformPoints(FXMMATRIX m, ConstFloat3Array in, Float4Array out, size_t count) noexcept;
+	// out[i] = in[i] * m, e.g. world matrices into world-view-projection
+	void MultiplyMatrices(ConstMatrixArray in, FXMMATRIX m, MatrixArray out, size_t count) noexcept;
+	// centers are transformed as points, radii scaled by the largest axis scale of m
+	void TransformSpheres(FXMMATRIX m, ConstFloat3Array centers, const float* radii,
+		Float3Array outCenters, float* outRadii, size_t count) noexcept;
+	// center / half extent boxes, the result is the box around the transformed box
+	// (m must be affine)
+	void TransformAabbs(FXMMATRIX m, ConstFloat3Array centers, ConstFloat3Array extents,
+		Float3Array outCenters, Float3Array outExtents, size_t count) noexcept;
+}
@@ -0,0 +1,793 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// The part of DirectXMath we use, with the same names, row-vector convention
+// (v' = v * M) and left-handed matrices, so code can move between the two by
+// swapping the namespace. Backed by SSE2 on x86/x64, NEON on ARM and plain
+// floats elsewhere; define O_MATH_NO_SIMD to force the scalar path.
+// Batch kernels over SoA arrays live in Math/BatchTransform.h.
+
+#if !defined(O_MATH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define O_MATH_SSE 1
+#include <emmintrin.h>
+#elif !defined(O_MATH_NO_SIMD) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define O_MATH_NEON 1
+#include <arm_neon.h>
+#else
+#define O_MATH_SCALAR 1
+#endif
+
+#if defined(_MSC_VER) && !defined(_M_ARM64) && !defined(O_MATH_SCALAR)
+#define O_MATH_CALLCONV __vectorcall
+#else
+#define O_MATH_CALLCONV
+#endif
+
+namespace OMath
+{
+	constexpr float XM_PI = 3.141592654f;
+	constexpr float XM_2PI = 6.283185307f;
+	constexpr float XM_PIDIV2 = 1.570796327f;
+	constexpr float XM_PIDIV4 = 0.785398163f;
+
+	constexpr float XMConvertToRadians(float degrees) noexcept
+	{
+		return degrees * (XM_PI / 180.0f);
+	}
+
+	constexpr float XMConvertToDegrees(float radians) noexcept
+	{
+		return radians * (180.0f / XM_PI);
+	}
+
+#if defined(O_MATH_SSE)
+	using XMVECTOR = __m128;
+#elif defined(O_MATH_NEON)
+	using XMVECTOR = float32x4_t;
+#else
+	struct alignas(16) XMVECTOR
+	{
+		float v[4];
+	};
+#endif
+	// first three vector arguments by value, the rest by reference, as DirectXMath
+	using FXMVECTOR = const XMVECTOR;
+	using GXMVECTOR = const XMVECTOR;
+	using HXMVECTOR = const XMVECTOR&;
+	using CXMVECTOR = const XMVECTOR&;
+
+	struct XMFLOAT2
+	{
+		float x;
+		float y;
+		XMFLOAT2() = default;
+		constexpr XMFLOAT2(float x, float y) noexcept : x(x), y(y) {}
+	};
+
+	struct XMFLOAT3
+	{
+		float x;
+		float y;
+		float z;
+		XMFLOAT3() = default;
+		constexpr XMFLOAT3(float x, float y, float z) noexcept : x(x), y(y), z(z) {}
+	};
+
+	struct XMFLOAT4
+	{
+		float x;
+		float y;
+		float z;
+		float w;
+		XMFLOAT4() = default;
+		constexpr XMFLOAT4(float x, float y, float z, float w) noexcept : x(x), y(y), z(z), w(w) {}
+	};
+
+	struct XMFLOAT4X4
+	{
+		float m[4][4];
+	};
+
+	// Vector construction and access
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorSet(float x, float y, float z, float w) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_set_ps(w, z, y, x);
+#elif defined(O_MATH_NEON)
+		const float v[4] = { x, y, z, w };
+		return vld1q_f32(v);
+#else
+		return { { x, y, z, w } };
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorReplicate(float value) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_set1_ps(value);
+#elif defined(O_MATH_NEON)
+		return vdupq_n_f32(value);
+#else
+		return { { value, value, value, value } };
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorZero() noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_setzero_ps();
+#elif defined(O_MATH_NEON)
+		return vdupq_n_f32(0.0f);
+#else
+		return { { 0.0f, 0.0f, 0.0f, 0.0f } };
+#endif
+	}
+
+	inline float O_MATH_CALLCONV XMVectorGetX(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_cvtss_f32(v);
+#elif defined(O_MATH_NEON)
+		return vgetq_lane_f32(v, 0);
+#else
+		return v.v[0];
+#endif
+	}
+
+	inline float O_MATH_CALLCONV XMVectorGetY(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+#elif defined(O_MATH_NEON)
+		return vgetq_lane_f32(v, 1);
+#else
+		return v.v[1];
+#endif
+	}
+
+	inline float O_MATH_CALLCONV XMVectorGetZ(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)));
+#elif defined(O_MATH_NEON)
+		return vgetq_lane_f32(v, 2);
+#else
+		return v.v[2];
+#endif
+	}
+
+	inline float O_MATH_CALLCONV XMVectorGetW(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+#elif defined(O_MATH_NEON)
+		return vgetq_lane_f32(v, 3);
+#else
+		return v.v[3];
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorSplatX(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+#elif defined(O_MATH_NEON)
+		return vdupq_lane_f32(vget_low_f32(v), 0);
+#else
+		return XMVectorReplicate(v.v[0]);
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorSplatY(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+#elif defined(O_MATH_NEON)
+		return vdupq_lane_f32(vget_low_f32(v), 1);
+#else
+		return XMVectorReplicate(v.v[1]);
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorSplatZ(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+#elif defined(O_MATH_NEON)
+		return vdupq_lane_f32(vget_high_f32(v), 0);
+#else
+		return XMVectorReplicate(v.v[2]);
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorSplatW(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+#elif defined(O_MATH_NEON)
+		return vdupq_lane_f32(vget_high_f32(v), 1);
+#else
+		return XMVectorReplicate(v.v[3]);
+#endif
+	}
+
+	// Loads and stores
+
+	inline XMVECTOR O_MATH_CALLCONV XMLoadFloat3(const XMFLOAT3* pSource) noexcept
+	{
+		return XMVectorSet(pSource->x, pSource->y, pSource->z, 0.0f);
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMLoadFloat4(const XMFLOAT4* pSource) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_loadu_ps(&pSource->x);
+#elif defined(O_MATH_NEON)
+		return vld1q_f32(&pSource->x);
+#else
+		return { { pSource->x, pSource->y, pSource->z, pSource->w } };
+#endif
+	}
+
+	inline void O_MATH_CALLCONV XMStoreFloat3(XMFLOAT3* pDestination, FXMVECTOR v) noexcept
+	{
+		pDestination->x = XMVectorGetX(v);
+		pDestination->y = XMVectorGetY(v);
+		pDestination->z = XMVectorGetZ(v);
+	}
+
+	inline void O_MATH_CALLCONV XMStoreFloat4(XMFLOAT4* pDestination, FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		_mm_storeu_ps(&pDestination->x, v);
+#elif defined(O_MATH_NEON)
+		vst1q_f32(&pDestination->x, v);
+#else
+		pDestination->x = v.v[0];
+		pDestination->y = v.v[1];
+		pDestination->z = v.v[2];
+		pDestination->w = v.v[3];
+#endif
+	}
+
+	// Component-wise arithmetic
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorAdd(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_add_ps(a, b);
+#elif defined(O_MATH_NEON)
+		return vaddq_f32(a, b);
+#else
+		return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorSubtract(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_sub_ps(a, b);
+#elif defined(O_MATH_NEON)
+		return vsubq_f32(a, b);
+#else
+		return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } };
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorMultiply(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_mul_ps(a, b);
+#elif defined(O_MATH_NEON)
+		return vmulq_f32(a, b);
+#else
+		return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } };
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorDivide(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_div_ps(a, b);
+#elif defined(O_MATH_NEON) && defined(__aarch64__)
+		return vdivq_f32(a, b);
+#elif defined(O_MATH_NEON)
+		return XMVectorSet(
+			vgetq_lane_f32(a, 0) / vgetq_lane_f32(b, 0), vgetq_lane_f32(a, 1) / vgetq_lane_f32(b, 1),
+			vgetq_lane_f32(a, 2) / vgetq_lane_f32(b, 2), vgetq_lane_f32(a, 3) / vgetq_lane_f32(b, 3));
+#else
+		return { { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } };
+#endif
+	}
+
+	// a * b + c
+	inline XMVECTOR O_MATH_CALLCONV XMVectorMultiplyAdd(FXMVECTOR a, FXMVECTOR b, FXMVECTOR c) noexcept
+	{
+#if defined(O_MATH_NEON)
+		return vmlaq_f32(c, a, b);
+#else
+		return XMVectorAdd(XMVectorMultiply(a, b), c);
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorScale(FXMVECTOR v, float scale) noexcept
+	{
+		return XMVectorMultiply(v, XMVectorReplicate(scale));
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorNegate(FXMVECTOR v) noexcept
+	{
+		return XMVectorSubtract(XMVectorZero(), v);
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorMin(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_min_ps(a, b);
+#elif defined(O_MATH_NEON)
+		return vminq_f32(a, b);
+#else
+		return { { std::fmin(a.v[0], b.v[0]), std::fmin(a.v[1], b.v[1]), std::fmin(a.v[2], b.v[2]), std::fmin(a.v[3], b.v[3]) } };
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorMax(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_max_ps(a, b);
+#elif defined(O_MATH_NEON)
+		return vmaxq_f32(a, b);
+#else
+		return { { std::fmax(a.v[0], b.v[0]), std::fmax(a.v[1], b.v[1]), std::fmax(a.v[2], b.v[2]), std::fmax(a.v[3], b.v[3]) } };
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorAbs(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+#elif defined(O_MATH_NEON)
+		return vabsq_f32(v);
+#else
+		return { { std::fabs(v.v[0]), std::fabs(v.v[1]), std::fabs(v.v[2]), std::fabs(v.v[3]) } };
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorSqrt(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_sqrt_ps(v);
+#elif defined(O_MATH_NEON) && defined(__aarch64__)
+		return vsqrtq_f32(v);
+#elif defined(O_MATH_NEON)
+		return XMVectorSet(
+			std::sqrt(vgetq_lane_f32(v, 0)), std::sqrt(vgetq_lane_f32(v, 1)),
+			std::sqrt(vgetq_lane_f32(v, 2)), std::sqrt(vgetq_lane_f32(v, 3)));
+#else
+		return { { std::sqrt(v.v[0]), std::sqrt(v.v[1]), std::sqrt(v.v[2]), std::sqrt(v.v[3]) } };
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorReciprocal(FXMVECTOR v) noexcept
+	{
+		return XMVectorDivide(XMVectorReplicate(1.0f), v);
+	}
+
+	// Comparisons, lanes are all ones where true and zero where false
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorLess(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return _mm_cmplt_ps(a, b);
+#elif defined(O_MATH_NEON)
+		return vreinterpretq_f32_u32(vcltq_f32(a, b));
+#else
+		XMVECTOR r;
+		for (int i = 0; i < 4; i++)
+		{
+			const uint32_t bits = a.v[i] < b.v[i] ? 0xFFFFFFFFu : 0u;
+			std::memcpy(&r.v[i], &bits, sizeof(bits));
+		}
+		return r;
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVectorGreater(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+		return XMVectorLess(b, a);
+	}
+
+	// Not in DirectXMath: the sign bit of each lane, x in bit 0. Turns a
+	// comparison into an integer mask without storing the vector.
+	inline uint32_t O_MATH_CALLCONV XMVectorMoveMask(FXMVECTOR v) noexcept
+	{
+#if defined(O_MATH_SSE)
+		return uint32_t(_mm_movemask_ps(v));
+#elif defined(O_MATH_NEON)
+		const uint32x4_t s = vshrq_n_u32(vreinterpretq_u32_f32(v), 31);
+		return vgetq_lane_u32(s, 0) | (vgetq_lane_u32(s, 1) << 1) | (vgetq_lane_u32(s, 2) << 2) | (vgetq_lane_u32(s, 3) << 3);
+#else
+		uint32_t mask = 0u;
+		for (int i = 0; i < 4; i++)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &v.v[i], sizeof(bits));
+			mask |= (bits >> 31) << i;
+		}
+		return mask;
+#endif
+	}
+
+	// Geometric functions, results are replicated into all lanes
+
+	inline XMVECTOR O_MATH_CALLCONV XMVector3Dot(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+#if defined(O_MATH_SSE)
+		const __m128 t = _mm_mul_ps(a, b);
+		const __m128 y = _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 z = _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2));
+		const __m128 s = _mm_add_ss(_mm_add_ss(t, y), z);
+		return _mm_shuffle_ps(s, s, _MM_SHUFFLE(0, 0, 0, 0));
+#elif defined(O_MATH_NEON)
+		const float32x4_t t = vmulq_f32(a, b);
+		return vdupq_n_f32(vgetq_lane_f32(t, 0) + vgetq_lane_f32(t, 1) + vgetq_lane_f32(t, 2));
+#else
+		return XMVectorReplicate(a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2]);
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVector4Dot(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+#if defined(O_MATH_SSE)
+		__m128 t = _mm_mul_ps(a, b);
+		t = _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 0, 3, 2)));
+#elif defined(O_MATH_NEON)
+		const float32x4_t t = vmulq_f32(a, b);
+		return vdupq_n_f32(vgetq_lane_f32(t, 0) + vgetq_lane_f32(t, 1) + vgetq_lane_f32(t, 2) + vgetq_lane_f32(t, 3));
+#else
+		return XMVectorReplicate(a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3]);
+#endif
+	}
+
+	// w of the result is zero
+	inline XMVECTOR O_MATH_CALLCONV XMVector3Cross(FXMVECTOR a, FXMVECTOR b) noexcept
+	{
+#if defined(O_MATH_SSE)
+		const __m128 a1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 b1 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+		const __m128 a2 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+		const __m128 b2 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 r = _mm_sub_ps(_mm_mul_ps(a1, b1), _mm_mul_ps(a2, b2));
+		// w is a.w * b.w - a.w * b.w, clear it so NaNs and infinities don't leak
+		return _mm_and_ps(r, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+#else
+		const float ax = XMVectorGetX(a), ay = XMVectorGetY(a), az = XMVectorGetZ(a);
+		const float bx = XMVectorGetX(b), by = XMVectorGetY(b), bz = XMVectorGetZ(b);
+		return XMVectorSet(ay * bz - az * by, az * bx - ax * bz, ax * by - ay * bx, 0.0f);
+#endif
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVector3LengthSq(FXMVECTOR v) noexcept
+	{
+		return XMVector3Dot(v, v);
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMVector3Length(FXMVECTOR v) noexcept
+	{
+		return XMVectorSqrt(XMVector3Dot(v, v));
+	}
+
+	// zero length vectors come back as zero instead of NaN
+	inline XMVECTOR O_MATH_CALLCONV XMVector3Normalize(FXMVECTOR v) noexcept
+	{
+		const float length = XMVectorGetX(XMVector3Length(v));
+		return length > 0.0f ? XMVectorScale(v, 1.0f / length) : XMVectorZero();
+	}
+
+	inline bool O_MATH_CALLCONV XMVector3NearEqual(FXMVECTOR a, FXMVECTOR b, FXMVECTOR epsilon) noexcept
+	{
+		const XMVECTOR d = XMVectorAbs(XMVectorSubtract(a, b));
+		return XMVectorGetX(d) <= XMVectorGetX(epsilon) &&
+			XMVectorGetY(d) <= XMVectorGetY(epsilon) &&
+			XMVectorGetZ(d) <= XMVectorGetZ(epsilon);
+	}
+
+	inline bool O_MATH_CALLCONV XMVector4NearEqual(FXMVECTOR a, FXMVECTOR b, FXMVECTOR epsilon) noexcept
+	{
+		return XMVector3NearEqual(a, b, epsilon) &&
+			std::fabs(XMVectorGetW(a) - XMVectorGetW(b)) <= XMVectorGetW(epsilon);
+	}
+
+	// Planes are (a, b, c, d) with a * x + b * y + c * z + d = 0
+
+	inline XMVECTOR O_MATH_CALLCONV XMPlaneNormalize(FXMVECTOR p) noexcept
+	{
+		const float length = XMVectorGetX(XMVector3Length(p));
+		return length > 0.0f ? XMVectorScale(p, 1.0f / length) : XMVectorZero();
+	}
+
+	inline XMVECTOR O_MATH_CALLCONV XMPlaneDotCoord(FXMVECTOR p, FXMVECTOR v) noexcept
+	{
+		return XMVectorAdd(XMVector3Dot(p, v), XMVectorSplatW(p));
+	}
+
+	// Matrices, stored as four row vectors
+
+	struct alignas(16) XMMATRIX
+	{
+		XMVECTOR r[4];
+		XMMATRIX() = default;
+		XMMATRIX(FXMVECTOR r0, FXMVECTOR r1, FXMVECTOR r2, CXMVECTOR r3) noexcept
+			:
+			r{ r0, r1, r2, r3 }
+		{
+		}
+		XMMATRIX(float m00, float m01, float m02, float m03,
+			float m10, float m11, float m12, float m13,
+			float m20, float m21, float m22, float m23,
+			float m30, float m31, float m32, float m33) noexcept
+			:
+			r{ XMVectorSet(m00, m01, m02, m03), XMVectorSet(m10, m11, m12, m13),
+				XMVectorSet(m20, m21, m22, m23), XMVectorSet(m30, m31, m32, m33) }
+		{
+		}
+		XMMATRIX operator*(const XMMATRIX& rhs) const noexcept;
+		XMMATRIX& operator*=(const XMMATRIX& rhs) noexcept;
+	};
+	using FXMMATRIX = const XMMATRIX&;
+	using CXMMATRIX = const XMMATRIX&;
+
+	inline XMMATRIX O_MATH_CALLCONV XMLoadFloat4x4(const XMFLOAT4X4* pSource) noexcept
+	{
+		XMMATRIX m;
+		for (int i = 0; i < 4; i++)
+		{
+			m.r[i] = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pSource->m[i]));
+		}
+		return m;
+	}
+
+	inline void O_MATH_CALLCONV XMStoreFloat4x4(XMFLOAT4X4* pDestination, FXMMATRIX m) noexcept
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(pDestination->m[i]), m.r[i]);
+		}
+	}
+
+	// v * m
+	inline XMVECTOR O_MATH_CALLCONV XMVector4Transform(FXMVECTOR v, FXMMATRIX m) noexcept
+	{
+		XMVECTOR r = XMVectorMultiply(XMVectorSplatX(v), m.r[0]);
+		r = XMVectorMultiplyAdd(XMVectorSplatY(v), m.r[1], r);
+		r = XMVectorMultiplyAdd(XMVectorSplatZ(v), m.r[2], r);
+		return XMVectorMultiplyAdd(XMVectorSplatW(v), m.r[3], r);
+	}
+
+	// (x, y, z, 1) * m, divided by w
+	inline XMVECTOR O_MATH_CALLCONV XMVector3TransformCoord(FXMVECTOR v, FXMMATRIX m) noexcept
+	{
+		XMVECTOR r = XMVectorMultiplyAdd(XMVectorSplatX(v), m.r[0], m.r[3]);
+		r = XMVectorMultiplyAdd(XMVectorSplatY(v), m.r[1], r);
+		r = XMVectorMultiplyAdd(XMVectorSplatZ(v), m.r[2], r);
+		return XMVectorDivide(r, XMVectorSplatW(r));
+	}
+
+	// (x, y, z, 0) * m
+	inline XMVECTOR O_MATH_CALLCONV XMVector3TransformNormal(FXMVECTOR v, FXMMATRIX m) noexcept
+	{
+		XMVECTOR r = XMVectorMultiply(XMVectorSplatX(v), m.r[0]);
+		r = XMVectorMultiplyAdd(XMVectorSplatY(v), m.r[1], r);
+		return XMVectorMultiplyAdd(XMVectorSplatZ(v), m.r[2], r);
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixMultiply(FXMMATRIX a, CXMMATRIX b) noexcept
+	{
+		return {
+			XMVector4Transform(a.r[0], b),
+			XMVector4Transform(a.r[1], b),
+			XMVector4Transform(a.r[2], b),
+			XMVector4Transform(a.r[3], b),
+		};
+	}
+
+	inline XMMATRIX XMMATRIX::operator*(const XMMATRIX& rhs) const noexcept
+	{
+		return XMMatrixMultiply(*this, rhs);
+	}
+
+	inline XMMATRIX& XMMATRIX::operator*=(const XMMATRIX& rhs) noexcept
+	{
+		*this = XMMatrixMultiply(*this, rhs);
+		return *this;
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixIdentity() noexcept
+	{
+		return {
+			XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f),
+			XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f),
+			XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f),
+			XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f),
+		};
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixTranspose(FXMMATRIX m) noexcept
+	{
+#if defined(O_MATH_SSE)
+		XMMATRIX t = m;
+		_MM_TRANSPOSE4_PS(t.r[0], t.r[1], t.r[2], t.r[3]);
+		return t;
+#else
+		XMFLOAT4X4 f;
+		XMStoreFloat4x4(&f, m);
+		return {
+			f.m[0][0], f.m[1][0], f.m[2][0], f.m[3][0],
+			f.m[0][1], f.m[1][1], f.m[2][1], f.m[3][1],
+			f.m[0][2], f.m[1][2], f.m[2][2], f.m[3][2],
+			f.m[0][3], f.m[1][3], f.m[2][3], f.m[3][3],
+		};
+#endif
+	}
+
+	// general inverse through cofactors, pDeterminant may be null; a singular
+	// matrix gives infinities as in DirectXMath
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixInverse(XMVECTOR* pDeterminant, FXMMATRIX m) noexcept
+	{
+		XMFLOAT4X4 f;
+		XMStoreFloat4x4(&f, m);
+		const float (&a)[4][4] = f.m;
+		const float s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+		const float s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+		const float s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+		const float s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+		const float s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+		const float s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+		const float c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+		const float c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+		const float c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+		const float c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+		const float c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+		const float c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+		const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		if (pDeterminant)
+		{
+			*pDeterminant = XMVectorReplicate(det);
+		}
+		const float inv = 1.0f / det;
+		return {
+			(a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * inv,
+			(-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * inv,
+			(a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * inv,
+			(-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * inv,
+
+			(-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * inv,
+			(a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * inv,
+			(-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * inv,
+			(a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * inv,
+
+			(a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * inv,
+			(-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * inv,
+			(a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * inv,
+			(-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * inv,
+
+			(-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * inv,
+			(a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * inv,
+			(-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * inv,
+			(a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * inv,
+		};
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixTranslation(float x, float y, float z) noexcept
+	{
+		return {
+			1.0f, 0.0f, 0.0f, 0.0f,
+			0.0f, 1.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, 1.0f, 0.0f,
+			x, y, z, 1.0f,
+		};
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixScaling(float x, float y, float z) noexcept
+	{
+		return {
+			x, 0.0f, 0.0f, 0.0f,
+			0.0f, y, 0.0f, 0.0f,
+			0.0f, 0.0f, z, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f,
+		};
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixRotationX(float angle) noexcept
+	{
+		const float s = std::sin(angle);
+		const float c = std::cos(angle);
+		return {
+			1.0f, 0.0f, 0.0f, 0.0f,
+			0.0f, c, s, 0.0f,
+			0.0f, -s, c, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f,
+		};
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixRotationY(float angle) noexcept
+	{
+		const float s = std::sin(angle);
+		const float c = std::cos(angle);
+		return {
+			c, 0.0f, -s, 0.0f,
+			0.0f, 1.0f, 0.0f, 0.0f,
+			s, 0.0f, c, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f,
+		};
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixRotationZ(float angle) noexcept
+	{
+		const float s = std::sin(angle);
+		const float c = std::cos(angle);
+		return {
+			c, s, 0.0f, 0.0f,
+			-s, c, 0.0f, 0.0f,
+			0.0f, 0.0f, 1.0f, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f,
+		};
+	}
+
+	// roll about z, then pitch about x, then yaw about y
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixRotationRollPitchYaw(float pitch, float yaw, float roll) noexcept
+	{
+		return XMMatrixRotationZ(roll) * XMMatrixRotationX(pitch) * XMMatrixRotationY(yaw);
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixPerspectiveLH(float viewWidth, float viewHeight, float nearZ, float farZ) noexcept
+	{
+		const float twoNear = nearZ + nearZ;
+		const float range = farZ / (farZ - nearZ);
+		return {
+			twoNear / viewWidth, 0.0f, 0.0f, 0.0f,
+			0.0f, twoNear / viewHeight, 0.0f, 0.0f,
+			0.0f, 0.0f, range, 1.0f,
+			0.0f, 0.0f, -range * nearZ, 0.0f,
+		};
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixPerspectiveFovLH(float fovAngleY, float aspectRatio, float nearZ, float farZ) noexcept
+	{
+		const float height = std::cos(0.5f * fovAngleY) / std::sin(0.5f * fovAngleY);
+		const float width = height / aspectRatio;
+		const float range = farZ / (farZ - nearZ);
+		return {
+			width, 0.0f, 0.0f, 0.0f,
+			0.0f, height, 0.0f, 0.0f,
+			0.0f, 0.0f, range, 1.0f,
+			0.0f, 0.0f, -range * nearZ, 0.0f,
+		};
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixLookToLH(FXMVECTOR eyePosition, FXMVECTOR eyeDirection, FXMVECTOR upDirection) noexcept
+	{
+		const XMVECTOR r2 = XMVector3Normalize(eyeDirection);
+		const XMVECTOR r0 = XMVector3Normalize(XMVector3Cross(upDirection, r2));
+		const XMVECTOR r1 = XMVector3Cross(r2, r0);
+		const XMVECTOR negEye = XMVectorNegate(eyePosition);
+		const float d0 = XMVectorGetX(XMVector3Dot(r0, negEye));
+		const float d1 = XMVectorGetX(XMVector3Dot(r1, negEye));
+		const float d2 = XMVectorGetX(XMVector3Dot(r2, negEye));
+		return {
+			XMVectorGetX(r0), XMVectorGetX(r1), XMVectorGetX(r2), 0.0f,
+			XMVectorGetY(r0), XMVectorGetY(r1), XMVectorGetY(r2), 0.0f,
+			XMVectorGetZ(r0), XMVectorGetZ(r1), XMVectorGetZ(r2), 0.0f,
+			d0, d1, d2, 1.0f,
+		};
+	}
+
+	inline XMMATRIX O_MATH_CALLCONV XMMatrixLookAtLH(FXMVECTOR eyePosition, FXMVECTOR focusPosition, FXMVECTOR upDirection) noexcept
+	{
+		return XMMatrixLookToLH(eyePosition, XMVectorSubtract(focusPosition, eyePosition), upDirection);
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "Memory/LinearArena.h"
+#include <array>
+#include <cstdint>
+
+namespace Memory
+{
+	// Heap traffic of the whole process since it started, every thread. The
+	// global operator new and delete are replaced to count, all of their
+	// forms; malloc and friends called directly are not counted.
+	// O_NO_PROFILE leaves the allocator alone and these stay 0.
+	struct HeapCounts
+	{
+		uint64_t allocations = 0u;
+		uint64_t frees = 0u;
+		uint64_t bytes = 0u;
+	};
+	HeapCounts GetHeapCounts() noexcept;
+
+	// Allocations per frame: heap calls from any thread between two
+	// AddFrame calls, and what the frame arena took. Format writes into an
+	// internal buffer, nothing here allocates.
+	class AllocationCounter
+	{
+	public:
+		struct Frame
+		{
+			uint64_t heapAllocations = 0u;
+			uint64_t heapBytes = 0u;
+			size_t arenaAllocations = 0u;
+			size_t arenaBytes = 0u;
+			size_t arenaOverflows = 0u;
+		};
+		struct Summary
+		{
+			uint64_t frames = 0u;
+			double heapAllocationsPerFrame = 0.0;
+			double heapBytesPerFrame = 0.0;
+			uint64_t maxHeapAllocations = 0u;
+			double arenaAllocationsPerFrame = 0.0;
+			double arenaBytesPerFrame = 0.0;
+			size_t arenaOverflows = 0u;
+		};
+	public:
+		AllocationCounter() noexcept;
+		// call once per frame with the frame arena's stats for the frame that ended
+		void AddFrame(const LinearArena::Stats& arena) noexcept;
+		const Frame& GetLastFrame() const noexcept;
+		// everything since the last Reset
+		Summary GetSummary() const noexcept;
+		// one line summary of the last frame, stays valid until the next call
+		const char* Format() noexcept;
+		void Reset() noexcept;
+	private:
+		HeapCounts last;
+		Frame lastFrame;
+		Frame total;
+		uint64_t frames = 0u;
+		uint64_t maxHeapAllocations = 0u;
+		std::array<char, 64> text = {};
+	};
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Memory
+{
+	// Fixed-size blocks handed out from pages through an intrusive free
+	// list, so allocating and freeing are a pointer swap each and nodes of
+	// one container end up next to each other. Pages are only returned when
+	// the pool is destroyed. Not thread safe.
+	class BlockPool
+	{
+	public:
+		struct Stats
+		{
+			size_t allocations = 0u;
+			size_t frees = 0u;
+			size_t live = 0u;
+			size_t peakLive = 0u;
+			size_t pages = 0u;
+		};
+	public:
+		// blockSize is rounded up to a multiple of alignment, a power of two
+		BlockPool(size_t blockSize, size_t blocksPerPage = 256u, size_t alignment = alignof(std::max_align_t));
+		BlockPool(const BlockPool&) = delete;
+		BlockPool& operator=(const BlockPool&) = delete;
+		void* Allocate();
+		// p must have come from this pool
+		void Free(void* p) noexcept;
+		template<typename T, typename... Args>
+		T* New(Args&&... args)
+		{
+			if (sizeof(T) > blockSize || alignof(T) > alignment)
+			{
+				throw std::bad_alloc();
+			}
+			void* p = Allocate();
+			try
+			{
+				return new(p) T(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				Free(p);
+				throw;
+			}
+		}
+		template<typename T>
+		void Delete(T* p) noexcept
+		{
+			if (p)
+			{
+				p->~T();
+				Free(p);
+			}
+		}
+		size_t GetBlockSize() const noexcept;
+		size_t GetAlignment() const noexcept;
+		const Stats& GetStats() const noexcept;
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* pNext;
+		};
+		void AddPage();
+	private:
+		std::vector<std::unique_ptr<std::byte[]>> pages;
+		FreeBlock* pFree = nullptr;
+		size_t blockSize;
+		size_t blocksPerPage;
+		size_t alignment;
+		Stats stats;
+	};
+}
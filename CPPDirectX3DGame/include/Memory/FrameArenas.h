@@ -0,0 +1,31 @@
+#pragma once
+#include "Memory/LinearArena.h"
+#include "Memory/MemoryResource.h"
+#include <array>
+#include <cstddef>
+
+namespace Memory
+{
+	// Double-buffered per-frame memory. BeginFrame switches to the other
+	// arena and resets it, so whatever a frame allocated stays valid through
+	// the next one, long enough for the renderer to consume a snapshot while
+	// the simulation fills the next. Belongs to the thread that simulates.
+	class FrameArenas
+	{
+	public:
+		static constexpr size_t frameCount = 2u;
+	public:
+		explicit FrameArenas(size_t capacity);
+		void BeginFrame();
+		LinearArena& Get() noexcept;
+		// for std::pmr containers that live until the end of the next frame
+		std::pmr::memory_resource* GetResource() noexcept;
+		// what the frame before this one allocated
+		const LinearArena::Stats& GetLastFrameStats() const noexcept;
+	private:
+		std::array<LinearArena, frameCount> arenas;
+		std::array<ArenaResource, frameCount> resources;
+		size_t current = 0u;
+		LinearArena::Stats lastFrame;
+	};
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Memory
+{
+	// Bump allocator: an allocation is an aligned pointer increment and
+	// nothing is freed on its own, Reset or Rewind take everything back at
+	// once. When the block runs out another one is taken from the heap and
+	// counted as an overflow; the next Reset merges them into one block of
+	// the size actually needed, so a steady workload stops overflowing after
+	// its first frame. Not thread safe, and nothing allocated here has its
+	// destructor run, hence the trivially destructible types only.
+	class LinearArena
+	{
+	public:
+		struct Marker
+		{
+			size_t block;
+			size_t offset;
+		};
+		struct Stats
+		{
+			// since the last Reset
+			size_t allocations = 0u;
+			size_t bytes = 0u;
+			size_t overflows = 0u;
+			size_t capacity = 0u;
+		};
+	public:
+		explicit LinearArena(size_t capacity);
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+		// alignment must be a power of two
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		template<typename T>
+		T* AllocateArray(size_t count)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "arena memory is never destroyed");
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+		Marker GetMarker() const noexcept;
+		// frees everything allocated after marker, the blocks are kept
+		void Rewind(Marker marker) noexcept;
+		void Reset();
+		const Stats& GetStats() const noexcept;
+	private:
+		struct Block
+		{
+			std::unique_ptr<std::byte[]> pData;
+			size_t size;
+		};
+	private:
+		std::vector<Block> blocks;
+		size_t current = 0u;
+		size_t offset = 0u;
+		Stats stats;
+	};
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Memory/BlockPool.h"
+#include "Memory/LinearArena.h"
+#include <memory_resource>
+
+namespace Memory
+{
+	// std::pmr views of the allocators, so std::pmr::vector, string, list
+	// and the rest can draw from them without changing their code.
+
+	// deallocation does nothing, the arena's Reset or Rewind frees
+	class ArenaResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit ArenaResource(LinearArena& arena) noexcept;
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	private:
+		LinearArena* pArena;
+	};
+
+	// Requests that fit a block come from the pool, anything larger from
+	// upstream; node based containers only ever ask for their node size.
+	class PoolResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit PoolResource(BlockPool& pool, std::pmr::memory_resource* pUpstream = std::pmr::new_delete_resource()) noexcept;
+	private:
+		bool Fits(size_t bytes, size_t alignment) const noexcept;
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	private:
+		BlockPool* pPool;
+		std::pmr::memory_resource* pUpstream;
+	};
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Memory/LinearArena.h"
+#include "Memory/MemoryResource.h"
+#include <cstddef>
+
+namespace Memory
+{
+	// Thread-local scratch memory for work that is done before the scope
+	// that asked for it ends: a Scratch marks its thread's arena and rewinds
+	// it on destruction, so nested scopes stack. The arena is created on
+	// first use, 256KB per thread, and grows to what the busiest outermost
+	// scope needed once that scope ends. Scratch memory must not leave the
+	// scope or the thread.
+	class Scratch
+	{
+	public:
+		static constexpr size_t initialCapacity = 256u * 1024u;
+	public:
+		Scratch();
+		~Scratch();
+		Scratch(const Scratch&) = delete;
+		Scratch& operator=(const Scratch&) = delete;
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		template<typename T>
+		T* AllocateArray(size_t count)
+		{
+			return arena.AllocateArray<T>(count);
+		}
+		// for std::pmr containers that live inside the scope
+		std::pmr::memory_resource* GetResource() noexcept;
+	private:
+		LinearArena& arena;
+		LinearArena::Marker marker;
+		ArenaResource resource;
+	};
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "Exception/OException.h"
+#include "Math/OMath.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Indexed triangle list as it comes out of an importer: float positions,
+// normals and texture coordinates, 32-bit indices. Load reads Wavefront
+// OBJ, and glTF 2.0 as .gltf with embedded or external buffers or as .glb;
+// every triangle primitive of a glTF scene goes into the one mesh with its
+// node transforms applied. Texture coordinates have their origin top left
+// as D3D samples them, files without normals get smooth ones. Importers
+// weld, so equal vertices are shared whatever the file did.
+class Mesh
+{
+public:
+	class Exception : public OException
+	{
+	public:
+		Exception(int line, const char* file, std::string note) noexcept;
+		const char* what() const noexcept override;
+		const char* GetType() const noexcept override;
+		const std::string& GetNote() const noexcept;
+	private:
+		std::string note;
+	};
+	struct Vertex
+	{
+		OMath::XMFLOAT3 position;
+		OMath::XMFLOAT3 normal;
+		OMath::XMFLOAT2 uv;
+	};
+public:
+	Mesh() = default;
+	// throws if an index is out of range or the count is not a multiple of 3
+	Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices);
+	// by extension: .obj, .gltf or .glb; throws for anything else
+	static Mesh Load(const std::string& path);
+	static Mesh ParseObj(std::string_view text);
+	// external buffers are read relative to directory
+	static Mesh ParseGltf(const std::byte* pData, size_t size, const std::string& directory);
+	const std::vector<Vertex>& GetVertices() const noexcept;
+	std::vector<Vertex>& GetVertices() noexcept;
+	const std::vector<uint32_t>& GetIndices() const noexcept;
+	std::vector<uint32_t>& GetIndices() noexcept;
+	size_t GetTriangleCount() const noexcept;
+	// merges bitwise equal vertices, drops unused ones; returns how many went
+	size_t Weld();
+	// area weighted, per position so welded seams stay smooth
+	void ComputeNormals();
+private:
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+};
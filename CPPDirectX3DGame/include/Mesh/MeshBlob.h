@@ -0,0 +1,98 @@
+#pragma once
+#include "Mesh/Mesh.h"
+#include "Mesh/MeshOptimize.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A mesh ready for upload: a small header, then the vertex and index
+// buffers exactly as the input assembler reads them, each 16 byte aligned.
+// The file is the blob's own memory, so Load is one read and no parsing
+// past checking the header. Cook runs the MeshOptimize passes and packs
+// the vertices; the compact format quantizes them to half the size of the
+// float one, and the vertex shader undoes it with the scales and offsets
+// the header carries. Indices are 16-bit whenever the vertices fit.
+class MeshBlob
+{
+public:
+	enum class Format
+	{
+		// 32 bytes: float3 position, float3 normal, float2 texture coordinates
+		Float,
+		// 16 bytes: 16-bit unorm position over the bounds, octahedral 16-bit
+		// snorm normal, 16-bit unorm texture coordinates over their range
+		Compact,
+	};
+	struct Options
+	{
+		Format format = Format::Compact;
+		bool optimize = true;
+		MeshOptimize::CacheAlgorithm cache = MeshOptimize::CacheAlgorithm::Forsyth;
+		bool overdraw = true;
+		float overdrawThreshold = 1.05f;
+		// fill Stats with the before and after measurements
+		bool analyze = true;
+	};
+	// one D3D11_INPUT_ELEMENT_DESC in all but name, formats are DXGI_FORMAT values
+	struct Attribute
+	{
+		const char* semantic;
+		uint32_t format;
+		uint32_t offset;
+	};
+	struct Stats
+	{
+		MeshOptimize::CacheStats cacheBefore;
+		MeshOptimize::CacheStats cacheAfter;
+		MeshOptimize::FetchStats fetchBefore;
+		MeshOptimize::FetchStats fetchAfter;
+		MeshOptimize::OverdrawStats overdrawBefore;
+		MeshOptimize::OverdrawStats overdrawAfter;
+		// largest distance of a decoded position from the source, in mesh units
+		float maxPositionError = 0.0f;
+		double optimizeSeconds = 0.0;
+	};
+public:
+	static MeshBlob Cook(const Mesh& mesh, const Options& options);
+	// throws Mesh::Exception if the file cannot be read or is not a blob
+	static MeshBlob Load(const std::string& path);
+	static MeshBlob Parse(std::vector<std::byte> data);
+	// throws Mesh::Exception if the file cannot be written
+	void Write(const std::string& path) const;
+	Format GetFormat() const noexcept;
+	uint32_t GetStride() const noexcept;
+	uint32_t GetVertexCount() const noexcept;
+	uint32_t GetIndexCount() const noexcept;
+	// DXGI_FORMAT_R16_UINT or DXGI_FORMAT_R32_UINT
+	uint32_t GetIndexFormat() const noexcept;
+	const std::byte* GetVertexData() const noexcept;
+	const std::byte* GetIndexData() const noexcept;
+	size_t GetVertexBytes() const noexcept;
+	size_t GetIndexBytes() const noexcept;
+	// the whole file
+	const std::vector<std::byte>& GetData() const noexcept;
+	std::vector<Attribute> GetLayout() const;
+	// position = stored * scale + offset, likewise texture coordinates;
+	// 1 and 0 for the float format
+	OMath::XMFLOAT3 GetPositionScale() const noexcept;
+	OMath::XMFLOAT3 GetPositionOffset() const noexcept;
+	OMath::XMFLOAT2 GetUvScale() const noexcept;
+	OMath::XMFLOAT2 GetUvOffset() const noexcept;
+	OMath::XMFLOAT3 GetBoundsMin() const noexcept;
+	OMath::XMFLOAT3 GetBoundsMax() const noexcept;
+	// vertex and index bytes per vertex, index bytes spread over the vertices
+	float GetBytesPerVertex() const noexcept;
+	// only filled in by Cook
+	const Stats& GetStats() const noexcept;
+	// the mesh as the vertex shader will see it
+	Mesh Decode() const;
+	static const char* GetFormatName(Format format) noexcept;
+private:
+	MeshBlob() = default;
+	struct Header;
+	Header GetHeader() const noexcept;
+private:
+	std::vector<std::byte> data;
+	Stats stats;
+};
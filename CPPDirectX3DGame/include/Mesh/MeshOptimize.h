@@ -0,0 +1,67 @@
+#pragma once
+#include "Mesh/Mesh.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Reordering of a mesh for the GPU front end, in the order the passes are
+// meant to run: triangles for the post-transform vertex cache, clusters of
+// those triangles for overdraw, then the vertices into the order the index
+// buffer first reads them. None of them change what is drawn. The Analyze
+// functions measure the three effects on a model of the hardware, so a
+// cook can report what each pass bought.
+namespace MeshOptimize
+{
+	enum class CacheAlgorithm
+	{
+		// Forsyth's scoring over a 32 entry LRU cache; holds up on whatever
+		// cache the GPU really has, small ones included
+		Forsyth,
+		// Sander, Nehab and Barczak's fans around cached vertices for a 16
+		// entry FIFO; faster to run and lower ACMR on caches of 16 or more,
+		// worse on smaller ones
+		Tipsify,
+	};
+
+	struct CacheStats
+	{
+		// vertex shader runs per triangle, 0.5 is the floor for a grid
+		float acmr = 0.0f;
+		// vertex shader runs per referenced vertex, 1.0 is perfect
+		float atvr = 0.0f;
+		size_t transformed = 0u;
+	};
+
+	struct FetchStats
+	{
+		// bytes read from memory over the bytes of the referenced vertices
+		float overfetch = 0.0f;
+		size_t bytesFetched = 0u;
+	};
+
+	struct OverdrawStats
+	{
+		// pixels shaded over pixels covered, 1.0 means nothing drawn twice
+		float overdraw = 0.0f;
+		size_t covered = 0u;
+		size_t shaded = 0u;
+	};
+
+	void OptimizeVertexCache(Mesh& mesh, CacheAlgorithm algorithm);
+	// Splits the cache ordered triangle list where the cache starts over
+	// anyway, and where a split costs at most threshold times the ACMR, then
+	// draws the clusters that face away from the center first. Run it after
+	// OptimizeVertexCache.
+	void OptimizeOverdraw(Mesh& mesh, float threshold = 1.05f);
+	// vertices in order of first use by the index buffer
+	void OptimizeVertexFetch(Mesh& mesh);
+
+	// a FIFO cache of cacheSize entries, as most GPUs behave near enough
+	CacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize = 16u);
+	// fetches on cache misses through 64 byte lines held in a 16KB LRU cache
+	FetchStats AnalyzeVertexFetch(const std::vector<uint32_t>& indices, size_t vertexCount, size_t vertexSize);
+	// Rasterizes the mesh at 256x256 from the six axis directions with back
+	// faces culled and a depth test, counting pixels that pass the test
+	// against pixels with anything on them.
+	OverdrawStats AnalyzeOverdraw(const Mesh& mesh);
+}
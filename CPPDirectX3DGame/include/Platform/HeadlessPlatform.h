@@ -0,0 +1,60 @@
+#pragma once
+#include "Platform/Platform.h"
+#include "Input/Keyboard.h"
+#include "Input/Mouse.h"
+#include "Render/Software/SoftwareRasterizer.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Platform with no display. Renders into the software rasterizer, takes
+// input only from code (InputReplay, tests) and runs until RequestQuit;
+// App::SetFrameLimit ends a run after a fixed number of frames.
+class HeadlessPlatform : public Platform
+{
+private:
+	// forwards to the rasterizer and counts presented frames
+	class Renderer : public RenderBackend
+	{
+	public:
+		Renderer(HeadlessPlatform& parent) noexcept;
+		void ClearBuffer(float red, float green, float blue) noexcept override;
+		void DrawIndexed(const Vertex* pVertices, size_t vertexCount, const unsigned short* pIndices, size_t indexCount) override;
+		void EndFrame() override;
+		void SetJobs(JobSystem* pJobs) noexcept override;
+		unsigned int GetWidth() const noexcept override;
+		unsigned int GetHeight() const noexcept override;
+	private:
+		HeadlessPlatform& parent;
+	};
+public:
+	HeadlessPlatform(int width, int height);
+	std::optional<int> ProcessMessages() override;
+	void SetTitle(const char* title) override;
+	void Resize(int width, int height) override;
+	int GetWidth() const noexcept override;
+	int GetHeight() const noexcept override;
+	void EnableCursor() noexcept override;
+	void DisableCursor() noexcept override;
+	bool IsCursorEnabled() const noexcept override;
+	Keyboard& GetKeyboard() noexcept override;
+	Mouse& GetMouse() noexcept override;
+	RenderBackend& GetRenderer() override;
+	void RequestQuit(int exitCode = 0) noexcept;
+	uint64_t GetPresentedFrames() const noexcept;
+	const char* GetTitle() const noexcept;
+	SoftwareRasterizer& GetRasterizer() noexcept;
+private:
+	// kept for the rasterizer Resize makes
+	JobSystem* pJobs = nullptr;
+	std::atomic<uint64_t> presented = 0u;
+	std::atomic<bool> quit = false;
+	std::atomic<int> exitCode = 0;
+	bool cursorEnabled = true;
+	std::array<char, 256> title = {};
+	Keyboard keyboard;
+	Mouse mouse;
+	std::unique_ptr<SoftwareRasterizer> pRasterizer;
+	Renderer renderer;
+};
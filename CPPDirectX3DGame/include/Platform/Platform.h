@@ -0,0 +1,32 @@
+#pragma once
+#include <optional>
+
+class Keyboard;
+class Mouse;
+class RenderBackend;
+
+// Everything App needs from the operating system: message pumping, the
+// window's size, cursor and title, input devices and somewhere to render.
+// Win32Platform wraps the real window, HeadlessPlatform runs the same loop
+// with no display so it builds and runs anywhere.
+class Platform
+{
+public:
+	Platform() = default;
+	virtual ~Platform() = default;
+	Platform(const Platform&) = delete;
+	Platform& operator=(const Platform&) = delete;
+	// handle pending messages without blocking, has a value when the app should exit
+	virtual std::optional<int> ProcessMessages() = 0;
+	virtual void SetTitle(const char* title) = 0;
+	// client area in pixels
+	virtual void Resize(int width, int height) = 0;
+	virtual int GetWidth() const noexcept = 0;
+	virtual int GetHeight() const noexcept = 0;
+	virtual void EnableCursor() noexcept = 0;
+	virtual void DisableCursor() noexcept = 0;
+	virtual bool IsCursorEnabled() const noexcept = 0;
+	virtual Keyboard& GetKeyboard() noexcept = 0;
+	virtual Mouse& GetMouse() noexcept = 0;
+	virtual RenderBackend& GetRenderer() = 0;
+};
@@ -0,0 +1,23 @@
+#pragma once
+#include "Platform/Platform.h"
+#include "Window/Window.h"
+
+class Win32Platform : public Platform
+{
+public:
+	Win32Platform(int width, int height, const char* name);
+	std::optional<int> ProcessMessages() override;
+	void SetTitle(const char* title) override;
+	void Resize(int width, int height) override;
+	int GetWidth() const noexcept override;
+	int GetHeight() const noexcept override;
+	void EnableCursor() noexcept override;
+	void DisableCursor() noexcept override;
+	bool IsCursorEnabled() const noexcept override;
+	Keyboard& GetKeyboard() noexcept override;
+	Mouse& GetMouse() noexcept override;
+	RenderBackend& GetRenderer() override;
+	Window& GetWindow() noexcept;
+private:
+	Window window;
+};
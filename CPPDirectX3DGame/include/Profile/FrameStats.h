@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Rolling frame time statistics over the last windowSize frames, all in
+// fixed storage. AddFrame reports when the configured update interval has
+// passed so callers can refresh a title or overlay at a bounded rate, Format
+// writes into an internal buffer. Nothing here allocates after construction.
+class FrameStats
+{
+public:
+	static constexpr size_t windowSize = 256u;
+	static constexpr size_t nBins = 34u;
+	struct Summary
+	{
+		size_t count = 0u;
+		float minMs = 0.0f;
+		float avgMs = 0.0f;
+		float p50Ms = 0.0f;
+		float p95Ms = 0.0f;
+		float p99Ms = 0.0f;
+		float maxMs = 0.0f;
+		float fps = 0.0f;
+	};
+public:
+	FrameStats(float updateInterval = 0.5f, float binWidthMs = 1.0f) noexcept;
+	// true when an update is due, at most once per update interval
+	bool AddFrame(float seconds) noexcept;
+	// percentiles are computed here, call it at the update rate
+	const Summary& Update() noexcept;
+	const Summary& GetSummary() const noexcept;
+	// bin i counts frames in [i, i + 1) bin widths, the last bin everything above
+	const std::array<uint32_t, nBins>& GetHistogram() const noexcept;
+	float GetBinWidthMs() const noexcept;
+	// one line summary, stays valid until the next call
+	const char* Format() noexcept;
+	void SetUpdateInterval(float seconds) noexcept;
+	uint64_t GetFrameCount() const noexcept;
+	void Reset() noexcept;
+private:
+	size_t BinOf(float ms) const noexcept;
+private:
+	std::array<float, windowSize> samples = {};
+	std::array<float, windowSize> sorted = {};
+	std::array<uint32_t, nBins> histogram = {};
+	std::array<char, 128> text = {};
+	size_t next = 0u;
+	size_t count = 0u;
+	uint64_t frames = 0u;
+	float updateInterval;
+	float sinceUpdate = 0.0f;
+	float binWidthMs;
+	Summary summary;
+};
@@ -0,0 +1,154 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Hierarchical CPU profiler. Scopes are recorded into a ring per thread that
+// only the owning thread writes, EndFrame drains all rings on the main thread,
+// folds them into a per-frame summary and optionally keeps them for a Chrome
+// trace (chrome://tracing, Perfetto) written with WriteChromeTrace.
+class Profiler
+{
+public:
+	struct Event
+	{
+		// string literal, compared by address
+		const char* name;
+		int64_t begin;
+		int64_t end;
+		uint32_t depth;
+	};
+	struct Entry
+	{
+		const char* name;
+		uint32_t depth;
+		uint32_t calls;
+		double seconds;
+	};
+	struct Stats
+	{
+		uint64_t frames = 0u;
+		uint64_t events = 0u;
+		// writes that found their ring full
+		uint64_t dropped = 0u;
+		uint64_t captured = 0u;
+		size_t threads = 0u;
+	};
+private:
+	class ThreadRing
+	{
+	public:
+		ThreadRing(size_t capacity, uint32_t threadIndex);
+		void Push(const Event& e) noexcept;
+		template<typename F>
+		void Drain(F&& f)
+		{
+			const size_t h = head.load(std::memory_order_acquire);
+			size_t t = tail.load(std::memory_order_relaxed);
+			for (; t != h; t++)
+			{
+				f(events[t & mask]);
+			}
+			tail.store(t, std::memory_order_release);
+		}
+	public:
+		const uint32_t threadIndex;
+		std::string name;
+		uint32_t depth = 0u;
+		std::atomic<uint64_t> dropped = 0u;
+	private:
+		std::unique_ptr<Event[]> events;
+		const size_t mask;
+		alignas(64) std::atomic<size_t> head = 0u;
+		alignas(64) std::atomic<size_t> tail = 0u;
+	};
+public:
+	static int64_t Now() noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	// called at scope entry/exit, returns the depth of the scope
+	static uint32_t Enter() noexcept;
+	static void Leave(const char* name, int64_t begin, uint32_t depth) noexcept;
+	static void SetThreadName(const char* name);
+	// events per thread, rounded up to a power of two, applies to rings
+	// created afterwards; a thread that takes over the ring of one that has
+	// exited keeps that ring's capacity
+	static void SetRingCapacity(size_t capacity) noexcept;
+	// drain all threads and rebuild the frame summary, main thread only
+	static void EndFrame();
+	// scopes of the last frame in order of first appearance
+	static const std::vector<Entry>& GetFrame() noexcept;
+	static Stats GetStats() noexcept;
+	// keep drained events for export, up to maxEvents
+	static void BeginCapture(size_t maxEvents = 1u << 20);
+	static void EndCapture() noexcept;
+	static bool IsCapturing() noexcept;
+	// Chrome trace-event JSON, false if the file could not be written
+	static bool WriteChromeTrace(const std::string& path);
+private:
+	// hands the ring of a thread back for reuse when the thread exits
+	struct RingOwner
+	{
+		ThreadRing* pRing = nullptr;
+		~RingOwner();
+	};
+private:
+	static ThreadRing& GetThreadRing();
+	static void Collect(const ThreadRing& ring, const Event& e);
+private:
+	static std::mutex mtx;
+	static std::vector<std::unique_ptr<ThreadRing>> rings;
+	// rings of exited threads, drained by EndFrame as usual until taken over
+	static std::vector<ThreadRing*> freeRings;
+	static std::atomic<size_t> ringCapacity;
+	static std::vector<Entry> frame;
+	static std::vector<std::pair<uint32_t, Event>> capture;
+	static size_t captureLimit;
+	static bool capturing;
+	static int64_t captureStart;
+	static Stats stats;
+};
+
+class ProfileScope
+{
+public:
+	ProfileScope(const char* name) noexcept
+		:
+		name(name),
+		depth(Profiler::Enter()),
+		begin(Profiler::Now())
+	{}
+	~ProfileScope()
+	{
+		Profiler::Leave(name, begin, depth);
+	}
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+	const char* name;
+	uint32_t depth;
+	int64_t begin;
+};
+
+#define O_PROFILE_CONCAT_IMPL(a, b) a##b
+#define O_PROFILE_CONCAT(a, b) O_PROFILE_CONCAT_IMPL(a, b)
+
+// O_NO_PROFILE (ReleaseNoProfile) removes every marker from the build
+#ifndef O_NO_PROFILE
+#define O_PROFILE_SCOPE(name) ProfileScope O_PROFILE_CONCAT(profileScope, __LINE__){ name }
+#define O_PROFILE_FUNCTION() O_PROFILE_SCOPE(__FUNCTION__)
+#define O_PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#define O_PROFILE_END_FRAME() Profiler::EndFrame()
+#else
+#define O_PROFILE_SCOPE(name)
+#define O_PROFILE_FUNCTION()
+#define O_PROFILE_THREAD(name)
+#define O_PROFILE_END_FRAME()
+#endif
@@ -0,0 +1,30 @@
+#pragma once
+#include "Render/Command/DrawPacket.h"
+#include "Render/Command/StateCache.h"
+#include <vector>
+
+// Per-frame list of draw packets. Record with Submit, Sort once all draws
+// are in, then Execute replays them in key order through a StateCache.
+class CommandBuffer
+{
+public:
+	CommandBuffer(size_t capacity = 0u);
+	void Submit(const DrawPacket& packet);
+	// stable LSD radix sort on the 64-bit keys, skipping byte passes where all keys agree
+	void Sort();
+	void Execute(RenderContext& context, StateCache& cache) const;
+	void Reset() noexcept;
+	size_t GetSize() const noexcept;
+	// i-th packet in replay order
+	const DrawPacket& GetPacket(size_t i) const noexcept;
+private:
+	struct SortEntry
+	{
+		uint64_t key;
+		uint32_t index;
+	};
+private:
+	std::vector<DrawPacket> packets;
+	std::vector<SortEntry> order;
+	std::vector<SortEntry> scratch;
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include "Render/Command/RenderContext.h"
+#include "Render/GraphicsResource.h"
+
+// Replays packets on the immediate context of a Graphics instance. Once
+// Graphics has fallen back to the software rasterizer there is no context
+// left, binds and draws are dropped then and the draws counted; the software
+// backend only takes RenderBackend vertex arrays.
+class D3D11RenderContext : public RenderContext, public GraphicsResource
+{
+public:
+	D3D11RenderContext(Graphics& gfx) noexcept;
+	void SetState(Slot slot, Bind::Bindable* pBindable) override;
+	void DrawIndexed(unsigned int indexCount, unsigned int startIndex, int baseVertex) override;
+	void DrawIndexedInstanced(unsigned int indexCount, unsigned int instanceCount,
+		unsigned int startIndex, int baseVertex, unsigned int startInstance) override;
+	size_t GetDroppedDraws() const noexcept;
+private:
+	Graphics& gfx;
+	size_t droppedDraws = 0u;
+};
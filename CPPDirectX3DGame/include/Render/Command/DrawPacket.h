@@ -0,0 +1,66 @@
+#pragma once
+#include "Render/Command/RenderContext.h"
+#include <array>
+#include <cstdint>
+
+struct DrawPacket
+{
+	uint64_t key = 0u;
+	// bindable per pipeline slot, nullptr leaves the slot as it is
+	std::array<Bind::Bindable*, RenderContext::nSlots> state = {};
+	unsigned int indexCount = 0u;
+	unsigned int startIndex = 0u;
+	int baseVertex = 0;
+	// 0 draws without instancing
+	unsigned int instanceCount = 0u;
+	unsigned int startInstance = 0u;
+	void Set(RenderContext::Slot slot, Bind::Bindable* pBindable) noexcept
+	{
+		state[size_t(slot)] = pBindable;
+	}
+};
+
+// 64-bit draw sort key, most significant first:
+// pass (8) | shader (12) | material (20) | depth (24)
+// Sorting by key groups draws by pass, then by shader and material so the
+// state cache can skip binds, and finally by depth inside a material.
+class SortKey
+{
+public:
+	static constexpr unsigned int passBits = 8u;
+	static constexpr unsigned int shaderBits = 12u;
+	static constexpr unsigned int materialBits = 20u;
+	static constexpr unsigned int depthBits = 24u;
+public:
+	// depth is normalized view depth in [0,1]; translucent passes want backToFront
+	static uint64_t Make(unsigned int pass, unsigned int shader, unsigned int material, float depth, bool backToFront = false) noexcept
+	{
+		const float d = depth < 0.0f ? 0.0f : (depth > 1.0f ? 1.0f : depth);
+		uint64_t quantized = uint64_t(d * float(Mask(depthBits)));
+		if (backToFront)
+		{
+			quantized = Mask(depthBits) - quantized;
+		}
+		return (uint64_t(pass & Mask(passBits)) << (shaderBits + materialBits + depthBits)) |
+			(uint64_t(shader & Mask(shaderBits)) << (materialBits + depthBits)) |
+			(uint64_t(material & Mask(materialBits)) << depthBits) |
+			quantized;
+	}
+	static unsigned int GetPass(uint64_t key) noexcept
+	{
+		return static_cast<unsigned int>(key >> (shaderBits + materialBits + depthBits));
+	}
+	static unsigned int GetShader(uint64_t key) noexcept
+	{
+		return static_cast<unsigned int>((key >> (materialBits + depthBits)) & Mask(shaderBits));
+	}
+	static unsigned int GetMaterial(uint64_t key) noexcept
+	{
+		return static_cast<unsigned int>((key >> depthBits) & Mask(materialBits));
+	}
+private:
+	static constexpr uint64_t Mask(unsigned int bits) noexcept
+	{
+		return (uint64_t(1) << bits) - 1u;
+	}
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include "Render/Command/CommandBuffer.h"
+#include "Render/Command/DrawPacket.h"
+#include "Math/OMath.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Per-instance vertex data, the layout the instanced shaders read from the
+// instance stream
+struct InstanceData
+{
+	// world matrix, row vectors like the rest of OMath
+	OMath::XMFLOAT4X4 transform;
+	OMath::XMFLOAT4 color;
+};
+
+// Collects draws of the same mesh with the same material and turns each
+// group into one instanced draw. Submit one packet per object; packets
+// match when their bound state, index range and the pass/shader/material
+// part of the key are equal, so the depth part may differ. Build lays the
+// instances out group by group for upload into an InstanceBuffer and
+// submits one packet per group that draws them from it.
+// Instances of a group are drawn in submission order, but groups as a
+// whole are sorted by their nearest member, so keep back-to-front passes
+// out of the batcher.
+class InstanceBatcher
+{
+public:
+	struct Stats
+	{
+		size_t submitted = 0u;
+		size_t batches = 0u;
+	};
+public:
+	void Submit(const DrawPacket& packet, const InstanceData& instance);
+	// submits one instanced packet per group into commands, bound to
+	// pInstanceBuffer; the instances to upload are in GetInstances after
+	void Build(CommandBuffer& commands, Bind::Bindable* pInstanceBuffer);
+	const std::vector<InstanceData>& GetInstances() const noexcept;
+	Stats GetStats() const noexcept;
+	// drops everything submitted, keeps the memory for the next frame
+	void Reset() noexcept;
+private:
+	// what has to match for two packets to share a draw
+	struct BatchKey
+	{
+		std::array<Bind::Bindable*, RenderContext::nSlots> state;
+		unsigned int indexCount;
+		unsigned int startIndex;
+		int baseVertex;
+		// pass, shader and material bits of the sort key
+		uint64_t material;
+		bool operator==(const BatchKey& other) const noexcept;
+		uint64_t Hash() const noexcept;
+	};
+	struct Batch
+	{
+		BatchKey key;
+		uint64_t hash;
+		DrawPacket packet;
+		uint32_t count = 0u;
+		uint32_t first = 0u;
+	};
+private:
+	uint32_t FindOrAdd(const DrawPacket& packet);
+	void Grow();
+private:
+	std::vector<Batch> batches;
+	// open addressing over batch indices, -1 is empty, at most half full
+	std::vector<int32_t> table;
+	// submissions tend to come in runs of the same mesh
+	uint32_t lastBatch = 0u;
+	// submission order, batch index per instance
+	std::vector<InstanceData> submitted;
+	std::vector<uint32_t> batchOf;
+	// grouped for upload
+	std::vector<InstanceData> instances;
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include "Render/Command/RenderContext.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Mock context that records every call it receives instead of touching a
+// device, used to check what a replay actually issues.
+class RecordingContext : public RenderContext
+{
+public:
+	struct Call
+	{
+		enum class Type
+		{
+			SetState,
+			DrawIndexed,
+			DrawIndexedInstanced,
+		};
+		Type type;
+		Slot slot;
+		Bind::Bindable* pBindable;
+		unsigned int indexCount;
+		unsigned int startIndex;
+		int baseVertex;
+		unsigned int instanceCount;
+		unsigned int startInstance;
+	};
+public:
+	// keepLog == false only counts, for large benchmark scenes
+	RecordingContext(bool keepLog = true) noexcept;
+	void SetState(Slot slot, Bind::Bindable* pBindable) override;
+	void DrawIndexed(unsigned int indexCount, unsigned int startIndex, int baseVertex) override;
+	void DrawIndexedInstanced(unsigned int indexCount, unsigned int instanceCount,
+		unsigned int startIndex, int baseVertex, unsigned int startInstance) override;
+	size_t GetStateCalls() const noexcept;
+	size_t GetStateCalls(Slot slot) const noexcept;
+	// plain and instanced draws
+	size_t GetDrawCalls() const noexcept;
+	size_t GetInstancedDrawCalls() const noexcept;
+	// objects drawn, one per plain draw plus the instances of instanced ones
+	size_t GetDrawnObjects() const noexcept;
+	const std::vector<Call>& GetCalls() const noexcept;
+	void Reset() noexcept;
+	// distinct stand-in bindable per id, for replays onto this context only
+	// since it never dereferences what it is given
+	static Bind::Bindable* Fake(uintptr_t id) noexcept;
+private:
+	bool keepLog;
+	std::array<size_t, nSlots> stateCalls = {};
+	size_t drawCalls = 0u;
+	size_t instancedDrawCalls = 0u;
+	size_t drawnObjects = 0u;
+	std::vector<Call> calls;
+};
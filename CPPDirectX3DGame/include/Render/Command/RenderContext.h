@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+
+namespace Bind
+{
+	class Bindable;
+}
+
+// Pipeline surface the command buffer replays onto. D3D11RenderContext forwards
+// to the bindables on the immediate context, RecordingContext only counts, so
+// sorting and redundant-bind elimination can be exercised without a device.
+class RenderContext
+{
+public:
+	enum class Slot : unsigned char
+	{
+		VertexShader,
+		PixelShader,
+		InputLayout,
+		Topology,
+		VertexBuffer,
+		// per-instance vertex stream of instanced draws
+		InstanceBuffer,
+		IndexBuffer,
+		VertexConstants,
+		PixelConstants,
+		Sampler,
+		Blend,
+		Rasterizer,
+		DepthStencil,
+		Count,
+	};
+	static constexpr size_t nSlots = size_t(Slot::Count);
+public:
+	virtual ~RenderContext() = default;
+	virtual void SetState(Slot slot, Bind::Bindable* pBindable) = 0;
+	virtual void DrawIndexed(unsigned int indexCount, unsigned int startIndex, int baseVertex) = 0;
+	virtual void DrawIndexedInstanced(unsigned int indexCount, unsigned int instanceCount,
+		unsigned int startIndex, int baseVertex, unsigned int startInstance) = 0;
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include "Render/Command/RenderContext.h"
+#include <array>
+
+// Shadows what is currently bound on a RenderContext and drops binds that
+// would not change anything. Invalidate whenever something binds behind its back.
+class StateCache
+{
+public:
+	struct Stats
+	{
+		size_t bindsIssued = 0u;
+		size_t bindsSkipped = 0u;
+		size_t draws = 0u;
+		// objects drawn by instanced draws, each of which also counts in draws
+		size_t instances = 0u;
+	};
+public:
+	void Bind(RenderContext& context, RenderContext::Slot slot, Bind::Bindable* pBindable);
+	void Draw(RenderContext& context, unsigned int indexCount, unsigned int startIndex, int baseVertex);
+	void DrawInstanced(RenderContext& context, unsigned int indexCount, unsigned int instanceCount,
+		unsigned int startIndex, int baseVertex, unsigned int startInstance);
+	void Invalidate() noexcept;
+	Stats GetStats() const noexcept;
+	void ResetStats() noexcept;
+private:
+	std::array<Bind::Bindable*, RenderContext::nSlots> current = {};
+	Stats stats;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include "Math/OMath.h"
+#include <algorithm>
+
+// Bounding volumes for culling, plain floats so they pack into arrays
+struct Aabb
+{
+	OMath::XMFLOAT3 min;
+	OMath::XMFLOAT3 max;
+
+	static Aabb FromCenterExtents(const OMath::XMFLOAT3& center, const OMath::XMFLOAT3& extents) noexcept
+	{
+		return {
+			{ center.x - extents.x, center.y - extents.y, center.z - extents.z },
+			{ center.x + extents.x, center.y + extents.y, center.z + extents.z },
+		};
+	}
+	static Aabb Union(const Aabb& a, const Aabb& b) noexcept
+	{
+		return {
+			{ std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z) },
+			{ std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z) },
+		};
+	}
+	bool Contains(const Aabb& other) const noexcept
+	{
+		return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+			max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+	}
+	Aabb Expanded(float margin) const noexcept
+	{
+		return {
+			{ min.x - margin, min.y - margin, min.z - margin },
+			{ max.x + margin, max.y + margin, max.z + margin },
+		};
+	}
+	// half the surface area, enough for comparing costs
+	float GetHalfArea() const noexcept
+	{
+		const float dx = max.x - min.x;
+		const float dy = max.y - min.y;
+		const float dz = max.z - min.z;
+		return dx * dy + dy * dz + dz * dx;
+	}
+	OMath::XMFLOAT3 GetCenter() const noexcept
+	{
+		return { (min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f };
+	}
+	OMath::XMFLOAT3 GetExtents() const noexcept
+	{
+		return { (max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f };
+	}
+};
+
+struct Sphere
+{
+	OMath::XMFLOAT3 center;
+	float radius;
+
+	Aabb GetBox() const noexcept
+	{
+		return Aabb::FromCenterExtents(center, { radius, radius, radius });
+	}
+};
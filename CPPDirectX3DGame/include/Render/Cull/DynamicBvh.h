@@ -0,0 +1,99 @@
+#pragma once
+#include "Render/Cull/Bounds.h"
+#include "Render/Cull/Frustum.h"
+#include <cstdint>
+#include <vector>
+
+// Dynamic bounding volume hierarchy for view culling. Every object is a leaf
+// holding its exact bounds and a slightly larger "fat" box; moving an object
+// inside its fat box costs nothing, moving it out refits the boxes on the
+// way up to the root. Insertion picks the cheapest sibling by surface area
+// and rotations keep the tree balanced. After many refits Rebuild restores
+// tree quality.
+class DynamicBvh
+{
+public:
+	using ProxyId = int32_t;
+	static constexpr ProxyId nullProxy = -1;
+	struct CullStats
+	{
+		size_t objects = 0u;
+		size_t visible = 0u;
+		size_t culled = 0u;
+		size_t nodesTested = 0u;
+		size_t leavesTested = 0u;
+		// objects accepted without a test because their subtree was fully inside
+		size_t acceptedWhole = 0u;
+		double seconds = 0.0;
+	};
+public:
+	// margin fattens leaf boxes so small movements don't touch the tree
+	DynamicBvh(float margin = 0.1f);
+	ProxyId Insert(const Aabb& box, uint32_t userData);
+	ProxyId Insert(const Sphere& sphere, uint32_t userData);
+	void Remove(ProxyId proxy);
+	// true when the tree had to be refit
+	bool Move(ProxyId proxy, const Aabb& box);
+	bool Move(ProxyId proxy, const Sphere& sphere);
+	// rebuilds top-down from the current leaves, ids stay valid
+	void Rebuild();
+	// replaces the contents of visible with the userData of every object
+	// that is not outside the frustum
+	void Cull(const Frustum& frustum, std::vector<uint32_t>& visible);
+	const CullStats& GetCullStats() const noexcept;
+	uint32_t GetUserData(ProxyId proxy) const noexcept;
+	const Aabb& GetFatBox(ProxyId proxy) const noexcept;
+	size_t GetProxyCount() const noexcept;
+	int GetHeight() const noexcept;
+	// summed area of the inner nodes over the root's, lower is better
+	float GetAreaRatio() const noexcept;
+	// checks parent links, heights and containment, for debugging
+	bool Validate() const noexcept;
+private:
+	struct Node
+	{
+		// fat box for leaves
+		Aabb box;
+		// exact bounds, leaves only
+		Aabb tight;
+		// >= 0 when the leaf is a sphere centered in tight
+		float radius;
+		uint32_t userData;
+		union
+		{
+			int32_t parent;
+			int32_t next;
+		};
+		int32_t child1;
+		int32_t child2;
+		// leaf = 0, free = -1
+		int32_t height;
+		bool IsLeaf() const noexcept
+		{
+			return child1 == nullProxy;
+		}
+	};
+private:
+	ProxyId InsertProxy(const Aabb& tight, float radius, uint32_t userData);
+	bool MoveProxy(ProxyId proxy, const Aabb& tight, float radius);
+	int32_t AllocateNode();
+	void FreeNode(int32_t node) noexcept;
+	void InsertLeaf(int32_t leaf);
+	void RemoveLeaf(int32_t leaf) noexcept;
+	// fix boxes and heights from node up to the root, balancing as it goes;
+	// stopEarly ends at the first node that comes out unchanged, which is only
+	// right when that node was up to date before the change below it
+	void Refit(int32_t node, bool stopEarly) noexcept;
+	int32_t Balance(int32_t node) noexcept;
+	int32_t BuildTopDown(int32_t* leaves, size_t count);
+	bool ValidateNode(int32_t node) const noexcept;
+private:
+	std::vector<Node> nodes;
+	int32_t root = nullProxy;
+	int32_t freeList = nullProxy;
+	size_t proxyCount = 0u;
+	float margin;
+	std::vector<int32_t> stack;
+	std::vector<uint32_t> maskStack;
+	CullStats stats;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include "Render/Cull/Bounds.h"
+#include "Math/OMath.h"
+#include <cstdint>
+
+// View frustum as six planes facing inwards, taken from a D3D style
+// (z in [0, 1]) view-projection matrix. Bounds are tested against four
+// planes per SIMD operation. The plane mask says which planes still need
+// testing: children of a node that was fully inside a plane can skip it.
+class Frustum
+{
+public:
+	enum class Result
+	{
+		Outside,
+		Intersect,
+		Inside,
+	};
+	enum Plane
+	{
+		Left,
+		Right,
+		Bottom,
+		Top,
+		Near,
+		Far,
+		Count,
+	};
+	static constexpr uint32_t allPlanes = (1u << Plane::Count) - 1u;
+public:
+	Frustum() noexcept;
+	explicit Frustum(OMath::FXMMATRIX viewProjection) noexcept;
+	void Set(OMath::FXMMATRIX viewProjection) noexcept;
+	// clears the planes in planeMask the bounds are fully inside of
+	Result Test(const Aabb& box, uint32_t& planeMask) const noexcept;
+	Result Test(const Sphere& sphere, uint32_t& planeMask) const noexcept;
+	bool IsVisible(const Aabb& box) const noexcept;
+	bool IsVisible(const Sphere& sphere) const noexcept;
+	// (a, b, c, d), normalized, inside where a * x + b * y + c * z + d >= 0
+	OMath::XMFLOAT4 GetPlane(Plane plane) const noexcept;
+private:
+	// planes 0-3 and 4-5 plus two that everything is inside of, one
+	// component of four planes per vector
+	OMath::XMVECTOR px[2];
+	OMath::XMVECTOR py[2];
+	OMath::XMVECTOR pz[2];
+	OMath::XMVECTOR pw[2];
+	// absolute normal components for the box radius
+	OMath::XMVECTOR ax[2];
+	OMath::XMVECTOR ay[2];
+	OMath::XMVECTOR az[2];
+};
@@ -3,7 +3,9 @@
 #include "Exception/OException.h"
 #include "DX/DxgiInfoManager.h"
 #include "OWin/OWrl.h"
-//#include "ConditionalNoexcept.h"
+#include "Render/RenderBackend.h"
+#include "Render/Present/FramePacer.h"
+#include "Core/ConditionalNoexcept.h"
 #include <d3d11.h>
 #include <string>
 #include <vector>
@@ -12,15 +14,21 @@
 #include <memory>
 #include <random>
 
+class SoftwareRasterizer;
+class DxgiSwapChain;
+class D3D11FrameFence;
+class D3D11UploadBuffer;
+class UploadRing;
+
 namespace Bind
 {
 	class Bindable;
 	class RenderTarget;
 }
 
-class Graphics
+class Graphics : public RenderBackend
 {
-	//friend class GraphicsResource;
+	friend class GraphicsResource;
 public:
 	class Exception : public OException
 	{
@@ -58,17 +66,31 @@ public:
 	private:
 		std::string reason;
 	};
+	// D3D11 work requested while there is no device, on the software backend
+	// or after a switch to it
+	class NoDeviceException : public Exception
+	{
+		using Exception::Exception;
+	public:
+		const char* GetType() const noexcept override;
+	};
 public:
-	Graphics(HWND hWnd, int width, int height);
-	~Graphics() = default;
+	enum class Backend
+	{
+		Hardware,
+		Software,
+	};
+public:
+	Graphics(HWND hWnd, int width, int height, Backend backend = Backend::Hardware);
+	~Graphics();
 
 	// No need to have a copy constructor
 	Graphics(const Graphics&) = delete;
 	Graphics& operator =(const Graphics&) = delete;
 	
-	void EndFrame();
-	// void BeginFrame(float red, float green, float blue) noexcept;
-	// void DrawIndexed(UINT count) noxnd;
+	void EndFrame() override;
+	// waits until the swap chain can take another frame, then clears
+	void BeginFrame(float red, float green, float blue) noexcept override;
 	// void SetProjection(DirectX::FXMMATRIX proj) noexcept;
 	// DirectX::XMMATRIX GetProjection() const noexcept;
 	// void SetCamera(DirectX::FXMMATRIX cam) noexcept;
@@ -76,15 +98,47 @@ public:
 	// void EnableImgui() noexcept;
 	// void DisableImgui() noexcept;
 	// bool IsImguiEnabled() const noexcept;
-	// UINT GetWidth() const noexcept;
-	// UINT GetHeight() const noexcept;
+	UINT GetWidth() const noexcept override;
+	UINT GetHeight() const noexcept override;
 	// std::shared_ptr<Bind::RenderTarget> GetTarget();
 
-	void ClearBuffer(float r, float g, float b) noexcept;
+	void ClearBuffer(float r, float g, float b) noexcept override;
+	// draws with whatever the bindables left on the context, hardware backend only
+	void DrawIndexed(UINT count) noxnd;
+	// on the hardware backend the arrays go through the vertex upload ring and
+	// are drawn with a built-in pipeline bound behind the back of any
+	// StateCache replaying on the context, which has to be invalidated after
+	void DrawIndexed(const RenderBackend::Vertex* pVertices, size_t vertexCount, const unsigned short* pIndices, size_t indexCount) override;
 	void DrawTestTriangle();
+	// for the software rasterizer, now or once the fallback makes one
+	void SetJobs(JobSystem* pJobs) noexcept override;
+	Backend GetBackend() const noexcept;
+	// on device removal, continue on the software rasterizer instead of throwing
+	void EnableSoftwareFallback() noexcept;
+	void DisableSoftwareFallback() noexcept;
+	bool IsSoftwareFallbackEnabled() const noexcept;
+	// uncapped presents with tearing when the system supports it
+	void SetVSync(bool enabled) noexcept;
+	bool IsVSync() const noexcept;
+	FramePacer::Stats GetPresentStats() const noexcept;
+	// per-frame upload rings, null on the software backend; the constant
+	// ring also needs a driver that can map constant buffers with NO_OVERWRITE
+	UploadRing* GetVertexUploads() noexcept;
+	ID3D11Buffer* GetVertexUploadBuffer() const noexcept;
+	UploadRing* GetConstantUploads() noexcept;
+	ID3D11Buffer* GetConstantUploadBuffer() const noexcept;
+private:
+	void SwitchToSoftware();
+	void PresentSoftware() noexcept;
+	void CreateImmediatePipeline();
 private:
 	UINT width;
 	UINT height;
+	HWND hWnd;
+	bool softwareFallback = false;
+	bool vsync = true;
+	std::unique_ptr<SoftwareRasterizer> pSoftware;
+	JobSystem* pJobs = nullptr;
 	DirectX::XMMATRIX projection;
 	DirectX::XMMATRIX camera;
 	bool imguiEnabled = true;
@@ -92,8 +146,22 @@ private:
 	DxgiInfoManager infoManager;
 #endif
 	Microsoft::WRL::ComPtr<ID3D11Device> pDevice;
-	Microsoft::WRL::ComPtr<IDXGISwapChain> pSwap;
+	std::unique_ptr<DxgiSwapChain> pSwapChain;
+	std::unique_ptr<FramePacer> pPacer;
 	Microsoft::WRL::ComPtr<ID3D11DeviceContext> pContext;
 	Microsoft::WRL::ComPtr<ID3D11RenderTargetView> pTarget;
+	// signaled at the end of every frame, the rings wait on it to bound
+	// how far the CPU runs ahead of their data
+	std::unique_ptr<D3D11FrameFence> pFrameFence;
+	uint64_t frameFenceValue = 0u;
+	std::unique_ptr<D3D11UploadBuffer> pVertexUploadBuffer;
+	std::unique_ptr<UploadRing> pVertexUploads;
+	std::unique_ptr<D3D11UploadBuffer> pConstantUploadBuffer;
+	std::unique_ptr<UploadRing> pConstantUploads;
+	// pipeline of the vertex array draws, created by the first one
+	Microsoft::WRL::ComPtr<ID3D11VertexShader> pImmediateVertexShader;
+	Microsoft::WRL::ComPtr<ID3D11PixelShader> pImmediatePixelShader;
+	Microsoft::WRL::ComPtr<ID3D11InputLayout> pImmediateLayout;
+	Microsoft::WRL::ComPtr<ID3D11RasterizerState> pImmediateRasterizer;
 	//std::shared_ptr<Bind::RenderTarget> pTarget;
 };
\ No newline at end of file
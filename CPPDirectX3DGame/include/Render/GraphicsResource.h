@@ -0,0 +1,16 @@
+#pragma once
+#include "Render/Graphics.h"
+
+// Base for anything that needs to reach into Graphics for the device, context
+// or debug info manager (INFOMAN relies on GetInfoManager being in scope).
+// The software backend has no device, also after a fallback switch, and
+// GetContext and GetDevice throw Graphics::NoDeviceException then; noexcept
+// paths check HasDevice first.
+class GraphicsResource
+{
+protected:
+	static bool HasDevice(Graphics& gfx) noexcept;
+	static ID3D11DeviceContext* GetContext(Graphics& gfx);
+	static ID3D11Device* GetDevice(Graphics& gfx);
+	static DxgiInfoManager& GetInfoManager(Graphics& gfx);
+};
@@ -2,6 +2,7 @@
 
 // HRESULT hr should exist in the local scope for these macros to work
 
+#define GFX_NO_DEVICE_EXCEPT() Graphics::NoDeviceException( __LINE__,__FILE__ )
 #define GFX_EXCEPT_NOINFO(hr) Graphics::HrException( __LINE__,__FILE__, hr)
 #define GFX_THROW_NOINFO(hrcall) if( FAILED( hr = (hrcall) ) ) throw Graphics::HrException( __LINE__,__FILE__,hr )
 
@@ -0,0 +1,33 @@
+#pragma once
+#include "OWin/OWin.h"
+#include "OWin/OWrl.h"
+#include "Render/Present/SwapChain.h"
+#include <d3d11.h>
+#include <dxgi1_5.h>
+
+// DXGI flip-model swap chain. Falls back to flip-sequential and then to the
+// legacy blit model on systems that cannot create the requested effect.
+class DxgiSwapChain : public SwapChain
+{
+public:
+	DxgiSwapChain(ID3D11Device* pDevice, HWND hWnd, const Desc& desc);
+	~DxgiSwapChain() override;
+	DxgiSwapChain(const DxgiSwapChain&) = delete;
+	DxgiSwapChain& operator=(const DxgiSwapChain&) = delete;
+	bool WaitForNextFrame(unsigned int timeoutMs) noexcept override;
+	PresentResult Present(unsigned int syncInterval, unsigned int flags) override;
+	bool IsTearingSupported() const noexcept override;
+	const Desc& GetDesc() const noexcept override;
+	IDXGISwapChain1* Get() const noexcept;
+	// HRESULT of the last Present that returned Error
+	HRESULT GetLastPresentError() const noexcept;
+private:
+	static DXGI_SWAP_EFFECT ToDxgi(Effect effect) noexcept;
+private:
+	Desc desc;
+	bool tearingSupported = false;
+	HRESULT lastError = S_OK;
+	// signaled whenever a queued frame leaves, null on the blit model
+	HANDLE hFrameLatency = nullptr;
+	Microsoft::WRL::ComPtr<IDXGISwapChain1> pSwap;
+};
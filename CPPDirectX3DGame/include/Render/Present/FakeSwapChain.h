@@ -0,0 +1,51 @@
+#pragma once
+#include "Render/Present/SwapChain.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Simulated display for exercising presentation logic without a window.
+// Time is virtual: waiting on a full queue advances the clock to the vblank
+// that retires the oldest frame instead of sleeping.
+class FakeSwapChain : public SwapChain
+{
+public:
+	struct PresentCall
+	{
+		unsigned int syncInterval;
+		unsigned int flags;
+		// virtual time the frame reaches the screen, negative if it never does
+		double displaySeconds;
+	};
+public:
+	FakeSwapChain(const Desc& desc, double refreshRate = 60.0, bool tearingSupported = true);
+	bool WaitForNextFrame(unsigned int timeoutMs) noexcept override;
+	PresentResult Present(unsigned int syncInterval, unsigned int flags) override;
+	bool IsTearingSupported() const noexcept override;
+	const Desc& GetDesc() const noexcept override;
+	// advance virtual time, stands in for CPU work between presents
+	void Advance(double seconds) noexcept;
+	void SetOccluded(bool occluded) noexcept;
+	void SetDeviceRemoved() noexcept;
+	double GetTime() const noexcept;
+	size_t GetQueuedFrames() const noexcept;
+	uint64_t GetWaitCount() const noexcept;
+	const std::vector<PresentCall>& GetPresents() const noexcept;
+	void Reset() noexcept;
+private:
+	double NextVBlank(double after) const noexcept;
+	void Retire() noexcept;
+private:
+	Desc desc;
+	double refreshPeriod;
+	bool tearingSupported;
+	bool occluded = false;
+	bool removed = false;
+	double time = 0.0;
+	double lastDisplay = 0.0;
+	uint64_t waits = 0u;
+	// display times of frames handed over but not on screen yet
+	std::deque<double> queue;
+	std::vector<PresentCall> presents;
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include "Render/Present/SwapChain.h"
+#include <cstdint>
+#include <functional>
+
+// Decides how and when frames are handed to a SwapChain: waits on the frame
+// latency object before a frame starts, picks sync interval and tearing for
+// vsync or uncapped presentation, and stops presenting real frames while the
+// window is occluded (probing with test presents at a throttled rate).
+class FramePacer
+{
+public:
+	struct Stats
+	{
+		uint64_t frames = 0u;
+		uint64_t presents = 0u;
+		uint64_t testPresents = 0u;
+		uint64_t occludedFrames = 0u;
+		uint64_t waitTimeouts = 0u;
+		// time spent in the last BeginFrame
+		float lastWaitSeconds = 0.0f;
+	};
+public:
+	// sleep is called with milliseconds while throttling, replaceable for tests
+	FramePacer(SwapChain& swapChain, std::function<void(unsigned int)> sleep = {});
+	void BeginFrame() noexcept;
+	SwapChain::PresentResult Present();
+	void SetVSync(bool enabled) noexcept;
+	bool IsVSync() const noexcept;
+	void SetOccludedThrottle(unsigned int milliseconds) noexcept;
+	bool IsOccluded() const noexcept;
+	Stats GetStats() const noexcept;
+private:
+	SwapChain& swapChain;
+	std::function<void(unsigned int)> sleep;
+	bool vsync = true;
+	bool occluded = false;
+	unsigned int occludedThrottleMs = 50u;
+	unsigned int waitTimeoutMs = 1000u;
+	Stats stats;
+};
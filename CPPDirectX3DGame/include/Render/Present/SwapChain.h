@@ -0,0 +1,48 @@
+#pragma once
+
+// Presentation surface behind Graphics. DxgiSwapChain wraps a real DXGI swap
+// chain, FakeSwapChain simulates a display so FramePacer can be exercised
+// without a window or GPU.
+class SwapChain
+{
+public:
+	enum class Effect
+	{
+		// legacy blit model
+		Discard,
+		// flip model, Windows 8+
+		FlipSequential,
+		// flip model, Windows 10+
+		FlipDiscard,
+	};
+	enum class PresentResult
+	{
+		Ok,
+		// window minimized or covered, nothing was shown
+		Occluded,
+		DeviceRemoved,
+		Error,
+	};
+	// Present flags
+	static constexpr unsigned int presentTest = 0x1u;
+	static constexpr unsigned int presentAllowTearing = 0x2u;
+	struct Desc
+	{
+		unsigned int width = 0u;
+		unsigned int height = 0u;
+		Effect effect = Effect::FlipDiscard;
+		unsigned int bufferCount = 2u;
+		// frames the CPU may queue ahead of the display
+		unsigned int maxFrameLatency = 1u;
+		// ask for tearing support so uncapped mode is not throttled by the compositor
+		bool allowTearing = true;
+	};
+public:
+	virtual ~SwapChain() = default;
+	// block until another frame may be queued, false on timeout
+	virtual bool WaitForNextFrame(unsigned int timeoutMs) noexcept = 0;
+	virtual PresentResult Present(unsigned int syncInterval, unsigned int flags) = 0;
+	virtual bool IsTearingSupported() const noexcept = 0;
+	// what was actually created, may differ from the request after fallbacks
+	virtual const Desc& GetDesc() const noexcept = 0;
+};
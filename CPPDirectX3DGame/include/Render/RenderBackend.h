@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+
+class JobSystem;
+
+// Target-independent surface of the renderer. Graphics drives either the D3D11
+// device or the software rasterizer through these calls, App only sees this
+// interface, and headless tools (benchmarks, pixel regression runs) talk to a
+// backend directly.
+class RenderBackend
+{
+public:
+	struct Vertex
+	{
+		struct
+		{
+			float x;
+			float y;
+		} pos;
+		struct
+		{
+			unsigned char r;
+			unsigned char g;
+			unsigned char b;
+			unsigned char a;
+		} color;
+	};
+public:
+	RenderBackend() = default;
+	virtual ~RenderBackend() = default;
+	RenderBackend(const RenderBackend&) = delete;
+	RenderBackend& operator=(const RenderBackend&) = delete;
+	virtual void ClearBuffer(float red, float green, float blue) noexcept = 0;
+	// backends that pace presentation wait here before clearing
+	virtual void BeginFrame(float red, float green, float blue) noexcept
+	{
+		ClearBuffer(red, green, blue);
+	}
+	// positions are in normalized device coordinates, triangle list topology
+	virtual void DrawIndexed(const Vertex* pVertices, size_t vertexCount, const unsigned short* pIndices, size_t indexCount) = 0;
+	virtual void EndFrame() = 0;
+	// backends that spread a frame over threads use the app's job system,
+	// from whichever thread draws; it has to outlive any drawing after this
+	virtual void SetJobs(JobSystem* /*pJobs*/) noexcept
+	{
+	}
+	virtual unsigned int GetWidth() const noexcept = 0;
+	virtual unsigned int GetHeight() const noexcept = 0;
+};
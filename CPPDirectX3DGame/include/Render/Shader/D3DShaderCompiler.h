@@ -0,0 +1,10 @@
+#pragma once
+#include "Render/Shader/ShaderCompiler.h"
+
+// D3DCompile from d3dcompiler_47, includes are served from the ShaderSource
+class D3DShaderCompiler : public ShaderCompiler
+{
+public:
+	Result Compile(const ShaderDesc& desc, const ShaderSource& source) override;
+	std::string GetVersion() const override;
+};
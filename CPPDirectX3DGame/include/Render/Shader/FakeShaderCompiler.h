@@ -0,0 +1,26 @@
+#pragma once
+#include "Render/Shader/ShaderCompiler.h"
+#include <atomic>
+#include <cstdint>
+
+// Stand-in compiler: the bytecode is a digest of everything that went in, so
+// equal inputs give equal output and any change gives different output.
+// Spins for a fixed time per compile to stand in for the real cost, and
+// fails sources that contain "#error".
+class FakeShaderCompiler : public ShaderCompiler
+{
+public:
+	FakeShaderCompiler(unsigned int costMicroseconds = 0u, std::string version = "fake-1");
+	Result Compile(const ShaderDesc& desc, const ShaderSource& source) override;
+	std::string GetVersion() const override;
+	uint64_t GetCompileCount() const noexcept;
+	// most compiles that were running at the same time
+	unsigned int GetPeakConcurrency() const noexcept;
+	void ResetCounters() noexcept;
+private:
+	unsigned int costMicroseconds;
+	std::string version;
+	std::atomic<uint64_t> compiles = 0u;
+	std::atomic<unsigned int> running = 0u;
+	std::atomic<unsigned int> peak = 0u;
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include "Exception/OException.h"
+#include "Render/Shader/ShaderCompiler.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class JobSystem;
+
+// Compiled shaders keyed by a 128-bit hash of everything that decides the
+// output: compiler version, profile, entry point, defines, flags, and the
+// text of the source and every file it includes. Lookups go through memory,
+// then a directory of one file per key, and only then to the compiler, so a
+// second launch with unchanged shaders compiles nothing. Load takes the
+// shaders needed at startup and compiles the misses on the job system.
+// Includes are found by scanning for #include lines, also in inactive #if
+// branches, so an edit to a file the preprocessor skips still invalidates;
+// that only costs a compile.
+class ShaderCache
+{
+public:
+	class Exception : public OException
+	{
+	public:
+		Exception(int line, const char* file, std::string note) noexcept;
+		const char* what() const noexcept override;
+		const char* GetType() const noexcept override;
+		const std::string& GetNote() const noexcept;
+	private:
+		std::string note;
+	};
+	struct Key
+	{
+		uint64_t hi = 0u;
+		uint64_t lo = 0u;
+		bool operator==(const Key& other) const noexcept;
+		// 32 hex digits, the file name in the cache directory
+		std::string ToString() const;
+	};
+	using Bytecode = std::shared_ptr<const std::vector<std::byte>>;
+	// reads a whole file, false if it does not exist; replaceable so tests
+	// can serve sources from memory
+	using FileLoader = std::function<bool(const std::string& path, std::string& contents)>;
+	struct Config
+	{
+		// empty keeps the cache in memory only
+		std::string directory;
+		// Load compiles on the calling thread without one
+		JobSystem* pJobs = nullptr;
+		FileLoader loader;
+	};
+	struct Stats
+	{
+		uint64_t requests = 0u;
+		uint64_t memoryHits = 0u;
+		uint64_t diskHits = 0u;
+		uint64_t compiles = 0u;
+		uint64_t failures = 0u;
+		// summed over threads
+		double hashSeconds = 0.0;
+		double diskSeconds = 0.0;
+		double compileSeconds = 0.0;
+		// wall clock of Load and Get calls
+		double totalSeconds = 0.0;
+		double HitRate() const noexcept;
+	};
+public:
+	ShaderCache(ShaderCompiler& compiler, Config config);
+	ShaderCache(const ShaderCache&) = delete;
+	ShaderCache& operator=(const ShaderCache&) = delete;
+	// bytecode for every desc in order; throws with the compiler messages
+	// of the first shader that failed once all are done
+	std::vector<Bytecode> Load(const std::vector<ShaderDesc>& descs);
+	Bytecode Get(const ShaderDesc& desc);
+	// reads the sources to hash them, throws if the main file is missing
+	Key ComputeKey(const ShaderDesc& desc) const;
+	Stats GetStats() const;
+	void ResetStats();
+	// forgets what is in memory, the directory stays
+	void ClearMemory();
+	static bool ReadFile(const std::string& path, std::string& contents);
+private:
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const noexcept;
+	};
+	Bytecode Resolve(const ShaderDesc& desc);
+	ShaderSource ReadSource(const std::string& path) const;
+	Key ComputeKey(const ShaderDesc& desc, const ShaderSource& source) const;
+	Bytecode ReadEntry(const Key& key) const;
+	void WriteEntry(const Key& key, const std::vector<std::byte>& bytecode) const;
+private:
+	ShaderCompiler& compiler;
+	Config config;
+	const std::string compilerVersion;
+	mutable std::mutex mtx;
+	std::unordered_map<Key, Bytecode, KeyHash> entries;
+	Stats stats;
+};
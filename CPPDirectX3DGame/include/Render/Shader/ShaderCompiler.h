@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// What to build from a shader file: the file, its entry point, the target
+// profile such as "vs_5_0", preprocessor defines and compiler flags
+// (D3DCOMPILE_* for D3DShaderCompiler).
+struct ShaderDesc
+{
+	std::string path;
+	std::string entryPoint = "main";
+	std::string profile;
+	std::vector<std::pair<std::string, std::string>> defines;
+	uint32_t flags = 0u;
+};
+
+// A shader file with everything it includes already read, so compiling
+// needs no file access of its own
+struct ShaderSource
+{
+	struct File
+	{
+		// resolved relative to the including file
+		std::string path;
+		std::string text;
+	};
+	File main;
+	// in the order the scan found them, each file once
+	std::vector<File> includes;
+	// the file an include written as name in parent resolves to, null if
+	// it was not found
+	const File* FindInclude(const std::string& parentPath, const std::string& name) const noexcept;
+	static std::string ResolveInclude(const std::string& parentPath, const std::string& name);
+};
+
+// Turns HLSL into bytecode. D3DShaderCompiler calls D3DCompile,
+// FakeShaderCompiler produces stand-in bytecode so the cache can be tested
+// without the Windows SDK. Compile is called from several threads at once.
+class ShaderCompiler
+{
+public:
+	struct Result
+	{
+		bool succeeded = false;
+		std::vector<std::byte> bytecode;
+		// compiler output, warnings included
+		std::string messages;
+	};
+public:
+	virtual ~ShaderCompiler() = default;
+	virtual Result Compile(const ShaderDesc& desc, const ShaderSource& source) = 0;
+	// part of every cache key, so a different compiler never hits old entries
+	virtual std::string GetVersion() const = 0;
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include "Render/RenderBackend.h"
+#include <vector>
+#include <cstdint>
+
+// Tile-binned, multithreaded CPU rasterizer. Renders into a B8G8R8A8 buffer
+// (same layout as the DXGI_FORMAT_B8G8R8A8_UNORM swap chain) and has no
+// platform dependencies, so it runs headless.
+// Triangles are binned into tiles as they are submitted; EndFrame rasterizes
+// all tiles in parallel on the job system (the calling thread helps, as a
+// guest when it is not one of the system's) and then flips the buffers.
+// Coverage uses 28.4 fixed point with the D3D top-left rule, and each tile
+// draws its triangles in submission order, so output is identical regardless
+// of thread count.
+class SoftwareRasterizer : public RenderBackend
+{
+public:
+	struct Stats
+	{
+		unsigned int triangles;
+		unsigned int binnedTriangles;
+	};
+public:
+	// renders on the calling thread without a job system
+	SoftwareRasterizer(unsigned int width, unsigned int height, JobSystem* pJobs = nullptr);
+	void SetJobs(JobSystem* pJobs) noexcept override;
+	void ClearBuffer(float red, float green, float blue) noexcept override;
+	void DrawIndexed(const Vertex* pVertices, size_t vertexCount, const unsigned short* pIndices, size_t indexCount) override;
+	void EndFrame() override;
+	unsigned int GetWidth() const noexcept override;
+	unsigned int GetHeight() const noexcept override;
+	// pixels of the last completed frame, rows are GetPitch() pixels apart
+	const uint32_t* GetFrontBuffer() const noexcept;
+	unsigned int GetPitch() const noexcept;
+	// counters of the last completed frame
+	Stats GetStats() const noexcept;
+private:
+	struct Triangle
+	{
+		// screen space vertices, 4 bits of subpixel precision
+		int32_t x[3];
+		int32_t y[3];
+		// pixel bounding box, inclusive min / exclusive max
+		int minX, minY, maxX, maxY;
+		// edge functions fit in 32 bits, see wideLimit
+		bool wide;
+		// 0 for top-left edges, -1 otherwise (edge i is opposite vertex i)
+		int32_t bias[3];
+		float invArea;
+		// r, g, b, a per vertex in 0..255
+		float color[3][4];
+	};
+private:
+	void RasterizeTiles(size_t begin, size_t end) noexcept;
+	void RasterizeTile(unsigned int tileIndex) noexcept;
+	void RasterizeTriangle(const Triangle& tri, int x0, int y0, int x1, int y1) noexcept;
+	void RasterizeTriangleWide(const Triangle& tri, int x0, int y0, int x1, int y1) noexcept;
+private:
+	static constexpr int tileSize = 64;
+	static constexpr int subpixelBits = 4;
+	static constexpr int subpixelScale = 1 << subpixelBits;
+	// triangles whose (unclipped) bounding box fits this many pixels keep
+	// their edge functions inside 32 bits and can take the SIMD path
+	static constexpr int wideLimit = 512;
+	unsigned int width;
+	unsigned int height;
+	unsigned int pitch;
+	unsigned int tilesX;
+	unsigned int tilesY;
+	std::vector<uint32_t> backBuffer;
+	std::vector<uint32_t> frontBuffer;
+	bool clearPending = false;
+	uint32_t clearColor = 0xFF000000u;
+	std::vector<Triangle> triangles;
+	std::vector<std::vector<uint32_t>> bins;
+	Stats frameStats = {};
+	Stats lastStats = {};
+	JobSystem* pJobs;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include "Render/Upload/UploadBuffer.h"
+#include <cstdint>
+#include <memory>
+
+// Upload buffer in system memory. Counts maps by mode so tests can check
+// how often the ring discards.
+class CpuUploadBuffer : public UploadBuffer
+{
+public:
+	struct Stats
+	{
+		uint64_t discards = 0u;
+		uint64_t noOverwrites = 0u;
+	};
+public:
+	CpuUploadBuffer(size_t size);
+	std::byte* Map(MapMode mode) override;
+	void Unmap() noexcept override;
+	size_t GetSize() const noexcept override;
+	bool IsMapped() const noexcept;
+	Stats GetStats() const noexcept;
+private:
+	size_t size;
+	std::unique_ptr<std::byte[]> pData;
+	bool mapped = false;
+	Stats stats;
+};
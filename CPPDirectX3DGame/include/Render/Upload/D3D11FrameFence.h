@@ -0,0 +1,35 @@
+#pragma once
+#include "OWin/OWin.h"
+#include "OWin/OWrl.h"
+#include "Render/Upload/FrameFence.h"
+#include <d3d11.h>
+#include <array>
+#include <cstdint>
+
+// D3D11 has no fences, an event query issued at the end of a frame completes
+// when the GPU gets there. Queries are reused round robin, signaling more
+// than maxPending frames ahead waits for the oldest.
+class D3D11FrameFence : public FrameFence
+{
+public:
+	static constexpr size_t maxPending = 8u;
+public:
+	D3D11FrameFence(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
+	D3D11FrameFence(const D3D11FrameFence&) = delete;
+	D3D11FrameFence& operator=(const D3D11FrameFence&) = delete;
+	void Signal(uint64_t value) override;
+	uint64_t GetCompletedValue() noexcept override;
+	void Wait(uint64_t value) override;
+private:
+	// true once the oldest pending query is done, flush kicks the GPU so
+	// a blocking wait cannot stall on unsubmitted work
+	bool Poll(bool flush) noexcept;
+private:
+	ID3D11DeviceContext* pContext;
+	std::array<Microsoft::WRL::ComPtr<ID3D11Query>, maxPending> queries;
+	std::array<uint64_t, maxPending> values = {};
+	// pending queries are [first, first + count) modulo maxPending
+	size_t first = 0u;
+	size_t count = 0u;
+	uint64_t completed = 0u;
+};
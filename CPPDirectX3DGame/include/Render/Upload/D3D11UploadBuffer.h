@@ -0,0 +1,25 @@
+#pragma once
+#include "OWin/OWin.h"
+#include "OWin/OWrl.h"
+#include "Render/Upload/UploadBuffer.h"
+#include <d3d11.h>
+
+// Dynamic D3D11 buffer the CPU writes through Map. Constant buffers can only
+// be mapped with NoOverwrite on D3D11.1 drivers that report
+// MapNoOverwriteOnDynamicConstantBuffer, see IsNoOverwriteSupported.
+class D3D11UploadBuffer : public UploadBuffer
+{
+public:
+	D3D11UploadBuffer(ID3D11Device* pDevice, ID3D11DeviceContext* pContext, size_t size, UINT bindFlags);
+	D3D11UploadBuffer(const D3D11UploadBuffer&) = delete;
+	D3D11UploadBuffer& operator=(const D3D11UploadBuffer&) = delete;
+	std::byte* Map(MapMode mode) override;
+	void Unmap() noexcept override;
+	size_t GetSize() const noexcept override;
+	ID3D11Buffer* Get() const noexcept;
+	static bool IsNoOverwriteSupported(ID3D11Device* pDevice, UINT bindFlags) noexcept;
+private:
+	size_t size;
+	ID3D11DeviceContext* pContext;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> pBuffer;
+};
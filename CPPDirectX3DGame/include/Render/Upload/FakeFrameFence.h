@@ -0,0 +1,24 @@
+#pragma once
+#include "Render/Upload/FrameFence.h"
+#include <cstdint>
+#include <deque>
+
+// Simulated GPU that finishes a frame `latency` signals after it was
+// submitted. Waiting completes the frame immediately instead of blocking.
+class FakeFrameFence : public FrameFence
+{
+public:
+	FakeFrameFence(unsigned int latency = 2u);
+	void Signal(uint64_t value) override;
+	uint64_t GetCompletedValue() noexcept override;
+	void Wait(uint64_t value) override;
+	uint64_t GetSignaledValue() const noexcept;
+	uint64_t GetWaitCount() const noexcept;
+private:
+	unsigned int latency;
+	uint64_t signaled = 0u;
+	uint64_t completed = 0u;
+	uint64_t waits = 0u;
+	// signaled but not complete, oldest first
+	std::deque<uint64_t> pending;
+};
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+// Tells the CPU how far the GPU has got. Values are signaled in increasing
+// order, one per frame; D3D11FrameFence uses event queries, FakeFrameFence
+// completes a fixed number of frames behind.
+class FrameFence
+{
+public:
+	virtual ~FrameFence() = default;
+	// completes once the GPU has finished everything submitted before the call
+	virtual void Signal(uint64_t value) = 0;
+	// highest value known to be complete, does not block
+	virtual uint64_t GetCompletedValue() noexcept = 0;
+	// blocks until value is complete
+	virtual void Wait(uint64_t value) = 0;
+};
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+
+// Memory the UploadRing sub-allocates from. D3D11UploadBuffer wraps a dynamic
+// D3D11 buffer, CpuUploadBuffer keeps the bytes in system memory so the ring
+// can be exercised without a device.
+class UploadBuffer
+{
+public:
+	enum class MapMode
+	{
+		// the previous contents may still be in use, hand out fresh memory
+		Discard,
+		// the caller promises not to touch bytes written since the last discard
+		NoOverwrite,
+	};
+public:
+	virtual ~UploadBuffer() = default;
+	// the whole buffer, valid until Unmap
+	virtual std::byte* Map(MapMode mode) = 0;
+	virtual void Unmap() noexcept = 0;
+	virtual size_t GetSize() const noexcept = 0;
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include "Exception/OException.h"
+#include "Render/Upload/FrameFence.h"
+#include "Render/Upload/UploadBuffer.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+// Per-frame upload allocator over one large UploadBuffer. Allocate hands out
+// aligned slices by bumping a head offset through the buffer, which stays
+// mapped with NoOverwrite between Flush calls so consecutive allocations in
+// a frame, and in the frames after it, never touch bytes the GPU may still
+// read. When a slice does not fit before the end the buffer is mapped with
+// Discard and the head starts over at 0.
+// A discard hands out fresh memory for everything issued after it, so draws
+// referring to slices from before a wrap have to be issued before the wrap;
+// Allocation::generation tells the two apart.
+// EndFrame is called from Graphics::EndFrame with the value the frame fence
+// is about to be signaled with; at most maxFramesInFlight frames are kept
+// outstanding, waiting on the fence of the oldest one beyond that.
+class UploadRing
+{
+public:
+	class Exception : public OException
+	{
+	public:
+		Exception(int line, const char* file, std::string note) noexcept;
+		const char* what() const noexcept override;
+		const char* GetType() const noexcept override;
+		const std::string& GetNote() const noexcept;
+	private:
+		std::string note;
+	};
+	struct Allocation
+	{
+		// write only, valid until the next Flush
+		void* pData = nullptr;
+		// bytes from the start of the buffer, what gets bound
+		size_t offset = 0u;
+		size_t size = 0u;
+		// number of discards before this slice
+		uint64_t generation = 0u;
+	};
+	// counted per frame
+	struct Stats
+	{
+		uint64_t bytesUploaded = 0u;
+		// lost to alignment and to the tail skipped by a wrap
+		uint64_t bytesPadding = 0u;
+		uint64_t allocations = 0u;
+		uint64_t maps = 0u;
+		uint64_t wraps = 0u;
+		// EndFrame had to block on the fence
+		uint64_t waits = 0u;
+	};
+public:
+	UploadRing(UploadBuffer& buffer, FrameFence& fence, unsigned int maxFramesInFlight = 2u);
+	~UploadRing();
+	UploadRing(const UploadRing&) = delete;
+	UploadRing& operator=(const UploadRing&) = delete;
+	// alignment must be a power of two; throws when size exceeds the buffer
+	Allocation Allocate(size_t size, size_t alignment = 16u);
+	// unmaps so the uploaded slices can be drawn from, the next Allocate maps again
+	void Flush() noexcept;
+	void EndFrame(uint64_t fenceValue);
+	// the frame in progress
+	const Stats& GetFrameStats() const noexcept;
+	// the last frame passed to EndFrame
+	const Stats& GetStats() const noexcept;
+	// bytes written by frames the GPU has not finished yet, including this one
+	size_t GetBytesInFlight() noexcept;
+	size_t GetCapacity() const noexcept;
+private:
+	Allocation AllocateSlow(size_t size, size_t alignment);
+	void Retire() noexcept;
+private:
+	struct Frame
+	{
+		uint64_t fenceValue;
+		size_t bytes;
+	};
+private:
+	UploadBuffer& buffer;
+	FrameFence& fence;
+	unsigned int maxFramesInFlight;
+	size_t capacity;
+	std::byte* pMapped = nullptr;
+	size_t head = 0u;
+	uint64_t generation = 0u;
+	std::deque<Frame> frames;
+	Stats frame;
+	Stats last;
+};
+
+inline UploadRing::Allocation UploadRing::Allocate(size_t size, size_t alignment)
+{
+	assert(alignment != 0u && (alignment & (alignment - 1u)) == 0u && "alignment must be a power of two");
+	const size_t offset = (head + alignment - 1u) & ~(alignment - 1u);
+	if (pMapped != nullptr && offset + size <= capacity)
+	{
+		frame.bytesUploaded += size;
+		frame.bytesPadding += offset - head;
+		frame.allocations++;
+		head = offset + size;
+		return { pMapped + offset, offset, size, generation };
+	}
+	return AllocateSlow(size, alignment);
+}
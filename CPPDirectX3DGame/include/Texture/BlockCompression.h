@@ -0,0 +1,55 @@
+#pragma once
+#include "Texture/Image.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// Encoders for the BC formats D3D11 samples natively, one 4x4 block at a
+// time. BC1 and the color half of BC3 fit the endpoints along the principal
+// axis of the block's colors and refine them by least squares against the
+// chosen indices; the alpha half of BC3 spans the block's alpha range. BC7
+// is written in two of its eight modes, whichever fits the block better:
+// mode 6, one RGBA line with 16 levels, and mode 5, separate RGB and alpha
+// lines with 4 levels each. Skipping the partitioned modes costs quality on
+// blocks with several distinct colors but keeps the encoder fast and short.
+// The decoders are there to measure what the encoders lose and only read the
+// BC7 modes written here.
+namespace Bc
+{
+	enum class Format
+	{
+		// RGB, 4 bits per texel, alpha is dropped
+		BC1,
+		// RGBA, 8 bits per texel
+		BC3,
+		// RGBA, 8 bits per texel
+		BC7,
+	};
+
+	constexpr size_t GetBlockBytes(Format format) noexcept
+	{
+		return format == Format::BC1 ? 8u : 16u;
+	}
+	size_t GetEncodedSize(Format format, uint32_t width, uint32_t height) noexcept;
+	const char* GetFormatName(Format format) noexcept;
+
+	// pRgba holds 16 texels, rows of 4 top to bottom
+	void EncodeBlock(Format format, const uint8_t* pRgba, std::byte* pBlock) noexcept;
+	// false for BC7 blocks in a mode other than 5 or 6, which decode to zero
+	bool DecodeBlock(Format format, const std::byte* pBlock, uint8_t* pRgba) noexcept;
+
+	// Blocks over the image edge repeat the last row and column. Rows of
+	// blocks are spread over the job system, or encoded on the calling
+	// thread without one.
+	std::vector<std::byte> Encode(Format format, const Image& image, JobSystem* pJobs = nullptr);
+	// one row of blocks into pOut, for callers that schedule the rows themselves
+	void EncodeBlockRow(Format format, const Image& image, uint32_t blockRow, std::byte* pOut) noexcept;
+	// throws Image::Exception if data is smaller than the image needs
+	Image Decode(Format format, const std::byte* pData, size_t size, uint32_t width, uint32_t height);
+
+	// peak signal to noise ratio in dB over RGB, or RGBA with alpha; infinite
+	// for equal images. Throws Image::Exception if the sizes differ.
+	double ComputePsnr(const Image& a, const Image& b, bool alpha);
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "Texture/BlockCompression.h"
+#include "Texture/Image.h"
+#include "Texture/MipChain.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+// A texture ready for upload: the mip chain of a source image, block
+// compressed or left as RGBA8, every level back to back in one buffer.
+// Cooking spreads the rows of blocks of all levels over the job system in
+// one go, so the small levels do not each wait for a round of their own. WriteDds saves it
+// with the DX10 header extension, which D3D11 loaders read directly.
+class CookedTexture
+{
+public:
+	enum class Format
+	{
+		RGBA8,
+		BC1,
+		BC3,
+		BC7,
+		// BC1 for opaque images, BC3 otherwise
+		Auto,
+	};
+	struct Options
+	{
+		Format format = Format::Auto;
+		MipChain::Options mips;
+		// encodes on the calling thread without one
+		JobSystem* pJobs = nullptr;
+	};
+	struct Level
+	{
+		uint32_t width;
+		uint32_t height;
+		size_t offset;
+		size_t size;
+	};
+	struct Stats
+	{
+		double mipSeconds = 0.0;
+		double encodeSeconds = 0.0;
+		size_t blocks = 0u;
+		unsigned int threads = 0u;
+	};
+public:
+	// throws Image::Exception for an empty image
+	static CookedTexture Cook(const Image& image, const Options& options);
+	// never Auto
+	Format GetFormat() const noexcept;
+	bool IsSrgb() const noexcept;
+	size_t GetLevelCount() const noexcept;
+	const Level& GetLevel(size_t index) const noexcept;
+	const std::vector<std::byte>& GetData() const noexcept;
+	const Stats& GetStats() const noexcept;
+	// the level as the GPU will sample it
+	Image DecodeLevel(size_t index) const;
+	// throws Image::Exception if the file cannot be written
+	void WriteDds(const std::string& path) const;
+	static const char* GetFormatName(Format format) noexcept;
+	// the chain's size as RGBA8 over its cooked size, the VRAM saving
+	double GetCompressionRatio() const noexcept;
+private:
+	CookedTexture() = default;
+private:
+	Format format = Format::RGBA8;
+	bool srgb = true;
+	std::vector<Level> levels;
+	std::vector<std::byte> data;
+	Stats stats;
+};
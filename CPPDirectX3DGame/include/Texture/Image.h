@@ -0,0 +1,45 @@
+#pragma once
+#include "Exception/OException.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 8-bit RGBA pixels, rows top to bottom with no padding. Source images for
+// the texture cooker are decoded into this: uncompressed and palettized BMP,
+// ICO files holding BMP images (the largest one is taken) and TGA, plain or
+// RLE. PNG, also inside ICO, is not read.
+class Image
+{
+public:
+	class Exception : public OException
+	{
+	public:
+		Exception(int line, const char* file, std::string note) noexcept;
+		const char* what() const noexcept override;
+		const char* GetType() const noexcept override;
+		const std::string& GetNote() const noexcept;
+	private:
+		std::string note;
+	};
+public:
+	Image() = default;
+	// opaque black
+	Image(uint32_t width, uint32_t height);
+	// throws if the file cannot be read or decoded
+	static Image Load(const std::string& path);
+	// the format is told from the content, throws on damaged or unsupported data
+	static Image Decode(const std::byte* pData, size_t size);
+	uint32_t GetWidth() const noexcept;
+	uint32_t GetHeight() const noexcept;
+	uint8_t* GetPixels() noexcept;
+	const uint8_t* GetPixels() const noexcept;
+	uint8_t* GetPixel(uint32_t x, uint32_t y) noexcept;
+	const uint8_t* GetPixel(uint32_t x, uint32_t y) const noexcept;
+	// every alpha is 255
+	bool IsOpaque() const noexcept;
+private:
+	uint32_t width = 0u;
+	uint32_t height = 0u;
+	std::vector<uint8_t> pixels;
+};
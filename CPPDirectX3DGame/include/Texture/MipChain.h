@@ -0,0 +1,37 @@
+#pragma once
+#include "Texture/Image.h"
+#include <cstdint>
+#include <vector>
+
+// Mip chains filtered in linear light. sRGB sources are decoded to linear
+// floats, each level is resampled from the previous one without going back
+// to 8 bits in between, and the results are encoded again. Filtering runs on
+// whole RGBA pixels in OMath vectors, so one SSE or NEON operation covers
+// the four channels. Sides that are odd or not powers of two are handled by
+// computing the filter taps for each output pixel; edges clamp.
+namespace MipChain
+{
+	enum class Filter
+	{
+		// 2x2 average for even sides, the area covered for odd ones
+		Box,
+		// Kaiser windowed sinc three output pixels wide each side, sharper
+		// than the box without visible ringing
+		Kaiser,
+	};
+
+	struct Options
+	{
+		Filter filter = Filter::Kaiser;
+		// color channels are sRGB encoded, alpha is always linear
+		bool srgb = true;
+		// weight colors by alpha so transparent texels do not bleed their color
+		bool alphaWeighted = true;
+		// 0 for the full chain down to 1x1
+		uint32_t maxLevels = 0u;
+	};
+
+	uint32_t GetLevelCount(uint32_t width, uint32_t height) noexcept;
+	// level 0 is a copy of image
+	std::vector<Image> Build(const Image& image, const Options& options);
+}
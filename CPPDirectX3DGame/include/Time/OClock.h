@@ -0,0 +1,66 @@
+#pragma once
+#include "Time/OTimer.h"
+#include <cstdint>
+
+// Fixed timestep simulation clock on an integer tick base.
+// Each frame call Advance, run the returned number of fixed steps of
+// GetStepSeconds each, then render with GetAlpha to blend the last two
+// simulated states. Simulation speed is independent of frame rate.
+class OClock
+{
+public:
+	using Ticks = OTimer::Ticks;
+	static constexpr Ticks ticksPerSecond = OTimer::ticksPerSecond;
+public:
+	OClock(double stepSeconds = 1.0 / 60.0, unsigned int maxStepsPerFrame = 5u) noexcept;
+	// consume the time since the last call and return how many fixed steps to simulate
+	unsigned int Advance() noexcept;
+	// how far between the previous and the current simulated state we are, [0,1)
+	float GetAlpha() const noexcept;
+	// scaled duration of the last frame
+	float GetFrameSeconds() const noexcept;
+	// unscaled duration of the last frame, also while paused
+	float GetRealFrameSeconds() const noexcept;
+	float GetStepSeconds() const noexcept;
+	Ticks GetStepTicks() const noexcept;
+	// total simulated time, advances in whole steps
+	Ticks GetSimTicks() const noexcept;
+	double GetSimSeconds() const noexcept;
+	// simulated time blended by alpha, what the renderer should show
+	double GetInterpolatedSeconds() const noexcept;
+	uint64_t GetStepIndex() const noexcept;
+	// unscaled wall time consumed so far
+	Ticks GetRealTicks() const noexcept;
+	// time thrown away because the simulation could not keep up
+	Ticks GetDroppedTicks() const noexcept;
+	void SetStep(double stepSeconds) noexcept;
+	void SetMaxStepsPerFrame(unsigned int maxSteps) noexcept;
+	void SetTimeScale(double scale) noexcept;
+	double GetTimeScale() const noexcept;
+	void Pause() noexcept;
+	void Resume() noexcept;
+	bool IsPaused() const noexcept;
+	// feed a synthetic frame time instead of the wall clock, for reproducible runs
+	void EnableDeterministic(double frameSeconds) noexcept;
+	void DisableDeterministic() noexcept;
+	bool IsDeterministic() const noexcept;
+private:
+	static Ticks ToTicks(double seconds) noexcept;
+private:
+	OTimer timer;
+	Ticks step;
+	unsigned int maxStepsPerFrame;
+	Ticks accumulator = 0;
+	Ticks simTicks = 0;
+	Ticks realTicks = 0;
+	Ticks droppedTicks = 0;
+	Ticks frameTicks = 0;
+	Ticks realFrameTicks = 0;
+	uint64_t stepIndex = 0u;
+	double timeScale = 1.0;
+	// sub-tick remainder of scaled time so slow motion does not drift
+	double scaleCarry = 0.0;
+	bool paused = false;
+	bool deterministic = false;
+	Ticks syntheticFrame = 0;
+};
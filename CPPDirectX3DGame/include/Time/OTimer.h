@@ -1,11 +1,21 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
 
 class OTimer
 {
+public:
+	// integer time base, nanoseconds
+	using Ticks = int64_t;
+	static constexpr Ticks ticksPerSecond = 1000000000;
 public:
 	OTimer() noexcept;
 
+	/// <summary>
+	/// Current steady clock time in ticks, shared time base for event timestamps
+	/// </summary>
+	static Ticks Now() noexcept;
+
 	/// <summary>
 	/// Time elapsed since you last time called Mark
 	/// </summary>
@@ -16,6 +26,16 @@ public:
 	/// </summary>
 	float Peek() const noexcept;
 
+	/// <summary>
+	/// Same as Mark but in ticks, exact no matter how long the session runs
+	/// </summary>
+	Ticks MarkTicks() noexcept;
+
+	/// <summary>
+	/// Same as Peek but in ticks
+	/// </summary>
+	Ticks PeekTicks() const noexcept;
+
 private:
 	std::chrono::steady_clock::time_point last;
 };
@@ -5,6 +5,7 @@
 #include "Input/Mouse.h"
 #include "Render/Graphics.h"
 #include <optional>
+#include <array>
 #include <memory>
 #include <iostream>
 
@@ -67,6 +68,15 @@ public:
 
 	void SetTitle(const std::string& title);
 
+	void SetTitle(const char* title);
+
+	// client area size; the swap chain keeps its size and is stretched
+	void Resize(int width, int height);
+
+	int GetWidth() const noexcept;
+
+	int GetHeight() const noexcept;
+
 	void EnableCursor() noexcept;
 
 	void DisableCursor() noexcept;
@@ -92,6 +102,10 @@ private:
 
 	LRESULT HandleMsg(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) noexcept;
 
+	void ReadRawInputBatch() noexcept;
+
+	void ProcessRawInput(const RAWINPUT& ri) noexcept;
+
 public:
 	Keyboard keyboard;
 	Mouse mouse;
@@ -101,6 +115,7 @@ private:
 	int height;
 	HWND hWnd;
 	std::unique_ptr<Graphics> pGfx;
-	std::vector<BYTE> rawBuffer;
+	// batch storage for raw input reads, sized once
+	std::array<RAWINPUT, 64> rawBuffer;
 	std::string commandLine;
 };
@@ -0,0 +1,558 @@
+#include "Asset/AssetStreamer.h"
+#include "Asset/PackArchive.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#define STREAM_EXCEPT(note) AssetStreamer::Exception(__LINE__, __FILE__, (note))
+
+bool AssetStreamer::Priority::operator<(const Priority& other) const noexcept
+{
+	if (visible != other.visible)
+	{
+		return visible;
+	}
+	return distance < other.distance;
+}
+
+void AssetStreamer::Queue::Push(const Entry& entry)
+{
+	entries.push_back(entry);
+	std::push_heap(entries.begin(), entries.end(), &After);
+}
+
+const AssetStreamer::Entry& AssetStreamer::Queue::Top() const noexcept
+{
+	return entries.front();
+}
+
+void AssetStreamer::Queue::Pop()
+{
+	std::pop_heap(entries.begin(), entries.end(), &After);
+	entries.pop_back();
+}
+
+bool AssetStreamer::Queue::IsEmpty() const noexcept
+{
+	return entries.empty();
+}
+
+size_t AssetStreamer::Queue::GetSize() const noexcept
+{
+	return entries.size();
+}
+
+template<typename F>
+void AssetStreamer::Queue::Compact(F&& pred)
+{
+	entries.erase(std::remove_if(entries.begin(), entries.end(), pred), entries.end());
+	std::make_heap(entries.begin(), entries.end(), &After);
+}
+
+bool AssetStreamer::Queue::After(const Entry& a, const Entry& b) noexcept
+{
+	// std heaps keep the largest on top, so the order is reversed; equal
+	// priorities go in request order
+	if (a.priority < b.priority)
+	{
+		return false;
+	}
+	if (b.priority < a.priority)
+	{
+		return true;
+	}
+	return a.sequence > b.sequence;
+}
+
+AssetStreamer::AssetStreamer()
+	:
+	AssetStreamer(Config{})
+{
+}
+
+AssetStreamer::AssetStreamer(Config config)
+	:
+	config(std::move(config))
+{
+	if (this->config.ioThreads == 0u)
+	{
+		throw STREAM_EXCEPT("The streamer needs at least one I/O thread");
+	}
+	if (!this->config.reader)
+	{
+		this->config.reader = &AssetStreamer::ReadFile;
+		if (!this->config.sizer)
+		{
+			this->config.sizer = &AssetStreamer::GetFileSize;
+		}
+	}
+	if (!this->config.sizer)
+	{
+		throw STREAM_EXCEPT("A custom reader needs a sizer to keep to the memory budget");
+	}
+	unsigned int decodeThreads = 0u;
+	if (this->config.decoder)
+	{
+		decodeThreads = this->config.decodeThreads;
+		if (decodeThreads == 0u)
+		{
+			const unsigned int cores = std::max(std::thread::hardware_concurrency(), 1u);
+			decodeThreads = cores > this->config.ioThreads ? cores - this->config.ioThreads : 1u;
+		}
+	}
+	try
+	{
+		for (unsigned int i = 0; i < this->config.ioThreads; i++)
+		{
+			threads.emplace_back(&AssetStreamer::IoLoop, this);
+		}
+		for (unsigned int i = 0; i < decodeThreads; i++)
+		{
+			threads.emplace_back(&AssetStreamer::DecodeLoop, this);
+		}
+	}
+	catch (...)
+	{
+		Stop();
+		throw;
+	}
+}
+
+AssetStreamer::~AssetStreamer()
+{
+	Stop();
+}
+
+void AssetStreamer::Stop() noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		stopping = true;
+	}
+	cvIo.notify_all();
+	cvDecode.notify_all();
+	for (std::thread& thread : threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+}
+
+AssetStreamer::Handle AssetStreamer::Request(std::string name, Priority priority, Uploader upload)
+{
+	// may touch the disk, so outside the lock
+	const size_t reserved = config.sizer(name);
+	std::lock_guard<std::mutex> lock(mtx);
+	const Handle handle = nextHandle++;
+	Item& item = items.emplace(handle, Item{ std::move(name), priority, State::Queued, 0u, false, false,
+		OTimer::Now(), reserved, 0u, std::move(upload), {}, {} }).first->second;
+	depths[size_t(State::Queued)]++;
+	stats.requests++;
+	Push(ioQueue, handle, item);
+	cvIo.notify_one();
+	return handle;
+}
+
+bool AssetStreamer::SetPriority(Handle handle, Priority priority)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	const auto it = items.find(handle);
+	if (it == items.end() || it->second.cancelled)
+	{
+		return false;
+	}
+	Item& item = it->second;
+	item.priority = priority;
+	// a thread working on it pushes it on with the new priority when done
+	if (!item.busy)
+	{
+		item.version++;
+		Push(QueueOf(item.state), handle, item);
+	}
+	return true;
+}
+
+bool AssetStreamer::Cancel(Handle handle)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	const auto it = items.find(handle);
+	if (it == items.end() || it->second.cancelled)
+	{
+		return false;
+	}
+	stats.cancels++;
+	if (it->second.busy)
+	{
+		// the read or decode cannot be interrupted, its thread drops it after
+		it->second.cancelled = true;
+		return true;
+	}
+	Drop(it);
+	cvIo.notify_all();
+	return true;
+}
+
+AssetStreamer::State AssetStreamer::GetState(Handle handle) const
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	const auto it = items.find(handle);
+	return it == items.end() || it->second.cancelled ? State::None : it->second.state;
+}
+
+size_t AssetStreamer::Pump()
+{
+	O_PROFILE_FUNCTION();
+	size_t uploads = 0u;
+	size_t bytes = 0u;
+	std::unique_lock<std::mutex> lock(mtx);
+	while (Peek(readyQueue, State::Ready))
+	{
+		const Handle handle = readyQueue.Top().handle;
+		const size_t size = items.at(handle).data.size();
+		// the first asset of a frame always goes, or one over the budget never would
+		if (bytes > 0u && bytes + size > config.uploadBytesPerFrame)
+		{
+			break;
+		}
+		readyQueue.Pop();
+		auto node = items.extract(handle);
+		Item& item = node.mapped();
+		depths[size_t(State::Ready)]--;
+		stats.residentBytes -= item.resident;
+		if (item.error.empty())
+		{
+			latencies[latencyNext] = float(OTimer::Now() - item.requested) * (1000.0f / float(OTimer::ticksPerSecond));
+			latencyNext = (latencyNext + 1u) % latencyWindow;
+			latencyCount = std::min(latencyCount + 1u, latencyWindow);
+			stats.uploads++;
+			stats.bytesUploaded += size;
+			uploads++;
+			bytes += size;
+		}
+		else
+		{
+			stats.failures++;
+		}
+		// memory was freed, reads held back by the budget can go on
+		cvIo.notify_all();
+		if (item.upload)
+		{
+			// unlocked so the uploader can request more
+			lock.unlock();
+			item.upload(Asset{ handle, item.name, item.data, item.error });
+			lock.lock();
+		}
+	}
+	stats.frameUploads = uploads;
+	stats.frameBytes = bytes;
+	return uploads;
+}
+
+AssetStreamer::Stats AssetStreamer::GetStats() const
+{
+	std::array<float, latencyWindow> sorted;
+	Stats result;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		result = stats;
+		result.queued = depths[size_t(State::Queued)];
+		result.reading = depths[size_t(State::Reading)];
+		result.decoding = depths[size_t(State::Decoding)];
+		result.ready = depths[size_t(State::Ready)];
+		result.latencyCount = latencyCount;
+		std::copy_n(latencies.begin(), latencyCount, sorted.begin());
+	}
+	const size_t count = result.latencyCount;
+	if (count == 0u)
+	{
+		return result;
+	}
+	const auto first = sorted.begin();
+	const auto last = sorted.begin() + count;
+	// nearest rank, like FrameStats
+	const auto percentile = [&](float p)
+	{
+		const size_t rank = std::min(size_t(p * float(count)), count - 1u);
+		std::nth_element(first, first + rank, last);
+		return sorted[rank];
+	};
+	result.p50Ms = percentile(0.50f);
+	result.p95Ms = percentile(0.95f);
+	result.p99Ms = percentile(0.99f);
+	result.maxMs = *std::max_element(first, last);
+	return result;
+}
+
+AssetStreamer::Reader AssetStreamer::MakePackReader(const PackArchive& archive)
+{
+	return [&archive](const std::string& name, std::vector<std::byte>& data)
+	{
+		const size_t index = archive.Find(name);
+		if (index == PackArchive::npos)
+		{
+			return false;
+		}
+		data.resize(size_t(archive.GetEntry(index).size));
+		archive.ReadInto(index, data);
+		return true;
+	};
+}
+
+AssetStreamer::Sizer AssetStreamer::MakePackSizer(const PackArchive& archive)
+{
+	return [&archive](const std::string& name)
+	{
+		const size_t index = archive.Find(name);
+		return index == PackArchive::npos ? size_t(0u) : size_t(archive.GetEntry(index).size);
+	};
+}
+
+size_t AssetStreamer::GetFileSize(const std::string& path)
+{
+	// a missing file fails in the read
+	std::error_code error;
+	const uintmax_t size = std::filesystem::file_size(path, error);
+	return error ? 0u : size_t(size);
+}
+
+bool AssetStreamer::ReadFile(const std::string& path, std::vector<std::byte>& data)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+	data.resize(size_t(file.tellg()));
+	file.seekg(0);
+	return bool(file.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size())));
+}
+
+void AssetStreamer::IoLoop() noexcept
+{
+	O_PROFILE_THREAD("Stream I/O");
+	std::unique_lock<std::mutex> lock(mtx);
+	while (true)
+	{
+		cvIo.wait(lock, [this]
+		{
+			return stopping || (Peek(ioQueue, State::Queued) && CanRead());
+		});
+		if (stopping)
+		{
+			return;
+		}
+		const Handle handle = ioQueue.Top().handle;
+		ioQueue.Pop();
+		// elements of the map stay where they are, and nobody else erases a busy one
+		Item& item = items.at(handle);
+		SetState(item, State::Reading);
+		item.busy = true;
+		SetResident(item, item.reserved);
+		lock.unlock();
+
+		std::vector<std::byte> data;
+		std::string error;
+		{
+			O_PROFILE_SCOPE("AssetStreamer::Read");
+			try
+			{
+				if (!config.reader(item.name, data))
+				{
+					error = "Cannot read " + item.name;
+				}
+			}
+			catch (const std::exception& e)
+			{
+				error = e.what();
+			}
+			catch (...)
+			{
+				error = "Unknown error reading " + item.name;
+			}
+		}
+
+		lock.lock();
+		item.data = std::move(data);
+		Finish(handle, item, std::move(error));
+	}
+}
+
+void AssetStreamer::DecodeLoop() noexcept
+{
+	O_PROFILE_THREAD("Stream Decode");
+	std::unique_lock<std::mutex> lock(mtx);
+	while (true)
+	{
+		cvDecode.wait(lock, [this] { return stopping || Peek(decodeQueue, State::Decoding); });
+		if (stopping)
+		{
+			return;
+		}
+		const Handle handle = decodeQueue.Top().handle;
+		decodeQueue.Pop();
+		Item& item = items.at(handle);
+		item.busy = true;
+		// still counted as resident while out of the item
+		std::vector<std::byte> data = std::move(item.data);
+		lock.unlock();
+
+		std::string error;
+		{
+			O_PROFILE_SCOPE("AssetStreamer::Decode");
+			try
+			{
+				config.decoder(item.name, data);
+			}
+			catch (const std::exception& e)
+			{
+				error = e.what();
+			}
+			catch (...)
+			{
+				error = "Unknown error decoding " + item.name;
+			}
+		}
+
+		lock.lock();
+		item.data = std::move(data);
+		Finish(handle, item, std::move(error));
+	}
+}
+
+bool AssetStreamer::Peek(Queue& queue, State state)
+{
+	while (!queue.IsEmpty())
+	{
+		const Entry& top = queue.Top();
+		const auto it = items.find(top.handle);
+		if (it != items.end() && it->second.version == top.version && it->second.state == state && !it->second.busy)
+		{
+			return true;
+		}
+		queue.Pop();
+	}
+	return false;
+}
+
+void AssetStreamer::Push(Queue& queue, Handle handle, Item& item)
+{
+	queue.Push(Entry{ item.priority, sequence++, handle, item.version });
+	// priority updates every frame would grow the heap without bound
+	// while nothing is popped, sweep the stale entries once they dominate
+	const size_t live = depths[size_t(item.state)];
+	if (queue.GetSize() > 2u * live + 64u)
+	{
+		queue.Compact([this, state = item.state](const Entry& entry)
+		{
+			const auto it = items.find(entry.handle);
+			return it == items.end() || it->second.version != entry.version || it->second.state != state || it->second.busy;
+		});
+	}
+}
+
+AssetStreamer::Queue& AssetStreamer::QueueOf(State state) noexcept
+{
+	switch (state)
+	{
+	case State::Queued:
+		return ioQueue;
+	case State::Decoding:
+		return decodeQueue;
+	default:
+		return readyQueue;
+	}
+}
+
+void AssetStreamer::SetState(Item& item, State state) noexcept
+{
+	depths[size_t(item.state)]--;
+	depths[size_t(state)]++;
+	item.state = state;
+}
+
+bool AssetStreamer::CanRead() const
+{
+	const size_t reserved = items.at(ioQueue.Top().handle).reserved;
+	// with nothing resident even an asset over the budget has to go
+	return stats.residentBytes == 0u || stats.residentBytes + reserved <= config.memoryBudget;
+}
+
+void AssetStreamer::SetResident(Item& item, size_t bytes) noexcept
+{
+	stats.residentBytes = stats.residentBytes - item.resident + bytes;
+	stats.peakResidentBytes = std::max(stats.peakResidentBytes, stats.residentBytes);
+	item.resident = bytes;
+}
+
+void AssetStreamer::Finish(Handle handle, Item& item, std::string error)
+{
+	item.busy = false;
+	// a sizer that under-reported, the excess counts from here on
+	SetResident(item, std::max(item.reserved, item.data.size()));
+	if (item.cancelled)
+	{
+		Drop(items.find(handle));
+		cvIo.notify_all();
+		return;
+	}
+	if (!error.empty())
+	{
+		// failures go to the uploader like any asset, without data
+		item.data.clear();
+		SetResident(item, 0u);
+		cvIo.notify_all();
+		item.error = std::move(error);
+		SetState(item, State::Ready);
+	}
+	else if (item.state == State::Reading && config.decoder)
+	{
+		SetState(item, State::Decoding);
+		cvDecode.notify_one();
+	}
+	else
+	{
+		SetState(item, State::Ready);
+	}
+	// the priority may have changed while the thread had it
+	item.version++;
+	Push(QueueOf(item.state), handle, item);
+}
+
+void AssetStreamer::Drop(std::unordered_map<Handle, Item>::iterator it) noexcept
+{
+	depths[size_t(it->second.state)]--;
+	stats.residentBytes -= it->second.resident;
+	items.erase(it);
+}
+
+// AssetStreamer exception
+AssetStreamer::Exception::Exception(int line, const char* file, std::string note) noexcept
+	:
+	OException(line, file),
+	note(std::move(note))
+{
+}
+
+const char* AssetStreamer::Exception::what() const noexcept
+{
+	std::ostringstream oss;
+	oss << GetType() << std::endl
+		<< "[Note] " << GetNote() << std::endl
+		<< GetOriginString();
+	whatBuffer = oss.str();
+	return whatBuffer.c_str();
+}
+
+const char* AssetStreamer::Exception::GetType() const noexcept
+{
+	return "O Asset Streamer Exception";
+}
+
+const std::string& AssetStreamer::Exception::GetNote() const noexcept
+{
+	return note;
+}
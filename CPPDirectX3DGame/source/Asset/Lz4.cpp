@@ -0,0 +1,234 @@
+#include "Asset/Lz4.h"
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+	constexpr size_t minMatch = 4u;
+	// the format ends every block with at least this many literals
+	constexpr size_t lastLiterals = 5u;
+	// and no match may start closer to the end than this
+	constexpr size_t matchStartLimit = 12u;
+	constexpr size_t maxOffset = 65535u;
+	constexpr unsigned int hashBits = 12u;
+
+	uint32_t Read32(const uint8_t* p) noexcept
+	{
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	uint32_t Hash(uint32_t sequence) noexcept
+	{
+		return (sequence * 2654435761u) >> (32u - hashBits);
+	}
+
+	// token nibble overflow, a run of 255s and the remainder
+	bool WriteLength(uint8_t*& op, const uint8_t* oend, size_t length) noexcept
+	{
+		while (length >= 255u)
+		{
+			if (op >= oend)
+			{
+				return false;
+			}
+			*op++ = 255u;
+			length -= 255u;
+		}
+		if (op >= oend)
+		{
+			return false;
+		}
+		*op++ = uint8_t(length);
+		return true;
+	}
+
+	bool ReadLength(const uint8_t*& ip, const uint8_t* iend, size_t& length) noexcept
+	{
+		uint8_t byte;
+		do
+		{
+			if (ip >= iend)
+			{
+				return false;
+			}
+			byte = *ip++;
+			length += byte;
+		} while (byte == 255u);
+		return true;
+	}
+
+	bool WriteSequence(uint8_t*& op, const uint8_t* oend, const uint8_t* pLiterals, size_t literals,
+		size_t offset, size_t matchLength, bool last) noexcept
+	{
+		if (op >= oend)
+		{
+			return false;
+		}
+		uint8_t* pToken = op++;
+		const size_t literalNibble = literals < 15u ? literals : 15u;
+		if (literals >= 15u && !WriteLength(op, oend, literals - 15u))
+		{
+			return false;
+		}
+		if (size_t(oend - op) < literals)
+		{
+			return false;
+		}
+		if (literals > 0u)
+		{
+			std::memcpy(op, pLiterals, literals);
+			op += literals;
+		}
+		if (last)
+		{
+			*pToken = uint8_t(literalNibble << 4);
+			return true;
+		}
+		if (oend - op < 2)
+		{
+			return false;
+		}
+		*op++ = uint8_t(offset);
+		*op++ = uint8_t(offset >> 8);
+		const size_t extra = matchLength - minMatch;
+		const size_t matchNibble = extra < 15u ? extra : 15u;
+		if (extra >= 15u && !WriteLength(op, oend, extra - 15u))
+		{
+			return false;
+		}
+		*pToken = uint8_t((literalNibble << 4) | matchNibble);
+		return true;
+	}
+}
+
+namespace Lz4
+{
+	size_t Compress(const std::byte* pSource, size_t size, std::byte* pDestination, size_t capacity) noexcept
+	{
+		const uint8_t* const src = reinterpret_cast<const uint8_t*>(pSource);
+		const uint8_t* const end = src + size;
+		uint8_t* op = reinterpret_cast<uint8_t*>(pDestination);
+		const uint8_t* const oend = op + capacity;
+		const uint8_t* anchor = src;
+
+		if (size > matchStartLimit)
+		{
+			// positions relative to src, a stale or empty slot only costs a failed compare
+			uint32_t table[size_t(1) << hashBits] = {};
+			const uint8_t* const matchLimit = end - matchStartLimit;
+			const uint8_t* const extendLimit = end - lastLiterals;
+			const uint8_t* ip = src + 1u;
+			table[Hash(Read32(src))] = 0u;
+			// skip faster through data that does not match, like the reference
+			unsigned int misses = 0u;
+			while (ip < matchLimit)
+			{
+				const uint32_t sequence = Read32(ip);
+				const uint32_t h = Hash(sequence);
+				const uint8_t* ref = src + table[h];
+				table[h] = uint32_t(ip - src);
+				if (ref >= ip || size_t(ip - ref) > maxOffset || Read32(ref) != sequence)
+				{
+					ip += 1u + (misses++ >> 6);
+					continue;
+				}
+				misses = 0u;
+				// grow the match backwards over literals that also match
+				while (ip > anchor && ref > src && ip[-1] == ref[-1])
+				{
+					ip--;
+					ref--;
+				}
+				const uint8_t* matchEnd = ip + minMatch;
+				const uint8_t* r = ref + minMatch;
+				while (matchEnd < extendLimit && *matchEnd == *r)
+				{
+					matchEnd++;
+					r++;
+				}
+				if (!WriteSequence(op, oend, anchor, size_t(ip - anchor), size_t(ip - ref), size_t(matchEnd - ip), false))
+				{
+					return 0u;
+				}
+				// the position just before the end is likely to start the next match
+				if (matchEnd - 2 > src)
+				{
+					table[Hash(Read32(matchEnd - 2))] = uint32_t(matchEnd - 2 - src);
+				}
+				ip = matchEnd;
+				anchor = ip;
+			}
+		}
+		if (!WriteSequence(op, oend, anchor, size_t(end - anchor), 0u, 0u, true))
+		{
+			return 0u;
+		}
+		return size_t(op - reinterpret_cast<uint8_t*>(pDestination));
+	}
+
+	bool Decompress(const std::byte* pSource, size_t sourceSize, std::byte* pDestination, size_t size) noexcept
+	{
+		const uint8_t* ip = reinterpret_cast<const uint8_t*>(pSource);
+		const uint8_t* const iend = ip + sourceSize;
+		uint8_t* const dst = reinterpret_cast<uint8_t*>(pDestination);
+		uint8_t* op = dst;
+		uint8_t* const oend = dst + size;
+		while (ip < iend)
+		{
+			const uint8_t token = *ip++;
+			size_t literals = token >> 4;
+			if (literals == 15u && !ReadLength(ip, iend, literals))
+			{
+				return false;
+			}
+			if (size_t(iend - ip) < literals || size_t(oend - op) < literals)
+			{
+				return false;
+			}
+			if (literals > 0u)
+			{
+				std::memcpy(op, ip, literals);
+				ip += literals;
+				op += literals;
+			}
+			if (ip == iend)
+			{
+				// the last sequence has no match
+				break;
+			}
+			if (iend - ip < 2)
+			{
+				return false;
+			}
+			const size_t offset = size_t(ip[0]) | (size_t(ip[1]) << 8);
+			ip += 2;
+			size_t matchLength = token & 15u;
+			if (matchLength == 15u && !ReadLength(ip, iend, matchLength))
+			{
+				return false;
+			}
+			matchLength += minMatch;
+			if (offset == 0u || offset > size_t(op - dst) || size_t(oend - op) < matchLength)
+			{
+				return false;
+			}
+			const uint8_t* match = op - offset;
+			if (offset >= matchLength)
+			{
+				std::memcpy(op, match, matchLength);
+				op += matchLength;
+			}
+			else
+			{
+				// overlapping, the copy repeats the last offset bytes
+				for (size_t i = 0; i < matchLength; i++)
+				{
+					*op++ = *match++;
+				}
+			}
+		}
+		return op == oend;
+	}
+}
@@ -0,0 +1,129 @@
+#include "Asset/MappedFile.h"
+#include <utility>
+#ifdef _WIN32
+// the trimmed down Windows.h leaves out the file mapping API
+#define FULL_WINTARD
+#include "OWin/OWin.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	:
+	pData(std::exchange(other.pData, nullptr)),
+	size(std::exchange(other.size, 0u)),
+	open(std::exchange(other.open, false))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		pData = std::exchange(other.pData, nullptr);
+		size = std::exchange(other.size, 0u);
+		open = std::exchange(other.open, false);
+	}
+	return *this;
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+#ifdef _WIN32
+	const HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(hFile, &fileSize))
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+	if (fileSize.QuadPart > 0)
+	{
+		// the view keeps the mapping and the file alive, both handles can go
+		const HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+		if (hMapping != nullptr)
+		{
+			pData = static_cast<const std::byte*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0u, 0u, 0u));
+			CloseHandle(hMapping);
+		}
+		if (pData == nullptr)
+		{
+			CloseHandle(hFile);
+			return false;
+		}
+	}
+	CloseHandle(hFile);
+	size = size_t(fileSize.QuadPart);
+#else
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat info = {};
+	if (fstat(fd, &info) != 0)
+	{
+		::close(fd);
+		return false;
+	}
+	if (info.st_size > 0)
+	{
+		void* p = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p == MAP_FAILED)
+		{
+			::close(fd);
+			return false;
+		}
+		pData = static_cast<const std::byte*>(p);
+	}
+	// the mapping holds its own reference to the file
+	::close(fd);
+	size = size_t(info.st_size);
+#endif
+	open = true;
+	return true;
+}
+
+void MappedFile::Close() noexcept
+{
+	if (pData != nullptr)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(pData);
+#else
+		munmap(const_cast<std::byte*>(pData), size);
+#endif
+	}
+	pData = nullptr;
+	size = 0u;
+	open = false;
+}
+
+bool MappedFile::IsOpen() const noexcept
+{
+	return open;
+}
+
+const std::byte* MappedFile::GetData() const noexcept
+{
+	return pData;
+}
+
+size_t MappedFile::GetSize() const noexcept
+{
+	return size;
+}
@@ -0,0 +1,201 @@
+#include "Asset/PackArchive.h"
+#include "Asset/Lz4.h"
+#include "Core/ContentHash.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#define PACK_EXCEPT(note) PackArchive::Exception(__LINE__, __FILE__, (note))
+
+PackArchive::PackArchive(const std::string& path)
+{
+	if (!file.Open(path))
+	{
+		throw PACK_EXCEPT("Cannot open archive " + path);
+	}
+	pData = file.GetData();
+	size = file.GetSize();
+	Validate();
+}
+
+PackArchive::PackArchive(const std::byte* pData, size_t size)
+	:
+	pData(pData),
+	size(size)
+{
+	Validate();
+}
+
+size_t PackArchive::GetEntryCount() const noexcept
+{
+	return pHeader->entryCount;
+}
+
+PackArchive::Entry PackArchive::GetEntry(size_t index) const noexcept
+{
+	const Pack::TocEntry& toc = GetToc(index);
+	return { std::string_view(pNames + toc.nameOffset, toc.nameSize), toc.size, toc.storedSize, toc.compression };
+}
+
+size_t PackArchive::Find(std::string_view name) const noexcept
+{
+	const uint64_t hash = Pack::HashName(name);
+	const Pack::TocEntry* pEnd = pToc + pHeader->entryCount;
+	const Pack::TocEntry* p = std::lower_bound(pToc, pEnd, hash, [](const Pack::TocEntry& entry, uint64_t value)
+	{
+		return entry.nameHash < value;
+	});
+	for (; p != pEnd && p->nameHash == hash; p++)
+	{
+		if (std::string_view(pNames + p->nameOffset, p->nameSize) == name)
+		{
+			return size_t(p - pToc);
+		}
+	}
+	return npos;
+}
+
+bool PackArchive::IsDirect(size_t index) const noexcept
+{
+	return GetToc(index).compression == Pack::Compression::None;
+}
+
+std::span<const std::byte> PackArchive::Read(size_t index, std::vector<std::byte>& scratch) const
+{
+	const Pack::TocEntry& toc = GetToc(index);
+	if (toc.compression == Pack::Compression::None)
+	{
+		return { pData + toc.offset, size_t(toc.size) };
+	}
+	scratch.resize(size_t(toc.size));
+	ReadInto(index, scratch);
+	return scratch;
+}
+
+void PackArchive::ReadInto(size_t index, std::span<std::byte> destination) const
+{
+	const Pack::TocEntry& toc = GetToc(index);
+	const std::string_view name(pNames + toc.nameOffset, toc.nameSize);
+	if (destination.size() != toc.size)
+	{
+		throw PACK_EXCEPT("Destination for " + std::string(name) + " holds " + std::to_string(destination.size()) +
+			" bytes, the entry has " + std::to_string(toc.size));
+	}
+	switch (toc.compression)
+	{
+	case Pack::Compression::None:
+		if (toc.size > 0u)
+		{
+			std::memcpy(destination.data(), pData + toc.offset, size_t(toc.size));
+		}
+		break;
+	case Pack::Compression::Lz4:
+		if (!Lz4::Decompress(pData + toc.offset, size_t(toc.storedSize), destination.data(), destination.size()))
+		{
+			throw PACK_EXCEPT("Entry " + std::string(name) + " is damaged");
+		}
+		break;
+	default:
+		throw PACK_EXCEPT("Entry " + std::string(name) + " uses an unknown compression");
+	}
+}
+
+bool PackArchive::Verify(size_t index) const
+{
+	const Pack::TocEntry& toc = GetToc(index);
+	std::vector<std::byte> scratch;
+	std::span<const std::byte> data;
+	try
+	{
+		data = Read(index, scratch);
+	}
+	catch (const Exception&)
+	{
+		return false;
+	}
+	ContentHash hash;
+	hash.Add(data.data(), data.size());
+	uint64_t hi, lo;
+	hash.Finish(hi, lo);
+	return hi == toc.hashHi && lo == toc.hashLo;
+}
+
+void PackArchive::Validate()
+{
+	if (size < sizeof(Pack::Header) || pData == nullptr)
+	{
+		throw PACK_EXCEPT("Archive is too small to hold a header");
+	}
+	pHeader = reinterpret_cast<const Pack::Header*>(pData);
+	if (std::memcmp(pHeader->magic, Pack::magic, sizeof(Pack::magic)) != 0)
+	{
+		throw PACK_EXCEPT("Not an archive");
+	}
+	if (pHeader->version != Pack::version)
+	{
+		throw PACK_EXCEPT("Archive version " + std::to_string(pHeader->version) + " is not supported");
+	}
+	const uint64_t tocEnd = sizeof(Pack::Header) + uint64_t(pHeader->entryCount) * sizeof(Pack::TocEntry);
+	if (pHeader->fileSize != size || tocEnd > size || pHeader->namesOffset < tocEnd ||
+		pHeader->namesSize > size - pHeader->namesOffset || pHeader->namesOffset > size)
+	{
+		throw PACK_EXCEPT("Archive is truncated or its header is damaged");
+	}
+	pToc = reinterpret_cast<const Pack::TocEntry*>(pData + sizeof(Pack::Header));
+	pNames = reinterpret_cast<const char*>(pData + pHeader->namesOffset);
+
+	ContentHash hash;
+	hash.Add(pToc, size_t(tocEnd - sizeof(Pack::Header)));
+	hash.Add(pNames, size_t(pHeader->namesSize));
+	uint64_t hi, lo;
+	hash.Finish(hi, lo);
+	if (hi != pHeader->tocHash)
+	{
+		throw PACK_EXCEPT("Archive table of contents is damaged");
+	}
+	// with the table intact, only a bad packer could produce these
+	for (uint32_t i = 0; i < pHeader->entryCount; i++)
+	{
+		const Pack::TocEntry& toc = pToc[i];
+		if (uint64_t(toc.nameOffset) + toc.nameSize > pHeader->namesSize ||
+			toc.offset > size || toc.storedSize > size - toc.offset ||
+			(toc.compression == Pack::Compression::None && toc.storedSize != toc.size) ||
+			(i > 0u && toc.nameHash < pToc[i - 1u].nameHash))
+		{
+			throw PACK_EXCEPT("Archive entry " + std::to_string(i) + " is out of bounds");
+		}
+	}
+}
+
+const Pack::TocEntry& PackArchive::GetToc(size_t index) const noexcept
+{
+	return pToc[index];
+}
+
+// Pack archive exception
+PackArchive::Exception::Exception(int line, const char* file, std::string note) noexcept
+	:
+	OException(line, file),
+	note(std::move(note))
+{
+}
+
+const char* PackArchive::Exception::what() const noexcept
+{
+	std::ostringstream oss;
+	oss << GetType() << std::endl
+		<< "[Note] " << GetNote() << std::endl
+		<< GetOriginString();
+	whatBuffer = oss.str();
+	return whatBuffer.c_str();
+}
+
+const char* PackArchive::Exception::GetType() const noexcept
+{
+	return "O Pack Archive Exception";
+}
+
+const std::string& PackArchive::Exception::GetNote() const noexcept
+{
+	return note;
+}
@@ -0,0 +1,178 @@
+#include "Asset/PackWriter.h"
+#include "Asset/Lz4.h"
+#include "Asset/PackArchive.h"
+#include "Core/ContentHash.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+
+#define PACK_EXCEPT(note) PackArchive::Exception(__LINE__, __FILE__, (note))
+
+namespace
+{
+	uint64_t AlignUp(uint64_t value, uint64_t alignment) noexcept
+	{
+		return (value + alignment - 1u) & ~(alignment - 1u);
+	}
+}
+
+PackWriter::PackWriter(Options options)
+	:
+	options(options)
+{
+	if (options.alignment == 0u || (options.alignment & (options.alignment - 1u)) != 0u)
+	{
+		throw PACK_EXCEPT("Pack alignment " + std::to_string(options.alignment) + " is not a power of two");
+	}
+}
+
+void PackWriter::Add(std::string name, std::vector<std::byte> data, bool compress)
+{
+	if (!names.insert(name).second)
+	{
+		throw PACK_EXCEPT("Archive already has an entry " + name);
+	}
+	pending.push_back({ std::move(name), std::move(data), compress });
+}
+
+void PackWriter::AddFile(std::string name, const std::string& path, bool compress)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		throw PACK_EXCEPT("Cannot read " + path);
+	}
+	const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	std::vector<std::byte> data(bytes.size());
+	if (!bytes.empty())
+	{
+		std::memcpy(data.data(), bytes.data(), bytes.size());
+	}
+	Add(std::move(name), std::move(data), compress);
+}
+
+size_t PackWriter::GetEntryCount() const noexcept
+{
+	return pending.size();
+}
+
+std::vector<std::byte> PackWriter::Build(Stats* pStats) const
+{
+	O_PROFILE_FUNCTION();
+	// the table is sorted by name hash so lookups can binary search
+	std::vector<size_t> order(pending.size());
+	std::iota(order.begin(), order.end(), size_t(0));
+	std::vector<uint64_t> hashes(pending.size());
+	for (size_t i = 0; i < pending.size(); i++)
+	{
+		hashes[i] = Pack::HashName(pending[i].name);
+	}
+	std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+	{
+		return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : pending[a].name < pending[b].name;
+	});
+
+	std::vector<Pack::TocEntry> toc(pending.size());
+	std::string names;
+	std::vector<std::vector<std::byte>> compressed(pending.size());
+	Stats stats;
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		const Pending& entry = pending[order[i]];
+		Pack::TocEntry& t = toc[i];
+		t = {};
+		t.nameHash = hashes[order[i]];
+		t.nameOffset = uint32_t(names.size());
+		t.nameSize = uint32_t(entry.name.size());
+		names += entry.name;
+		t.size = entry.data.size();
+		t.storedSize = t.size;
+		t.compression = Pack::Compression::None;
+		ContentHash hash;
+		hash.Add(entry.data.data(), entry.data.size());
+		hash.Finish(t.hashHi, t.hashLo);
+		if (options.compress && entry.compress && !entry.data.empty())
+		{
+			std::vector<std::byte>& out = compressed[i];
+			out.resize(Lz4::CompressBound(entry.data.size()));
+			const size_t n = Lz4::Compress(entry.data.data(), entry.data.size(), out.data(), out.size());
+			if (n > 0u && double(n) < double(entry.data.size()) * double(options.maxRatio))
+			{
+				out.resize(n);
+				t.storedSize = n;
+				t.compression = Pack::Compression::Lz4;
+				stats.compressed++;
+			}
+			else
+			{
+				out.clear();
+				out.shrink_to_fit();
+			}
+		}
+		stats.bytes += t.size;
+		stats.storedBytes += t.storedSize;
+	}
+	stats.entries = pending.size();
+
+	Pack::Header header = {};
+	std::memcpy(header.magic, Pack::magic, sizeof(Pack::magic));
+	header.version = Pack::version;
+	header.entryCount = uint32_t(toc.size());
+	header.alignment = options.alignment;
+	header.namesOffset = sizeof(Pack::Header) + toc.size() * sizeof(Pack::TocEntry);
+	header.namesSize = names.size();
+	uint64_t offset = header.namesOffset + header.namesSize;
+	for (Pack::TocEntry& t : toc)
+	{
+		offset = AlignUp(offset, options.alignment);
+		t.offset = offset;
+		offset += t.storedSize;
+	}
+	header.fileSize = offset;
+	ContentHash hash;
+	hash.Add(toc.data(), toc.size() * sizeof(Pack::TocEntry));
+	hash.Add(names.data(), names.size());
+	uint64_t lo;
+	hash.Finish(header.tocHash, lo);
+	stats.fileSize = header.fileSize;
+
+	std::vector<std::byte> archive(size_t(header.fileSize));
+	std::memcpy(archive.data(), &header, sizeof(header));
+	if (!toc.empty())
+	{
+		std::memcpy(archive.data() + sizeof(header), toc.data(), toc.size() * sizeof(Pack::TocEntry));
+	}
+	if (!names.empty())
+	{
+		std::memcpy(archive.data() + header.namesOffset, names.data(), names.size());
+	}
+	for (size_t i = 0; i < toc.size(); i++)
+	{
+		const std::vector<std::byte>& data = toc[i].compression == Pack::Compression::None ? pending[order[i]].data : compressed[i];
+		if (!data.empty())
+		{
+			std::memcpy(archive.data() + toc[i].offset, data.data(), data.size());
+		}
+	}
+	if (pStats)
+	{
+		*pStats = stats;
+	}
+	return archive;
+}
+
+PackWriter::Stats PackWriter::Write(const std::string& path) const
+{
+	Stats stats;
+	const std::vector<std::byte> archive = Build(&stats);
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(archive.data()), std::streamsize(archive.size()));
+	if (!file)
+	{
+		throw PACK_EXCEPT("Cannot write archive " + path);
+	}
+	return stats;
+}
@@ -0,0 +1,289 @@
+#include "Bench/Bench.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+	struct Entry
+	{
+		std::string name;
+		Bench::Function function;
+	};
+
+	// function local so registration from other translation units is safe
+	// during static initialization
+	std::vector<Entry>& GetRegistry()
+	{
+		static std::vector<Entry> registry;
+		return registry;
+	}
+
+	double RunOnce(Bench::Function function, uint64_t iterations, uint64_t& items)
+	{
+		Bench::State state(iterations);
+		function(state);
+		state.PauseTiming();
+		items = state.GetItemsPerIteration();
+		return state.GetElapsedSeconds();
+	}
+
+	void WriteEscaped(std::ostream& out, const std::string& text)
+	{
+		out << '"';
+		for (const char c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				out << '\\';
+			}
+			out << c;
+		}
+		out << '"';
+	}
+}
+
+namespace Bench
+{
+	State::State(uint64_t iterations) noexcept
+		:
+		iterations(iterations),
+		start(Clock::now())
+	{
+	}
+
+	uint64_t State::GetIterations() const noexcept
+	{
+		return iterations;
+	}
+
+	void State::ResetTimer() noexcept
+	{
+		elapsed = Clock::duration::zero();
+		start = Clock::now();
+	}
+
+	void State::PauseTiming() noexcept
+	{
+		if (running)
+		{
+			elapsed += Clock::now() - start;
+			running = false;
+		}
+	}
+
+	void State::ResumeTiming() noexcept
+	{
+		if (!running)
+		{
+			start = Clock::now();
+			running = true;
+		}
+	}
+
+	void State::SetItemsPerIteration(uint64_t items) noexcept
+	{
+		itemsPerIteration = std::max<uint64_t>(items, 1u);
+	}
+
+	uint64_t State::GetItemsPerIteration() const noexcept
+	{
+		return itemsPerIteration;
+	}
+
+	double State::GetElapsedSeconds() const noexcept
+	{
+		const Clock::duration total = running ? elapsed + (Clock::now() - start) : elapsed;
+		return std::chrono::duration<double>(total).count();
+	}
+
+	bool Register(const char* name, Function function)
+	{
+		GetRegistry().push_back({ name, function });
+		return true;
+	}
+
+	std::vector<std::string> GetNames()
+	{
+		std::vector<std::string> names;
+		for (const Entry& e : GetRegistry())
+		{
+			names.push_back(e.name);
+		}
+		std::sort(names.begin(), names.end());
+		return names;
+	}
+
+	std::vector<Result> Run(const Options& options)
+	{
+		std::vector<Entry> entries = GetRegistry();
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+
+		std::vector<Result> results;
+		for (const Entry& e : entries)
+		{
+			if (!options.filter.empty() && e.name.find(options.filter) == std::string::npos)
+			{
+				continue;
+			}
+			// grow the iteration count until one run fills the minimum time,
+			// the first runs double as warm up
+			uint64_t iterations = 1u;
+			uint64_t items = 1u;
+			while (true)
+			{
+				const double seconds = RunOnce(e.function, iterations, items);
+				if (seconds >= options.minSeconds || iterations >= (uint64_t(1) << 40))
+				{
+					break;
+				}
+				// aim 20% past the target so the next run usually lands
+				const double scale = seconds > 0.0 ? options.minSeconds * 1.2 / seconds : 10.0;
+				iterations = std::max(iterations + 1u, uint64_t(double(iterations) * std::min(scale, 10.0)));
+			}
+
+			const unsigned int repetitions = std::max(options.repetitions, 1u);
+			std::vector<double> samples;
+			samples.reserve(repetitions);
+			for (unsigned int i = 0; i < repetitions; i++)
+			{
+				const double seconds = RunOnce(e.function, iterations, items);
+				samples.push_back(seconds * 1e9 / (double(iterations) * double(items)));
+			}
+			std::sort(samples.begin(), samples.end());
+
+			Result r;
+			r.name = e.name;
+			r.iterations = iterations;
+			r.repetitions = repetitions;
+			r.nsPerOp = samples[samples.size() / 2u];
+			r.minNsPerOp = samples.front();
+			r.maxNsPerOp = samples.back();
+			results.push_back(r);
+		}
+		return results;
+	}
+
+	void WriteJson(std::ostream& out, const std::vector<Result>& results)
+	{
+		out << "{\n  \"benchmarks\": [";
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const Result& r = results[i];
+			out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+			WriteEscaped(out, r.name);
+			out << std::setprecision(6) << std::fixed
+				<< ", \"iterations\": " << r.iterations
+				<< ", \"repetitions\": " << r.repetitions
+				<< ", \"ns_per_op\": " << r.nsPerOp
+				<< ", \"min_ns_per_op\": " << r.minNsPerOp
+				<< ", \"max_ns_per_op\": " << r.maxNsPerOp << "}";
+		}
+		out << "\n  ]\n}\n";
+	}
+
+	std::vector<Result> ReadJson(const std::string& path)
+	{
+		std::ifstream file(path);
+		if (!file)
+		{
+			throw std::runtime_error("Cannot open baseline " + path);
+		}
+		std::stringstream ss;
+		ss << file.rdbuf();
+		const std::string text = ss.str();
+
+		// one object per benchmark, keys in any order
+		const auto readNumber = [&text](size_t begin, size_t end, const char* key, double& value)
+		{
+			const std::string pattern = std::string("\"") + key + "\":";
+			const size_t at = text.find(pattern, begin);
+			if (at == std::string::npos || at >= end)
+			{
+				return false;
+			}
+			value = std::strtod(text.c_str() + at + pattern.size(), nullptr);
+			return true;
+		};
+
+		std::vector<Result> results;
+		size_t pos = text.find("\"benchmarks\"");
+		if (pos == std::string::npos)
+		{
+			throw std::runtime_error("No benchmarks in " + path);
+		}
+		while ((pos = text.find('{', pos)) != std::string::npos)
+		{
+			const size_t end = text.find('}', pos);
+			if (end == std::string::npos)
+			{
+				throw std::runtime_error("Truncated benchmark entry in " + path);
+			}
+			Result r;
+			const size_t nameKey = text.find("\"name\":", pos);
+			if (nameKey == std::string::npos || nameKey >= end)
+			{
+				throw std::runtime_error("Benchmark entry without a name in " + path);
+			}
+			size_t i = text.find('"', nameKey + 7u) + 1u;
+			for (; i < end && text[i] != '"'; i++)
+			{
+				if (text[i] == '\\' && i + 1u < end)
+				{
+					i++;
+				}
+				r.name += text[i];
+			}
+			double value = 0.0;
+			if (!readNumber(pos, end, "ns_per_op", value))
+			{
+				throw std::runtime_error("Benchmark " + r.name + " has no ns_per_op in " + path);
+			}
+			r.nsPerOp = value;
+			r.minNsPerOp = readNumber(pos, end, "min_ns_per_op", value) ? value : r.nsPerOp;
+			r.maxNsPerOp = readNumber(pos, end, "max_ns_per_op", value) ? value : r.nsPerOp;
+			if (readNumber(pos, end, "iterations", value))
+			{
+				r.iterations = uint64_t(value);
+			}
+			if (readNumber(pos, end, "repetitions", value))
+			{
+				r.repetitions = unsigned(value);
+			}
+			results.push_back(r);
+			pos = end + 1u;
+		}
+		return results;
+	}
+
+	std::vector<Comparison> Compare(const std::vector<Result>& baseline, const std::vector<Result>& current, double thresholdPercent)
+	{
+		std::map<std::string, double> base;
+		for (const Result& r : baseline)
+		{
+			base[r.name] = r.nsPerOp;
+		}
+		std::vector<Comparison> comparisons;
+		for (const Result& r : current)
+		{
+			const auto it = base.find(r.name);
+			if (it == base.end() || it->second <= 0.0)
+			{
+				continue;
+			}
+			Comparison c;
+			c.name = r.name;
+			c.baselineNs = it->second;
+			c.currentNs = r.nsPerOp;
+			c.deltaPercent = (c.currentNs - c.baselineNs) / c.baselineNs * 100.0;
+			c.regressed = c.deltaPercent > thresholdPercent;
+			comparisons.push_back(c);
+		}
+		return comparisons;
+	}
+}
@@ -0,0 +1,119 @@
+// Entry point of the Benchmark project. Runs every registered benchmark (or
+// those matching --filter), prints a table, writes JSON to --out (stdout by
+// default) and with --baseline fails when a benchmark got slower than
+// --threshold percent.
+#include "Bench/Bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		Bench::Options options;
+		const char* outPath = nullptr;
+		const char* baselinePath = nullptr;
+		double threshold = 10.0;
+		for (int i = 1; i < argc; i++)
+		{
+			const bool hasValue = i + 1 < argc;
+			if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+			{
+				options.filter = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+			{
+				options.minSeconds = std::strtod(argv[++i], nullptr);
+			}
+			else if (std::strcmp(argv[i], "--repetitions") == 0 && hasValue)
+			{
+				options.repetitions = unsigned(std::strtoul(argv[++i], nullptr, 10));
+			}
+			else if (std::strcmp(argv[i], "--out") == 0 && hasValue)
+			{
+				outPath = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue)
+			{
+				baselinePath = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--threshold") == 0 && hasValue)
+			{
+				threshold = std::strtod(argv[++i], nullptr);
+			}
+			else if (std::strcmp(argv[i], "--list") == 0)
+			{
+				for (const std::string& name : Bench::GetNames())
+				{
+					std::printf("%s\n", name.c_str());
+				}
+				return 0;
+			}
+			else
+			{
+				std::fprintf(stderr,
+					"usage: %s [--filter text] [--min-time seconds] [--repetitions n] [--out file]\n"
+					"          [--baseline file] [--threshold percent] [--list]\n", argv[0]);
+				return 2;
+			}
+		}
+
+		// read the baseline first so a bad path fails before the long run
+		std::vector<Bench::Result> baseline;
+		if (baselinePath)
+		{
+			baseline = Bench::ReadJson(baselinePath);
+		}
+
+		const std::vector<Bench::Result> results = Bench::Run(options);
+		for (const Bench::Result& r : results)
+		{
+			std::fprintf(stderr, "%-40s %14.2f ns %14.2f min %14.2f max %12llu iterations\n",
+				r.name.c_str(), r.nsPerOp, r.minNsPerOp, r.maxNsPerOp, static_cast<unsigned long long>(r.iterations));
+		}
+
+		if (outPath)
+		{
+			std::ofstream out(outPath);
+			if (!out)
+			{
+				std::fprintf(stderr, "Cannot write %s\n", outPath);
+				return 2;
+			}
+			Bench::WriteJson(out, results);
+		}
+		else
+		{
+			Bench::WriteJson(std::cout, results);
+		}
+
+		if (!baselinePath)
+		{
+			return 0;
+		}
+		int regressions = 0;
+		std::fprintf(stderr, "\ncompared to %s, threshold %.1f%%\n", baselinePath, threshold);
+		for (const Bench::Comparison& c : Bench::Compare(baseline, results, threshold))
+		{
+			std::fprintf(stderr, "%-40s %14.2f -> %14.2f ns %+8.1f%%%s\n",
+				c.name.c_str(), c.baselineNs, c.currentNs, c.deltaPercent, c.regressed ? "  REGRESSION" : "");
+			regressions += c.regressed ? 1 : 0;
+		}
+		if (regressions > 0)
+		{
+			std::fprintf(stderr, "%d benchmark(s) regressed\n", regressions);
+			return 1;
+		}
+		return 0;
+	}
+	catch (const std::exception& e)
+	{
+		std::fprintf(stderr, "%s\n", e.what());
+	}
+	return -1;
+}
@@ -0,0 +1,153 @@
+#include "Bench/Bench.h"
+#include "Render/Cull/DynamicBvh.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Culling a synthetic city of 100k boxes and spheres spread over a
+// 2km square while the camera turns in place. Time is per object.
+namespace
+{
+	using namespace OMath;
+
+	constexpr size_t count = 100000u;
+	constexpr float halfSize = 1000.0f;
+
+	struct Scene
+	{
+		Scene()
+		{
+			std::mt19937 rng(11u);
+			std::uniform_real_distribution<float> position(-halfSize, halfSize);
+			std::uniform_real_distribution<float> height(0.0f, 50.0f);
+			std::uniform_real_distribution<float> size(0.5f, 4.0f);
+			for (size_t i = 0; i < count; i++)
+			{
+				const XMFLOAT3 center = { position(rng), height(rng), position(rng) };
+				const float s = size(rng);
+				if (i % 2u == 0u)
+				{
+					proxies.push_back(bvh.Insert(Aabb::FromCenterExtents(center, { s, s * 2.0f, s }), uint32_t(i)));
+				}
+				else
+				{
+					proxies.push_back(bvh.Insert(Sphere{ center, s }, uint32_t(i)));
+				}
+			}
+			visible.reserve(count);
+		}
+		DynamicBvh bvh;
+		std::vector<DynamicBvh::ProxyId> proxies;
+		std::vector<uint32_t> visible;
+	};
+
+	Scene& GetScene()
+	{
+		static Scene scene;
+		return scene;
+	}
+
+	Frustum CameraAt(uint64_t frame) noexcept
+	{
+		const float yaw = float(frame % 360u) * (XM_2PI / 360.0f);
+		const XMMATRIX view = XMMatrixLookToLH(
+			XMVectorSet(0.0f, 20.0f, 0.0f, 1.0f), XMVectorSet(std::sin(yaw), -0.1f, std::cos(yaw), 0.0f),
+			XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+		return Frustum(view * XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.5f, 600.0f));
+	}
+
+	void CullStatic(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			state.PauseTiming();
+			const Frustum frustum = CameraAt(i);
+			state.ResumeTiming();
+			s.bvh.Cull(frustum, s.visible);
+			Bench::DoNotOptimize(s.visible.data());
+		}
+	}
+
+	// same scene tested object by object, what the tree has to beat
+	void CullBruteForce(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		std::vector<Aabb> boxes;
+		boxes.reserve(count);
+		for (DynamicBvh::ProxyId proxy : s.proxies)
+		{
+			boxes.push_back(s.bvh.GetFatBox(proxy));
+		}
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			state.PauseTiming();
+			const Frustum frustum = CameraAt(i);
+			state.ResumeTiming();
+			s.visible.clear();
+			for (uint32_t j = 0; j < uint32_t(count); j++)
+			{
+				if (frustum.IsVisible(boxes[j]))
+				{
+					s.visible.push_back(j);
+				}
+			}
+			Bench::DoNotOptimize(s.visible.data());
+		}
+	}
+
+	// a tenth of the objects drift every frame before the cull, so the
+	// time includes the refits
+	void CullMoving(Bench::State& state)
+	{
+		DynamicBvh bvh;
+		std::vector<DynamicBvh::ProxyId> proxies;
+		std::vector<XMFLOAT3> centers;
+		std::vector<uint32_t> visible;
+		std::mt19937 rng(13u);
+		std::uniform_real_distribution<float> position(-halfSize, halfSize);
+		std::uniform_real_distribution<float> step(-0.3f, 0.3f);
+		for (size_t i = 0; i < count; i++)
+		{
+			centers.push_back({ position(rng), 10.0f, position(rng) });
+			proxies.push_back(bvh.Insert(Aabb::FromCenterExtents(centers.back(), { 1.0f, 1.0f, 1.0f }), uint32_t(i)));
+		}
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			for (size_t j = i % 10u; j < count; j += 10u)
+			{
+				centers[j].x += step(rng);
+				centers[j].z += step(rng);
+				bvh.Move(proxies[j], Aabb::FromCenterExtents(centers[j], { 1.0f, 1.0f, 1.0f }));
+			}
+			state.PauseTiming();
+			const Frustum frustum = CameraAt(i);
+			state.ResumeTiming();
+			bvh.Cull(frustum, visible);
+			Bench::DoNotOptimize(visible.data());
+		}
+	}
+
+	void Rebuild(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			s.bvh.Rebuild();
+			Bench::DoNotOptimize(s.bvh.GetHeight());
+		}
+	}
+}
+
+O_BENCHMARK("cull/bvh_static_100k", CullStatic);
+O_BENCHMARK("cull/brute_force_100k", CullBruteForce);
+O_BENCHMARK("cull/bvh_moving_100k", CullMoving);
+O_BENCHMARK("cull/bvh_rebuild_100k", Rebuild);
@@ -0,0 +1,207 @@
+#include "Bench/Bench.h"
+#include "Ecs/EntityCommandBuffer.h"
+#include "Ecs/World.h"
+#include "Job/JobSystem.h"
+#include <vector>
+
+// One million entities, half of them with a Health component so queries
+// span two archetypes. Time is per entity.
+namespace
+{
+	using namespace Ecs;
+
+	constexpr size_t count = 1000000u;
+
+	struct Position
+	{
+		float x, y, z;
+	};
+
+	struct Velocity
+	{
+		float x, y, z;
+	};
+
+	struct Health
+	{
+		float value;
+	};
+
+	struct Frozen
+	{
+		uint8_t unused;
+	};
+
+	struct Scene
+	{
+		Scene()
+		{
+			entities.reserve(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				const float f = float(i);
+				if (i % 2u == 0u)
+				{
+					entities.push_back(world.Create(Position{ f, 0.0f, 0.0f }, Velocity{ 1.0f, 0.5f, 0.25f }));
+				}
+				else
+				{
+					entities.push_back(world.Create(Position{ f, 0.0f, 0.0f }, Velocity{ 1.0f, 0.5f, 0.25f }, Health{ 100.0f }));
+				}
+			}
+		}
+		// one thread per core for the parallel queries
+		JobSystem jobs;
+		World world{ &jobs };
+		std::vector<Entity> entities;
+	};
+
+	Scene& GetScene()
+	{
+		static Scene scene;
+		return scene;
+	}
+
+	void Integrate(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		Query<Position, const Velocity> query(s.world);
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			query.ForEach([](Position& p, const Velocity& v)
+			{
+				p.x += v.x * 0.016f;
+				p.y += v.y * 0.016f;
+				p.z += v.z * 0.016f;
+			});
+		}
+		Bench::DoNotOptimize(s.world.Get<Position>(s.entities[0]).x);
+	}
+
+	// same work on whole arrays, what a system written against chunks gets
+	void IntegrateChunks(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		Query<Position, const Velocity> query(s.world);
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			query.ForEachChunk([](const ChunkView& chunk)
+			{
+				Position* p = chunk.Get<Position>();
+				const Velocity* v = chunk.Get<const Velocity>();
+				const uint32_t n = chunk.GetCount();
+				for (uint32_t j = 0; j < n; j++)
+				{
+					p[j].x += v[j].x * 0.016f;
+					p[j].y += v[j].y * 0.016f;
+					p[j].z += v[j].z * 0.016f;
+				}
+			});
+		}
+		Bench::DoNotOptimize(s.world.Get<Position>(s.entities[0]).x);
+	}
+
+	void IntegrateParallel(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		Query<Position, const Velocity> query(s.world);
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			query.ForEachParallel([](Position& p, const Velocity& v)
+			{
+				p.x += v.x * 0.016f;
+				p.y += v.y * 0.016f;
+				p.z += v.z * 0.016f;
+			});
+		}
+		Bench::DoNotOptimize(s.world.Get<Position>(s.entities[0]).x);
+	}
+
+	// reads one archetype of the two
+	void DamageWithHealth(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		Query<Health, const Position> query(s.world);
+		state.SetItemsPerIteration(count / 2u);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			query.ForEach([](Health& h, const Position& p)
+			{
+				h.value -= p.x > 0.0f ? 0.001f : 0.0f;
+			});
+		}
+		Bench::DoNotOptimize(s.world.Get<Health>(s.entities[1]).value);
+	}
+
+	void Create(Bench::State& state)
+	{
+		state.SetItemsPerIteration(count);
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			state.PauseTiming();
+			{
+				World world;
+				state.ResumeTiming();
+				for (size_t j = 0; j < count; j++)
+				{
+					world.Create(Position{ 0.0f, 0.0f, 0.0f }, Velocity{ 1.0f, 0.0f, 0.0f });
+				}
+				state.PauseTiming();
+			}
+			state.ResumeTiming();
+		}
+	}
+
+	// tag and untag every entity through command buffers recorded in a
+	// parallel query, two archetype moves per entity
+	void AddRemoveDeferred(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		std::vector<EntityCommandBuffer> buffers(s.world.GetWorkerCount());
+		Query<const Position> all(s.world);
+		Query<const Frozen> frozen(s.world);
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			all.ForEachChunkParallel([&buffers](const ChunkView& chunk, unsigned int worker)
+			{
+				const Entity* entities = chunk.GetEntities();
+				for (uint32_t j = 0; j < chunk.GetCount(); j++)
+				{
+					buffers[worker].Add<Frozen>(entities[j]);
+				}
+			});
+			for (EntityCommandBuffer& buffer : buffers)
+			{
+				buffer.Playback(s.world);
+			}
+			frozen.ForEachChunkParallel([&buffers](const ChunkView& chunk, unsigned int worker)
+			{
+				const Entity* entities = chunk.GetEntities();
+				for (uint32_t j = 0; j < chunk.GetCount(); j++)
+				{
+					buffers[worker].Remove<Frozen>(entities[j]);
+				}
+			});
+			for (EntityCommandBuffer& buffer : buffers)
+			{
+				buffer.Playback(s.world);
+			}
+		}
+	}
+}
+
+O_BENCHMARK("ecs/integrate_1m", Integrate);
+O_BENCHMARK("ecs/integrate_chunks_1m", IntegrateChunks);
+O_BENCHMARK("ecs/integrate_parallel_1m", IntegrateParallel);
+O_BENCHMARK("ecs/damage_half_of_1m", DamageWithHealth);
+O_BENCHMARK("ecs/create_1m", Create);
+O_BENCHMARK("ecs/add_remove_deferred_1m", AddRemoveDeferred);
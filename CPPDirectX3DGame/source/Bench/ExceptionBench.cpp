@@ -0,0 +1,52 @@
+#include "Bench/Bench.h"
+#include "Input/InputReplay.h"
+#ifdef _WIN32
+#include "Render/Graphics.h"
+#endif
+
+// what() formats into a string stream on every call, these keep an eye on
+// what reporting an error costs
+namespace
+{
+	void ReplayExceptionWhat(Bench::State& state)
+	{
+		const InputReplay::Exception e(__LINE__, __FILE__, "Bad magic in recording header");
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Bench::DoNotOptimize(e.what());
+		}
+	}
+
+	void ReplayExceptionThrowCatch(Bench::State& state)
+	{
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			try
+			{
+				throw InputReplay::Exception(__LINE__, __FILE__, "Bad magic in recording header");
+			}
+			catch (const OException& e)
+			{
+				Bench::DoNotOptimize(e.what());
+			}
+		}
+	}
+
+#ifdef _WIN32
+	// adds the error string, description and info message formatting
+	void GraphicsHrExceptionWhat(Bench::State& state)
+	{
+		const Graphics::HrException e(__LINE__, __FILE__, DXGI_ERROR_DEVICE_REMOVED, { "info message one", "info message two" });
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Bench::DoNotOptimize(e.what());
+		}
+	}
+#endif
+}
+
+O_BENCHMARK("exception/replay_what", ReplayExceptionWhat);
+O_BENCHMARK("exception/replay_throw_catch", ReplayExceptionThrowCatch);
+#ifdef _WIN32
+O_BENCHMARK("exception/graphics_hr_what", GraphicsHrExceptionWhat);
+#endif
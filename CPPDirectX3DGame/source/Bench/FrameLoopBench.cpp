@@ -0,0 +1,111 @@
+#include "Bench/Bench.h"
+#include "Core/App.h"
+#include "Job/JobSystem.h"
+#include "Platform/HeadlessPlatform.h"
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Whole frames through App on HeadlessPlatform, messages to present on the
+// software rasterizer. One iteration is one frame. The raster ones draw a
+// fixed scene of 20k triangles straight into the rasterizer, time is per
+// triangle; they fail the run when a frame loses triangles.
+namespace
+{
+	struct Scene
+	{
+		static constexpr unsigned int width = 1920u;
+		static constexpr unsigned int height = 1080u;
+		static constexpr size_t triangles = 20000u;
+		Scene()
+		{
+			std::mt19937 rng(31u);
+			std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+			// mostly small triangles, every thousandth one large enough for
+			// the scalar path
+			std::uniform_real_distribution<float> small(0.005f, 0.04f);
+			std::uniform_real_distribution<float> large(0.6f, 1.0f);
+			for (size_t i = 0; i < triangles; i++)
+			{
+				const float x = position(rng);
+				const float y = position(rng);
+				const float size = i % 1000u == 0u ? large(rng) : small(rng);
+				for (int v = 0; v < 3; v++)
+				{
+					RenderBackend::Vertex vertex;
+					vertex.pos.x = x + (v == 1 ? size : 0.0f);
+					vertex.pos.y = y + (v == 2 ? size : 0.0f);
+					vertex.color = { (unsigned char)rng(), (unsigned char)rng(), (unsigned char)rng(), 255 };
+					vertices.push_back(vertex);
+				}
+			}
+			// 16-bit indices, so each draw takes up to 21845 triangles
+			indices.resize(vertices.size());
+			std::iota(indices.begin(), indices.end(), (unsigned short)0u);
+		}
+		std::vector<RenderBackend::Vertex> vertices;
+		std::vector<unsigned short> indices;
+	};
+
+	void RunRaster(Bench::State& state, JobSystem* pJobs)
+	{
+		static const Scene scene;
+		SoftwareRasterizer rasterizer(Scene::width, Scene::height, pJobs);
+		state.SetItemsPerIteration(Scene::triangles);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			rasterizer.ClearBuffer(0.0f, 0.0f, 0.0f);
+			rasterizer.DrawIndexed(scene.vertices.data(), scene.vertices.size(), scene.indices.data(), scene.indices.size());
+			rasterizer.EndFrame();
+		}
+		state.PauseTiming();
+		if (rasterizer.GetStats().triangles != Scene::triangles)
+		{
+			throw std::runtime_error("frame: rasterizer saw " + std::to_string(rasterizer.GetStats().triangles) + " triangles, expected " + std::to_string(Scene::triangles));
+		}
+		Bench::DoNotOptimize(rasterizer.GetFrontBuffer()[0]);
+	}
+
+	void RasterSerial(Bench::State& state)
+	{
+		RunRaster(state, nullptr);
+	}
+
+	void RasterThreaded(Bench::State& state)
+	{
+		JobSystem jobs;
+		RunRaster(state, &jobs);
+	}
+
+	void RunFrames(Bench::State& state, int width, int height, App::LoopMode mode)
+	{
+		App app{ std::make_unique<HeadlessPlatform>(width, height), mode };
+		app.SetFrameLimit(state.GetIterations());
+		state.ResetTimer();
+		Bench::DoNotOptimize(app.Start());
+	}
+
+	void FrameSerial(Bench::State& state)
+	{
+		RunFrames(state, 800, 300, App::LoopMode::Serial);
+	}
+
+	void FramePipelined(Bench::State& state)
+	{
+		RunFrames(state, 800, 300, App::LoopMode::Pipelined);
+	}
+
+	void FrameSerialHD(Bench::State& state)
+	{
+		RunFrames(state, 1920, 1080, App::LoopMode::Serial);
+	}
+}
+
+O_BENCHMARK("frame/headless_serial_800x300", FrameSerial);
+O_BENCHMARK("frame/headless_pipelined_800x300", FramePipelined);
+O_BENCHMARK("frame/headless_serial_1920x1080", FrameSerialHD);
+O_BENCHMARK("frame/raster_20k_triangles_serial_1920x1080", RasterSerial);
+O_BENCHMARK("frame/raster_20k_triangles_threaded_1920x1080", RasterThreaded);
@@ -0,0 +1,84 @@
+#include "Bench/Bench.h"
+#include "Input/Keyboard.h"
+#include "Input/Mouse.h"
+
+// Drives the devices the way the window procedure does, through the private
+// On* handlers, and drains them the way App does.
+class InputBench
+{
+public:
+	static void KeyboardPushPop(Bench::State& state)
+	{
+		Keyboard kbd;
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			kbd.OnKeyPressed(static_cast<unsigned char>(i));
+			Bench::DoNotOptimize(kbd.ReadKey());
+		}
+	}
+	// a frame's worth of typing: fill half the ring, then drain it
+	static void KeyboardBurst(Bench::State& state)
+	{
+		constexpr unsigned int burst = Keyboard::defaultCapacity / 2u;
+		Keyboard kbd;
+		state.SetItemsPerIteration(burst);
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			for (unsigned int k = 0; k < burst; k++)
+			{
+				kbd.OnKeyPressed(static_cast<unsigned char>(k));
+			}
+			while (const auto e = kbd.ReadKey())
+			{
+				Bench::DoNotOptimize(*e);
+			}
+		}
+	}
+	static void MouseButtonPushPop(Bench::State& state)
+	{
+		Mouse mouse;
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			mouse.OnLeftPressed(int(i & 1023u), 10);
+			Bench::DoNotOptimize(mouse.Read());
+		}
+	}
+	// moves between reads are coalesced into one event
+	static void MouseMoveCoalesced(Bench::State& state)
+	{
+		constexpr unsigned int moves = 16u;
+		Mouse mouse;
+		state.SetItemsPerIteration(moves);
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			for (unsigned int m = 0; m < moves; m++)
+			{
+				mouse.OnMouseMove(int(m), int(i & 1023u));
+			}
+			while (const auto e = mouse.Read())
+			{
+				Bench::DoNotOptimize(*e);
+			}
+		}
+	}
+	static void MouseRawDelta(Bench::State& state)
+	{
+		constexpr unsigned int reports = 16u;
+		Mouse mouse;
+		state.SetItemsPerIteration(reports);
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			for (unsigned int r = 0; r < reports; r++)
+			{
+				mouse.OnRawDelta(1, -1);
+			}
+			Bench::DoNotOptimize(mouse.ReadRawFrameDelta());
+		}
+	}
+};
+
+O_BENCHMARK("input/keyboard_push_pop", InputBench::KeyboardPushPop);
+O_BENCHMARK("input/keyboard_burst", InputBench::KeyboardBurst);
+O_BENCHMARK("input/mouse_button_push_pop", InputBench::MouseButtonPushPop);
+O_BENCHMARK("input/mouse_move_coalesced", InputBench::MouseMoveCoalesced);
+O_BENCHMARK("input/mouse_raw_delta", InputBench::MouseRawDelta);
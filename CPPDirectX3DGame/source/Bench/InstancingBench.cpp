@@ -0,0 +1,127 @@
+#include "Bench/Bench.h"
+#include "Render/Command/InstanceBatcher.h"
+#include "Render/Command/RecordingContext.h"
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 100k objects using 16 meshes and 8 materials, replayed onto a counting
+// RecordingContext so only the CPU side is measured: one draw per object
+// against the batcher's one draw per mesh and material. Time is per object.
+// Both fail the run when the context saw other draw counts than that.
+namespace
+{
+	using namespace OMath;
+
+	constexpr size_t count = 100000u;
+	constexpr unsigned int meshes = 16u;
+	constexpr unsigned int materials = 8u;
+
+	constexpr auto Fake = &RecordingContext::Fake;
+
+	void Expect(size_t actual, size_t expected, const char* what)
+	{
+		if (actual != expected)
+		{
+			throw std::runtime_error(std::string("instancing: ") + what + " " + std::to_string(actual) + ", expected " + std::to_string(expected));
+		}
+	}
+
+	struct Scene
+	{
+		Scene()
+		{
+			std::mt19937 rng(17u);
+			std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+			std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+			packets.reserve(count);
+			instances.reserve(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				const unsigned int mesh = unsigned(rng() % meshes);
+				const unsigned int material = unsigned(rng() % materials);
+				DrawPacket packet;
+				packet.key = SortKey::Make(0u, material % 2u, material, depth(rng));
+				packet.Set(RenderContext::Slot::VertexShader, Fake(100u + material % 2u));
+				packet.Set(RenderContext::Slot::PixelShader, Fake(200u + material % 2u));
+				packet.Set(RenderContext::Slot::PixelConstants, Fake(300u + material));
+				packet.Set(RenderContext::Slot::VertexBuffer, Fake(400u + mesh));
+				packet.Set(RenderContext::Slot::IndexBuffer, Fake(500u + mesh));
+				packet.indexCount = 36u + mesh * 3u;
+				packets.push_back(packet);
+				InstanceData instance;
+				XMStoreFloat4x4(&instance.transform, XMMatrixTranslation(position(rng), 0.0f, position(rng)));
+				instance.color = { 1.0f, 0.5f, 0.25f, 1.0f };
+				instances.push_back(instance);
+			}
+		}
+		std::vector<DrawPacket> packets;
+		std::vector<InstanceData> instances;
+	};
+
+	Scene& GetScene()
+	{
+		static Scene scene;
+		return scene;
+	}
+
+	void OneDrawPerObject(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		CommandBuffer commands(count);
+		RecordingContext context(false);
+		StateCache cache;
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			commands.Reset();
+			cache.Invalidate();
+			for (const DrawPacket& packet : s.packets)
+			{
+				commands.Submit(packet);
+			}
+			commands.Sort();
+			commands.Execute(context, cache);
+		}
+		const size_t frames = size_t(state.GetIterations());
+		Expect(context.GetDrawCalls(), frames * count, "draws");
+		Expect(context.GetInstancedDrawCalls(), 0u, "instanced draws");
+	}
+
+	void Batched(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		InstanceBatcher batcher;
+		CommandBuffer commands(count);
+		RecordingContext context(false);
+		StateCache cache;
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			batcher.Reset();
+			commands.Reset();
+			cache.Invalidate();
+			for (size_t j = 0; j < count; j++)
+			{
+				batcher.Submit(s.packets[j], s.instances[j]);
+			}
+			batcher.Build(commands, Fake(600u));
+			commands.Sort();
+			commands.Execute(context, cache);
+		}
+		// every mesh and material pair occurs among 100k random objects
+		const size_t frames = size_t(state.GetIterations());
+		Expect(batcher.GetStats().batches, meshes * materials, "batches");
+		Expect(context.GetInstancedDrawCalls(), frames * meshes * materials, "instanced draws");
+		Expect(context.GetDrawCalls(), frames * meshes * materials, "draws");
+		Expect(context.GetDrawnObjects(), frames * count, "objects drawn");
+		Bench::DoNotOptimize(batcher.GetInstances().data());
+	}
+}
+
+O_BENCHMARK("instancing/one_draw_per_object_100k", OneDrawPerObject);
+O_BENCHMARK("instancing/batched_100k", Batched);
@@ -0,0 +1,160 @@
+#include "Bench/Bench.h"
+#include "Job/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Scaling of the job system from one thread up to every hardware thread,
+// doubling in between: a parallel for over a million elements of a few
+// dozen ns each, timed per element; 64 dependency chains of 16 jobs of
+// about a microsecond, per job; and empty child jobs under one parent,
+// per job, which is the scheduling overhead alone. Only the counts up to
+// the hardware concurrency are registered.
+namespace
+{
+	constexpr size_t elements = 1u << 20;
+	constexpr size_t chains = 64u;
+	constexpr size_t links = 16u;
+	constexpr size_t emptyJobs = 2048u;
+
+	const std::vector<unsigned int>& GetThreadCounts()
+	{
+		static const std::vector<unsigned int> counts = []
+		{
+			const unsigned int hardware = std::max(std::thread::hardware_concurrency(), 1u);
+			std::vector<unsigned int> counts;
+			for (unsigned int n = 1u; n < hardware; n *= 2u)
+			{
+				counts.push_back(n);
+			}
+			counts.push_back(hardware);
+			return counts;
+		}();
+		return counts;
+	}
+
+	float Work(float x) noexcept
+	{
+		for (int k = 0; k < 8; k++)
+		{
+			x = x * 0.5f + std::sqrt(x + 1.0f);
+		}
+		return x;
+	}
+
+	template<size_t slot>
+	void ParallelFor(Bench::State& state)
+	{
+		JobSystem jobs(GetThreadCounts()[slot]);
+		std::vector<float> in(elements);
+		std::vector<float> out(elements);
+		for (size_t i = 0; i < elements; i++)
+		{
+			in[i] = float(i % 1024u);
+		}
+		state.SetItemsPerIteration(elements);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			jobs.ParallelFor(elements, [&](size_t begin, size_t end)
+			{
+				for (size_t j = begin; j < end; j++)
+				{
+					out[j] = Work(in[j]);
+				}
+			});
+			Bench::DoNotOptimize(out[i % elements]);
+		}
+	}
+
+	template<size_t slot>
+	void Chains(Bench::State& state)
+	{
+		JobSystem jobs(GetThreadCounts()[slot]);
+		// padded so neighbouring jobs do not share a line
+		struct alignas(64) Link
+		{
+			float value;
+		};
+		std::vector<Link> values(chains * links);
+		state.SetItemsPerIteration(chains * links);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			JobSystem::Handle root = jobs.Create([](void*) {}, nullptr);
+			for (size_t c = 0; c < chains; c++)
+			{
+				JobSystem::Handle previous = nullptr;
+				std::vector<JobSystem::Handle> chain;
+				for (size_t l = 0; l < links; l++)
+				{
+					JobSystem::Handle job = jobs.Create([](void* p)
+					{
+						float& value = static_cast<Link*>(p)->value;
+						for (int k = 0; k < 32; k++)
+						{
+							value = Work(value);
+						}
+					}, &values[c * links + l], root);
+					if (previous)
+					{
+						jobs.AddDependency(job, previous);
+					}
+					chain.push_back(job);
+					previous = job;
+				}
+				for (JobSystem::Handle job : chain)
+				{
+					jobs.Run(job);
+				}
+			}
+			jobs.Run(root);
+			jobs.Wait(root);
+			Bench::DoNotOptimize(values[i % values.size()].value);
+		}
+	}
+
+	template<size_t slot>
+	void EmptyJobs(Bench::State& state)
+	{
+		JobSystem jobs(GetThreadCounts()[slot]);
+		state.SetItemsPerIteration(emptyJobs);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			JobSystem::Handle root = jobs.Create([](void*) {}, nullptr);
+			for (size_t j = 0; j < emptyJobs; j++)
+			{
+				jobs.Run(jobs.Create([](void*) {}, nullptr, root));
+			}
+			jobs.Run(root);
+			jobs.Wait(root);
+		}
+	}
+
+	template<size_t slot>
+	bool RegisterSlot()
+	{
+		if (slot >= GetThreadCounts().size())
+		{
+			return false;
+		}
+		const std::string suffix = "/" + std::to_string(GetThreadCounts()[slot]) + "t";
+		Bench::Register(("job/parallel_for" + suffix).c_str(), ParallelFor<slot>);
+		Bench::Register(("job/chains" + suffix).c_str(), Chains<slot>);
+		Bench::Register(("job/empty" + suffix).c_str(), EmptyJobs<slot>);
+		return true;
+	}
+
+	template<size_t... slots>
+	bool RegisterSlots(std::index_sequence<slots...>)
+	{
+		return (RegisterSlot<slots>() | ...);
+	}
+}
+
+// up to 2^9 threads
+O_BENCHMARK_REGISTER(RegisterSlots(std::make_index_sequence<10>()));
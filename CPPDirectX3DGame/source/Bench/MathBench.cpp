@@ -0,0 +1,176 @@
+#include "Bench/Bench.h"
+#include "Math/BatchTransform.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// Batch kernels over 4096 objects, once per instruction set this CPU runs.
+// Time is per object.
+namespace
+{
+	using namespace OMath;
+	using namespace OMath::Batch;
+
+	constexpr size_t count = 4096u;
+
+	struct Scene
+	{
+		Scene()
+		{
+			std::mt19937 rng(7u);
+			std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+			for (auto& v : values)
+			{
+				v.resize(count);
+				for (float& f : v)
+				{
+					f = dist(rng);
+				}
+			}
+			for (auto& v : outputs)
+			{
+				v.resize(count);
+			}
+		}
+		ConstFloat3Array Positions() const noexcept
+		{
+			return { values[0].data(), values[1].data(), values[2].data() };
+		}
+		ConstFloat3Array Extents() const noexcept
+		{
+			return { values[3].data(), values[4].data(), values[5].data() };
+		}
+		const float* Radii() const noexcept
+		{
+			return values[6].data();
+		}
+		ConstMatrixArray Matrices() const noexcept
+		{
+			ConstMatrixArray m;
+			for (int r = 0; r < 4; r++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					m.m[r][c] = values[r * 4 + c].data();
+				}
+			}
+			return m;
+		}
+		Float3Array Out3(int first) noexcept
+		{
+			return { outputs[first].data(), outputs[first + 1].data(), outputs[first + 2].data() };
+		}
+		Float4Array Out4() noexcept
+		{
+			return { outputs[0].data(), outputs[1].data(), outputs[2].data(), outputs[3].data() };
+		}
+		MatrixArray OutMatrices() noexcept
+		{
+			MatrixArray m;
+			for (int r = 0; r < 4; r++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					m.m[r][c] = outputs[r * 4 + c].data();
+				}
+			}
+			return m;
+		}
+		std::vector<float> values[16];
+		std::vector<float> outputs[16];
+	};
+
+	Scene& GetScene()
+	{
+		static Scene scene;
+		return scene;
+	}
+
+	XMMATRIX ViewProjection() noexcept
+	{
+		const XMMATRIX view = XMMatrixLookAtLH(
+			XMVectorSet(0.0f, 50.0f, -200.0f, 1.0f), XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+		return view * XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.5f, 1000.0f);
+	}
+
+	template<Isa isa>
+	void TransformPointsBench(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		const XMMATRIX m = ViewProjection();
+		SetIsa(isa);
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			TransformPoints(m, s.Positions(), s.Out4(), count);
+			Bench::DoNotOptimize(s.outputs[0][i % count]);
+		}
+	}
+
+	template<Isa isa>
+	void MultiplyMatricesBench(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		const XMMATRIX m = ViewProjection();
+		SetIsa(isa);
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			MultiplyMatrices(s.Matrices(), m, s.OutMatrices(), count);
+			Bench::DoNotOptimize(s.outputs[15][i % count]);
+		}
+	}
+
+	template<Isa isa>
+	void TransformSpheresBench(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		const XMMATRIX m = XMMatrixRotationRollPitchYaw(0.3f, 0.7f, 0.1f) * XMMatrixTranslation(4.0f, 5.0f, 6.0f);
+		SetIsa(isa);
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			TransformSpheres(m, s.Positions(), s.Radii(), s.Out3(0), s.outputs[3].data(), count);
+			Bench::DoNotOptimize(s.outputs[3][i % count]);
+		}
+	}
+
+	template<Isa isa>
+	void TransformAabbsBench(Bench::State& state)
+	{
+		Scene& s = GetScene();
+		const XMMATRIX m = XMMatrixRotationRollPitchYaw(0.3f, 0.7f, 0.1f) * XMMatrixTranslation(4.0f, 5.0f, 6.0f);
+		SetIsa(isa);
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			TransformAabbs(m, s.Positions(), s.Extents(), s.Out3(0), s.Out3(3), count);
+			Bench::DoNotOptimize(s.outputs[5][i % count]);
+		}
+	}
+
+	template<Isa isa>
+	bool RegisterIsa()
+	{
+		if (!IsSupported(isa))
+		{
+			return false;
+		}
+		const std::string suffix = std::string("/") + GetIsaName(isa);
+		Bench::Register(("math/transform_points" + suffix).c_str(), TransformPointsBench<isa>);
+		Bench::Register(("math/multiply_matrices" + suffix).c_str(), MultiplyMatricesBench<isa>);
+		Bench::Register(("math/transform_spheres" + suffix).c_str(), TransformSpheresBench<isa>);
+		Bench::Register(("math/transform_aabbs" + suffix).c_str(), TransformAabbsBench<isa>);
+		return true;
+	}
+
+}
+
+O_BENCHMARK_REGISTER(RegisterIsa<Isa::Scalar>());
+O_BENCHMARK_REGISTER(RegisterIsa<Isa::SSE>());
+O_BENCHMARK_REGISTER(RegisterIsa<Isa::AVX2>());
+O_BENCHMARK_REGISTER(RegisterIsa<Isa::NEON>());
@@ -0,0 +1,166 @@
+#include "Bench/Bench.h"
+#include "Memory/BlockPool.h"
+#include "Memory/FrameArenas.h"
+#include "Memory/MemoryResource.h"
+#include "Memory/Scratch.h"
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// The allocators against the heap on the patterns they replace: single
+// 64 byte objects, list nodes, a vector grown element by element every
+// frame and a temporary buffer per call. Timed per object, node, element
+// or buffer.
+namespace
+{
+	constexpr size_t objects = 1024u;
+
+	struct Object
+	{
+		uint64_t values[8];
+	};
+
+	void HeapObjects(Bench::State& state)
+	{
+		std::vector<Object*> live(objects);
+		state.SetItemsPerIteration(objects);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			for (Object*& p : live)
+			{
+				p = new Object{};
+			}
+			Bench::DoNotOptimize(live[i % objects]);
+			for (Object* p : live)
+			{
+				delete p;
+			}
+		}
+	}
+
+	void PoolObjects(Bench::State& state)
+	{
+		Memory::BlockPool pool(sizeof(Object));
+		std::vector<Object*> live(objects);
+		state.SetItemsPerIteration(objects);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			for (Object*& p : live)
+			{
+				p = pool.New<Object>();
+			}
+			Bench::DoNotOptimize(live[i % objects]);
+			for (Object* p : live)
+			{
+				pool.Delete(p);
+			}
+		}
+	}
+
+	void HeapList(Bench::State& state)
+	{
+		std::list<uint32_t> list;
+		state.SetItemsPerIteration(objects);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32_t j = 0; j < objects; j++)
+			{
+				list.push_back(j);
+			}
+			while (!list.empty())
+			{
+				Bench::DoNotOptimize(list.front());
+				list.pop_front();
+			}
+		}
+	}
+
+	void PoolList(Bench::State& state)
+	{
+		// list nodes are two pointers and the value
+		Memory::BlockPool pool(4u * sizeof(void*));
+		Memory::PoolResource resource(pool);
+		std::pmr::list<uint32_t> list(&resource);
+		state.SetItemsPerIteration(objects);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			for (uint32_t j = 0; j < objects; j++)
+			{
+				list.push_back(j);
+			}
+			while (!list.empty())
+			{
+				Bench::DoNotOptimize(list.front());
+				list.pop_front();
+			}
+		}
+	}
+
+	void HeapVector(Bench::State& state)
+	{
+		state.SetItemsPerIteration(objects);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			std::vector<uint32_t> values;
+			for (uint32_t j = 0; j < objects; j++)
+			{
+				values.push_back(j);
+			}
+			Bench::DoNotOptimize(values.data());
+		}
+	}
+
+	void FrameVector(Bench::State& state)
+	{
+		Memory::FrameArenas frames(64u * 1024u);
+		state.SetItemsPerIteration(objects);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			frames.BeginFrame();
+			std::pmr::vector<uint32_t> values(frames.GetResource());
+			for (uint32_t j = 0; j < objects; j++)
+			{
+				values.push_back(j);
+			}
+			Bench::DoNotOptimize(values.data());
+		}
+	}
+
+	void HeapBuffer(Bench::State& state)
+	{
+		state.SetItemsPerIteration(1u);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			auto bytes = std::make_unique<std::byte[]>(4096u);
+			Bench::DoNotOptimize(bytes.get());
+		}
+	}
+
+	void ScratchBuffer(Bench::State& state)
+	{
+		state.SetItemsPerIteration(1u);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Memory::Scratch scratch;
+			Bench::DoNotOptimize(scratch.Allocate(4096u));
+		}
+	}
+}
+
+O_BENCHMARK("memory/objects_heap", HeapObjects);
+O_BENCHMARK("memory/objects_pool", PoolObjects);
+O_BENCHMARK("memory/list_heap", HeapList);
+O_BENCHMARK("memory/list_pool", PoolList);
+O_BENCHMARK("memory/vector_heap", HeapVector);
+O_BENCHMARK("memory/vector_frame_arena", FrameVector);
+O_BENCHMARK("memory/buffer_4k_heap", HeapBuffer);
+O_BENCHMARK("memory/buffer_4k_scratch", ScratchBuffer);
@@ -0,0 +1,122 @@
+#include "Bench/Bench.h"
+#include "Mesh/MeshBlob.h"
+#include "Mesh/MeshOptimize.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+
+// A 256x128 UV sphere, about 65k triangles, with its triangles shuffled so
+// the optimizers start from the worst order an exporter could produce.
+// Welding runs on the same sphere as an unindexed triangle soup. Everything
+// is timed per triangle.
+namespace
+{
+	using namespace OMath;
+
+	constexpr uint32_t slices = 256u;
+	constexpr uint32_t stacks = 128u;
+
+	const Mesh& GetSphere()
+	{
+		static const Mesh mesh = []
+		{
+			std::vector<Mesh::Vertex> vertices;
+			for (uint32_t y = 0; y <= stacks; y++)
+			{
+				for (uint32_t x = 0; x <= slices; x++)
+				{
+					const float theta = float(y) / float(stacks) * 3.14159265f;
+					const float phi = float(x) / float(slices) * 6.28318531f;
+					const XMFLOAT3 n(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+					vertices.push_back({ n, n, XMFLOAT2(float(x) / float(slices), float(y) / float(stacks)) });
+				}
+			}
+			std::vector<std::array<uint32_t, 3>> triangles;
+			for (uint32_t y = 0; y < stacks; y++)
+			{
+				for (uint32_t x = 0; x < slices; x++)
+				{
+					const uint32_t a = y * (slices + 1u) + x;
+					const uint32_t b = a + slices + 1u;
+					triangles.push_back({ a, a + 1u, b });
+					triangles.push_back({ a + 1u, b + 1u, b });
+				}
+			}
+			std::shuffle(triangles.begin(), triangles.end(), std::mt19937(24u));
+			std::vector<uint32_t> indices;
+			for (const auto& triangle : triangles)
+			{
+				indices.insert(indices.end(), triangle.begin(), triangle.end());
+			}
+			return Mesh(std::move(vertices), std::move(indices));
+		}();
+		return mesh;
+	}
+
+	void Weld(Bench::State& state)
+	{
+		const Mesh& sphere = GetSphere();
+		std::vector<Mesh::Vertex> soup;
+		std::vector<uint32_t> indices;
+		for (uint32_t index : sphere.GetIndices())
+		{
+			indices.push_back(uint32_t(soup.size()));
+			soup.push_back(sphere.GetVertices()[index]);
+		}
+		state.SetItemsPerIteration(sphere.GetTriangleCount());
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Mesh mesh(soup, indices);
+			Bench::DoNotOptimize(mesh.Weld());
+		}
+	}
+
+	template<MeshOptimize::CacheAlgorithm algorithm>
+	void VertexCache(Bench::State& state)
+	{
+		const Mesh& sphere = GetSphere();
+		state.SetItemsPerIteration(sphere.GetTriangleCount());
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Mesh mesh = sphere;
+			MeshOptimize::OptimizeVertexCache(mesh, algorithm);
+			Bench::DoNotOptimize(mesh.GetIndices()[0]);
+		}
+	}
+
+	void Overdraw(Bench::State& state)
+	{
+		Mesh sphere = GetSphere();
+		MeshOptimize::OptimizeVertexCache(sphere, MeshOptimize::CacheAlgorithm::Tipsify);
+		state.SetItemsPerIteration(sphere.GetTriangleCount());
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Mesh mesh = sphere;
+			MeshOptimize::OptimizeOverdraw(mesh);
+			Bench::DoNotOptimize(mesh.GetIndices()[0]);
+		}
+	}
+
+	void CookCompact(Bench::State& state)
+	{
+		const Mesh& sphere = GetSphere();
+		MeshBlob::Options options;
+		options.analyze = false;
+		state.SetItemsPerIteration(sphere.GetTriangleCount());
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Bench::DoNotOptimize(MeshBlob::Cook(sphere, options).GetData().data());
+		}
+	}
+}
+
+O_BENCHMARK("mesh/weld_65k", Weld);
+O_BENCHMARK("mesh/forsyth_65k", VertexCache<MeshOptimize::CacheAlgorithm::Forsyth>);
+O_BENCHMARK("mesh/tipsify_65k", VertexCache<MeshOptimize::CacheAlgorithm::Tipsify>);
+O_BENCHMARK("mesh/overdraw_65k", Overdraw);
+O_BENCHMARK("mesh/cook_compact_65k", CookCompact);
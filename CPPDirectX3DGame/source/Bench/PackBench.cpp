@@ -0,0 +1,119 @@
+#include "Bench/Bench.h"
+#include "Asset/PackArchive.h"
+#include "Asset/PackWriter.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// 256 files of 64KB, half text-like and half noise, loaded as loose files
+// through ifstream and from archives with and without compression. Every
+// load sums the bytes it got so the pages are really read; files are warm
+// in the OS cache after the first iteration. Time is per file.
+namespace
+{
+	namespace fs = std::filesystem;
+
+	constexpr size_t count = 256u;
+	constexpr size_t fileSize = 64u * 1024u;
+
+	struct Assets
+	{
+		Assets()
+		{
+			directory = fs::temp_directory_path() / "o_pack_bench";
+			fs::remove_all(directory);
+			fs::create_directories(directory / "loose");
+			std::mt19937 rng(20u);
+			PackWriter stored(PackWriter::Options{ 16u, false, 0.9f });
+			PackWriter compressed;
+			for (size_t i = 0; i < count; i++)
+			{
+				std::vector<std::byte> data(fileSize);
+				const bool text = i % 2u == 0u;
+				for (std::byte& b : data)
+				{
+					b = std::byte(text ? "etaoin shrdlu\n"[rng() % 14u] : char(rng()));
+				}
+				const std::string name = "asset" + std::to_string(i) + ".bin";
+				std::ofstream(directory / "loose" / name, std::ios::binary)
+					.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+				names.push_back(name);
+				stored.Add(name, data);
+				compressed.Add(name, std::move(data));
+			}
+			stored.Write((directory / "stored.pak").string());
+			compressed.Write((directory / "compressed.pak").string());
+		}
+		fs::path directory;
+		std::vector<std::string> names;
+	};
+
+	Assets& GetAssets()
+	{
+		static Assets assets;
+		return assets;
+	}
+
+	uint64_t Sum(const std::byte* p, size_t size) noexcept
+	{
+		uint64_t sum = 0u;
+		for (size_t i = 0; i + 8u <= size; i += 8u)
+		{
+			uint64_t word;
+			std::memcpy(&word, p + i, 8u);
+			sum += word;
+		}
+		return sum;
+	}
+
+	void LooseFiles(Bench::State& state)
+	{
+		Assets& a = GetAssets();
+		std::vector<std::byte> data;
+		uint64_t sum = 0u;
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			for (const std::string& name : a.names)
+			{
+				// one read of the whole file, the best case for loose files
+				std::ifstream file(a.directory / "loose" / name, std::ios::binary | std::ios::ate);
+				data.resize(size_t(file.tellg()));
+				file.seekg(0);
+				file.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size()));
+				sum += Sum(data.data(), data.size());
+			}
+		}
+		Bench::DoNotOptimize(sum);
+	}
+
+	template<bool compressed>
+	void Archive(Bench::State& state)
+	{
+		Assets& a = GetAssets();
+		const std::string path = (a.directory / (compressed ? "compressed.pak" : "stored.pak")).string();
+		std::vector<std::byte> scratch;
+		uint64_t sum = 0u;
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			// opening is part of loading
+			const PackArchive archive(path);
+			for (const std::string& name : a.names)
+			{
+				const std::span<const std::byte> data = archive.Read(archive.Find(name), scratch);
+				sum += Sum(data.data(), data.size());
+			}
+		}
+		Bench::DoNotOptimize(sum);
+	}
+}
+
+O_BENCHMARK("pack/loose_files_256x64k", LooseFiles);
+O_BENCHMARK("pack/archive_stored_256x64k", Archive<false>);
+O_BENCHMARK("pack/archive_lz4_256x64k", Archive<true>);
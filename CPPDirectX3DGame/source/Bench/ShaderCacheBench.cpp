@@ -0,0 +1,95 @@
+#include "Bench/Bench.h"
+#include "Job/JobSystem.h"
+#include "Render/Shader/FakeShaderCompiler.h"
+#include "Render/Shader/ShaderCache.h"
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+// Startup of 64 shaders sharing two include files, served from memory and
+// compiled by a fake compiler that spends 2ms on each. Cold starts from an
+// empty cache directory, warm from one the previous launch filled. Time is
+// per shader.
+namespace
+{
+	constexpr size_t count = 64u;
+
+	struct Sources
+	{
+		Sources()
+		{
+			files["shaders/common.hlsli"] = "#include \"lighting.hlsli\"\ncbuffer Frame : register(b0) { float4x4 viewProj; };\n";
+			files["shaders/lighting.hlsli"] = "float3 Lambert(float3 n, float3 l) { return saturate(dot(n, l)); }\n";
+			for (size_t i = 0; i < count; i++)
+			{
+				ShaderDesc desc;
+				desc.path = "shaders/material" + std::to_string(i) + ".hlsl";
+				desc.profile = i % 2u ? "ps_5_0" : "vs_5_0";
+				desc.defines = { { "VARIANT", std::to_string(i) } };
+				files[desc.path] = "#include \"common.hlsli\"\nfloat4 main() : SV_Target { return " + std::to_string(i) + "; }\n";
+				descs.push_back(desc);
+			}
+			directory = (std::filesystem::temp_directory_path() / "o_shader_cache_bench").string();
+		}
+		ShaderCache::Config MakeConfig()
+		{
+			ShaderCache::Config config;
+			config.directory = directory;
+			config.pJobs = &jobs;
+			config.loader = [this](const std::string& path, std::string& contents)
+			{
+				const auto it = files.find(path);
+				if (it == files.end())
+				{
+					return false;
+				}
+				contents = it->second;
+				return true;
+			};
+			return config;
+		}
+		std::unordered_map<std::string, std::string> files;
+		std::vector<ShaderDesc> descs;
+		std::string directory;
+		JobSystem jobs;
+	};
+
+	Sources& GetSources()
+	{
+		static Sources sources;
+		return sources;
+	}
+
+	void Cold(Bench::State& state)
+	{
+		Sources& s = GetSources();
+		FakeShaderCompiler compiler(2000u);
+		state.SetItemsPerIteration(count);
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			state.PauseTiming();
+			std::filesystem::remove_all(s.directory);
+			state.ResumeTiming();
+			ShaderCache cache(compiler, s.MakeConfig());
+			Bench::DoNotOptimize(cache.Load(s.descs).data());
+		}
+	}
+
+	void Warm(Bench::State& state)
+	{
+		Sources& s = GetSources();
+		FakeShaderCompiler compiler(2000u);
+		std::filesystem::remove_all(s.directory);
+		ShaderCache(compiler, s.MakeConfig()).Load(s.descs);
+		state.SetItemsPerIteration(count);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			ShaderCache cache(compiler, s.MakeConfig());
+			Bench::DoNotOptimize(cache.Load(s.descs).data());
+		}
+	}
+}
+
+O_BENCHMARK("shader_cache/cold_64", Cold);
+O_BENCHMARK("shader_cache/warm_64", Warm);
@@ -0,0 +1,35 @@
+#include "Bench/Bench.h"
+#include "Time/OTimer.h"
+
+namespace
+{
+	void TimerMark(Bench::State& state)
+	{
+		OTimer timer;
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Bench::DoNotOptimize(timer.Mark());
+		}
+	}
+
+	void TimerMarkTicks(Bench::State& state)
+	{
+		OTimer timer;
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Bench::DoNotOptimize(timer.MarkTicks());
+		}
+	}
+
+	void TimerNow(Bench::State& state)
+	{
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			Bench::DoNotOptimize(OTimer::Now());
+		}
+	}
+}
+
+O_BENCHMARK("timer/mark", TimerMark);
+O_BENCHMARK("timer/mark_ticks", TimerMarkTicks);
+O_BENCHMARK("timer/now", TimerNow);
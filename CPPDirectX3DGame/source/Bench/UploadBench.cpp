@@ -0,0 +1,52 @@
+#include "Bench/Bench.h"
+#include "Render/Upload/CpuUploadBuffer.h"
+#include "Render/Upload/FakeFrameFence.h"
+#include "Render/Upload/UploadRing.h"
+#include <cstdint>
+#include <cstring>
+
+// 10k per-draw constant blocks of 64 bytes a frame into a 4MB ring over
+// system memory: the pointer bump alone, then with the copy into the slice.
+// Time is per upload.
+namespace
+{
+	constexpr size_t draws = 10000u;
+	constexpr size_t blockSize = 64u;
+	constexpr size_t ringSize = 4u * 1024u * 1024u;
+
+	template<bool write>
+	void Ring(Bench::State& state)
+	{
+		CpuUploadBuffer buffer(ringSize);
+		FakeFrameFence fence(2u);
+		UploadRing ring(buffer, fence, 3u);
+		uint8_t block[blockSize] = {};
+		uint64_t frame = 0u;
+		state.SetItemsPerIteration(draws);
+		state.ResetTimer();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			for (size_t j = 0; j < draws; j++)
+			{
+				// constant buffer offsets have to be multiples of 256 bytes
+				const UploadRing::Allocation a = ring.Allocate(blockSize, 256u);
+				if constexpr (write)
+				{
+					block[0] = uint8_t(j);
+					std::memcpy(a.pData, block, blockSize);
+				}
+				else
+				{
+					Bench::DoNotOptimize(a.pData);
+				}
+			}
+			frame++;
+			ring.EndFrame(frame);
+			fence.Signal(frame);
+		}
+		Bench::DoNotOptimize(ring.GetStats().bytesUploaded);
+	}
+}
+
+O_BENCHMARK("upload/ring_allocate_10k", Ring<false>);
+O_BENCHMARK("upload/ring_upload_10k", Ring<true>);
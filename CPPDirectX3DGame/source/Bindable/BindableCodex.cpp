@@ -0,0 +1,58 @@
+#include "Bindable/BindableCodex.h"
+
+namespace Bind
+{
+	Codex::Stats Codex::GetStats() noexcept
+	{
+		Codex& codex = Get();
+		std::lock_guard<std::mutex> lock(codex.mtx);
+		Stats total;
+		for (const auto& s : codex.stats)
+		{
+			total.lookups += s.second.lookups;
+			total.hits += s.second.hits;
+			total.created += s.second.created;
+		}
+		return total;
+	}
+
+	std::vector<std::pair<std::string, Codex::Stats>> Codex::GetTypeStats()
+	{
+		Codex& codex = Get();
+		std::lock_guard<std::mutex> lock(codex.mtx);
+		std::vector<std::pair<std::string, Stats>> typeStats;
+		typeStats.reserve(codex.stats.size());
+		for (const auto& s : codex.stats)
+		{
+			typeStats.emplace_back(s.first.name(), s.second);
+		}
+		return typeStats;
+	}
+
+	size_t Codex::GetSize() noexcept
+	{
+		Codex& codex = Get();
+		std::lock_guard<std::mutex> lock(codex.mtx);
+		return codex.binds.size();
+	}
+
+	void Codex::ResetStats() noexcept
+	{
+		Codex& codex = Get();
+		std::lock_guard<std::mutex> lock(codex.mtx);
+		codex.stats.clear();
+	}
+
+	void Codex::Clear() noexcept
+	{
+		Codex& codex = Get();
+		std::lock_guard<std::mutex> lock(codex.mtx);
+		codex.binds.clear();
+	}
+
+	Codex& Codex::Get()
+	{
+		static Codex codex;
+		return codex;
+	}
+}
@@ -0,0 +1,55 @@
+#include "Bindable/Blender.h"
+#include "Bindable/DescriptorKey.h"
+#include "Render/GraphicsThrowMacros.h"
+#include <iterator>
+
+namespace Bind
+{
+	Blender::Blender(Graphics& gfx, const D3D11_BLEND_DESC& desc)
+	{
+		INFOMAN(gfx);
+
+		GFX_THROW_INFO(GetDevice(gfx)->CreateBlendState(&desc, &pBlender));
+	}
+
+	void Blender::Bind(Graphics& gfx) noexcept
+	{
+		GetContext(gfx)->OMSetBlendState(pBlender.Get(), nullptr, 0xFFFFFFFFu);
+	}
+
+	std::string Blender::GenerateKey(const D3D11_BLEND_DESC& desc)
+	{
+		DescriptorKey key(typeid(Blender).name());
+		key.Add(desc.AlphaToCoverageEnable).Add(desc.IndependentBlendEnable);
+		// without independent blend only target 0 is used by the runtime
+		const size_t nTargets = desc.IndependentBlendEnable ? std::size(desc.RenderTarget) : 1u;
+		for (size_t i = 0; i < nTargets; i++)
+		{
+			const auto& rt = desc.RenderTarget[i];
+			key.Add(rt.BlendEnable)
+				.Add(rt.SrcBlend)
+				.Add(rt.DestBlend)
+				.Add(rt.BlendOp)
+				.Add(rt.SrcBlendAlpha)
+				.Add(rt.DestBlendAlpha)
+				.Add(rt.BlendOpAlpha)
+				.Add(rt.RenderTargetWriteMask);
+		}
+		return key.Release();
+	}
+
+	D3D11_BLEND_DESC Blender::DefaultDesc(bool blending) noexcept
+	{
+		D3D11_BLEND_DESC desc = {};
+		auto& rt = desc.RenderTarget[0];
+		rt.BlendEnable = blending ? TRUE : FALSE;
+		rt.SrcBlend = blending ? D3D11_BLEND_SRC_ALPHA : D3D11_BLEND_ONE;
+		rt.DestBlend = blending ? D3D11_BLEND_INV_SRC_ALPHA : D3D11_BLEND_ZERO;
+		rt.BlendOp = D3D11_BLEND_OP_ADD;
+		rt.SrcBlendAlpha = D3D11_BLEND_ONE;
+		rt.DestBlendAlpha = D3D11_BLEND_ZERO;
+		rt.BlendOpAlpha = D3D11_BLEND_OP_ADD;
+		rt.RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+		return desc;
+	}
+}
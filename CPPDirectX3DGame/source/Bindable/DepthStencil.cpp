@@ -0,0 +1,61 @@
+#include "Bindable/DepthStencil.h"
+#include "Bindable/DescriptorKey.h"
+#include "Render/GraphicsThrowMacros.h"
+
+namespace Bind
+{
+	namespace
+	{
+		void AddStencilOp(DescriptorKey& key, const D3D11_DEPTH_STENCILOP_DESC& op)
+		{
+			key.Add(op.StencilFailOp)
+				.Add(op.StencilDepthFailOp)
+				.Add(op.StencilPassOp)
+				.Add(op.StencilFunc);
+		}
+	}
+
+	DepthStencil::DepthStencil(Graphics& gfx, const D3D11_DEPTH_STENCIL_DESC& desc, UINT stencilRef)
+		:
+		stencilRef(stencilRef)
+	{
+		INFOMAN(gfx);
+
+		GFX_THROW_INFO(GetDevice(gfx)->CreateDepthStencilState(&desc, &pDepthStencil));
+	}
+
+	void DepthStencil::Bind(Graphics& gfx) noexcept
+	{
+		GetContext(gfx)->OMSetDepthStencilState(pDepthStencil.Get(), stencilRef);
+	}
+
+	std::string DepthStencil::GenerateKey(const D3D11_DEPTH_STENCIL_DESC& desc, UINT stencilRef)
+	{
+		DescriptorKey key(typeid(DepthStencil).name());
+		key.Add(desc.DepthEnable)
+			.Add(desc.DepthWriteMask)
+			.Add(desc.DepthFunc)
+			.Add(desc.StencilEnable)
+			.Add(desc.StencilReadMask)
+			.Add(desc.StencilWriteMask);
+		AddStencilOp(key, desc.FrontFace);
+		AddStencilOp(key, desc.BackFace);
+		key.Add(stencilRef);
+		return key.Release();
+	}
+
+	D3D11_DEPTH_STENCIL_DESC DepthStencil::DefaultDesc() noexcept
+	{
+		D3D11_DEPTH_STENCIL_DESC desc = {};
+		desc.DepthEnable = TRUE;
+		desc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
+		desc.DepthFunc = D3D11_COMPARISON_LESS_EQUAL;
+		desc.StencilEnable = FALSE;
+		desc.StencilReadMask = D3D11_DEFAULT_STENCIL_READ_MASK;
+		desc.StencilWriteMask = D3D11_DEFAULT_STENCIL_WRITE_MASK;
+		const D3D11_DEPTH_STENCILOP_DESC op = { D3D11_STENCIL_OP_KEEP, D3D11_STENCIL_OP_KEEP, D3D11_STENCIL_OP_KEEP, D3D11_COMPARISON_ALWAYS };
+		desc.FrontFace = op;
+		desc.BackFace = op;
+		return desc;
+	}
+}
@@ -0,0 +1,16 @@
+#include "Bindable/DescriptorKey.h"
+
+namespace Bind
+{
+	uint64_t HashBytes(const void* pData, size_t size, uint64_t seed) noexcept
+	{
+		const auto* pBytes = static_cast<const unsigned char*>(pData);
+		uint64_t hash = seed;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= pBytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+}
@@ -0,0 +1,41 @@
+#include "Bindable/InputLayout.h"
+#include "Bindable/DescriptorKey.h"
+#include "Render/GraphicsThrowMacros.h"
+
+namespace Bind
+{
+	InputLayout::InputLayout(Graphics& gfx, const std::vector<D3D11_INPUT_ELEMENT_DESC>& layout, ID3DBlob* pVertexShaderBytecode)
+	{
+		INFOMAN(gfx);
+
+		GFX_THROW_INFO(GetDevice(gfx)->CreateInputLayout(
+			layout.data(), UINT(layout.size()),
+			pVertexShaderBytecode->GetBufferPointer(),
+			pVertexShaderBytecode->GetBufferSize(),
+			&pInputLayout
+		));
+	}
+
+	void InputLayout::Bind(Graphics& gfx) noexcept
+	{
+		GetContext(gfx)->IASetInputLayout(pInputLayout.Get());
+	}
+
+	std::string InputLayout::GenerateKey(const std::vector<D3D11_INPUT_ELEMENT_DESC>& layout, ID3DBlob* pVertexShaderBytecode)
+	{
+		DescriptorKey key(typeid(InputLayout).name());
+		for (const auto& e : layout)
+		{
+			key.Add(e.SemanticName)
+				.Add(e.SemanticIndex)
+				.Add(e.Format)
+				.Add(e.InputSlot)
+				.Add(e.AlignedByteOffset)
+				.Add(e.InputSlotClass)
+				.Add(e.InstanceDataStepRate);
+		}
+		// layouts are validated against the shader input signature, so it is part of the identity
+		key.AddBytes(pVertexShaderBytecode->GetBufferPointer(), pVertexShaderBytecode->GetBufferSize());
+		return key.Release();
+	}
+}
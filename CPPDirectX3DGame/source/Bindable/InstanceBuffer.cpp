@@ -0,0 +1,77 @@
+#include "Bindable/InstanceBuffer.h"
+#include "Bindable/DescriptorKey.h"
+#include "Render/GraphicsThrowMacros.h"
+#include <cstring>
+
+namespace Bind
+{
+	InstanceBuffer::InstanceBuffer(Graphics& gfx, const std::string& tag, UINT stride, UINT capacity, UINT slot)
+		:
+		stride(stride),
+		slot(slot)
+	{
+		Create(gfx, capacity);
+	}
+
+	void InstanceBuffer::Update(Graphics& gfx, const void* pInstances, UINT count)
+	{
+		INFOMAN(gfx);
+
+		if (count > capacity)
+		{
+			// grow geometrically so a slowly rising count does not recreate every frame
+			Create(gfx, count > capacity * 2u ? count : capacity * 2u);
+			// the old buffer may still be bound
+			Bind(gfx);
+		}
+		if (count == 0u)
+		{
+			return;
+		}
+		D3D11_MAPPED_SUBRESOURCE msr;
+		GFX_THROW_INFO(GetContext(gfx)->Map(
+			pInstanceBuffer.Get(), 0u,
+			D3D11_MAP_WRITE_DISCARD, 0u,
+			&msr
+		));
+		memcpy(msr.pData, pInstances, size_t(stride) * count);
+		GetContext(gfx)->Unmap(pInstanceBuffer.Get(), 0u);
+	}
+
+	void InstanceBuffer::Bind(Graphics& gfx) noexcept
+	{
+		const UINT offset = 0u;
+		GetContext(gfx)->IASetVertexBuffers(slot, 1u, pInstanceBuffer.GetAddressOf(), &stride, &offset);
+	}
+
+	UINT InstanceBuffer::GetCapacity() const noexcept
+	{
+		return capacity;
+	}
+
+	std::string InstanceBuffer::GenerateKey(const std::string& tag, UINT stride, UINT capacity, UINT slot)
+	{
+		// capacity only sizes the first allocation, not part of the identity
+		return DescriptorKey(typeid(InstanceBuffer).name())
+			.Add(tag)
+			.Add(stride)
+			.Add(slot)
+			.Release();
+	}
+
+	void InstanceBuffer::Create(Graphics& gfx, UINT newCapacity)
+	{
+		INFOMAN(gfx);
+
+		D3D11_BUFFER_DESC bd = {};
+		bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		bd.Usage = D3D11_USAGE_DYNAMIC;
+		bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		bd.MiscFlags = 0u;
+		bd.ByteWidth = stride * newCapacity;
+		bd.StructureByteStride = stride;
+		pInstanceBuffer.Reset();
+		GFX_THROW_INFO(GetDevice(gfx)->CreateBuffer(&bd, nullptr, &pInstanceBuffer));
+		capacity = newCapacity;
+	}
+}
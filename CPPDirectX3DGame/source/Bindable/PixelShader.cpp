@@ -0,0 +1,38 @@
+#include "Bindable/PixelShader.h"
+#include "Bindable/DescriptorKey.h"
+#include "Render/GraphicsThrowMacros.h"
+
+namespace Bind
+{
+	PixelShader::PixelShader(Graphics& gfx, const std::string& path)
+	{
+		INFOMAN(gfx);
+
+		Microsoft::WRL::ComPtr<ID3DBlob> pBlob;
+		GFX_THROW_INFO(D3DReadFileToBlob(std::wstring{ path.begin(),path.end() }.c_str(), &pBlob));
+		GFX_THROW_INFO(GetDevice(gfx)->CreatePixelShader(pBlob->GetBufferPointer(), pBlob->GetBufferSize(), nullptr, &pPixelShader));
+	}
+
+	PixelShader::PixelShader(Graphics& gfx, ShaderCache& cache, const ShaderDesc& desc)
+	{
+		INFOMAN(gfx);
+
+		const ShaderCache::Bytecode bytecode = cache.Get(desc);
+		GFX_THROW_INFO(GetDevice(gfx)->CreatePixelShader(bytecode->data(), bytecode->size(), nullptr, &pPixelShader));
+	}
+
+	void PixelShader::Bind(Graphics& gfx) noexcept
+	{
+		GetContext(gfx)->PSSetShader(pPixelShader.Get(), nullptr, 0u);
+	}
+
+	std::string PixelShader::GenerateKey(const std::string& path)
+	{
+		return DescriptorKey(typeid(PixelShader).name()).Add(path).Release();
+	}
+
+	std::string PixelShader::GenerateKey(const ShaderCache& cache, const ShaderDesc& desc)
+	{
+		return DescriptorKey(typeid(PixelShader).name()).Add(cache.ComputeKey(desc).ToString()).Release();
+	}
+}
@@ -0,0 +1,44 @@
+#include "Bindable/Rasterizer.h"
+#include "Bindable/DescriptorKey.h"
+#include "Render/GraphicsThrowMacros.h"
+
+namespace Bind
+{
+	Rasterizer::Rasterizer(Graphics& gfx, const D3D11_RASTERIZER_DESC& desc)
+	{
+		INFOMAN(gfx);
+
+		GFX_THROW_INFO(GetDevice(gfx)->CreateRasterizerState(&desc, &pRasterizer));
+	}
+
+	void Rasterizer::Bind(Graphics& gfx) noexcept
+	{
+		GetContext(gfx)->RSSetState(pRasterizer.Get());
+	}
+
+	std::string Rasterizer::GenerateKey(const D3D11_RASTERIZER_DESC& desc)
+	{
+		return DescriptorKey(typeid(Rasterizer).name())
+			.Add(desc.FillMode)
+			.Add(desc.CullMode)
+			.Add(desc.FrontCounterClockwise)
+			.Add(desc.DepthBias)
+			.Add(desc.DepthBiasClamp)
+			.Add(desc.SlopeScaledDepthBias)
+			.Add(desc.DepthClipEnable)
+			.Add(desc.ScissorEnable)
+			.Add(desc.MultisampleEnable)
+			.Add(desc.AntialiasedLineEnable)
+			.Release();
+	}
+
+	D3D11_RASTERIZER_DESC Rasterizer::DefaultDesc(bool twoSided) noexcept
+	{
+		D3D11_RASTERIZER_DESC desc = {};
+		desc.FillMode = D3D11_FILL_SOLID;
+		desc.CullMode = twoSided ? D3D11_CULL_NONE : D3D11_CULL_BACK;
+		desc.FrontCounterClockwise = FALSE;
+		desc.DepthClipEnable = TRUE;
+		return desc;
+	}
+}
@@ -0,0 +1,54 @@
+#include "Bindable/Sampler.h"
+#include "Bindable/DescriptorKey.h"
+#include "Render/GraphicsThrowMacros.h"
+
+namespace Bind
+{
+	Sampler::Sampler(Graphics& gfx, const D3D11_SAMPLER_DESC& desc, UINT slot)
+		:
+		slot(slot)
+	{
+		INFOMAN(gfx);
+
+		GFX_THROW_INFO(GetDevice(gfx)->CreateSamplerState(&desc, &pSampler));
+	}
+
+	void Sampler::Bind(Graphics& gfx) noexcept
+	{
+		GetContext(gfx)->PSSetSamplers(slot, 1u, pSampler.GetAddressOf());
+	}
+
+	std::string Sampler::GenerateKey(const D3D11_SAMPLER_DESC& desc, UINT slot)
+	{
+		return DescriptorKey(typeid(Sampler).name())
+			.Add(desc.Filter)
+			.Add(desc.AddressU)
+			.Add(desc.AddressV)
+			.Add(desc.AddressW)
+			.Add(desc.MipLODBias)
+			.Add(desc.MaxAnisotropy)
+			.Add(desc.ComparisonFunc)
+			.Add(desc.BorderColor[0])
+			.Add(desc.BorderColor[1])
+			.Add(desc.BorderColor[2])
+			.Add(desc.BorderColor[3])
+			.Add(desc.MinLOD)
+			.Add(desc.MaxLOD)
+			.Add(slot)
+			.Release();
+	}
+
+	D3D11_SAMPLER_DESC Sampler::DefaultDesc() noexcept
+	{
+		D3D11_SAMPLER_DESC desc = {};
+		desc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+		desc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
+		desc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
+		desc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+		desc.MaxAnisotropy = 1u;
+		desc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+		desc.MinLOD = 0.0f;
+		desc.MaxLOD = D3D11_FLOAT32_MAX;
+		return desc;
+	}
+}
@@ -0,0 +1,21 @@
+#include "Bindable/Topology.h"
+#include "Bindable/DescriptorKey.h"
+
+namespace Bind
+{
+	Topology::Topology(Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY type)
+		:
+		type(type)
+	{
+	}
+
+	void Topology::Bind(Graphics& gfx) noexcept
+	{
+		GetContext(gfx)->IASetPrimitiveTopology(type);
+	}
+
+	std::string Topology::GenerateKey(D3D11_PRIMITIVE_TOPOLOGY type)
+	{
+		return DescriptorKey(typeid(Topology).name()).Add(type).Release();
+	}
+}
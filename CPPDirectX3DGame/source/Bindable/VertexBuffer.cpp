@@ -0,0 +1,41 @@
+#include "Bindable/VertexBuffer.h"
+#include "Bindable/DescriptorKey.h"
+#include "Render/GraphicsThrowMacros.h"
+
+namespace Bind
+{
+	VertexBuffer::VertexBuffer(Graphics& gfx, const std::string& tag, const void* pVertices, UINT stride, UINT count)
+		:
+		stride(stride)
+	{
+		INFOMAN(gfx);
+
+		D3D11_BUFFER_DESC bd = {};
+		bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		bd.Usage = D3D11_USAGE_DEFAULT;
+		bd.CPUAccessFlags = 0u;
+		bd.MiscFlags = 0u;
+		bd.ByteWidth = stride * count;
+		bd.StructureByteStride = stride;
+		D3D11_SUBRESOURCE_DATA sd = {};
+		sd.pSysMem = pVertices;
+		GFX_THROW_INFO(GetDevice(gfx)->CreateBuffer(&bd, &sd, &pVertexBuffer));
+	}
+
+	void VertexBuffer::Bind(Graphics& gfx) noexcept
+	{
+		const UINT offset = 0u;
+		GetContext(gfx)->IASetVertexBuffers(0u, 1u, pVertexBuffer.GetAddressOf(), &stride, &offset);
+	}
+
+	std::string VertexBuffer::GenerateKey(const std::string& tag, const void* pVertices, UINT stride, UINT count)
+	{
+		// the contents are part of the key as well, so a tag reused for other data
+		// gets its own buffer instead of the one cached under the tag
+		return DescriptorKey(typeid(VertexBuffer).name())
+			.Add(tag)
+			.Add(stride)
+			.AddBytes(pVertices, size_t(stride) * count)
+			.Release();
+	}
+}
@@ -0,0 +1,56 @@
+#include "Bindable/VertexShader.h"
+#include "Bindable/DescriptorKey.h"
+#include "Render/GraphicsThrowMacros.h"
+#include <cstring>
+
+namespace Bind
+{
+	VertexShader::VertexShader(Graphics& gfx, const std::string& path)
+	{
+		INFOMAN(gfx);
+
+		GFX_THROW_INFO(D3DReadFileToBlob(std::wstring{ path.begin(),path.end() }.c_str(), &pBytecodeBlob));
+		GFX_THROW_INFO(GetDevice(gfx)->CreateVertexShader(
+			pBytecodeBlob->GetBufferPointer(),
+			pBytecodeBlob->GetBufferSize(),
+			nullptr,
+			&pVertexShader
+		));
+	}
+
+	VertexShader::VertexShader(Graphics& gfx, ShaderCache& cache, const ShaderDesc& desc)
+	{
+		INFOMAN(gfx);
+
+		const ShaderCache::Bytecode bytecode = cache.Get(desc);
+		// input layouts are created from the blob
+		GFX_THROW_INFO(D3DCreateBlob(bytecode->size(), &pBytecodeBlob));
+		std::memcpy(pBytecodeBlob->GetBufferPointer(), bytecode->data(), bytecode->size());
+		GFX_THROW_INFO(GetDevice(gfx)->CreateVertexShader(
+			pBytecodeBlob->GetBufferPointer(),
+			pBytecodeBlob->GetBufferSize(),
+			nullptr,
+			&pVertexShader
+		));
+	}
+
+	void VertexShader::Bind(Graphics& gfx) noexcept
+	{
+		GetContext(gfx)->VSSetShader(pVertexShader.Get(), nullptr, 0u);
+	}
+
+	ID3DBlob* VertexShader::GetBytecode() const noexcept
+	{
+		return pBytecodeBlob.Get();
+	}
+
+	std::string VertexShader::GenerateKey(const std::string& path)
+	{
+		return DescriptorKey(typeid(VertexShader).name()).Add(path).Release();
+	}
+
+	std::string VertexShader::GenerateKey(const ShaderCache& cache, const ShaderDesc& desc)
+	{
+		return DescriptorKey(typeid(VertexShader).name()).Add(cache.ComputeKey(desc).ToString()).Release();
+	}
+}
@@ -1,70 +1,315 @@
 #include "Core/App.h"
-#include "Window/Window.h"
+#include "Input/Keyboard.h"
 #include "Input/Mouse.h"
-#include <sstream>
+#include "Render/RenderBackend.h"
+#include "Profile/Profiler.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 
-App::App()
-	: window(800, 300, "CPP Direct3D11 Game")
+App::App(std::unique_ptr<Platform> pPlatform, LoopMode mode)
+	:
+	pPlatform(std::move(pPlatform)),
+	frameMemory(frameMemoryCapacity),
+	mode(mode)
 {
+	this->pPlatform->GetRenderer().SetJobs(&jobs);
 }
 
 App::~App()
 {
+	StopRenderThread();
 }
 
 int App::Start()
 {
-	/*MSG msg;
-	BOOL gResult;
+	return mode == LoopMode::Pipelined ? RunPipelined() : RunSerial();
+}
 
-	while ((gResult = GetMessage(&msg, nullptr, 0, 0)) > 0) {
-		TranslateMessage(&msg);
-		DispatchMessage(&msg);
+void App::SetFrameLimit(uint64_t frames) noexcept
+{
+	frameLimit = frames;
+}
 
-		DoFrame(0);
-	}
+uint64_t App::GetFrameCount() const noexcept
+{
+	return frameIndex;
+}
 
-	if (gResult == -1) {
-		return -1;
-	}
+const StageTimings& App::GetStageTimings() const noexcept
+{
+	return timings;
+}
+
+OClock& App::GetClock() noexcept
+{
+	return clock;
+}
+
+const FrameStats& App::GetFrameStats() const noexcept
+{
+	return frameStats;
+}
+
+Platform& App::GetPlatform() noexcept
+{
+	return *pPlatform;
+}
+
+Ecs::World& App::GetWorld() noexcept
+{
+	return world;
+}
+
+AssetStreamer& App::GetStreamer() noexcept
+{
+	return streamer;
+}
+
+JobSystem& App::GetJobs() noexcept
+{
+	return jobs;
+}
+
+Memory::FrameArenas& App::GetFrameMemory() noexcept
+{
+	return frameMemory;
+}
+
+const Memory::AllocationCounter& App::GetAllocations() const noexcept
+{
+	return allocations;
+}
 
-	return msg.wParam;*/
+void App::RecordInput(InputRecorder& recorder) noexcept
+{
+	pRecorder = &recorder;
+	inputFrameBase = frameIndex;
+	recorder.BeginFrame(0u);
+	pPlatform->GetKeyboard().SetRecorder(pRecorder);
+	pPlatform->GetMouse().SetRecorder(pRecorder);
+}
 
+void App::ReplayInput(InputReplay& replay) noexcept
+{
+	pReplay = &replay;
+	inputFrameBase = frameIndex;
+	clock.EnableDeterministic(replay.GetFrameSeconds());
+}
+
+int App::RunSerial()
+{
+	O_PROFILE_THREAD("Main");
 	while (true)
 	{
+		OTimer stage;
 		// process all messages pending, but to not block for new messages
-		if (const auto exitCode = Window::ProcessMessages())
+		const auto exitCode = pPlatform->ProcessMessages();
+		timings.Set(StageTimings::Stage::Messages, stage.Mark());
+		if (exitCode)
 		{
 			// if return optional has value, means we're quitting so return exit code
 			return *exitCode;
 		}
 		// execute the game logic
-		const auto dt = timer.Mark()  /*speed_factor*/;
-		HandleInput(dt);
-		DoFrame(dt);
+		DoFrame();
+		O_PROFILE_END_FRAME();
+		if (frameLimit != 0u && frameIndex >= frameLimit)
+		{
+			return 0;
+		}
 	}
 }
 
-void App::HandleInput(float dt)
+int App::RunPipelined()
 {
+	O_PROFILE_THREAD("Main");
+	renderThread = std::thread(&App::RenderLoop, this);
+	while (true)
+	{
+		OTimer stage;
+		// message pumping has to stay on the thread that created the window
+		const auto exitCode = pPlatform->ProcessMessages();
+		timings.Set(StageTimings::Stage::Messages, stage.Mark());
+		if (exitCode)
+		{
+			StopRenderThread();
+			return *exitCode;
+		}
+		{
+			// stay at most one snapshot ahead of the renderer, but wake up
+			// regularly so the window keeps responding while we wait
+			std::unique_lock<std::mutex> lock(pipeMtx);
+			const bool ready = pipeCv.wait_for(lock, std::chrono::milliseconds(1),
+				[this] { return consumed == published || renderError; });
+			if (renderError)
+			{
+				lock.unlock();
+				StopRenderThread();
+				std::rethrow_exception(renderError);
+			}
+			if (!ready)
+			{
+				continue;
+			}
+		}
+		Simulate(snapshots.GetWriteBuffer());
+		snapshots.Publish();
+		{
+			std::lock_guard<std::mutex> lock(pipeMtx);
+			published++;
+		}
+		pipeCv.notify_all();
+		O_PROFILE_END_FRAME();
+		if (frameLimit != 0u && frameIndex >= frameLimit)
+		{
+			// the renderer presents the last published frame before it stops
+			std::unique_lock<std::mutex> lock(pipeMtx);
+			pipeCv.wait(lock, [this] { return rendered == published || renderError; });
+			const std::exception_ptr error = renderError;
+			lock.unlock();
+			StopRenderThread();
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+			return 0;
+		}
+	}
 }
 
-void App::DoFrame(float dt)
+void App::RenderLoop() noexcept
 {
-	static float elapsedTime = 0.0f; // Accumulated time
-	elapsedTime += dt;              // Add the delta time
+	try
+	{
+		O_PROFILE_THREAD("Render");
+		while (true)
+		{
+			uint64_t frame;
+			{
+				std::unique_lock<std::mutex> lock(pipeMtx);
+				pipeCv.wait(lock, [this] { return renderStop || consumed != published; });
+				if (renderStop)
+				{
+					return;
+				}
+				consumed = published;
+				frame = consumed;
+			}
+			// let the simulation start on the next frame while we draw this one
+			pipeCv.notify_all();
+			snapshots.Acquire();
+			Render(snapshots.GetReadBuffer());
+			{
+				std::lock_guard<std::mutex> lock(pipeMtx);
+				rendered = frame;
+			}
+			pipeCv.notify_all();
+		}
+	}
+	catch (...)
+	{
+		// surfaced on the main thread, which owns the error reporting
+		std::lock_guard<std::mutex> lock(pipeMtx);
+		renderError = std::current_exception();
+		pipeCv.notify_all();
+	}
+}
 
-	// Update title
-	std::ostringstream oss;
-	oss << "Time elapsed: " << std::setprecision(1) << std::fixed << elapsedTime << "s";
-	window.SetTitle(oss.str());
+void App::StopRenderThread() noexcept
+{
+	if (!renderThread.joinable())
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(pipeMtx);
+		renderStop = true;
+	}
+	pipeCv.notify_all();
+	renderThread.join();
+}
+
+void App::HandleInput(float /*dt*/)
+{
+	O_PROFILE_FUNCTION();
+}
+
+void App::DoFrame()
+{
+	O_PROFILE_FUNCTION();
+	FrameSnapshot snapshot;
+	Simulate(snapshot);
+	Render(snapshot);
+}
+
+void App::Simulate(FrameSnapshot& snapshot)
+{
+	O_PROFILE_FUNCTION();
+	OTimer stage;
+	// everything allocated since the last frame began, on any thread
+	frameMemory.BeginFrame();
+	allocations.AddFrame(frameMemory.GetLastFrameStats());
+	if (pReplay)
+	{
+		pReplay->Feed(frameIndex - inputFrameBase, pPlatform->GetKeyboard(), pPlatform->GetMouse());
+	}
+	if (pRecorder)
+	{
+		// whatever arrives from here on is consumed by the next frame
+		pRecorder->BeginFrame(frameIndex - inputFrameBase + 1u);
+	}
+	const unsigned int steps = clock.Advance();
+	HandleInput(clock.GetFrameSeconds());
+	timings.Set(StageTimings::Stage::Input, stage.Mark());
+
+	// fixed steps keep the simulation independent of the frame rate
+	for (unsigned int i = 0; i < steps; i++)
+	{
+		Step(clock.GetStepSeconds());
+	}
+
+	// render between the last two simulated states
+	const double elapsedTime = clock.GetInterpolatedSeconds();
+
+	// Update title, a few times a second is plenty and keeps SetWindowText out of most frames
+	if (frameStats.AddFrame(clock.GetRealFrameSeconds()))
+	{
+		frameStats.Update();
+		std::snprintf(title.data(), title.size(), "Time elapsed: %.1fs | %s | %s", elapsedTime, frameStats.Format(), allocations.Format());
+		pPlatform->SetTitle(title.data());
+	}
 
 	// Add sine wave to give some animated color
-	const float c = sin(elapsedTime) / 2.0f + .5f;
+	const float c = float(std::sin(elapsedTime) / 2.0 + .5);
 
-	Graphics& gfx = window.Gfx();
-	gfx.ClearBuffer(c, c, 1.0f); // White to blue
+	snapshot.frameIndex = frameIndex++;
+	snapshot.dt = clock.GetFrameSeconds();
+	snapshot.alpha = clock.GetAlpha();
+	snapshot.elapsedTime = elapsedTime;
+	snapshot.clearColor[0] = c;
+	snapshot.clearColor[1] = c;
+	snapshot.clearColor[2] = 1.0f; // White to blue
+	timings.Set(StageTimings::Stage::Simulate, stage.Mark());
+}
+
+void App::Step(float /*dt*/)
+{
+	// game state advances here in fixed increments of dt, systems query
+	// world and record structural changes for after the step
+}
+
+void App::Render(const FrameSnapshot& snapshot)
+{
+	O_PROFILE_FUNCTION();
+	OTimer stage;
+	RenderBackend& gfx = pPlatform->GetRenderer();
+	gfx.BeginFrame(snapshot.clearColor[0], snapshot.clearColor[1], snapshot.clearColor[2]);
+	// whatever finished loading, up to the per frame upload budget
+	streamer.Pump();
+	timings.Set(StageTimings::Stage::Render, stage.Mark());
 
 	// End graphics frame;
 	gfx.EndFrame();
+	timings.Set(StageTimings::Stage::Present, stage.Mark());
 }
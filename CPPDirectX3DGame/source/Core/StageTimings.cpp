@@ -0,0 +1,38 @@
+#include "Core/StageTimings.h"
+
+StageTimings::StageTimings() noexcept
+{
+	for (auto& t : times)
+	{
+		t.store(0.0f, std::memory_order_relaxed);
+	}
+}
+
+void StageTimings::Set(Stage stage, float seconds) noexcept
+{
+	times[size_t(stage)].store(seconds, std::memory_order_relaxed);
+}
+
+float StageTimings::Get(Stage stage) const noexcept
+{
+	return times[size_t(stage)].load(std::memory_order_relaxed);
+}
+
+const char* StageTimings::GetName(Stage stage) noexcept
+{
+	switch (stage)
+	{
+	case Stage::Messages:
+		return "Messages";
+	case Stage::Input:
+		return "Input";
+	case Stage::Simulate:
+		return "Simulate";
+	case Stage::Render:
+		return "Render";
+	case Stage::Present:
+		return "Present";
+	default:
+		return "Unknown";
+	}
+}
@@ -3,8 +3,8 @@
 #include "Window/WindowThrowMacros.h"
 #include "Render/Graphics.h"
 #include "Render/GraphicsThrowMacros.h"
+#include "Memory/Scratch.h"
 #include <dxgidebug.h>
-#include <memory>
 
 #pragma comment(lib, "dxguid.lib")
 
@@ -50,9 +50,9 @@ std::vector<std::string> DxgiInfoManager::GetMessages() const
 		SIZE_T messageLength;
 		// get the size of message i in bytes
 		GFX_THROW_NOINFO(pDxgiInfoQueue->GetMessage(DXGI_DEBUG_ALL, i, nullptr, &messageLength));
-		// allocate memory for message
-		auto bytes = std::make_unique<byte[]>(messageLength);
-		auto pMessage = reinterpret_cast<DXGI_INFO_QUEUE_MESSAGE*>(bytes.get());
+		// the message only lives until its description is copied out
+		Memory::Scratch scratch;
+		auto pMessage = static_cast<DXGI_INFO_QUEUE_MESSAGE*>(scratch.Allocate(messageLength, alignof(DXGI_INFO_QUEUE_MESSAGE)));
 		// get the message and push its description into the vector
 		GFX_THROW_NOINFO(pDxgiInfoQueue->GetMessage(DXGI_DEBUG_ALL, i, pMessage, &messageLength));
 		messages.emplace_back(pMessage->pDescription);
@@ -0,0 +1,170 @@
+#include "Ecs/Archetype.h"
+#include <cstring>
+#include <new>
+
+namespace
+{
+	size_t AlignUp(size_t value, size_t align) noexcept
+	{
+		return (value + align - 1u) & ~(align - 1u);
+	}
+}
+
+namespace Ecs
+{
+	Archetype::Archetype(ComponentMask mask)
+		:
+		mask(mask)
+	{
+		columnOf.fill(-1);
+		addEdges.fill(-1);
+		removeEdges.fill(-1);
+		size_t rowBytes = sizeof(Entity);
+		for (ComponentId id = 0u; id < maxComponents; id++)
+		{
+			if (mask & (ComponentMask(1u) << id))
+			{
+				columnOf[id] = static_cast<int8_t>(columns.size());
+				columns.push_back({ id, 0u, GetComponentInfo(id).size });
+				rowBytes += GetComponentInfo(id).size;
+			}
+		}
+
+		// the entity array and every column start on their own cache line
+		const size_t padding = columnAlign * (columns.size() + 1u);
+		capacity = static_cast<uint32_t>((chunkBytes - padding) / rowBytes);
+		if (capacity == 0u)
+		{
+			capacity = 1u;
+		}
+		size_t offset = AlignUp(sizeof(Entity) * capacity, columnAlign);
+		for (Column& column : columns)
+		{
+			column.offset = offset;
+			offset = AlignUp(offset + column.size * capacity, columnAlign);
+		}
+	}
+
+	Archetype::~Archetype()
+	{
+		for (std::byte* chunk : chunks)
+		{
+			::operator delete(chunk, std::align_val_t(columnAlign));
+		}
+	}
+
+	ComponentMask Archetype::GetMask() const noexcept
+	{
+		return mask;
+	}
+
+	bool Archetype::Has(ComponentId id) const noexcept
+	{
+		return columnOf[id] >= 0;
+	}
+
+	uint32_t Archetype::GetCapacity() const noexcept
+	{
+		return capacity;
+	}
+
+	size_t Archetype::GetEntityCount() const noexcept
+	{
+		return count;
+	}
+
+	size_t Archetype::GetChunkCount() const noexcept
+	{
+		return (count + capacity - 1u) / capacity;
+	}
+
+	uint32_t Archetype::GetChunkSize(size_t chunk) const noexcept
+	{
+		const size_t first = chunk * capacity;
+		return count - first >= capacity ? capacity : static_cast<uint32_t>(count - first);
+	}
+
+	Entity* Archetype::GetEntities(size_t chunk) noexcept
+	{
+		return reinterpret_cast<Entity*>(chunks[chunk]);
+	}
+
+	void* Archetype::GetColumn(size_t chunk, ComponentId id) noexcept
+	{
+		const int column = columnOf[id];
+		return column < 0 ? nullptr : chunks[chunk] + columns[column].offset;
+	}
+
+	Archetype::Slot Archetype::Append(Entity entity)
+	{
+		const Slot slot = { static_cast<uint32_t>(count / capacity), static_cast<uint32_t>(count % capacity) };
+		// emptied chunks are kept around, only allocate past the last one
+		if (slot.chunk == chunks.size())
+		{
+			const size_t bytes = columns.empty() ? sizeof(Entity) * capacity : columns.back().offset + columns.back().size * capacity;
+			chunks.push_back(static_cast<std::byte*>(::operator new(bytes, std::align_val_t(columnAlign))));
+		}
+		std::byte* chunk = chunks[slot.chunk];
+		reinterpret_cast<Entity*>(chunk)[slot.row] = entity;
+		for (const Column& column : columns)
+		{
+			std::memset(chunk + column.offset + column.size * slot.row, 0, column.size);
+		}
+		count++;
+		return slot;
+	}
+
+	Entity Archetype::RemoveSwap(Slot slot) noexcept
+	{
+		count--;
+		const Slot last = { static_cast<uint32_t>(count / capacity), static_cast<uint32_t>(count % capacity) };
+		if (last.chunk == slot.chunk && last.row == slot.row)
+		{
+			return {};
+		}
+		std::byte* to = chunks[slot.chunk];
+		const std::byte* from = chunks[last.chunk];
+		const Entity moved = reinterpret_cast<const Entity*>(from)[last.row];
+		reinterpret_cast<Entity*>(to)[slot.row] = moved;
+		for (const Column& column : columns)
+		{
+			std::memcpy(to + column.offset + column.size * slot.row, from + column.offset + column.size * last.row, column.size);
+		}
+		return moved;
+	}
+
+	void Archetype::CopyRow(Archetype& from, Slot fromSlot, Archetype& to, Slot toSlot) noexcept
+	{
+		const std::byte* src = from.chunks[fromSlot.chunk];
+		std::byte* dst = to.chunks[toSlot.chunk];
+		for (const Column& column : from.columns)
+		{
+			const int other = to.columnOf[column.id];
+			if (other >= 0)
+			{
+				std::memcpy(dst + to.columns[other].offset + column.size * toSlot.row,
+					src + column.offset + column.size * fromSlot.row, column.size);
+			}
+		}
+	}
+
+	int32_t Archetype::GetAddEdge(ComponentId id) const noexcept
+	{
+		return addEdges[id];
+	}
+
+	int32_t Archetype::GetRemoveEdge(ComponentId id) const noexcept
+	{
+		return removeEdges[id];
+	}
+
+	void Archetype::SetAddEdge(ComponentId id, int32_t archetype) noexcept
+	{
+		addEdges[id] = archetype;
+	}
+
+	void Archetype::SetRemoveEdge(ComponentId id, int32_t archetype) noexcept
+	{
+		removeEdges[id] = archetype;
+	}
+}
@@ -0,0 +1,75 @@
+#include "Ecs/EntityCommandBuffer.h"
+#include "Profile/Profiler.h"
+#include <cstring>
+
+namespace Ecs
+{
+	void EntityCommandBuffer::Destroy(Entity entity)
+	{
+		Record(Op::Destroy, entity, 0u, 0u, nullptr, 0u);
+	}
+
+	void EntityCommandBuffer::Playback(World& world)
+	{
+		O_PROFILE_FUNCTION();
+		Entity created;
+		for (const Command& c : commands)
+		{
+			switch (c.op)
+			{
+			case Op::Create:
+				created = world.CreateWithMask(c.mask);
+				break;
+			case Op::SetCreated:
+				std::memcpy(world.GetRaw(created, c.id), data.data() + c.offset, GetComponentInfo(c.id).size);
+				break;
+			case Op::Destroy:
+				if (world.IsAlive(c.entity))
+				{
+					world.Destroy(c.entity);
+				}
+				break;
+			case Op::Add:
+				if (world.IsAlive(c.entity))
+				{
+					world.AddRaw(c.entity, c.id, data.data() + c.offset);
+				}
+				break;
+			case Op::Remove:
+				if (world.IsAlive(c.entity))
+				{
+					world.RemoveRaw(c.entity, c.id);
+				}
+				break;
+			}
+		}
+		Clear();
+	}
+
+	void EntityCommandBuffer::Clear() noexcept
+	{
+		commands.clear();
+		data.clear();
+	}
+
+	size_t EntityCommandBuffer::GetCommandCount() const noexcept
+	{
+		return commands.size();
+	}
+
+	bool EntityCommandBuffer::IsEmpty() const noexcept
+	{
+		return commands.empty();
+	}
+
+	void EntityCommandBuffer::Record(Op op, Entity entity, ComponentId id, ComponentMask mask, const void* pValue, size_t size)
+	{
+		commands.push_back({ op, id, entity, mask, data.size() });
+		if (size > 0u)
+		{
+			const size_t offset = data.size();
+			data.resize(offset + size);
+			std::memcpy(data.data() + offset, pValue, size);
+		}
+	}
+}
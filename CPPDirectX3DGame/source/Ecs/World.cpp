@@ -0,0 +1,293 @@
+#include "Ecs/World.h"
+#include "Job/JobSystem.h"
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+
+#define ECS_EXCEPT(note) World::Exception(__LINE__, __FILE__, (note))
+
+namespace
+{
+	struct Registry
+	{
+		std::mutex mtx;
+		std::array<Ecs::ComponentInfo, Ecs::maxComponents> infos = {};
+		Ecs::ComponentId count = 0u;
+	};
+
+	Registry& GetRegistry()
+	{
+		static Registry registry;
+		return registry;
+	}
+}
+
+namespace Ecs
+{
+	ComponentId RegisterComponent(size_t size, size_t align, const char* name)
+	{
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.mtx);
+		if (registry.count == maxComponents)
+		{
+			throw ECS_EXCEPT(std::string("Too many component types, cannot register ") + name);
+		}
+		if (align > Archetype::columnAlign)
+		{
+			throw ECS_EXCEPT(std::string("Component alignment above 64 bytes is not supported: ") + name);
+		}
+		registry.infos[registry.count] = { size, align, name };
+		return registry.count++;
+	}
+
+	const ComponentInfo& GetComponentInfo(ComponentId id) noexcept
+	{
+		// entries never change once their id was handed out
+		return GetRegistry().infos[id];
+	}
+
+	World::World(JobSystem* pJobs)
+		:
+		pJobs(pJobs)
+	{
+		// archetype 0 holds entities without components
+		GetOrCreateArchetype(0u);
+	}
+
+	World::~World() = default;
+
+	void World::Destroy(Entity entity)
+	{
+		CheckStructural();
+		const Record& record = GetRecord(entity);
+		Archetype& archetype = *archetypes[record.archetype];
+		const Entity moved = archetype.RemoveSwap(record.slot);
+		if (!moved.IsNull())
+		{
+			records[moved.index].slot = record.slot;
+		}
+		Record& dead = records[entity.index];
+		dead.generation++;
+		dead.archetype = -1;
+		freeIndices.push_back(entity.index);
+		entityCount--;
+	}
+
+	bool World::IsAlive(Entity entity) const noexcept
+	{
+		return entity.index < records.size() &&
+			records[entity.index].generation == entity.generation &&
+			records[entity.index].archetype >= 0;
+	}
+
+	Entity World::CreateWithMask(ComponentMask mask)
+	{
+		CheckStructural();
+		const int32_t target = GetOrCreateArchetype(mask);
+		Entity entity;
+		if (freeIndices.empty())
+		{
+			entity.index = static_cast<uint32_t>(records.size());
+			records.emplace_back();
+		}
+		else
+		{
+			entity.index = freeIndices.back();
+			freeIndices.pop_back();
+		}
+		Record& record = records[entity.index];
+		entity.generation = record.generation;
+		record.archetype = target;
+		record.slot = archetypes[target]->Append(entity);
+		entityCount++;
+		return entity;
+	}
+
+	void World::AddRaw(Entity entity, ComponentId id, const void* pValue)
+	{
+		CheckStructural();
+		const Record& record = GetRecord(entity);
+		Archetype& from = *archetypes[record.archetype];
+		if (!from.Has(id))
+		{
+			int32_t target = from.GetAddEdge(id);
+			if (target < 0)
+			{
+				target = GetOrCreateArchetype(from.GetMask() | (ComponentMask(1u) << id));
+				from.SetAddEdge(id, target);
+				archetypes[target]->SetRemoveEdge(id, record.archetype);
+			}
+			MoveEntity(entity, target);
+		}
+		std::memcpy(GetRaw(entity, id), pValue, GetComponentInfo(id).size);
+	}
+
+	void World::RemoveRaw(Entity entity, ComponentId id)
+	{
+		CheckStructural();
+		const Record& record = GetRecord(entity);
+		Archetype& from = *archetypes[record.archetype];
+		if (!from.Has(id))
+		{
+			return;
+		}
+		int32_t target = from.GetRemoveEdge(id);
+		if (target < 0)
+		{
+			target = GetOrCreateArchetype(from.GetMask() & ~(ComponentMask(1u) << id));
+			from.SetRemoveEdge(id, target);
+			archetypes[target]->SetAddEdge(id, record.archetype);
+		}
+		MoveEntity(entity, target);
+	}
+
+	void* World::GetRaw(Entity entity, ComponentId id)
+	{
+		const Record& record = GetRecord(entity);
+		void* pColumn = archetypes[record.archetype]->GetColumn(record.slot.chunk, id);
+		if (!pColumn)
+		{
+			throw ECS_EXCEPT(std::string("Entity has no ") + GetComponentInfo(id).name);
+		}
+		return static_cast<std::byte*>(pColumn) + GetComponentInfo(id).size * record.slot.row;
+	}
+
+	size_t World::GetEntityCount() const noexcept
+	{
+		return entityCount;
+	}
+
+	size_t World::GetArchetypeCount() const noexcept
+	{
+		return archetypes.size();
+	}
+
+	Archetype& World::GetArchetype(size_t index) noexcept
+	{
+		return *archetypes[index];
+	}
+
+	bool World::IsIterating() const noexcept
+	{
+		return iterating.load(std::memory_order_relaxed) > 0;
+	}
+
+	unsigned int World::GetWorkerCount() const noexcept
+	{
+		return pJobs ? pJobs->GetThreadCount() : 1u;
+	}
+
+	void World::ParallelFor(size_t count, void(*fn)(void*, size_t, unsigned int), void* context)
+	{
+		if (!pJobs)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				fn(context, i, 0u);
+			}
+			return;
+		}
+		JobSystem& jobs = *pJobs;
+		jobs.ParallelFor(count, [&jobs, fn, context](size_t begin, size_t end)
+		{
+			const unsigned int worker = jobs.GetThreadIndex();
+			for (size_t i = begin; i < end; i++)
+			{
+				fn(context, i, worker);
+			}
+		});
+	}
+
+	const World::Record& World::GetRecord(Entity entity) const
+	{
+		if (!IsAlive(entity))
+		{
+			throw ECS_EXCEPT("Entity " + std::to_string(entity.index) + ":" + std::to_string(entity.generation) + " is not alive");
+		}
+		return records[entity.index];
+	}
+
+	const Archetype& World::GetArchetypeOf(Entity entity) const
+	{
+		return *archetypes[GetRecord(entity).archetype];
+	}
+
+	int32_t World::GetOrCreateArchetype(ComponentMask mask)
+	{
+		const auto it = archetypeOf.find(mask);
+		if (it != archetypeOf.end())
+		{
+			return it->second;
+		}
+		const int32_t index = static_cast<int32_t>(archetypes.size());
+		archetypes.push_back(std::make_unique<Archetype>(mask));
+		archetypeOf.emplace(mask, index);
+		return index;
+	}
+
+	void World::CheckStructural() const
+	{
+		if (IsIterating())
+		{
+			throw ECS_EXCEPT("Structural change while a query is iterating, record it in an EntityCommandBuffer instead");
+		}
+	}
+
+	void World::MoveEntity(Entity entity, int32_t target)
+	{
+		Record& record = records[entity.index];
+		Archetype& from = *archetypes[record.archetype];
+		Archetype& to = *archetypes[target];
+		const Archetype::Slot slot = to.Append(entity);
+		Archetype::CopyRow(from, record.slot, to, slot);
+		const Entity moved = from.RemoveSwap(record.slot);
+		if (!moved.IsNull())
+		{
+			records[moved.index].slot = record.slot;
+		}
+		record.archetype = target;
+		record.slot = slot;
+	}
+
+	// Iteration scope
+	World::IterationScope::IterationScope(World& world) noexcept
+		:
+		world(world)
+	{
+		world.iterating.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	World::IterationScope::~IterationScope()
+	{
+		world.iterating.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	// World exception
+	World::Exception::Exception(int line, const char* file, std::string note) noexcept
+		:
+		OException(line, file),
+		note(std::move(note))
+	{
+	}
+
+	const char* World::Exception::what() const noexcept
+	{
+		std::ostringstream oss;
+		oss << GetType() << std::endl
+			<< "[Note] " << GetNote() << std::endl
+			<< GetOriginString();
+		whatBuffer = oss.str();
+		return whatBuffer.c_str();
+	}
+
+	const char* World::Exception::GetType() const noexcept
+	{
+		return "O ECS World Exception";
+	}
+
+	const std::string& World::Exception::GetNote() const noexcept
+	{
+		return note;
+	}
+}
@@ -0,0 +1,204 @@
+#include "Headless/HeadlessModes.h"
+#include "Render/Command/CommandBuffer.h"
+#include "Render/Command/RecordingContext.h"
+#include <array>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Slot = RenderContext::Slot;
+	using Call = RecordingContext::Call;
+	using Headless::Checker;
+	constexpr auto Fake = &RecordingContext::Fake;
+
+	// A bind of what the slot already holds never reaches the context,
+	// a different bindable or an invalidated cache does.
+	void CheckStateCache(Checker& checker)
+	{
+		RecordingContext context;
+		StateCache cache;
+		cache.Bind(context, Slot::VertexShader, Fake(1u));
+		cache.Bind(context, Slot::VertexShader, Fake(1u));
+		cache.Bind(context, Slot::PixelShader, Fake(1u));
+		checker.Expect(context.GetStateCalls(Slot::VertexShader) == 1u, "state cache", "a repeated bind reached the context");
+		checker.Expect(context.GetStateCalls(Slot::PixelShader) == 1u, "state cache", "the same bindable in another slot was skipped");
+		cache.Bind(context, Slot::VertexShader, Fake(2u));
+		checker.Expect(context.GetStateCalls(Slot::VertexShader) == 2u, "state cache", "a changed bind was skipped");
+		cache.Invalidate();
+		cache.Bind(context, Slot::VertexShader, Fake(2u));
+		checker.Expect(context.GetStateCalls(Slot::VertexShader) == 3u, "state cache", "a bind after Invalidate was skipped");
+		const StateCache::Stats stats = cache.GetStats();
+		checker.Expect(stats.bindsIssued == 4u && stats.bindsSkipped == 1u, "state cache", "stats do not match the binds");
+		cache.ResetStats();
+		cache.Bind(context, Slot::VertexShader, Fake(2u));
+		checker.Expect(cache.GetStats().bindsIssued == 0u && cache.GetStats().bindsSkipped == 1u,
+			"state cache", "ResetStats forgot the bound state or kept the counts");
+	}
+
+	// A scene of random packets submitted out of order, with state drawn from
+	// small pools so neighbours after sorting share most of it.
+	std::vector<DrawPacket> MakePackets(size_t count)
+	{
+		std::mt19937 rng(23u);
+		std::vector<DrawPacket> packets(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			DrawPacket& packet = packets[i];
+			const unsigned int pass = rng() % 3u;
+			const unsigned int shader = rng() % 4u;
+			const unsigned int material = rng() % 16u;
+			// coarse depths so equal keys happen and stability is exercised
+			packet.key = SortKey::Make(pass, shader, material, float(rng() % 8u) / 8.0f, pass == 2u);
+			packet.Set(Slot::VertexShader, Fake(100u + shader));
+			packet.Set(Slot::PixelShader, Fake(200u + shader));
+			packet.Set(Slot::PixelConstants, Fake(300u + material));
+			packet.Set(Slot::Blend, Fake(400u + pass));
+			// some packets leave the mesh slots as the one before left them
+			if (rng() % 4u != 0u)
+			{
+				const unsigned int mesh = rng() % 8u;
+				packet.Set(Slot::VertexBuffer, Fake(500u + mesh));
+				packet.Set(Slot::IndexBuffer, Fake(600u + mesh));
+			}
+			packet.indexCount = 36u;
+			// the submission order, to check the sort is stable
+			packet.startIndex = static_cast<unsigned int>(i);
+			packet.instanceCount = rng() % 5u == 0u ? 1u + rng() % 16u : 0u;
+		}
+		return packets;
+	}
+
+	// The calls a replay of sorted packets has to issue: every slot whose
+	// bindable differs from what the previous packets left, then the draw.
+	std::vector<Call> ExpectedCalls(const CommandBuffer& commands)
+	{
+		std::vector<Call> calls;
+		std::array<Bind::Bindable*, RenderContext::nSlots> bound = {};
+		for (size_t i = 0; i < commands.GetSize(); i++)
+		{
+			const DrawPacket& packet = commands.GetPacket(i);
+			for (size_t s = 0; s < RenderContext::nSlots; s++)
+			{
+				if (packet.state[s] != nullptr && packet.state[s] != bound[s])
+				{
+					bound[s] = packet.state[s];
+					Call bind = {};
+					bind.type = Call::Type::SetState;
+					bind.slot = Slot(s);
+					bind.pBindable = packet.state[s];
+					calls.push_back(bind);
+				}
+			}
+			Call draw = {};
+			draw.type = packet.instanceCount > 0u ? Call::Type::DrawIndexedInstanced : Call::Type::DrawIndexed;
+			draw.indexCount = packet.indexCount;
+			draw.startIndex = packet.startIndex;
+			draw.baseVertex = packet.baseVertex;
+			draw.instanceCount = packet.instanceCount;
+			draw.startInstance = packet.startInstance;
+			calls.push_back(draw);
+		}
+		return calls;
+	}
+
+	bool SameCalls(const std::vector<Call>& a, const std::vector<Call>& b) noexcept
+	{
+		if (a.size() != b.size())
+		{
+			return false;
+		}
+		for (size_t i = 0; i < a.size(); i++)
+		{
+			const bool same = a[i].type == b[i].type && (a[i].type == Call::Type::SetState ?
+				a[i].slot == b[i].slot && a[i].pBindable == b[i].pBindable :
+				a[i].indexCount == b[i].indexCount && a[i].startIndex == b[i].startIndex &&
+				a[i].baseVertex == b[i].baseVertex && a[i].instanceCount == b[i].instanceCount &&
+				a[i].startInstance == b[i].startInstance);
+			if (!same)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Sorts and replays the scene onto a recording context and compares the
+	// calls with what a plain diff of the sorted packets predicts.
+	void CheckReplay(size_t count, Checker& checker)
+	{
+		const std::vector<DrawPacket> packets = MakePackets(count);
+		CommandBuffer commands;
+		for (const DrawPacket& packet : packets)
+		{
+			commands.Submit(packet);
+		}
+		commands.Sort();
+		bool sorted = commands.GetSize() == count;
+		for (size_t i = 1; sorted && i < commands.GetSize(); i++)
+		{
+			const DrawPacket& a = commands.GetPacket(i - 1u);
+			const DrawPacket& b = commands.GetPacket(i);
+			sorted = a.key < b.key || (a.key == b.key && a.startIndex < b.startIndex);
+		}
+		checker.Expect(sorted, "replay", "packets not in stable key order");
+
+		RecordingContext context;
+		StateCache cache;
+		commands.Execute(context, cache);
+		const std::vector<Call> expected = ExpectedCalls(commands);
+		checker.Expect(SameCalls(context.GetCalls(), expected), "replay", "issued calls differ from the sorted packets' state changes");
+
+		size_t binds = 0u;
+		size_t instanced = 0u;
+		size_t objects = 0u;
+		for (const DrawPacket& packet : packets)
+		{
+			for (const Bind::Bindable* pBindable : packet.state)
+			{
+				binds += pBindable != nullptr ? 1u : 0u;
+			}
+			instanced += packet.instanceCount > 0u ? 1u : 0u;
+			objects += packet.instanceCount > 0u ? packet.instanceCount : 1u;
+		}
+		const StateCache::Stats stats = cache.GetStats();
+		checker.Expect(stats.bindsIssued == context.GetStateCalls(), "replay", "issued binds do not match the context");
+		checker.Expect(stats.bindsIssued + stats.bindsSkipped == binds, "replay", "not every bind went through the cache");
+		checker.Expect(stats.draws == count && context.GetDrawCalls() == count, "replay", "not one draw per packet");
+		checker.Expect(context.GetInstancedDrawCalls() == instanced && context.GetDrawnObjects() == objects,
+			"replay", "instanced draws or drawn objects wrong");
+		// sorting is the point, a scene this size has to save most binds
+		checker.Expect(count < 64u || stats.bindsSkipped > stats.bindsIssued, "replay", "sorted replay skipped fewer binds than it issued");
+
+		// an invalidated cache replays the frame exactly as a fresh one did
+		context.Reset();
+		cache.Invalidate();
+		commands.Execute(context, cache);
+		checker.Expect(SameCalls(context.GetCalls(), expected), "replay", "replay after Invalidate differs from the first");
+
+		commands.Reset();
+		context.Reset();
+		commands.Execute(context, cache);
+		checker.Expect(commands.GetSize() == 0u && context.GetCalls().empty(), "replay", "Reset left packets behind");
+	}
+
+	// Runs StateCache and CommandBuffer against RecordingContext and checks
+	// every call they issue.
+	int RunCommandChecks(size_t count)
+	{
+		Checker checker("commands");
+		CheckStateCache(checker);
+		CheckReplay(count, checker);
+		std::printf("commands: %zu packets, %d failed checks\n", count, checker.GetFailures());
+		return checker.GetResult();
+	}
+}
+
+namespace Headless
+{
+	int RunCommands(const char* draws, const Options& /*options*/)
+	{
+		return RunCommandChecks(ParseCount(draws));
+	}
+}
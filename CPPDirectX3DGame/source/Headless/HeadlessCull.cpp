@@ -0,0 +1,108 @@
+#include "Headless/HeadlessModes.h"
+#include "Render/Cull/DynamicBvh.h"
+#include "Time/OTimer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Headless::Checker;
+
+	// Culls a synthetic scene of boxes spread over a 2km square for the
+	// given number of frames, the camera turning a degree per frame and a
+	// tenth of the objects moving, then prints the averaged cull stats.
+	// Every frame the tree has to validate after the moves and its visible
+	// set has to be the one testing every box against the frustum finds;
+	// halfway through the tree is rebuilt, which must not change either.
+	int RunCullScene(size_t objects, uint64_t frames)
+	{
+		using namespace OMath;
+		const XMFLOAT3 extents = { 1.0f, 2.0f, 1.0f };
+		Checker checker("cull");
+		DynamicBvh bvh;
+		std::vector<DynamicBvh::ProxyId> proxies;
+		std::vector<XMFLOAT3> centers;
+		std::vector<uint32_t> visible;
+		std::mt19937 rng(1u);
+		std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+		std::uniform_real_distribution<float> step(-0.3f, 0.3f);
+		OTimer build;
+		for (size_t i = 0; i < objects; i++)
+		{
+			centers.push_back({ position(rng), 10.0f, position(rng) });
+			proxies.push_back(bvh.Insert(Aabb::FromCenterExtents(centers.back(), extents), uint32_t(i)));
+		}
+		const float buildSeconds = build.Mark();
+
+		const XMMATRIX projection = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.5f, 600.0f);
+		DynamicBvh::CullStats total;
+		size_t refits = 0u;
+		std::vector<uint32_t> expected;
+		size_t invalidFrames = 0u;
+		size_t wrongFrames = 0u;
+		double bruteSeconds = 0.0;
+		for (uint64_t frame = 0; frame < frames; frame++)
+		{
+			for (size_t i = frame % 10u; i < objects; i += 10u)
+			{
+				centers[i].x += step(rng);
+				centers[i].z += step(rng);
+				refits += bvh.Move(proxies[i], Aabb::FromCenterExtents(centers[i], extents)) ? 1u : 0u;
+			}
+			if (frame == frames / 2u)
+			{
+				bvh.Rebuild();
+			}
+			invalidFrames += bvh.Validate() ? 0u : 1u;
+			const float yaw = float(frame % 360u) * (XM_2PI / 360.0f);
+			const XMMATRIX view = XMMatrixLookToLH(
+				XMVectorSet(0.0f, 20.0f, 0.0f, 1.0f), XMVectorSet(std::sin(yaw), -0.1f, std::cos(yaw), 0.0f),
+				XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+			const Frustum frustum(view * projection);
+			bvh.Cull(frustum, visible);
+			OTimer brute;
+			expected.clear();
+			for (size_t i = 0; i < objects; i++)
+			{
+				if (frustum.IsVisible(Aabb::FromCenterExtents(centers[i], extents)))
+				{
+					expected.push_back(uint32_t(i));
+				}
+			}
+			bruteSeconds += brute.Mark();
+			// the tree hands them out in its own order
+			std::sort(visible.begin(), visible.end());
+			wrongFrames += visible == expected ? 0u : 1u;
+			const DynamicBvh::CullStats& stats = bvh.GetCullStats();
+			total.visible += stats.visible;
+			total.culled += stats.culled;
+			total.nodesTested += stats.nodesTested;
+			total.leavesTested += stats.leavesTested;
+			total.acceptedWhole += stats.acceptedWhole;
+			total.seconds += stats.seconds;
+		}
+
+		const double n = frames > 0u ? double(frames) : 1.0;
+		std::printf("cull %zu objects, built in %.3fs, height %d, area ratio %.1f\n",
+			objects, buildSeconds, bvh.GetHeight(), bvh.GetAreaRatio());
+		std::printf("per frame over %llu frames: visible %.0f culled %.0f nodes %.0f leaves %.0f accepted whole %.0f refits %.0f, %.3fms\n",
+			static_cast<unsigned long long>(frames), double(total.visible) / n, double(total.culled) / n,
+			double(total.nodesTested) / n, double(total.leavesTested) / n, double(total.acceptedWhole) / n,
+			double(refits) / n, total.seconds * 1000.0 / n);
+		std::printf("testing every box: %.3fms per frame\n", bruteSeconds * 1000.0 / n);
+		checker.Expect(invalidFrames == 0u, "tree", "the tree did not validate after moving objects");
+		checker.Expect(wrongFrames == 0u, "visible", "the tree's visible set differs from testing every box");
+		return checker.GetResult();
+	}
+}
+
+namespace Headless
+{
+	int RunCull(const char* objects, const Options& options)
+	{
+		return RunCullScene(ParseCount(objects), options.frames);
+	}
+}
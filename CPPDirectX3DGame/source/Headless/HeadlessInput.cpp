@@ -0,0 +1,630 @@
+#include "Headless/HeadlessModes.h"
+#include "Core/App.h"
+#include "Input/InputRecorder.h"
+#include "Input/InputReplay.h"
+#include "Input/Keyboard.h"
+#include "Input/Mouse.h"
+#include "Input/RawDeltaAccumulator.h"
+#include "Platform/HeadlessPlatform.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using Type = InputRecorder::Type;
+	using Headless::Checker;
+
+	constexpr double frameSeconds = 1.0 / 50.0;
+
+	// one event of the synthetic script, in the frame it arrives in
+	struct Scripted
+	{
+		Type type;
+		uint64_t frame;
+		// since the first event
+		OTimer::Ticks time;
+		int a;
+		int b;
+	};
+
+	// what the devices hand out, one entry per event read, per frame of raw
+	// deltas and per frame's key state
+	struct Seen
+	{
+		enum class Device
+		{
+			Key,
+			Char,
+			Mouse,
+			Raw,
+			KeyState,
+		};
+		bool operator==(const Seen& other) const noexcept
+		{
+			return frame == other.frame && device == other.device && kind == other.kind &&
+				a == other.a && b == other.b && time == other.time;
+		}
+		uint64_t frame;
+		Device device;
+		int kind;
+		int a;
+		int b;
+		// relative to the first event, 0 where the device keeps none
+		OTimer::Ticks time;
+	};
+
+	// Random keys, characters, mouse moves (negative ones too, a captured
+	// mouse leaves the window), buttons, wheel turns and raw deltas, a few a
+	// frame with gaps of up to 2 frames. The first is a key press on frame 0
+	// so every timestamp can be taken relative to it.
+	std::vector<Scripted> MakeScript(size_t count)
+	{
+		std::mt19937 rng(11u);
+		std::vector<Scripted> script;
+		uint64_t frame = 0u;
+		OTimer::Ticks time = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			const Type type = i == 0u ? Type::KeyPress : Type(rng() % uint32_t(Type::Count));
+			int a = 0;
+			int b = 0;
+			switch (type)
+			{
+			case Type::KeyPress:
+			case Type::KeyRelease:
+				a = int(rng() % 256u);
+				break;
+			case Type::Char:
+				a = int(32u + rng() % 95u);
+				break;
+			case Type::Wheel:
+				a = int(rng() % 481u) - 240;
+				break;
+			case Type::RawDelta:
+				a = int(rng() % 201u) - 100;
+				b = int(rng() % 201u) - 100;
+				break;
+			default:
+				a = int(rng() % 1100u) - 50;
+				b = int(rng() % 800u) - 50;
+				break;
+			}
+			if (i > 0u && rng() % 4u == 0u)
+			{
+				frame += 1u + rng() % 2u;
+			}
+			time += OTimer::Ticks(1 + rng() % 4000000u);
+			script.push_back({ type, frame, i == 0u ? 0 : time, a, b });
+		}
+		return script;
+	}
+
+	// What the devices have to hand out for the script when drained after
+	// every frame: key events and characters as they came, mouse events with
+	// a run of moves folded into its last one, wheel turns as one event per
+	// 120 and raw deltas summed per frame.
+	std::vector<Seen> Expect(const std::vector<Scripted>& script)
+	{
+		using Device = Seen::Device;
+		std::vector<Seen> seen;
+		int x = 0;
+		int y = 0;
+		bool left = false;
+		bool right = false;
+		int carry = 0;
+		std::array<bool, 256> keys = {};
+		size_t i = 0u;
+		const uint64_t lastFrame = script.empty() ? 0u : script.back().frame;
+		for (uint64_t frame = 0u; frame <= lastFrame; frame++)
+		{
+			std::vector<Seen> keyEvents;
+			std::vector<Seen> chars;
+			std::vector<Seen> mouseEvents;
+			bool pendingMove = false;
+			Seen move = {};
+			bool raw = false;
+			Seen rawSum = { frame, Device::Raw, 0, 0, 0, 0 };
+			const auto mouse = [&](Mouse::Event::Type kind, OTimer::Ticks t)
+			{
+				if (pendingMove)
+				{
+					mouseEvents.push_back(move);
+					pendingMove = false;
+				}
+				const int buttons = (left ? 1 : 0) | (right ? 2 : 0);
+				mouseEvents.push_back({ frame, Device::Mouse, int(kind) * 4 + buttons, x, y, t });
+			};
+			for (; i < script.size() && script[i].frame == frame; i++)
+			{
+				const Scripted& e = script[i];
+				switch (e.type)
+				{
+				case Type::KeyPress:
+				case Type::KeyRelease:
+					keys[size_t(e.a)] = e.type == Type::KeyPress;
+					keyEvents.push_back({ frame, Device::Key, e.type == Type::KeyPress ? 0 : 1, e.a, 0, e.time });
+					break;
+				case Type::Char:
+					chars.push_back({ frame, Device::Char, 0, e.a, 0, e.time });
+					break;
+				case Type::KeyClear:
+					keys = {};
+					break;
+				case Type::MouseMove:
+					x = e.a;
+					y = e.b;
+					move = { frame, Device::Mouse, int(Mouse::Event::Type::Move) * 4 + (left ? 1 : 0) + (right ? 2 : 0), x, y, e.time };
+					pendingMove = true;
+					break;
+				case Type::MouseEnter:
+					mouse(Mouse::Event::Type::Enter, e.time);
+					break;
+				case Type::MouseLeave:
+					mouse(Mouse::Event::Type::Leave, e.time);
+					break;
+				case Type::LPress:
+				case Type::LRelease:
+					left = e.type == Type::LPress;
+					mouse(left ? Mouse::Event::Type::LPress : Mouse::Event::Type::LRelease, e.time);
+					break;
+				case Type::RPress:
+				case Type::RRelease:
+					right = e.type == Type::RPress;
+					mouse(right ? Mouse::Event::Type::RPress : Mouse::Event::Type::RRelease, e.time);
+					break;
+				case Type::Wheel:
+					for (carry += e.a; carry >= 120; carry -= 120)
+					{
+						mouse(Mouse::Event::Type::WheelUp, e.time);
+					}
+					for (; carry <= -120; carry += 120)
+					{
+						mouse(Mouse::Event::Type::WheelDown, e.time);
+					}
+					break;
+				case Type::RawDelta:
+					raw = true;
+					rawSum.a += e.a;
+					rawSum.b += e.b;
+					rawSum.time = e.time;
+					break;
+				default:
+					break;
+				}
+			}
+			if (pendingMove)
+			{
+				mouseEvents.push_back(move);
+			}
+			seen.insert(seen.end(), keyEvents.begin(), keyEvents.end());
+			seen.insert(seen.end(), chars.begin(), chars.end());
+			seen.insert(seen.end(), mouseEvents.begin(), mouseEvents.end());
+			if (raw)
+			{
+				seen.push_back(rawSum);
+			}
+			for (size_t k = 0; k < keys.size(); k++)
+			{
+				if (keys[k])
+				{
+					seen.push_back({ frame, Device::KeyState, 0, int(k), 0, 0 });
+				}
+			}
+		}
+		return seen;
+	}
+
+	std::vector<uint8_t> Record(const std::vector<Scripted>& script)
+	{
+		InputRecorder recorder(frameSeconds);
+		// at or after the recorder's start, so no stamp is clamped
+		const OTimer::Ticks base = OTimer::Now();
+		for (const Scripted& e : script)
+		{
+			recorder.BeginFrame(e.frame);
+			recorder.Record(e.type, base + e.time, e.a, e.b);
+		}
+		return recorder.GetData();
+	}
+
+	// Replays the stream through App::ReplayInput one frame per Start and
+	// drains the headless platform's devices after each, the way a game
+	// reading input once a frame would.
+	std::vector<Seen> Replay(const std::vector<uint8_t>& data, uint64_t frames, Checker& checker)
+	{
+		using Device = Seen::Device;
+		InputReplay replay(data);
+		auto pPlatform = std::make_unique<HeadlessPlatform>(64, 64);
+		HeadlessPlatform& platform = *pPlatform;
+		App app{ std::move(pPlatform), App::LoopMode::Serial };
+		app.ReplayInput(replay);
+		Keyboard& kbd = platform.GetKeyboard();
+		Mouse& mouse = platform.GetMouse();
+		std::vector<Seen> seen;
+		// the first event is a key press at 0
+		OTimer::Ticks origin = 0;
+		bool hasOrigin = false;
+		const auto since = [&](OTimer::Ticks t)
+		{
+			if (!hasOrigin)
+			{
+				origin = t;
+				hasOrigin = true;
+			}
+			return t - origin;
+		};
+		OTimer::Ticks lastRaw = 0;
+		for (uint64_t frame = 0u; frame < frames; frame++)
+		{
+			app.SetFrameLimit(app.GetFrameCount() + 1u);
+			app.Start();
+			while (const auto e = kbd.ReadKey())
+			{
+				seen.push_back({ frame, Device::Key, e->IsPress() ? 0 : 1, int(e->GetCode()), 0, since(e->GetTimestamp()) });
+			}
+			while (const auto c = kbd.ReadCharEvent())
+			{
+				seen.push_back({ frame, Device::Char, 0, int(static_cast<unsigned char>(c->GetChar())), 0, since(c->GetTimestamp()) });
+			}
+			while (const auto e = mouse.Read())
+			{
+				const int buttons = (e->LeftIsPressed() ? 1 : 0) | (e->RightIsPressed() ? 2 : 0);
+				seen.push_back({ frame, Device::Mouse, int(e->GetType()) * 4 + buttons, e->GetPosX(), e->GetPosY(), since(e->GetTimestamp()) });
+			}
+			// the timestamp moves on only when reports came in
+			const Mouse::RawDelta raw = mouse.ReadRawFrameDelta();
+			if (raw.timestamp != lastRaw)
+			{
+				seen.push_back({ frame, Device::Raw, 0, raw.x, raw.y, since(raw.timestamp) });
+				lastRaw = raw.timestamp;
+			}
+			for (unsigned int k = 0; k < 256u; k++)
+			{
+				if (kbd.IsKeyPressed(static_cast<unsigned char>(k)))
+				{
+					seen.push_back({ frame, Device::KeyState, 0, int(k), 0, 0 });
+				}
+			}
+		}
+		checker.Expect(replay.IsFinished(), "replay", "events left after the last frame");
+		checker.Expect(kbd.GetOverflowCount() == 0u && mouse.GetOverflowCount() == 0u, "replay", "a device overflowed");
+		checker.Expect(app.GetClock().IsDeterministic() && std::abs(app.GetClock().GetFrameSeconds() - float(frameSeconds)) < 1e-6f,
+			"replay", "the clock does not run at the recorded frame time");
+		return seen;
+	}
+
+	// The stream fed to a replay as far as it goes, true if it threw
+	// InputReplay::Exception; anything else thrown counts as not.
+	bool Throws(std::vector<uint8_t> data, size_t& replayed)
+	{
+		replayed = 0u;
+		try
+		{
+			InputReplay replay(std::move(data));
+			Keyboard kbd(4096u);
+			Mouse mouse(4096u);
+			replay.Feed(~uint64_t(0u), kbd, mouse);
+			replayed = replay.GetReplayedCount();
+			return false;
+		}
+		catch (const InputReplay::Exception&)
+		{
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+
+	// Every cut of the stream's first events either ends on an event, and
+	// replays the events before it, or in the middle of one and throws;
+	// damaged headers, unknown types and endless varints throw too.
+	void CheckDamaged(const std::vector<Scripted>& script, Checker& checker)
+	{
+		constexpr size_t maxEvents = 256u;
+		InputRecorder recorder(frameSeconds);
+		std::vector<size_t> ends;
+		for (const Scripted& e : script)
+		{
+			if (ends.size() == maxEvents)
+			{
+				break;
+			}
+			recorder.BeginFrame(e.frame);
+			recorder.Record(e.type, OTimer::Now(), e.a, e.b);
+			ends.push_back(recorder.GetData().size());
+		}
+		const std::vector<uint8_t>& data = recorder.GetData();
+		size_t replayed = 0u;
+		checker.Expect(!Throws(data, replayed) && replayed == ends.size(), "damaged", "the whole stream did not replay");
+		size_t next = 0u;
+		bool cutsOk = true;
+		for (size_t size = InputRecorder::headerSize; size < data.size(); size++)
+		{
+			const bool boundary = size == InputRecorder::headerSize || size == ends[next];
+			next += size == ends[next] ? 1u : 0u;
+			const bool threw = Throws(std::vector<uint8_t>(data.begin(), data.begin() + size), replayed);
+			cutsOk = cutsOk && (boundary ? !threw && replayed == next : threw);
+		}
+		checker.Expect(cutsOk, "damaged", "a truncated stream replayed or a whole one threw");
+
+		// the first size bytes of the stream followed by extra
+		const auto damaged = [&](size_t size, std::initializer_list<uint8_t> extra)
+		{
+			std::vector<uint8_t> bytes(data.begin(), data.begin() + size);
+			bytes.insert(bytes.end(), extra);
+			return bytes;
+		};
+		std::vector<uint8_t> magic = data;
+		magic[0] = uint8_t('X');
+		std::vector<uint8_t> version = data;
+		version[4] = uint8_t(InputRecorder::version + 1u);
+		checker.Expect(Throws(damaged(InputRecorder::headerSize - 1u, {}), replayed), "damaged", "a short header did not throw");
+		checker.Expect(Throws(magic, replayed), "damaged", "a bad magic did not throw");
+		checker.Expect(Throws(version, replayed), "damaged", "an unknown version did not throw");
+		checker.Expect(Throws(damaged(InputRecorder::headerSize, { uint8_t(Type::Count) }), replayed), "damaged",
+			"an unknown first type did not throw");
+		checker.Expect(Throws(damaged(data.size(), { 0xFFu, 0u, 0u }), replayed), "damaged",
+			"an unknown type after the events did not throw");
+		checker.Expect(Throws(damaged(data.size(), { uint8_t(Type::KeyClear), 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+			0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu }), replayed), "damaged", "a varint without an end did not throw");
+	}
+
+	// Per frame sums of raw deltas of either sign, out to the largest a frame
+	// may hold, come back out of the packed sum exactly; samples past the
+	// capacity are counted, and sums taken while another thread adds lose
+	// nothing.
+	void CheckRawDeltas(Checker& checker)
+	{
+		std::mt19937 rng(10u);
+		RawDeltaAccumulator raw(8u);
+		bool sums = true;
+		OTimer::Ticks t = 0;
+		for (int frame = 0; frame < 1000; frame++)
+		{
+			const unsigned int reports = rng() % 8u;
+			int x = 0;
+			int y = 0;
+			for (unsigned int r = 0; r < reports; r++)
+			{
+				const int dx = int(rng() % 20001u) - 10000;
+				const int dy = int(rng() % 20001u) - 10000;
+				raw.Add(dx, dy, ++t);
+				x += dx;
+				y += dy;
+			}
+			const RawDeltaAccumulator::Delta d = raw.Take();
+			sums = sums && d.x == x && d.y == y && d.timestamp == t;
+		}
+		checker.Expect(sums, "raw", "a frame's sum or newest timestamp is wrong");
+		constexpr int most = 0x7FFFFFFF;
+		const std::pair<int, int> extremes[] =
+		{
+			{ -most, most }, { most, -most }, { -most, -most }, { most, most },
+			{ -1, 0 }, { 0, -1 }, { -1, 1 }, { 1, -1 }, { -1, -1 },
+		};
+		bool edges = true;
+		for (const auto& [x, y] : extremes)
+		{
+			// in two reports, so the halves carry into each other
+			raw.Add(x / 2, y / 2);
+			raw.Add(x - x / 2, y - y / 2);
+			const RawDeltaAccumulator::Delta d = raw.Take();
+			edges = edges && d.x == x && d.y == y;
+		}
+		checker.Expect(edges, "raw", "a sum at the edge of the range did not survive the packing");
+		checker.Expect(raw.Take().x == 0 && raw.Take().y == 0, "raw", "a frame without reports is not zero");
+		checker.Expect(!raw.PopSample() && raw.GetOverflowCount() == 0u, "raw", "a sample was kept while samples were off");
+
+		const uint64_t reportsBefore = raw.GetReportCount();
+		raw.EnableSamples();
+		for (int i = 0; i < 20; i++)
+		{
+			raw.Add(i, -i, OTimer::Ticks(i));
+		}
+		bool samples = true;
+		for (int i = 0; i < 8; i++)
+		{
+			const auto sample = raw.PopSample();
+			samples = samples && sample && sample->x == i && sample->y == -i && sample->timestamp == OTimer::Ticks(i);
+		}
+		checker.Expect(samples && !raw.PopSample(), "raw", "samples are not the first ones in order");
+		checker.Expect(raw.GetOverflowCount() == 12u && raw.GetReportCount() == reportsBefore + 20u, "raw",
+			"overflowing samples or reports were miscounted");
+		raw.DisableSamples();
+
+		// a mouse thread reporting while the simulation takes a sum each frame
+		RawDeltaAccumulator shared;
+		std::atomic<bool> done = false;
+		std::thread mouse([&shared, &done]
+		{
+			for (int i = 0; i < 200000; i++)
+			{
+				shared.Add(i % 3 - 1, 1 - i % 5);
+			}
+			done = true;
+		});
+		int64_t x = 0;
+		int64_t y = 0;
+		while (!done)
+		{
+			const RawDeltaAccumulator::Delta d = shared.Take();
+			x += d.x;
+			y += d.y;
+		}
+		mouse.join();
+		const RawDeltaAccumulator::Delta d = shared.Take();
+		x += d.x;
+		y += d.y;
+		int64_t expectedX = 0;
+		int64_t expectedY = 0;
+		for (int i = 0; i < 200000; i++)
+		{
+			expectedX += i % 3 - 1;
+			expectedY += 1 - i % 5;
+		}
+		checker.Expect(x == expectedX && y == expectedY, "raw", "sums taken during reports lost some");
+	}
+
+	// Runs of moves fold into their last move and take one slot, so a ring
+	// of 8 holds 6 buttons with the moves between them, the last run is held
+	// back until read and nothing is rejected. A button is never dropped to
+	// make room for a move.
+	void CheckCoalescing(Checker& checker)
+	{
+		using EventType = Mouse::Event::Type;
+		InputRecorder recorder;
+		const auto moves = [&recorder](int from)
+		{
+			for (int i = from; i < from + 300; i++)
+			{
+				recorder.Record(Type::MouseMove, OTimer::Now(), i, -i);
+			}
+		};
+		recorder.Record(Type::LPress, OTimer::Now(), 0, 0);
+		moves(0);
+		recorder.Record(Type::LRelease, OTimer::Now(), 0, 0);
+		recorder.Record(Type::RPress, OTimer::Now(), 0, 0);
+		moves(300);
+		recorder.Record(Type::RRelease, OTimer::Now(), 0, 0);
+		recorder.Record(Type::MouseEnter, OTimer::Now());
+		recorder.Record(Type::MouseLeave, OTimer::Now());
+		moves(600);
+		InputReplay replay(recorder.GetData());
+		Keyboard kbd;
+		Mouse mouse(8u);
+		replay.Feed(0u, kbd, mouse);
+		const std::pair<EventType, int> expected[] =
+		{
+			{ EventType::LPress, 0 }, { EventType::Move, 299 }, { EventType::LRelease, 299 }, { EventType::RPress, 299 },
+			{ EventType::Move, 599 }, { EventType::RRelease, 599 }, { EventType::Enter, 599 }, { EventType::Leave, 599 },
+			{ EventType::Move, 899 },
+		};
+		bool order = true;
+		for (const auto& [type, x] : expected)
+		{
+			const auto e = mouse.Read();
+			order = order && e && e->GetType() == type && e->GetPosX() == x && e->GetPosY() == (type == EventType::LPress ? 0 : -x);
+		}
+		checker.Expect(order && !mouse.Read() && mouse.IsEmpty(), "coalescing", "events out of order, missing or moves not folded");
+		checker.Expect(mouse.GetOverflowCount() == 0u, "coalescing", "a full ring of buttons and folded moves overflowed");
+		checker.Expect(mouse.GetCoalescedMoveCount() == 3u * 299u, "coalescing", "folded moves miscounted");
+
+		// the window thread moving and clicking while the simulation reads
+		recorder.Reset();
+		constexpr int clicks = 2000;
+		for (int i = 0; i < clicks; i++)
+		{
+			for (int m = 0; m < 5; m++)
+			{
+				recorder.Record(Type::MouseMove, OTimer::Now(), i * 5 + m, 0);
+			}
+			recorder.Record(i % 2 == 0 ? Type::LPress : Type::LRelease, OTimer::Now(), 0, 0);
+		}
+		InputReplay threaded(recorder.GetData());
+		Mouse shared(size_t(clicks) * 2u);
+		std::atomic<bool> done = false;
+		std::thread window([&]
+		{
+			threaded.Feed(0u, kbd, shared);
+			done = true;
+		});
+		int buttons = 0;
+		int lastX = -1;
+		bool ordered = true;
+		while (true)
+		{
+			// read the flag first so nothing pushed before it is missed
+			const bool finished = done;
+			while (const auto e = shared.Read())
+			{
+				if (e->GetType() == EventType::Move)
+				{
+					ordered = ordered && e->GetPosX() > lastX;
+					lastX = e->GetPosX();
+				}
+				else
+				{
+					ordered = ordered && e->GetType() == (buttons % 2 == 0 ? EventType::LPress : EventType::LRelease);
+					buttons++;
+				}
+			}
+			if (finished)
+			{
+				break;
+			}
+		}
+		window.join();
+		checker.Expect(ordered && buttons == clicks, "coalescing", "a concurrent reader lost a button or saw events out of order");
+		checker.Expect(lastX == clicks * 5 - 1 && shared.GetOverflowCount() == 0u, "coalescing",
+			"a concurrent reader missed the last move or overflowed");
+	}
+
+	// ReadChar and ReadCharEvent take from the same queue, in order.
+	void CheckChars(Checker& checker)
+	{
+		InputRecorder recorder;
+		recorder.Record(Type::Char, OTimer::Now(), 'a');
+		recorder.Record(Type::Char, OTimer::Now() + 1000, 'b');
+		InputReplay replay(recorder.GetData());
+		Keyboard kbd;
+		Mouse mouse;
+		replay.Feed(0u, kbd, mouse);
+		const std::optional<char> a = kbd.ReadChar();
+		const std::optional<Keyboard::CharEvent> b = kbd.ReadCharEvent();
+		checker.Expect(a == 'a' && b && b->GetChar() == 'b' && b->GetTimestamp() >= 1000 && kbd.IsCharEmpty(),
+			"chars", "ReadChar and ReadCharEvent do not share the queue");
+	}
+
+	// Records a synthetic script of input events, replays it twice through
+	// the app on the headless platform and compares what the devices hand
+	// out with what the script says they have to, then checks damaged
+	// streams throw and the raw delta sums and move coalescing hold up.
+	int RunInputChecks(size_t count)
+	{
+		Checker checker("input");
+		const std::vector<Scripted> script = MakeScript(count);
+		const std::vector<uint8_t> data = Record(script);
+		const uint64_t frames = script.empty() ? 1u : script.back().frame + 1u;
+		const std::vector<Seen> expected = Expect(script);
+		const std::vector<Seen> first = Replay(data, frames, checker);
+		const std::vector<Seen> second = Replay(data, frames, checker);
+		size_t mismatch = 0u;
+		while (mismatch < first.size() && mismatch < expected.size() && first[mismatch] == expected[mismatch])
+		{
+			mismatch++;
+		}
+		if (mismatch < first.size() || mismatch < expected.size())
+		{
+			std::fprintf(stderr, "input replay: first difference at entry %zu of %zu, frame %llu\n", mismatch, expected.size(),
+				static_cast<unsigned long long>(mismatch < expected.size() ? expected[mismatch].frame : first[mismatch].frame));
+		}
+		checker.Expect(first == expected, "replay", "events, their order or timestamps differ from the script");
+		checker.Expect(second == first, "replay", "a second run saw different events");
+		CheckDamaged(script, checker);
+		CheckRawDeltas(checker);
+		CheckCoalescing(checker);
+		CheckChars(checker);
+		std::printf("input: %zu events over %llu frames (%zu bytes), %d failed checks\n", count,
+			static_cast<unsigned long long>(frames), data.size(), checker.GetFailures());
+		return checker.GetResult();
+	}
+}
+
+namespace Headless
+{
+	int RunInput(const char* events, const Options& /*options*/)
+	{
+		return RunInputChecks(ParseCount(events));
+	}
+}
@@ -0,0 +1,171 @@
+#include "Headless/HeadlessModes.h"
+#include "Mesh/Mesh.h"
+#include "Mesh/MeshBlob.h"
+#include "Time/OTimer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr int rings = 32;
+	constexpr int segments = 64;
+
+	struct Point
+	{
+		double x;
+		double y;
+		double z;
+	};
+
+	double TriangleArea(const Point& a, const Point& b, const Point& c) noexcept
+	{
+		const Point u = { b.x - a.x, b.y - a.y, b.z - a.z };
+		const Point v = { c.x - a.x, c.y - a.y, c.z - a.z };
+		const Point n = { u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x };
+		return 0.5 * std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+	}
+
+	// Stand-in for a model file when none is given: a UV sphere in OBJ with
+	// texture coordinates and no normals, triangles at the poles, quads in
+	// between and every index relative, counted back from the last vertex.
+	// The seam and the poles repeat positions with different coordinates.
+	// area is what its faces cover, to find corners the parser misplaced.
+	std::string MakeObj(double& area)
+	{
+		constexpr double pi = 3.14159265358979323846;
+		constexpr int columns = segments + 1;
+		constexpr int total = (rings + 1) * columns;
+		std::string obj = "# uv sphere\n";
+		char line[128];
+		std::vector<Point> points;
+		for (int r = 0; r <= rings; r++)
+		{
+			for (int s = 0; s <= segments; s++)
+			{
+				const double theta = pi * r / rings;
+				const double phi = 2.0 * pi * s / segments;
+				std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\n",
+					std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi),
+					double(s) / segments, 1.0 - double(r) / rings);
+				obj += line;
+				points.push_back({ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) });
+			}
+		}
+		const auto at = [&points](int index) { return points[size_t(index + total)]; };
+		area = 0.0;
+		const auto rel = [](int r, int s) { return r * columns + s - total; };
+		for (int r = 0; r < rings; r++)
+		{
+			for (int s = 0; s < segments; s++)
+			{
+				const int a = rel(r, s);
+				const int b = rel(r + 1, s);
+				const int c = rel(r + 1, s + 1);
+				const int d = rel(r, s + 1);
+				if (r == 0)
+				{
+					std::snprintf(line, sizeof(line), "f %d/%d %d/%d %d/%d\n", a, a, b, b, c, c);
+					area += TriangleArea(at(a), at(b), at(c));
+				}
+				else if (r == rings - 1)
+				{
+					std::snprintf(line, sizeof(line), "f %d/%d %d/%d %d/%d\n", a, a, b, b, d, d);
+					area += TriangleArea(at(a), at(b), at(d));
+				}
+				else
+				{
+					std::snprintf(line, sizeof(line), "f %d/%d %d/%d %d/%d %d/%d\n", a, a, b, b, c, c, d, d);
+					area += TriangleArea(at(a), at(b), at(c)) + TriangleArea(at(a), at(c), at(d));
+				}
+				obj += line;
+			}
+		}
+		return obj;
+	}
+
+	// Cooks the model in both vertex formats with both cache optimizers,
+	// writes each blob out and loads it back. Returns 1 when a blob does not
+	// come back byte for byte, an optimizer leaves the ACMR worse than the
+	// file's own order, or quantization moves a position by more than one
+	// 16-bit step of the bounds. "synthetic" cooks a generated sphere
+	// instead of loading a file, and fails too when the parser does not
+	// split its quads into two triangles each, drops a vertex or puts a
+	// corner on the wrong one.
+	int RunMeshCook(const char* path)
+	{
+		const bool synthetic = std::strcmp(path, "synthetic") == 0;
+		double area = 0.0;
+		const Mesh mesh = synthetic ? Mesh::ParseObj(MakeObj(area)) : Mesh::Load(path);
+		const std::string blobPath = (std::filesystem::temp_directory_path() / "headless_mesh.omsh").string();
+		std::printf("%s: %zu vertices, %zu triangles\n", path, mesh.GetVertices().size(), mesh.GetTriangleCount());
+		int exitCode = 0;
+		// a pole vertex per segment, the last column of each pole is unused
+		const size_t vertices = size_t(rings - 1) * (segments + 1) + 2u * segments;
+		const size_t triangles = 2u * segments * (rings - 1);
+		double parsedArea = 0.0;
+		const std::vector<Mesh::Vertex>& parsed = mesh.GetVertices();
+		const std::vector<uint32_t>& indices = mesh.GetIndices();
+		for (size_t i = 0; synthetic && i + 2u < indices.size(); i += 3u)
+		{
+			const auto point = [&](size_t corner)
+			{
+				const OMath::XMFLOAT3& p = parsed[indices[i + corner]].position;
+				return Point{ p.x, p.y, p.z };
+			};
+			parsedArea += TriangleArea(point(0u), point(1u), point(2u));
+		}
+		// the file keeps 6 decimals
+		const bool wrongArea = std::abs(parsedArea - area) > 1e-4 * area;
+		if (synthetic && (parsed.size() != vertices || mesh.GetTriangleCount() != triangles || wrongArea))
+		{
+			std::fprintf(stderr, "mesh synthetic: expected %zu vertices, %zu triangles and an area of %.6f, got %.6f\n",
+				vertices, triangles, area, parsedArea);
+			exitCode = 1;
+		}
+		for (const MeshBlob::Format format : { MeshBlob::Format::Float, MeshBlob::Format::Compact })
+		{
+			for (const MeshOptimize::CacheAlgorithm cache : { MeshOptimize::CacheAlgorithm::Forsyth, MeshOptimize::CacheAlgorithm::Tipsify })
+			{
+				MeshBlob::Options options;
+				options.format = format;
+				options.cache = cache;
+				const MeshBlob blob = MeshBlob::Cook(mesh, options);
+				blob.Write(blobPath);
+				OTimer timer;
+				const MeshBlob loaded = MeshBlob::Load(blobPath);
+				const float loadSeconds = timer.Mark();
+				const MeshBlob::Stats& stats = blob.GetStats();
+				const OMath::XMFLOAT3 scale = blob.GetPositionScale();
+				const float step = std::max({ scale.x, scale.y, scale.z }) / 65535.0f;
+				const bool roundTrip = loaded.GetData() == blob.GetData();
+				const bool worse = stats.cacheAfter.acmr > stats.cacheBefore.acmr;
+				const bool lossy = format == MeshBlob::Format::Compact ? stats.maxPositionError > step : stats.maxPositionError > 0.0f;
+				std::printf("%s %s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, overfetch %.3f -> %.3f, overdraw %.3f -> %.3f, %.2f bytes per vertex, optimize %.3fms, load %.3fms, error %g%s%s%s\n",
+					MeshBlob::GetFormatName(format), cache == MeshOptimize::CacheAlgorithm::Forsyth ? "forsyth" : "tipsify",
+					stats.cacheBefore.acmr, stats.cacheAfter.acmr, stats.cacheBefore.atvr, stats.cacheAfter.atvr,
+					stats.fetchBefore.overfetch, stats.fetchAfter.overfetch, stats.overdrawBefore.overdraw, stats.overdrawAfter.overdraw,
+					blob.GetBytesPerVertex(), stats.optimizeSeconds * 1000.0, loadSeconds * 1000.0, stats.maxPositionError,
+					roundTrip ? "" : " ROUND TRIP FAILED", worse ? " ACMR WORSE" : "", lossy ? " ERROR OVER LIMIT" : "");
+				if (!roundTrip || worse || lossy)
+				{
+					exitCode = 1;
+				}
+			}
+		}
+		std::filesystem::remove(blobPath);
+		return exitCode;
+	}
+}
+
+namespace Headless
+{
+	int RunMesh(const char* path, const Options& /*options*/)
+	{
+		return RunMeshCook(path);
+	}
+}
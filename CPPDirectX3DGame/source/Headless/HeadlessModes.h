@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// Modes of the headless executable besides the frame loop. Each is picked by
+// its flag, gets the flag's value and the options shared with the frame loop,
+// and returns the exit code, nonzero when one of its checks failed.
+namespace Headless
+{
+	struct Options
+	{
+		uint64_t frames = 1000u;
+	};
+	struct Mode
+	{
+		const char* flag;
+		// what the value is, for the usage line
+		const char* value;
+		int (*run)(const char* value, const Options& options);
+	};
+
+	inline size_t ParseCount(const char* value) noexcept
+	{
+		return static_cast<size_t>(std::strtoull(value, nullptr, 10));
+	}
+
+	// Collects the results of a mode's checks, printing each failed one as
+	// "mode scenario: what" so a ctest log says what broke.
+	class Checker
+	{
+	public:
+		Checker(const char* mode) noexcept
+			:
+			mode(mode)
+		{
+		}
+		void Expect(bool ok, const char* scenario, const char* what) noexcept
+		{
+			if (!ok)
+			{
+				std::fprintf(stderr, "%s %s: %s\n", mode, scenario, what);
+				failures++;
+			}
+		}
+		int GetFailures() const noexcept
+		{
+			return failures;
+		}
+		// the mode's exit code
+		int GetResult() const noexcept
+		{
+			return failures > 0 ? 1 : 0;
+		}
+	private:
+		const char* mode;
+		int failures = 0;
+	};
+
+	// view culling on a synthetic scene for options.frames frames, fails when it differs from testing every object
+	int RunCull(const char* objects, const Options& options);
+	// cold, warm, edited and damaged starts of the shader cache, fails on a wrong hit or compile
+	int RunShaders(const char* count, const Options& options);
+	// the texture cooker on an image or "synthetic", fails when a format loses too much
+	int RunTexture(const char* path, const Options& options);
+	// the asset streamer on a generated level
+	int RunStream(const char* assets, const Options& options);
+	// the mesh cooker on a model or "synthetic", fails when a blob does not survive the round trip
+	int RunMesh(const char* path, const Options& options);
+	// sorted command buffer replay on a recording context, fails when a call is wrong
+	int RunCommands(const char* draws, const Options& options);
+	// the software rasterizer on fixed scenes, fails when a pixel differs
+	int RunRaster(const char* threads, const Options& options);
+	// frame pacing decisions on a simulated display, fails when one is wrong
+	int RunPacing(const char* frames, const Options& options);
+	// the upload ring over system memory and a simulated GPU, fails on a misplaced slice, map or wait
+	int RunUpload(const char* frames, const Options& options);
+	// recorded input replayed through the app twice and the mouse under load, fails when an event or its timestamp differs
+	int RunInput(const char* events, const Options& options);
+}
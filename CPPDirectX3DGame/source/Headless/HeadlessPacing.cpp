@@ -0,0 +1,174 @@
+#include "Headless/HeadlessModes.h"
+#include "Render/Present/FakeSwapChain.h"
+#include "Render/Present/FramePacer.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	constexpr double refreshRate = 60.0;
+	constexpr double refreshPeriod = 1.0 / refreshRate;
+	// CPU time of a frame, well inside a refresh
+	constexpr double frameWork = 0.005;
+
+	using Headless::Checker;
+
+	// a pacer on a simulated display whose throttling sleeps in virtual time
+	struct Display
+	{
+		Display(double refreshRate, bool tearingSupported)
+			:
+			chain(SwapChain::Desc{}, refreshRate, tearingSupported),
+			pacer(chain, [this](unsigned int ms)
+			{
+				sleeps.push_back(ms);
+				chain.Advance(double(ms) / 1000.0);
+			})
+		{
+		}
+		// one frame of frameWork, the result of its present
+		SwapChain::PresentResult Frame()
+		{
+			pacer.BeginFrame();
+			chain.Advance(frameWork);
+			return pacer.Present();
+		}
+		FakeSwapChain chain;
+		FramePacer pacer;
+		std::vector<unsigned int> sleeps;
+	};
+
+	bool Near(double a, double b) noexcept
+	{
+		return std::abs(a - b) < 1e-9;
+	}
+
+	// With vsync and one frame of latency every frame waits for the one
+	// before it to reach the screen, so frames land on consecutive vblanks.
+	void CheckVSync(size_t frames, Checker& checker)
+	{
+		Display display(refreshRate, true);
+		bool ok = true;
+		for (size_t i = 0; i < frames; i++)
+		{
+			ok = ok && display.Frame() == SwapChain::PresentResult::Ok;
+		}
+		checker.Expect(ok, "vsync", "a present failed");
+		const std::vector<FakeSwapChain::PresentCall>& presents = display.chain.GetPresents();
+		checker.Expect(presents.size() == frames, "vsync", "not one present per frame");
+		for (size_t i = 0; ok && i < presents.size(); i++)
+		{
+			ok = presents[i].syncInterval == 1u && presents[i].flags == 0u &&
+				Near(presents[i].displaySeconds, double(i + 1u) * refreshPeriod);
+		}
+		checker.Expect(ok, "vsync", "frames not shown on consecutive vblanks with sync interval 1");
+		checker.Expect(display.chain.GetWaitCount() == frames, "vsync", "not one wait per frame");
+		checker.Expect(display.pacer.GetStats().waitTimeouts == 0u, "vsync", "the wait timed out");
+	}
+
+	// Uncapped with tearing the CPU sets the rate: nothing waits and every
+	// frame is shown the moment it is presented.
+	void CheckTearing(size_t frames, Checker& checker)
+	{
+		Display display(refreshRate, true);
+		display.pacer.SetVSync(false);
+		for (size_t i = 0; i < frames; i++)
+		{
+			display.Frame();
+		}
+		const std::vector<FakeSwapChain::PresentCall>& presents = display.chain.GetPresents();
+		bool ok = presents.size() == frames;
+		for (size_t i = 0; ok && i < presents.size(); i++)
+		{
+			ok = presents[i].syncInterval == 0u && presents[i].flags == SwapChain::presentAllowTearing &&
+				Near(presents[i].displaySeconds, double(i + 1u) * frameWork);
+		}
+		checker.Expect(ok, "tearing", "frames not presented with tearing as soon as they were done");
+		checker.Expect(Near(display.chain.GetTime(), double(frames) * frameWork), "tearing", "frames waited on the display");
+	}
+
+	// Uncapped on a swap chain without tearing support must not ask for it,
+	// DXGI fails those presents.
+	void CheckNoTearing(size_t frames, Checker& checker)
+	{
+		Display display(refreshRate, false);
+		display.pacer.SetVSync(false);
+		bool ok = true;
+		for (size_t i = 0; i < frames; i++)
+		{
+			ok = ok && display.Frame() == SwapChain::PresentResult::Ok;
+		}
+		for (const FakeSwapChain::PresentCall& present : display.chain.GetPresents())
+		{
+			ok = ok && present.syncInterval == 0u && present.flags == 0u;
+		}
+		checker.Expect(ok, "no tearing", "asked for tearing the swap chain cannot do");
+	}
+
+	// Once a present reports occlusion the pacer only probes with test
+	// presents, sleeping the throttle each frame, until one succeeds; the
+	// frame after that presents for real again.
+	void CheckOcclusion(size_t frames, Checker& checker)
+	{
+		Display display(refreshRate, true);
+		display.Frame();
+		display.chain.SetOccluded(true);
+		checker.Expect(display.Frame() == SwapChain::PresentResult::Occluded && display.pacer.IsOccluded(),
+			"occlusion", "an occluded present did not stop presenting");
+		const size_t presents = display.chain.GetPresents().size();
+		for (size_t i = 0; i < frames; i++)
+		{
+			display.Frame();
+		}
+		const FramePacer::Stats stats = display.pacer.GetStats();
+		checker.Expect(display.chain.GetPresents().size() == presents, "occlusion", "presented real frames while occluded");
+		checker.Expect(stats.testPresents == frames && stats.occludedFrames == frames, "occlusion", "not one test present per occluded frame");
+		bool throttled = display.sleeps.size() == frames;
+		for (const unsigned int ms : display.sleeps)
+		{
+			throttled = throttled && ms == 50u;
+		}
+		checker.Expect(throttled, "occlusion", "occluded frames not throttled to 50ms");
+		display.chain.SetOccluded(false);
+		// the probe that finds the window visible still drops its frame
+		checker.Expect(display.Frame() == SwapChain::PresentResult::Occluded && !display.pacer.IsOccluded(),
+			"occlusion", "a successful test present did not end occlusion");
+		checker.Expect(display.Frame() == SwapChain::PresentResult::Ok && display.chain.GetPresents().size() == presents + 1u,
+			"occlusion", "no real present after the window became visible");
+	}
+
+	// A display slower than the wait timeout makes BeginFrame give up
+	// rather than hang, and device removal reaches the caller.
+	void CheckFailures(Checker& checker)
+	{
+		Display display(0.5, true);
+		display.Frame();
+		display.Frame();
+		checker.Expect(display.pacer.GetStats().waitTimeouts == 1u, "failures", "a wait longer than the timeout did not time out");
+		display.chain.SetDeviceRemoved();
+		checker.Expect(display.Frame() == SwapChain::PresentResult::DeviceRemoved, "failures", "device removal not reported");
+	}
+
+	// Runs FramePacer on a FakeSwapChain in virtual time and checks the
+	// decisions it makes.
+	int RunPacingChecks(size_t frames)
+	{
+		Checker checker("pacing");
+		CheckVSync(frames, checker);
+		CheckTearing(frames, checker);
+		CheckNoTearing(frames, checker);
+		CheckOcclusion(frames, checker);
+		CheckFailures(checker);
+		std::printf("pacing: %zu frames per scenario, %d failed checks\n", frames, checker.GetFailures());
+		return checker.GetResult();
+	}
+}
+
+namespace Headless
+{
+	int RunPacing(const char* frames, const Options& /*options*/)
+	{
+		return RunPacingChecks(ParseCount(frames));
+	}
+}
@@ -0,0 +1,278 @@
+#include "Headless/HeadlessModes.h"
+#include "Job/JobSystem.h"
+#include "Render/Software/SoftwareRasterizer.h"
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+	using Headless::Checker;
+	using Vertex = RenderBackend::Vertex;
+	using Frame = std::vector<uint32_t>;
+
+	// three tiles by two, and a width that leaves padding at the end of each row
+	constexpr unsigned int width = 150u;
+	constexpr unsigned int height = 100u;
+	// ClearBuffer(0, 0, 1)
+	constexpr uint32_t clearColor = 0xFF0000FFu;
+
+	// vertex at a position in pixels, colored with a B8G8R8A8 value
+	Vertex At(float x, float y, uint32_t color) noexcept
+	{
+		Vertex v;
+		v.pos.x = x / float(width) * 2.0f - 1.0f;
+		v.pos.y = 1.0f - y / float(height) * 2.0f;
+		v.color.r = (unsigned char)(color >> 16);
+		v.color.g = (unsigned char)(color >> 8);
+		v.color.b = (unsigned char)color;
+		v.color.a = (unsigned char)(color >> 24);
+		return v;
+	}
+
+	void AddTriangle(std::vector<Vertex>& vertices, Vertex a, Vertex b, Vertex c)
+	{
+		vertices.insert(vertices.end(), { a, b, c });
+	}
+
+	// two triangles sharing the diagonal
+	void AddQuad(std::vector<Vertex>& vertices, float x0, float y0, float x1, float y1, uint32_t color)
+	{
+		AddTriangle(vertices, At(x0, y0, color), At(x1, y0, color), At(x1, y1, color));
+		AddTriangle(vertices, At(x0, y0, color), At(x1, y1, color), At(x0, y1, color));
+	}
+
+	// pixels [x0, x1) x [y0, y1) set to color
+	void Fill(Frame& frame, unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1, uint32_t color)
+	{
+		for (unsigned int y = y0; y < y1; y++)
+		{
+			for (unsigned int x = x0; x < x1; x++)
+			{
+				frame[size_t(y) * width + x] = color;
+			}
+		}
+	}
+
+	Frame Cleared(uint32_t color = clearColor)
+	{
+		return Frame(size_t(width) * height, color);
+	}
+
+	// Draws each scene on the calling thread and on the job system, so
+	// every check also covers the output not depending on the thread count.
+	class Canvas
+	{
+	public:
+		Canvas(JobSystem& jobs, Checker& checker) noexcept
+			:
+			jobs(jobs),
+			checker(checker)
+		{
+		}
+		Frame Draw(const char* scene, const std::vector<Vertex>& vertices, float red = 0.0f, float green = 0.0f, float blue = 1.0f)
+		{
+			const Frame frame = Render(nullptr, vertices, red, green, blue);
+			checker.Expect(Render(&jobs, vertices, red, green, blue) == frame, scene, "output depends on the thread count");
+			return frame;
+		}
+	private:
+		static Frame Render(JobSystem* pJobs, const std::vector<Vertex>& vertices, float red, float green, float blue)
+		{
+			SoftwareRasterizer rasterizer(width, height, pJobs);
+			std::vector<unsigned short> indices(vertices.size());
+			std::iota(indices.begin(), indices.end(), (unsigned short)0u);
+			rasterizer.ClearBuffer(red, green, blue);
+			rasterizer.DrawIndexed(vertices.data(), vertices.size(), indices.data(), indices.size());
+			rasterizer.EndFrame();
+			Frame frame(size_t(width) * height);
+			for (unsigned int y = 0; y < height; y++)
+			{
+				const uint32_t* pRow = rasterizer.GetFrontBuffer() + size_t(y) * rasterizer.GetPitch();
+				std::copy(pRow, pRow + width, frame.begin() + size_t(y) * width);
+			}
+			return frame;
+		}
+	private:
+		JobSystem& jobs;
+		Checker& checker;
+	};
+
+	void CheckClear(Canvas& canvas, Checker& checker)
+	{
+		checker.Expect(canvas.Draw("clear", {}) == Cleared(), "clear", "not every pixel has the clear color");
+		checker.Expect(canvas.Draw("clear", {}, 0.5f, 0.25f, 1.0f) == Cleared(0xFF8040FFu), "clear", "clear color not rounded to B8G8R8A8");
+	}
+
+	// Edges through pixel centres: the top and left ones own them, the
+	// bottom and right ones do not, so a quad from x.5 to x'.5 covers
+	// exactly x' - x columns. The second quad straddles four tiles.
+	void CheckRectangles(Canvas& canvas, Checker& checker)
+	{
+		std::vector<Vertex> vertices;
+		AddQuad(vertices, 4.5f, 2.5f, 12.5f, 10.5f, 0xFFFFFFFFu);
+		AddQuad(vertices, 60.5f, 60.5f, 70.5f, 70.5f, 0xFFFF0000u);
+		Frame expected = Cleared();
+		Fill(expected, 4u, 2u, 12u, 10u, 0xFFFFFFFFu);
+		Fill(expected, 60u, 60u, 70u, 70u, 0xFFFF0000u);
+		checker.Expect(canvas.Draw("rectangles", vertices) == expected, "rectangles", "pixels on the edges not owned by the top-left ones");
+	}
+
+	// Later triangles overwrite earlier ones in every tile they share.
+	void CheckOrder(Canvas& canvas, Checker& checker)
+	{
+		std::vector<Vertex> vertices;
+		AddQuad(vertices, 20.5f, 20.5f, 100.5f, 80.5f, 0xFFFF0000u);
+		AddQuad(vertices, 50.5f, 40.5f, 130.5f, 90.5f, 0xFF00FF00u);
+		Frame expected = Cleared();
+		Fill(expected, 20u, 20u, 100u, 80u, 0xFFFF0000u);
+		Fill(expected, 50u, 40u, 130u, 90u, 0xFF00FF00u);
+		checker.Expect(canvas.Draw("order", vertices) == expected, "order", "triangles not drawn in submission order");
+	}
+
+	// A fan around a pixel centre covering the screen, with horizontal and
+	// vertical edges through a row and a column of centres: drawn one at a
+	// time the triangles have to cover every pixel exactly once.
+	void CheckSharedEdges(Canvas& canvas, Checker& checker)
+	{
+		const float centre[2] = { 75.5f, 50.5f };
+		const float ring[][2] =
+		{
+			{ 0.0f, 0.0f }, { 75.5f, 0.0f }, { 150.0f, 0.0f }, { 150.0f, 50.5f },
+			{ 150.0f, 100.0f }, { 75.5f, 100.0f }, { 0.0f, 100.0f }, { 0.0f, 50.5f },
+		};
+		// all channels 0 or 255 so flat shading is exact, none of them the clear color
+		const uint32_t colors[] =
+		{
+			0xFFFF0000u, 0xFF00FF00u, 0xFFFFFF00u, 0xFFFF00FFu,
+			0xFF00FFFFu, 0xFFFFFFFFu, 0xFF000000u, 0x00FF0000u,
+		};
+		std::vector<Vertex> fan;
+		std::vector<Frame> alone;
+		for (size_t i = 0; i < std::size(ring); i++)
+		{
+			const float* a = ring[i];
+			const float* b = ring[(i + 1u) % std::size(ring)];
+			std::vector<Vertex> vertices;
+			AddTriangle(vertices, At(centre[0], centre[1], colors[i]), At(a[0], a[1], colors[i]), At(b[0], b[1], colors[i]));
+			alone.push_back(canvas.Draw("shared edges", vertices));
+			fan.insert(fan.end(), vertices.begin(), vertices.end());
+		}
+		const Frame all = canvas.Draw("shared edges", fan);
+		bool once = true;
+		bool same = true;
+		for (size_t p = 0; p < all.size(); p++)
+		{
+			size_t covering = 0u;
+			for (const Frame& frame : alone)
+			{
+				if (frame[p] != clearColor)
+				{
+					covering++;
+					same = same && all[p] == frame[p];
+				}
+			}
+			once = once && covering == 1u;
+		}
+		checker.Expect(once, "shared edges", "a pixel covered by none or by two triangles of the fan");
+		checker.Expect(same, "shared edges", "the fan drawn at once differs from its triangles drawn alone");
+	}
+
+	// Triangles smaller than a pixel cover the centres they contain and no
+	// others; a degenerate one covers nothing.
+	void CheckSubPixel(Canvas& canvas, Checker& checker)
+	{
+		const uint32_t white = 0xFFFFFFFFu;
+		std::vector<Vertex> vertices;
+		// next to the centre of (10, 10) without containing it
+		AddTriangle(vertices, At(10.6f, 10.6f, white), At(10.9f, 10.6f, white), At(10.6f, 10.9f, white));
+		// around the centre of (20, 20)
+		AddTriangle(vertices, At(20.4f, 20.4f, white), At(20.7f, 20.4f, white), At(20.4f, 20.7f, white));
+		// a line through the centres of row 30
+		AddTriangle(vertices, At(5.5f, 30.5f, white), At(40.5f, 30.5f, white), At(20.5f, 30.5f, white));
+		Frame expected = Cleared();
+		Fill(expected, 20u, 20u, 21u, 21u, white);
+		checker.Expect(canvas.Draw("sub-pixel", vertices) == expected, "sub-pixel", "small or degenerate triangles covered the wrong pixels");
+	}
+
+	// Vertices far outside the screen, which also take the scalar path for
+	// triangles too large for 32-bit edge functions.
+	void CheckClipping(Canvas& canvas, Checker& checker)
+	{
+		const uint32_t red = 0xFFFF0000u;
+		std::vector<Vertex> vertices;
+		AddTriangle(vertices, At(-1000.0f, -1000.0f, red), At(3000.0f, -1000.0f, red), At(-1000.0f, 3000.0f, red));
+		checker.Expect(canvas.Draw("clipping", vertices) == Cleared(red), "clipping", "a triangle around the screen left pixels uncovered");
+
+		vertices.clear();
+		AddQuad(vertices, -500.0f, -500.0f, 75.0f, 600.0f, red);
+		Frame expected = Cleared();
+		Fill(expected, 0u, 0u, 75u, height, red);
+		checker.Expect(canvas.Draw("clipping", vertices) == expected, "clipping", "a quad over the left edge covered the wrong columns");
+
+		vertices.clear();
+		AddTriangle(vertices, At(-50.0f, 10.0f, red), At(-10.0f, 10.0f, red), At(-30.0f, 40.0f, red));
+		AddTriangle(vertices, At(160.0f, 110.0f, red), At(400.0f, 120.0f, red), At(170.0f, 300.0f, red));
+		checker.Expect(canvas.Draw("clipping", vertices) == Cleared(), "clipping", "a triangle off the screen drew");
+	}
+
+	// The test triangle of Graphics::DrawTestTriangle: weights sum to one,
+	// so each covered pixel keeps the vertex colors' total of 255 up to the
+	// rounding of its three channels, and each corner takes its vertex's color.
+	void CheckTestTriangle(Canvas& canvas, Checker& checker)
+	{
+		std::vector<Vertex> vertices =
+		{
+			{ {  0.0f,  0.5f }, { 255, 0, 0, 255 } },
+			{ {  0.5f, -0.5f }, { 0, 255, 0, 255 } },
+			{ { -0.5f, -0.5f }, { 0, 0, 255, 255 } },
+		};
+		const Frame frame = canvas.Draw("test triangle", vertices, 0.0f, 0.0f, 0.0f);
+		size_t covered = 0u;
+		bool sums = true;
+		for (const uint32_t pixel : frame)
+		{
+			const unsigned int sum = ((pixel >> 16) & 0xFFu) + ((pixel >> 8) & 0xFFu) + (pixel & 0xFFu);
+			covered += sum != 0u ? 1u : 0u;
+			sums = sums && (pixel >> 24) == 0xFFu && (sum == 0u || (sum >= 254u && sum <= 256u));
+		}
+		checker.Expect(sums, "test triangle", "interpolated colors do not add up to the vertex colors");
+		// 75 by 50 pixels, the edges can gain or lose about half their length
+		checker.Expect(covered > 1875u - 100u && covered < 1875u + 100u, "test triangle", "covered area far from the triangle's");
+		const auto dominant = [&frame](unsigned int x, unsigned int y, int shift)
+		{
+			const uint32_t pixel = frame[size_t(y) * width + x];
+			const uint32_t channel = (pixel >> shift) & 0xFFu;
+			return channel > 200u;
+		};
+		checker.Expect(dominant(75u, 27u, 16) && dominant(110u, 73u, 8) && dominant(40u, 73u, 0),
+			"test triangle", "corners do not take the color of their vertex");
+	}
+
+	// Renders fixed scenes into a small multi-tile buffer and compares the
+	// pixels with the ones the fill rules and vertex colors call for.
+	int RunRasterChecks(unsigned int threads)
+	{
+		JobSystem jobs(threads);
+		Checker checker("raster");
+		Canvas canvas(jobs, checker);
+		CheckClear(canvas, checker);
+		CheckRectangles(canvas, checker);
+		CheckOrder(canvas, checker);
+		CheckSharedEdges(canvas, checker);
+		CheckSubPixel(canvas, checker);
+		CheckClipping(canvas, checker);
+		CheckTestTriangle(canvas, checker);
+		std::printf("raster: %ux%u on the calling thread and %u threads, %d failed checks\n",
+			width, height, jobs.GetThreadCount(), checker.GetFailures());
+		return checker.GetResult();
+	}
+}
+
+namespace Headless
+{
+	int RunRaster(const char* threads, const Options& /*options*/)
+	{
+		return RunRasterChecks(unsigned(ParseCount(threads)));
+	}
+}
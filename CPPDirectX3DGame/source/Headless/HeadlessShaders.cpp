@@ -0,0 +1,162 @@
+#include "Headless/HeadlessModes.h"
+#include "Job/JobSystem.h"
+#include "Render/Shader/FakeShaderCompiler.h"
+#include "Render/Shader/ShaderCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	using Headless::Checker;
+
+	bool SameBytecode(const std::vector<ShaderCache::Bytecode>& a, const std::vector<ShaderCache::Bytecode>& b) noexcept
+	{
+		if (a.size() != b.size())
+		{
+			return false;
+		}
+		for (size_t i = 0; i < a.size(); i++)
+		{
+			if (!a[i] || !b[i] || *a[i] != *b[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Expected(const ShaderCache::Stats& stats, uint64_t memoryHits, uint64_t diskHits, uint64_t compiles) noexcept
+	{
+		return stats.memoryHits == memoryHits && stats.diskHits == diskHits && stats.compiles == compiles && stats.failures == 0u;
+	}
+
+	// Damages two entries on disk, one cut short and one with a flipped byte,
+	// the way a crash mid-write or a bad sector would leave them.
+	size_t DamageEntries(const std::string& directory)
+	{
+		std::vector<std::filesystem::path> entries;
+		for (const auto& entry : std::filesystem::directory_iterator(directory))
+		{
+			if (entry.path().extension() == ".cso")
+			{
+				entries.push_back(entry.path());
+			}
+		}
+		if (entries.size() < 2u)
+		{
+			return 0u;
+		}
+		std::sort(entries.begin(), entries.end());
+		std::filesystem::resize_file(entries[0], std::filesystem::file_size(entries[0]) - 1u);
+		std::fstream file(entries[1], std::ios::binary | std::ios::in | std::ios::out);
+		file.seekg(-1, std::ios::end);
+		const char last = char(file.get());
+		file.seekp(-1, std::ios::end);
+		file.put(char(~last));
+		return 2u;
+	}
+
+	// Loads the given number of generated shaders through a cache in the temp
+	// directory, with a fake compiler standing in for 2ms of D3DCompile per
+	// shader: first empty, then as the previous run left it, then after an
+	// edit to an include and after damage to entries on disk. Fails when a
+	// run compiles or hits anything other than what it should.
+	int RunShaderCache(size_t shaders)
+	{
+		std::unordered_map<std::string, std::string> files;
+		files["shaders/common.hlsli"] = "cbuffer Frame : register(b0) { float4x4 viewProj; };\n";
+		files["shaders/lighting.hlsli"] = "float3 lightDir;\n";
+		std::vector<ShaderDesc> descs;
+		// only the even shaders see common.hlsli, editing it must leave the others alone
+		size_t includingCommon = 0u;
+		for (size_t i = 0; i < shaders; i++)
+		{
+			ShaderDesc desc;
+			desc.path = "shaders/shader" + std::to_string(i) + ".hlsl";
+			desc.profile = i % 2u ? "ps_5_0" : "vs_5_0";
+			const char* include = i % 2u ? "lighting.hlsli" : "common.hlsli";
+			includingCommon += i % 2u ? 0u : 1u;
+			files[desc.path] = "#include \"" + std::string(include) + "\"\nfloat4 main() : SV_Target { return " + std::to_string(i) + "; }\n";
+			descs.push_back(desc);
+		}
+		JobSystem jobs;
+		ShaderCache::Config config;
+		config.pJobs = &jobs;
+		config.directory = (std::filesystem::temp_directory_path() / "o_shader_cache").string();
+		config.loader = [&files](const std::string& path, std::string& contents)
+		{
+			const auto it = files.find(path);
+			if (it == files.end())
+			{
+				return false;
+			}
+			contents = it->second;
+			return true;
+		};
+		std::filesystem::remove_all(config.directory);
+		FakeShaderCompiler compiler(2000u);
+		Checker checker("shaders");
+		std::vector<ShaderCache::Bytecode> first;
+		for (const char* run : { "cold", "warm" })
+		{
+			ShaderCache cache(compiler, config);
+			const std::vector<ShaderCache::Bytecode> bytecode = cache.Load(descs);
+			const ShaderCache::Stats stats = cache.GetStats();
+			std::printf("%s start: %zu shaders in %.3fms, hit rate %.0f%% (%llu from disk, %llu compiled), hash %.3fms disk %.3fms compile %.3fms summed over threads\n",
+				run, shaders, stats.totalSeconds * 1000.0, stats.HitRate() * 100.0,
+				static_cast<unsigned long long>(stats.diskHits), static_cast<unsigned long long>(stats.compiles),
+				stats.hashSeconds * 1000.0, stats.diskSeconds * 1000.0, stats.compileSeconds * 1000.0);
+			if (first.empty())
+			{
+				checker.Expect(Expected(stats, 0u, 0u, shaders), run, "an empty cache did not compile every shader once");
+				first = bytecode;
+				continue;
+			}
+			checker.Expect(Expected(stats, 0u, shaders, 0u), run, "not every shader came from disk");
+			checker.Expect(SameBytecode(bytecode, first), run, "bytecode from disk differs from the compiled one");
+			cache.ResetStats();
+			cache.Load(descs);
+			checker.Expect(Expected(cache.GetStats(), shaders, 0u, 0u), run, "a second load did not hit memory");
+		}
+
+		{
+			files["shaders/common.hlsli"] += "float time;\n";
+			ShaderCache cache(compiler, config);
+			const std::vector<ShaderCache::Bytecode> bytecode = cache.Load(descs);
+			checker.Expect(Expected(cache.GetStats(), 0u, shaders - includingCommon, includingCommon),
+				"include edit", "not exactly the shaders including the edited file recompiled");
+			bool changed = true;
+			for (size_t i = 0; i < shaders; i++)
+			{
+				changed = changed && (*bytecode[i] != *first[i]) == (i % 2u == 0u);
+			}
+			checker.Expect(changed, "include edit", "bytecode did not follow the edit");
+		}
+
+		const size_t damaged = DamageEntries(config.directory);
+		for (const char* run : { "damaged", "repaired" })
+		{
+			ShaderCache cache(compiler, config);
+			cache.Load(descs);
+			const uint64_t compiles = std::string(run) == "damaged" ? damaged : 0u;
+			checker.Expect(Expected(cache.GetStats(), 0u, shaders - compiles, compiles), run,
+				compiles ? "damaged entries were not recompiled" : "recompiled entries were not written back");
+		}
+		std::filesystem::remove_all(config.directory);
+		std::printf("shaders: %zu shaders, %d failed checks\n", shaders, checker.GetFailures());
+		return checker.GetResult();
+	}
+}
+
+namespace Headless
+{
+	int RunShaders(const char* count, const Options& /*options*/)
+	{
+		return RunShaderCache(ParseCount(count));
+	}
+}
@@ -0,0 +1,150 @@
+#include "Headless/HeadlessModes.h"
+#include "Asset/AssetStreamer.h"
+#include "Asset/PackArchive.h"
+#include "Asset/PackWriter.h"
+#include "Texture/Image.h"
+#include "Time/OTimer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	// Streams the given number of generated TGA images, 64 to 512 texels a
+	// side, out of an in-memory pack while a camera flies down a corridor
+	// they are spread over at 10m per frame. Every frame re-prioritizes
+	// what is pending by distance and whether it is ahead, cancels what has
+	// fallen 200m behind and pumps with a 1MB budget. Frames are paced at
+	// 2ms so the loaders have something to overlap with. Fails if the
+	// resident bytes ever went over the 16MB memory budget.
+	int RunStreamLevel(size_t assets)
+	{
+		constexpr size_t uploadBudget = 1u << 20;
+		constexpr float speed = 10.0f;
+		std::mt19937 rng(22u);
+		std::uniform_int_distribution<uint32_t> side(64u, 512u);
+		std::uniform_real_distribution<float> position(0.0f, float(assets) * 5.0f);
+		PackWriter writer;
+		std::vector<float> positions;
+		// decoding to RGBA grows every image by a third
+		std::unordered_map<std::string, size_t> decodedSizes;
+		for (size_t i = 0; i < assets; i++)
+		{
+			const uint32_t width = side(rng);
+			const uint32_t height = side(rng);
+			// uncompressed true color, bottom up
+			std::vector<std::byte> tga(18u + size_t(width) * height * 3u);
+			tga[2] = std::byte(2u);
+			tga[12] = std::byte(width & 0xFFu);
+			tga[13] = std::byte(width >> 8);
+			tga[14] = std::byte(height & 0xFFu);
+			tga[15] = std::byte(height >> 8);
+			tga[16] = std::byte(24u);
+			for (size_t j = 18u; j < tga.size(); j++)
+			{
+				tga[j] = std::byte((j * 7u + i) & 0xFFu);
+			}
+			decodedSizes.emplace("image" + std::to_string(i) + ".tga", size_t(width) * height * 4u);
+			writer.Add("image" + std::to_string(i) + ".tga", std::move(tga));
+			positions.push_back(position(rng));
+		}
+		const std::vector<std::byte> pack = writer.Build();
+		const PackArchive archive(pack.data(), pack.size());
+
+		AssetStreamer::Config config;
+		config.reader = AssetStreamer::MakePackReader(archive);
+		config.decoder = [](const std::string&, std::vector<std::byte>& data)
+		{
+			const Image image = Image::Decode(data.data(), data.size());
+			const std::byte* pPixels = reinterpret_cast<const std::byte*>(image.GetPixels());
+			data.assign(pPixels, pPixels + size_t(image.GetWidth()) * image.GetHeight() * 4u);
+		};
+		config.sizer = [&decodedSizes](const std::string& name)
+		{
+			return decodedSizes.at(name);
+		};
+		config.uploadBytesPerFrame = uploadBudget;
+		config.memoryBudget = 16u << 20;
+		AssetStreamer streamer(config);
+
+		const auto priorityOf = [&](size_t i, float camera)
+		{
+			return AssetStreamer::Priority{ positions[i] >= camera, std::abs(positions[i] - camera) };
+		};
+		std::vector<AssetStreamer::Handle> handles;
+		size_t overBudget = 0u;
+		for (size_t i = 0; i < assets; i++)
+		{
+			handles.push_back(streamer.Request("image" + std::to_string(i) + ".tga", priorityOf(i, 0.0f),
+				[&overBudget](const AssetStreamer::Asset& asset)
+				{
+					if (!asset.error.empty())
+					{
+						std::fprintf(stderr, "%s: %s\n", asset.name.c_str(), asset.error.c_str());
+					}
+					overBudget += asset.data.size() > uploadBudget ? 1u : 0u;
+				}));
+		}
+
+		OTimer run;
+		uint64_t frames = 0u;
+		size_t maxFrameBytes = 0u;
+		size_t maxQueued = 0u;
+		AssetStreamer::Stats stats = streamer.GetStats();
+		while (stats.uploads + stats.cancels + stats.failures < stats.requests)
+		{
+			const float camera = float(frames) * speed;
+			for (size_t i = 0; i < assets; i++)
+			{
+				if (handles[i] == 0u)
+				{
+					continue;
+				}
+				if (positions[i] < camera - 200.0f)
+				{
+					streamer.Cancel(handles[i]);
+					handles[i] = 0u;
+				}
+				else if (!streamer.SetPriority(handles[i], priorityOf(i, camera)))
+				{
+					// uploaded
+					handles[i] = 0u;
+				}
+			}
+			streamer.Pump();
+			stats = streamer.GetStats();
+			// an asset over the budget goes alone, it is not a frame over budget
+			if (stats.frameUploads > 1u)
+			{
+				maxFrameBytes = std::max(maxFrameBytes, stats.frameBytes);
+			}
+			maxQueued = std::max(maxQueued, stats.queued + stats.reading + stats.decoding + stats.ready);
+			frames++;
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+		const float seconds = run.Mark();
+		std::printf("%zu assets in %llu frames (%.3fs): %llu uploaded (%.1fMB, %zu over the budget alone), %llu cancelled, %llu failed\n",
+			assets, static_cast<unsigned long long>(frames), seconds, static_cast<unsigned long long>(stats.uploads),
+			double(stats.bytesUploaded) / double(1u << 20), overBudget,
+			static_cast<unsigned long long>(stats.cancels), static_cast<unsigned long long>(stats.failures));
+		std::printf("latency p50 %.2fms p95 %.2fms p99 %.2fms max %.2fms (last %zu), max %.1fKB per frame, max %zu in the queues, max %.1fMB resident of %.1fMB\n",
+			stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs, stats.latencyCount,
+			double(maxFrameBytes) / 1024.0, maxQueued, double(stats.peakResidentBytes) / double(1u << 20),
+			double(config.memoryBudget) / double(1u << 20));
+		return stats.failures > 0u || maxFrameBytes > uploadBudget || stats.peakResidentBytes > config.memoryBudget ? 1 : 0;
+	}
+}
+
+namespace Headless
+{
+	int RunStream(const char* assets, const Options& /*options*/)
+	{
+		return RunStreamLevel(ParseCount(assets));
+	}
+}
@@ -0,0 +1,93 @@
+#include "Headless/HeadlessModes.h"
+#include "Job/JobSystem.h"
+#include "Texture/BlockCompression.h"
+#include "Texture/CookedTexture.h"
+#include "Texture/MipChain.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Stand-in for a real albedo map when no image is given: gradients, a
+	// soft pattern, a little noise and cut-out alpha, so the check can run
+	// anywhere. The seed is fixed, the PSNR it gets only moves with the code.
+	Image MakeImage()
+	{
+		constexpr uint32_t size = 256u;
+		Image image(size, size);
+		std::mt19937 rng(21u);
+		std::uniform_int_distribution<int> noise(-6, 6);
+		for (uint32_t y = 0; y < size; y++)
+		{
+			for (uint32_t x = 0; x < size; x++)
+			{
+				uint8_t* p = image.GetPixel(x, y);
+				const float wave = std::sin(float(x) * 0.05f) * std::cos(float(y) * 0.031f);
+				p[0] = uint8_t(std::clamp(int(x) + noise(rng), 0, 255));
+				p[1] = uint8_t(std::clamp(int(128.0f + 100.0f * wave) + noise(rng), 0, 255));
+				p[2] = uint8_t(std::clamp(int(y) + noise(rng), 0, 255));
+				p[3] = (x / 32u + y / 32u) % 4u == 0u ? uint8_t(0u) : uint8_t(255u);
+			}
+		}
+		return image;
+	}
+
+	// Cooks the image in each block format and compares every level against
+	// the uncompressed mip chain. Returns 1 when the top level of any format
+	// falls under minPsnr, which a working encoder clears on any real image.
+	// "synthetic" cooks a generated image instead of loading one, against
+	// tighter limits since its PSNR is known, on the mean over the chain as
+	// well: a biased endpoint fit hides in the top level but not the small ones.
+	int RunTextureCook(const char* path)
+	{
+		const bool synthetic = std::strcmp(path, "synthetic") == 0;
+		const double minPsnr = synthetic ? 35.0 : 30.0;
+		const double minMeanPsnr = synthetic ? 30.0 : 0.0;
+		const Image image = synthetic ? MakeImage() : Image::Load(path);
+		JobSystem jobs;
+		CookedTexture::Options options;
+		options.pJobs = &jobs;
+		const std::vector<Image> mips = MipChain::Build(image, options.mips);
+		int exitCode = 0;
+		for (const CookedTexture::Format format : { CookedTexture::Format::BC1, CookedTexture::Format::BC3, CookedTexture::Format::BC7 })
+		{
+			options.format = format;
+			const CookedTexture texture = CookedTexture::Cook(image, options);
+			const CookedTexture::Stats& stats = texture.GetStats();
+			const bool alpha = format != CookedTexture::Format::BC1;
+			double top = 0.0;
+			double sum = 0.0;
+			for (size_t i = 0; i < texture.GetLevelCount(); i++)
+			{
+				const double psnr = Bc::ComputePsnr(mips[i], texture.DecodeLevel(i), alpha);
+				top = i == 0u ? psnr : top;
+				// an exact level would make the average infinite
+				sum += std::min(psnr, 99.0);
+			}
+			const double mean = sum / double(texture.GetLevelCount());
+			const bool below = top < minPsnr || mean < minMeanPsnr;
+			std::printf("%s %ux%u: %zu blocks in %.3fms on %u threads (%.0f blocks/s), %.1fx smaller, PSNR %s top %.2f dB mean %.2f dB%s\n",
+				CookedTexture::GetFormatName(format), image.GetWidth(), image.GetHeight(), stats.blocks,
+				stats.encodeSeconds * 1000.0, stats.threads, stats.encodeSeconds > 0.0 ? double(stats.blocks) / stats.encodeSeconds : 0.0,
+				texture.GetCompressionRatio(), alpha ? "RGBA" : "RGB", top, mean,
+				below ? " BELOW LIMIT" : "");
+			if (below)
+			{
+				exitCode = 1;
+			}
+		}
+		return exitCode;
+	}
+}
+
+namespace Headless
+{
+	int RunTexture(const char* path, const Options& /*options*/)
+	{
+		return RunTextureCook(path);
+	}
+}
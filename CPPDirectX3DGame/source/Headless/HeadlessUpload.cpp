@@ -0,0 +1,187 @@
+#include "Headless/HeadlessModes.h"
+#include "Render/Upload/CpuUploadBuffer.h"
+#include "Render/Upload/FakeFrameFence.h"
+#include "Render/Upload/UploadRing.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Headless::Checker;
+
+	constexpr size_t ringSize = 64u * 1024u;
+
+	// a slice written with a pattern, to find it overwritten later
+	struct Written
+	{
+		UploadRing::Allocation allocation;
+		uint8_t pattern;
+	};
+
+	bool Intact(const Written& w) noexcept
+	{
+		const uint8_t* p = static_cast<const uint8_t*>(w.allocation.pData);
+		for (size_t i = 0; i < w.allocation.size; i++)
+		{
+			if (p[i] != w.pattern)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Frames of random sized and aligned uploads, flushed a few times a
+	// frame the way draws do. Every slice is checked against a model of the
+	// head: aligned, where the model puts it, inside the ring and after the
+	// one before in its generation, whose bytes it must not touch. Wraps
+	// bump the generation and map with Discard, every other map within and
+	// across frames is NoOverwrite.
+	void CheckAllocations(size_t frames, Checker& checker)
+	{
+		std::mt19937 rng(18u);
+		CpuUploadBuffer buffer(ringSize);
+		FakeFrameFence fence(1u);
+		UploadRing ring(buffer, fence, 2u);
+		size_t head = 0u;
+		uint64_t generation = 0u;
+		uint64_t maps = 0u;
+		uint64_t wraps = 0u;
+		std::byte* pBase = nullptr;
+		std::vector<Written> current;
+		bool aligned = true;
+		bool placed = true;
+		bool intact = true;
+		bool mapsOk = true;
+		for (uint64_t f = 1u; f <= frames; f++)
+		{
+			uint64_t frameWraps = 0u;
+			uint64_t frameMaps = 0u;
+			const unsigned int flushes = 1u + rng() % 4u;
+			for (unsigned int s = 0; s < flushes; s++)
+			{
+				const unsigned int count = 1u + rng() % 32u;
+				for (unsigned int i = 0; i < count; i++)
+				{
+					const size_t size = 1u + rng() % 2048u;
+					const size_t alignment = size_t(1u) << (rng() % 9u);
+					size_t offset = (head + alignment - 1u) & ~(alignment - 1u);
+					const bool wrap = offset + size > ringSize;
+					if (wrap)
+					{
+						offset = 0u;
+						generation++;
+						frameWraps++;
+						current.clear();
+					}
+					frameMaps += wrap || i == 0u ? 1u : 0u;
+					const UploadRing::Allocation a = ring.Allocate(size, alignment);
+					pBase = pBase == nullptr ? static_cast<std::byte*>(a.pData) - a.offset : pBase;
+					aligned = aligned && a.offset % alignment == 0u;
+					placed = placed && a.offset == offset && a.size == size && a.generation == generation &&
+						a.offset + a.size <= ringSize && static_cast<std::byte*>(a.pData) == pBase + a.offset;
+					const uint8_t pattern = uint8_t(rng());
+					std::memset(a.pData, pattern, size);
+					current.push_back({ a, pattern });
+					head = offset + size;
+				}
+				// what was written before in this generation is still there
+				for (const Written& w : current)
+				{
+					intact = intact && Intact(w);
+				}
+				ring.Flush();
+				mapsOk = mapsOk && !buffer.IsMapped();
+			}
+			maps += frameMaps;
+			wraps += frameWraps;
+			mapsOk = mapsOk && ring.GetFrameStats().maps == frameMaps && ring.GetFrameStats().wraps == frameWraps;
+			ring.EndFrame(f);
+			fence.Signal(f);
+		}
+		checker.Expect(aligned, "allocations", "a slice is not aligned");
+		checker.Expect(placed, "allocations", "a slice is not where the head puts it or its generation is wrong");
+		checker.Expect(intact, "allocations", "a slice overwrote an earlier one of its generation");
+		checker.Expect(mapsOk, "allocations", "maps or wraps per frame miscounted, or the buffer stayed mapped");
+		checker.Expect(wraps > 0u, "allocations", "the ring never wrapped");
+		const CpuUploadBuffer::Stats stats = buffer.GetStats();
+		// the very first map discards too
+		checker.Expect(stats.discards == wraps + 1u && stats.discards + stats.noOverwrites == maps, "allocations",
+			"Discard is not used exactly for the first map and the wraps");
+	}
+
+	// Frames end before their fence is signaled. With a GPU further behind
+	// than maxFramesInFlight allows every frame past the first few waits
+	// once, on one closer it never does.
+	void CheckFence(unsigned int latency, unsigned int maxFramesInFlight, size_t frames, Checker& checker)
+	{
+		CpuUploadBuffer buffer(ringSize);
+		FakeFrameFence fence(latency);
+		UploadRing ring(buffer, fence, maxFramesInFlight);
+		uint64_t waits = 0u;
+		bool inFlight = true;
+		for (uint64_t f = 1u; f <= frames; f++)
+		{
+			ring.Allocate(256u);
+			ring.EndFrame(f);
+			waits += ring.GetStats().waits;
+			// the frame just ended plus the ones the GPU has not finished
+			inFlight = inFlight && ring.GetBytesInFlight() <= size_t(maxFramesInFlight) * 256u;
+			fence.Signal(f);
+		}
+		const uint64_t expected = latency >= maxFramesInFlight && frames > maxFramesInFlight ? frames - maxFramesInFlight : 0u;
+		char scenario[64];
+		std::snprintf(scenario, sizeof(scenario), "fence latency %u in flight %u", latency, maxFramesInFlight);
+		checker.Expect(waits == expected && fence.GetWaitCount() == expected, scenario, "waits differ from the frames over the limit");
+		checker.Expect(inFlight, scenario, "more frames in flight than allowed");
+	}
+
+	// An upload larger than the ring throws and leaves the ring usable, one
+	// of exactly its size wraps to the start.
+	void CheckOversize(Checker& checker)
+	{
+		CpuUploadBuffer buffer(ringSize);
+		FakeFrameFence fence;
+		UploadRing ring(buffer, fence);
+		ring.Allocate(100u);
+		bool threw = false;
+		try
+		{
+			ring.Allocate(ringSize + 1u);
+		}
+		catch (const UploadRing::Exception&)
+		{
+			threw = true;
+		}
+		checker.Expect(threw, "oversize", "an upload larger than the ring did not throw");
+		const UploadRing::Allocation whole = ring.Allocate(ringSize);
+		checker.Expect(whole.offset == 0u && whole.generation == 1u, "oversize", "an upload of the whole ring did not wrap");
+		const UploadRing::Allocation next = ring.Allocate(16u);
+		checker.Expect(next.generation == 2u && next.offset == 0u, "oversize", "the ring did not wrap after being filled");
+	}
+
+	// Runs the upload ring over system memory and a simulated GPU and
+	// checks its allocations, maps and fence waits.
+	int RunUploadChecks(size_t frames)
+	{
+		Checker checker("upload");
+		CheckAllocations(frames, checker);
+		CheckFence(3u, 2u, frames, checker);
+		CheckFence(2u, 2u, frames, checker);
+		CheckFence(1u, 2u, frames, checker);
+		CheckFence(4u, 1u, frames, checker);
+		CheckOversize(checker);
+		std::printf("upload: %zu frames, %d failed checks\n", frames, checker.GetFailures());
+		return checker.GetResult();
+	}
+}
+
+namespace Headless
+{
+	int RunUpload(const char* frames, const Options& /*options*/)
+	{
+		return RunUploadChecks(ParseCount(frames));
+	}
+}
@@ -0,0 +1,107 @@
+#include "Input/InputRecorder.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+unsigned int InputRecorder::GetFieldCount(Type type) noexcept
+{
+	switch (type)
+	{
+	case Type::KeyPress:
+	case Type::KeyRelease:
+	case Type::Char:
+	case Type::Wheel:
+		return 1u;
+	case Type::MouseMove:
+	case Type::LPress:
+	case Type::LRelease:
+	case Type::RPress:
+	case Type::RRelease:
+	case Type::RawDelta:
+		return 2u;
+	default:
+		return 0u;
+	}
+}
+
+InputRecorder::InputRecorder(double frameSeconds)
+	:
+	start(OTimer::Now()),
+	frameSeconds(frameSeconds)
+{
+	Reset();
+}
+
+void InputRecorder::BeginFrame(uint64_t frameIndex) noexcept
+{
+	frame.store(frameIndex, std::memory_order_relaxed);
+}
+
+void InputRecorder::Record(Type type, OTimer::Ticks timestamp, int a, int b)
+{
+	const uint64_t f = frame.load(std::memory_order_relaxed);
+	// relative to the start so streams do not depend on the machine's uptime,
+	// clamped so out of order stamps never produce a negative delta
+	const OTimer::Ticks t = std::max(timestamp - start, lastTime);
+	data.push_back(uint8_t(type));
+	WriteVarint(f - std::min(f, lastFrame));
+	WriteVarint(uint64_t(t - lastTime));
+	const auto zigZag = [](int v) { return (uint64_t(int64_t(v)) << 1) ^ uint64_t(int64_t(v) >> 63); };
+	const unsigned int nFields = GetFieldCount(type);
+	if (nFields > 0u)
+	{
+		WriteVarint(zigZag(a));
+	}
+	if (nFields > 1u)
+	{
+		WriteVarint(zigZag(b));
+	}
+	lastFrame = std::max(f, lastFrame);
+	lastTime = t;
+	records++;
+}
+
+const std::vector<uint8_t>& InputRecorder::GetData() const noexcept
+{
+	return data;
+}
+
+size_t InputRecorder::GetRecordCount() const noexcept
+{
+	return records;
+}
+
+bool InputRecorder::Save(const std::string& path) const
+{
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+	file.close();
+	return !file.fail();
+}
+
+void InputRecorder::Reset()
+{
+	data.assign(headerSize, 0u);
+	std::memcpy(data.data(), magic, sizeof(magic));
+	data[4] = uint8_t(version & 0xFFu);
+	data[5] = uint8_t(version >> 8u);
+	std::memcpy(data.data() + 8u, &frameSeconds, sizeof(frameSeconds));
+	start = OTimer::Now();
+	lastFrame = frame.load(std::memory_order_relaxed);
+	lastTime = 0;
+	records = 0u;
+}
+
+void InputRecorder::WriteVarint(uint64_t value)
+{
+	while (value >= 0x80u)
+	{
+		data.push_back(uint8_t(value) | 0x80u);
+		value >>= 7u;
+	}
+	data.push_back(uint8_t(value));
+}
@@ -0,0 +1,196 @@
+#include "Input/InputReplay.h"
+#include "Input/Keyboard.h"
+#include "Input/Mouse.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#define REPLAY_EXCEPT(note) InputReplay::Exception(__LINE__, __FILE__, (note))
+
+InputReplay::InputReplay(std::vector<uint8_t> data)
+	:
+	data(std::move(data))
+{
+	if (this->data.size() < InputRecorder::headerSize ||
+		std::memcmp(this->data.data(), InputRecorder::magic, sizeof(InputRecorder::magic)) != 0)
+	{
+		throw REPLAY_EXCEPT("Not an input recording");
+	}
+	const uint16_t v = uint16_t(this->data[4] | (this->data[5] << 8u));
+	if (v != InputRecorder::version)
+	{
+		throw REPLAY_EXCEPT("Unsupported input recording version " + std::to_string(v));
+	}
+	std::memcpy(&frameSeconds, this->data.data() + 8u, sizeof(frameSeconds));
+	Rewind();
+}
+
+InputReplay InputReplay::Load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		throw REPLAY_EXCEPT("Cannot open " + path);
+	}
+	return InputReplay(std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+}
+
+size_t InputReplay::Feed(uint64_t frameIndex, Keyboard& kbd, Mouse& mouse)
+{
+	using Type = InputRecorder::Type;
+	size_t count = 0u;
+	while (hasNext && nextFrame <= frameIndex)
+	{
+		// events carry the recorded time, not the time of the replay
+		kbd.timeOverride = nextTime;
+		mouse.timeOverride = nextTime;
+		switch (nextType)
+		{
+		case Type::KeyPress:
+			kbd.OnKeyPressed(static_cast<unsigned char>(nextA));
+			break;
+		case Type::KeyRelease:
+			kbd.OnKeyReleased(static_cast<unsigned char>(nextA));
+			break;
+		case Type::Char:
+			kbd.OnChar(static_cast<char>(nextA));
+			break;
+		case Type::KeyClear:
+			kbd.ClearState();
+			break;
+		case Type::MouseMove:
+			mouse.OnMouseMove(nextA, nextB);
+			break;
+		case Type::MouseEnter:
+			mouse.OnMouseEnter();
+			break;
+		case Type::MouseLeave:
+			mouse.OnMouseLeave();
+			break;
+		case Type::LPress:
+			mouse.OnLeftPressed(nextA, nextB);
+			break;
+		case Type::LRelease:
+			mouse.OnLeftReleased(nextA, nextB);
+			break;
+		case Type::RPress:
+			mouse.OnRightPressed(nextA, nextB);
+			break;
+		case Type::RRelease:
+			mouse.OnRightReleased(nextA, nextB);
+			break;
+		case Type::Wheel:
+			mouse.OnWheelDelta(mouse.GetPosX(), mouse.GetPosY(), nextA);
+			break;
+		case Type::RawDelta:
+			mouse.OnRawDelta(nextA, nextB);
+			break;
+		default:
+			break;
+		}
+		kbd.timeOverride.reset();
+		mouse.timeOverride.reset();
+		count++;
+		replayed++;
+		ReadNext();
+	}
+	return count;
+}
+
+bool InputReplay::IsFinished() const noexcept
+{
+	return !hasNext;
+}
+
+double InputReplay::GetFrameSeconds() const noexcept
+{
+	return frameSeconds;
+}
+
+size_t InputReplay::GetReplayedCount() const noexcept
+{
+	return replayed;
+}
+
+void InputReplay::Rewind()
+{
+	offset = InputRecorder::headerSize;
+	replayed = 0u;
+	nextFrame = 0u;
+	nextTime = 0;
+	ReadNext();
+}
+
+uint64_t InputReplay::ReadVarint()
+{
+	uint64_t value = 0u;
+	for (unsigned int shift = 0u; shift < 64u; shift += 7u)
+	{
+		if (offset >= data.size())
+		{
+			throw REPLAY_EXCEPT("Input recording ends in the middle of an event");
+		}
+		const uint8_t byte = data[offset++];
+		value |= uint64_t(byte & 0x7Fu) << shift;
+		if (!(byte & 0x80u))
+		{
+			return value;
+		}
+	}
+	throw REPLAY_EXCEPT("Malformed varint in input recording");
+}
+
+int InputReplay::ReadField()
+{
+	const uint64_t v = ReadVarint();
+	return int(int64_t(v >> 1) ^ -int64_t(v & 1u));
+}
+
+void InputReplay::ReadNext()
+{
+	hasNext = offset < data.size();
+	if (!hasNext)
+	{
+		return;
+	}
+	const uint8_t type = data[offset++];
+	if (type >= uint8_t(InputRecorder::Type::Count))
+	{
+		throw REPLAY_EXCEPT("Unknown event type " + std::to_string(type) + " in input recording");
+	}
+	nextType = InputRecorder::Type(type);
+	nextFrame += ReadVarint();
+	nextTime += OTimer::Ticks(ReadVarint());
+	const unsigned int nFields = InputRecorder::GetFieldCount(nextType);
+	nextA = nFields > 0u ? ReadField() : 0;
+	nextB = nFields > 1u ? ReadField() : 0;
+}
+
+// Input replay exception
+InputReplay::Exception::Exception(int line, const char* file, std::string note) noexcept
+	:
+	OException(line, file),
+	note(std::move(note))
+{
+}
+
+const char* InputReplay::Exception::what() const noexcept
+{
+	std::ostringstream oss;
+	oss << GetType() << std::endl
+		<< "[Note] " << GetNote() << std::endl
+		<< GetOriginString();
+	whatBuffer = oss.str();
+	return whatBuffer.c_str();
+}
+
+const char* InputReplay::Exception::GetType() const noexcept
+{
+	return "O Input Replay Exception";
+}
+
+const std::string& InputReplay::Exception::GetNote() const noexcept
+{
+	return note;
+}
@@ -1,50 +1,54 @@
 #include "Input/Keyboard.h"
 
+Keyboard::Keyboard(size_t capacity)
+	:
+	keybuffer(capacity),
+	charbuffer(capacity)
+{
+}
+
 bool Keyboard::IsKeyPressed(unsigned char keycode) const noexcept
 {
-	return keystates[keycode];
+	return (keystates[keycode / 64u].load(std::memory_order_relaxed) >> (keycode % 64u)) & 1u;
 }
 
 std::optional<Keyboard::Event> Keyboard::ReadKey() noexcept
 {
-	if (keybuffer.size() > 0u)
-	{
-		Keyboard::Event e = keybuffer.front();
-		keybuffer.pop();
-		return e;
-	}
-	return {};
+	return keybuffer.Pop();
 }
 
 bool Keyboard::IsKeyEmpty() const noexcept
 {
-	return keybuffer.empty();
+	return keybuffer.IsEmpty();
 }
 
 std::optional<char> Keyboard::ReadChar() noexcept
 {
-	if (charbuffer.size() > 0u)
+	if (const auto e = charbuffer.Pop())
 	{
-		unsigned char charcode = charbuffer.front();
-		charbuffer.pop();
-		return charcode;
+		return e->GetChar();
 	}
-	return {};
+	return std::nullopt;
+}
+
+std::optional<Keyboard::CharEvent> Keyboard::ReadCharEvent() noexcept
+{
+	return charbuffer.Pop();
 }
 
 bool Keyboard::IsCharEmpty() const noexcept
 {
-	return charbuffer.empty();
+	return charbuffer.IsEmpty();
 }
 
 void Keyboard::FlushKey() noexcept
 {
-	keybuffer = std::queue<Event>();
+	keybuffer.Clear();
 }
 
 void Keyboard::FlushChar() noexcept
 {
-	charbuffer = std::queue<char>();
+	charbuffer.Clear();
 }
 
 void Keyboard::Flush() noexcept
@@ -53,6 +57,11 @@ void Keyboard::Flush() noexcept
 	FlushChar();
 }
 
+uint64_t Keyboard::GetOverflowCount() const noexcept
+{
+	return keybuffer.GetOverflowCount() + charbuffer.GetOverflowCount();
+}
+
 void Keyboard::EnableAutorepeat() noexcept
 {
 	autorepeatEnabled = true;
@@ -68,36 +77,56 @@ bool Keyboard::IsAutorepeatEnabled() const noexcept
 	return autorepeatEnabled;
 }
 
+void Keyboard::SetRecorder(InputRecorder* pRecorder) noexcept
+{
+	this->pRecorder = pRecorder;
+}
+
 void Keyboard::OnKeyPressed(unsigned char keycode) noexcept
 {
-	keystates[keycode] = true;
-	keybuffer.push(Keyboard::Event(Keyboard::Event::Type::Press, keycode));
-	TrimBuffer(keybuffer);
+	const OTimer::Ticks t = Now();
+	keystates[keycode / 64u].fetch_or(uint64_t(1u) << (keycode % 64u), std::memory_order_relaxed);
+	keybuffer.Push(Keyboard::Event(Keyboard::Event::Type::Press, keycode, t));
+	if (pRecorder)
+	{
+		pRecorder->Record(InputRecorder::Type::KeyPress, t, keycode);
+	}
 }
 
 void Keyboard::OnKeyReleased(unsigned char keycode) noexcept
 {
-	keystates[keycode] = false;
-	keybuffer.push(Keyboard::Event(Keyboard::Event::Type::Release, keycode));
-	TrimBuffer(keybuffer);
+	const OTimer::Ticks t = Now();
+	keystates[keycode / 64u].fetch_and(~(uint64_t(1u) << (keycode % 64u)), std::memory_order_relaxed);
+	keybuffer.Push(Keyboard::Event(Keyboard::Event::Type::Release, keycode, t));
+	if (pRecorder)
+	{
+		pRecorder->Record(InputRecorder::Type::KeyRelease, t, keycode);
+	}
 }
 
 void Keyboard::OnChar(char character) noexcept
 {
-	charbuffer.push(character);
-	TrimBuffer(charbuffer);
+	const OTimer::Ticks t = Now();
+	charbuffer.Push(Keyboard::CharEvent(character, t));
+	if (pRecorder)
+	{
+		pRecorder->Record(InputRecorder::Type::Char, t, static_cast<unsigned char>(character));
+	}
 }
 
 void Keyboard::ClearState() noexcept
 {
-	keystates.reset();
+	for (auto& word : keystates)
+	{
+		word.store(0u, std::memory_order_relaxed);
+	}
+	if (pRecorder)
+	{
+		pRecorder->Record(InputRecorder::Type::KeyClear, Now());
+	}
 }
 
-template<typename T>
-void Keyboard::TrimBuffer(std::queue<T>& buffer) noexcept
+OTimer::Ticks Keyboard::Now() const noexcept
 {
-	while (buffer.size() > bufferSize)
-	{
-		buffer.pop();
-	}
+	return timeOverride ? *timeOverride : OTimer::Now();
 }
@@ -1,30 +1,38 @@
-#include "OWin/OWin.h"
 #include "Input/Mouse.h"
 
+// WHEEL_DELTA, kept local so input builds without windows.h
+static constexpr int wheelDelta = 120;
+
+Mouse::Mouse(size_t capacity)
+	:
+	buffer(capacity)
+{
+}
+
 std::pair<int, int> Mouse::GetPos() const noexcept
 {
-	return { x,y };
+	const uint64_t p = pos.load(std::memory_order_relaxed);
+	return { int(uint32_t(p)), int(uint32_t(p >> 32u)) };
 }
 
 std::optional<Mouse::RawDelta> Mouse::ReadRawDelta() noexcept
 {
-	if (rawDeltaBuffer.empty())
-	{
-		return std::nullopt;
-	}
-	const RawDelta d = rawDeltaBuffer.front();
-	rawDeltaBuffer.pop();
-	return d;
+	return rawDelta.PopSample();
+}
+
+Mouse::RawDelta Mouse::ReadRawFrameDelta() noexcept
+{
+	return rawDelta.Take();
 }
 
 int Mouse::GetPosX() const noexcept
 {
-	return x;
+	return GetPos().first;
 }
 
 int Mouse::GetPosY() const noexcept
 {
-	return y;
+	return GetPos().second;
 }
 
 bool Mouse::IsInWindow() const noexcept
@@ -44,18 +52,55 @@ bool Mouse::IsRightPressed() const noexcept
 
 std::optional<Mouse::Event> Mouse::Read() noexcept
 {
-	if (buffer.size() > 0u)
+	while (true)
 	{
-		Mouse::Event e = buffer.front();
-		buffer.pop();
-		return e;
+		if (auto e = buffer.Pop())
+		{
+			return e;
+		}
+		const uint64_t state = pendingState.load(std::memory_order_acquire);
+		if (!(state & hasMove) || (state & writing))
+		{
+			return std::nullopt;
+		}
+		// everything queued is older than the held back move, and the window
+		// thread may have queued more since the buffer was empty
+		if (!buffer.IsEmpty())
+		{
+			continue;
+		}
+		const Event e = LoadPendingMove();
+		if (ClaimPendingMove(state))
+		{
+			return e;
+		}
 	}
-	return {};
+}
+
+bool Mouse::IsEmpty() const noexcept
+{
+	return buffer.IsEmpty() && !(pendingState.load(std::memory_order_acquire) & hasMove);
 }
 
 void Mouse::Flush() noexcept
 {
-	buffer = std::queue<Event>();
+	buffer.Clear();
+	uint64_t state = pendingState.load(std::memory_order_acquire);
+	// a move being written right now arrived after the flush
+	while ((state & hasMove) && !(state & writing) && !ClaimPendingMove(state))
+	{
+		state = pendingState.load(std::memory_order_acquire);
+	}
+}
+
+uint64_t Mouse::GetOverflowCount() const noexcept
+{
+	return buffer.GetOverflowCount() + rawDelta.GetOverflowCount();
+}
+
+uint64_t Mouse::GetCoalescedMoveCount() const noexcept
+{
+	return coalescedMoves.load(std::memory_order_relaxed);
 }
 
 void Mouse::EnableRaw() noexcept
@@ -73,107 +118,177 @@ bool Mouse::RawEnabled() const noexcept
 	return rawEnabled;
 }
 
-void Mouse::OnMouseMove(int newx, int newy) noexcept
+void Mouse::EnableRawSamples() noexcept
+{
+	rawDelta.EnableSamples();
+}
+
+void Mouse::DisableRawSamples() noexcept
 {
-	x = newx;
-	y = newy;
+	rawDelta.DisableSamples();
+}
 
-	buffer.push(Mouse::Event(Mouse::Event::Type::Move, *this));
-	TrimBuffer();
+void Mouse::SetRecorder(InputRecorder* pRecorder) noexcept
+{
+	this->pRecorder = pRecorder;
+}
+
+void Mouse::OnMouseMove(int newx, int newy) noexcept
+{
+	const OTimer::Ticks t = Now();
+	SetPos(newx, newy);
+	StorePendingMove(t);
+	Record(InputRecorder::Type::MouseMove, t, newx, newy);
 }
 
 void Mouse::OnMouseLeave() noexcept
 {
+	const OTimer::Ticks t = Now();
 	isInWindow = false;
-	buffer.push(Mouse::Event(Mouse::Event::Type::Leave, *this));
-	TrimBuffer();
+	Push(Mouse::Event(Mouse::Event::Type::Leave, *this, t));
+	Record(InputRecorder::Type::MouseLeave, t);
 }
 
 void Mouse::OnMouseEnter() noexcept
 {
+	const OTimer::Ticks t = Now();
 	isInWindow = true;
-	buffer.push(Mouse::Event(Mouse::Event::Type::Enter, *this));
-	TrimBuffer();
+	Push(Mouse::Event(Mouse::Event::Type::Enter, *this, t));
+	Record(InputRecorder::Type::MouseEnter, t);
 }
 
 void Mouse::OnRawDelta(int dx, int dy) noexcept
 {
-	rawDeltaBuffer.push({ dx,dy });
-	TrimBuffer();
+	const OTimer::Ticks t = Now();
+	rawDelta.Add(dx, dy, t);
+	Record(InputRecorder::Type::RawDelta, t, dx, dy);
 }
 
 void Mouse::OnLeftPressed(int x, int y) noexcept
 {
+	const OTimer::Ticks t = Now();
 	leftIsPressed = true;
 
-	buffer.push(Mouse::Event(Mouse::Event::Type::LPress, *this));
-	TrimBuffer();
+	Push(Mouse::Event(Mouse::Event::Type::LPress, *this, t));
+	Record(InputRecorder::Type::LPress, t, x, y);
 }
 
 void Mouse::OnLeftReleased(int x, int y) noexcept
 {
+	const OTimer::Ticks t = Now();
 	leftIsPressed = false;
 
-	buffer.push(Mouse::Event(Mouse::Event::Type::LRelease, *this));
-	TrimBuffer();
+	Push(Mouse::Event(Mouse::Event::Type::LRelease, *this, t));
+	Record(InputRecorder::Type::LRelease, t, x, y);
 }
 
 void Mouse::OnRightPressed(int x, int y) noexcept
 {
+	const OTimer::Ticks t = Now();
 	rightIsPressed = true;
 
-	buffer.push(Mouse::Event(Mouse::Event::Type::RPress, *this));
-	TrimBuffer();
+	Push(Mouse::Event(Mouse::Event::Type::RPress, *this, t));
+	Record(InputRecorder::Type::RPress, t, x, y);
 }
 
 void Mouse::OnRightReleased(int x, int y) noexcept
 {
+	const OTimer::Ticks t = Now();
 	rightIsPressed = false;
 
-	buffer.push(Mouse::Event(Mouse::Event::Type::RRelease, *this));
-	TrimBuffer();
+	Push(Mouse::Event(Mouse::Event::Type::RRelease, *this, t));
+	Record(InputRecorder::Type::RRelease, t, x, y);
 }
 
-void Mouse::OnWheelUp(int x, int y) noexcept
+void Mouse::OnWheelUp(int /*x*/, int /*y*/) noexcept
 {
-	buffer.push(Mouse::Event(Mouse::Event::Type::WheelUp, *this));
-	TrimBuffer();
+	Push(Mouse::Event(Mouse::Event::Type::WheelUp, *this, Now()));
 }
 
-void Mouse::OnWheelDown(int x, int y) noexcept
+void Mouse::OnWheelDown(int /*x*/, int /*y*/) noexcept
 {
-	buffer.push(Mouse::Event(Mouse::Event::Type::WheelDown, *this));
-	TrimBuffer();
+	Push(Mouse::Event(Mouse::Event::Type::WheelDown, *this, Now()));
 }
 
-void Mouse::TrimBuffer() noexcept
+void Mouse::OnWheelDelta(int x, int y, int delta) noexcept
 {
-	while (buffer.size() > bufferSize)
+	// recorded as the raw delta, replay regenerates the up/down events
+	Record(InputRecorder::Type::Wheel, Now(), delta);
+	wheelDeltaCarry += delta;
+	// generate events for every 120 
+	while (wheelDeltaCarry >= wheelDelta)
 	{
-		buffer.pop();
+		wheelDeltaCarry -= wheelDelta;
+		OnWheelUp(x, y);
+	}
+	while (wheelDeltaCarry <= -wheelDelta)
+	{
+		wheelDeltaCarry += wheelDelta;
+		OnWheelDown(x, y);
 	}
 }
 
-void Mouse::TrimRawInputBuffer() noexcept
+void Mouse::SetPos(int x, int y) noexcept
 {
-	while (rawDeltaBuffer.size() > bufferSize)
+	pos.store(uint64_t(uint32_t(x)) | (uint64_t(uint32_t(y)) << 32u), std::memory_order_relaxed);
+}
+
+void Mouse::Push(const Event& e) noexcept
+{
+	// publish the held back move first to keep the order, unless the
+	// consumer took it in the meantime
+	const uint64_t state = pendingState.load(std::memory_order_acquire);
+	if (state & hasMove)
 	{
-		rawDeltaBuffer.pop();
+		const Event move = LoadPendingMove();
+		if (ClaimPendingMove(state))
+		{
+			buffer.Push(move);
+		}
 	}
+	buffer.Push(e);
 }
 
-void Mouse::OnWheelDelta(int x, int y, int delta) noexcept
+void Mouse::Record(InputRecorder::Type type, OTimer::Ticks timestamp, int a, int b) noexcept
 {
-	wheelDeltaCarry += delta;
-	// generate events for every 120 
-	while (wheelDeltaCarry >= WHEEL_DELTA)
+	if (pRecorder)
 	{
-		wheelDeltaCarry -= WHEEL_DELTA;
-		OnWheelUp(x, y);
+		pRecorder->Record(type, timestamp, a, b);
 	}
-	while (wheelDeltaCarry <= -WHEEL_DELTA)
+}
+
+OTimer::Ticks Mouse::Now() const noexcept
+{
+	return timeOverride ? *timeOverride : OTimer::Now();
+}
+
+void Mouse::StorePendingMove(OTimer::Ticks timestamp) noexcept
+{
+	// claims fail from here on, so the move being replaced counts as folded
+	const uint64_t state = pendingState.fetch_or(writing, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	if (state & hasMove)
 	{
-		wheelDeltaCarry += WHEEL_DELTA;
-		OnWheelDown(x, y);
+		coalescedMoves.fetch_add(1u, std::memory_order_relaxed);
 	}
-}
\ No newline at end of file
+	pendingPos.store(pos.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	pendingTime.store(timestamp, std::memory_order_relaxed);
+	pendingButtons.store(uint8_t((leftIsPressed ? 1u : 0u) | (rightIsPressed ? 2u : 0u)), std::memory_order_relaxed);
+	// nobody else changes the state while writing is set
+	pendingState.store((state & ~(hasMove | writing)) + sequenceStep + hasMove, std::memory_order_release);
+}
+
+Mouse::Event Mouse::LoadPendingMove() const noexcept
+{
+	const uint64_t p = pendingPos.load(std::memory_order_relaxed);
+	const OTimer::Ticks t = pendingTime.load(std::memory_order_relaxed);
+	const uint8_t buttons = pendingButtons.load(std::memory_order_relaxed);
+	// keeps the loads ahead of the claim that validates them
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return Event(Event::Type::Move, int(uint32_t(p)), int(uint32_t(p >> 32u)), (buttons & 1u) != 0u, (buttons & 2u) != 0u, t);
+}
+
+bool Mouse::ClaimPendingMove(uint64_t state) noexcept
+{
+	return pendingState.compare_exchange_strong(state, state & ~hasMove, std::memory_order_acq_rel, std::memory_order_relaxed);
+}
@@ -0,0 +1,64 @@
+#include "Input/RawDeltaAccumulator.h"
+
+RawDeltaAccumulator::RawDeltaAccumulator(size_t sampleCapacity)
+	:
+	samples(sampleCapacity)
+{
+}
+
+void RawDeltaAccumulator::Add(int dx, int dy, OTimer::Ticks timestamp) noexcept
+{
+	sum.fetch_add(uint64_t(int64_t(dy) * (int64_t(1) << 32) + int64_t(dx)), std::memory_order_relaxed);
+	lastTimestamp.store(timestamp, std::memory_order_relaxed);
+	reports.fetch_add(1u, std::memory_order_relaxed);
+	if (samplesEnabled.load(std::memory_order_relaxed))
+	{
+		samples.Push({ dx, dy, timestamp });
+	}
+}
+
+RawDeltaAccumulator::Delta RawDeltaAccumulator::Take() noexcept
+{
+	const uint64_t packed = sum.exchange(0u, std::memory_order_relaxed);
+	// the low half holds x exactly, what is left above it is y
+	const int32_t x = int32_t(uint32_t(packed));
+	const int64_t y = int64_t(packed - uint64_t(int64_t(x))) / (int64_t(1) << 32);
+	return { x, int(y), lastTimestamp.load(std::memory_order_relaxed) };
+}
+
+std::optional<RawDeltaAccumulator::Delta> RawDeltaAccumulator::PopSample() noexcept
+{
+	return samples.Pop();
+}
+
+void RawDeltaAccumulator::EnableSamples() noexcept
+{
+	samplesEnabled = true;
+}
+
+void RawDeltaAccumulator::DisableSamples() noexcept
+{
+	samplesEnabled = false;
+	samples.Clear();
+}
+
+bool RawDeltaAccumulator::SamplesEnabled() const noexcept
+{
+	return samplesEnabled;
+}
+
+uint64_t RawDeltaAccumulator::GetReportCount() const noexcept
+{
+	return reports.load(std::memory_order_relaxed);
+}
+
+uint64_t RawDeltaAccumulator::GetOverflowCount() const noexcept
+{
+	return samples.GetOverflowCount();
+}
+
+void RawDeltaAccumulator::Clear() noexcept
+{
+	sum.store(0u, std::memory_order_relaxed);
+	samples.Clear();
+}
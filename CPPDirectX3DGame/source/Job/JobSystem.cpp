@@ -0,0 +1,500 @@
+#include "Job/JobSystem.h"
+#include "Job/WorkStealingDeque.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#define JOB_EXCEPT(note) JobSystem::Exception(__LINE__, __FILE__, (note))
+
+struct alignas(64) JobSystem::Job
+{
+	Function fn = nullptr;
+	void* context = nullptr;
+	Job* parent = nullptr;
+	// the job itself and its children that have not finished
+	std::atomic<int32_t> unfinished = 0;
+	// prerequisites that have not finished, plus one until Run
+	std::atomic<int32_t> pending = 0;
+	// set last, the slot can be reused from then on
+	std::atomic<bool> finished = true;
+	uint32_t nDependents = 0u;
+	Job* dependents[maxDependents] = {};
+	// written under errorMtx, children report into their parent's
+	std::exception_ptr error;
+	// a ParallelFor range keeps its bounds here instead of on the heap
+	alignas(8) std::byte payload[32] = {};
+};
+
+struct alignas(64) JobSystem::Worker
+{
+	WorkStealingDeque<Job, jobsPerThread> deque;
+	std::unique_ptr<Job[]> jobs = std::make_unique<Job[]>(jobsPerThread);
+	size_t nextJob = 0u;
+	uint32_t rng = 0u;
+	// guest deques only, set while a Guest holds it
+	std::atomic<bool> taken = false;
+	// written by the owner only
+	std::atomic<uint64_t> jobsRun = 0u;
+	std::atomic<uint64_t> steals = 0u;
+	std::atomic<uint64_t> failedSteals = 0u;
+	std::atomic<uint64_t> sleeps = 0u;
+};
+
+namespace
+{
+	// which system and deque the current thread belongs to
+	struct Binding
+	{
+		JobSystem* pSystem = nullptr;
+		unsigned int index = 0u;
+	};
+	thread_local Binding binding;
+
+	void Count(std::atomic<uint64_t>& counter) noexcept
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+	}
+
+	struct RangeShared
+	{
+		JobSystem::RangeFunction fn;
+		void* context;
+		size_t grain;
+	};
+
+	struct Range
+	{
+		const RangeShared* pShared;
+		// the ParallelFor's job, parent of every piece split off
+		JobSystem::Handle pRoot;
+		size_t begin;
+		size_t end;
+	};
+}
+
+JobSystem::JobSystem(unsigned int threads, unsigned int guests)
+{
+	if (threads == 0u)
+	{
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	firstGuest = threads;
+	for (unsigned int i = 0; i < threads + guests; i++)
+	{
+		workers.push_back(std::make_unique<Worker>());
+		workers.back()->rng = 0x9E3779B9u * (i + 1u);
+	}
+	// the constructing thread is thread 0, it helps in Wait
+	pPreviousSystem = binding.pSystem;
+	previousIndex = binding.index;
+	binding = { this, 0u };
+	try
+	{
+		for (unsigned int i = 1; i < threads; i++)
+		{
+			this->threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+		}
+	}
+	catch (...)
+	{
+		Stop();
+		throw;
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	Stop();
+}
+
+void JobSystem::Stop() noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMtx);
+		stopping.store(true, std::memory_order_release);
+	}
+	sleepCv.notify_all();
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	threads.clear();
+	if (binding.pSystem == this)
+	{
+		binding = { pPreviousSystem, previousIndex };
+	}
+}
+
+JobSystem::Handle JobSystem::Create(Function fn, void* context, Handle parent)
+{
+	return Make(GetThreadIndex(), fn, context, parent);
+}
+
+void JobSystem::AddDependency(Handle job, Handle prerequisite)
+{
+	if (prerequisite->nDependents == maxDependents)
+	{
+		throw JOB_EXCEPT("A job can have at most " + std::to_string(maxDependents) + " dependents");
+	}
+	job->pending.fetch_add(1, std::memory_order_relaxed);
+	prerequisite->dependents[prerequisite->nDependents++] = job;
+}
+
+void JobSystem::Run(Handle job)
+{
+	const unsigned int index = GetThreadIndex();
+	if (job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		Push(index, job);
+	}
+}
+
+void JobSystem::Wait(Handle job)
+{
+	const unsigned int index = GetThreadIndex();
+	while (!job->finished.load(std::memory_order_acquire))
+	{
+		if (Job* pNext = Find(index))
+		{
+			Execute(index, pNext);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+	if (job->error)
+	{
+		std::rethrow_exception(job->error);
+	}
+}
+
+bool JobSystem::IsFinished(Handle job) const noexcept
+{
+	return job->finished.load(std::memory_order_acquire);
+}
+
+void JobSystem::ParallelFor(size_t count, RangeFunction fn, void* context, size_t minChunk)
+{
+	O_PROFILE_FUNCTION();
+	if (count == 0u)
+	{
+		return;
+	}
+	// small enough chunks for every thread to get a share a few dozen
+	// times over, the splitting decides how many actually do
+	const size_t grain = std::max({ minChunk, count / (size_t(GetThreadCount()) * 32u), size_t(1u) });
+	// guests only help while they wait on their own jobs
+	if (threads.empty() || count <= grain)
+	{
+		fn(context, 0u, count);
+		return;
+	}
+	const RangeShared shared = { fn, context, grain };
+	Job* pRoot = Make(GetThreadIndex(), &JobSystem::RunRange, nullptr, nullptr);
+	const Range range = { &shared, pRoot, 0u, count };
+	static_assert(sizeof(Range) <= sizeof(Job::payload));
+	std::memcpy(pRoot->payload, &range, sizeof(range));
+	pRoot->context = pRoot->payload;
+	Run(pRoot);
+	Wait(pRoot);
+}
+
+unsigned int JobSystem::GetThreadCount() const noexcept
+{
+	return unsigned(workers.size());
+}
+
+JobSystem::Stats JobSystem::GetStats() const noexcept
+{
+	Stats stats;
+	for (const auto& pWorker : workers)
+	{
+		stats.jobs += pWorker->jobsRun.load(std::memory_order_relaxed);
+		stats.steals += pWorker->steals.load(std::memory_order_relaxed);
+		stats.failedSteals += pWorker->failedSteals.load(std::memory_order_relaxed);
+		stats.sleeps += pWorker->sleeps.load(std::memory_order_relaxed);
+	}
+	return stats;
+}
+
+void JobSystem::ResetStats() noexcept
+{
+	for (const auto& pWorker : workers)
+	{
+		pWorker->jobsRun.store(0u, std::memory_order_relaxed);
+		pWorker->steals.store(0u, std::memory_order_relaxed);
+		pWorker->failedSteals.store(0u, std::memory_order_relaxed);
+		pWorker->sleeps.store(0u, std::memory_order_relaxed);
+	}
+}
+
+unsigned int JobSystem::GetThreadIndex() const
+{
+	if (binding.pSystem != this)
+	{
+		throw JOB_EXCEPT("Jobs are made, run and waited on from the thread that made the system, from jobs or from guests");
+	}
+	return binding.index;
+}
+
+JobSystem::Job* JobSystem::Make(unsigned int index, Function fn, void* context, Job* parent)
+{
+	Worker& worker = *workers[index];
+	Job& job = worker.jobs[worker.nextJob % jobsPerThread];
+	if (!job.finished.load(std::memory_order_acquire))
+	{
+		throw JOB_EXCEPT("More than " + std::to_string(jobsPerThread) + " unfinished jobs made on one thread");
+	}
+	worker.nextJob++;
+	job.fn = fn;
+	job.context = context;
+	job.parent = parent;
+	job.unfinished.store(1, std::memory_order_relaxed);
+	job.pending.store(1, std::memory_order_relaxed);
+	job.finished.store(false, std::memory_order_relaxed);
+	job.nDependents = 0u;
+	job.error = nullptr;
+	if (parent)
+	{
+		parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+	}
+	return &job;
+}
+
+void JobSystem::Push(unsigned int index, Job* pJob) noexcept
+{
+	if (!workers[index]->deque.Push(pJob))
+	{
+		// full, nobody is short of work then
+		Execute(index, pJob);
+		return;
+	}
+	// pairs with the fence in Sleep: either the sleeper sees the job or we see the sleeper
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (sleepers.load(std::memory_order_relaxed) > 0u)
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleepMtx);
+			wakeGeneration++;
+		}
+		sleepCv.notify_one();
+	}
+}
+
+JobSystem::Job* JobSystem::Find(unsigned int index) noexcept
+{
+	Worker& worker = *workers[index];
+	if (Job* pJob = worker.deque.Pop())
+	{
+		return pJob;
+	}
+	const size_t count = workers.size();
+	if (count == 1u)
+	{
+		return nullptr;
+	}
+	// xorshift, a random first victim spreads the thieves out
+	worker.rng ^= worker.rng << 13;
+	worker.rng ^= worker.rng >> 17;
+	worker.rng ^= worker.rng << 5;
+	const size_t first = worker.rng % count;
+	for (size_t i = 0; i < count; i++)
+	{
+		const size_t victim = (first + i) % count;
+		if (victim == index)
+		{
+			continue;
+		}
+		if (Job* pJob = workers[victim]->deque.Steal())
+		{
+			Count(worker.steals);
+			return pJob;
+		}
+	}
+	Count(worker.failedSteals);
+	return nullptr;
+}
+
+void JobSystem::Execute(unsigned int index, Job* pJob) noexcept
+{
+	try
+	{
+		pJob->fn(pJob->context);
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lock(errorMtx);
+		if (!pJob->error)
+		{
+			pJob->error = std::current_exception();
+		}
+	}
+	Count(workers[index]->jobsRun);
+	Finish(index, pJob);
+}
+
+void JobSystem::Finish(unsigned int index, Job* pJob) noexcept
+{
+	if (pJob->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1)
+	{
+		return;
+	}
+	// nothing writes the job any more, read what is needed before it can be reused
+	Job* pParent = pJob->parent;
+	if (pParent && pJob->error)
+	{
+		std::lock_guard<std::mutex> lock(errorMtx);
+		if (!pParent->error)
+		{
+			pParent->error = pJob->error;
+		}
+	}
+	for (uint32_t i = 0; i < pJob->nDependents; i++)
+	{
+		if (pJob->dependents[i]->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Push(index, pJob->dependents[i]);
+		}
+	}
+	pJob->finished.store(true, std::memory_order_release);
+	if (pParent)
+	{
+		Finish(index, pParent);
+	}
+}
+
+void JobSystem::Sleep(unsigned int index)
+{
+	std::unique_lock<std::mutex> lock(sleepMtx);
+	const uint64_t seen = wakeGeneration;
+	sleepers.fetch_add(1u, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const bool work = std::any_of(workers.begin(), workers.end(), [](const auto& pWorker)
+	{
+		return !pWorker->deque.IsEmpty();
+	});
+	if (!work)
+	{
+		Count(workers[index]->sleeps);
+		sleepCv.wait(lock, [this, seen]
+		{
+			return stopping.load(std::memory_order_acquire) || wakeGeneration != seen;
+		});
+	}
+	sleepers.fetch_sub(1u, std::memory_order_relaxed);
+}
+
+void JobSystem::WorkerLoop(unsigned int index) noexcept
+{
+	binding = { this, index };
+	O_PROFILE_THREAD("Jobs");
+	// spin a little before sleeping, work tends to come in bursts
+	unsigned int idle = 0u;
+	while (!stopping.load(std::memory_order_acquire))
+	{
+		if (Job* pJob = Find(index))
+		{
+			Execute(index, pJob);
+			idle = 0u;
+		}
+		else if (++idle < 64u)
+		{
+			std::this_thread::yield();
+		}
+		else
+		{
+			Sleep(index);
+			idle = 0u;
+		}
+	}
+}
+
+void JobSystem::RunRange(void* context)
+{
+	Range range;
+	std::memcpy(&range, context, sizeof(range));
+	const RangeShared& shared = *range.pShared;
+	JobSystem& system = *binding.pSystem;
+	const unsigned int index = binding.index;
+	const Worker& worker = *system.workers[index];
+	while (range.begin < range.end)
+	{
+		// an empty deque means thieves took whatever was there, or nobody
+		// needed any; split the rest so the next thief finds something
+		if (range.end - range.begin > shared.grain && worker.deque.IsEmpty())
+		{
+			const size_t middle = range.begin + (range.end - range.begin) / 2u;
+			const Range half = { &shared, range.pRoot, middle, range.end };
+			Job* pHalf = system.Make(index, &JobSystem::RunRange, nullptr, range.pRoot);
+			std::memcpy(pHalf->payload, &half, sizeof(half));
+			pHalf->context = pHalf->payload;
+			system.Run(pHalf);
+			range.end = middle;
+		}
+		const size_t chunkEnd = std::min(range.begin + shared.grain, range.end);
+		shared.fn(shared.context, range.begin, chunkEnd);
+		range.begin = chunkEnd;
+	}
+}
+
+// Guest
+JobSystem::Guest::Guest(JobSystem& system)
+{
+	if (binding.pSystem == &system)
+	{
+		return;
+	}
+	for (unsigned int i = system.firstGuest; i < system.GetThreadCount(); i++)
+	{
+		if (!system.workers[i]->taken.exchange(true, std::memory_order_acquire))
+		{
+			pSystem = &system;
+			index = i;
+			pPreviousSystem = binding.pSystem;
+			previousIndex = binding.index;
+			binding = { pSystem, index };
+			return;
+		}
+	}
+	throw JOB_EXCEPT("More than " + std::to_string(system.GetThreadCount() - system.firstGuest) + " guests at the same time");
+}
+
+JobSystem::Guest::~Guest()
+{
+	if (!pSystem)
+	{
+		return;
+	}
+	binding = { pPreviousSystem, previousIndex };
+	pSystem->workers[index]->taken.store(false, std::memory_order_release);
+}
+
+// JobSystem exception
+JobSystem::Exception::Exception(int line, const char* file, std::string note) noexcept
+	:
+	OException(line, file),
+	note(std::move(note))
+{
+}
+
+const char* JobSystem::Exception::what() const noexcept
+{
+	std::ostringstream oss;
+	oss << GetType() << std::endl
+		<< "[Note] " << GetNote() << std::endl
+		<< GetOriginString();
+	whatBuffer = oss.str();
+	return whatBuffer.c_str();
+}
+
+const char* JobSystem::Exception::GetType() const noexcept
+{
+	return "O Job System Exception";
+}
+
+const std::string& JobSystem::Exception::GetNote() const noexcept
+{
+	return note;
+}
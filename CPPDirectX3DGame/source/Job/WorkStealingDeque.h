@@ -0,0 +1,84 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Chase-Lev deque of pointers with a fixed power of two capacity, in the
+// C11 formulation of Le, Pop, Cohen and Zappa Nardelli. The owning thread
+// pushes and pops at the bottom, any thread steals from the top; only the
+// last element is contended, and settled with one CAS on top. Push fails
+// when full instead of growing, callers run the item themselves then.
+template<typename T, size_t capacity>
+class WorkStealingDeque
+{
+	static_assert(capacity > 0u && (capacity & (capacity - 1u)) == 0u, "capacity must be a power of two");
+public:
+	// owner only
+	bool Push(T* pItem) noexcept
+	{
+		const int64_t b = bottom.load(std::memory_order_relaxed);
+		const int64_t t = top.load(std::memory_order_acquire);
+		if (b - t >= int64_t(capacity))
+		{
+			return false;
+		}
+		items[size_t(b) & mask].store(pItem, std::memory_order_relaxed);
+		// the paper's release fence and relaxed store, as one release store
+		// thread sanitizers can follow
+		bottom.store(b + 1, std::memory_order_release);
+		return true;
+	}
+	// owner only, newest first; nullptr when empty
+	T* Pop() noexcept
+	{
+		const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+		if (t > b)
+		{
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		T* pItem = items[size_t(b) & mask].load(std::memory_order_relaxed);
+		if (t == b)
+		{
+			// the last one, a thief may be after it too
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				pItem = nullptr;
+			}
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return pItem;
+	}
+	// any thread, oldest first; nullptr when empty or another thread won
+	T* Steal() noexcept
+	{
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t b = bottom.load(std::memory_order_acquire);
+		if (t >= b)
+		{
+			return nullptr;
+		}
+		T* pItem = items[size_t(t) & mask].load(std::memory_order_relaxed);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			return nullptr;
+		}
+		return pItem;
+	}
+	// a snapshot, exact only on the owning thread
+	bool IsEmpty() const noexcept
+	{
+		return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+	}
+private:
+	static constexpr size_t mask = capacity - 1u;
+	// apart so thieves hitting top do not keep invalidating the owner's bottom
+	alignas(64) std::atomic<int64_t> top = 0;
+	alignas(64) std::atomic<int64_t> bottom = 0;
+	alignas(64) std::array<std::atomic<T*>, capacity> items = {};
+};
@@ -0,0 +1,25 @@
+#pragma once
+#include "Math/BatchTransform.h"
+
+// Per instruction set implementations behind Math/BatchTransform.h. Each
+// kernel handles the first count - count % width elements itself and hands
+// the rest to the scalar kernel. The matrix comes in as plain floats so the
+// kernels can broadcast elements without touching XMVECTOR.
+namespace OMath::Batch::Kernels
+{
+	struct Table
+	{
+		void (*transformPoints)(const XMFLOAT4X4& m, ConstFloat3Array in, Float4Array out, size_t begin, size_t end) noexcept;
+		void (*multiplyMatrices)(ConstMatrixArray in, const XMFLOAT4X4& m, MatrixArray out, size_t begin, size_t end) noexcept;
+		void (*transformSpheres)(const XMFLOAT4X4& m, float radiusScale, ConstFloat3Array centers, const float* radii,
+			Float3Array outCenters, float* outRadii, size_t begin, size_t end) noexcept;
+		void (*transformAabbs)(const XMFLOAT4X4& m, ConstFloat3Array centers, ConstFloat3Array extents,
+			Float3Array outCenters, Float3Array outExtents, size_t begin, size_t end) noexcept;
+	};
+
+	const Table& GetScalar() noexcept;
+	// null when the instruction set is not compiled in for this target
+	const Table* GetSSE() noexcept;
+	const Table* GetAVX2() noexcept;
+	const Table* GetNEON() noexcept;
+}
@@ -0,0 +1,277 @@
+#include "Math/BatchTransform.h"
+#include "Math/BatchKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define O_MATH_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+#endif
+
+namespace
+{
+	using namespace OMath;
+	using namespace OMath::Batch;
+
+	void TransformPointsScalar(const XMFLOAT4X4& m, ConstFloat3Array in, Float4Array out, size_t begin, size_t end) noexcept
+	{
+		const auto& a = m.m;
+		for (size_t i = begin; i < end; i++)
+		{
+			const float x = in.x[i];
+			const float y = in.y[i];
+			const float z = in.z[i];
+			out.x[i] = x * a[0][0] + y * a[1][0] + z * a[2][0] + a[3][0];
+			out.y[i] = x * a[0][1] + y * a[1][1] + z * a[2][1] + a[3][1];
+			out.z[i] = x * a[0][2] + y * a[1][2] + z * a[2][2] + a[3][2];
+			out.w[i] = x * a[0][3] + y * a[1][3] + z * a[2][3] + a[3][3];
+		}
+	}
+
+	void MultiplyMatricesScalar(ConstMatrixArray in, const XMFLOAT4X4& m, MatrixArray out, size_t begin, size_t end) noexcept
+	{
+		const auto& b = m.m;
+		for (size_t i = begin; i < end; i++)
+		{
+			// read everything first, out may alias in
+			float a[4][4];
+			for (int r = 0; r < 4; r++)
+			{
+				for (int k = 0; k < 4; k++)
+				{
+					a[r][k] = in.m[r][k][i];
+				}
+			}
+			for (int r = 0; r < 4; r++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					out.m[r][c][i] = a[r][0] * b[0][c] + a[r][1] * b[1][c] + a[r][2] * b[2][c] + a[r][3] * b[3][c];
+				}
+			}
+		}
+	}
+
+	void TransformSpheresScalar(const XMFLOAT4X4& m, float radiusScale, ConstFloat3Array centers, const float* radii,
+		Float3Array outCenters, float* outRadii, size_t begin, size_t end) noexcept
+	{
+		const auto& a = m.m;
+		for (size_t i = begin; i < end; i++)
+		{
+			const float x = centers.x[i];
+			const float y = centers.y[i];
+			const float z = centers.z[i];
+			outCenters.x[i] = x * a[0][0] + y * a[1][0] + z * a[2][0] + a[3][0];
+			outCenters.y[i] = x * a[0][1] + y * a[1][1] + z * a[2][1] + a[3][1];
+			outCenters.z[i] = x * a[0][2] + y * a[1][2] + z * a[2][2] + a[3][2];
+			outRadii[i] = radii[i] * radiusScale;
+		}
+	}
+
+	void TransformAabbsScalar(const XMFLOAT4X4& m, ConstFloat3Array centers, ConstFloat3Array extents,
+		Float3Array outCenters, Float3Array outExtents, size_t begin, size_t end) noexcept
+	{
+		const auto& a = m.m;
+		for (size_t i = begin; i < end; i++)
+		{
+			const float x = centers.x[i];
+			const float y = centers.y[i];
+			const float z = centers.z[i];
+			const float ex = extents.x[i];
+			const float ey = extents.y[i];
+			const float ez = extents.z[i];
+			outCenters.x[i] = x * a[0][0] + y * a[1][0] + z * a[2][0] + a[3][0];
+			outCenters.y[i] = x * a[0][1] + y * a[1][1] + z * a[2][1] + a[3][1];
+			outCenters.z[i] = x * a[0][2] + y * a[1][2] + z * a[2][2] + a[3][2];
+			// Arvo: each new half extent is the old ones through |m|
+			outExtents.x[i] = ex * std::fabs(a[0][0]) + ey * std::fabs(a[1][0]) + ez * std::fabs(a[2][0]);
+			outExtents.y[i] = ex * std::fabs(a[0][1]) + ey * std::fabs(a[1][1]) + ez * std::fabs(a[2][1]);
+			outExtents.z[i] = ex * std::fabs(a[0][2]) + ey * std::fabs(a[1][2]) + ez * std::fabs(a[2][2]);
+		}
+	}
+
+	bool CpuSupports(Isa isa) noexcept
+	{
+		switch (isa)
+		{
+		case Isa::Scalar:
+			return true;
+		case Isa::SSE:
+#if defined(O_MATH_X86)
+			// SSE2 is part of x64 and required by this build on x86
+			return true;
+#else
+			return false;
+#endif
+		case Isa::AVX2:
+#if defined(O_MATH_X86) && defined(_MSC_VER)
+		{
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+			{
+				return false;
+			}
+			__cpuid(info, 1);
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			const bool fma = (info[2] & (1 << 12)) != 0;
+			if (!osxsave || !fma)
+			{
+				return false;
+			}
+			// the OS has to save the ymm registers
+			if ((_xgetbv(0) & 0x6) != 0x6)
+			{
+				return false;
+			}
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+		}
+#elif defined(O_MATH_X86)
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+			return false;
+#endif
+		case Isa::NEON:
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+			return true;
+#else
+			return false;
+#endif
+		default:
+			return false;
+		}
+	}
+
+	const Kernels::Table* GetTable(Isa isa) noexcept
+	{
+		switch (isa)
+		{
+		case Isa::Scalar:
+			return &Kernels::GetScalar();
+		case Isa::SSE:
+			return Kernels::GetSSE();
+		case Isa::AVX2:
+			return Kernels::GetAVX2();
+		case Isa::NEON:
+			return Kernels::GetNEON();
+		default:
+			return nullptr;
+		}
+	}
+
+	Isa DetectBest() noexcept
+	{
+		for (Isa isa : { Isa::AVX2, Isa::NEON, Isa::SSE })
+		{
+			if (IsSupported(isa))
+			{
+				return isa;
+			}
+		}
+		return Isa::Scalar;
+	}
+
+	std::atomic<Isa>& ActiveIsa() noexcept
+	{
+		static std::atomic<Isa> active = DetectBest();
+		return active;
+	}
+
+	const Kernels::Table& Active() noexcept
+	{
+		return *GetTable(ActiveIsa().load(std::memory_order_relaxed));
+	}
+
+	XMFLOAT4X4 ToFloats(FXMMATRIX m) noexcept
+	{
+		XMFLOAT4X4 f;
+		XMStoreFloat4x4(&f, m);
+		return f;
+	}
+}
+
+namespace OMath::Batch
+{
+	const Kernels::Table& Kernels::GetScalar() noexcept
+	{
+		static const Table table = {
+			TransformPointsScalar,
+			MultiplyMatricesScalar,
+			TransformSpheresScalar,
+			TransformAabbsScalar,
+		};
+		return table;
+	}
+
+	const char* GetIsaName(Isa isa) noexcept
+	{
+		switch (isa)
+		{
+		case Isa::Scalar:
+			return "scalar";
+		case Isa::SSE:
+			return "sse";
+		case Isa::AVX2:
+			return "avx2";
+		case Isa::NEON:
+			return "neon";
+		default:
+			return "unknown";
+		}
+	}
+
+	bool IsSupported(Isa isa) noexcept
+	{
+		return GetTable(isa) != nullptr && CpuSupports(isa);
+	}
+
+	Isa GetBestIsa() noexcept
+	{
+		static const Isa best = DetectBest();
+		return best;
+	}
+
+	Isa SetIsa(Isa isa) noexcept
+	{
+		const Isa chosen = IsSupported(isa) ? isa : GetBestIsa();
+		ActiveIsa().store(chosen, std::memory_order_relaxed);
+		return chosen;
+	}
+
+	Isa GetIsa() noexcept
+	{
+		return ActiveIsa().load(std::memory_order_relaxed);
+	}
+
+	void TransformPoints(FXMMATRIX m, ConstFloat3Array in, Float4Array out, size_t count) noexcept
+	{
+		Active().transformPoints(ToFloats(m), in, out, 0u, count);
+	}
+
+	void MultiplyMatrices(ConstMatrixArray in, FXMMATRIX m, MatrixArray out, size_t count) noexcept
+	{
+		Active().multiplyMatrices(in, ToFloats(m), out, 0u, count);
+	}
+
+	void TransformSpheres(FXMMATRIX m, ConstFloat3Array centers, const float* radii,
+		Float3Array outCenters, float* outRadii, size_t count) noexcept
+	{
+		// the longest basis vector bounds how far any point can move away from the center
+		const float scaleSq = std::max({
+			XMVectorGetX(XMVector3LengthSq(m.r[0])),
+			XMVectorGetX(XMVector3LengthSq(m.r[1])),
+			XMVectorGetX(XMVector3LengthSq(m.r[2])) });
+		Active().transformSpheres(ToFloats(m), std::sqrt(scaleSq), centers, radii, outCenters, outRadii, 0u, count);
+	}
+
+	void TransformAabbs(FXMMATRIX m, ConstFloat3Array centers, ConstFloat3Array extents,
+		Float3Array outCenters, Float3Array outExtents, size_t count) noexcept
+	{
+		Active().transformAabbs(ToFloats(m), centers, extents, outCenters, outExtents, 0u, count);
+	}
+}
@@ -0,0 +1,157 @@
+#include "Math/BatchKernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+// MSVC emits AVX intrinsics without /arch:AVX2, the dispatcher only calls
+// these after checking the CPU
+#define O_MATH_TARGET_AVX2
+#else
+#define O_MATH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+// Eight objects per register with fused multiply-add, so results can differ
+// from the other kernels in the last bit.
+namespace
+{
+	using namespace OMath;
+	using namespace OMath::Batch;
+
+	constexpr size_t width = 8u;
+
+	O_MATH_TARGET_AVX2 inline __m256 Madd(__m256 a, __m256 b, __m256 c) noexcept
+	{
+		return _mm256_fmadd_ps(a, b, c);
+	}
+
+	O_MATH_TARGET_AVX2 void TransformPointsAVX2(const XMFLOAT4X4& m, ConstFloat3Array in, Float4Array out, size_t begin, size_t end) noexcept
+	{
+		__m256 a[4][4];
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				a[r][c] = _mm256_set1_ps(m.m[r][c]);
+			}
+		}
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			const __m256 x = _mm256_loadu_ps(in.x + i);
+			const __m256 y = _mm256_loadu_ps(in.y + i);
+			const __m256 z = _mm256_loadu_ps(in.z + i);
+			_mm256_storeu_ps(out.x + i, _mm256_add_ps(Madd(z, a[2][0], Madd(y, a[1][0], _mm256_mul_ps(x, a[0][0]))), a[3][0]));
+			_mm256_storeu_ps(out.y + i, _mm256_add_ps(Madd(z, a[2][1], Madd(y, a[1][1], _mm256_mul_ps(x, a[0][1]))), a[3][1]));
+			_mm256_storeu_ps(out.z + i, _mm256_add_ps(Madd(z, a[2][2], Madd(y, a[1][2], _mm256_mul_ps(x, a[0][2]))), a[3][2]));
+			_mm256_storeu_ps(out.w + i, _mm256_add_ps(Madd(z, a[2][3], Madd(y, a[1][3], _mm256_mul_ps(x, a[0][3]))), a[3][3]));
+		}
+		Kernels::GetScalar().transformPoints(m, in, out, i, end);
+	}
+
+	O_MATH_TARGET_AVX2 void MultiplyMatricesAVX2(ConstMatrixArray in, const XMFLOAT4X4& m, MatrixArray out, size_t begin, size_t end) noexcept
+	{
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			__m256 a[4][4];
+			for (int r = 0; r < 4; r++)
+			{
+				for (int k = 0; k < 4; k++)
+				{
+					a[r][k] = _mm256_loadu_ps(in.m[r][k] + i);
+				}
+			}
+			for (int r = 0; r < 4; r++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					__m256 v = _mm256_mul_ps(a[r][0], _mm256_set1_ps(m.m[0][c]));
+					v = Madd(a[r][1], _mm256_set1_ps(m.m[1][c]), v);
+					v = Madd(a[r][2], _mm256_set1_ps(m.m[2][c]), v);
+					v = Madd(a[r][3], _mm256_set1_ps(m.m[3][c]), v);
+					_mm256_storeu_ps(out.m[r][c] + i, v);
+				}
+			}
+		}
+		Kernels::GetScalar().multiplyMatrices(in, m, out, i, end);
+	}
+
+	O_MATH_TARGET_AVX2 void TransformSpheresAVX2(const XMFLOAT4X4& m, float radiusScale, ConstFloat3Array centers, const float* radii,
+		Float3Array outCenters, float* outRadii, size_t begin, size_t end) noexcept
+	{
+		__m256 a[4][3];
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				a[r][c] = _mm256_set1_ps(m.m[r][c]);
+			}
+		}
+		const __m256 scale = _mm256_set1_ps(radiusScale);
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			const __m256 x = _mm256_loadu_ps(centers.x + i);
+			const __m256 y = _mm256_loadu_ps(centers.y + i);
+			const __m256 z = _mm256_loadu_ps(centers.z + i);
+			_mm256_storeu_ps(outCenters.x + i, _mm256_add_ps(Madd(z, a[2][0], Madd(y, a[1][0], _mm256_mul_ps(x, a[0][0]))), a[3][0]));
+			_mm256_storeu_ps(outCenters.y + i, _mm256_add_ps(Madd(z, a[2][1], Madd(y, a[1][1], _mm256_mul_ps(x, a[0][1]))), a[3][1]));
+			_mm256_storeu_ps(outCenters.z + i, _mm256_add_ps(Madd(z, a[2][2], Madd(y, a[1][2], _mm256_mul_ps(x, a[0][2]))), a[3][2]));
+			_mm256_storeu_ps(outRadii + i, _mm256_mul_ps(_mm256_loadu_ps(radii + i), scale));
+		}
+		Kernels::GetScalar().transformSpheres(m, radiusScale, centers, radii, outCenters, outRadii, i, end);
+	}
+
+	O_MATH_TARGET_AVX2 void TransformAabbsAVX2(const XMFLOAT4X4& m, ConstFloat3Array centers, ConstFloat3Array extents,
+		Float3Array outCenters, Float3Array outExtents, size_t begin, size_t end) noexcept
+	{
+		__m256 a[4][3];
+		__m256 abs[3][3];
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				a[r][c] = _mm256_set1_ps(m.m[r][c]);
+				if (r < 3)
+				{
+					abs[r][c] = _mm256_set1_ps(m.m[r][c] < 0.0f ? -m.m[r][c] : m.m[r][c]);
+				}
+			}
+		}
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			const __m256 x = _mm256_loadu_ps(centers.x + i);
+			const __m256 y = _mm256_loadu_ps(centers.y + i);
+			const __m256 z = _mm256_loadu_ps(centers.z + i);
+			const __m256 ex = _mm256_loadu_ps(extents.x + i);
+			const __m256 ey = _mm256_loadu_ps(extents.y + i);
+			const __m256 ez = _mm256_loadu_ps(extents.z + i);
+			_mm256_storeu_ps(outCenters.x + i, _mm256_add_ps(Madd(z, a[2][0], Madd(y, a[1][0], _mm256_mul_ps(x, a[0][0]))), a[3][0]));
+			_mm256_storeu_ps(outCenters.y + i, _mm256_add_ps(Madd(z, a[2][1], Madd(y, a[1][1], _mm256_mul_ps(x, a[0][1]))), a[3][1]));
+			_mm256_storeu_ps(outCenters.z + i, _mm256_add_ps(Madd(z, a[2][2], Madd(y, a[1][2], _mm256_mul_ps(x, a[0][2]))), a[3][2]));
+			_mm256_storeu_ps(outExtents.x + i, Madd(ez, abs[2][0], Madd(ey, abs[1][0], _mm256_mul_ps(ex, abs[0][0]))));
+			_mm256_storeu_ps(outExtents.y + i, Madd(ez, abs[2][1], Madd(ey, abs[1][1], _mm256_mul_ps(ex, abs[0][1]))));
+			_mm256_storeu_ps(outExtents.z + i, Madd(ez, abs[2][2], Madd(ey, abs[1][2], _mm256_mul_ps(ex, abs[0][2]))));
+		}
+		Kernels::GetScalar().transformAabbs(m, centers, extents, outCenters, outExtents, i, end);
+	}
+}
+
+const OMath::Batch::Kernels::Table* OMath::Batch::Kernels::GetAVX2() noexcept
+{
+	static const Table table = {
+		TransformPointsAVX2,
+		MultiplyMatricesAVX2,
+		TransformSpheresAVX2,
+		TransformAabbsAVX2,
+	};
+	return &table;
+}
+#else
+const OMath::Batch::Kernels::Table* OMath::Batch::Kernels::GetAVX2() noexcept
+{
+	return nullptr;
+}
+#endif
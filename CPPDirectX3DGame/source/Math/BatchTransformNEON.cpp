@@ -0,0 +1,148 @@
+#include "Math/BatchKernels.h"
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+
+// Four objects per register, the same shape as the SSE kernels.
+namespace
+{
+	using namespace OMath;
+	using namespace OMath::Batch;
+
+	constexpr size_t width = 4u;
+
+	inline float32x4_t Madd(float32x4_t a, float32x4_t b, float32x4_t c) noexcept
+	{
+		return vmlaq_f32(c, a, b);
+	}
+
+	void TransformPointsNEON(const XMFLOAT4X4& m, ConstFloat3Array in, Float4Array out, size_t begin, size_t end) noexcept
+	{
+		float32x4_t a[4][4];
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				a[r][c] = vdupq_n_f32(m.m[r][c]);
+			}
+		}
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			const float32x4_t x = vld1q_f32(in.x + i);
+			const float32x4_t y = vld1q_f32(in.y + i);
+			const float32x4_t z = vld1q_f32(in.z + i);
+			vst1q_f32(out.x + i, vaddq_f32(Madd(z, a[2][0], Madd(y, a[1][0], vmulq_f32(x, a[0][0]))), a[3][0]));
+			vst1q_f32(out.y + i, vaddq_f32(Madd(z, a[2][1], Madd(y, a[1][1], vmulq_f32(x, a[0][1]))), a[3][1]));
+			vst1q_f32(out.z + i, vaddq_f32(Madd(z, a[2][2], Madd(y, a[1][2], vmulq_f32(x, a[0][2]))), a[3][2]));
+			vst1q_f32(out.w + i, vaddq_f32(Madd(z, a[2][3], Madd(y, a[1][3], vmulq_f32(x, a[0][3]))), a[3][3]));
+		}
+		Kernels::GetScalar().transformPoints(m, in, out, i, end);
+	}
+
+	void MultiplyMatricesNEON(ConstMatrixArray in, const XMFLOAT4X4& m, MatrixArray out, size_t begin, size_t end) noexcept
+	{
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			float32x4_t a[4][4];
+			for (int r = 0; r < 4; r++)
+			{
+				for (int k = 0; k < 4; k++)
+				{
+					a[r][k] = vld1q_f32(in.m[r][k] + i);
+				}
+			}
+			for (int r = 0; r < 4; r++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					float32x4_t v = vmulq_f32(a[r][0], vdupq_n_f32(m.m[0][c]));
+					v = Madd(a[r][1], vdupq_n_f32(m.m[1][c]), v);
+					v = Madd(a[r][2], vdupq_n_f32(m.m[2][c]), v);
+					v = Madd(a[r][3], vdupq_n_f32(m.m[3][c]), v);
+					vst1q_f32(out.m[r][c] + i, v);
+				}
+			}
+		}
+		Kernels::GetScalar().multiplyMatrices(in, m, out, i, end);
+	}
+
+	void TransformSpheresNEON(const XMFLOAT4X4& m, float radiusScale, ConstFloat3Array centers, const float* radii,
+		Float3Array outCenters, float* outRadii, size_t begin, size_t end) noexcept
+	{
+		float32x4_t a[4][3];
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				a[r][c] = vdupq_n_f32(m.m[r][c]);
+			}
+		}
+		const float32x4_t scale = vdupq_n_f32(radiusScale);
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			const float32x4_t x = vld1q_f32(centers.x + i);
+			const float32x4_t y = vld1q_f32(centers.y + i);
+			const float32x4_t z = vld1q_f32(centers.z + i);
+			vst1q_f32(outCenters.x + i, vaddq_f32(Madd(z, a[2][0], Madd(y, a[1][0], vmulq_f32(x, a[0][0]))), a[3][0]));
+			vst1q_f32(outCenters.y + i, vaddq_f32(Madd(z, a[2][1], Madd(y, a[1][1], vmulq_f32(x, a[0][1]))), a[3][1]));
+			vst1q_f32(outCenters.z + i, vaddq_f32(Madd(z, a[2][2], Madd(y, a[1][2], vmulq_f32(x, a[0][2]))), a[3][2]));
+			vst1q_f32(outRadii + i, vmulq_f32(vld1q_f32(radii + i), scale));
+		}
+		Kernels::GetScalar().transformSpheres(m, radiusScale, centers, radii, outCenters, outRadii, i, end);
+	}
+
+	void TransformAabbsNEON(const XMFLOAT4X4& m, ConstFloat3Array centers, ConstFloat3Array extents,
+		Float3Array outCenters, Float3Array outExtents, size_t begin, size_t end) noexcept
+	{
+		float32x4_t a[4][3];
+		float32x4_t abs[3][3];
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				a[r][c] = vdupq_n_f32(m.m[r][c]);
+				if (r < 3)
+				{
+					abs[r][c] = vdupq_n_f32(m.m[r][c] < 0.0f ? -m.m[r][c] : m.m[r][c]);
+				}
+			}
+		}
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			const float32x4_t x = vld1q_f32(centers.x + i);
+			const float32x4_t y = vld1q_f32(centers.y + i);
+			const float32x4_t z = vld1q_f32(centers.z + i);
+			const float32x4_t ex = vld1q_f32(extents.x + i);
+			const float32x4_t ey = vld1q_f32(extents.y + i);
+			const float32x4_t ez = vld1q_f32(extents.z + i);
+			vst1q_f32(outCenters.x + i, vaddq_f32(Madd(z, a[2][0], Madd(y, a[1][0], vmulq_f32(x, a[0][0]))), a[3][0]));
+			vst1q_f32(outCenters.y + i, vaddq_f32(Madd(z, a[2][1], Madd(y, a[1][1], vmulq_f32(x, a[0][1]))), a[3][1]));
+			vst1q_f32(outCenters.z + i, vaddq_f32(Madd(z, a[2][2], Madd(y, a[1][2], vmulq_f32(x, a[0][2]))), a[3][2]));
+			vst1q_f32(outExtents.x + i, Madd(ez, abs[2][0], Madd(ey, abs[1][0], vmulq_f32(ex, abs[0][0]))));
+			vst1q_f32(outExtents.y + i, Madd(ez, abs[2][1], Madd(ey, abs[1][1], vmulq_f32(ex, abs[0][1]))));
+			vst1q_f32(outExtents.z + i, Madd(ez, abs[2][2], Madd(ey, abs[1][2], vmulq_f32(ex, abs[0][2]))));
+		}
+		Kernels::GetScalar().transformAabbs(m, centers, extents, outCenters, outExtents, i, end);
+	}
+}
+
+const OMath::Batch::Kernels::Table* OMath::Batch::Kernels::GetNEON() noexcept
+{
+	static const Table table = {
+		TransformPointsNEON,
+		MultiplyMatricesNEON,
+		TransformSpheresNEON,
+		TransformAabbsNEON,
+	};
+	return &table;
+}
+#else
+const OMath::Batch::Kernels::Table* OMath::Batch::Kernels::GetNEON() noexcept
+{
+	return nullptr;
+}
+#endif
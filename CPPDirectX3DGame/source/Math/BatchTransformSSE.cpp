@@ -0,0 +1,149 @@
+#include "Math/BatchKernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+
+// Four objects per register. SSE2 has no fused multiply-add, operations run
+// in the same order as in the scalar kernels.
+namespace
+{
+	using namespace OMath;
+	using namespace OMath::Batch;
+
+	constexpr size_t width = 4u;
+
+	inline __m128 Madd(__m128 a, __m128 b, __m128 c) noexcept
+	{
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+	}
+
+	void TransformPointsSSE(const XMFLOAT4X4& m, ConstFloat3Array in, Float4Array out, size_t begin, size_t end) noexcept
+	{
+		__m128 a[4][4];
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				a[r][c] = _mm_set1_ps(m.m[r][c]);
+			}
+		}
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			const __m128 x = _mm_loadu_ps(in.x + i);
+			const __m128 y = _mm_loadu_ps(in.y + i);
+			const __m128 z = _mm_loadu_ps(in.z + i);
+			_mm_storeu_ps(out.x + i, _mm_add_ps(Madd(z, a[2][0], Madd(y, a[1][0], _mm_mul_ps(x, a[0][0]))), a[3][0]));
+			_mm_storeu_ps(out.y + i, _mm_add_ps(Madd(z, a[2][1], Madd(y, a[1][1], _mm_mul_ps(x, a[0][1]))), a[3][1]));
+			_mm_storeu_ps(out.z + i, _mm_add_ps(Madd(z, a[2][2], Madd(y, a[1][2], _mm_mul_ps(x, a[0][2]))), a[3][2]));
+			_mm_storeu_ps(out.w + i, _mm_add_ps(Madd(z, a[2][3], Madd(y, a[1][3], _mm_mul_ps(x, a[0][3]))), a[3][3]));
+		}
+		Kernels::GetScalar().transformPoints(m, in, out, i, end);
+	}
+
+	void MultiplyMatricesSSE(ConstMatrixArray in, const XMFLOAT4X4& m, MatrixArray out, size_t begin, size_t end) noexcept
+	{
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			__m128 a[4][4];
+			for (int r = 0; r < 4; r++)
+			{
+				for (int k = 0; k < 4; k++)
+				{
+					a[r][k] = _mm_loadu_ps(in.m[r][k] + i);
+				}
+			}
+			for (int r = 0; r < 4; r++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					__m128 v = _mm_mul_ps(a[r][0], _mm_set1_ps(m.m[0][c]));
+					v = Madd(a[r][1], _mm_set1_ps(m.m[1][c]), v);
+					v = Madd(a[r][2], _mm_set1_ps(m.m[2][c]), v);
+					v = Madd(a[r][3], _mm_set1_ps(m.m[3][c]), v);
+					_mm_storeu_ps(out.m[r][c] + i, v);
+				}
+			}
+		}
+		Kernels::GetScalar().multiplyMatrices(in, m, out, i, end);
+	}
+
+	void TransformSpheresSSE(const XMFLOAT4X4& m, float radiusScale, ConstFloat3Array centers, const float* radii,
+		Float3Array outCenters, float* outRadii, size_t begin, size_t end) noexcept
+	{
+		__m128 a[4][3];
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				a[r][c] = _mm_set1_ps(m.m[r][c]);
+			}
+		}
+		const __m128 scale = _mm_set1_ps(radiusScale);
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			const __m128 x = _mm_loadu_ps(centers.x + i);
+			const __m128 y = _mm_loadu_ps(centers.y + i);
+			const __m128 z = _mm_loadu_ps(centers.z + i);
+			_mm_storeu_ps(outCenters.x + i, _mm_add_ps(Madd(z, a[2][0], Madd(y, a[1][0], _mm_mul_ps(x, a[0][0]))), a[3][0]));
+			_mm_storeu_ps(outCenters.y + i, _mm_add_ps(Madd(z, a[2][1], Madd(y, a[1][1], _mm_mul_ps(x, a[0][1]))), a[3][1]));
+			_mm_storeu_ps(outCenters.z + i, _mm_add_ps(Madd(z, a[2][2], Madd(y, a[1][2], _mm_mul_ps(x, a[0][2]))), a[3][2]));
+			_mm_storeu_ps(outRadii + i, _mm_mul_ps(_mm_loadu_ps(radii + i), scale));
+		}
+		Kernels::GetScalar().transformSpheres(m, radiusScale, centers, radii, outCenters, outRadii, i, end);
+	}
+
+	void TransformAabbsSSE(const XMFLOAT4X4& m, ConstFloat3Array centers, ConstFloat3Array extents,
+		Float3Array outCenters, Float3Array outExtents, size_t begin, size_t end) noexcept
+	{
+		__m128 a[4][3];
+		__m128 abs[3][3];
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				a[r][c] = _mm_set1_ps(m.m[r][c]);
+				if (r < 3)
+				{
+					abs[r][c] = _mm_set1_ps(m.m[r][c] < 0.0f ? -m.m[r][c] : m.m[r][c]);
+				}
+			}
+		}
+		size_t i = begin;
+		for (; i + width <= end; i += width)
+		{
+			const __m128 x = _mm_loadu_ps(centers.x + i);
+			const __m128 y = _mm_loadu_ps(centers.y + i);
+			const __m128 z = _mm_loadu_ps(centers.z + i);
+			const __m128 ex = _mm_loadu_ps(extents.x + i);
+			const __m128 ey = _mm_loadu_ps(extents.y + i);
+			const __m128 ez = _mm_loadu_ps(extents.z + i);
+			_mm_storeu_ps(outCenters.x + i, _mm_add_ps(Madd(z, a[2][0], Madd(y, a[1][0], _mm_mul_ps(x, a[0][0]))), a[3][0]));
+			_mm_storeu_ps(outCenters.y + i, _mm_add_ps(Madd(z, a[2][1], Madd(y, a[1][1], _mm_mul_ps(x, a[0][1]))), a[3][1]));
+			_mm_storeu_ps(outCenters.z + i, _mm_add_ps(Madd(z, a[2][2], Madd(y, a[1][2], _mm_mul_ps(x, a[0][2]))), a[3][2]));
+			_mm_storeu_ps(outExtents.x + i, Madd(ez, abs[2][0], Madd(ey, abs[1][0], _mm_mul_ps(ex, abs[0][0]))));
+			_mm_storeu_ps(outExtents.y + i, Madd(ez, abs[2][1], Madd(ey, abs[1][1], _mm_mul_ps(ex, abs[0][1]))));
+			_mm_storeu_ps(outExtents.z + i, Madd(ez, abs[2][2], Madd(ey, abs[1][2], _mm_mul_ps(ex, abs[0][2]))));
+		}
+		Kernels::GetScalar().transformAabbs(m, centers, extents, outCenters, outExtents, i, end);
+	}
+}
+
+const OMath::Batch::Kernels::Table* OMath::Batch::Kernels::GetSSE() noexcept
+{
+	static const Table table = {
+		TransformPointsSSE,
+		MultiplyMatricesSSE,
+		TransformSpheresSSE,
+		TransformAabbsSSE,
+	};
+	return &table;
+}
+#else
+const OMath::Batch::Kernels::Table* OMath::Batch::Kernels::GetSSE() noexcept
+{
+	return nullptr;
+}
+#endif
@@ -0,0 +1,264 @@
+#include "Memory/AllocationCounter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifndef O_NO_PROFILE
+namespace
+{
+	// relaxed, the counts only need to add up, not order anything
+	std::atomic<uint64_t> heapAllocations{ 0u };
+	std::atomic<uint64_t> heapFrees{ 0u };
+	std::atomic<uint64_t> heapBytes{ 0u };
+
+	void* Allocate(size_t size) noexcept
+	{
+		void* p = std::malloc(size > 0u ? size : 1u);
+		if (p)
+		{
+			heapAllocations.fetch_add(1u, std::memory_order_relaxed);
+			heapBytes.fetch_add(size, std::memory_order_relaxed);
+		}
+		return p;
+	}
+
+	void* AllocateAligned(size_t size, std::align_val_t alignment) noexcept
+	{
+		const size_t align = size_t(alignment);
+#ifdef _MSC_VER
+		void* p = _aligned_malloc(size > 0u ? size : 1u, align);
+#else
+		// aligned_alloc wants a multiple of the alignment
+		void* p = std::aligned_alloc(align, (std::max(size, size_t(1u)) + align - 1u) & ~(align - 1u));
+#endif
+		if (p)
+		{
+			heapAllocations.fetch_add(1u, std::memory_order_relaxed);
+			heapBytes.fetch_add(size, std::memory_order_relaxed);
+		}
+		return p;
+	}
+
+	void Free(void* p) noexcept
+	{
+		if (p)
+		{
+			heapFrees.fetch_add(1u, std::memory_order_relaxed);
+			std::free(p);
+		}
+	}
+
+	void FreeAligned(void* p) noexcept
+	{
+		if (p)
+		{
+			heapFrees.fetch_add(1u, std::memory_order_relaxed);
+#ifdef _MSC_VER
+			_aligned_free(p);
+#else
+			std::free(p);
+#endif
+		}
+	}
+
+	void* AllocateOrThrow(size_t size)
+	{
+		void* p = Allocate(size);
+		if (!p)
+		{
+			throw std::bad_alloc();
+		}
+		return p;
+	}
+
+	void* AllocateOrThrow(size_t size, std::align_val_t alignment)
+	{
+		void* p = AllocateAligned(size, alignment);
+		if (!p)
+		{
+			throw std::bad_alloc();
+		}
+		return p;
+	}
+}
+
+// Every replaceable form, so whatever the library or a new-expression
+// picks frees through the same allocator it came from; replacing only
+// some of them pairs the library's new with this delete.
+void* operator new(size_t size)
+{
+	return AllocateOrThrow(size);
+}
+
+void* operator new[](size_t size)
+{
+	return AllocateOrThrow(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return AllocateOrThrow(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return AllocateOrThrow(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* p) noexcept
+{
+	Free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	Free(p);
+}
+
+void operator delete(void* p, size_t /*size*/) noexcept
+{
+	Free(p);
+}
+
+void operator delete[](void* p, size_t /*size*/) noexcept
+{
+	Free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	Free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	Free(p);
+}
+
+void operator delete(void* p, std::align_val_t /*alignment*/) noexcept
+{
+	FreeAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t /*alignment*/) noexcept
+{
+	FreeAligned(p);
+}
+
+void operator delete(void* p, size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+	FreeAligned(p);
+}
+
+void operator delete[](void* p, size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+	FreeAligned(p);
+}
+
+void operator delete(void* p, std::align_val_t /*alignment*/, const std::nothrow_t&) noexcept
+{
+	FreeAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t /*alignment*/, const std::nothrow_t&) noexcept
+{
+	FreeAligned(p);
+}
+#endif
+
+namespace Memory
+{
+	HeapCounts GetHeapCounts() noexcept
+	{
+		HeapCounts counts;
+#ifndef O_NO_PROFILE
+		counts.allocations = heapAllocations.load(std::memory_order_relaxed);
+		counts.frees = heapFrees.load(std::memory_order_relaxed);
+		counts.bytes = heapBytes.load(std::memory_order_relaxed);
+#endif
+		return counts;
+	}
+
+	AllocationCounter::AllocationCounter() noexcept
+		:
+		last(GetHeapCounts())
+	{
+	}
+
+	void AllocationCounter::AddFrame(const LinearArena::Stats& arena) noexcept
+	{
+		const HeapCounts now = GetHeapCounts();
+		lastFrame.heapAllocations = now.allocations - last.allocations;
+		lastFrame.heapBytes = now.bytes - last.bytes;
+		lastFrame.arenaAllocations = arena.allocations;
+		lastFrame.arenaBytes = arena.bytes;
+		lastFrame.arenaOverflows = arena.overflows;
+		last = now;
+		total.heapAllocations += lastFrame.heapAllocations;
+		total.heapBytes += lastFrame.heapBytes;
+		total.arenaAllocations += lastFrame.arenaAllocations;
+		total.arenaBytes += lastFrame.arenaBytes;
+		total.arenaOverflows += lastFrame.arenaOverflows;
+		maxHeapAllocations = std::max(maxHeapAllocations, lastFrame.heapAllocations);
+		frames++;
+	}
+
+	const AllocationCounter::Frame& AllocationCounter::GetLastFrame() const noexcept
+	{
+		return lastFrame;
+	}
+
+	AllocationCounter::Summary AllocationCounter::GetSummary() const noexcept
+	{
+		Summary summary;
+		summary.frames = frames;
+		if (frames > 0u)
+		{
+			summary.heapAllocationsPerFrame = double(total.heapAllocations) / double(frames);
+			summary.heapBytesPerFrame = double(total.heapBytes) / double(frames);
+			summary.arenaAllocationsPerFrame = double(total.arenaAllocations) / double(frames);
+			summary.arenaBytesPerFrame = double(total.arenaBytes) / double(frames);
+		}
+		summary.maxHeapAllocations = maxHeapAllocations;
+		summary.arenaOverflows = total.arenaOverflows;
+		return summary;
+	}
+
+	const char* AllocationCounter::Format() noexcept
+	{
+		std::snprintf(text.data(), text.size(), "%llu allocs | arena %zu allocs %.1f KB",
+			static_cast<unsigned long long>(lastFrame.heapAllocations), lastFrame.arenaAllocations, double(lastFrame.arenaBytes) / 1024.0);
+		return text.data();
+	}
+
+	void AllocationCounter::Reset() noexcept
+	{
+		last = GetHeapCounts();
+		lastFrame = {};
+		total = {};
+		frames = 0u;
+		maxHeapAllocations = 0u;
+	}
+}
@@ -0,0 +1,74 @@
+#include "Memory/BlockPool.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace Memory
+{
+	BlockPool::BlockPool(size_t blockSize, size_t blocksPerPage, size_t alignment)
+		:
+		blockSize(std::max(blockSize, sizeof(FreeBlock))),
+		blocksPerPage(std::max(blocksPerPage, size_t(1u))),
+		alignment(std::max(alignment, alignof(FreeBlock)))
+	{
+		// every block starts aligned, and can hold the free list link
+		this->blockSize = (this->blockSize + this->alignment - 1u) / this->alignment * this->alignment;
+	}
+
+	void* BlockPool::Allocate()
+	{
+		if (!pFree)
+		{
+			AddPage();
+		}
+		FreeBlock* pBlock = pFree;
+		pFree = pBlock->pNext;
+		stats.allocations++;
+		stats.live++;
+		stats.peakLive = std::max(stats.peakLive, stats.live);
+		return pBlock;
+	}
+
+	void BlockPool::Free(void* p) noexcept
+	{
+		if (!p)
+		{
+			return;
+		}
+		FreeBlock* pBlock = static_cast<FreeBlock*>(p);
+		pBlock->pNext = pFree;
+		pFree = pBlock;
+		stats.frees++;
+		stats.live--;
+	}
+
+	void BlockPool::AddPage()
+	{
+		// the extra alignment bytes let the first block start aligned
+		std::unique_ptr<std::byte[]> page(new std::byte[blockSize * blocksPerPage + alignment]);
+		const uintptr_t base = reinterpret_cast<uintptr_t>(page.get());
+		std::byte* pFirst = page.get() + (((base + alignment - 1u) & ~uintptr_t(alignment - 1u)) - base);
+		// linked back to front so blocks are handed out in address order
+		for (size_t i = blocksPerPage; i-- > 0u;)
+		{
+			FreeBlock* pBlock = new(pFirst + i * blockSize) FreeBlock{ pFree };
+			pFree = pBlock;
+		}
+		pages.push_back(std::move(page));
+		stats.pages++;
+	}
+
+	size_t BlockPool::GetBlockSize() const noexcept
+	{
+		return blockSize;
+	}
+
+	size_t BlockPool::GetAlignment() const noexcept
+	{
+		return alignment;
+	}
+
+	const BlockPool::Stats& BlockPool::GetStats() const noexcept
+	{
+		return stats;
+	}
+}
@@ -0,0 +1,33 @@
+#include "Memory/FrameArenas.h"
+
+namespace Memory
+{
+	FrameArenas::FrameArenas(size_t capacity)
+		:
+		arenas{ LinearArena(capacity), LinearArena(capacity) },
+		resources{ ArenaResource(arenas[0]), ArenaResource(arenas[1]) }
+	{
+	}
+
+	void FrameArenas::BeginFrame()
+	{
+		lastFrame = arenas[current].GetStats();
+		current = (current + 1u) % frameCount;
+		arenas[current].Reset();
+	}
+
+	LinearArena& FrameArenas::Get() noexcept
+	{
+		return arenas[current];
+	}
+
+	std::pmr::memory_resource* FrameArenas::GetResource() noexcept
+	{
+		return &resources[current];
+	}
+
+	const LinearArena::Stats& FrameArenas::GetLastFrameStats() const noexcept
+	{
+		return lastFrame;
+	}
+}
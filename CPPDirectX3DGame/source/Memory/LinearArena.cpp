@@ -0,0 +1,70 @@
+#include "Memory/LinearArena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace Memory
+{
+	LinearArena::LinearArena(size_t capacity)
+	{
+		// default initialized, an arena block is never read before it is written
+		blocks.push_back({ std::unique_ptr<std::byte[]>(new std::byte[capacity]), capacity });
+		stats.capacity = capacity;
+	}
+
+	void* LinearArena::Allocate(size_t size, size_t alignment)
+	{
+		while (true)
+		{
+			Block& block = blocks[current];
+			const uintptr_t base = reinterpret_cast<uintptr_t>(block.pData.get());
+			const size_t aligned = size_t(((base + offset + alignment - 1u) & ~uintptr_t(alignment - 1u)) - base);
+			if (aligned <= block.size && size <= block.size - aligned)
+			{
+				offset = aligned + size;
+				stats.allocations++;
+				stats.bytes += size;
+				return block.pData.get() + aligned;
+			}
+			if (current + 1u == blocks.size())
+			{
+				// at least as large as the last one, so a long frame needs few of them
+				const size_t blockSize = std::max(size + alignment, block.size);
+				blocks.push_back({ std::unique_ptr<std::byte[]>(new std::byte[blockSize]), blockSize });
+				stats.overflows++;
+				stats.capacity += blockSize;
+			}
+			current++;
+			offset = 0u;
+		}
+	}
+
+	LinearArena::Marker LinearArena::GetMarker() const noexcept
+	{
+		return { current, offset };
+	}
+
+	void LinearArena::Rewind(Marker marker) noexcept
+	{
+		current = marker.block;
+		offset = marker.offset;
+	}
+
+	void LinearArena::Reset()
+	{
+		if (blocks.size() > 1u)
+		{
+			const size_t capacity = stats.capacity;
+			blocks.clear();
+			blocks.push_back({ std::unique_ptr<std::byte[]>(new std::byte[capacity]), capacity });
+		}
+		current = 0u;
+		offset = 0u;
+		stats = {};
+		stats.capacity = blocks[0].size;
+	}
+
+	const LinearArena::Stats& LinearArena::GetStats() const noexcept
+	{
+		return stats;
+	}
+}
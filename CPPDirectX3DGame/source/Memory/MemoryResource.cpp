@@ -0,0 +1,58 @@
+#include "Memory/MemoryResource.h"
+
+namespace Memory
+{
+	ArenaResource::ArenaResource(LinearArena& arena) noexcept
+		:
+		pArena(&arena)
+	{
+	}
+
+	void* ArenaResource::do_allocate(size_t bytes, size_t alignment)
+	{
+		return pArena->Allocate(bytes, alignment);
+	}
+
+	void ArenaResource::do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/)
+	{
+	}
+
+	bool ArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		return this == &other;
+	}
+
+	PoolResource::PoolResource(BlockPool& pool, std::pmr::memory_resource* pUpstream) noexcept
+		:
+		pPool(&pool),
+		pUpstream(pUpstream)
+	{
+	}
+
+	bool PoolResource::Fits(size_t bytes, size_t alignment) const noexcept
+	{
+		return bytes <= pPool->GetBlockSize() && alignment <= pPool->GetAlignment();
+	}
+
+	void* PoolResource::do_allocate(size_t bytes, size_t alignment)
+	{
+		return Fits(bytes, alignment) ? pPool->Allocate() : pUpstream->allocate(bytes, alignment);
+	}
+
+	void PoolResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+	{
+		if (Fits(bytes, alignment))
+		{
+			pPool->Free(p);
+		}
+		else
+		{
+			pUpstream->deallocate(p, bytes, alignment);
+		}
+	}
+
+	bool PoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		return this == &other;
+	}
+}
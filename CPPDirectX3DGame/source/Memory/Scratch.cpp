@@ -0,0 +1,55 @@
+#include "Memory/Scratch.h"
+
+namespace
+{
+	struct ThreadScratch
+	{
+		Memory::LinearArena arena{ Memory::Scratch::initialCapacity };
+		unsigned int depth = 0u;
+	};
+
+	ThreadScratch& GetThreadScratch()
+	{
+		thread_local ThreadScratch scratch;
+		return scratch;
+	}
+}
+
+namespace Memory
+{
+	Scratch::Scratch()
+		:
+		arena(GetThreadScratch().arena),
+		marker(arena.GetMarker()),
+		resource(arena)
+	{
+		GetThreadScratch().depth++;
+	}
+
+	Scratch::~Scratch()
+	{
+		arena.Rewind(marker);
+		// the outermost scope folds any overflow into one block for next time
+		if (--GetThreadScratch().depth == 0u && arena.GetStats().overflows > 0u)
+		{
+			try
+			{
+				arena.Reset();
+			}
+			catch (...)
+			{
+				// keeping the overflow blocks is fine too
+			}
+		}
+	}
+
+	void* Scratch::Allocate(size_t size, size_t alignment)
+	{
+		return arena.Allocate(size, alignment);
+	}
+
+	std::pmr::memory_resource* Scratch::GetResource() noexcept
+	{
+		return &resource;
+	}
+}
@@ -0,0 +1,788 @@
+#include "Mesh/Mesh.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+#define MESH_EXCEPT(note) Mesh::Exception(__LINE__, __FILE__, (note))
+
+// glTF 2.0: the JSON, the buffers it points at and the parts of the scene
+// that make up geometry. Materials, skins, morph targets, cameras and
+// animation are ignored; sparse accessors are not supported.
+namespace
+{
+	using namespace OMath;
+
+	// Just enough JSON for glTF: objects keep their members in file order,
+	// numbers are doubles. Nesting is limited so hostile files cannot run
+	// the stack out.
+	struct Json
+	{
+		enum class Type
+		{
+			Null,
+			Bool,
+			Number,
+			String,
+			Array,
+			Object,
+		};
+		Type type = Type::Null;
+		bool boolean = false;
+		double number = 0.0;
+		std::string string;
+		std::vector<Json> elements;
+		std::vector<std::pair<std::string, Json>> members;
+
+		const Json* Find(std::string_view key) const noexcept
+		{
+			for (const auto& member : members)
+			{
+				if (member.first == key)
+				{
+					return &member.second;
+				}
+			}
+			return nullptr;
+		}
+		double GetNumber(std::string_view key, double fallback) const noexcept
+		{
+			const Json* p = Find(key);
+			return p && p->type == Type::Number ? p->number : fallback;
+		}
+		const std::vector<Json>& GetArray(std::string_view key) const noexcept
+		{
+			static const std::vector<Json> empty;
+			const Json* p = Find(key);
+			return p && p->type == Type::Array ? p->elements : empty;
+		}
+	};
+
+	class JsonParser
+	{
+	public:
+		explicit JsonParser(std::string_view text) noexcept
+			:
+			text(text)
+		{
+		}
+		Json Parse()
+		{
+			Json value = ParseValue(0u);
+			SkipSpace();
+			if (pos != text.size())
+			{
+				Fail("trailing characters");
+			}
+			return value;
+		}
+	private:
+		static constexpr unsigned int maxDepth = 64u;
+
+		[[noreturn]] void Fail(const char* what) const
+		{
+			throw MESH_EXCEPT(std::string("glTF JSON: ") + what + " at offset " + std::to_string(pos));
+		}
+		void SkipSpace() noexcept
+		{
+			while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r'))
+			{
+				pos++;
+			}
+		}
+		bool Consume(char c) noexcept
+		{
+			SkipSpace();
+			if (pos < text.size() && text[pos] == c)
+			{
+				pos++;
+				return true;
+			}
+			return false;
+		}
+		void Expect(char c)
+		{
+			if (!Consume(c))
+			{
+				Fail("unexpected character");
+			}
+		}
+		bool ConsumeWord(std::string_view word) noexcept
+		{
+			if (text.substr(pos, word.size()) == word)
+			{
+				pos += word.size();
+				return true;
+			}
+			return false;
+		}
+		Json ParseValue(unsigned int depth)
+		{
+			if (depth > maxDepth)
+			{
+				Fail("nested too deep");
+			}
+			SkipSpace();
+			if (pos >= text.size())
+			{
+				Fail("unexpected end");
+			}
+			Json value;
+			const char c = text[pos];
+			if (c == '{')
+			{
+				pos++;
+				value.type = Json::Type::Object;
+				if (Consume('}'))
+				{
+					return value;
+				}
+				do
+				{
+					SkipSpace();
+					std::string key = ParseString();
+					Expect(':');
+					value.members.emplace_back(std::move(key), ParseValue(depth + 1u));
+				} while (Consume(','));
+				Expect('}');
+			}
+			else if (c == '[')
+			{
+				pos++;
+				value.type = Json::Type::Array;
+				if (Consume(']'))
+				{
+					return value;
+				}
+				do
+				{
+					value.elements.push_back(ParseValue(depth + 1u));
+				} while (Consume(','));
+				Expect(']');
+			}
+			else if (c == '"')
+			{
+				value.type = Json::Type::String;
+				value.string = ParseString();
+			}
+			else if (ConsumeWord("true") || ConsumeWord("false"))
+			{
+				value.type = Json::Type::Bool;
+				value.boolean = c == 't';
+			}
+			else if (ConsumeWord("null"))
+			{
+				value.type = Json::Type::Null;
+			}
+			else
+			{
+				value.type = Json::Type::Number;
+				const auto [p, ec] = std::from_chars(text.data() + pos, text.data() + text.size(), value.number);
+				if (ec != std::errc())
+				{
+					Fail("bad value");
+				}
+				pos = size_t(p - text.data());
+			}
+			return value;
+		}
+		std::string ParseString()
+		{
+			if (pos >= text.size() || text[pos] != '"')
+			{
+				Fail("expected a string");
+			}
+			pos++;
+			std::string out;
+			while (true)
+			{
+				if (pos >= text.size())
+				{
+					Fail("unterminated string");
+				}
+				const char c = text[pos++];
+				if (c == '"')
+				{
+					return out;
+				}
+				if (c != '\\')
+				{
+					out.push_back(c);
+					continue;
+				}
+				if (pos >= text.size())
+				{
+					Fail("unterminated string");
+				}
+				const char e = text[pos++];
+				switch (e)
+				{
+				case 'b': out.push_back('\b'); break;
+				case 'f': out.push_back('\f'); break;
+				case 'n': out.push_back('\n'); break;
+				case 'r': out.push_back('\r'); break;
+				case 't': out.push_back('\t'); break;
+				case 'u':
+				{
+					// names in glTF files are what this is for, surrogate
+					// pairs come out as two 3-byte sequences
+					unsigned int code = 0u;
+					if (pos + 4u > text.size() || std::from_chars(text.data() + pos, text.data() + pos + 4u, code, 16).ptr != text.data() + pos + 4u)
+					{
+						Fail("bad escape");
+					}
+					pos += 4u;
+					if (code < 0x80u)
+					{
+						out.push_back(char(code));
+					}
+					else if (code < 0x800u)
+					{
+						out.push_back(char(0xC0u | (code >> 6)));
+						out.push_back(char(0x80u | (code & 0x3Fu)));
+					}
+					else
+					{
+						out.push_back(char(0xE0u | (code >> 12)));
+						out.push_back(char(0x80u | ((code >> 6) & 0x3Fu)));
+						out.push_back(char(0x80u | (code & 0x3Fu)));
+					}
+					break;
+				}
+				default:
+					out.push_back(e);
+					break;
+				}
+			}
+		}
+	private:
+		std::string_view text;
+		size_t pos = 0u;
+	};
+
+	std::vector<std::byte> DecodeBase64(std::string_view text)
+	{
+		std::vector<std::byte> out;
+		out.reserve(text.size() / 4u * 3u);
+		uint32_t bits = 0u;
+		int count = 0;
+		for (char c : text)
+		{
+			int value;
+			if (c >= 'A' && c <= 'Z')
+			{
+				value = c - 'A';
+			}
+			else if (c >= 'a' && c <= 'z')
+			{
+				value = c - 'a' + 26;
+			}
+			else if (c >= '0' && c <= '9')
+			{
+				value = c - '0' + 52;
+			}
+			else if (c == '+')
+			{
+				value = 62;
+			}
+			else if (c == '/')
+			{
+				value = 63;
+			}
+			else if (c == '=')
+			{
+				break;
+			}
+			else
+			{
+				throw MESH_EXCEPT("glTF: bad base64 in a data URI");
+			}
+			bits = (bits << 6) | uint32_t(value);
+			if (++count == 4)
+			{
+				out.push_back(std::byte((bits >> 16) & 0xFFu));
+				out.push_back(std::byte((bits >> 8) & 0xFFu));
+				out.push_back(std::byte(bits & 0xFFu));
+				bits = 0u;
+				count = 0;
+			}
+		}
+		if (count == 2)
+		{
+			out.push_back(std::byte((bits >> 4) & 0xFFu));
+		}
+		else if (count == 3)
+		{
+			out.push_back(std::byte((bits >> 10) & 0xFFu));
+			out.push_back(std::byte((bits >> 2) & 0xFFu));
+		}
+		return out;
+	}
+
+	uint32_t ReadU32(const std::byte* p) noexcept
+	{
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	class GltfReader
+	{
+	public:
+		GltfReader(const std::byte* pData, size_t size, const std::string& directory)
+		{
+			std::string_view jsonText;
+			std::vector<std::byte> glbBinary;
+			if (size >= 12u && ReadU32(pData) == 0x46546C67u)
+			{
+				// glb: header, JSON chunk, optional BIN chunk
+				if (ReadU32(pData + 4u) != 2u)
+				{
+					throw MESH_EXCEPT("glb: only version 2 is supported");
+				}
+				size = std::min<size_t>(size, ReadU32(pData + 8u));
+				size_t offset = 12u;
+				while (offset + 8u <= size)
+				{
+					const size_t length = ReadU32(pData + offset);
+					const uint32_t type = ReadU32(pData + offset + 4u);
+					if (length > size - offset - 8u)
+					{
+						throw MESH_EXCEPT("glb: chunk runs past the end of the file");
+					}
+					const std::byte* pChunk = pData + offset + 8u;
+					if (type == 0x4E4F534Au && jsonText.empty())
+					{
+						jsonText = std::string_view(reinterpret_cast<const char*>(pChunk), length);
+					}
+					else if (type == 0x004E4942u && glbBinary.empty())
+					{
+						glbBinary.assign(pChunk, pChunk + length);
+					}
+					offset += 8u + (length + 3u) / 4u * 4u;
+				}
+				if (jsonText.empty())
+				{
+					throw MESH_EXCEPT("glb: no JSON chunk");
+				}
+			}
+			else
+			{
+				jsonText = std::string_view(reinterpret_cast<const char*>(pData), size);
+			}
+			root = JsonParser(jsonText).Parse();
+			if (root.type != Json::Type::Object)
+			{
+				throw MESH_EXCEPT("glTF: the document is not an object");
+			}
+			for (const Json& buffer : root.GetArray("buffers"))
+			{
+				const Json* pUri = buffer.Find("uri");
+				if (!pUri || pUri->type != Json::Type::String)
+				{
+					// the glb's own binary chunk
+					buffers.push_back(std::move(glbBinary));
+					glbBinary.clear();
+				}
+				else if (pUri->string.rfind("data:", 0u) == 0u)
+				{
+					const size_t comma = pUri->string.find(";base64,");
+					if (comma == std::string::npos)
+					{
+						throw MESH_EXCEPT("glTF: only base64 data URIs are supported");
+					}
+					buffers.push_back(DecodeBase64(std::string_view(pUri->string).substr(comma + 8u)));
+				}
+				else
+				{
+					const std::string path = (std::filesystem::path(directory) / pUri->string).string();
+					std::ifstream file(path, std::ios::binary | std::ios::ate);
+					if (!file)
+					{
+						throw MESH_EXCEPT("glTF: cannot open buffer " + path);
+					}
+					std::vector<std::byte> data(size_t(file.tellg()));
+					file.seekg(0);
+					file.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size()));
+					buffers.push_back(std::move(data));
+				}
+				if (size_t(buffer.GetNumber("byteLength", 0.0)) > buffers.back().size())
+				{
+					throw MESH_EXCEPT("glTF: buffer shorter than its byteLength");
+				}
+			}
+		}
+
+		Mesh Read()
+		{
+			std::vector<Mesh::Vertex> vertices;
+			std::vector<uint32_t> indices;
+			bool missingNormals = false;
+			const std::vector<Json>& scenes = root.GetArray("scenes");
+			if (scenes.empty())
+			{
+				// no scene, every mesh as it is
+				for (size_t i = 0; i < root.GetArray("meshes").size(); i++)
+				{
+					AddMesh(i, XMMatrixIdentity(), vertices, indices, missingNormals);
+				}
+			}
+			else
+			{
+				const size_t scene = size_t(root.GetNumber("scene", 0.0));
+				if (scene >= scenes.size())
+				{
+					throw MESH_EXCEPT("glTF: scene index out of range");
+				}
+				for (const Json& node : scenes[scene].GetArray("nodes"))
+				{
+					AddNode(Index(node, root.GetArray("nodes").size()), XMMatrixIdentity(), 0u, vertices, indices, missingNormals);
+				}
+			}
+			Mesh mesh(std::move(vertices), std::move(indices));
+			if (missingNormals)
+			{
+				mesh.ComputeNormals();
+			}
+			mesh.Weld();
+			return mesh;
+		}
+	private:
+		static size_t Index(const Json& value, size_t count)
+		{
+			if (value.type != Json::Type::Number || value.number < 0.0 || value.number >= double(count))
+			{
+				throw MESH_EXCEPT("glTF: index out of range");
+			}
+			return size_t(value.number);
+		}
+
+		static XMMATRIX LocalTransform(const Json& node)
+		{
+			const std::vector<Json>& m = node.GetArray("matrix");
+			if (m.size() == 16u)
+			{
+				// column major for column vectors is row major for DirectXMath's row vectors
+				XMFLOAT4X4 matrix;
+				for (size_t i = 0; i < 16u; i++)
+				{
+					matrix.m[i / 4u][i % 4u] = float(m[i].number);
+				}
+				return XMLoadFloat4x4(&matrix);
+			}
+			const auto get = [&](std::string_view key, size_t n, std::array<float, 4> fallback)
+			{
+				const std::vector<Json>& values = node.GetArray(key);
+				if (values.size() == n)
+				{
+					for (size_t i = 0; i < n; i++)
+					{
+						fallback[i] = float(values[i].number);
+					}
+				}
+				return fallback;
+			};
+			const auto t = get("translation", 3u, { 0.0f, 0.0f, 0.0f, 0.0f });
+			const auto r = get("rotation", 4u, { 0.0f, 0.0f, 0.0f, 1.0f });
+			const auto s = get("scale", 3u, { 1.0f, 1.0f, 1.0f, 0.0f });
+			const float x = r[0], y = r[1], z = r[2], w = r[3];
+			const XMFLOAT4X4 rotation = { {
+				{ 1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + z * w), 2.0f * (x * z - y * w), 0.0f },
+				{ 2.0f * (x * y - z * w), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + x * w), 0.0f },
+				{ 2.0f * (x * z + y * w), 2.0f * (y * z - x * w), 1.0f - 2.0f * (x * x + y * y), 0.0f },
+				{ 0.0f, 0.0f, 0.0f, 1.0f },
+			} };
+			return XMMatrixMultiply(XMMatrixMultiply(XMMatrixScaling(s[0], s[1], s[2]), XMLoadFloat4x4(&rotation)),
+				XMMatrixTranslation(t[0], t[1], t[2]));
+		}
+
+		void AddNode(size_t index, FXMMATRIX parent, unsigned int depth,
+			std::vector<Mesh::Vertex>& vertices, std::vector<uint32_t>& indices, bool& missingNormals)
+		{
+			// node graphs are trees, anything deeper than this is a cycle
+			if (depth > 64u)
+			{
+				throw MESH_EXCEPT("glTF: node hierarchy too deep or cyclic");
+			}
+			const std::vector<Json>& nodes = root.GetArray("nodes");
+			const Json& node = nodes[index];
+			const XMMATRIX world = XMMatrixMultiply(LocalTransform(node), parent);
+			if (const Json* pMesh = node.Find("mesh"))
+			{
+				AddMesh(Index(*pMesh, root.GetArray("meshes").size()), world, vertices, indices, missingNormals);
+			}
+			for (const Json& child : node.GetArray("children"))
+			{
+				AddNode(Index(child, nodes.size()), world, depth + 1u, vertices, indices, missingNormals);
+			}
+		}
+
+		void AddMesh(size_t index, FXMMATRIX world, std::vector<Mesh::Vertex>& vertices, std::vector<uint32_t>& indices, bool& missingNormals)
+		{
+			// normals go through the inverse transpose, a mirroring transform flips the winding
+			const XMMATRIX normalMatrix = XMMatrixTranspose(XMMatrixInverse(nullptr, world));
+			XMFLOAT4X4 m;
+			XMStoreFloat4x4(&m, world);
+			const auto& r = m.m;
+			const float determinant = r[0][0] * (r[1][1] * r[2][2] - r[1][2] * r[2][1])
+				- r[0][1] * (r[1][0] * r[2][2] - r[1][2] * r[2][0]) + r[0][2] * (r[1][0] * r[2][1] - r[1][1] * r[2][0]);
+			for (const Json& primitive : root.GetArray("meshes")[index].GetArray("primitives"))
+			{
+				const int mode = int(primitive.GetNumber("mode", 4.0));
+				if (mode < 4 || mode > 6)
+				{
+					// points and lines
+					continue;
+				}
+				const Json* pAttributes = primitive.Find("attributes");
+				const Json* pPosition = pAttributes ? pAttributes->Find("POSITION") : nullptr;
+				if (!pPosition)
+				{
+					continue;
+				}
+				const std::vector<float> positions = ReadFloats(*pPosition, 3u);
+				const size_t count = positions.size() / 3u;
+				const Json* pNormal = pAttributes->Find("NORMAL");
+				const Json* pUv = pAttributes->Find("TEXCOORD_0");
+				const std::vector<float> normals = pNormal ? ReadFloats(*pNormal, 3u) : std::vector<float>();
+				const std::vector<float> uvs = pUv ? ReadFloats(*pUv, 2u) : std::vector<float>();
+				if ((pNormal && normals.size() != count * 3u) || (pUv && uvs.size() != count * 2u))
+				{
+					throw MESH_EXCEPT("glTF: attributes of one primitive differ in count");
+				}
+				missingNormals |= !pNormal;
+				const uint32_t base = uint32_t(vertices.size());
+				for (size_t i = 0; i < count; i++)
+				{
+					Mesh::Vertex vertex;
+					XMFLOAT3 p(positions[i * 3u], positions[i * 3u + 1u], positions[i * 3u + 2u]);
+					XMStoreFloat3(&vertex.position, XMVector3TransformCoord(XMLoadFloat3(&p), world));
+					vertex.normal = XMFLOAT3(0.0f, 0.0f, 0.0f);
+					if (pNormal)
+					{
+						XMFLOAT3 n(normals[i * 3u], normals[i * 3u + 1u], normals[i * 3u + 2u]);
+						const XMVECTOR transformed = XMVector3TransformNormal(XMLoadFloat3(&n), normalMatrix);
+						if (XMVectorGetX(XMVector3LengthSq(transformed)) > 0.0f)
+						{
+							XMStoreFloat3(&vertex.normal, XMVector3Normalize(transformed));
+						}
+					}
+					vertex.uv = pUv ? XMFLOAT2(uvs[i * 2u], uvs[i * 2u + 1u]) : XMFLOAT2(0.0f, 0.0f);
+					vertices.push_back(vertex);
+				}
+				std::vector<uint32_t> list;
+				if (const Json* pIndices = primitive.Find("indices"))
+				{
+					list = ReadIndices(*pIndices, count);
+				}
+				else
+				{
+					for (uint32_t i = 0; i < uint32_t(count); i++)
+					{
+						list.push_back(i);
+					}
+				}
+				std::vector<uint32_t> triangles;
+				if (mode == 4)
+				{
+					triangles = std::move(list);
+					triangles.resize(triangles.size() / 3u * 3u);
+				}
+				for (size_t i = 2u; mode != 4 && i < list.size(); i++)
+				{
+					if (mode == 5)
+					{
+						// strips alternate their winding
+						const bool odd = (i % 2u) == 1u;
+						triangles.insert(triangles.end(), { list[i - 2u], odd ? list[i] : list[i - 1u], odd ? list[i - 1u] : list[i] });
+					}
+					else
+					{
+						triangles.insert(triangles.end(), { list[0], list[i - 1u], list[i] });
+					}
+				}
+				for (size_t i = 0; i < triangles.size(); i += 3u)
+				{
+					const uint32_t a = base + triangles[i];
+					const uint32_t b = base + triangles[i + 1u];
+					const uint32_t c = base + triangles[i + 2u];
+					indices.insert(indices.end(), { a, determinant < 0.0f ? c : b, determinant < 0.0f ? b : c });
+				}
+			}
+		}
+
+		struct View
+		{
+			const std::byte* pData;
+			size_t count;
+			size_t stride;
+			int componentType;
+			size_t components;
+			bool normalized;
+		};
+
+		View GetView(const Json& accessorIndex, size_t components)
+		{
+			const std::vector<Json>& accessors = root.GetArray("accessors");
+			const Json& accessor = accessors[Index(accessorIndex, accessors.size())];
+			if (accessor.Find("sparse"))
+			{
+				throw MESH_EXCEPT("glTF: sparse accessors are not supported");
+			}
+			static const std::pair<const char*, size_t> types[] = { { "SCALAR", 1u }, { "VEC2", 2u }, { "VEC3", 3u }, { "VEC4", 4u } };
+			const Json* pType = accessor.Find("type");
+			size_t actual = 0u;
+			for (const auto& [name, n] : types)
+			{
+				actual = pType && pType->string == name ? n : actual;
+			}
+			if (actual != components)
+			{
+				throw MESH_EXCEPT("glTF: accessor has the wrong type");
+			}
+			View view;
+			view.componentType = int(accessor.GetNumber("componentType", 0.0));
+			view.components = components;
+			view.count = size_t(accessor.GetNumber("count", 0.0));
+			const Json* pNormalized = accessor.Find("normalized");
+			view.normalized = pNormalized && pNormalized->boolean;
+			size_t componentSize;
+			switch (view.componentType)
+			{
+			case 5120:
+			case 5121:
+				componentSize = 1u;
+				break;
+			case 5122:
+			case 5123:
+				componentSize = 2u;
+				break;
+			case 5125:
+			case 5126:
+				componentSize = 4u;
+				break;
+			default:
+				throw MESH_EXCEPT("glTF: unknown component type");
+			}
+			const Json* pBufferView = accessor.Find("bufferView");
+			if (!pBufferView)
+			{
+				throw MESH_EXCEPT("glTF: accessors without a buffer view are not supported");
+			}
+			const std::vector<Json>& bufferViews = root.GetArray("bufferViews");
+			const Json& bufferView = bufferViews[Index(*pBufferView, bufferViews.size())];
+			const Json* pBuffer = bufferView.Find("buffer");
+			if (!pBuffer)
+			{
+				throw MESH_EXCEPT("glTF: buffer view without a buffer");
+			}
+			const std::vector<std::byte>& buffer = buffers[Index(*pBuffer, buffers.size())];
+			const size_t viewOffset = size_t(bufferView.GetNumber("byteOffset", 0.0));
+			const size_t viewLength = size_t(bufferView.GetNumber("byteLength", 0.0));
+			const size_t offset = size_t(accessor.GetNumber("byteOffset", 0.0));
+			const size_t elementSize = componentSize * components;
+			view.stride = size_t(bufferView.GetNumber("byteStride", double(elementSize)));
+			if (viewOffset > buffer.size() || viewLength > buffer.size() - viewOffset || view.stride < elementSize
+				|| (view.count > 0u && (offset > viewLength || (view.count - 1u) > (viewLength - offset - std::min(elementSize, viewLength - offset)) / view.stride
+					|| elementSize > viewLength - offset)))
+			{
+				throw MESH_EXCEPT("glTF: accessor runs past its buffer view");
+			}
+			view.pData = buffer.data() + viewOffset + offset;
+			return view;
+		}
+
+		std::vector<float> ReadFloats(const Json& accessorIndex, size_t components)
+		{
+			const View view = GetView(accessorIndex, components);
+			std::vector<float> out(view.count * components);
+			for (size_t i = 0; i < view.count; i++)
+			{
+				const std::byte* p = view.pData + i * view.stride;
+				for (size_t c = 0; c < components; c++)
+				{
+					float value = 0.0f;
+					switch (view.componentType)
+					{
+					case 5126:
+						std::memcpy(&value, p + c * 4u, 4u);
+						break;
+					case 5121:
+						value = float(uint8_t(p[c]));
+						value = view.normalized ? value / 255.0f : value;
+						break;
+					case 5120:
+						value = float(int8_t(p[c]));
+						value = view.normalized ? std::max(value / 127.0f, -1.0f) : value;
+						break;
+					case 5123:
+					case 5122:
+					{
+						uint16_t bits;
+						std::memcpy(&bits, p + c * 2u, 2u);
+						value = view.componentType == 5123 ? float(bits) : float(int16_t(bits));
+						if (view.normalized)
+						{
+							value = view.componentType == 5123 ? value / 65535.0f : std::max(value / 32767.0f, -1.0f);
+						}
+						break;
+					}
+					default:
+						throw MESH_EXCEPT("glTF: unsupported component type for vertex data");
+					}
+					out[i * components + c] = value;
+				}
+			}
+			return out;
+		}
+
+		std::vector<uint32_t> ReadIndices(const Json& accessorIndex, size_t vertexCount)
+		{
+			const View view = GetView(accessorIndex, 1u);
+			std::vector<uint32_t> out(view.count);
+			for (size_t i = 0; i < view.count; i++)
+			{
+				const std::byte* p = view.pData + i * view.stride;
+				uint32_t value;
+				switch (view.componentType)
+				{
+				case 5121:
+					value = uint32_t(uint8_t(p[0]));
+					break;
+				case 5123:
+				{
+					uint16_t bits;
+					std::memcpy(&bits, p, 2u);
+					value = bits;
+					break;
+				}
+				case 5125:
+					std::memcpy(&value, p, 4u);
+					break;
+				default:
+					throw MESH_EXCEPT("glTF: indices must be unsigned integers");
+				}
+				if (value >= vertexCount)
+				{
+					throw MESH_EXCEPT("glTF: index past the primitive's vertices");
+				}
+				out[i] = value;
+			}
+			return out;
+		}
+	private:
+		Json root;
+		std::vector<std::vector<std::byte>> buffers;
+	};
+}
+
+Mesh Mesh::ParseGltf(const std::byte* pData, size_t size, const std::string& directory)
+{
+	O_PROFILE_FUNCTION();
+	return GltfReader(pData, size, directory).Read();
+}
@@ -0,0 +1,215 @@
+#include "Mesh/Mesh.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#define MESH_EXCEPT(note) Mesh::Exception(__LINE__, __FILE__, (note))
+
+namespace
+{
+	using namespace OMath;
+
+	// bit patterns of the floats, -0 folded into 0 so they weld
+	template<size_t n>
+	std::array<uint32_t, n> ToBits(const float* p) noexcept
+	{
+		std::array<uint32_t, n> bits;
+		for (size_t i = 0; i < n; i++)
+		{
+			const float value = p[i] == 0.0f ? 0.0f : p[i];
+			std::memcpy(&bits[i], &value, sizeof(value));
+		}
+		return bits;
+	}
+
+	template<size_t n>
+	struct BitsHash
+	{
+		size_t operator()(const std::array<uint32_t, n>& bits) const noexcept
+		{
+			uint64_t h = 14695981039346656037ull;
+			for (uint32_t b : bits)
+			{
+				h = (h ^ b) * 1099511628211ull;
+			}
+			return size_t(h ^ (h >> 29));
+		}
+	};
+
+	std::array<uint32_t, 8> ToBits(const Mesh::Vertex& v) noexcept
+	{
+		const float values[8] = { v.position.x, v.position.y, v.position.z, v.normal.x, v.normal.y, v.normal.z, v.uv.x, v.uv.y };
+		return ToBits<8>(values);
+	}
+}
+
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices)
+	:
+	vertices(std::move(vertices)),
+	indices(std::move(indices))
+{
+	if (this->indices.size() % 3u != 0u)
+	{
+		throw MESH_EXCEPT("Index count " + std::to_string(this->indices.size()) + " is not a multiple of 3");
+	}
+	for (uint32_t index : this->indices)
+	{
+		if (index >= this->vertices.size())
+		{
+			throw MESH_EXCEPT("Index " + std::to_string(index) + " is past the " + std::to_string(this->vertices.size()) + " vertices");
+		}
+	}
+}
+
+Mesh Mesh::Load(const std::string& path)
+{
+	O_PROFILE_FUNCTION();
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		throw MESH_EXCEPT("Cannot open " + path);
+	}
+	std::vector<std::byte> data(size_t(file.tellg()));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size())))
+	{
+		throw MESH_EXCEPT("Cannot read " + path);
+	}
+	std::string extension = std::filesystem::path(path).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](char c)
+	{
+		return char(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+	});
+	if (extension == ".obj")
+	{
+		return ParseObj(std::string_view(reinterpret_cast<const char*>(data.data()), data.size()));
+	}
+	if (extension == ".gltf" || extension == ".glb")
+	{
+		return ParseGltf(data.data(), data.size(), std::filesystem::path(path).parent_path().string());
+	}
+	throw MESH_EXCEPT("Unknown mesh format " + path);
+}
+
+const std::vector<Mesh::Vertex>& Mesh::GetVertices() const noexcept
+{
+	return vertices;
+}
+
+std::vector<Mesh::Vertex>& Mesh::GetVertices() noexcept
+{
+	return vertices;
+}
+
+const std::vector<uint32_t>& Mesh::GetIndices() const noexcept
+{
+	return indices;
+}
+
+std::vector<uint32_t>& Mesh::GetIndices() noexcept
+{
+	return indices;
+}
+
+size_t Mesh::GetTriangleCount() const noexcept
+{
+	return indices.size() / 3u;
+}
+
+size_t Mesh::Weld()
+{
+	O_PROFILE_FUNCTION();
+	std::unordered_map<std::array<uint32_t, 8>, uint32_t, BitsHash<8>> unique;
+	unique.reserve(vertices.size());
+	// numbered in order of first use, unused vertices never get a number
+	std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+	std::vector<Vertex> welded;
+	welded.reserve(vertices.size());
+	for (uint32_t& index : indices)
+	{
+		if (remap[index] == UINT32_MAX)
+		{
+			const auto [it, inserted] = unique.try_emplace(ToBits(vertices[index]), uint32_t(welded.size()));
+			if (inserted)
+			{
+				welded.push_back(vertices[index]);
+			}
+			remap[index] = it->second;
+		}
+		index = remap[index];
+	}
+	const size_t removed = vertices.size() - welded.size();
+	vertices = std::move(welded);
+	return removed;
+}
+
+void Mesh::ComputeNormals()
+{
+	O_PROFILE_FUNCTION();
+	// one normal per distinct position
+	std::unordered_map<std::array<uint32_t, 3>, uint32_t, BitsHash<3>> positionOf;
+	std::vector<uint32_t> group(vertices.size());
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		group[i] = positionOf.try_emplace(ToBits<3>(&vertices[i].position.x), uint32_t(positionOf.size())).first->second;
+	}
+	std::vector<XMFLOAT3> sums(positionOf.size(), XMFLOAT3(0.0f, 0.0f, 0.0f));
+	for (size_t i = 0; i + 2u < indices.size(); i += 3u)
+	{
+		const XMVECTOR a = XMLoadFloat3(&vertices[indices[i]].position);
+		const XMVECTOR b = XMLoadFloat3(&vertices[indices[i + 1u]].position);
+		const XMVECTOR c = XMLoadFloat3(&vertices[indices[i + 2u]].position);
+		// the cross product's length is twice the area, the weighting we want
+		const XMVECTOR n = XMVector3Cross(XMVectorSubtract(b, a), XMVectorSubtract(c, a));
+		for (size_t k = 0; k < 3u; k++)
+		{
+			XMFLOAT3& sum = sums[group[indices[i + k]]];
+			XMStoreFloat3(&sum, XMVectorAdd(XMLoadFloat3(&sum), n));
+		}
+	}
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		const XMVECTOR n = XMLoadFloat3(&sums[group[i]]);
+		if (XMVectorGetX(XMVector3LengthSq(n)) > 0.0f)
+		{
+			XMStoreFloat3(&vertices[i].normal, XMVector3Normalize(n));
+		}
+		else
+		{
+			vertices[i].normal = XMFLOAT3(0.0f, 0.0f, 1.0f);
+		}
+	}
+}
+
+// Mesh exception
+Mesh::Exception::Exception(int line, const char* file, std::string note) noexcept
+	:
+	OException(line, file),
+	note(std::move(note))
+{
+}
+
+const char* Mesh::Exception::what() const noexcept
+{
+	std::ostringstream oss;
+	oss << GetType() << std::endl
+		<< "[Note] " << GetNote() << std::endl
+		<< GetOriginString();
+	whatBuffer = oss.str();
+	return whatBuffer.c_str();
+}
+
+const char* Mesh::Exception::GetType() const noexcept
+{
+	return "O Mesh Exception";
+}
+
+const std::string& Mesh::Exception::GetNote() const noexcept
+{
+	return note;
+}
@@ -0,0 +1,475 @@
+#include "Mesh/MeshBlob.h"
+#include "Profile/Profiler.h"
+#include "Time/OTimer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#define MESH_EXCEPT(note) Mesh::Exception(__LINE__, __FILE__, (note))
+
+struct MeshBlob::Header
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t format;
+	uint32_t stride;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t indexSize;
+	uint32_t vertexOffset;
+	uint32_t indexOffset;
+	uint32_t reserved;
+	float positionScale[3];
+	float positionOffset[3];
+	float uvScale[2];
+	float uvOffset[2];
+	float boundsMin[3];
+	float boundsMax[3];
+};
+
+namespace
+{
+	using namespace OMath;
+
+	constexpr uint32_t magic = 0x48534D4Fu; // "OMSH"
+	constexpr uint32_t version = 1u;
+	constexpr size_t alignment = 16u;
+
+	// DXGI_FORMAT values
+	constexpr uint32_t dxgiR32G32B32Float = 6u;
+	constexpr uint32_t dxgiR16G16B16A16Unorm = 11u;
+	constexpr uint32_t dxgiR32G32Float = 16u;
+	constexpr uint32_t dxgiR16G16Unorm = 35u;
+	constexpr uint32_t dxgiR16G16Snorm = 37u;
+	constexpr uint32_t dxgiR32Uint = 42u;
+	constexpr uint32_t dxgiR16Uint = 57u;
+
+	uint32_t GetFormatStride(MeshBlob::Format format) noexcept
+	{
+		return format == MeshBlob::Format::Float ? 32u : 16u;
+	}
+
+	size_t AlignUp(size_t value) noexcept
+	{
+		return (value + alignment - 1u) / alignment * alignment;
+	}
+
+	uint16_t ToUnorm16(float value) noexcept
+	{
+		return uint16_t(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+	}
+
+	int16_t ToSnorm16(float value) noexcept
+	{
+		return int16_t(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+	}
+
+	float FromSnorm16(int16_t value) noexcept
+	{
+		return std::max(float(value) / 32767.0f, -1.0f);
+	}
+
+	float SignNotZero(float value) noexcept
+	{
+		return value < 0.0f ? -1.0f : 1.0f;
+	}
+
+	// Octahedral mapping: the unit sphere projected onto the octahedron,
+	// the lower half folded over the upper. Two 16-bit values keep the
+	// angular error well under what lighting shows.
+	XMFLOAT2 EncodeOctahedral(const XMFLOAT3& n) noexcept
+	{
+		const float sum = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+		if (sum == 0.0f)
+		{
+			return XMFLOAT2(0.0f, 0.0f);
+		}
+		const float x = n.x / sum;
+		const float y = n.y / sum;
+		if (n.z >= 0.0f)
+		{
+			return XMFLOAT2(x, y);
+		}
+		return XMFLOAT2((1.0f - std::abs(y)) * SignNotZero(x), (1.0f - std::abs(x)) * SignNotZero(y));
+	}
+
+	XMFLOAT3 DecodeOctahedral(float x, float y) noexcept
+	{
+		const float z = 1.0f - std::abs(x) - std::abs(y);
+		XMFLOAT3 n(x, y, z);
+		if (z < 0.0f)
+		{
+			n.x = (1.0f - std::abs(y)) * SignNotZero(x);
+			n.y = (1.0f - std::abs(x)) * SignNotZero(y);
+		}
+		XMFLOAT3 out;
+		XMStoreFloat3(&out, XMVector3Normalize(XMLoadFloat3(&n)));
+		return out;
+	}
+
+	template<class T>
+	void Put(std::byte* p, const T& value) noexcept
+	{
+		std::memcpy(p, &value, sizeof(value));
+	}
+
+	template<class T>
+	T Get(const std::byte* p) noexcept
+	{
+		T value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+}
+
+MeshBlob MeshBlob::Cook(const Mesh& mesh, const Options& options)
+{
+	O_PROFILE_FUNCTION();
+	MeshBlob blob;
+	Mesh optimized = mesh;
+	const uint32_t stride = GetFormatStride(options.format);
+	if (options.analyze)
+	{
+		blob.stats.cacheBefore = MeshOptimize::AnalyzeVertexCache(optimized.GetIndices(), optimized.GetVertices().size());
+		blob.stats.fetchBefore = MeshOptimize::AnalyzeVertexFetch(optimized.GetIndices(), optimized.GetVertices().size(), stride);
+		blob.stats.overdrawBefore = MeshOptimize::AnalyzeOverdraw(optimized);
+	}
+	OTimer timer;
+	if (options.optimize)
+	{
+		MeshOptimize::OptimizeVertexCache(optimized, options.cache);
+		if (options.overdraw)
+		{
+			MeshOptimize::OptimizeOverdraw(optimized, options.overdrawThreshold);
+		}
+		MeshOptimize::OptimizeVertexFetch(optimized);
+	}
+	blob.stats.optimizeSeconds = timer.Mark();
+
+	const std::vector<Mesh::Vertex>& vertices = optimized.GetVertices();
+	const std::vector<uint32_t>& indices = optimized.GetIndices();
+	Header header = {};
+	header.magic = magic;
+	header.version = version;
+	header.format = uint32_t(options.format);
+	header.stride = stride;
+	header.vertexCount = uint32_t(vertices.size());
+	header.indexCount = uint32_t(indices.size());
+	// 0xFFFF stays free, it is the strip cut value
+	header.indexSize = vertices.size() < 0xFFFFu ? 2u : 4u;
+	header.vertexOffset = uint32_t(AlignUp(sizeof(Header)));
+	header.indexOffset = uint32_t(AlignUp(header.vertexOffset + size_t(stride) * vertices.size()));
+
+	XMFLOAT3 low(0.0f, 0.0f, 0.0f);
+	XMFLOAT3 high(0.0f, 0.0f, 0.0f);
+	XMFLOAT2 uvLow(0.0f, 0.0f);
+	XMFLOAT2 uvHigh(0.0f, 0.0f);
+	if (!vertices.empty())
+	{
+		XMVECTOR lo = XMLoadFloat3(&vertices[0].position);
+		XMVECTOR hi = lo;
+		uvLow = uvHigh = vertices[0].uv;
+		for (const Mesh::Vertex& vertex : vertices)
+		{
+			lo = XMVectorMin(lo, XMLoadFloat3(&vertex.position));
+			hi = XMVectorMax(hi, XMLoadFloat3(&vertex.position));
+			uvLow = XMFLOAT2(std::min(uvLow.x, vertex.uv.x), std::min(uvLow.y, vertex.uv.y));
+			uvHigh = XMFLOAT2(std::max(uvHigh.x, vertex.uv.x), std::max(uvHigh.y, vertex.uv.y));
+		}
+		XMStoreFloat3(&low, lo);
+		XMStoreFloat3(&high, hi);
+	}
+	const float boundsMin[3] = { low.x, low.y, low.z };
+	const float boundsMax[3] = { high.x, high.y, high.z };
+	for (size_t i = 0; i < 3u; i++)
+	{
+		header.boundsMin[i] = boundsMin[i];
+		header.boundsMax[i] = boundsMax[i];
+		const bool compact = options.format == Format::Compact;
+		header.positionScale[i] = compact ? boundsMax[i] - boundsMin[i] : 1.0f;
+		header.positionOffset[i] = compact ? boundsMin[i] : 0.0f;
+	}
+	header.uvScale[0] = options.format == Format::Compact ? uvHigh.x - uvLow.x : 1.0f;
+	header.uvScale[1] = options.format == Format::Compact ? uvHigh.y - uvLow.y : 1.0f;
+	header.uvOffset[0] = options.format == Format::Compact ? uvLow.x : 0.0f;
+	header.uvOffset[1] = options.format == Format::Compact ? uvLow.y : 0.0f;
+
+	blob.data.resize(header.indexOffset + size_t(header.indexSize) * indices.size());
+	Put(blob.data.data(), header);
+	const auto normalize = [](float value, float offset, float scale)
+	{
+		return scale > 0.0f ? (value - offset) / scale : 0.0f;
+	};
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		const Mesh::Vertex& v = vertices[i];
+		std::byte* p = blob.data.data() + header.vertexOffset + i * stride;
+		if (options.format == Format::Float)
+		{
+			Put(p, v.position);
+			Put(p + 12u, v.normal);
+			Put(p + 24u, v.uv);
+			continue;
+		}
+		const uint16_t position[4] = {
+			ToUnorm16(normalize(v.position.x, header.positionOffset[0], header.positionScale[0])),
+			ToUnorm16(normalize(v.position.y, header.positionOffset[1], header.positionScale[1])),
+			ToUnorm16(normalize(v.position.z, header.positionOffset[2], header.positionScale[2])),
+			0u,
+		};
+		const XMFLOAT2 octahedral = EncodeOctahedral(v.normal);
+		const int16_t normal[2] = { ToSnorm16(octahedral.x), ToSnorm16(octahedral.y) };
+		const uint16_t uv[2] = {
+			ToUnorm16(normalize(v.uv.x, header.uvOffset[0], header.uvScale[0])),
+			ToUnorm16(normalize(v.uv.y, header.uvOffset[1], header.uvScale[1])),
+		};
+		Put(p, position);
+		Put(p + 8u, normal);
+		Put(p + 12u, uv);
+	}
+	std::byte* pIndices = blob.data.data() + header.indexOffset;
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		if (header.indexSize == 2u)
+		{
+			Put(pIndices + i * 2u, uint16_t(indices[i]));
+		}
+		else
+		{
+			Put(pIndices + i * 4u, indices[i]);
+		}
+	}
+
+	if (options.analyze)
+	{
+		blob.stats.cacheAfter = MeshOptimize::AnalyzeVertexCache(indices, vertices.size());
+		blob.stats.fetchAfter = MeshOptimize::AnalyzeVertexFetch(indices, vertices.size(), stride);
+		blob.stats.overdrawAfter = MeshOptimize::AnalyzeOverdraw(optimized);
+		const Mesh decoded = blob.Decode();
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			const XMVECTOR error = XMVectorSubtract(XMLoadFloat3(&decoded.GetVertices()[i].position), XMLoadFloat3(&vertices[i].position));
+			blob.stats.maxPositionError = std::max(blob.stats.maxPositionError, std::sqrt(XMVectorGetX(XMVector3LengthSq(error))));
+		}
+	}
+	return blob;
+}
+
+MeshBlob MeshBlob::Load(const std::string& path)
+{
+	O_PROFILE_FUNCTION();
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		throw MESH_EXCEPT("Cannot open " + path);
+	}
+	std::vector<std::byte> data(size_t(file.tellg()));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size())))
+	{
+		throw MESH_EXCEPT("Cannot read " + path);
+	}
+	return Parse(std::move(data));
+}
+
+MeshBlob MeshBlob::Parse(std::vector<std::byte> data)
+{
+	if (data.size() < sizeof(Header))
+	{
+		throw MESH_EXCEPT("Mesh blob shorter than its header");
+	}
+	const Header header = Get<Header>(data.data());
+	if (header.magic != magic || header.version != version)
+	{
+		throw MESH_EXCEPT("Not a mesh blob of version " + std::to_string(version));
+	}
+	if (header.format > uint32_t(Format::Compact) || header.stride != GetFormatStride(Format(header.format))
+		|| (header.indexSize != 2u && header.indexSize != 4u) || header.indexCount % 3u != 0u)
+	{
+		throw MESH_EXCEPT("Mesh blob header is damaged");
+	}
+	// 64-bit sums, a damaged count cannot wrap around the check
+	if (header.vertexOffset % alignment != 0u || header.indexOffset % alignment != 0u
+		|| header.vertexOffset < sizeof(Header) || header.indexOffset < header.vertexOffset
+		|| uint64_t(header.vertexOffset) + uint64_t(header.stride) * header.vertexCount > header.indexOffset
+		|| uint64_t(header.indexOffset) + uint64_t(header.indexSize) * header.indexCount > data.size())
+	{
+		throw MESH_EXCEPT("Mesh blob buffers run past the end of the file");
+	}
+	MeshBlob blob;
+	blob.data = std::move(data);
+	return blob;
+}
+
+void MeshBlob::Write(const std::string& path) const
+{
+	O_PROFILE_FUNCTION();
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file || !file.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size())))
+	{
+		throw MESH_EXCEPT("Cannot write " + path);
+	}
+}
+
+MeshBlob::Header MeshBlob::GetHeader() const noexcept
+{
+	return Get<Header>(data.data());
+}
+
+MeshBlob::Format MeshBlob::GetFormat() const noexcept
+{
+	return Format(GetHeader().format);
+}
+
+uint32_t MeshBlob::GetStride() const noexcept
+{
+	return GetHeader().stride;
+}
+
+uint32_t MeshBlob::GetVertexCount() const noexcept
+{
+	return GetHeader().vertexCount;
+}
+
+uint32_t MeshBlob::GetIndexCount() const noexcept
+{
+	return GetHeader().indexCount;
+}
+
+uint32_t MeshBlob::GetIndexFormat() const noexcept
+{
+	return GetHeader().indexSize == 2u ? dxgiR16Uint : dxgiR32Uint;
+}
+
+const std::byte* MeshBlob::GetVertexData() const noexcept
+{
+	return data.data() + GetHeader().vertexOffset;
+}
+
+const std::byte* MeshBlob::GetIndexData() const noexcept
+{
+	return data.data() + GetHeader().indexOffset;
+}
+
+size_t MeshBlob::GetVertexBytes() const noexcept
+{
+	const Header header = GetHeader();
+	return size_t(header.stride) * header.vertexCount;
+}
+
+size_t MeshBlob::GetIndexBytes() const noexcept
+{
+	const Header header = GetHeader();
+	return size_t(header.indexSize) * header.indexCount;
+}
+
+const std::vector<std::byte>& MeshBlob::GetData() const noexcept
+{
+	return data;
+}
+
+std::vector<MeshBlob::Attribute> MeshBlob::GetLayout() const
+{
+	if (GetFormat() == Format::Float)
+	{
+		return {
+			{ "POSITION", dxgiR32G32B32Float, 0u },
+			{ "NORMAL", dxgiR32G32B32Float, 12u },
+			{ "TEXCOORD", dxgiR32G32Float, 24u },
+		};
+	}
+	return {
+		{ "POSITION", dxgiR16G16B16A16Unorm, 0u },
+		{ "NORMAL", dxgiR16G16Snorm, 8u },
+		{ "TEXCOORD", dxgiR16G16Unorm, 12u },
+	};
+}
+
+XMFLOAT3 MeshBlob::GetPositionScale() const noexcept
+{
+	const Header header = GetHeader();
+	return XMFLOAT3(header.positionScale[0], header.positionScale[1], header.positionScale[2]);
+}
+
+XMFLOAT3 MeshBlob::GetPositionOffset() const noexcept
+{
+	const Header header = GetHeader();
+	return XMFLOAT3(header.positionOffset[0], header.positionOffset[1], header.positionOffset[2]);
+}
+
+XMFLOAT2 MeshBlob::GetUvScale() const noexcept
+{
+	const Header header = GetHeader();
+	return XMFLOAT2(header.uvScale[0], header.uvScale[1]);
+}
+
+XMFLOAT2 MeshBlob::GetUvOffset() const noexcept
+{
+	const Header header = GetHeader();
+	return XMFLOAT2(header.uvOffset[0], header.uvOffset[1]);
+}
+
+XMFLOAT3 MeshBlob::GetBoundsMin() const noexcept
+{
+	const Header header = GetHeader();
+	return XMFLOAT3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+}
+
+XMFLOAT3 MeshBlob::GetBoundsMax() const noexcept
+{
+	const Header header = GetHeader();
+	return XMFLOAT3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+}
+
+float MeshBlob::GetBytesPerVertex() const noexcept
+{
+	const uint32_t count = GetVertexCount();
+	return count == 0u ? 0.0f : float(GetVertexBytes() + GetIndexBytes()) / float(count);
+}
+
+const MeshBlob::Stats& MeshBlob::GetStats() const noexcept
+{
+	return stats;
+}
+
+Mesh MeshBlob::Decode() const
+{
+	const Header header = GetHeader();
+	std::vector<Mesh::Vertex> vertices(header.vertexCount);
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		const std::byte* p = data.data() + header.vertexOffset + i * header.stride;
+		Mesh::Vertex& v = vertices[i];
+		if (Format(header.format) == Format::Float)
+		{
+			v.position = Get<XMFLOAT3>(p);
+			v.normal = Get<XMFLOAT3>(p + 12u);
+			v.uv = Get<XMFLOAT2>(p + 24u);
+			continue;
+		}
+		const auto unorm = [&](size_t offset)
+		{
+			return float(Get<uint16_t>(p + offset)) / 65535.0f;
+		};
+		v.position = XMFLOAT3(
+			unorm(0u) * header.positionScale[0] + header.positionOffset[0],
+			unorm(2u) * header.positionScale[1] + header.positionOffset[1],
+			unorm(4u) * header.positionScale[2] + header.positionOffset[2]);
+		v.normal = DecodeOctahedral(FromSnorm16(Get<int16_t>(p + 8u)), FromSnorm16(Get<int16_t>(p + 10u)));
+		v.uv = XMFLOAT2(unorm(12u) * header.uvScale[0] + header.uvOffset[0], unorm(14u) * header.uvScale[1] + header.uvOffset[1]);
+	}
+	std::vector<uint32_t> indices(header.indexCount);
+	const std::byte* pIndices = data.data() + header.indexOffset;
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		indices[i] = header.indexSize == 2u ? Get<uint16_t>(pIndices + i * 2u) : Get<uint32_t>(pIndices + i * 4u);
+	}
+	return Mesh(std::move(vertices), std::move(indices));
+}
+
+const char* MeshBlob::GetFormatName(Format format) noexcept
+{
+	return format == Format::Float ? "float" : "compact";
+}
@@ -0,0 +1,568 @@
+#include "Mesh/MeshOptimize.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+	using namespace OMath;
+
+	// triangles around each vertex, each vertex's list shrinks from the back
+	// as its triangles are emitted
+	struct Adjacency
+	{
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> counts;
+		std::vector<uint32_t> triangles;
+
+		Adjacency(const std::vector<uint32_t>& indices, size_t vertexCount)
+			:
+			offsets(vertexCount + 1u, 0u),
+			counts(vertexCount, 0u),
+			triangles(indices.size())
+		{
+			for (uint32_t index : indices)
+			{
+				counts[index]++;
+			}
+			for (size_t v = 0; v < vertexCount; v++)
+			{
+				offsets[v + 1u] = offsets[v] + counts[v];
+			}
+			std::fill(counts.begin(), counts.end(), 0u);
+			for (size_t i = 0; i < indices.size(); i++)
+			{
+				const uint32_t v = indices[i];
+				triangles[offsets[v] + counts[v]++] = uint32_t(i / 3u);
+			}
+		}
+		void Remove(uint32_t vertex, uint32_t triangle) noexcept
+		{
+			uint32_t* pBegin = triangles.data() + offsets[vertex];
+			uint32_t* pEnd = pBegin + counts[vertex];
+			*std::find(pBegin, pEnd, triangle) = pEnd[-1];
+			counts[vertex]--;
+		}
+	};
+
+	// FIFO cache through timestamps: a vertex is cached while fewer than
+	// cacheSize misses have happened since its own
+	class FifoCache
+	{
+	public:
+		FifoCache(size_t vertexCount, size_t cacheSize)
+			:
+			stamps(vertexCount, 0u),
+			cacheSize(uint32_t(cacheSize)),
+			time(uint32_t(cacheSize) + 1u)
+		{
+		}
+		// true on a miss
+		bool Access(uint32_t vertex) noexcept
+		{
+			if (time - stamps[vertex] > cacheSize)
+			{
+				stamps[vertex] = time++;
+				return true;
+			}
+			return false;
+		}
+		void Clear() noexcept
+		{
+			time += cacheSize + 1u;
+		}
+	private:
+		std::vector<uint32_t> stamps;
+		uint32_t cacheSize;
+		uint32_t time;
+	};
+
+	// Forsyth, "Linear-Speed Vertex Cache Optimisation", with his constants
+	constexpr size_t forsythCacheSize = 32u;
+
+	struct ForsythScores
+	{
+		std::array<float, forsythCacheSize> cache;
+		std::array<float, 64> valence;
+
+		ForsythScores() noexcept
+		{
+			for (size_t i = 0; i < forsythCacheSize; i++)
+			{
+				// the last triangle's vertices get a fixed score so it is not simply repeated
+				cache[i] = i < 3u ? 0.75f : std::pow(1.0f - float(i - 3u) / float(forsythCacheSize - 3u), 1.5f);
+			}
+			for (size_t i = 0; i < valence.size(); i++)
+			{
+				valence[i] = i == 0u ? 0.0f : 2.0f / std::sqrt(float(i));
+			}
+		}
+		float Get(int position, uint32_t remaining) const noexcept
+		{
+			if (remaining == 0u)
+			{
+				return -1.0f;
+			}
+			const float boost = remaining < valence.size() ? valence[remaining] : 2.0f / std::sqrt(float(remaining));
+			return (position >= 0 ? cache[size_t(position)] : 0.0f) + boost;
+		}
+	};
+
+	std::vector<uint32_t> Forsyth(const std::vector<uint32_t>& indices, size_t vertexCount)
+	{
+		static const ForsythScores scores;
+		const size_t triangleCount = indices.size() / 3u;
+		Adjacency adjacency(indices, vertexCount);
+		std::vector<int> positions(vertexCount, -1);
+		std::vector<float> vertexScores(vertexCount);
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			vertexScores[v] = scores.Get(-1, adjacency.counts[v]);
+		}
+		std::vector<float> triangleScores(triangleCount);
+		for (size_t t = 0; t < triangleCount; t++)
+		{
+			triangleScores[t] = vertexScores[indices[t * 3u]] + vertexScores[indices[t * 3u + 1u]] + vertexScores[indices[t * 3u + 2u]];
+		}
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<uint32_t> out;
+		out.reserve(indices.size());
+		// three more than the cache so the vertices pushed out still get rescored
+		std::array<uint32_t, forsythCacheSize + 3u> cache;
+		std::array<uint32_t, forsythCacheSize + 3u> next;
+		size_t cached = 0u;
+		size_t cursor = 0u;
+		int64_t best = -1;
+		for (size_t count = 0; count < triangleCount; count++)
+		{
+			if (best < 0)
+			{
+				// nothing left around the cache, start on the next island
+				while (emitted[cursor])
+				{
+					cursor++;
+				}
+				best = int64_t(cursor);
+			}
+			const uint32_t triangle = uint32_t(best);
+			emitted[triangle] = true;
+			const uint32_t* pCorners = &indices[size_t(triangle) * 3u];
+			size_t nextCount = 0u;
+			for (size_t k = 0; k < 3u; k++)
+			{
+				out.push_back(pCorners[k]);
+				adjacency.Remove(pCorners[k], triangle);
+				next[nextCount++] = pCorners[k];
+			}
+			for (size_t i = 0; i < cached; i++)
+			{
+				const uint32_t v = cache[i];
+				if (v != pCorners[0] && v != pCorners[1] && v != pCorners[2])
+				{
+					next[nextCount++] = v;
+				}
+			}
+			for (size_t i = 0; i < nextCount; i++)
+			{
+				const uint32_t v = next[i];
+				positions[v] = i < forsythCacheSize ? int(i) : -1;
+				const float score = scores.Get(positions[v], adjacency.counts[v]);
+				const float delta = score - vertexScores[v];
+				vertexScores[v] = score;
+				const uint32_t* pTriangles = adjacency.triangles.data() + adjacency.offsets[v];
+				for (uint32_t j = 0; j < adjacency.counts[v]; j++)
+				{
+					triangleScores[pTriangles[j]] += delta;
+				}
+			}
+			// only triangles touching the cache can have gained
+			cached = std::min(nextCount, forsythCacheSize);
+			best = -1;
+			float bestScore = -1.0f;
+			for (size_t i = 0; i < cached; i++)
+			{
+				const uint32_t v = next[i];
+				const uint32_t* pTriangles = adjacency.triangles.data() + adjacency.offsets[v];
+				for (uint32_t j = 0; j < adjacency.counts[v]; j++)
+				{
+					if (triangleScores[pTriangles[j]] > bestScore)
+					{
+						bestScore = triangleScores[pTriangles[j]];
+						best = int64_t(pTriangles[j]);
+					}
+				}
+			}
+			std::copy(next.begin(), next.begin() + cached, cache.begin());
+		}
+		return out;
+	}
+
+	// Sander, Nehab and Barczak, "Fast Triangle Reordering for Vertex
+	// Locality and Reduced Overdraw"
+	constexpr size_t tipsifyCacheSize = 16u;
+
+	std::vector<uint32_t> Tipsify(const std::vector<uint32_t>& indices, size_t vertexCount)
+	{
+		const size_t k = tipsifyCacheSize;
+		Adjacency adjacency(indices, vertexCount);
+		std::vector<uint32_t> live = adjacency.counts;
+		std::vector<uint32_t> stamps(vertexCount, 0u);
+		std::vector<bool> emitted(indices.size() / 3u, false);
+		std::vector<uint32_t> deadEnds;
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> out;
+		out.reserve(indices.size());
+		uint32_t time = uint32_t(k) + 1u;
+		size_t cursor = 0u;
+		int64_t fan = vertexCount > 0u ? 0 : -1;
+		while (fan >= 0)
+		{
+			candidates.clear();
+			const uint32_t* pTriangles = adjacency.triangles.data() + adjacency.offsets[size_t(fan)];
+			for (uint32_t j = 0; j < adjacency.counts[size_t(fan)]; j++)
+			{
+				const uint32_t t = pTriangles[j];
+				if (emitted[t])
+				{
+					continue;
+				}
+				emitted[t] = true;
+				for (size_t c = 0; c < 3u; c++)
+				{
+					const uint32_t v = indices[size_t(t) * 3u + c];
+					out.push_back(v);
+					deadEnds.push_back(v);
+					candidates.push_back(v);
+					live[v]--;
+					if (time - stamps[v] > k)
+					{
+						stamps[v] = time++;
+					}
+				}
+			}
+			// the candidate that will still be cached after its remaining
+			// triangles, and has been cached longest
+			fan = -1;
+			int64_t bestPriority = -1;
+			for (uint32_t v : candidates)
+			{
+				if (live[v] == 0u)
+				{
+					continue;
+				}
+				int64_t priority = 0;
+				if (int64_t(time - stamps[v]) + 2 * int64_t(live[v]) <= int64_t(k))
+				{
+					priority = time - stamps[v];
+				}
+				if (priority > bestPriority)
+				{
+					bestPriority = priority;
+					fan = v;
+				}
+			}
+			if (fan < 0)
+			{
+				// dead end: the most recent vertex with triangles left, else the next in input order
+				while (!deadEnds.empty() && fan < 0)
+				{
+					const uint32_t v = deadEnds.back();
+					deadEnds.pop_back();
+					fan = live[v] > 0u ? int64_t(v) : -1;
+				}
+				while (fan < 0 && cursor < vertexCount)
+				{
+					fan = live[cursor] > 0u ? int64_t(cursor) : -1;
+					cursor++;
+				}
+			}
+		}
+		return out;
+	}
+
+	struct Cluster
+	{
+		size_t begin;
+		size_t end;
+		float sortKey;
+	};
+}
+
+void MeshOptimize::OptimizeVertexCache(Mesh& mesh, CacheAlgorithm algorithm)
+{
+	O_PROFILE_FUNCTION();
+	std::vector<uint32_t>& indices = mesh.GetIndices();
+	const size_t vertexCount = mesh.GetVertices().size();
+	indices = algorithm == CacheAlgorithm::Forsyth ? Forsyth(indices, vertexCount) : Tipsify(indices, vertexCount);
+}
+
+void MeshOptimize::OptimizeOverdraw(Mesh& mesh, float threshold)
+{
+	O_PROFILE_FUNCTION();
+	std::vector<uint32_t>& indices = mesh.GetIndices();
+	const std::vector<Mesh::Vertex>& vertices = mesh.GetVertices();
+	const size_t triangleCount = indices.size() / 3u;
+	if (triangleCount == 0u)
+	{
+		return;
+	}
+	// hard boundaries: triangles that miss on all three vertices, the cache starts over there
+	FifoCache cache(vertices.size(), tipsifyCacheSize);
+	std::vector<size_t> hard;
+	for (size_t t = 0; t < triangleCount; t++)
+	{
+		int misses = 0;
+		for (size_t c = 0; c < 3u; c++)
+		{
+			misses += cache.Access(indices[t * 3u + c]) ? 1 : 0;
+		}
+		if (misses == 3 || t == 0u)
+		{
+			hard.push_back(t);
+		}
+	}
+	hard.push_back(triangleCount);
+	// soft boundaries inside them wherever the running ACMR is close enough to the cluster's
+	std::vector<Cluster> clusters;
+	for (size_t h = 0; h + 1u < hard.size(); h++)
+	{
+		const size_t begin = hard[h];
+		const size_t end = hard[h + 1u];
+		cache.Clear();
+		size_t clusterMisses = 0u;
+		for (size_t i = begin * 3u; i < end * 3u; i++)
+		{
+			clusterMisses += cache.Access(indices[i]) ? 1u : 0u;
+		}
+		const float limit = float(clusterMisses) / float(end - begin) * threshold;
+		cache.Clear();
+		size_t start = begin;
+		size_t misses = 0u;
+		for (size_t t = begin; t < end; t++)
+		{
+			for (size_t c = 0; c < 3u; c++)
+			{
+				misses += cache.Access(indices[t * 3u + c]) ? 1u : 0u;
+			}
+			if (t + 1u < end && float(misses) / float(t + 1u - start) <= limit)
+			{
+				clusters.push_back({ start, t + 1u, 0.0f });
+				start = t + 1u;
+				misses = 0u;
+				cache.Clear();
+			}
+		}
+		clusters.push_back({ start, end, 0.0f });
+	}
+	// outward facing clusters far from the middle are likely in front of the rest
+	XMVECTOR meshCenter = XMVectorZero();
+	float meshArea = 0.0f;
+	std::vector<XMFLOAT3> centers(clusters.size());
+	std::vector<XMFLOAT3> normals(clusters.size());
+	for (size_t i = 0; i < clusters.size(); i++)
+	{
+		XMVECTOR center = XMVectorZero();
+		XMVECTOR normal = XMVectorZero();
+		float area = 0.0f;
+		for (size_t t = clusters[i].begin; t < clusters[i].end; t++)
+		{
+			const XMVECTOR a = XMLoadFloat3(&vertices[indices[t * 3u]].position);
+			const XMVECTOR b = XMLoadFloat3(&vertices[indices[t * 3u + 1u]].position);
+			const XMVECTOR c = XMLoadFloat3(&vertices[indices[t * 3u + 2u]].position);
+			const XMVECTOR n = XMVector3Cross(XMVectorSubtract(b, a), XMVectorSubtract(c, a));
+			const float weight = std::sqrt(XMVectorGetX(XMVector3LengthSq(n)));
+			center = XMVectorAdd(center, XMVectorScale(XMVectorAdd(XMVectorAdd(a, b), c), weight / 3.0f));
+			normal = XMVectorAdd(normal, n);
+			area += weight;
+		}
+		meshCenter = XMVectorAdd(meshCenter, center);
+		meshArea += area;
+		XMStoreFloat3(&centers[i], area > 0.0f ? XMVectorScale(center, 1.0f / area) : center);
+		XMStoreFloat3(&normals[i], XMVectorGetX(XMVector3LengthSq(normal)) > 0.0f ? XMVector3Normalize(normal) : normal);
+	}
+	meshCenter = meshArea > 0.0f ? XMVectorScale(meshCenter, 1.0f / meshArea) : meshCenter;
+	for (size_t i = 0; i < clusters.size(); i++)
+	{
+		clusters[i].sortKey = XMVectorGetX(XMVector3Dot(XMVectorSubtract(XMLoadFloat3(&centers[i]), meshCenter), XMLoadFloat3(&normals[i])));
+	}
+	std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& lhs, const Cluster& rhs)
+	{
+		return lhs.sortKey > rhs.sortKey;
+	});
+	std::vector<uint32_t> out;
+	out.reserve(indices.size());
+	for (const Cluster& cluster : clusters)
+	{
+		out.insert(out.end(), indices.begin() + cluster.begin * 3u, indices.begin() + cluster.end * 3u);
+	}
+	indices = std::move(out);
+}
+
+void MeshOptimize::OptimizeVertexFetch(Mesh& mesh)
+{
+	O_PROFILE_FUNCTION();
+	std::vector<Mesh::Vertex>& vertices = mesh.GetVertices();
+	std::vector<uint32_t>& indices = mesh.GetIndices();
+	std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+	std::vector<Mesh::Vertex> ordered;
+	ordered.reserve(vertices.size());
+	for (uint32_t& index : indices)
+	{
+		if (remap[index] == UINT32_MAX)
+		{
+			remap[index] = uint32_t(ordered.size());
+			ordered.push_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+	vertices = std::move(ordered);
+}
+
+MeshOptimize::CacheStats MeshOptimize::AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize)
+{
+	CacheStats stats;
+	FifoCache cache(vertexCount, cacheSize);
+	std::vector<bool> referenced(vertexCount, false);
+	size_t unique = 0u;
+	for (uint32_t index : indices)
+	{
+		stats.transformed += cache.Access(index) ? 1u : 0u;
+		unique += referenced[index] ? 0u : 1u;
+		referenced[index] = true;
+	}
+	stats.acmr = indices.empty() ? 0.0f : float(stats.transformed) / float(indices.size() / 3u);
+	stats.atvr = unique == 0u ? 0.0f : float(stats.transformed) / float(unique);
+	return stats;
+}
+
+MeshOptimize::FetchStats MeshOptimize::AnalyzeVertexFetch(const std::vector<uint32_t>& indices, size_t vertexCount, size_t vertexSize)
+{
+	constexpr size_t lineSize = 64u;
+	constexpr size_t lineCount = 16384u / lineSize;
+	FetchStats stats;
+	FifoCache transformCache(vertexCount, 16u);
+	std::vector<bool> referenced(vertexCount, false);
+	size_t unique = 0u;
+	// LRU through last use times, a linear scan is fine at 256 lines
+	std::array<size_t, lineCount> lines;
+	std::array<uint64_t, lineCount> lastUse{};
+	lines.fill(SIZE_MAX);
+	uint64_t time = 0u;
+	for (uint32_t index : indices)
+	{
+		unique += referenced[index] ? 0u : 1u;
+		referenced[index] = true;
+		if (!transformCache.Access(index))
+		{
+			continue;
+		}
+		const size_t first = size_t(index) * vertexSize / lineSize;
+		const size_t last = (size_t(index) * vertexSize + vertexSize - 1u) / lineSize;
+		for (size_t line = first; line <= last; line++)
+		{
+			time++;
+			size_t slot = 0u;
+			bool hit = false;
+			for (size_t i = 0; i < lineCount && !hit; i++)
+			{
+				hit = lines[i] == line;
+				slot = hit || lastUse[i] < lastUse[slot] ? i : slot;
+			}
+			if (!hit)
+			{
+				lines[slot] = line;
+				stats.bytesFetched += lineSize;
+			}
+			lastUse[slot] = time;
+		}
+	}
+	stats.overfetch = unique == 0u ? 0.0f : float(stats.bytesFetched) / float(unique * vertexSize);
+	return stats;
+}
+
+MeshOptimize::OverdrawStats MeshOptimize::AnalyzeOverdraw(const Mesh& mesh)
+{
+	O_PROFILE_FUNCTION();
+	constexpr int resolution = 256;
+	const std::vector<Mesh::Vertex>& vertices = mesh.GetVertices();
+	const std::vector<uint32_t>& indices = mesh.GetIndices();
+	OverdrawStats stats;
+	if (vertices.empty())
+	{
+		return stats;
+	}
+	XMVECTOR lo = XMLoadFloat3(&vertices[0].position);
+	XMVECTOR hi = lo;
+	for (const Mesh::Vertex& vertex : vertices)
+	{
+		lo = XMVectorMin(lo, XMLoadFloat3(&vertex.position));
+		hi = XMVectorMax(hi, XMLoadFloat3(&vertex.position));
+	}
+	XMFLOAT3 low;
+	XMFLOAT3 extent;
+	XMStoreFloat3(&low, lo);
+	XMStoreFloat3(&extent, XMVectorSubtract(hi, lo));
+	const float largest = std::max({ extent.x, extent.y, extent.z });
+	const float scale = largest > 0.0f ? float(resolution) / largest : 0.0f;
+	std::vector<float> depth(size_t(resolution) * resolution);
+	std::vector<std::array<float, 3>> projected(vertices.size());
+	for (int axis = 0; axis < 3; axis++)
+	{
+		for (int side = 0; side < 2; side++)
+		{
+			// looking down the axis from the positive end, then from the
+			// negative one with the screen axes swapped to stay right handed
+			const int u = side == 0 ? (axis + 1) % 3 : (axis + 2) % 3;
+			const int v = side == 0 ? (axis + 2) % 3 : (axis + 1) % 3;
+			const float toViewer = side == 0 ? 1.0f : -1.0f;
+			for (size_t i = 0; i < vertices.size(); i++)
+			{
+				const float p[3] = { vertices[i].position.x - low.x, vertices[i].position.y - low.y, vertices[i].position.z - low.z };
+				projected[i] = { p[u] * scale, p[v] * scale, -toViewer * p[axis] };
+			}
+			std::fill(depth.begin(), depth.end(), INFINITY);
+			for (size_t t = 0; t + 2u < indices.size(); t += 3u)
+			{
+				const std::array<float, 3>& a = projected[indices[t]];
+				const std::array<float, 3>& b = projected[indices[t + 1u]];
+				const std::array<float, 3>& c = projected[indices[t + 2u]];
+				// facing the viewer when the screen space winding is counter clockwise in this right handed frame
+				const float area = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+				if (area <= 0.0f)
+				{
+					continue;
+				}
+				const int x0 = std::max(int(std::floor(std::min({ a[0], b[0], c[0] }))), 0);
+				const int y0 = std::max(int(std::floor(std::min({ a[1], b[1], c[1] }))), 0);
+				const int x1 = std::min(int(std::ceil(std::max({ a[0], b[0], c[0] }))), resolution - 1);
+				const int y1 = std::min(int(std::ceil(std::max({ a[1], b[1], c[1] }))), resolution - 1);
+				for (int y = y0; y <= y1; y++)
+				{
+					for (int x = x0; x <= x1; x++)
+					{
+						const float px = float(x) + 0.5f;
+						const float py = float(y) + 0.5f;
+						const float w0 = (b[0] - px) * (c[1] - py) - (b[1] - py) * (c[0] - px);
+						const float w1 = (c[0] - px) * (a[1] - py) - (c[1] - py) * (a[0] - px);
+						const float w2 = (a[0] - px) * (b[1] - py) - (a[1] - py) * (b[0] - px);
+						if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+						{
+							continue;
+						}
+						const float z = (w0 * a[2] + w1 * b[2] + w2 * c[2]) / area;
+						float& stored = depth[size_t(y) * resolution + size_t(x)];
+						if (z < stored)
+						{
+							stats.covered += stored == INFINITY ? 1u : 0u;
+							stats.shaded++;
+							stored = z;
+						}
+					}
+				}
+			}
+		}
+	}
+	stats.overdraw = stats.covered == 0u ? 0.0f : float(stats.shaded) / float(stats.covered);
+	return stats;
+}
@@ -0,0 +1,169 @@
+#include "Mesh/Mesh.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <charconv>
+#include <unordered_map>
+
+#define MESH_EXCEPT(note) Mesh::Exception(__LINE__, __FILE__, (note))
+
+namespace
+{
+	using namespace OMath;
+
+	bool IsSpace(char c) noexcept
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	// the next whitespace separated token of line, empty at its end
+	std::string_view NextToken(std::string_view& line) noexcept
+	{
+		size_t begin = 0u;
+		while (begin < line.size() && IsSpace(line[begin]))
+		{
+			begin++;
+		}
+		size_t end = begin;
+		while (end < line.size() && !IsSpace(line[end]))
+		{
+			end++;
+		}
+		const std::string_view token = line.substr(begin, end - begin);
+		line.remove_prefix(end);
+		return token;
+	}
+
+	float ParseFloat(std::string_view token, size_t lineNumber)
+	{
+		float value = 0.0f;
+		const auto [p, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+		if (ec != std::errc() || p != token.data() + token.size())
+		{
+			throw MESH_EXCEPT("Bad number '" + std::string(token) + "' on line " + std::to_string(lineNumber));
+		}
+		return value;
+	}
+
+	// 1-based, negative counts back from the last one read; -1 for missing
+	int64_t ParseIndex(std::string_view token, size_t count, size_t lineNumber)
+	{
+		if (token.empty())
+		{
+			return -1;
+		}
+		int64_t value = 0;
+		const auto [p, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+		const int64_t index = value < 0 ? int64_t(count) + value : value - 1;
+		if (ec != std::errc() || p != token.data() + token.size() || value == 0 || index < 0 || index >= int64_t(count))
+		{
+			throw MESH_EXCEPT("Bad index '" + std::string(token) + "' on line " + std::to_string(lineNumber));
+		}
+		return index;
+	}
+
+	struct Corner
+	{
+		int64_t position;
+		int64_t uv;
+		int64_t normal;
+		bool operator==(const Corner& other) const noexcept
+		{
+			return position == other.position && uv == other.uv && normal == other.normal;
+		}
+	};
+
+	struct CornerHash
+	{
+		size_t operator()(const Corner& c) const noexcept
+		{
+			return size_t(c.position * 73856093ll ^ c.uv * 19349663ll ^ c.normal * 83492791ll);
+		}
+	};
+}
+
+Mesh Mesh::ParseObj(std::string_view text)
+{
+	O_PROFILE_FUNCTION();
+	std::vector<XMFLOAT3> positions;
+	std::vector<XMFLOAT3> normals;
+	std::vector<XMFLOAT2> uvs;
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+	std::unordered_map<Corner, uint32_t, CornerHash> vertexOf;
+	std::vector<uint32_t> face;
+	bool missingNormals = false;
+	size_t lineNumber = 0u;
+	while (!text.empty())
+	{
+		const size_t end = std::min(text.find('\n'), text.size());
+		std::string_view line = text.substr(0u, end);
+		text.remove_prefix(std::min(end + 1u, text.size()));
+		lineNumber++;
+		const std::string_view keyword = NextToken(line);
+		if (keyword == "v")
+		{
+			const float x = ParseFloat(NextToken(line), lineNumber);
+			const float y = ParseFloat(NextToken(line), lineNumber);
+			const float z = ParseFloat(NextToken(line), lineNumber);
+			positions.emplace_back(x, y, z);
+		}
+		else if (keyword == "vn")
+		{
+			const float x = ParseFloat(NextToken(line), lineNumber);
+			const float y = ParseFloat(NextToken(line), lineNumber);
+			const float z = ParseFloat(NextToken(line), lineNumber);
+			normals.emplace_back(x, y, z);
+		}
+		else if (keyword == "vt")
+		{
+			const float u = ParseFloat(NextToken(line), lineNumber);
+			// v is optional; OBJ has the origin bottom left, D3D top left
+			const std::string_view token = NextToken(line);
+			const float v = 1.0f - (token.empty() ? 0.0f : ParseFloat(token, lineNumber));
+			uvs.emplace_back(u, v);
+		}
+		else if (keyword == "f")
+		{
+			face.clear();
+			for (std::string_view token = NextToken(line); !token.empty(); token = NextToken(line))
+			{
+				// v, v/vt, v//vn or v/vt/vn
+				const size_t slash1 = token.find('/');
+				const size_t slash2 = slash1 == std::string_view::npos ? slash1 : token.find('/', slash1 + 1u);
+				Corner corner;
+				corner.position = ParseIndex(token.substr(0u, slash1), positions.size(), lineNumber);
+				corner.uv = slash1 == std::string_view::npos ? -1
+					: ParseIndex(token.substr(slash1 + 1u, slash2 == std::string_view::npos ? std::string_view::npos : slash2 - slash1 - 1u), uvs.size(), lineNumber);
+				corner.normal = slash2 == std::string_view::npos ? -1 : ParseIndex(token.substr(slash2 + 1u), normals.size(), lineNumber);
+				if (corner.position < 0)
+				{
+					throw MESH_EXCEPT("Face without a position on line " + std::to_string(lineNumber));
+				}
+				const auto [it, inserted] = vertexOf.try_emplace(corner, uint32_t(vertices.size()));
+				if (inserted)
+				{
+					Vertex vertex;
+					vertex.position = positions[size_t(corner.position)];
+					vertex.normal = corner.normal < 0 ? XMFLOAT3(0.0f, 0.0f, 0.0f) : normals[size_t(corner.normal)];
+					vertex.uv = corner.uv < 0 ? XMFLOAT2(0.0f, 0.0f) : uvs[size_t(corner.uv)];
+					missingNormals |= corner.normal < 0;
+					vertices.push_back(vertex);
+				}
+				face.push_back(it->second);
+			}
+			// polygons as fans around their first corner
+			for (size_t i = 2u; i < face.size(); i++)
+			{
+				indices.insert(indices.end(), { face[0], face[i - 1u], face[i] });
+			}
+		}
+		// groups, objects, smoothing groups and materials do not change the geometry
+	}
+	Mesh mesh(std::move(vertices), std::move(indices));
+	if (missingNormals)
+	{
+		mesh.ComputeNormals();
+	}
+	mesh.Weld();
+	return mesh;
+}
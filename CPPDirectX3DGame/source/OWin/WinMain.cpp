@@ -1,4 +1,8 @@
 #include "Core/App.h"
+#include "Platform/Win32Platform.h"
+#include "Profile/Profiler.h"
+#include <optional>
+#include <string>
 
 int CALLBACK WinMain(
 	HINSTANCE hInstance,
@@ -8,7 +12,43 @@ int CALLBACK WinMain(
 {
 	try
 	{
-		return App{}.Start();
+		// --pipelined runs rendering on its own thread
+		const bool pipelined = std::string(lpCmdLine).find("--pipelined") != std::string::npos;
+		// --trace records profiler scopes and writes them to trace.json on exit
+		const bool trace = std::string(lpCmdLine).find("--trace") != std::string::npos;
+		// --record writes all input to input.rec on exit, --replay plays it back
+		const bool record = std::string(lpCmdLine).find("--record") != std::string::npos;
+		const bool replay = std::string(lpCmdLine).find("--replay") != std::string::npos;
+		if (trace)
+		{
+			Profiler::BeginCapture();
+		}
+		InputRecorder recorder;
+		std::optional<InputReplay> player;
+		App app{
+			std::make_unique<Win32Platform>(800, 300, "CPP Direct3D11 Game"),
+			pipelined ? App::LoopMode::Pipelined : App::LoopMode::Serial
+		};
+		if (record)
+		{
+			app.RecordInput(recorder);
+		}
+		if (replay)
+		{
+			player.emplace(InputReplay::Load("input.rec"));
+			app.ReplayInput(*player);
+		}
+		const int exitCode = app.Start();
+		if (record)
+		{
+			recorder.Save("input.rec");
+		}
+		if (trace)
+		{
+			Profiler::EndCapture();
+			Profiler::WriteChromeTrace("trace.json");
+		}
+		return exitCode;
 		// return App{ lpCmdLine }.Start();
 	}
 	catch (const OException& e)
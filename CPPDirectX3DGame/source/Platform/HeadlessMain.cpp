@@ -0,0 +1,164 @@
+// Entry point for the headless build: runs the full App loop on
+// HeadlessPlatform for a fixed number of frames with no display, for
+// profiling, memory checking and benchmarks on machines without a GPU.
+// The flags in the mode table below run one of the tools in
+// source/Headless instead. Not part of the Windows executable.
+#include "Core/App.h"
+#include "Headless/HeadlessModes.h"
+#include "Platform/HeadlessPlatform.h"
+#include "Profile/Profiler.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <string>
+
+namespace
+{
+	constexpr Headless::Mode modes[] =
+	{
+		{ "--cull", "objects", Headless::RunCull },
+		{ "--shaders", "count", Headless::RunShaders },
+		{ "--texture", "image", Headless::RunTexture },
+		{ "--stream", "assets", Headless::RunStream },
+		{ "--mesh", "model", Headless::RunMesh },
+		{ "--raster", "threads", Headless::RunRaster },
+		{ "--commands", "draws", Headless::RunCommands },
+		{ "--pacing", "frames", Headless::RunPacing },
+		{ "--upload", "frames", Headless::RunUpload },
+		{ "--input", "events", Headless::RunInput },
+	};
+
+	int PrintUsage(const char* program)
+	{
+		std::string usage = "usage: ";
+		usage += program;
+		usage += " [--frames N] [--size WxH] [--pipelined] [--replay file] [--trace file]";
+		for (const Headless::Mode& mode : modes)
+		{
+			usage = usage + " [" + mode.flag + " " + mode.value + "]";
+		}
+		std::fprintf(stderr, "%s\n", usage.c_str());
+		return 2;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		Headless::Options options;
+		const Headless::Mode* pMode = nullptr;
+		const char* modeValue = nullptr;
+		int width = 800;
+		int height = 300;
+		bool pipelined = false;
+		const char* replayPath = nullptr;
+		const char* tracePath = nullptr;
+		for (int i = 1; i < argc; i++)
+		{
+			const bool hasValue = i + 1 < argc;
+			if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+			{
+				options.frames = std::strtoull(argv[++i], nullptr, 10);
+			}
+			else if (std::strcmp(argv[i], "--size") == 0 && hasValue)
+			{
+				// WxH
+				if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2)
+				{
+					std::fprintf(stderr, "bad --size '%s', expected WxH\n", argv[i]);
+					return 2;
+				}
+			}
+			else if (std::strcmp(argv[i], "--pipelined") == 0)
+			{
+				pipelined = true;
+			}
+			else if (std::strcmp(argv[i], "--replay") == 0 && hasValue)
+			{
+				replayPath = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--trace") == 0 && hasValue)
+			{
+				tracePath = argv[++i];
+			}
+			else
+			{
+				const Headless::Mode* pFound = nullptr;
+				for (const Headless::Mode& mode : modes)
+				{
+					pFound = std::strcmp(argv[i], mode.flag) == 0 ? &mode : pFound;
+				}
+				if (!pFound || !hasValue)
+				{
+					return PrintUsage(argv[0]);
+				}
+				pMode = pFound;
+				modeValue = argv[++i];
+			}
+		}
+
+		if (pMode)
+		{
+			return pMode->run(modeValue, options);
+		}
+		if (tracePath)
+		{
+			Profiler::BeginCapture();
+		}
+		auto pPlatform = std::make_unique<HeadlessPlatform>(width, height);
+		HeadlessPlatform& platform = *pPlatform;
+		std::optional<InputReplay> player;
+		App app{ std::move(pPlatform), pipelined ? App::LoopMode::Pipelined : App::LoopMode::Serial };
+		app.SetFrameLimit(options.frames);
+		if (replayPath)
+		{
+			player.emplace(InputReplay::Load(replayPath));
+			app.ReplayInput(*player);
+		}
+		OTimer run;
+		const int exitCode = app.Start();
+		const float seconds = run.Mark();
+		if (tracePath)
+		{
+			Profiler::EndCapture();
+			Profiler::WriteChromeTrace(tracePath);
+		}
+
+		// short runs may end before the first periodic update
+		FrameStats stats = app.GetFrameStats();
+		const FrameStats::Summary& summary = stats.Update();
+		const uint64_t presented = platform.GetPresentedFrames();
+		std::printf("frames %llu in %.3fs (%.1f fps) at %dx%d, %s\n",
+			static_cast<unsigned long long>(presented), seconds, seconds > 0.0f ? float(presented) / seconds : 0.0f,
+			width, height, pipelined ? "pipelined" : "serial");
+		std::printf("last %zu frames: avg %.3fms p50 %.3fms p95 %.3fms p99 %.3fms max %.3fms\n",
+			summary.count, summary.avgMs, summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs);
+		const Memory::AllocationCounter::Summary memory = app.GetAllocations().GetSummary();
+		std::printf("per frame: %.2f heap allocations (%.0f bytes, max %llu), frame arena %.2f allocations (%.1fKB), %zu arena overflows\n",
+			memory.heapAllocationsPerFrame, memory.heapBytesPerFrame, static_cast<unsigned long long>(memory.maxHeapAllocations),
+			memory.arenaAllocationsPerFrame, memory.arenaBytesPerFrame / 1024.0, memory.arenaOverflows);
+		if (options.frames != 0u && presented != options.frames)
+		{
+			std::fprintf(stderr, "presented %llu frames, expected %llu\n",
+				static_cast<unsigned long long>(presented), static_cast<unsigned long long>(options.frames));
+			return 1;
+		}
+		return exitCode;
+	}
+	catch (const OException& e)
+	{
+		std::fprintf(stderr, "%s\n%s\n", e.GetType(), e.what());
+	}
+	catch (const std::exception& e)
+	{
+		std::fprintf(stderr, "Standard Exception\n%s\n", e.what());
+	}
+	catch (...)
+	{
+		std::fprintf(stderr, "Unknown Exception\n");
+	}
+	return -1;
+}
@@ -0,0 +1,132 @@
+#include "Platform/HeadlessPlatform.h"
+#include <algorithm>
+#include <cstring>
+
+HeadlessPlatform::HeadlessPlatform(int width, int height)
+	:
+	pRasterizer(std::make_unique<SoftwareRasterizer>(
+		static_cast<unsigned int>(std::max(width, 1)), static_cast<unsigned int>(std::max(height, 1)))),
+	renderer(*this)
+{
+}
+
+std::optional<int> HeadlessPlatform::ProcessMessages()
+{
+	// there are no messages, only RequestQuit stops the loop
+	if (quit.load(std::memory_order_acquire))
+	{
+		return exitCode.load(std::memory_order_relaxed);
+	}
+	return std::nullopt;
+}
+
+void HeadlessPlatform::SetTitle(const char* title)
+{
+	std::strncpy(this->title.data(), title, this->title.size() - 1u);
+}
+
+void HeadlessPlatform::Resize(int width, int height)
+{
+	pRasterizer = std::make_unique<SoftwareRasterizer>(
+		static_cast<unsigned int>(std::max(width, 1)), static_cast<unsigned int>(std::max(height, 1)), pJobs);
+}
+
+int HeadlessPlatform::GetWidth() const noexcept
+{
+	return int(pRasterizer->GetWidth());
+}
+
+int HeadlessPlatform::GetHeight() const noexcept
+{
+	return int(pRasterizer->GetHeight());
+}
+
+void HeadlessPlatform::EnableCursor() noexcept
+{
+	cursorEnabled = true;
+}
+
+void HeadlessPlatform::DisableCursor() noexcept
+{
+	cursorEnabled = false;
+}
+
+bool HeadlessPlatform::IsCursorEnabled() const noexcept
+{
+	return cursorEnabled;
+}
+
+Keyboard& HeadlessPlatform::GetKeyboard() noexcept
+{
+	return keyboard;
+}
+
+Mouse& HeadlessPlatform::GetMouse() noexcept
+{
+	return mouse;
+}
+
+RenderBackend& HeadlessPlatform::GetRenderer()
+{
+	return renderer;
+}
+
+void HeadlessPlatform::RequestQuit(int exitCode) noexcept
+{
+	this->exitCode.store(exitCode, std::memory_order_relaxed);
+	quit.store(true, std::memory_order_release);
+}
+
+uint64_t HeadlessPlatform::GetPresentedFrames() const noexcept
+{
+	return presented.load(std::memory_order_acquire);
+}
+
+const char* HeadlessPlatform::GetTitle() const noexcept
+{
+	return title.data();
+}
+
+SoftwareRasterizer& HeadlessPlatform::GetRasterizer() noexcept
+{
+	return *pRasterizer;
+}
+
+// Headless renderer
+HeadlessPlatform::Renderer::Renderer(HeadlessPlatform& parent) noexcept
+	:
+	parent(parent)
+{
+}
+
+void HeadlessPlatform::Renderer::ClearBuffer(float red, float green, float blue) noexcept
+{
+	parent.pRasterizer->ClearBuffer(red, green, blue);
+}
+
+void HeadlessPlatform::Renderer::DrawIndexed(const Vertex* pVertices, size_t vertexCount, const unsigned short* pIndices, size_t indexCount)
+{
+	parent.pRasterizer->DrawIndexed(pVertices, vertexCount, pIndices, indexCount);
+}
+
+void HeadlessPlatform::Renderer::EndFrame()
+{
+	parent.pRasterizer->EndFrame();
+	parent.presented.fetch_add(1u, std::memory_order_release);
+}
+
+void HeadlessPlatform::Renderer::SetJobs(JobSystem* pJobs) noexcept
+{
+	parent.pJobs = pJobs;
+	parent.pRasterizer->SetJobs(pJobs);
+}
+
+unsigned int HeadlessPlatform::Renderer::GetWidth() const noexcept
+{
+	return parent.pRasterizer->GetWidth();
+}
+
+unsigned int HeadlessPlatform::Renderer::GetHeight() const noexcept
+{
+	return parent.pRasterizer->GetHeight();
+}
@@ -0,0 +1,69 @@
+#include "Platform/Win32Platform.h"
+
+Win32Platform::Win32Platform(int width, int height, const char* name)
+	:
+	window(width, height, name)
+{
+	// keep running on the CPU rasterizer if the GPU goes away
+	window.Gfx().EnableSoftwareFallback();
+}
+
+std::optional<int> Win32Platform::ProcessMessages()
+{
+	return Window::ProcessMessages();
+}
+
+void Win32Platform::SetTitle(const char* title)
+{
+	window.SetTitle(title);
+}
+
+void Win32Platform::Resize(int width, int height)
+{
+	window.Resize(width, height);
+}
+
+int Win32Platform::GetWidth() const noexcept
+{
+	return window.GetWidth();
+}
+
+int Win32Platform::GetHeight() const noexcept
+{
+	return window.GetHeight();
+}
+
+void Win32Platform::EnableCursor() noexcept
+{
+	window.EnableCursor();
+}
+
+void Win32Platform::DisableCursor() noexcept
+{
+	window.DisableCursor();
+}
+
+bool Win32Platform::IsCursorEnabled() const noexcept
+{
+	return window.CursorEnabled();
+}
+
+Keyboard& Win32Platform::GetKeyboard() noexcept
+{
+	return window.keyboard;
+}
+
+Mouse& Win32Platform::GetMouse() noexcept
+{
+	return window.mouse;
+}
+
+RenderBackend& Win32Platform::GetRenderer()
+{
+	return window.Gfx();
+}
+
+Window& Win32Platform::GetWindow() noexcept
+{
+	return window;
+}
@@ -0,0 +1,120 @@
+#include "Profile/FrameStats.h"
+#include <algorithm>
+#include <cstdio>
+
+FrameStats::FrameStats(float updateInterval, float binWidthMs) noexcept
+	:
+	updateInterval(updateInterval),
+	binWidthMs(std::max(binWidthMs, 0.001f))
+{
+}
+
+bool FrameStats::AddFrame(float seconds) noexcept
+{
+	const float ms = seconds * 1000.0f;
+	if (count == windowSize)
+	{
+		// evict the oldest sample from the histogram, Update sums the window itself
+		histogram[BinOf(samples[next])]--;
+	}
+	else
+	{
+		count++;
+	}
+	samples[next] = ms;
+	next = (next + 1u) % windowSize;
+	histogram[BinOf(ms)]++;
+	frames++;
+
+	sinceUpdate += seconds;
+	if (sinceUpdate < updateInterval)
+	{
+		return false;
+	}
+	sinceUpdate = 0.0f;
+	return true;
+}
+
+const FrameStats::Summary& FrameStats::Update() noexcept
+{
+	summary = {};
+	summary.count = count;
+	if (count == 0u)
+	{
+		return summary;
+	}
+	std::copy_n(samples.begin(), count, sorted.begin());
+	const auto first = sorted.begin();
+	const auto last = sorted.begin() + count;
+	// nearest rank, on a copy so the ring keeps its order
+	const auto percentile = [&](float p)
+	{
+		const size_t rank = std::min(size_t(p * float(count)), count - 1u);
+		std::nth_element(first, first + rank, last);
+		return sorted[rank];
+	};
+	summary.p50Ms = percentile(0.50f);
+	summary.p95Ms = percentile(0.95f);
+	summary.p99Ms = percentile(0.99f);
+	const auto [pMin, pMax] = std::minmax_element(first, last);
+	summary.minMs = *pMin;
+	summary.maxMs = *pMax;
+	double sum = 0.0;
+	for (auto i = first; i != last; i++)
+	{
+		sum += *i;
+	}
+	summary.avgMs = float(sum / double(count));
+	summary.fps = summary.avgMs > 0.0f ? 1000.0f / summary.avgMs : 0.0f;
+	return summary;
+}
+
+const FrameStats::Summary& FrameStats::GetSummary() const noexcept
+{
+	return summary;
+}
+
+const std::array<uint32_t, FrameStats::nBins>& FrameStats::GetHistogram() const noexcept
+{
+	return histogram;
+}
+
+float FrameStats::GetBinWidthMs() const noexcept
+{
+	return binWidthMs;
+}
+
+const char* FrameStats::Format() noexcept
+{
+	std::snprintf(text.data(), text.size(),
+		"%.1f fps | avg %.2f ms | min %.2f | p50 %.2f | p95 %.2f | p99 %.2f | max %.2f",
+		summary.fps, summary.avgMs, summary.minMs,
+		summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs);
+	return text.data();
+}
+
+void FrameStats::SetUpdateInterval(float seconds) noexcept
+{
+	updateInterval = seconds;
+}
+
+uint64_t FrameStats::GetFrameCount() const noexcept
+{
+	return frames;
+}
+
+void FrameStats::Reset() noexcept
+{
+	histogram = {};
+	next = 0u;
+	count = 0u;
+	frames = 0u;
+	sinceUpdate = 0.0f;
+	summary = {};
+}
+
+size_t FrameStats::BinOf(float ms) const noexcept
+{
+	const float bin = ms / binWidthMs;
+	return bin >= float(nBins - 1u) ? nBins - 1u : size_t(std::max(bin, 0.0f));
+}
@@ -0,0 +1,215 @@
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <iomanip>
+
+std::mutex Profiler::mtx;
+std::vector<std::unique_ptr<Profiler::ThreadRing>> Profiler::rings;
+std::vector<Profiler::ThreadRing*> Profiler::freeRings;
+std::atomic<size_t> Profiler::ringCapacity = 1u << 14;
+std::vector<Profiler::Entry> Profiler::frame;
+std::vector<std::pair<uint32_t, Profiler::Event>> Profiler::capture;
+size_t Profiler::captureLimit = 0u;
+bool Profiler::capturing = false;
+int64_t Profiler::captureStart = 0;
+Profiler::Stats Profiler::stats;
+
+Profiler::ThreadRing::ThreadRing(size_t capacity, uint32_t threadIndex)
+	:
+	threadIndex(threadIndex),
+	events(std::make_unique<Event[]>(capacity)),
+	mask(capacity - 1u)
+{}
+
+void Profiler::ThreadRing::Push(const Event& e) noexcept
+{
+	const size_t h = head.load(std::memory_order_relaxed);
+	if (h - tail.load(std::memory_order_acquire) > mask)
+	{
+		// the collector is behind, losing events beats blocking the frame
+		dropped.fetch_add(1u, std::memory_order_relaxed);
+		return;
+	}
+	events[h & mask] = e;
+	head.store(h + 1u, std::memory_order_release);
+}
+
+uint32_t Profiler::Enter() noexcept
+{
+	return GetThreadRing().depth++;
+}
+
+void Profiler::Leave(const char* name, int64_t begin, uint32_t depth) noexcept
+{
+	ThreadRing& ring = GetThreadRing();
+	ring.depth = depth;
+	ring.Push({ name, begin, Now(), depth });
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+	ThreadRing& ring = GetThreadRing();
+	std::lock_guard<std::mutex> lock(mtx);
+	ring.name = name;
+}
+
+void Profiler::SetRingCapacity(size_t capacity) noexcept
+{
+	ringCapacity = std::bit_ceil(std::max<size_t>(capacity, 2u));
+}
+
+Profiler::ThreadRing& Profiler::GetThreadRing()
+{
+	// rings are never freed, so the pointer stays valid for the thread's lifetime
+	thread_local ThreadRing* pRing = nullptr;
+	if (!pRing)
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		// threads come and go with every App (job workers, streamer loaders),
+		// take over the ring of one that has exited before making a new one
+		if (!freeRings.empty())
+		{
+			pRing = freeRings.back();
+			freeRings.pop_back();
+		}
+		else
+		{
+			rings.push_back(std::make_unique<ThreadRing>(ringCapacity.load(), static_cast<uint32_t>(rings.size())));
+			pRing = rings.back().get();
+		}
+		pRing->name = pRing->threadIndex == 0u ? "Main" : "Thread " + std::to_string(pRing->threadIndex);
+		pRing->depth = 0u;
+		// only reached once per thread, the fast path stays a plain pointer
+		thread_local RingOwner owner;
+		owner.pRing = pRing;
+	}
+	return *pRing;
+}
+
+Profiler::RingOwner::~RingOwner()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	freeRings.push_back(pRing);
+}
+
+void Profiler::EndFrame()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	// keep the capacity, steady state frames do not allocate
+	frame.clear();
+	uint64_t dropped = 0u;
+	for (auto& pRing : rings)
+	{
+		pRing->Drain([&ring = *pRing](const Event& e) { Collect(ring, e); });
+		dropped += pRing->dropped.load(std::memory_order_relaxed);
+	}
+	stats.frames++;
+	stats.dropped = dropped;
+	stats.threads = rings.size();
+}
+
+void Profiler::Collect(const ThreadRing& ring, const Event& e)
+{
+	stats.events++;
+	// a frame has a few dozen distinct scopes at most, linear search is fine
+	auto i = std::find_if(frame.begin(), frame.end(), [&e](const Entry& entry)
+	{
+		return entry.name == e.name && entry.depth == e.depth;
+	});
+	if (i == frame.end())
+	{
+		frame.push_back({ e.name, e.depth, 0u, 0.0 });
+		i = frame.end() - 1;
+	}
+	i->calls++;
+	i->seconds += double(e.end - e.begin) / 1e9;
+
+	if (capturing && capture.size() < captureLimit)
+	{
+		capture.emplace_back(ring.threadIndex, e);
+		stats.captured++;
+	}
+}
+
+const std::vector<Profiler::Entry>& Profiler::GetFrame() noexcept
+{
+	return frame;
+}
+
+Profiler::Stats Profiler::GetStats() noexcept
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return stats;
+}
+
+void Profiler::BeginCapture(size_t maxEvents)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	capture.clear();
+	capture.reserve(maxEvents);
+	captureLimit = maxEvents;
+	captureStart = Now();
+	capturing = true;
+	stats.captured = 0u;
+}
+
+void Profiler::EndCapture() noexcept
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	capturing = false;
+}
+
+bool Profiler::IsCapturing() noexcept
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return capturing;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	const auto writeString = [&file](const char* s)
+	{
+		file.put('"');
+		for (; *s; s++)
+		{
+			if (*s == '"' || *s == '\\')
+			{
+				file.put('\\');
+			}
+			file.put(static_cast<unsigned char>(*s) < 0x20 ? ' ' : *s);
+		}
+		file.put('"');
+	};
+
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool first = true;
+	for (const auto& pRing : rings)
+	{
+		file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+			<< pRing->threadIndex << ",\"args\":{\"name\":";
+		writeString(pRing->name.c_str());
+		file << "}}";
+		first = false;
+	}
+	for (const auto& [tid, e] : capture)
+	{
+		// complete events, timestamps in microseconds
+		file << (first ? "" : ",\n") << "{\"name\":";
+		writeString(e.name);
+		file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+			<< ",\"ts\":" << double(e.begin - captureStart) / 1e3
+			<< ",\"dur\":" << double(e.end - e.begin) / 1e3 << "}";
+		first = false;
+	}
+	file << "\n]}\n";
+	file.close();
+	return !file.fail();
+}
@@ -0,0 +1,94 @@
+#include "Render/Command/CommandBuffer.h"
+
+CommandBuffer::CommandBuffer(size_t capacity)
+{
+	packets.reserve(capacity);
+	order.reserve(capacity);
+	scratch.reserve(capacity);
+}
+
+void CommandBuffer::Submit(const DrawPacket& packet)
+{
+	order.push_back({ packet.key, uint32_t(packets.size()) });
+	packets.push_back(packet);
+}
+
+void CommandBuffer::Sort()
+{
+	const size_t n = order.size();
+	if (n < 2u)
+	{
+		return;
+	}
+	// one read over the keys builds the histograms of all eight digits
+	size_t counts[8][256] = {};
+	for (const auto& e : order)
+	{
+		for (int d = 0; d < 8; d++)
+		{
+			counts[d][(e.key >> (d * 8)) & 0xFFu]++;
+		}
+	}
+	scratch.resize(n);
+	for (int d = 0; d < 8; d++)
+	{
+		auto& count = counts[d];
+		// every key has the same byte here, this pass would not move anything
+		if (count[(order[0].key >> (d * 8)) & 0xFFu] == n)
+		{
+			continue;
+		}
+		size_t offset = 0u;
+		for (auto& c : count)
+		{
+			const size_t bucket = c;
+			c = offset;
+			offset += bucket;
+		}
+		for (const auto& e : order)
+		{
+			scratch[count[(e.key >> (d * 8)) & 0xFFu]++] = e;
+		}
+		order.swap(scratch);
+	}
+}
+
+void CommandBuffer::Execute(RenderContext& context, StateCache& cache) const
+{
+	for (const auto& e : order)
+	{
+		const DrawPacket& packet = packets[e.index];
+		for (size_t s = 0; s < RenderContext::nSlots; s++)
+		{
+			if (packet.state[s] != nullptr)
+			{
+				cache.Bind(context, RenderContext::Slot(s), packet.state[s]);
+			}
+		}
+		if (packet.instanceCount > 0u)
+		{
+			cache.DrawInstanced(context, packet.indexCount, packet.instanceCount, packet.startIndex, packet.baseVertex, packet.startInstance);
+		}
+		else
+		{
+			cache.Draw(context, packet.indexCount, packet.startIndex, packet.baseVertex);
+		}
+	}
+}
+
+void CommandBuffer::Reset() noexcept
+{
+	// keeps the capacity so steady-state frames do not allocate
+	packets.clear();
+	order.clear();
+}
+
+size_t CommandBuffer::GetSize() const noexcept
+{
+	return packets.size();
+}
+
+const DrawPacket& CommandBuffer::GetPacket(size_t i) const noexcept
+{
+	return packets[order[i].index];
+}
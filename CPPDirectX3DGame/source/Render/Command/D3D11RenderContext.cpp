@@ -0,0 +1,47 @@
+#include "Render/Command/D3D11RenderContext.h"
+#include "Render/GraphicsThrowMacros.h"
+#include "Bindable/Bindable.h"
+
+D3D11RenderContext::D3D11RenderContext(Graphics& gfx) noexcept
+	:
+	gfx(gfx)
+{
+}
+
+void D3D11RenderContext::SetState(Slot slot, Bind::Bindable* pBindable)
+{
+	if (!HasDevice(gfx))
+	{
+		return;
+	}
+	// each bindable knows which pipeline stage it belongs to
+	pBindable->Bind(gfx);
+}
+
+void D3D11RenderContext::DrawIndexed(unsigned int indexCount, unsigned int startIndex, int baseVertex)
+{
+	if (!HasDevice(gfx))
+	{
+		droppedDraws++;
+		return;
+	}
+	INFOMAN_NOHR(gfx);
+	GFX_THROW_INFO_ONLY(GetContext(gfx)->DrawIndexed(indexCount, startIndex, baseVertex));
+}
+
+void D3D11RenderContext::DrawIndexedInstanced(unsigned int indexCount, unsigned int instanceCount,
+	unsigned int startIndex, int baseVertex, unsigned int startInstance)
+{
+	if (!HasDevice(gfx))
+	{
+		droppedDraws++;
+		return;
+	}
+	INFOMAN_NOHR(gfx);
+	GFX_THROW_INFO_ONLY(GetContext(gfx)->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance));
+}
+
+size_t D3D11RenderContext::GetDroppedDraws() const noexcept
+{
+	return droppedDraws;
+}
@@ -0,0 +1,150 @@
+#include "Render/Command/InstanceBatcher.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+
+namespace
+{
+	uint64_t MaterialBits(uint64_t key) noexcept
+	{
+		return key >> SortKey::depthBits;
+	}
+}
+
+void InstanceBatcher::Submit(const DrawPacket& packet, const InstanceData& instance)
+{
+	const uint32_t index = FindOrAdd(packet);
+	Batch& batch = batches[index];
+	// the group sorts with its nearest member
+	if (packet.key < batch.packet.key)
+	{
+		batch.packet.key = packet.key;
+	}
+	batch.count++;
+	submitted.push_back(instance);
+	batchOf.push_back(index);
+}
+
+void InstanceBatcher::Build(CommandBuffer& commands, Bind::Bindable* pInstanceBuffer)
+{
+	O_PROFILE_FUNCTION();
+	// counting sort of the instances by group, stable so each group keeps
+	// submission order
+	uint32_t offset = 0u;
+	for (Batch& batch : batches)
+	{
+		batch.first = offset;
+		offset += batch.count;
+	}
+	instances.resize(submitted.size());
+	for (Batch& batch : batches)
+	{
+		// reused as the write cursor
+		batch.count = 0u;
+	}
+	for (size_t i = 0; i < submitted.size(); i++)
+	{
+		Batch& batch = batches[batchOf[i]];
+		instances[batch.first + batch.count++] = submitted[i];
+	}
+	for (Batch& batch : batches)
+	{
+		DrawPacket packet = batch.packet;
+		packet.Set(RenderContext::Slot::InstanceBuffer, pInstanceBuffer);
+		packet.instanceCount = batch.count;
+		packet.startInstance = batch.first;
+		commands.Submit(packet);
+	}
+}
+
+const std::vector<InstanceData>& InstanceBatcher::GetInstances() const noexcept
+{
+	return instances;
+}
+
+InstanceBatcher::Stats InstanceBatcher::GetStats() const noexcept
+{
+	return { submitted.size(), batches.size() };
+}
+
+void InstanceBatcher::Reset() noexcept
+{
+	batches.clear();
+	std::fill(table.begin(), table.end(), -1);
+	submitted.clear();
+	batchOf.clear();
+}
+
+bool InstanceBatcher::BatchKey::operator==(const BatchKey& other) const noexcept
+{
+	return state == other.state && indexCount == other.indexCount && startIndex == other.startIndex &&
+		baseVertex == other.baseVertex && material == other.material;
+}
+
+uint64_t InstanceBatcher::BatchKey::Hash() const noexcept
+{
+	// FNV-1a over the fields, pointers are mixed by value
+	uint64_t hash = 14695981039346656037ull;
+	const auto mix = [&hash](uint64_t value)
+	{
+		hash ^= value;
+		hash *= 1099511628211ull;
+	};
+	for (Bind::Bindable* pBindable : state)
+	{
+		mix(reinterpret_cast<uintptr_t>(pBindable));
+	}
+	mix(indexCount);
+	mix(startIndex);
+	mix(uint64_t(int64_t(baseVertex)));
+	mix(material);
+	// the low bits pick the slot, fold the high ones in
+	return hash ^ (hash >> 29);
+}
+
+uint32_t InstanceBatcher::FindOrAdd(const DrawPacket& packet)
+{
+	const BatchKey key = { packet.state, packet.indexCount, packet.startIndex, packet.baseVertex, MaterialBits(packet.key) };
+	if (lastBatch < batches.size() && batches[lastBatch].key == key)
+	{
+		return lastBatch;
+	}
+	if ((batches.size() + 1u) * 2u > table.size())
+	{
+		Grow();
+	}
+	const uint64_t hash = key.Hash();
+	const size_t mask = table.size() - 1u;
+	size_t slot = size_t(hash) & mask;
+	while (table[slot] >= 0)
+	{
+		const Batch& batch = batches[table[slot]];
+		if (batch.hash == hash && batch.key == key)
+		{
+			lastBatch = uint32_t(table[slot]);
+			return lastBatch;
+		}
+		slot = (slot + 1u) & mask;
+	}
+	lastBatch = uint32_t(batches.size());
+	table[slot] = int32_t(lastBatch);
+	Batch& batch = batches.emplace_back();
+	batch.key = key;
+	batch.hash = hash;
+	batch.packet = packet;
+	return lastBatch;
+}
+
+void InstanceBatcher::Grow()
+{
+	table.assign(table.empty() ? 64u : table.size() * 2u, -1);
+	const size_t mask = table.size() - 1u;
+	for (size_t i = 0; i < batches.size(); i++)
+	{
+		size_t slot = size_t(batches[i].hash) & mask;
+		while (table[slot] >= 0)
+		{
+			slot = (slot + 1u) & mask;
+		}
+		table[slot] = int32_t(i);
+	}
+}
@@ -0,0 +1,83 @@
+#include "Render/Command/RecordingContext.h"
+#include <numeric>
+
+RecordingContext::RecordingContext(bool keepLog) noexcept
+	:
+	keepLog(keepLog)
+{
+}
+
+void RecordingContext::SetState(Slot slot, Bind::Bindable* pBindable)
+{
+	stateCalls[size_t(slot)]++;
+	if (keepLog)
+	{
+		calls.push_back({ Call::Type::SetState, slot, pBindable, 0u, 0u, 0, 0u, 0u });
+	}
+}
+
+void RecordingContext::DrawIndexed(unsigned int indexCount, unsigned int startIndex, int baseVertex)
+{
+	drawCalls++;
+	drawnObjects++;
+	if (keepLog)
+	{
+		calls.push_back({ Call::Type::DrawIndexed, Slot::Count, nullptr, indexCount, startIndex, baseVertex, 0u, 0u });
+	}
+}
+
+void RecordingContext::DrawIndexedInstanced(unsigned int indexCount, unsigned int instanceCount,
+	unsigned int startIndex, int baseVertex, unsigned int startInstance)
+{
+	drawCalls++;
+	instancedDrawCalls++;
+	drawnObjects += instanceCount;
+	if (keepLog)
+	{
+		calls.push_back({ Call::Type::DrawIndexedInstanced, Slot::Count, nullptr, indexCount, startIndex, baseVertex, instanceCount, startInstance });
+	}
+}
+
+size_t RecordingContext::GetStateCalls() const noexcept
+{
+	return std::accumulate(stateCalls.begin(), stateCalls.end(), size_t(0u));
+}
+
+size_t RecordingContext::GetStateCalls(Slot slot) const noexcept
+{
+	return stateCalls[size_t(slot)];
+}
+
+size_t RecordingContext::GetDrawCalls() const noexcept
+{
+	return drawCalls;
+}
+
+size_t RecordingContext::GetInstancedDrawCalls() const noexcept
+{
+	return instancedDrawCalls;
+}
+
+size_t RecordingContext::GetDrawnObjects() const noexcept
+{
+	return drawnObjects;
+}
+
+const std::vector<RecordingContext::Call>& RecordingContext::GetCalls() const noexcept
+{
+	return calls;
+}
+
+void RecordingContext::Reset() noexcept
+{
+	stateCalls.fill(0u);
+	drawCalls = 0u;
+	instancedDrawCalls = 0u;
+	drawnObjects = 0u;
+	calls.clear();
+}
+
+Bind::Bindable* RecordingContext::Fake(uintptr_t id) noexcept
+{
+	return reinterpret_cast<Bind::Bindable*>((id + 1u) * 64u);
+}
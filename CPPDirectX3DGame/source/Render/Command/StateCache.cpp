@@ -0,0 +1,43 @@
+#include "Render/Command/StateCache.h"
+
+void StateCache::Bind(RenderContext& context, RenderContext::Slot slot, Bind::Bindable* pBindable)
+{
+	auto& bound = current[size_t(slot)];
+	if (bound == pBindable)
+	{
+		stats.bindsSkipped++;
+		return;
+	}
+	context.SetState(slot, pBindable);
+	bound = pBindable;
+	stats.bindsIssued++;
+}
+
+void StateCache::Draw(RenderContext& context, unsigned int indexCount, unsigned int startIndex, int baseVertex)
+{
+	context.DrawIndexed(indexCount, startIndex, baseVertex);
+	stats.draws++;
+}
+
+void StateCache::DrawInstanced(RenderContext& context, unsigned int indexCount, unsigned int instanceCount,
+	unsigned int startIndex, int baseVertex, unsigned int startInstance)
+{
+	context.DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+	stats.draws++;
+	stats.instances += instanceCount;
+}
+
+void StateCache::Invalidate() noexcept
+{
+	current.fill(nullptr);
+}
+
+StateCache::Stats StateCache::GetStats() const noexcept
+{
+	return stats;
+}
+
+void StateCache::ResetStats() noexcept
+{
+	stats = {};
+}
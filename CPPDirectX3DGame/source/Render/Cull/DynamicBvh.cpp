@@ -0,0 +1,503 @@
+#include "Render/Cull/DynamicBvh.h"
+#include "Time/OTimer.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	bool SameBox(const Aabb& a, const Aabb& b) noexcept
+	{
+		return a.min.x == b.min.x && a.min.y == b.min.y && a.min.z == b.min.z &&
+			a.max.x == b.max.x && a.max.y == b.max.y && a.max.z == b.max.z;
+	}
+
+	bool Overlaps(const Aabb& a, const Aabb& b) noexcept
+	{
+		return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+			a.min.y <= b.max.y && a.max.y >= b.min.y &&
+			a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
+}
+
+DynamicBvh::DynamicBvh(float margin)
+	:
+	margin(margin)
+{
+}
+
+DynamicBvh::ProxyId DynamicBvh::Insert(const Aabb& box, uint32_t userData)
+{
+	return InsertProxy(box, -1.0f, userData);
+}
+
+DynamicBvh::ProxyId DynamicBvh::Insert(const Sphere& sphere, uint32_t userData)
+{
+	return InsertProxy(sphere.GetBox(), sphere.radius, userData);
+}
+
+void DynamicBvh::Remove(ProxyId proxy)
+{
+	assert(proxy >= 0 && size_t(proxy) < nodes.size() && nodes[proxy].IsLeaf());
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	proxyCount--;
+}
+
+bool DynamicBvh::Move(ProxyId proxy, const Aabb& box)
+{
+	return MoveProxy(proxy, box, -1.0f);
+}
+
+bool DynamicBvh::Move(ProxyId proxy, const Sphere& sphere)
+{
+	return MoveProxy(proxy, sphere.GetBox(), sphere.radius);
+}
+
+void DynamicBvh::Rebuild()
+{
+	std::vector<int32_t> leaves;
+	leaves.reserve(proxyCount);
+	for (int32_t i = 0; i < int32_t(nodes.size()); i++)
+	{
+		if (nodes[i].height < 0)
+		{
+			continue;
+		}
+		if (nodes[i].IsLeaf())
+		{
+			leaves.push_back(i);
+		}
+		else
+		{
+			FreeNode(i);
+		}
+	}
+	root = leaves.empty() ? nullProxy : BuildTopDown(leaves.data(), leaves.size());
+	if (root != nullProxy)
+	{
+		nodes[root].parent = nullProxy;
+	}
+}
+
+void DynamicBvh::Cull(const Frustum& frustum, std::vector<uint32_t>& visible)
+{
+	O_PROFILE_FUNCTION();
+	OTimer timer;
+	visible.clear();
+	stats = {};
+	stats.objects = proxyCount;
+	if (root != nullProxy)
+	{
+		stack.clear();
+		maskStack.clear();
+		stack.push_back(root);
+		maskStack.push_back(Frustum::allPlanes);
+		while (!stack.empty())
+		{
+			const int32_t index = stack.back();
+			uint32_t mask = maskStack.back();
+			stack.pop_back();
+			maskStack.pop_back();
+			const Node& node = nodes[index];
+			if (mask == 0u)
+			{
+				// an ancestor was fully inside, take everything below it
+				if (node.IsLeaf())
+				{
+					visible.push_back(node.userData);
+					stats.acceptedWhole++;
+				}
+				else
+				{
+					stack.push_back(node.child1);
+					stack.push_back(node.child2);
+					maskStack.push_back(0u);
+					maskStack.push_back(0u);
+				}
+				continue;
+			}
+			if (node.IsLeaf())
+			{
+				stats.leavesTested++;
+				const Frustum::Result result = node.radius >= 0.0f
+					? frustum.Test(Sphere{ node.tight.GetCenter(), node.radius }, mask)
+					: frustum.Test(node.tight, mask);
+				if (result != Frustum::Result::Outside)
+				{
+					visible.push_back(node.userData);
+				}
+				continue;
+			}
+			stats.nodesTested++;
+			if (frustum.Test(node.box, mask) == Frustum::Result::Outside)
+			{
+				continue;
+			}
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+			maskStack.push_back(mask);
+			maskStack.push_back(mask);
+		}
+	}
+	stats.visible = visible.size();
+	stats.culled = stats.objects - stats.visible;
+	stats.seconds = double(timer.MarkTicks()) / double(OTimer::ticksPerSecond);
+}
+
+const DynamicBvh::CullStats& DynamicBvh::GetCullStats() const noexcept
+{
+	return stats;
+}
+
+uint32_t DynamicBvh::GetUserData(ProxyId proxy) const noexcept
+{
+	return nodes[proxy].userData;
+}
+
+const Aabb& DynamicBvh::GetFatBox(ProxyId proxy) const noexcept
+{
+	return nodes[proxy].box;
+}
+
+size_t DynamicBvh::GetProxyCount() const noexcept
+{
+	return proxyCount;
+}
+
+int DynamicBvh::GetHeight() const noexcept
+{
+	return root == nullProxy ? 0 : nodes[root].height;
+}
+
+float DynamicBvh::GetAreaRatio() const noexcept
+{
+	if (root == nullProxy)
+	{
+		return 0.0f;
+	}
+	float total = 0.0f;
+	for (const Node& node : nodes)
+	{
+		if (node.height > 0)
+		{
+			total += node.box.GetHalfArea();
+		}
+	}
+	const float rootArea = nodes[root].box.GetHalfArea();
+	return rootArea > 0.0f ? total / rootArea : 0.0f;
+}
+
+bool DynamicBvh::Validate() const noexcept
+{
+	if (root != nullProxy && nodes[root].parent != nullProxy)
+	{
+		return false;
+	}
+	size_t leaves = 0u;
+	for (const Node& node : nodes)
+	{
+		leaves += node.height == 0 ? 1u : 0u;
+	}
+	return leaves == proxyCount && (root == nullProxy || ValidateNode(root));
+}
+
+DynamicBvh::ProxyId DynamicBvh::InsertProxy(const Aabb& tight, float radius, uint32_t userData)
+{
+	const int32_t leaf = AllocateNode();
+	Node& node = nodes[leaf];
+	node.box = tight.Expanded(margin);
+	node.tight = tight;
+	node.radius = radius;
+	node.userData = userData;
+	node.height = 0;
+	InsertLeaf(leaf);
+	proxyCount++;
+	return leaf;
+}
+
+bool DynamicBvh::MoveProxy(ProxyId proxy, const Aabb& tight, float radius)
+{
+	assert(proxy >= 0 && size_t(proxy) < nodes.size() && nodes[proxy].IsLeaf());
+	Node& node = nodes[proxy];
+	node.tight = tight;
+	node.radius = radius;
+	if (node.box.Contains(tight))
+	{
+		return false;
+	}
+	const Aabb fat = tight.Expanded(margin);
+	if (Overlaps(fat, node.box))
+	{
+		// small step, grow the ancestors in place
+		node.box = fat;
+		Refit(node.parent, true);
+	}
+	else
+	{
+		// jumped away, refitting would stretch every ancestor across the gap
+		RemoveLeaf(proxy);
+		nodes[proxy].box = fat;
+		InsertLeaf(proxy);
+	}
+	return true;
+}
+
+int32_t DynamicBvh::AllocateNode()
+{
+	int32_t index;
+	if (freeList == nullProxy)
+	{
+		index = int32_t(nodes.size());
+		nodes.emplace_back();
+	}
+	else
+	{
+		index = freeList;
+		freeList = nodes[index].next;
+	}
+	Node& node = nodes[index];
+	node.parent = nullProxy;
+	node.child1 = nullProxy;
+	node.child2 = nullProxy;
+	node.height = 0;
+	node.radius = -1.0f;
+	node.userData = 0u;
+	return index;
+}
+
+void DynamicBvh::FreeNode(int32_t node) noexcept
+{
+	nodes[node].next = freeList;
+	nodes[node].height = -1;
+	freeList = node;
+}
+
+void DynamicBvh::InsertLeaf(int32_t leaf)
+{
+	if (root == nullProxy)
+	{
+		root = leaf;
+		nodes[root].parent = nullProxy;
+		return;
+	}
+
+	// walk down towards the sibling that grows the total surface area least
+	const Aabb leafBox = nodes[leaf].box;
+	int32_t index = root;
+	while (!nodes[index].IsLeaf())
+	{
+		const Node& node = nodes[index];
+		const float area = node.box.GetHalfArea();
+		const float combinedArea = Aabb::Union(node.box, leafBox).GetHalfArea();
+		// pairing with this node creates a parent with the combined box
+		const float cost = 2.0f * combinedArea;
+		// descending means everything on the way grows by at least this much
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+		const auto descendCost = [&](int32_t child)
+		{
+			const Node& c = nodes[child];
+			const float grown = Aabb::Union(leafBox, c.box).GetHalfArea();
+			return (c.IsLeaf() ? grown : grown - c.box.GetHalfArea()) + inheritanceCost;
+		};
+		const float cost1 = descendCost(node.child1);
+		const float cost2 = descendCost(node.child2);
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const int32_t sibling = index;
+	const int32_t oldParent = nodes[sibling].parent;
+	// may reallocate, take no references across it
+	const int32_t newParent = AllocateNode();
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].box = Aabb::Union(leafBox, nodes[sibling].box);
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].child1 = sibling;
+	nodes[newParent].child2 = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+	if (oldParent == nullProxy)
+	{
+		root = newParent;
+	}
+	else if (nodes[oldParent].child1 == sibling)
+	{
+		nodes[oldParent].child1 = newParent;
+	}
+	else
+	{
+		nodes[oldParent].child2 = newParent;
+	}
+	Refit(newParent, false);
+}
+
+void DynamicBvh::RemoveLeaf(int32_t leaf) noexcept
+{
+	if (leaf == root)
+	{
+		root = nullProxy;
+		return;
+	}
+	const int32_t parent = nodes[leaf].parent;
+	const int32_t grandParent = nodes[parent].parent;
+	const int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+	FreeNode(parent);
+	if (grandParent == nullProxy)
+	{
+		root = sibling;
+		nodes[sibling].parent = nullProxy;
+		return;
+	}
+	if (nodes[grandParent].child1 == parent)
+	{
+		nodes[grandParent].child1 = sibling;
+	}
+	else
+	{
+		nodes[grandParent].child2 = sibling;
+	}
+	nodes[sibling].parent = grandParent;
+	Refit(grandParent, true);
+}
+
+void DynamicBvh::Refit(int32_t index, bool stopEarly) noexcept
+{
+	while (index != nullProxy)
+	{
+		const int32_t top = Balance(index);
+		Node& node = nodes[top];
+		const int32_t height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+		const Aabb box = Aabb::Union(nodes[node.child1].box, nodes[node.child2].box);
+		// nothing above can change once a node comes out the same
+		if (stopEarly && top == index && height == node.height && SameBox(box, node.box))
+		{
+			return;
+		}
+		node.height = height;
+		node.box = box;
+		index = node.parent;
+	}
+}
+
+int32_t DynamicBvh::Balance(int32_t iA) noexcept
+{
+	Node& a = nodes[iA];
+	if (a.IsLeaf() || a.height < 2)
+	{
+		return iA;
+	}
+	const int32_t iB = a.child1;
+	const int32_t iC = a.child2;
+	Node& b = nodes[iB];
+	Node& c = nodes[iC];
+	const int32_t balance = c.height - b.height;
+
+	// rotate the taller child up, its taller child stays with it and the
+	// shorter one moves under A
+	const auto rotate = [this, iA, &a](int32_t iUp, Node& up, int32_t& aSlot, const Node& stay)
+	{
+		const int32_t iF = up.child1;
+		const int32_t iG = up.child2;
+		Node& f = nodes[iF];
+		Node& g = nodes[iG];
+
+		up.child1 = iA;
+		up.parent = a.parent;
+		a.parent = iUp;
+		if (up.parent == nullProxy)
+		{
+			root = iUp;
+		}
+		else if (nodes[up.parent].child1 == iA)
+		{
+			nodes[up.parent].child1 = iUp;
+		}
+		else
+		{
+			nodes[up.parent].child2 = iUp;
+		}
+
+		const bool keepF = f.height > g.height;
+		const int32_t iKeep = keepF ? iF : iG;
+		const int32_t iMove = keepF ? iG : iF;
+		up.child2 = iKeep;
+		aSlot = iMove;
+		nodes[iMove].parent = iA;
+		a.box = Aabb::Union(stay.box, nodes[iMove].box);
+		a.height = 1 + std::max(stay.height, nodes[iMove].height);
+		up.box = Aabb::Union(a.box, nodes[iKeep].box);
+		up.height = 1 + std::max(a.height, nodes[iKeep].height);
+	};
+
+	if (balance > 1)
+	{
+		// C goes up, B stays under A
+		rotate(iC, c, a.child2, b);
+		return iC;
+	}
+	if (balance < -1)
+	{
+		// B goes up, C stays under A
+		rotate(iB, b, a.child1, c);
+		return iB;
+	}
+	return iA;
+}
+
+int32_t DynamicBvh::BuildTopDown(int32_t* leaves, size_t count)
+{
+	if (count == 1u)
+	{
+		return leaves[0];
+	}
+	// split at the median along the widest spread of centers
+	Aabb centers = { nodes[leaves[0]].box.GetCenter(), nodes[leaves[0]].box.GetCenter() };
+	for (size_t i = 1; i < count; i++)
+	{
+		const OMath::XMFLOAT3 c = nodes[leaves[i]].box.GetCenter();
+		centers = Aabb::Union(centers, { c, c });
+	}
+	const float dx = centers.max.x - centers.min.x;
+	const float dy = centers.max.y - centers.min.y;
+	const float dz = centers.max.z - centers.min.z;
+	const int axis = dx >= dy && dx >= dz ? 0 : (dy >= dz ? 1 : 2);
+	const auto key = [this, axis](int32_t leaf)
+	{
+		const Aabb& box = nodes[leaf].box;
+		return axis == 0 ? box.min.x + box.max.x : (axis == 1 ? box.min.y + box.max.y : box.min.z + box.max.z);
+	};
+	const size_t half = count / 2u;
+	std::nth_element(leaves, leaves + half, leaves + count,
+		[&key](int32_t l, int32_t r) { return key(l) < key(r); });
+
+	const int32_t child1 = BuildTopDown(leaves, half);
+	const int32_t child2 = BuildTopDown(leaves + half, count - half);
+	const int32_t parent = AllocateNode();
+	Node& node = nodes[parent];
+	node.child1 = child1;
+	node.child2 = child2;
+	node.box = Aabb::Union(nodes[child1].box, nodes[child2].box);
+	node.height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+	nodes[child1].parent = parent;
+	nodes[child2].parent = parent;
+	return parent;
+}
+
+bool DynamicBvh::ValidateNode(int32_t index) const noexcept
+{
+	const Node& node = nodes[index];
+	if (node.IsLeaf())
+	{
+		return node.height == 0 && node.child2 == nullProxy && node.box.Contains(node.tight);
+	}
+	const Node& c1 = nodes[node.child1];
+	const Node& c2 = nodes[node.child2];
+	return c1.parent == index && c2.parent == index &&
+		node.height == 1 + std::max(c1.height, c2.height) &&
+		SameBox(node.box, Aabb::Union(c1.box, c2.box)) &&
+		ValidateNode(node.child1) && ValidateNode(node.child2);
+}
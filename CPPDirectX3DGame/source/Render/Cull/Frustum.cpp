@@ -0,0 +1,121 @@
+#include "Render/Cull/Frustum.h"
+
+using namespace OMath;
+
+Frustum::Frustum() noexcept
+{
+	// accepts everything until Set is called
+	for (int g = 0; g < 2; g++)
+	{
+		px[g] = py[g] = pz[g] = ax[g] = ay[g] = az[g] = XMVectorZero();
+		pw[g] = XMVectorReplicate(1.0f);
+	}
+}
+
+Frustum::Frustum(FXMMATRIX viewProjection) noexcept
+{
+	Set(viewProjection);
+}
+
+void Frustum::Set(FXMMATRIX viewProjection) noexcept
+{
+	// clip = v * m, so the planes come from the columns of m
+	const XMMATRIX t = XMMatrixTranspose(viewProjection);
+	XMFLOAT4 planes[8];
+	XMStoreFloat4(&planes[Left], XMPlaneNormalize(XMVectorAdd(t.r[3], t.r[0])));
+	XMStoreFloat4(&planes[Right], XMPlaneNormalize(XMVectorSubtract(t.r[3], t.r[0])));
+	XMStoreFloat4(&planes[Bottom], XMPlaneNormalize(XMVectorAdd(t.r[3], t.r[1])));
+	XMStoreFloat4(&planes[Top], XMPlaneNormalize(XMVectorSubtract(t.r[3], t.r[1])));
+	// z in [0, 1]
+	XMStoreFloat4(&planes[Near], XMPlaneNormalize(t.r[2]));
+	XMStoreFloat4(&planes[Far], XMPlaneNormalize(XMVectorSubtract(t.r[3], t.r[2])));
+	planes[6] = planes[7] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+	for (int g = 0; g < 2; g++)
+	{
+		const XMFLOAT4* p = planes + g * 4;
+		px[g] = XMVectorSet(p[0].x, p[1].x, p[2].x, p[3].x);
+		py[g] = XMVectorSet(p[0].y, p[1].y, p[2].y, p[3].y);
+		pz[g] = XMVectorSet(p[0].z, p[1].z, p[2].z, p[3].z);
+		pw[g] = XMVectorSet(p[0].w, p[1].w, p[2].w, p[3].w);
+		ax[g] = XMVectorAbs(px[g]);
+		ay[g] = XMVectorAbs(py[g]);
+		az[g] = XMVectorAbs(pz[g]);
+	}
+}
+
+Frustum::Result Frustum::Test(const Aabb& box, uint32_t& planeMask) const noexcept
+{
+	const XMVECTOR cx = XMVectorReplicate((box.min.x + box.max.x) * 0.5f);
+	const XMVECTOR cy = XMVectorReplicate((box.min.y + box.max.y) * 0.5f);
+	const XMVECTOR cz = XMVectorReplicate((box.min.z + box.max.z) * 0.5f);
+	const XMVECTOR ex = XMVectorReplicate((box.max.x - box.min.x) * 0.5f);
+	const XMVECTOR ey = XMVectorReplicate((box.max.y - box.min.y) * 0.5f);
+	const XMVECTOR ez = XMVectorReplicate((box.max.z - box.min.z) * 0.5f);
+	uint32_t outside = 0u;
+	uint32_t straddle = 0u;
+	for (int g = 0; g < 2; g++)
+	{
+		// signed distance of the center and the box's reach towards each plane
+		const XMVECTOR d = XMVectorMultiplyAdd(cz, pz[g], XMVectorMultiplyAdd(cy, py[g], XMVectorMultiplyAdd(cx, px[g], pw[g])));
+		const XMVECTOR r = XMVectorMultiplyAdd(ez, az[g], XMVectorMultiplyAdd(ey, ay[g], XMVectorMultiply(ex, ax[g])));
+		outside |= XMVectorMoveMask(XMVectorLess(XMVectorAdd(d, r), XMVectorZero())) << (g * 4);
+		straddle |= XMVectorMoveMask(XMVectorLess(XMVectorSubtract(d, r), XMVectorZero())) << (g * 4);
+	}
+	if (outside & planeMask)
+	{
+		return Result::Outside;
+	}
+	planeMask &= straddle;
+	return planeMask == 0u ? Result::Inside : Result::Intersect;
+}
+
+Frustum::Result Frustum::Test(const Sphere& sphere, uint32_t& planeMask) const noexcept
+{
+	const XMVECTOR cx = XMVectorReplicate(sphere.center.x);
+	const XMVECTOR cy = XMVectorReplicate(sphere.center.y);
+	const XMVECTOR cz = XMVectorReplicate(sphere.center.z);
+	const XMVECTOR r = XMVectorReplicate(sphere.radius);
+	uint32_t outside = 0u;
+	uint32_t straddle = 0u;
+	for (int g = 0; g < 2; g++)
+	{
+		const XMVECTOR d = XMVectorMultiplyAdd(cz, pz[g], XMVectorMultiplyAdd(cy, py[g], XMVectorMultiplyAdd(cx, px[g], pw[g])));
+		outside |= XMVectorMoveMask(XMVectorLess(XMVectorAdd(d, r), XMVectorZero())) << (g * 4);
+		straddle |= XMVectorMoveMask(XMVectorLess(XMVectorSubtract(d, r), XMVectorZero())) << (g * 4);
+	}
+	if (outside & planeMask)
+	{
+		return Result::Outside;
+	}
+	planeMask &= straddle;
+	return planeMask == 0u ? Result::Inside : Result::Intersect;
+}
+
+bool Frustum::IsVisible(const Aabb& box) const noexcept
+{
+	uint32_t mask = allPlanes;
+	return Test(box, mask) != Result::Outside;
+}
+
+bool Frustum::IsVisible(const Sphere& sphere) const noexcept
+{
+	uint32_t mask = allPlanes;
+	return Test(sphere, mask) != Result::Outside;
+}
+
+XMFLOAT4 Frustum::GetPlane(Plane plane) const noexcept
+{
+	const int g = plane / 4;
+	const int lane = plane % 4;
+	XMFLOAT4 x, y, z, w;
+	XMStoreFloat4(&x, px[g]);
+	XMStoreFloat4(&y, py[g]);
+	XMStoreFloat4(&z, pz[g]);
+	XMStoreFloat4(&w, pw[g]);
+	const float* fx = &x.x;
+	const float* fy = &y.x;
+	const float* fz = &z.x;
+	const float* fw = &w.x;
+	return { fx[lane], fy[lane], fz[lane], fw[lane] };
+}
@@ -1,5 +1,11 @@
 #include "Render/Graphics.h"
 #include "Render/GraphicsThrowMacros.h"
+#include "Render/Software/SoftwareRasterizer.h"
+#include "Render/Present/DxgiSwapChain.h"
+#include "Render/Upload/D3D11FrameFence.h"
+#include "Render/Upload/D3D11UploadBuffer.h"
+#include "Render/Upload/UploadRing.h"
+#include "Profile/Profiler.h"
 #include "OWin/OWin.h"
 #include <sstream>
 #include <unordered_map>
@@ -7,105 +13,387 @@
 #include <cmath>
 #include <DirectXMath.h>
 #include <array>
+#include <cassert>
+#include <cstring>
 
 namespace wrl = Microsoft::WRL;
 namespace dx = DirectX;
 
+namespace
+{
+	// sized for a frame of dynamic geometry and per-draw constants with
+	// room for the frames still in flight before a wrap
+	constexpr size_t vertexUploadSize = 16u * 1024u * 1024u;
+	constexpr size_t constantUploadSize = 4u * 1024u * 1024u;
+
+	// NDC positions and vertex colors, the same thing the software rasterizer does
+	constexpr char immediateShaderSource[] = R"(
+struct VSOut
+{
+	float4 color : COLOR;
+	float4 pos : SV_Position;
+};
+VSOut VSMain(float2 pos : POSITION, float4 color : COLOR)
+{
+	VSOut vso;
+	vso.pos = float4(pos, 0.0f, 1.0f);
+	vso.color = color;
+	return vso;
+}
+float4 PSMain(float4 color : COLOR) : SV_Target
+{
+	return color;
+}
+)";
+}
+
 #pragma comment(lib, "d3d11.lib")
 #pragma comment(lib,"D3DCompiler.lib")
 
-Graphics::Graphics(HWND hWnd, int width, int height)
-{
-	DXGI_SWAP_CHAIN_DESC sd = {};
-	// Width and height 0 means look at the window and you figure it out
-	sd.BufferDesc.Width = width;
-	sd.BufferDesc.Height = height;
-	// Layout of the pixels, channels in there and this is the BGRA layout
-	sd.BufferDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
-	// Refresh rate, pick whatever is available
-	sd.BufferDesc.RefreshRate.Numerator = 0;
-	sd.BufferDesc.RefreshRate.Denominator = 0;
-	// Since the width and height is undefined, scaling should not be specified
-	sd.BufferDesc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
-	sd.BufferDesc.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED;
-	// Anti-aliasing
-	sd.SampleDesc.Count = 1;
-	sd.SampleDesc.Quality = 0;
-	// Buffer
-	sd.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-	sd.BufferCount = 1; // One back buffer (double buffering)
-	// Window mode
-	sd.OutputWindow = hWnd;
-	sd.Windowed = TRUE;
-	// Effect used for flipping the presentation
-	sd.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
-	sd.Flags = 0;
-
-	UINT swapCreateFlags = 0u;
+Graphics::Graphics(HWND hWnd, int width, int height, Backend backend)
+	:
+	width(width),
+	height(height),
+	hWnd(hWnd)
+{
+	if (backend == Backend::Software)
+	{
+		pSoftware = std::make_unique<SoftwareRasterizer>(this->width, this->height, pJobs);
+		return;
+	}
+
+	UINT deviceCreateFlags = 0u;
 #ifndef NDEBUG
-	swapCreateFlags |= D3D11_CREATE_DEVICE_DEBUG;
+	deviceCreateFlags |= D3D11_CREATE_DEVICE_DEBUG;
 #endif
 
 	// for checking results of d3d functions
 	HRESULT hr;
 
-	// Creates a device that represents the display adapter and a swap chain used for rendering.
-	// Also creates front/back buffers.
-	GFX_THROW_INFO(D3D11CreateDeviceAndSwapChain(
+	// Creates a device that represents the display adapter, the swap chain
+	// is created separately so it can use the flip model
+	GFX_THROW_INFO(D3D11CreateDevice(
 		nullptr,
 		D3D_DRIVER_TYPE_HARDWARE,
 		nullptr,
-		swapCreateFlags,
+		deviceCreateFlags,
 		nullptr,
 		0,
 		D3D11_SDK_VERSION,
-		&sd,
-		&pSwap,
 		&pDevice,
 		nullptr,
 		&pContext));
 
+	SwapChain::Desc sd;
+	sd.width = this->width;
+	sd.height = this->height;
+	// flip-discard with one back buffer being drawn while the other is shown,
+	// and at most one frame queued so input latency stays low
+	sd.effect = SwapChain::Effect::FlipDiscard;
+	sd.bufferCount = 2u;
+	sd.maxFrameLatency = 1u;
+	sd.allowTearing = true;
+	pSwapChain = std::make_unique<DxgiSwapChain>(pDevice.Get(), hWnd, sd);
+	pPacer = std::make_unique<FramePacer>(*pSwapChain);
+
 	// Gain access to texture subresource in swap chain (back buffer)
 	wrl::ComPtr<ID3D11Resource> pBackBuffer;
-	// first param 0 will give the back buffer
-	GFX_THROW_INFO(pSwap->GetBuffer(0, __uuidof(ID3D11Resource), &pBackBuffer));
+	// with D3D11 buffer 0 always is the current back buffer, also on the flip model
+	GFX_THROW_INFO(pSwapChain->Get()->GetBuffer(0, __uuidof(ID3D11Resource), &pBackBuffer));
 	GFX_THROW_INFO(pDevice->CreateRenderTargetView(pBackBuffer.Get(), nullptr, &pTarget));
 
+	pFrameFence = std::make_unique<D3D11FrameFence>(pDevice.Get(), pContext.Get());
+	pVertexUploadBuffer = std::make_unique<D3D11UploadBuffer>(pDevice.Get(), pContext.Get(), vertexUploadSize,
+		UINT(D3D11_BIND_VERTEX_BUFFER | D3D11_BIND_INDEX_BUFFER));
+	pVertexUploads = std::make_unique<UploadRing>(*pVertexUploadBuffer, *pFrameFence, sd.maxFrameLatency + 1u);
+	if (D3D11UploadBuffer::IsNoOverwriteSupported(pDevice.Get(), D3D11_BIND_CONSTANT_BUFFER))
+	{
+		// slices are bound with *SSetConstantBuffers1, which counts in 16 constants
+		pConstantUploadBuffer = std::make_unique<D3D11UploadBuffer>(pDevice.Get(), pContext.Get(), constantUploadSize,
+			UINT(D3D11_BIND_CONSTANT_BUFFER));
+		pConstantUploads = std::make_unique<UploadRing>(*pConstantUploadBuffer, *pFrameFence, sd.maxFrameLatency + 1u);
+	}
+
 	// GFX_THROW_INFO(pSwp->GetBuffer(0, __uuidof(ID3D11Texture2D), &pBackBuffer));
 	// pTarget = std::shared_ptr<Bind::RenderTarget>{ new Bind::OutputOnlyRenderTarget(*this,pBackBuffer.Get()) };
 }
 
+Graphics::~Graphics() = default;
+
 void Graphics::EndFrame()
 {
-	HRESULT hr;
+	O_PROFILE_FUNCTION();
+	if (pSoftware)
+	{
+		pSoftware->EndFrame();
+		PresentSoftware();
+		return;
+	}
+
+	// the fence goes in right after the frame's last use of the rings
+	frameFenceValue++;
+	for (UploadRing* pRing : { pVertexUploads.get(), pConstantUploads.get() })
+	{
+		if (pRing)
+		{
+			pRing->EndFrame(frameFenceValue);
+		}
+	}
+	pFrameFence->Signal(frameFenceValue);
 
 #ifndef NDEBUG
 	infoManager.Set();
 #endif // NDEBUG
 
-	if (FAILED(hr = pSwap->Present(1u, 0u))) {
-		if (hr == DXGI_ERROR_DEVICE_REMOVED) {
-			throw GFX_DEVICE_REMOVED_EXCEPT(pDevice->GetDeviceRemovedReason());
-		}
-		else {
-			throw GFX_EXCEPT(hr);
+	switch (pPacer->Present())
+	{
+	case SwapChain::PresentResult::DeviceRemoved:
+		if (softwareFallback) {
+			SwitchToSoftware();
+			return;
 		}
+		throw GFX_DEVICE_REMOVED_EXCEPT(pDevice->GetDeviceRemovedReason());
+	case SwapChain::PresentResult::Error:
+		throw GFX_EXCEPT(pSwapChain->GetLastPresentError());
+	default:
+		// occluded frames are fine, the pacer throttles until we are visible again
+		break;
+	}
+}
+
+void Graphics::BeginFrame(float red, float green, float blue) noexcept
+{
+	O_PROFILE_FUNCTION();
+	if (!pSoftware)
+	{
+		pPacer->BeginFrame();
+		// the flip model unbinds the back buffer on every present
+		pContext->OMSetRenderTargets(1u, pTarget.GetAddressOf(), nullptr);
+		D3D11_VIEWPORT vp = {};
+		vp.Width = float(width);
+		vp.Height = float(height);
+		vp.MinDepth = 0.0f;
+		vp.MaxDepth = 1.0f;
+		pContext->RSSetViewports(1u, &vp);
 	}
+	ClearBuffer(red, green, blue);
 }
 
 void Graphics::ClearBuffer(float r, float g, float b) noexcept
 {
+	if (pSoftware)
+	{
+		pSoftware->ClearBuffer(r, g, b);
+		return;
+	}
 	const float color[]{ r, g, b, 1.0f };
 	pContext->ClearRenderTargetView(pTarget.Get(), color);
 }
 
+void Graphics::DrawIndexed(UINT count) noxnd
+{
+	if (!pContext)
+	{
+		assert(false && "DrawIndexed(count) needs the D3D11 device, the software backend only takes vertex arrays");
+		return;
+	}
+	GFX_THROW_INFO_ONLY(pContext->DrawIndexed(count, 0u, 0u));
+}
+
+void Graphics::DrawIndexed(const RenderBackend::Vertex* pVertices, size_t vertexCount, const unsigned short* pIndices, size_t indexCount)
+{
+	if (pSoftware)
+	{
+		pSoftware->DrawIndexed(pVertices, vertexCount, pIndices, indexCount);
+		return;
+	}
+	if (indexCount == 0u)
+	{
+		return;
+	}
+	if (!pImmediateVertexShader)
+	{
+		CreateImmediatePipeline();
+	}
+
+	// vertices and indices share one slice so a wrap cannot come between them
+	const size_t vertexBytes = sizeof(RenderBackend::Vertex) * vertexCount;
+	const size_t indexBytes = sizeof(unsigned short) * indexCount;
+	const UploadRing::Allocation slice = pVertexUploads->Allocate(vertexBytes + indexBytes);
+	std::memcpy(slice.pData, pVertices, vertexBytes);
+	std::memcpy(static_cast<std::byte*>(slice.pData) + vertexBytes, pIndices, indexBytes);
+	pVertexUploads->Flush();
+
+	ID3D11Buffer* pBuffer = pVertexUploadBuffer->Get();
+	const UINT stride = UINT(sizeof(RenderBackend::Vertex));
+	const UINT offset = UINT(slice.offset);
+	pContext->IASetVertexBuffers(0u, 1u, &pBuffer, &stride, &offset);
+	// the vertex size keeps this 2 byte aligned
+	pContext->IASetIndexBuffer(pBuffer, DXGI_FORMAT_R16_UINT, UINT(slice.offset + vertexBytes));
+	pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	pContext->IASetInputLayout(pImmediateLayout.Get());
+	pContext->VSSetShader(pImmediateVertexShader.Get(), nullptr, 0u);
+	pContext->PSSetShader(pImmediatePixelShader.Get(), nullptr, 0u);
+	pContext->RSSetState(pImmediateRasterizer.Get());
+	GFX_THROW_INFO_ONLY(pContext->DrawIndexed(UINT(indexCount), 0u, 0));
+}
+
 void Graphics::DrawTestTriangle()
 {
-	wrl::ComPtr<ID3D11Buffer> pVertexBuffer;
-	D3D11_BUFFER_DESC bd = {};
-	// pDevice->CreateBuffer();
-	// pContext->IASetVertexBuffers();
-	// pContext->Draw(3u, 0u);
+	const RenderBackend::Vertex vertices[] =
+	{
+		{ {  0.0f,  0.5f }, { 255, 0, 0, 255 } },
+		{ {  0.5f, -0.5f }, { 0, 255, 0, 255 } },
+		{ { -0.5f, -0.5f }, { 0, 0, 255, 255 } },
+	};
+	const unsigned short indices[] = { 0, 1, 2 };
+	DrawIndexed(vertices, std::size(vertices), indices, std::size(indices));
+}
+
+UINT Graphics::GetWidth() const noexcept
+{
+	return width;
+}
+
+UINT Graphics::GetHeight() const noexcept
+{
+	return height;
+}
+
+void Graphics::SetJobs(JobSystem* pJobs) noexcept
+{
+	this->pJobs = pJobs;
+	if (pSoftware)
+	{
+		pSoftware->SetJobs(pJobs);
+	}
+}
+
+Graphics::Backend Graphics::GetBackend() const noexcept
+{
+	return pSoftware ? Backend::Software : Backend::Hardware;
+}
+
+void Graphics::EnableSoftwareFallback() noexcept
+{
+	softwareFallback = true;
+}
+
+void Graphics::DisableSoftwareFallback() noexcept
+{
+	softwareFallback = false;
+}
+
+bool Graphics::IsSoftwareFallbackEnabled() const noexcept
+{
+	return softwareFallback;
+}
+
+void Graphics::SetVSync(bool enabled) noexcept
+{
+	vsync = enabled;
+	if (pPacer)
+	{
+		pPacer->SetVSync(enabled);
+	}
+}
+
+bool Graphics::IsVSync() const noexcept
+{
+	return vsync;
+}
+
+FramePacer::Stats Graphics::GetPresentStats() const noexcept
+{
+	return pPacer ? pPacer->GetStats() : FramePacer::Stats{};
+}
+
+UploadRing* Graphics::GetVertexUploads() noexcept
+{
+	return pVertexUploads.get();
+}
+
+ID3D11Buffer* Graphics::GetVertexUploadBuffer() const noexcept
+{
+	return pVertexUploadBuffer ? pVertexUploadBuffer->Get() : nullptr;
+}
+
+UploadRing* Graphics::GetConstantUploads() noexcept
+{
+	return pConstantUploads.get();
+}
+
+ID3D11Buffer* Graphics::GetConstantUploadBuffer() const noexcept
+{
+	return pConstantUploadBuffer ? pConstantUploadBuffer->Get() : nullptr;
+}
+
+void Graphics::CreateImmediatePipeline()
+{
+	// for checking results of d3d functions
+	HRESULT hr;
+
+	wrl::ComPtr<ID3DBlob> pVertexBlob;
+	wrl::ComPtr<ID3DBlob> pPixelBlob;
+	GFX_THROW_INFO(D3DCompile(immediateShaderSource, sizeof(immediateShaderSource) - 1u, "ImmediateDraw",
+		nullptr, nullptr, "VSMain", "vs_4_0", 0u, 0u, &pVertexBlob, nullptr));
+	GFX_THROW_INFO(D3DCompile(immediateShaderSource, sizeof(immediateShaderSource) - 1u, "ImmediateDraw",
+		nullptr, nullptr, "PSMain", "ps_4_0", 0u, 0u, &pPixelBlob, nullptr));
+	GFX_THROW_INFO(pDevice->CreateVertexShader(pVertexBlob->GetBufferPointer(), pVertexBlob->GetBufferSize(), nullptr, &pImmediateVertexShader));
+	GFX_THROW_INFO(pDevice->CreatePixelShader(pPixelBlob->GetBufferPointer(), pPixelBlob->GetBufferSize(), nullptr, &pImmediatePixelShader));
+
+	const D3D11_INPUT_ELEMENT_DESC elements[] =
+	{
+		{ "POSITION", 0u, DXGI_FORMAT_R32G32_FLOAT, 0u, 0u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+		{ "COLOR", 0u, DXGI_FORMAT_R8G8B8A8_UNORM, 0u, 8u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+	};
+	GFX_THROW_INFO(pDevice->CreateInputLayout(elements, UINT(std::size(elements)),
+		pVertexBlob->GetBufferPointer(), pVertexBlob->GetBufferSize(), &pImmediateLayout));
+
+	// the software rasterizer draws both windings
+	D3D11_RASTERIZER_DESC rd = {};
+	rd.FillMode = D3D11_FILL_SOLID;
+	rd.CullMode = D3D11_CULL_NONE;
+	rd.DepthClipEnable = TRUE;
+	GFX_THROW_INFO(pDevice->CreateRasterizerState(&rd, &pImmediateRasterizer));
+}
+
+void Graphics::SwitchToSoftware()
+{
+	// the device is gone, drop everything that refers to it so the window
+	// surface is free for GDI presentation
+	pImmediateRasterizer.Reset();
+	pImmediateLayout.Reset();
+	pImmediatePixelShader.Reset();
+	pImmediateVertexShader.Reset();
+	pConstantUploads.reset();
+	pConstantUploadBuffer.reset();
+	pVertexUploads.reset();
+	pVertexUploadBuffer.reset();
+	pFrameFence.reset();
+	pTarget.Reset();
+	pContext.Reset();
+	pPacer.reset();
+	pSwapChain.reset();
+	pDevice.Reset();
+	pSoftware = std::make_unique<SoftwareRasterizer>(width, height, pJobs);
+}
+
+void Graphics::PresentSoftware() noexcept
+{
+	BITMAPINFO bmi = {};
+	bmi.bmiHeader.biSize = sizeof(bmi.bmiHeader);
+	bmi.bmiHeader.biWidth = LONG(pSoftware->GetPitch());
+	// negative height for a top-down image
+	bmi.bmiHeader.biHeight = -LONG(height);
+	bmi.bmiHeader.biPlanes = 1;
+	// 32bpp BI_RGB is B8G8R8X8 in memory, same as the rasterizer output
+	bmi.bmiHeader.biBitCount = 32;
+	bmi.bmiHeader.biCompression = BI_RGB;
+	// window class uses CS_OWNDC so this is cheap
+	const HDC hdc = GetDC(hWnd);
+	SetDIBitsToDevice(hdc, 0, 0, width, height, 0, 0, 0u, height, pSoftware->GetFrontBuffer(), &bmi, DIB_RGB_COLORS);
+	ReleaseDC(hWnd, hdc);
 }
 
 // Graphics exception
@@ -258,6 +546,11 @@ const char* Graphics::DeviceRemovedException::GetType() const noexcept
 {
 	return "O Graphics Exception [Device Removed] (DXGI_ERROR_DEVICE_REMOVED)";
 }
+
+const char* Graphics::NoDeviceException::GetType() const noexcept
+{
+	return "O Graphics Exception [No Device]";
+}
 Graphics::InfoException::InfoException(int line, const char* file, std::vector<std::string> infoMsgs) noexcept
 	:
 	Exception(line, file)
@@ -0,0 +1,35 @@
+#include "Render/GraphicsResource.h"
+#include "Render/GraphicsThrowMacros.h"
+#include <stdexcept>
+
+bool GraphicsResource::HasDevice(Graphics& gfx) noexcept
+{
+	return gfx.pContext != nullptr;
+}
+
+ID3D11DeviceContext* GraphicsResource::GetContext(Graphics& gfx)
+{
+	if (!gfx.pContext)
+	{
+		throw GFX_NO_DEVICE_EXCEPT();
+	}
+	return gfx.pContext.Get();
+}
+
+ID3D11Device* GraphicsResource::GetDevice(Graphics& gfx)
+{
+	if (!gfx.pDevice)
+	{
+		throw GFX_NO_DEVICE_EXCEPT();
+	}
+	return gfx.pDevice.Get();
+}
+
+DxgiInfoManager& GraphicsResource::GetInfoManager(Graphics& gfx)
+{
+#ifndef NDEBUG
+	return gfx.infoManager;
+#else
+	throw std::logic_error("Tried to access gfx.infoManager in Release config");
+#endif
+}
@@ -0,0 +1,169 @@
+#include "Render/Present/DxgiSwapChain.h"
+#include "Render/Graphics.h"
+#include "Render/GraphicsThrowMacros.h"
+#include <algorithm>
+
+namespace wrl = Microsoft::WRL;
+
+DxgiSwapChain::DxgiSwapChain(ID3D11Device* pDevice, HWND hWnd, const Desc& desc)
+	:
+	desc(desc)
+{
+	HRESULT hr = E_FAIL;
+
+	// the factory has to be the one that created the device
+	wrl::ComPtr<IDXGIDevice1> pDxgiDevice;
+	GFX_THROW_NOINFO(pDevice->QueryInterface(__uuidof(IDXGIDevice1), &pDxgiDevice));
+	wrl::ComPtr<IDXGIAdapter> pAdapter;
+	GFX_THROW_NOINFO(pDxgiDevice->GetAdapter(&pAdapter));
+	wrl::ComPtr<IDXGIFactory2> pFactory;
+	GFX_THROW_NOINFO(pAdapter->GetParent(__uuidof(IDXGIFactory2), &pFactory));
+
+	// tearing needs Windows 10 and a driver that can do it in windowed mode
+	wrl::ComPtr<IDXGIFactory5> pFactory5;
+	if (desc.allowTearing && SUCCEEDED(pFactory.As(&pFactory5)))
+	{
+		BOOL allow = FALSE;
+		if (SUCCEEDED(pFactory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allow, sizeof(allow))))
+		{
+			tearingSupported = allow == TRUE;
+		}
+	}
+
+	// try the requested effect first, then the older ones
+	const Effect effects[] = { Effect::FlipDiscard, Effect::FlipSequential, Effect::Discard };
+	const Effect* pFirst = std::find(std::begin(effects), std::end(effects), desc.effect);
+	for (const Effect* pEffect = pFirst; pEffect != std::end(effects); pEffect++)
+	{
+		const bool flip = *pEffect != Effect::Discard;
+		DXGI_SWAP_CHAIN_DESC1 sd = {};
+		sd.Width = desc.width;
+		sd.Height = desc.height;
+		sd.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+		sd.SampleDesc.Count = 1;
+		sd.SampleDesc.Quality = 0;
+		sd.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+		// flip model needs a front buffer of its own
+		sd.BufferCount = flip ? std::max(desc.bufferCount, 2u) : 1u;
+		sd.Scaling = DXGI_SCALING_STRETCH;
+		sd.SwapEffect = ToDxgi(*pEffect);
+		sd.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
+		sd.Flags = 0u;
+		if (flip)
+		{
+			sd.Flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+			if (tearingSupported)
+			{
+				sd.Flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+			}
+		}
+		hr = pFactory->CreateSwapChainForHwnd(pDevice, hWnd, &sd, nullptr, nullptr, &pSwap);
+		if (SUCCEEDED(hr))
+		{
+			this->desc.effect = *pEffect;
+			this->desc.bufferCount = sd.BufferCount;
+			break;
+		}
+	}
+	if (!pSwap)
+	{
+		throw GFX_EXCEPT_NOINFO(hr);
+	}
+	if (this->desc.effect == Effect::Discard)
+	{
+		tearingSupported = false;
+	}
+
+	this->desc.maxFrameLatency = std::clamp(desc.maxFrameLatency, 1u, 16u);
+	wrl::ComPtr<IDXGISwapChain2> pSwap2;
+	if (this->desc.effect != Effect::Discard && SUCCEEDED(pSwap.As(&pSwap2)))
+	{
+		GFX_THROW_NOINFO(pSwap2->SetMaximumFrameLatency(this->desc.maxFrameLatency));
+		hFrameLatency = pSwap2->GetFrameLatencyWaitableObject();
+	}
+	else
+	{
+		// no waitable object, at least bound the queue on the device
+		GFX_THROW_NOINFO(pDxgiDevice->SetMaximumFrameLatency(this->desc.maxFrameLatency));
+	}
+}
+
+DxgiSwapChain::~DxgiSwapChain()
+{
+	if (hFrameLatency)
+	{
+		CloseHandle(hFrameLatency);
+	}
+}
+
+bool DxgiSwapChain::WaitForNextFrame(unsigned int timeoutMs) noexcept
+{
+	if (!hFrameLatency)
+	{
+		// blit model blocks inside Present instead
+		return true;
+	}
+	return WaitForSingleObjectEx(hFrameLatency, timeoutMs, TRUE) == WAIT_OBJECT_0;
+}
+
+DxgiSwapChain::PresentResult DxgiSwapChain::Present(unsigned int syncInterval, unsigned int flags)
+{
+	UINT dxgiFlags = 0u;
+	if (flags & presentTest)
+	{
+		dxgiFlags |= DXGI_PRESENT_TEST;
+	}
+	if ((flags & presentAllowTearing) && tearingSupported && syncInterval == 0u)
+	{
+		dxgiFlags |= DXGI_PRESENT_ALLOW_TEARING;
+	}
+
+	const HRESULT hr = pSwap->Present(syncInterval, dxgiFlags);
+	if (hr == DXGI_STATUS_OCCLUDED)
+	{
+		return PresentResult::Occluded;
+	}
+	if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
+	{
+		return PresentResult::DeviceRemoved;
+	}
+	if (FAILED(hr))
+	{
+		lastError = hr;
+		return PresentResult::Error;
+	}
+	return PresentResult::Ok;
+}
+
+bool DxgiSwapChain::IsTearingSupported() const noexcept
+{
+	return tearingSupported;
+}
+
+const SwapChain::Desc& DxgiSwapChain::GetDesc() const noexcept
+{
+	return desc;
+}
+
+IDXGISwapChain1* DxgiSwapChain::Get() const noexcept
+{
+	return pSwap.Get();
+}
+
+HRESULT DxgiSwapChain::GetLastPresentError() const noexcept
+{
+	return lastError;
+}
+
+DXGI_SWAP_EFFECT DxgiSwapChain::ToDxgi(Effect effect) noexcept
+{
+	switch (effect)
+	{
+	case Effect::FlipSequential:
+		return DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;
+	case Effect::FlipDiscard:
+		return DXGI_SWAP_EFFECT_FLIP_DISCARD;
+	default:
+		return DXGI_SWAP_EFFECT_DISCARD;
+	}
+}
@@ -0,0 +1,148 @@
+#include "Render/Present/FakeSwapChain.h"
+#include <algorithm>
+#include <cmath>
+
+FakeSwapChain::FakeSwapChain(const Desc& desc, double refreshRate, bool tearingSupported)
+	:
+	desc(desc),
+	refreshPeriod(1.0 / refreshRate),
+	tearingSupported(tearingSupported && desc.allowTearing && desc.effect != Effect::Discard)
+{
+	this->desc.maxFrameLatency = std::max(this->desc.maxFrameLatency, 1u);
+}
+
+bool FakeSwapChain::WaitForNextFrame(unsigned int timeoutMs) noexcept
+{
+	waits++;
+	Retire();
+	if (queue.size() < desc.maxFrameLatency)
+	{
+		return true;
+	}
+	// the waitable object is signaled when the oldest frame leaves the queue
+	const double wait = queue.front() - time;
+	if (wait * 1000.0 > double(timeoutMs))
+	{
+		time += double(timeoutMs) / 1000.0;
+		return false;
+	}
+	time = queue.front();
+	Retire();
+	return true;
+}
+
+FakeSwapChain::PresentResult FakeSwapChain::Present(unsigned int syncInterval, unsigned int flags)
+{
+	if (removed)
+	{
+		return PresentResult::DeviceRemoved;
+	}
+	if ((flags & presentAllowTearing) && (syncInterval != 0u || !tearingSupported))
+	{
+		// DXGI rejects tearing with vsync or without swap chain support
+		return PresentResult::Error;
+	}
+	if (flags & presentTest)
+	{
+		return occluded ? PresentResult::Occluded : PresentResult::Ok;
+	}
+	if (occluded)
+	{
+		presents.push_back({ syncInterval, flags, -1.0 });
+		return PresentResult::Occluded;
+	}
+
+	Retire();
+	double display;
+	if (syncInterval == 0u && (flags & presentAllowTearing))
+	{
+		// goes out immediately, mid-scanout
+		display = std::max(time, queue.empty() ? time : queue.back());
+	}
+	else if (syncInterval == 0u)
+	{
+		// without tearing the compositor still shows it on the next vblank,
+		// but it replaces rather than queues behind anything pending there
+		display = NextVBlank(std::max(time, queue.empty() ? lastDisplay : queue.back()));
+	}
+	else
+	{
+		const double after = std::max(time, queue.empty() ? lastDisplay : queue.back());
+		display = NextVBlank(after) + refreshPeriod * double(syncInterval - 1u);
+	}
+	queue.push_back(display);
+	presents.push_back({ syncInterval, flags, display });
+	return PresentResult::Ok;
+}
+
+bool FakeSwapChain::IsTearingSupported() const noexcept
+{
+	return tearingSupported;
+}
+
+const SwapChain::Desc& FakeSwapChain::GetDesc() const noexcept
+{
+	return desc;
+}
+
+void FakeSwapChain::Advance(double seconds) noexcept
+{
+	time += seconds;
+	Retire();
+}
+
+void FakeSwapChain::SetOccluded(bool occluded) noexcept
+{
+	this->occluded = occluded;
+}
+
+void FakeSwapChain::SetDeviceRemoved() noexcept
+{
+	removed = true;
+}
+
+double FakeSwapChain::GetTime() const noexcept
+{
+	return time;
+}
+
+size_t FakeSwapChain::GetQueuedFrames() const noexcept
+{
+	return queue.size();
+}
+
+uint64_t FakeSwapChain::GetWaitCount() const noexcept
+{
+	return waits;
+}
+
+const std::vector<FakeSwapChain::PresentCall>& FakeSwapChain::GetPresents() const noexcept
+{
+	return presents;
+}
+
+void FakeSwapChain::Reset() noexcept
+{
+	occluded = false;
+	removed = false;
+	time = 0.0;
+	lastDisplay = 0.0;
+	waits = 0u;
+	queue.clear();
+	presents.clear();
+}
+
+double FakeSwapChain::NextVBlank(double after) const noexcept
+{
+	// strictly after, a frame handed over exactly on a vblank misses it
+	return (std::floor(after / refreshPeriod) + 1.0) * refreshPeriod;
+}
+
+void FakeSwapChain::Retire() noexcept
+{
+	while (!queue.empty() && queue.front() <= time)
+	{
+		lastDisplay = queue.front();
+		queue.pop_front();
+	}
+}
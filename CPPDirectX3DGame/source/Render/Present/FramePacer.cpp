@@ -0,0 +1,88 @@
+#include "Render/Present/FramePacer.h"
+#include "Time/OTimer.h"
+#include <chrono>
+#include <thread>
+
+FramePacer::FramePacer(SwapChain& swapChain, std::function<void(unsigned int)> sleep)
+	:
+	swapChain(swapChain),
+	sleep(std::move(sleep))
+{
+	if (!this->sleep)
+	{
+		this->sleep = [](unsigned int ms)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+		};
+	}
+}
+
+void FramePacer::BeginFrame() noexcept
+{
+	stats.frames++;
+	OTimer wait;
+	if (occluded)
+	{
+		// nobody can see us, no point in running at full rate
+		stats.occludedFrames++;
+		sleep(occludedThrottleMs);
+	}
+	else if (!swapChain.WaitForNextFrame(waitTimeoutMs))
+	{
+		stats.waitTimeouts++;
+	}
+	stats.lastWaitSeconds = wait.Mark();
+}
+
+SwapChain::PresentResult FramePacer::Present()
+{
+	if (occluded)
+	{
+		// only probe whether we became visible again
+		stats.testPresents++;
+		const auto result = swapChain.Present(0u, SwapChain::presentTest);
+		if (result == SwapChain::PresentResult::Ok)
+		{
+			occluded = false;
+		}
+		return result == SwapChain::PresentResult::Ok ? SwapChain::PresentResult::Occluded : result;
+	}
+
+	unsigned int flags = 0u;
+	if (!vsync && swapChain.IsTearingSupported())
+	{
+		flags |= SwapChain::presentAllowTearing;
+	}
+	stats.presents++;
+	const auto result = swapChain.Present(vsync ? 1u : 0u, flags);
+	if (result == SwapChain::PresentResult::Occluded)
+	{
+		occluded = true;
+	}
+	return result;
+}
+
+void FramePacer::SetVSync(bool enabled) noexcept
+{
+	vsync = enabled;
+}
+
+bool FramePacer::IsVSync() const noexcept
+{
+	return vsync;
+}
+
+void FramePacer::SetOccludedThrottle(unsigned int milliseconds) noexcept
+{
+	occludedThrottleMs = milliseconds;
+}
+
+bool FramePacer::IsOccluded() const noexcept
+{
+	return occluded;
+}
+
+FramePacer::Stats FramePacer::GetStats() const noexcept
+{
+	return stats;
+}
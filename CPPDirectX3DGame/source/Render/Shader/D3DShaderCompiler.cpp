@@ -0,0 +1,90 @@
+#include "Render/Shader/D3DShaderCompiler.h"
+#include "OWin/OWin.h"
+#include "OWin/OWrl.h"
+#include <d3dcompiler.h>
+#include <cstring>
+#include <unordered_map>
+
+#pragma comment(lib,"D3DCompiler.lib")
+
+namespace
+{
+	// serves #include from the files the cache already read, so the compile
+	// sees exactly the text that was hashed
+	class SourceInclude : public ID3DInclude
+	{
+	public:
+		explicit SourceInclude(const ShaderSource& source) noexcept
+			:
+			source(source)
+		{
+			parents[source.main.text.data()] = &source.main;
+		}
+		HRESULT __stdcall Open(D3D_INCLUDE_TYPE, LPCSTR pFileName, LPCVOID pParentData, LPCVOID* ppData, UINT* pBytes) override
+		{
+			const auto it = parents.find(pParentData);
+			const std::string& parentPath = it != parents.end() ? it->second->path : source.main.path;
+			const ShaderSource::File* pFile = source.FindInclude(parentPath, pFileName);
+			if (pFile == nullptr)
+			{
+				return E_FAIL;
+			}
+			// nested includes come back with this text as their parent
+			parents[pFile->text.data()] = pFile;
+			*ppData = pFile->text.data();
+			*pBytes = UINT(pFile->text.size());
+			return S_OK;
+		}
+		HRESULT __stdcall Close(LPCVOID) override
+		{
+			return S_OK;
+		}
+	private:
+		const ShaderSource& source;
+		std::unordered_map<LPCVOID, const ShaderSource::File*> parents;
+	};
+}
+
+ShaderCompiler::Result D3DShaderCompiler::Compile(const ShaderDesc& desc, const ShaderSource& source)
+{
+	std::vector<D3D_SHADER_MACRO> macros;
+	macros.reserve(desc.defines.size() + 1u);
+	for (const auto& define : desc.defines)
+	{
+		macros.push_back({ define.first.c_str(), define.second.c_str() });
+	}
+	macros.push_back({ nullptr, nullptr });
+
+	SourceInclude include(source);
+	Microsoft::WRL::ComPtr<ID3DBlob> pCode;
+	Microsoft::WRL::ComPtr<ID3DBlob> pErrors;
+	const HRESULT hr = D3DCompile(
+		source.main.text.data(), source.main.text.size(),
+		source.main.path.c_str(),
+		macros.data(),
+		&include,
+		desc.entryPoint.c_str(),
+		desc.profile.c_str(),
+		desc.flags, 0u,
+		&pCode,
+		&pErrors
+	);
+
+	Result result;
+	if (pErrors)
+	{
+		result.messages.assign(static_cast<const char*>(pErrors->GetBufferPointer()), pErrors->GetBufferSize());
+	}
+	if (SUCCEEDED(hr) && pCode)
+	{
+		result.bytecode.resize(pCode->GetBufferSize());
+		std::memcpy(result.bytecode.data(), pCode->GetBufferPointer(), pCode->GetBufferSize());
+		result.succeeded = true;
+	}
+	return result;
+}
+
+std::string D3DShaderCompiler::GetVersion() const
+{
+	return "d3dcompiler_" + std::to_string(D3D_COMPILER_VERSION);
+}
@@ -0,0 +1,401 @@
+#include "Render/Shader/ShaderCache.h"
+#include "Core/ContentHash.h"
+#include "Job/JobSystem.h"
+#include "Profile/Profiler.h"
+#include "Time/OTimer.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+#define SHADER_EXCEPT(note) ShaderCache::Exception(__LINE__, __FILE__, (note))
+
+namespace
+{
+	// bumped whenever the key or entry layout changes
+	constexpr uint32_t formatVersion = 1u;
+
+	struct EntryHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint64_t size;
+		// hash of the bytecode, catches truncated or damaged files
+		uint64_t checksum;
+	};
+
+	uint64_t Checksum(const std::vector<std::byte>& bytecode) noexcept
+	{
+		ContentHash hash;
+		hash.Add(bytecode.data(), bytecode.size());
+		uint64_t hi, lo;
+		hash.Finish(hi, lo);
+		return lo;
+	}
+
+	// names of the #include lines in text, in order
+	std::vector<std::string> ScanIncludes(const std::string& text)
+	{
+		std::vector<std::string> names;
+		size_t pos = 0u;
+		while (pos < text.size())
+		{
+			size_t end = text.find('\n', pos);
+			if (end == std::string::npos)
+			{
+				end = text.size();
+			}
+			size_t i = text.find_first_not_of(" \t", pos);
+			if (i < end && text[i] == '#')
+			{
+				i = text.find_first_not_of(" \t", i + 1u);
+				if (i < end && text.compare(i, 7u, "include") == 0)
+				{
+					i = text.find_first_not_of(" \t", i + 7u);
+					if (i < end && (text[i] == '"' || text[i] == '<'))
+					{
+						const char close = text[i] == '"' ? '"' : '>';
+						const size_t last = text.find(close, i + 1u);
+						if (last < end)
+						{
+							names.push_back(text.substr(i + 1u, last - i - 1u));
+						}
+					}
+				}
+			}
+			pos = end + 1u;
+		}
+		return names;
+	}
+}
+
+ShaderCache::ShaderCache(ShaderCompiler& compiler, Config config)
+	:
+	compiler(compiler),
+	config(std::move(config)),
+	compilerVersion(compiler.GetVersion())
+{
+	if (!this->config.loader)
+	{
+		this->config.loader = &ShaderCache::ReadFile;
+	}
+}
+
+std::vector<ShaderCache::Bytecode> ShaderCache::Load(const std::vector<ShaderDesc>& descs)
+{
+	O_PROFILE_FUNCTION();
+	OTimer timer;
+	struct Context
+	{
+		ShaderCache& cache;
+		const std::vector<ShaderDesc>& descs;
+		std::vector<Bytecode>& results;
+	};
+	std::vector<Bytecode> results(descs.size());
+	Context context = { *this, descs, results };
+	const auto resolve = [](void* c, size_t begin, size_t end)
+	{
+		Context& context = *static_cast<Context*>(c);
+		for (size_t i = begin; i < end; i++)
+		{
+			context.results[i] = context.cache.Resolve(context.descs[i]);
+		}
+	};
+	if (config.pJobs)
+	{
+		config.pJobs->ParallelFor(descs.size(), resolve, &context);
+	}
+	else
+	{
+		resolve(&context, 0u, descs.size());
+	}
+	std::lock_guard<std::mutex> lock(mtx);
+	stats.totalSeconds += timer.Mark();
+	return results;
+}
+
+ShaderCache::Bytecode ShaderCache::Get(const ShaderDesc& desc)
+{
+	OTimer timer;
+	Bytecode bytecode = Resolve(desc);
+	std::lock_guard<std::mutex> lock(mtx);
+	stats.totalSeconds += timer.Mark();
+	return bytecode;
+}
+
+ShaderCache::Key ShaderCache::ComputeKey(const ShaderDesc& desc) const
+{
+	return ComputeKey(desc, ReadSource(desc.path));
+}
+
+ShaderCache::Stats ShaderCache::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return stats;
+}
+
+void ShaderCache::ResetStats()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	stats = {};
+}
+
+void ShaderCache::ClearMemory()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	entries.clear();
+}
+
+bool ShaderCache::ReadFile(const std::string& path, std::string& contents)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	std::ostringstream oss;
+	oss << file.rdbuf();
+	contents = oss.str();
+	return true;
+}
+
+ShaderCache::Bytecode ShaderCache::Resolve(const ShaderDesc& desc)
+{
+	OTimer timer;
+	const ShaderSource source = ReadSource(desc.path);
+	const Key key = ComputeKey(desc, source);
+	const float hashSeconds = timer.Mark();
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		stats.requests++;
+		stats.hashSeconds += hashSeconds;
+		const auto it = entries.find(key);
+		if (it != entries.end())
+		{
+			stats.memoryHits++;
+			return it->second;
+		}
+	}
+
+	Bytecode bytecode = ReadEntry(key);
+	const float readSeconds = timer.Mark();
+	if (bytecode)
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		stats.diskHits++;
+		stats.diskSeconds += readSeconds;
+		return entries.emplace(key, std::move(bytecode)).first->second;
+	}
+
+	ShaderCompiler::Result result = compiler.Compile(desc, source);
+	const float compileSeconds = timer.Mark();
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		stats.diskSeconds += readSeconds;
+		stats.compiles++;
+		stats.compileSeconds += compileSeconds;
+		if (!result.succeeded)
+		{
+			stats.failures++;
+		}
+	}
+	if (!result.succeeded)
+	{
+		throw SHADER_EXCEPT("Compiling " + desc.path + " (" + desc.entryPoint + ", " + desc.profile + ") failed:\n" + result.messages);
+	}
+	WriteEntry(key, result.bytecode);
+	const float writeSeconds = timer.Mark();
+	bytecode = std::make_shared<const std::vector<std::byte>>(std::move(result.bytecode));
+	std::lock_guard<std::mutex> lock(mtx);
+	stats.diskSeconds += writeSeconds;
+	// another thread may have built the same key meanwhile, either is fine
+	return entries.emplace(key, std::move(bytecode)).first->second;
+}
+
+ShaderSource ShaderCache::ReadSource(const std::string& path) const
+{
+	ShaderSource source;
+	source.main.path = std::filesystem::path(path).lexically_normal().generic_string();
+	if (!config.loader(path, source.main.text))
+	{
+		throw SHADER_EXCEPT("Shader source " + path + " not found");
+	}
+	// breadth first, each file once; the order goes into the key so it is
+	// fixed by the text alone
+	std::unordered_set<std::string> seen = { source.main.path };
+	for (size_t i = 0; i <= source.includes.size(); i++)
+	{
+		const ShaderSource::File& file = i == 0u ? source.main : source.includes[i - 1u];
+		const std::string parentPath = file.path;
+		for (const std::string& name : ScanIncludes(file.text))
+		{
+			ShaderSource::File include;
+			include.path = ShaderSource::ResolveInclude(parentPath, name);
+			// a missing file is left to the compiler, it may sit in an inactive #if
+			if (seen.insert(include.path).second && config.loader(include.path, include.text))
+			{
+				source.includes.push_back(std::move(include));
+			}
+		}
+	}
+	return source;
+}
+
+ShaderCache::Key ShaderCache::ComputeKey(const ShaderDesc& desc, const ShaderSource& source) const
+{
+	ContentHash hash;
+	hash.Add(uint64_t(formatVersion));
+	hash.Add(compilerVersion);
+	hash.Add(desc.profile);
+	hash.Add(desc.entryPoint);
+	hash.Add(uint64_t(desc.defines.size()));
+	for (const auto& define : desc.defines)
+	{
+		hash.Add(define.first);
+		hash.Add(define.second);
+	}
+	hash.Add(uint64_t(desc.flags));
+	// the path ends up in debug info and messages
+	hash.Add(source.main.path);
+	hash.Add(source.main.text);
+	hash.Add(uint64_t(source.includes.size()));
+	for (const ShaderSource::File& file : source.includes)
+	{
+		hash.Add(file.path);
+		hash.Add(file.text);
+	}
+	Key key;
+	hash.Finish(key.hi, key.lo);
+	return key;
+}
+
+ShaderCache::Bytecode ShaderCache::ReadEntry(const Key& key) const
+{
+	if (config.directory.empty())
+	{
+		return nullptr;
+	}
+	const std::filesystem::path path = std::filesystem::path(config.directory) / (key.ToString() + ".cso");
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		return nullptr;
+	}
+	EntryHeader header = {};
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		std::memcmp(header.magic, "OSHC", 4u) != 0 || header.version != formatVersion)
+	{
+		return nullptr;
+	}
+	// the size is read from disk, so it has to match the file before it
+	// decides an allocation; anything else is a damaged entry
+	std::error_code error;
+	const uintmax_t fileSize = std::filesystem::file_size(path, error);
+	if (error || fileSize < sizeof(header) || header.size != fileSize - sizeof(header))
+	{
+		return nullptr;
+	}
+	std::vector<std::byte> bytecode(size_t(header.size));
+	if (!file.read(reinterpret_cast<char*>(bytecode.data()), std::streamsize(bytecode.size())) ||
+		Checksum(bytecode) != header.checksum)
+	{
+		// damaged, the compile that follows writes a good one over it
+		return nullptr;
+	}
+	return std::make_shared<const std::vector<std::byte>>(std::move(bytecode));
+}
+
+void ShaderCache::WriteEntry(const Key& key, const std::vector<std::byte>& bytecode) const
+{
+	if (config.directory.empty())
+	{
+		return;
+	}
+	// the cache is best effort, a failed write only means compiling again
+	static std::atomic<uint64_t> tempCounter = 0u;
+	std::error_code error;
+	const std::filesystem::path directory(config.directory);
+	std::filesystem::create_directories(directory, error);
+	const std::string name = key.ToString();
+	const std::filesystem::path path = directory / (name + ".cso");
+	// written aside and renamed, so a reader never sees a half written entry
+	const std::filesystem::path temp = directory / (name + ".tmp" + std::to_string(tempCounter.fetch_add(1u)));
+	{
+		std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			return;
+		}
+		EntryHeader header = {};
+		std::memcpy(header.magic, "OSHC", 4u);
+		header.version = formatVersion;
+		header.size = bytecode.size();
+		header.checksum = Checksum(bytecode);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(bytecode.data()), std::streamsize(bytecode.size()));
+		if (!file)
+		{
+			file.close();
+			std::filesystem::remove(temp, error);
+			return;
+		}
+	}
+	std::filesystem::rename(temp, path, error);
+	if (error)
+	{
+		std::filesystem::remove(temp, error);
+	}
+}
+
+bool ShaderCache::Key::operator==(const Key& other) const noexcept
+{
+	return hi == other.hi && lo == other.lo;
+}
+
+std::string ShaderCache::Key::ToString() const
+{
+	char text[33];
+	std::snprintf(text, sizeof(text), "%016llx%016llx", static_cast<unsigned long long>(hi), static_cast<unsigned long long>(lo));
+	return text;
+}
+
+size_t ShaderCache::KeyHash::operator()(const Key& key) const noexcept
+{
+	return size_t(key.lo);
+}
+
+double ShaderCache::Stats::HitRate() const noexcept
+{
+	return requests > 0u ? double(memoryHits + diskHits) / double(requests) : 0.0;
+}
+
+// Shader cache exception
+ShaderCache::Exception::Exception(int line, const char* file, std::string note) noexcept
+	:
+	OException(line, file),
+	note(std::move(note))
+{
+}
+
+const char* ShaderCache::Exception::what() const noexcept
+{
+	std::ostringstream oss;
+	oss << GetType() << std::endl
+		<< "[Note] " << GetNote() << std::endl
+		<< GetOriginString();
+	whatBuffer = oss.str();
+	return whatBuffer.c_str();
+}
+
+const char* ShaderCache::Exception::GetType() const noexcept
+{
+	return "O Shader Cache Exception";
+}
+
+const std::string& ShaderCache::Exception::GetNote() const noexcept
+{
+	return note;
+}
@@ -0,0 +1,30 @@
+#include "Render/Shader/ShaderCompiler.h"
+#include <filesystem>
+
+const ShaderSource::File* ShaderSource::FindInclude(const std::string& parentPath, const std::string& name) const noexcept
+{
+	std::string path;
+	try
+	{
+		path = ResolveInclude(parentPath, name);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+	for (const File& file : includes)
+	{
+		if (file.path == path)
+		{
+			return &file;
+		}
+	}
+	return nullptr;
+}
+
+std::string ShaderSource::ResolveInclude(const std::string& parentPath, const std::string& name)
+{
+	// like the compiler's default handler, relative to the including file
+	const std::filesystem::path path = std::filesystem::path(parentPath).parent_path() / name;
+	return path.lexically_normal().generic_string();
+}
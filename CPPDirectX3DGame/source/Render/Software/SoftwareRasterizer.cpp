@@ -0,0 +1,390 @@
+#include "Render/Software/SoftwareRasterizer.h"
+#include "Job/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define O_RASTER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	uint32_t PackColor(float r, float g, float b, float a) noexcept
+	{
+		const auto toByte = [](float c)
+		{
+			return uint32_t(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+		};
+		return (toByte(a) << 24) | (toByte(r) << 16) | (toByte(g) << 8) | toByte(b);
+	}
+
+	int64_t Orient2D(int32_t ax, int32_t ay, int32_t bx, int32_t by, int64_t px, int64_t py) noexcept
+	{
+		return int64_t(bx - ax) * (py - ay) - int64_t(by - ay) * (px - ax);
+	}
+
+	// D3D top-left rule for a clockwise (screen space, y down) triangle
+	bool IsTopLeft(int32_t ax, int32_t ay, int32_t bx, int32_t by) noexcept
+	{
+		return (ay == by && bx > ax) || by < ay;
+	}
+
+	// shared by the scalar and SIMD paths so both produce identical bytes;
+	// rounded, the weights of large triangles are inexact and a flat 255
+	// would often truncate to 254
+	uint32_t ShadeChannel(float l0, float l1, float l2, float c0, float c1, float c2, float invArea) noexcept
+	{
+		const float c = std::clamp((l0 * c0 + l1 * c1 + l2 * c2) * invArea, 0.0f, 255.0f);
+		return uint32_t(c + 0.5f);
+	}
+}
+
+SoftwareRasterizer::SoftwareRasterizer(unsigned int width, unsigned int height, JobSystem* pJobs)
+	:
+	width(width),
+	height(height),
+	// rows padded to whole SIMD groups so 4-wide stores never touch a neighbouring tile
+	pitch((width + 3u) & ~3u),
+	tilesX((width + tileSize - 1u) / tileSize),
+	tilesY((height + tileSize - 1u) / tileSize),
+	backBuffer(size_t(pitch) * height, 0xFF000000u),
+	frontBuffer(size_t(pitch) * height, 0xFF000000u),
+	bins(size_t(tilesX) * tilesY),
+	pJobs(pJobs)
+{
+}
+
+void SoftwareRasterizer::SetJobs(JobSystem* pJobs) noexcept
+{
+	this->pJobs = pJobs;
+}
+
+void SoftwareRasterizer::ClearBuffer(float red, float green, float blue) noexcept
+{
+	// a clear makes everything recorded before it invisible, so drop it
+	for (auto& bin : bins)
+	{
+		bin.clear();
+	}
+	triangles.clear();
+	frameStats = {};
+	clearColor = PackColor(red, green, blue, 1.0f);
+	clearPending = true;
+}
+
+void SoftwareRasterizer::DrawIndexed(const Vertex* pVertices, size_t vertexCount, const unsigned short* pIndices, size_t indexCount)
+{
+	const float halfWidth = float(width) * 0.5f * subpixelScale;
+	const float halfHeight = float(height) * 0.5f * subpixelScale;
+	const float guardBand = float(1 << 24);
+	for (size_t i = 0; i + 2 < indexCount; i += 3)
+	{
+		frameStats.triangles++;
+		Triangle tri;
+		bool valid = true;
+		for (int v = 0; v < 3; v++)
+		{
+			const size_t index = pIndices[i + v];
+			if (index >= vertexCount)
+			{
+				valid = false;
+				break;
+			}
+			const Vertex& vtx = pVertices[index];
+			// NDC -> 28.4 fixed point screen space, y pointing down, clamped to the guard band
+			tri.x[v] = int32_t(std::lround(std::clamp((vtx.pos.x + 1.0f) * halfWidth, -guardBand, guardBand)));
+			tri.y[v] = int32_t(std::lround(std::clamp((1.0f - vtx.pos.y) * halfHeight, -guardBand, guardBand)));
+			tri.color[v][0] = vtx.color.r;
+			tri.color[v][1] = vtx.color.g;
+			tri.color[v][2] = vtx.color.b;
+			tri.color[v][3] = vtx.color.a;
+		}
+		if (!valid)
+		{
+			continue;
+		}
+		int64_t area = Orient2D(tri.x[0], tri.y[0], tri.x[1], tri.y[1], tri.x[2], tri.y[2]);
+		if (area == 0)
+		{
+			continue;
+		}
+		// no culling state yet, so accept both windings by making everything clockwise
+		if (area < 0)
+		{
+			std::swap(tri.x[1], tri.x[2]);
+			std::swap(tri.y[1], tri.y[2]);
+			std::swap(tri.color[1], tri.color[2]);
+			area = -area;
+		}
+		tri.invArea = 1.0f / float(area);
+		for (int e = 0; e < 3; e++)
+		{
+			const int a = (e + 1) % 3;
+			const int b = (e + 2) % 3;
+			tri.bias[e] = IsTopLeft(tri.x[a], tri.y[a], tri.x[b], tri.y[b]) ? 0 : -1;
+		}
+		// conservative pixel bounds, the edge tests decide the exact coverage
+		const int32_t minX = std::min({ tri.x[0], tri.x[1], tri.x[2] });
+		const int32_t minY = std::min({ tri.y[0], tri.y[1], tri.y[2] });
+		const int32_t maxX = std::max({ tri.x[0], tri.x[1], tri.x[2] });
+		const int32_t maxY = std::max({ tri.y[0], tri.y[1], tri.y[2] });
+		tri.wide = maxX - minX <= wideLimit * subpixelScale && maxY - minY <= wideLimit * subpixelScale;
+		tri.minX = std::max(int(minX >> subpixelBits), 0);
+		tri.minY = std::max(int(minY >> subpixelBits), 0);
+		tri.maxX = std::min(int(maxX >> subpixelBits) + 1, int(width));
+		tri.maxY = std::min(int(maxY >> subpixelBits) + 1, int(height));
+		if (tri.minX >= tri.maxX || tri.minY >= tri.maxY)
+		{
+			continue;
+		}
+
+		const uint32_t triIndex = uint32_t(triangles.size());
+		triangles.push_back(tri);
+		const unsigned int tx0 = unsigned(tri.minX) / tileSize;
+		const unsigned int ty0 = unsigned(tri.minY) / tileSize;
+		const unsigned int tx1 = unsigned(tri.maxX - 1) / tileSize;
+		const unsigned int ty1 = unsigned(tri.maxY - 1) / tileSize;
+		for (unsigned int ty = ty0; ty <= ty1; ty++)
+		{
+			for (unsigned int tx = tx0; tx <= tx1; tx++)
+			{
+				bins[size_t(ty) * tilesX + tx].push_back(triIndex);
+				frameStats.binnedTriangles++;
+			}
+		}
+	}
+}
+
+void SoftwareRasterizer::EndFrame()
+{
+	const unsigned int nTiles = tilesX * tilesY;
+	if (pJobs)
+	{
+		// in pipelined mode this is the render thread, which only joins the
+		// system for as long as the frame takes
+		JobSystem::Guest guest(*pJobs);
+		pJobs->ParallelFor(nTiles, [this](size_t begin, size_t end)
+		{
+			RasterizeTiles(begin, end);
+		});
+	}
+	else
+	{
+		RasterizeTiles(0u, nTiles);
+	}
+
+	std::swap(backBuffer, frontBuffer);
+	for (auto& bin : bins)
+	{
+		bin.clear();
+	}
+	triangles.clear();
+	clearPending = false;
+	lastStats = frameStats;
+	frameStats = {};
+}
+
+unsigned int SoftwareRasterizer::GetWidth() const noexcept
+{
+	return width;
+}
+
+unsigned int SoftwareRasterizer::GetHeight() const noexcept
+{
+	return height;
+}
+
+const uint32_t* SoftwareRasterizer::GetFrontBuffer() const noexcept
+{
+	return frontBuffer.data();
+}
+
+unsigned int SoftwareRasterizer::GetPitch() const noexcept
+{
+	return pitch;
+}
+
+SoftwareRasterizer::Stats SoftwareRasterizer::GetStats() const noexcept
+{
+	return lastStats;
+}
+
+void SoftwareRasterizer::RasterizeTiles(size_t begin, size_t end) noexcept
+{
+	for (size_t tile = begin; tile < end; tile++)
+	{
+		RasterizeTile(unsigned(tile));
+	}
+}
+
+void SoftwareRasterizer::RasterizeTile(unsigned int tileIndex) noexcept
+{
+	const int x0 = int(tileIndex % tilesX) * tileSize;
+	const int y0 = int(tileIndex / tilesX) * tileSize;
+	const int x1 = std::min(x0 + tileSize, int(width));
+	const int y1 = std::min(y0 + tileSize, int(height));
+
+	if (clearPending)
+	{
+		for (int y = y0; y < y1; y++)
+		{
+			uint32_t* pRow = &backBuffer[size_t(y) * pitch];
+			std::fill(pRow + x0, pRow + x1, clearColor);
+		}
+	}
+	for (const uint32_t triIndex : bins[tileIndex])
+	{
+		const Triangle& tri = triangles[triIndex];
+		const int rx0 = std::max(x0, tri.minX);
+		const int ry0 = std::max(y0, tri.minY);
+		const int rx1 = std::min(x1, tri.maxX);
+		const int ry1 = std::min(y1, tri.maxY);
+#ifdef O_RASTER_SSE2
+		if (tri.wide)
+		{
+			RasterizeTriangleWide(tri, rx0, ry0, rx1, ry1);
+			continue;
+		}
+#endif
+		RasterizeTriangle(tri, rx0, ry0, rx1, ry1);
+	}
+}
+
+void SoftwareRasterizer::RasterizeTriangle(const Triangle& tri, int x0, int y0, int x1, int y1) noexcept
+{
+	int64_t stepX[3];
+	int64_t stepY[3];
+	int64_t row[3];
+	const int64_t px = int64_t(x0) * subpixelScale + subpixelScale / 2;
+	const int64_t py = int64_t(y0) * subpixelScale + subpixelScale / 2;
+	for (int e = 0; e < 3; e++)
+	{
+		const int a = (e + 1) % 3;
+		const int b = (e + 2) % 3;
+		stepX[e] = -int64_t(tri.y[b] - tri.y[a]) * subpixelScale;
+		stepY[e] = int64_t(tri.x[b] - tri.x[a]) * subpixelScale;
+		row[e] = Orient2D(tri.x[a], tri.y[a], tri.x[b], tri.y[b], px, py) + tri.bias[e];
+	}
+	for (int y = y0; y < y1; y++)
+	{
+		uint32_t* pRow = &backBuffer[size_t(y) * pitch];
+		int64_t w0 = row[0];
+		int64_t w1 = row[1];
+		int64_t w2 = row[2];
+		for (int x = x0; x < x1; x++)
+		{
+			if ((w0 | w1 | w2) >= 0)
+			{
+				// undo the fill rule bias before using the weights
+				const float l0 = float(w0 - tri.bias[0]);
+				const float l1 = float(w1 - tri.bias[1]);
+				const float l2 = float(w2 - tri.bias[2]);
+				const auto& c = tri.color;
+				pRow[x] =
+					(ShadeChannel(l0, l1, l2, c[0][3], c[1][3], c[2][3], tri.invArea) << 24) |
+					(ShadeChannel(l0, l1, l2, c[0][0], c[1][0], c[2][0], tri.invArea) << 16) |
+					(ShadeChannel(l0, l1, l2, c[0][1], c[1][1], c[2][1], tri.invArea) << 8) |
+					ShadeChannel(l0, l1, l2, c[0][2], c[1][2], c[2][2], tri.invArea);
+			}
+			w0 += stepX[0];
+			w1 += stepX[1];
+			w2 += stepX[2];
+		}
+		row[0] += stepY[0];
+		row[1] += stepY[1];
+		row[2] += stepY[2];
+	}
+}
+
+#ifdef O_RASTER_SSE2
+void SoftwareRasterizer::RasterizeTriangleWide(const Triangle& tri, int x0, int y0, int x1, int y1) noexcept
+{
+	// align to the 4-pixel groups; pitch and tile size are multiples of 4
+	// so the extra lanes stay inside this tile's rows and are masked off
+	const int alignedX0 = x0 & ~3;
+	int32_t stepX[3];
+	int32_t stepY[3];
+	int32_t row[3];
+	const int64_t px = int64_t(alignedX0) * subpixelScale + subpixelScale / 2;
+	const int64_t py = int64_t(y0) * subpixelScale + subpixelScale / 2;
+	for (int e = 0; e < 3; e++)
+	{
+		const int a = (e + 1) % 3;
+		const int b = (e + 2) % 3;
+		stepX[e] = -(tri.y[b] - tri.y[a]) * subpixelScale;
+		stepY[e] = (tri.x[b] - tri.x[a]) * subpixelScale;
+		// small bounding box keeps the edge values within 32 bits
+		row[e] = int32_t(Orient2D(tri.x[a], tri.y[a], tri.x[b], tri.y[b], px, py));
+	}
+	__m128i laneStep[3];
+	for (int e = 0; e < 3; e++)
+	{
+		laneStep[e] = _mm_setr_epi32(0, stepX[e], stepX[e] * 2, stepX[e] * 3);
+	}
+	__m128 color[3][4];
+	for (int v = 0; v < 3; v++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			color[v][c] = _mm_set1_ps(tri.color[v][c]);
+		}
+	}
+	const __m128 invArea = _mm_set1_ps(tri.invArea);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 maxChannel = _mm_set1_ps(255.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128i laneIndex = _mm_setr_epi32(0, 1, 2, 3);
+	const auto shade = [&](__m128 l0, __m128 l1, __m128 l2, int c)
+	{
+		__m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, color[0][c]), _mm_mul_ps(l1, color[1][c])), _mm_mul_ps(l2, color[2][c]));
+		v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, invArea), zero), maxChannel);
+		return _mm_cvttps_epi32(_mm_add_ps(v, half));
+	};
+
+	for (int y = y0; y < y1; y++)
+	{
+		uint32_t* pRow = &backBuffer[size_t(y) * pitch];
+		__m128i w0 = _mm_add_epi32(_mm_set1_epi32(row[0]), laneStep[0]);
+		__m128i w1 = _mm_add_epi32(_mm_set1_epi32(row[1]), laneStep[1]);
+		__m128i w2 = _mm_add_epi32(_mm_set1_epi32(row[2]), laneStep[2]);
+		for (int x = alignedX0; x < x1; x += 4)
+		{
+			// inside when every biased edge value is non-negative
+			const __m128i outside = _mm_srai_epi32(_mm_or_si128(_mm_or_si128(
+				_mm_add_epi32(w0, _mm_set1_epi32(tri.bias[0])),
+				_mm_add_epi32(w1, _mm_set1_epi32(tri.bias[1]))),
+				_mm_add_epi32(w2, _mm_set1_epi32(tri.bias[2]))), 31);
+			// restrict to [x0, x1) of this tile
+			const __m128i lanes = _mm_add_epi32(_mm_set1_epi32(x), laneIndex);
+			const __m128i inRange = _mm_and_si128(
+				_mm_cmpgt_epi32(lanes, _mm_set1_epi32(x0 - 1)),
+				_mm_cmplt_epi32(lanes, _mm_set1_epi32(x1)));
+			const __m128i mask = _mm_andnot_si128(outside, inRange);
+			if (_mm_movemask_epi8(mask) != 0)
+			{
+				const __m128 l0 = _mm_cvtepi32_ps(w0);
+				const __m128 l1 = _mm_cvtepi32_ps(w1);
+				const __m128 l2 = _mm_cvtepi32_ps(w2);
+				const __m128i pixels = _mm_or_si128(
+					_mm_or_si128(_mm_slli_epi32(shade(l0, l1, l2, 3), 24), _mm_slli_epi32(shade(l0, l1, l2, 0), 16)),
+					_mm_or_si128(_mm_slli_epi32(shade(l0, l1, l2, 1), 8), shade(l0, l1, l2, 2)));
+				__m128i* pDst = reinterpret_cast<__m128i*>(pRow + x);
+				const __m128i old = _mm_loadu_si128(pDst);
+				_mm_storeu_si128(pDst, _mm_or_si128(_mm_and_si128(mask, pixels), _mm_andnot_si128(mask, old)));
+			}
+			w0 = _mm_add_epi32(w0, _mm_set1_epi32(stepX[0] * 4));
+			w1 = _mm_add_epi32(w1, _mm_set1_epi32(stepX[1] * 4));
+			w2 = _mm_add_epi32(w2, _mm_set1_epi32(stepX[2] * 4));
+		}
+		row[0] += stepY[0];
+		row[1] += stepY[1];
+		row[2] += stepY[2];
+	}
+}
+#else
+void SoftwareRasterizer::RasterizeTriangleWide(const Triangle& tri, int x0, int y0, int x1, int y1) noexcept
+{
+	RasterizeTriangle(tri, x0, y0, x1, y1);
+}
+#endif
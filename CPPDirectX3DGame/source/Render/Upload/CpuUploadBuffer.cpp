@@ -0,0 +1,43 @@
+#include "Render/Upload/CpuUploadBuffer.h"
+#include <cassert>
+
+CpuUploadBuffer::CpuUploadBuffer(size_t size)
+	:
+	size(size),
+	pData(std::make_unique<std::byte[]>(size))
+{}
+
+std::byte* CpuUploadBuffer::Map(MapMode mode)
+{
+	assert(!mapped && "buffer is already mapped");
+	mapped = true;
+	if (mode == MapMode::Discard)
+	{
+		stats.discards++;
+	}
+	else
+	{
+		stats.noOverwrites++;
+	}
+	return pData.get();
+}
+
+void CpuUploadBuffer::Unmap() noexcept
+{
+	mapped = false;
+}
+
+size_t CpuUploadBuffer::GetSize() const noexcept
+{
+	return size;
+}
+
+bool CpuUploadBuffer::IsMapped() const noexcept
+{
+	return mapped;
+}
+
+CpuUploadBuffer::Stats CpuUploadBuffer::GetStats() const noexcept
+{
+	return stats;
+}
@@ -0,0 +1,70 @@
+#include "Render/Upload/D3D11FrameFence.h"
+#include "Render/Graphics.h"
+#include "Render/GraphicsThrowMacros.h"
+#include <thread>
+
+D3D11FrameFence::D3D11FrameFence(ID3D11Device* pDevice, ID3D11DeviceContext* pContext)
+	:
+	pContext(pContext)
+{
+	HRESULT hr;
+
+	D3D11_QUERY_DESC qd = {};
+	qd.Query = D3D11_QUERY_EVENT;
+	qd.MiscFlags = 0u;
+	for (auto& pQuery : queries)
+	{
+		GFX_THROW_NOINFO(pDevice->CreateQuery(&qd, &pQuery));
+	}
+}
+
+void D3D11FrameFence::Signal(uint64_t value)
+{
+	if (count == maxPending)
+	{
+		Wait(values[first]);
+	}
+	const size_t slot = (first + count) % maxPending;
+	values[slot] = value;
+	pContext->End(queries[slot].Get());
+	count++;
+}
+
+uint64_t D3D11FrameFence::GetCompletedValue() noexcept
+{
+	while (Poll(false))
+	{
+	}
+	return completed;
+}
+
+void D3D11FrameFence::Wait(uint64_t value)
+{
+	while (completed < value && count > 0u)
+	{
+		if (!Poll(true))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool D3D11FrameFence::Poll(bool flush) noexcept
+{
+	if (count == 0u)
+	{
+		return false;
+	}
+	BOOL done = FALSE;
+	const UINT flags = flush ? 0u : UINT(D3D11_ASYNC_GETDATA_DONOTFLUSH);
+	const HRESULT hr = pContext->GetData(queries[first].Get(), &done, sizeof(done), flags);
+	// a removed device fails every query, nothing is running on it anymore
+	if (hr == S_FALSE || (hr == S_OK && !done))
+	{
+		return false;
+	}
+	completed = values[first];
+	first = (first + 1u) % maxPending;
+	count--;
+	return true;
+}
@@ -0,0 +1,62 @@
+#include "Render/Upload/D3D11UploadBuffer.h"
+#include "Render/Graphics.h"
+#include "Render/GraphicsThrowMacros.h"
+
+D3D11UploadBuffer::D3D11UploadBuffer(ID3D11Device* pDevice, ID3D11DeviceContext* pContext, size_t size, UINT bindFlags)
+	:
+	size(size),
+	pContext(pContext)
+{
+	HRESULT hr;
+
+	D3D11_BUFFER_DESC bd = {};
+	bd.BindFlags = bindFlags;
+	bd.Usage = D3D11_USAGE_DYNAMIC;
+	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	bd.MiscFlags = 0u;
+	bd.ByteWidth = UINT(size);
+	bd.StructureByteStride = 0u;
+	GFX_THROW_NOINFO(pDevice->CreateBuffer(&bd, nullptr, &pBuffer));
+}
+
+std::byte* D3D11UploadBuffer::Map(MapMode mode)
+{
+	HRESULT hr;
+
+	D3D11_MAPPED_SUBRESOURCE msr;
+	GFX_THROW_NOINFO(pContext->Map(
+		pBuffer.Get(), 0u,
+		mode == MapMode::Discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0u,
+		&msr
+	));
+	return static_cast<std::byte*>(msr.pData);
+}
+
+void D3D11UploadBuffer::Unmap() noexcept
+{
+	pContext->Unmap(pBuffer.Get(), 0u);
+}
+
+size_t D3D11UploadBuffer::GetSize() const noexcept
+{
+	return size;
+}
+
+ID3D11Buffer* D3D11UploadBuffer::Get() const noexcept
+{
+	return pBuffer.Get();
+}
+
+bool D3D11UploadBuffer::IsNoOverwriteSupported(ID3D11Device* pDevice, UINT bindFlags) noexcept
+{
+	if (!(bindFlags & D3D11_BIND_CONSTANT_BUFFER))
+	{
+		return true;
+	}
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+	if (FAILED(pDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+	{
+		return false;
+	}
+	return options.MapNoOverwriteOnDynamicConstantBuffer == TRUE;
+}
@@ -0,0 +1,47 @@
+#include "Render/Upload/FakeFrameFence.h"
+
+FakeFrameFence::FakeFrameFence(unsigned int latency)
+	:
+	latency(latency)
+{}
+
+void FakeFrameFence::Signal(uint64_t value)
+{
+	signaled = value;
+	pending.push_back(value);
+	while (pending.size() > latency)
+	{
+		completed = pending.front();
+		pending.pop_front();
+	}
+}
+
+uint64_t FakeFrameFence::GetCompletedValue() noexcept
+{
+	return completed;
+}
+
+void FakeFrameFence::Wait(uint64_t value)
+{
+	if (completed >= value)
+	{
+		return;
+	}
+	waits++;
+	// the GPU catches up to the requested frame
+	while (!pending.empty() && pending.front() <= value)
+	{
+		completed = pending.front();
+		pending.pop_front();
+	}
+}
+
+uint64_t FakeFrameFence::GetSignaledValue() const noexcept
+{
+	return signaled;
+}
+
+uint64_t FakeFrameFence::GetWaitCount() const noexcept
+{
+	return waits;
+}
@@ -0,0 +1,138 @@
+#include "Render/Upload/UploadRing.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <sstream>
+
+#define UPLOAD_EXCEPT(note) UploadRing::Exception(__LINE__, __FILE__, (note))
+
+UploadRing::UploadRing(UploadBuffer& buffer, FrameFence& fence, unsigned int maxFramesInFlight)
+	:
+	buffer(buffer),
+	fence(fence),
+	// the frame being ended is never waited on, its fence is not signaled yet
+	maxFramesInFlight(std::max(maxFramesInFlight, 1u)),
+	capacity(buffer.GetSize())
+{}
+
+UploadRing::~UploadRing()
+{
+	Flush();
+}
+
+void UploadRing::Flush() noexcept
+{
+	if (pMapped != nullptr)
+	{
+		buffer.Unmap();
+		pMapped = nullptr;
+	}
+}
+
+void UploadRing::EndFrame(uint64_t fenceValue)
+{
+	O_PROFILE_FUNCTION();
+	Flush();
+	frames.push_back({ fenceValue, size_t(frame.bytesUploaded + frame.bytesPadding) });
+	Retire();
+	// the frame being ended counts, the fence for it is signaled right after
+	while (frames.size() > maxFramesInFlight)
+	{
+		fence.Wait(frames.front().fenceValue);
+		frame.waits++;
+		frames.pop_front();
+	}
+	last = frame;
+	frame = {};
+}
+
+const UploadRing::Stats& UploadRing::GetFrameStats() const noexcept
+{
+	return frame;
+}
+
+const UploadRing::Stats& UploadRing::GetStats() const noexcept
+{
+	return last;
+}
+
+size_t UploadRing::GetBytesInFlight() noexcept
+{
+	Retire();
+	size_t bytes = size_t(frame.bytesUploaded + frame.bytesPadding);
+	for (const Frame& f : frames)
+	{
+		bytes += f.bytes;
+	}
+	return bytes;
+}
+
+size_t UploadRing::GetCapacity() const noexcept
+{
+	return capacity;
+}
+
+UploadRing::Allocation UploadRing::AllocateSlow(size_t size, size_t alignment)
+{
+	if (size > capacity)
+	{
+		throw UPLOAD_EXCEPT("Upload of " + std::to_string(size) + " bytes does not fit the " +
+			std::to_string(capacity) + " byte ring");
+	}
+	const size_t offset = (head + alignment - 1u) & ~(alignment - 1u);
+	if (offset + size > capacity)
+	{
+		// wrap, the driver renames the buffer so nothing in flight is overwritten
+		Flush();
+		pMapped = buffer.Map(UploadBuffer::MapMode::Discard);
+		frame.bytesPadding += capacity - head;
+		frame.maps++;
+		frame.wraps++;
+		generation++;
+		head = 0u;
+	}
+	else if (pMapped == nullptr)
+	{
+		// the very first map has nothing to preserve yet
+		const bool first = head == 0u && generation == 0u;
+		pMapped = buffer.Map(first ? UploadBuffer::MapMode::Discard : UploadBuffer::MapMode::NoOverwrite);
+		frame.maps++;
+	}
+	return Allocate(size, alignment);
+}
+
+void UploadRing::Retire() noexcept
+{
+	const uint64_t completed = fence.GetCompletedValue();
+	while (!frames.empty() && frames.front().fenceValue <= completed)
+	{
+		frames.pop_front();
+	}
+}
+
+// Upload ring exception
+UploadRing::Exception::Exception(int line, const char* file, std::string note) noexcept
+	:
+	OException(line, file),
+	note(std::move(note))
+{
+}
+
+const char* UploadRing::Exception::what() const noexcept
+{
+	std::ostringstream oss;
+	oss << GetType() << std::endl
+		<< "[Note] " << GetNote() << std::endl
+		<< GetOriginString();
+	whatBuffer = oss.str();
+	return whatBuffer.c_str();
+}
+
+const char* UploadRing::Exception::GetType() const noexcept
+{
+	return "O Upload Ring Exception";
+}
+
+const std::string& UploadRing::Exception::GetNote() const noexcept
+{
+	return note;
+}
@@ -0,0 +1,957 @@
+#include "Texture/BlockCompression.h"
+#include "Job/JobSystem.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#define IMAGE_EXCEPT(note) Image::Exception(__LINE__, __FILE__, (note))
+
+namespace
+{
+	constexpr int refineIterations = 2;
+	constexpr uint8_t bc7Weights2[4] = { 0u, 21u, 43u, 64u };
+	constexpr uint8_t bc7Weights4[16] = { 0u, 4u, 9u, 13u, 17u, 21u, 26u, 30u, 34u, 38u, 43u, 47u, 51u, 55u, 60u, 64u };
+
+	// Direction of largest variance of n-channel points, by power iteration
+	// on the covariance. Zero when the points are all equal.
+	template<int n>
+	void PrincipalAxis(const float (*pPoints)[4], const float* mean, float* axis) noexcept
+	{
+		float cov[n][n] = {};
+		for (int i = 0; i < 16; i++)
+		{
+			float d[n];
+			for (int c = 0; c < n; c++)
+			{
+				d[c] = pPoints[i][c] - mean[c];
+			}
+			for (int r = 0; r < n; r++)
+			{
+				for (int c = 0; c < n; c++)
+				{
+					cov[r][c] += d[r] * d[c];
+				}
+			}
+		}
+		for (int c = 0; c < n; c++)
+		{
+			axis[c] = 1.0f;
+		}
+		for (int iteration = 0; iteration < 8; iteration++)
+		{
+			float next[n] = {};
+			float length = 0.0f;
+			for (int r = 0; r < n; r++)
+			{
+				for (int c = 0; c < n; c++)
+				{
+					next[r] += cov[r][c] * axis[c];
+				}
+				length = std::max(length, std::abs(next[r]));
+			}
+			if (length < 1e-6f)
+			{
+				for (int c = 0; c < n; c++)
+				{
+					axis[c] = 0.0f;
+				}
+				return;
+			}
+			for (int c = 0; c < n; c++)
+			{
+				axis[c] = next[c] / length;
+			}
+		}
+	}
+
+	// Endpoints at the extremes of the points projected on the principal axis
+	template<int n>
+	void FitLine(const float (*pPoints)[4], float* e0, float* e1) noexcept
+	{
+		float mean[n] = {};
+		for (int i = 0; i < 16; i++)
+		{
+			for (int c = 0; c < n; c++)
+			{
+				mean[c] += pPoints[i][c] * (1.0f / 16.0f);
+			}
+		}
+		float axis[n];
+		PrincipalAxis<n>(pPoints, mean, axis);
+		float lo = std::numeric_limits<float>::max();
+		float hi = std::numeric_limits<float>::lowest();
+		for (int i = 0; i < 16; i++)
+		{
+			float t = 0.0f;
+			for (int c = 0; c < n; c++)
+			{
+				t += (pPoints[i][c] - mean[c]) * axis[c];
+			}
+			lo = std::min(lo, t);
+			hi = std::max(hi, t);
+		}
+		float lengthSq = 0.0f;
+		for (int c = 0; c < n; c++)
+		{
+			lengthSq += axis[c] * axis[c];
+		}
+		const float scale = lengthSq > 0.0f ? 1.0f / lengthSq : 0.0f;
+		for (int c = 0; c < n; c++)
+		{
+			e0[c] = std::clamp(mean[c] + axis[c] * hi * scale, 0.0f, 255.0f);
+			e1[c] = std::clamp(mean[c] + axis[c] * lo * scale, 0.0f, 255.0f);
+		}
+	}
+
+	// Endpoints minimizing the squared error for fixed indices; weights[i] is
+	// how much of e1 texel i gets. False when the indices do not pin both.
+	template<int n>
+	bool LeastSquares(const float (*pPoints)[4], const float* weights, float* e0, float* e1) noexcept
+	{
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		float ax[n] = {}, bx[n] = {};
+		for (int i = 0; i < 16; i++)
+		{
+			const float b = weights[i];
+			const float a = 1.0f - b;
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+			for (int c = 0; c < n; c++)
+			{
+				ax[c] += a * pPoints[i][c];
+				bx[c] += b * pPoints[i][c];
+			}
+		}
+		const float det = aa * bb - ab * ab;
+		if (std::abs(det) < 1e-6f)
+		{
+			return false;
+		}
+		for (int c = 0; c < n; c++)
+		{
+			e0[c] = std::clamp((bb * ax[c] - ab * bx[c]) / det, 0.0f, 255.0f);
+			e1[c] = std::clamp((aa * bx[c] - ab * ax[c]) / det, 0.0f, 255.0f);
+		}
+		return true;
+	}
+
+	void Load(const uint8_t* pRgba, float (*pPoints)[4]) noexcept
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				pPoints[i][c] = float(pRgba[i * 4 + c]);
+			}
+		}
+	}
+
+	void Store16(std::byte* p, uint16_t value) noexcept
+	{
+		p[0] = std::byte(value & 0xffu);
+		p[1] = std::byte(value >> 8);
+	}
+
+	uint16_t Load16(const std::byte* p) noexcept
+	{
+		return uint16_t(uint16_t(p[0]) | (uint16_t(p[1]) << 8));
+	}
+
+	// BC1 color
+
+	uint16_t To565(const float* c) noexcept
+	{
+		const uint32_t r = uint32_t(c[0] * (31.0f / 255.0f) + 0.5f);
+		const uint32_t g = uint32_t(c[1] * (63.0f / 255.0f) + 0.5f);
+		const uint32_t b = uint32_t(c[2] * (31.0f / 255.0f) + 0.5f);
+		return uint16_t((r << 11) | (g << 5) | b);
+	}
+
+	void From565(uint16_t value, int* c) noexcept
+	{
+		const int r = (value >> 11) & 31;
+		const int g = (value >> 5) & 63;
+		const int b = value & 31;
+		c[0] = (r << 3) | (r >> 2);
+		c[1] = (g << 2) | (g >> 4);
+		c[2] = (b << 3) | (b >> 2);
+	}
+
+	// colors of the four indices; with c0 <= c1 the third is the midpoint and
+	// the fourth transparent black, which BC3 never selects
+	void ColorPalette(uint16_t c0, uint16_t c1, int (*palette)[4]) noexcept
+	{
+		From565(c0, palette[0]);
+		From565(c1, palette[1]);
+		palette[0][3] = palette[1][3] = palette[2][3] = 255;
+		palette[3][3] = c0 > c1 ? 255 : 0;
+		for (int c = 0; c < 3; c++)
+		{
+			if (c0 > c1)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+			else
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+	}
+
+	// how much of c1 each index gives in four color mode
+	constexpr float colorWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+	float ColorIndices(const float (*pPoints)[4], uint16_t c0, uint16_t c1, uint32_t& indices) noexcept
+	{
+		int palette[4][4];
+		ColorPalette(c0, c1, palette);
+		// equal endpoints read as three color mode, stay on the first two
+		const int choices = c0 > c1 ? 4 : 2;
+		indices = 0u;
+		float error = 0.0f;
+		for (int i = 0; i < 16; i++)
+		{
+			float best = std::numeric_limits<float>::max();
+			uint32_t bestIndex = 0u;
+			for (int k = 0; k < choices; k++)
+			{
+				float d = 0.0f;
+				for (int c = 0; c < 3; c++)
+				{
+					const float diff = pPoints[i][c] - float(palette[k][c]);
+					d += diff * diff;
+				}
+				if (d < best)
+				{
+					best = d;
+					bestIndex = uint32_t(k);
+				}
+			}
+			indices |= bestIndex << (i * 2);
+			error += best;
+		}
+		return error;
+	}
+
+	void EncodeColor(const float (*pPoints)[4], std::byte* pBlock) noexcept
+	{
+		float e0[3], e1[3];
+		FitLine<3>(pPoints, e0, e1);
+		uint16_t best0 = 0u, best1 = 0u;
+		uint32_t bestIndices = 0u;
+		float bestError = std::numeric_limits<float>::max();
+		for (int iteration = 0; iteration <= refineIterations; iteration++)
+		{
+			uint16_t c0 = To565(e0);
+			uint16_t c1 = To565(e1);
+			if (c0 < c1)
+			{
+				std::swap(c0, c1);
+			}
+			uint32_t indices;
+			const float error = ColorIndices(pPoints, c0, c1, indices);
+			if (error < bestError)
+			{
+				bestError = error;
+				best0 = c0;
+				best1 = c1;
+				bestIndices = indices;
+			}
+			if (error == 0.0f || c0 == c1 || iteration == refineIterations)
+			{
+				break;
+			}
+			float weights[16];
+			for (int i = 0; i < 16; i++)
+			{
+				weights[i] = colorWeights[(indices >> (i * 2)) & 3u];
+			}
+			if (!LeastSquares<3>(pPoints, weights, e0, e1))
+			{
+				break;
+			}
+		}
+		Store16(pBlock, best0);
+		Store16(pBlock + 2, best1);
+		for (int i = 0; i < 4; i++)
+		{
+			pBlock[4 + i] = std::byte((bestIndices >> (i * 8)) & 0xffu);
+		}
+	}
+
+	void DecodeColor(const std::byte* pBlock, uint8_t* pRgba) noexcept
+	{
+		int palette[4][4];
+		ColorPalette(Load16(pBlock), Load16(pBlock + 2), palette);
+		for (int i = 0; i < 16; i++)
+		{
+			const int index = (int(pBlock[4 + i / 4]) >> ((i % 4) * 2)) & 3;
+			for (int c = 0; c < 4; c++)
+			{
+				pRgba[i * 4 + c] = uint8_t(palette[index][c]);
+			}
+		}
+	}
+
+	// BC4 alpha, the first half of a BC3 block
+
+	void AlphaPalette(int a0, int a1, int* palette) noexcept
+	{
+		palette[0] = a0;
+		palette[1] = a1;
+		if (a0 > a1)
+		{
+			for (int i = 2; i < 8; i++)
+			{
+				palette[i] = ((8 - i) * a0 + (i - 1) * a1 + 3) / 7;
+			}
+		}
+		else
+		{
+			for (int i = 2; i < 6; i++)
+			{
+				palette[i] = ((6 - i) * a0 + (i - 1) * a1 + 2) / 5;
+			}
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+	}
+
+	void EncodeAlpha(const uint8_t* pRgba, std::byte* pBlock) noexcept
+	{
+		int lo = 255, hi = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			lo = std::min(lo, int(pRgba[i * 4 + 3]));
+			hi = std::max(hi, int(pRgba[i * 4 + 3]));
+		}
+		int palette[8];
+		AlphaPalette(hi, lo, palette);
+		uint64_t indices = 0u;
+		for (int i = 0; hi > lo && i < 16; i++)
+		{
+			const int a = pRgba[i * 4 + 3];
+			int best = 0;
+			for (int k = 1; k < 8; k++)
+			{
+				if (std::abs(palette[k] - a) < std::abs(palette[best] - a))
+				{
+					best = k;
+				}
+			}
+			indices |= uint64_t(best) << (i * 3);
+		}
+		pBlock[0] = std::byte(hi);
+		pBlock[1] = std::byte(lo);
+		for (int i = 0; i < 6; i++)
+		{
+			pBlock[2 + i] = std::byte((indices >> (i * 8)) & 0xffu);
+		}
+	}
+
+	void DecodeAlpha(const std::byte* pBlock, uint8_t* pRgba) noexcept
+	{
+		int palette[8];
+		AlphaPalette(int(pBlock[0]), int(pBlock[1]), palette);
+		uint64_t indices = 0u;
+		for (int i = 0; i < 6; i++)
+		{
+			indices |= uint64_t(pBlock[2 + i]) << (i * 8);
+		}
+		for (int i = 0; i < 16; i++)
+		{
+			pRgba[i * 4 + 3] = uint8_t(palette[(indices >> (i * 3)) & 7u]);
+		}
+	}
+
+	// BC7
+
+	// Mode 6: one RGBA line, 7-bit endpoints plus a low bit per endpoint, 16 levels
+	struct Mode6
+	{
+		// 8-bit endpoint values, the low bit shared by the four channels
+		int e0[4];
+		int e1[4];
+		uint8_t indices[16];
+		float error;
+	};
+
+	void Quantize(const float* e, int pBit, int* out) noexcept
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			const int q = std::clamp(int(std::lround((e[c] - float(pBit)) * 0.5f)), 0, 127);
+			out[c] = q * 2 + pBit;
+		}
+	}
+
+	void Mode6Indices(const float (*pPoints)[4], Mode6& block) noexcept
+	{
+		int palette[16][4];
+		for (int k = 0; k < 16; k++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				palette[k][c] = ((64 - bc7Weights4[k]) * block.e0[c] + bc7Weights4[k] * block.e1[c] + 32) >> 6;
+			}
+		}
+		float axis[4];
+		float lengthSq = 0.0f;
+		for (int c = 0; c < 4; c++)
+		{
+			axis[c] = float(block.e1[c] - block.e0[c]);
+			lengthSq += axis[c] * axis[c];
+		}
+		const float scale = lengthSq > 0.0f ? 15.0f / lengthSq : 0.0f;
+		block.error = 0.0f;
+		for (int i = 0; i < 16; i++)
+		{
+			// the projection lands next to the best level, the rounding of the
+			// palette can make a neighbour closer
+			float t = 0.0f;
+			for (int c = 0; c < 4; c++)
+			{
+				t += (pPoints[i][c] - float(block.e0[c])) * axis[c];
+			}
+			const int guess = std::clamp(int(t * scale + 0.5f), 0, 15);
+			float best = std::numeric_limits<float>::max();
+			for (int k = std::max(guess - 1, 0); k <= std::min(guess + 1, 15); k++)
+			{
+				float d = 0.0f;
+				for (int c = 0; c < 4; c++)
+				{
+					const float diff = pPoints[i][c] - float(palette[k][c]);
+					d += diff * diff;
+				}
+				if (d < best)
+				{
+					best = d;
+					block.indices[i] = uint8_t(k);
+				}
+			}
+			block.error += best;
+		}
+	}
+
+	struct BitWriter
+	{
+		void Put(uint32_t value, int bits) noexcept
+		{
+			for (int i = 0; i < bits; i++, position++)
+			{
+				if ((value >> i) & 1u)
+				{
+					p[position / 8] |= std::byte(1u << (position % 8));
+				}
+			}
+		}
+		std::byte* p;
+		int position = 0;
+	};
+
+	struct BitReader
+	{
+		uint32_t Get(int bits) noexcept
+		{
+			uint32_t value = 0u;
+			for (int i = 0; i < bits; i++, position++)
+			{
+				value |= ((uint32_t(p[position / 8]) >> (position % 8)) & 1u) << i;
+			}
+			return value;
+		}
+		const std::byte* p;
+		int position = 0;
+	};
+
+	Mode6 FitMode6(const float (*pPoints)[4]) noexcept
+	{
+		float e0[4], e1[4];
+		FitLine<4>(pPoints, e0, e1);
+		Mode6 best;
+		best.error = std::numeric_limits<float>::max();
+		for (int iteration = 0; iteration <= refineIterations; iteration++)
+		{
+			Mode6 candidate;
+			for (int p0 = 0; p0 < 2; p0++)
+			{
+				for (int p1 = 0; p1 < 2; p1++)
+				{
+					Quantize(e0, p0, candidate.e0);
+					Quantize(e1, p1, candidate.e1);
+					Mode6Indices(pPoints, candidate);
+					if (candidate.error < best.error)
+					{
+						best = candidate;
+					}
+				}
+			}
+			if (best.error == 0.0f || iteration == refineIterations)
+			{
+				break;
+			}
+			float weights[16];
+			for (int i = 0; i < 16; i++)
+			{
+				weights[i] = float(bc7Weights4[best.indices[i]]) / 64.0f;
+			}
+			if (!LeastSquares<4>(pPoints, weights, e0, e1))
+			{
+				break;
+			}
+		}
+		return best;
+	}
+
+	// Mode 5: an RGB line with 7-bit endpoints and an alpha line with 8-bit
+	// ones, each with 4 levels and indices of its own. Alpha that does not
+	// follow the color, like the cut-out edges of sprites and icons, costs
+	// mode 6 a lot more.
+	struct Mode5
+	{
+		// 7-bit colors
+		int c0[3];
+		int c1[3];
+		int a0;
+		int a1;
+		uint8_t colorIndices[16];
+		uint8_t alphaIndices[16];
+		float error;
+	};
+
+	int Expand7(int value) noexcept
+	{
+		return (value << 1) | (value >> 6);
+	}
+
+	int Interpolate2(int e0, int e1, uint32_t index) noexcept
+	{
+		return ((64 - bc7Weights2[index]) * e0 + bc7Weights2[index] * e1 + 32) >> 6;
+	}
+
+	float Mode5ColorIndices(const float (*pPoints)[4], const int* c0, const int* c1, uint8_t* pIndices) noexcept
+	{
+		int palette[4][3];
+		for (uint32_t k = 0; k < 4u; k++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				palette[k][c] = Interpolate2(Expand7(c0[c]), Expand7(c1[c]), k);
+			}
+		}
+		float error = 0.0f;
+		for (int i = 0; i < 16; i++)
+		{
+			float best = std::numeric_limits<float>::max();
+			for (int k = 0; k < 4; k++)
+			{
+				float d = 0.0f;
+				for (int c = 0; c < 3; c++)
+				{
+					const float diff = pPoints[i][c] - float(palette[k][c]);
+					d += diff * diff;
+				}
+				if (d < best)
+				{
+					best = d;
+					pIndices[i] = uint8_t(k);
+				}
+			}
+			error += best;
+		}
+		return error;
+	}
+
+	Mode5 FitMode5(const float (*pPoints)[4]) noexcept
+	{
+		Mode5 best;
+		float e0[3], e1[3];
+		FitLine<3>(pPoints, e0, e1);
+		float colorError = std::numeric_limits<float>::max();
+		for (int iteration = 0; iteration <= refineIterations; iteration++)
+		{
+			int c0[3], c1[3];
+			for (int c = 0; c < 3; c++)
+			{
+				c0[c] = std::clamp(int(std::lround(e0[c] * (127.0f / 255.0f))), 0, 127);
+				c1[c] = std::clamp(int(std::lround(e1[c] * (127.0f / 255.0f))), 0, 127);
+			}
+			uint8_t indices[16];
+			const float error = Mode5ColorIndices(pPoints, c0, c1, indices);
+			if (error < colorError)
+			{
+				colorError = error;
+				std::memcpy(best.c0, c0, sizeof(c0));
+				std::memcpy(best.c1, c1, sizeof(c1));
+				std::memcpy(best.colorIndices, indices, sizeof(indices));
+			}
+			if (error == 0.0f || iteration == refineIterations)
+			{
+				break;
+			}
+			float weights[16];
+			for (int i = 0; i < 16; i++)
+			{
+				weights[i] = float(bc7Weights2[indices[i]]) / 64.0f;
+			}
+			if (!LeastSquares<3>(pPoints, weights, e0, e1))
+			{
+				break;
+			}
+		}
+
+		// alpha spans the block's range
+		float lo = 255.0f, hi = 0.0f;
+		for (int i = 0; i < 16; i++)
+		{
+			lo = std::min(lo, pPoints[i][3]);
+			hi = std::max(hi, pPoints[i][3]);
+		}
+		best.a0 = int(lo);
+		best.a1 = int(hi);
+		float alphaError = 0.0f;
+		for (int i = 0; i < 16; i++)
+		{
+			float bestDiff = std::numeric_limits<float>::max();
+			for (uint32_t k = 0; k < 4u; k++)
+			{
+				const float diff = std::abs(pPoints[i][3] - float(Interpolate2(best.a0, best.a1, k)));
+				if (diff < bestDiff)
+				{
+					bestDiff = diff;
+					best.alphaIndices[i] = uint8_t(k);
+				}
+			}
+			alphaError += bestDiff * bestDiff;
+		}
+		best.error = colorError + alphaError;
+		return best;
+	}
+
+	void WriteMode6(Mode6 block, std::byte* pBlock) noexcept
+	{
+		// the first index is stored without its top bit, flip the line so it is clear
+		if (block.indices[0] >= 8u)
+		{
+			std::swap(block.e0, block.e1);
+			for (uint8_t& index : block.indices)
+			{
+				index = uint8_t(15u - index);
+			}
+		}
+		std::memset(pBlock, 0, 16u);
+		BitWriter writer{ pBlock };
+		writer.Put(1u << 6, 7);
+		for (int c = 0; c < 4; c++)
+		{
+			writer.Put(uint32_t(block.e0[c] >> 1), 7);
+			writer.Put(uint32_t(block.e1[c] >> 1), 7);
+		}
+		writer.Put(uint32_t(block.e0[0] & 1), 1);
+		writer.Put(uint32_t(block.e1[0] & 1), 1);
+		writer.Put(block.indices[0], 3);
+		for (int i = 1; i < 16; i++)
+		{
+			writer.Put(block.indices[i], 4);
+		}
+	}
+
+	void WriteMode5(Mode5 block, std::byte* pBlock) noexcept
+	{
+		// same anchor rule as mode 6, for both index sets
+		if (block.colorIndices[0] >= 2u)
+		{
+			std::swap(block.c0, block.c1);
+			for (uint8_t& index : block.colorIndices)
+			{
+				index = uint8_t(3u - index);
+			}
+		}
+		if (block.alphaIndices[0] >= 2u)
+		{
+			std::swap(block.a0, block.a1);
+			for (uint8_t& index : block.alphaIndices)
+			{
+				index = uint8_t(3u - index);
+			}
+		}
+		std::memset(pBlock, 0, 16u);
+		BitWriter writer{ pBlock };
+		writer.Put(1u << 5, 6);
+		// no channel rotation
+		writer.Put(0u, 2);
+		for (int c = 0; c < 3; c++)
+		{
+			writer.Put(uint32_t(block.c0[c]), 7);
+			writer.Put(uint32_t(block.c1[c]), 7);
+		}
+		writer.Put(uint32_t(block.a0), 8);
+		writer.Put(uint32_t(block.a1), 8);
+		for (int i = 0; i < 16; i++)
+		{
+			writer.Put(block.colorIndices[i], i == 0 ? 1 : 2);
+		}
+		for (int i = 0; i < 16; i++)
+		{
+			writer.Put(block.alphaIndices[i], i == 0 ? 1 : 2);
+		}
+	}
+
+	void EncodeBc7(const float (*pPoints)[4], std::byte* pBlock) noexcept
+	{
+		const Mode6 mode6 = FitMode6(pPoints);
+		if (mode6.error == 0.0f)
+		{
+			WriteMode6(mode6, pBlock);
+			return;
+		}
+		const Mode5 mode5 = FitMode5(pPoints);
+		if (mode5.error < mode6.error)
+		{
+			WriteMode5(mode5, pBlock);
+		}
+		else
+		{
+			WriteMode6(mode6, pBlock);
+		}
+	}
+
+	bool DecodeBc7(const std::byte* pBlock, uint8_t* pRgba) noexcept
+	{
+		const uint32_t first = uint32_t(pBlock[0]);
+		if ((first & 0x7fu) == 0x40u)
+		{
+			BitReader reader{ pBlock, 7 };
+			int e[2][4];
+			for (int c = 0; c < 4; c++)
+			{
+				e[0][c] = int(reader.Get(7)) << 1;
+				e[1][c] = int(reader.Get(7)) << 1;
+			}
+			const int p0 = int(reader.Get(1));
+			const int p1 = int(reader.Get(1));
+			for (int c = 0; c < 4; c++)
+			{
+				e[0][c] |= p0;
+				e[1][c] |= p1;
+			}
+			for (int i = 0; i < 16; i++)
+			{
+				const uint32_t index = reader.Get(i == 0 ? 3 : 4);
+				for (int c = 0; c < 4; c++)
+				{
+					pRgba[i * 4 + c] = uint8_t(((64 - bc7Weights4[index]) * e[0][c] + bc7Weights4[index] * e[1][c] + 32) >> 6);
+				}
+			}
+			return true;
+		}
+		if ((first & 0x3fu) == 0x20u)
+		{
+			BitReader reader{ pBlock, 6 };
+			const uint32_t rotation = reader.Get(2);
+			int e[2][4];
+			for (int c = 0; c < 3; c++)
+			{
+				e[0][c] = Expand7(int(reader.Get(7)));
+				e[1][c] = Expand7(int(reader.Get(7)));
+			}
+			e[0][3] = int(reader.Get(8));
+			e[1][3] = int(reader.Get(8));
+			uint32_t colorIndices[16];
+			for (int i = 0; i < 16; i++)
+			{
+				colorIndices[i] = reader.Get(i == 0 ? 1 : 2);
+			}
+			for (int i = 0; i < 16; i++)
+			{
+				const uint32_t alphaIndex = reader.Get(i == 0 ? 1 : 2);
+				uint8_t* pTexel = pRgba + i * 4;
+				for (int c = 0; c < 3; c++)
+				{
+					pTexel[c] = uint8_t(Interpolate2(e[0][c], e[1][c], colorIndices[i]));
+				}
+				pTexel[3] = uint8_t(Interpolate2(e[0][3], e[1][3], alphaIndex));
+				// rotation 1 to 3 swaps alpha with red, green or blue
+				if (rotation > 0u)
+				{
+					std::swap(pTexel[3], pTexel[rotation - 1u]);
+				}
+			}
+			return true;
+		}
+		std::memset(pRgba, 0, 64u);
+		return false;
+	}
+
+	// the 4x4 texels of a block, repeating the edge past the image
+	void GatherBlock(const Image& image, uint32_t bx, uint32_t by, uint8_t* pRgba) noexcept
+	{
+		for (uint32_t y = 0; y < 4u; y++)
+		{
+			const uint32_t sy = std::min(by * 4u + y, image.GetHeight() - 1u);
+			for (uint32_t x = 0; x < 4u; x++)
+			{
+				const uint32_t sx = std::min(bx * 4u + x, image.GetWidth() - 1u);
+				std::memcpy(pRgba + (y * 4u + x) * 4u, image.GetPixel(sx, sy), 4u);
+			}
+		}
+	}
+
+	struct EncodeJob
+	{
+		Bc::Format format;
+		const Image* pImage;
+		std::byte* pOut;
+		size_t rowBytes;
+	};
+}
+
+size_t Bc::GetEncodedSize(Format format, uint32_t width, uint32_t height) noexcept
+{
+	return size_t((width + 3u) / 4u) * ((height + 3u) / 4u) * GetBlockBytes(format);
+}
+
+const char* Bc::GetFormatName(Format format) noexcept
+{
+	switch (format)
+	{
+	case Format::BC1:
+		return "BC1";
+	case Format::BC3:
+		return "BC3";
+	case Format::BC7:
+		return "BC7";
+	}
+	return "?";
+}
+
+void Bc::EncodeBlock(Format format, const uint8_t* pRgba, std::byte* pBlock) noexcept
+{
+	float points[16][4];
+	Load(pRgba, points);
+	switch (format)
+	{
+	case Format::BC1:
+		EncodeColor(points, pBlock);
+		break;
+	case Format::BC3:
+		EncodeAlpha(pRgba, pBlock);
+		EncodeColor(points, pBlock + 8);
+		break;
+	case Format::BC7:
+		EncodeBc7(points, pBlock);
+		break;
+	}
+}
+
+bool Bc::DecodeBlock(Format format, const std::byte* pBlock, uint8_t* pRgba) noexcept
+{
+	switch (format)
+	{
+	case Format::BC1:
+		DecodeColor(pBlock, pRgba);
+		return true;
+	case Format::BC3:
+		DecodeColor(pBlock + 8, pRgba);
+		DecodeAlpha(pBlock, pRgba);
+		return true;
+	case Format::BC7:
+		return DecodeBc7(pBlock, pRgba);
+	}
+	return false;
+}
+
+std::vector<std::byte> Bc::Encode(Format format, const Image& image, JobSystem* pJobs)
+{
+	O_PROFILE_FUNCTION();
+	std::vector<std::byte> data(GetEncodedSize(format, image.GetWidth(), image.GetHeight()));
+	const uint32_t blocksY = (image.GetHeight() + 3u) / 4u;
+	EncodeJob job{ format, &image, data.data(), size_t((image.GetWidth() + 3u) / 4u) * GetBlockBytes(format) };
+	if (pJobs)
+	{
+		pJobs->ParallelFor(blocksY, [](void* context, size_t begin, size_t end)
+		{
+			const EncodeJob& job = *static_cast<const EncodeJob*>(context);
+			for (size_t by = begin; by < end; by++)
+			{
+				EncodeBlockRow(job.format, *job.pImage, uint32_t(by), job.pOut + by * job.rowBytes);
+			}
+		}, &job);
+	}
+	else
+	{
+		for (uint32_t by = 0; by < blocksY; by++)
+		{
+			EncodeBlockRow(format, image, by, data.data() + by * job.rowBytes);
+		}
+	}
+	return data;
+}
+
+void Bc::EncodeBlockRow(Format format, const Image& image, uint32_t blockRow, std::byte* pOut) noexcept
+{
+	const uint32_t blocksX = (image.GetWidth() + 3u) / 4u;
+	uint8_t texels[64];
+	for (uint32_t bx = 0; bx < blocksX; bx++, pOut += GetBlockBytes(format))
+	{
+		GatherBlock(image, bx, blockRow, texels);
+		EncodeBlock(format, texels, pOut);
+	}
+}
+
+Image Bc::Decode(Format format, const std::byte* pData, size_t size, uint32_t width, uint32_t height)
+{
+	if (size < GetEncodedSize(format, width, height))
+	{
+		throw IMAGE_EXCEPT("Block data is smaller than a " + std::to_string(width) + "x" + std::to_string(height) + " image needs");
+	}
+	Image image(width, height);
+	const uint32_t blocksX = (width + 3u) / 4u;
+	const uint32_t blocksY = (height + 3u) / 4u;
+	uint8_t texels[64];
+	for (uint32_t by = 0; by < blocksY; by++)
+	{
+		for (uint32_t bx = 0; bx < blocksX; bx++)
+		{
+			DecodeBlock(format, pData + (size_t(by) * blocksX + bx) * GetBlockBytes(format), texels);
+			for (uint32_t y = 0; y < 4u && by * 4u + y < height; y++)
+			{
+				for (uint32_t x = 0; x < 4u && bx * 4u + x < width; x++)
+				{
+					std::memcpy(image.GetPixel(bx * 4u + x, by * 4u + y), texels + (y * 4u + x) * 4u, 4u);
+				}
+			}
+		}
+	}
+	return image;
+}
+
+double Bc::ComputePsnr(const Image& a, const Image& b, bool alpha)
+{
+	if (a.GetWidth() != b.GetWidth() || a.GetHeight() != b.GetHeight())
+	{
+		throw IMAGE_EXCEPT("PSNR needs images of the same size");
+	}
+	const size_t texels = size_t(a.GetWidth()) * a.GetHeight();
+	const int channels = alpha ? 4 : 3;
+	double sum = 0.0;
+	for (size_t i = 0; i < texels; i++)
+	{
+		for (int c = 0; c < channels; c++)
+		{
+			const double d = double(a.GetPixels()[i * 4u + c]) - double(b.GetPixels()[i * 4u + c]);
+			sum += d * d;
+		}
+	}
+	if (sum == 0.0 || texels == 0u)
+	{
+		return std::numeric_limits<double>::infinity();
+	}
+	const double mse = sum / double(texels * channels);
+	return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
@@ -0,0 +1,267 @@
+#include "Texture/CookedTexture.h"
+#include "Job/JobSystem.h"
+#include "Profile/Profiler.h"
+#include "Time/OTimer.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#define IMAGE_EXCEPT(note) Image::Exception(__LINE__, __FILE__, (note))
+
+namespace
+{
+	Bc::Format ToBc(CookedTexture::Format format) noexcept
+	{
+		switch (format)
+		{
+		case CookedTexture::Format::BC1:
+			return Bc::Format::BC1;
+		case CookedTexture::Format::BC3:
+			return Bc::Format::BC3;
+		default:
+			return Bc::Format::BC7;
+		}
+	}
+
+	// DXGI_FORMAT values, the sRGB variant is the next one up for each
+	uint32_t GetDxgiFormat(CookedTexture::Format format, bool srgb) noexcept
+	{
+		uint32_t value = 28u;
+		switch (format)
+		{
+		case CookedTexture::Format::BC1:
+			value = 71u;
+			break;
+		case CookedTexture::Format::BC3:
+			value = 77u;
+			break;
+		case CookedTexture::Format::BC7:
+			value = 98u;
+			break;
+		default:
+			break;
+		}
+		return value + (srgb ? 1u : 0u);
+	}
+
+	// DDS_HEADER and DDS_HEADER_DXT10 as the DirectX docs lay them out
+	struct DdsPixelFormat
+	{
+		uint32_t size;
+		uint32_t flags;
+		uint32_t fourCC;
+		uint32_t rgbBitCount;
+		uint32_t masks[4];
+	};
+
+	struct DdsHeader
+	{
+		uint32_t size;
+		uint32_t flags;
+		uint32_t height;
+		uint32_t width;
+		uint32_t pitchOrLinearSize;
+		uint32_t depth;
+		uint32_t mipMapCount;
+		uint32_t reserved1[11];
+		DdsPixelFormat format;
+		uint32_t caps;
+		uint32_t caps2;
+		uint32_t caps3;
+		uint32_t caps4;
+		uint32_t reserved2;
+	};
+	static_assert(sizeof(DdsHeader) == 124u);
+
+	struct DdsHeaderDx10
+	{
+		uint32_t dxgiFormat;
+		uint32_t resourceDimension;
+		uint32_t miscFlag;
+		uint32_t arraySize;
+		uint32_t miscFlags2;
+	};
+
+	struct CookJob
+	{
+		Bc::Format format;
+		const std::vector<Image>* pMips;
+		const std::vector<CookedTexture::Level>* pLevels;
+		std::byte* pData;
+		// level and block row of each job
+		std::vector<std::pair<uint32_t, uint32_t>> rows;
+	};
+}
+
+CookedTexture CookedTexture::Cook(const Image& image, const Options& options)
+{
+	O_PROFILE_FUNCTION();
+	if (image.GetWidth() == 0u || image.GetHeight() == 0u)
+	{
+		throw IMAGE_EXCEPT("Cannot cook an empty image");
+	}
+	CookedTexture texture;
+	texture.srgb = options.mips.srgb;
+	texture.format = options.format;
+	if (texture.format == Format::Auto)
+	{
+		texture.format = image.IsOpaque() ? Format::BC1 : Format::BC3;
+	}
+
+	OTimer timer;
+	const std::vector<Image> mips = MipChain::Build(image, options.mips);
+	texture.stats.mipSeconds = timer.Mark();
+
+	size_t offset = 0u;
+	for (const Image& mip : mips)
+	{
+		const size_t size = texture.format == Format::RGBA8 ?
+			size_t(mip.GetWidth()) * mip.GetHeight() * 4u : Bc::GetEncodedSize(ToBc(texture.format), mip.GetWidth(), mip.GetHeight());
+		texture.levels.push_back({ mip.GetWidth(), mip.GetHeight(), offset, size });
+		offset += size;
+	}
+	texture.data.resize(offset);
+
+	if (texture.format == Format::RGBA8)
+	{
+		for (size_t i = 0; i < mips.size(); i++)
+		{
+			std::memcpy(texture.data.data() + texture.levels[i].offset, mips[i].GetPixels(), texture.levels[i].size);
+		}
+		texture.stats.threads = 1u;
+	}
+	else
+	{
+		CookJob job{ ToBc(texture.format), &mips, &texture.levels, texture.data.data(), {} };
+		for (uint32_t level = 0; level < mips.size(); level++)
+		{
+			for (uint32_t row = 0; row < (mips[level].GetHeight() + 3u) / 4u; row++)
+			{
+				job.rows.emplace_back(level, row);
+			}
+			texture.stats.blocks += texture.levels[level].size / Bc::GetBlockBytes(job.format);
+		}
+		const auto encodeRows = [](void* context, size_t begin, size_t end)
+		{
+			const CookJob& job = *static_cast<const CookJob*>(context);
+			for (size_t index = begin; index < end; index++)
+			{
+				const auto [level, row] = job.rows[index];
+				const Image& mip = (*job.pMips)[level];
+				const size_t rowBytes = size_t((mip.GetWidth() + 3u) / 4u) * Bc::GetBlockBytes(job.format);
+				Bc::EncodeBlockRow(job.format, mip, row, job.pData + (*job.pLevels)[level].offset + row * rowBytes);
+			}
+		};
+		if (options.pJobs)
+		{
+			options.pJobs->ParallelFor(job.rows.size(), encodeRows, &job);
+			texture.stats.threads = options.pJobs->GetThreadCount();
+		}
+		else
+		{
+			encodeRows(&job, 0u, job.rows.size());
+			texture.stats.threads = 1u;
+		}
+	}
+	texture.stats.encodeSeconds = timer.Mark();
+	return texture;
+}
+
+CookedTexture::Format CookedTexture::GetFormat() const noexcept
+{
+	return format;
+}
+
+bool CookedTexture::IsSrgb() const noexcept
+{
+	return srgb;
+}
+
+size_t CookedTexture::GetLevelCount() const noexcept
+{
+	return levels.size();
+}
+
+const CookedTexture::Level& CookedTexture::GetLevel(size_t index) const noexcept
+{
+	return levels[index];
+}
+
+const std::vector<std::byte>& CookedTexture::GetData() const noexcept
+{
+	return data;
+}
+
+const CookedTexture::Stats& CookedTexture::GetStats() const noexcept
+{
+	return stats;
+}
+
+Image CookedTexture::DecodeLevel(size_t index) const
+{
+	const Level& level = levels[index];
+	if (format == Format::RGBA8)
+	{
+		Image image(level.width, level.height);
+		std::memcpy(image.GetPixels(), data.data() + level.offset, level.size);
+		return image;
+	}
+	return Bc::Decode(ToBc(format), data.data() + level.offset, level.size, level.width, level.height);
+}
+
+void CookedTexture::WriteDds(const std::string& path) const
+{
+	DdsHeader header = {};
+	header.size = sizeof(DdsHeader);
+	// CAPS | HEIGHT | WIDTH | PIXELFORMAT | MIPMAPCOUNT, then LINEARSIZE or PITCH
+	header.flags = 0x1u | 0x2u | 0x4u | 0x1000u | 0x20000u | (format == Format::RGBA8 ? 0x8u : 0x80000u);
+	header.height = levels[0].height;
+	header.width = levels[0].width;
+	header.pitchOrLinearSize = uint32_t(format == Format::RGBA8 ? levels[0].width * 4u : levels[0].size);
+	header.mipMapCount = uint32_t(levels.size());
+	header.format.size = sizeof(DdsPixelFormat);
+	// FOURCC "DX10", the real format is in the extension header
+	header.format.flags = 0x4u;
+	header.format.fourCC = 0x30315844u;
+	// TEXTURE, plus COMPLEX | MIPMAP for a chain
+	header.caps = 0x1000u | (levels.size() > 1u ? 0x8u | 0x400000u : 0u);
+	DdsHeaderDx10 extension = {};
+	extension.dxgiFormat = GetDxgiFormat(format, srgb);
+	// D3D10_RESOURCE_DIMENSION_TEXTURE2D
+	extension.resourceDimension = 3u;
+	extension.arraySize = 1u;
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write("DDS ", 4);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(&extension), sizeof(extension));
+	file.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+	if (!file)
+	{
+		throw IMAGE_EXCEPT("Cannot write " + path);
+	}
+}
+
+const char* CookedTexture::GetFormatName(Format format) noexcept
+{
+	switch (format)
+	{
+	case Format::RGBA8:
+		return "RGBA8";
+	case Format::Auto:
+		return "Auto";
+	default:
+		return Bc::GetFormatName(ToBc(format));
+	}
+}
+
+double CookedTexture::GetCompressionRatio() const noexcept
+{
+	size_t rgba = 0u;
+	for (const Level& level : levels)
+	{
+		rgba += size_t(level.width) * level.height * 4u;
+	}
+	return data.empty() ? 1.0 : double(rgba) / double(data.size());
+}
@@ -0,0 +1,523 @@
+#include "Texture/Image.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#define IMAGE_EXCEPT(note) Image::Exception(__LINE__, __FILE__, (note))
+
+namespace
+{
+	// larger sides are not a texture this engine can use
+	constexpr uint32_t maxSide = 16384u;
+
+	uint16_t ReadU16(const uint8_t* p) noexcept
+	{
+		return uint16_t(p[0] | (p[1] << 8));
+	}
+
+	uint32_t ReadU32(const uint8_t* p) noexcept
+	{
+		return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+	}
+
+	int32_t ReadI32(const uint8_t* p) noexcept
+	{
+		return int32_t(ReadU32(p));
+	}
+
+	void CheckSize(int64_t width, int64_t height)
+	{
+		if (width <= 0 || height <= 0 || width > maxSide || height > maxSide)
+		{
+			throw IMAGE_EXCEPT("Image size " + std::to_string(width) + "x" + std::to_string(height) + " is not supported");
+		}
+	}
+
+	bool IsPng(const uint8_t* p, size_t size) noexcept
+	{
+		static constexpr uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+		return size >= 8u && std::memcmp(p, signature, 8u) == 0;
+	}
+
+	// one channel of a BI_BITFIELDS pixel scaled to 8 bits, 255 for an empty mask
+	struct Channel
+	{
+		explicit Channel(uint32_t mask) noexcept
+			:
+			mask(mask)
+		{
+			if (mask != 0u)
+			{
+				while (((mask >> shift) & 1u) == 0u)
+				{
+					shift++;
+				}
+				max = mask >> shift;
+			}
+		}
+		uint8_t operator()(uint32_t pixel) const noexcept
+		{
+			if (mask == 0u)
+			{
+				return 255u;
+			}
+			return uint8_t((uint64_t((pixel & mask) >> shift) * 255u + max / 2u) / max);
+		}
+		uint32_t mask;
+		uint32_t shift = 0u;
+		uint32_t max = 1u;
+	};
+
+	// A device independent bitmap starting at its BITMAPINFOHEADER. Files give
+	// the offset of the pixels, icons store them right after the palette
+	// followed by a 1-bit transparency mask and count that mask in the height.
+	Image DecodeDib(const uint8_t* p, size_t size, size_t bitsOffset, bool icon)
+	{
+		if (size < 40u || ReadU32(p) < 40u || ReadU32(p) > size)
+		{
+			throw IMAGE_EXCEPT("Bitmap header is truncated or too old");
+		}
+		const uint32_t headerSize = ReadU32(p);
+		const int64_t width = ReadI32(p + 4);
+		int64_t height = ReadI32(p + 8);
+		const uint16_t bitCount = ReadU16(p + 14);
+		const uint32_t compression = ReadU32(p + 16);
+		const uint32_t colorsUsed = ReadU32(p + 32);
+		if (icon)
+		{
+			height /= 2;
+		}
+		const bool topDown = height < 0;
+		height = topDown ? -height : height;
+		CheckSize(width, height);
+
+		// BI_RGB, BI_BITFIELDS and BI_ALPHABITFIELDS
+		const bool bitfields = compression == 3u || compression == 6u;
+		if (compression != 0u && !(bitfields && (bitCount == 16u || bitCount == 32u)))
+		{
+			throw IMAGE_EXCEPT("Compressed bitmaps are not supported");
+		}
+		if (bitCount != 1u && bitCount != 4u && bitCount != 8u && bitCount != 16u && bitCount != 24u && bitCount != 32u)
+		{
+			throw IMAGE_EXCEPT("Bitmaps with " + std::to_string(bitCount) + " bits per pixel are not supported");
+		}
+
+		uint32_t masks[4] = { 0u, 0u, 0u, 0u };
+		size_t tablesEnd = headerSize;
+		if (bitfields)
+		{
+			// the masks follow a plain info header and are part of the later ones
+			const size_t maskCount = compression == 6u ? 4u : 3u;
+			if (headerSize == 40u)
+			{
+				tablesEnd += maskCount * 4u;
+			}
+			if (size < 40u + maskCount * 4u)
+			{
+				throw IMAGE_EXCEPT("Bitmap masks are truncated");
+			}
+			for (size_t i = 0; i < maskCount; i++)
+			{
+				masks[i] = ReadU32(p + 40 + i * 4u);
+			}
+			if (headerSize >= 56u)
+			{
+				masks[3] = ReadU32(p + 52);
+			}
+		}
+		else if (bitCount == 16u)
+		{
+			masks[0] = 0x7c00u;
+			masks[1] = 0x03e0u;
+			masks[2] = 0x001fu;
+		}
+		else if (bitCount == 32u)
+		{
+			masks[0] = 0x00ff0000u;
+			masks[1] = 0x0000ff00u;
+			masks[2] = 0x000000ffu;
+			masks[3] = 0xff000000u;
+		}
+
+		std::vector<uint8_t> palette;
+		if (bitCount <= 8u)
+		{
+			const size_t entries = colorsUsed != 0u ? std::min<size_t>(colorsUsed, 256u) : size_t(1u) << bitCount;
+			if (size < tablesEnd + entries * 4u)
+			{
+				throw IMAGE_EXCEPT("Bitmap palette is truncated");
+			}
+			palette.assign(p + tablesEnd, p + tablesEnd + entries * 4u);
+			tablesEnd += entries * 4u;
+		}
+		if (bitsOffset == 0u)
+		{
+			bitsOffset = tablesEnd;
+		}
+		const size_t stride = (size_t(width) * bitCount + 31u) / 32u * 4u;
+		if (bitsOffset > size || (size - bitsOffset) / stride < size_t(height))
+		{
+			throw IMAGE_EXCEPT("Bitmap pixels are truncated");
+		}
+
+		Image image{ uint32_t(width), uint32_t(height) };
+		const Channel channels[4] = { Channel(masks[0]), Channel(masks[1]), Channel(masks[2]), Channel(masks[3]) };
+		bool anyAlpha = false;
+		for (uint32_t y = 0; y < uint32_t(height); y++)
+		{
+			const uint8_t* pRow = p + bitsOffset + stride * (topDown ? y : uint32_t(height) - 1u - y);
+			uint8_t* pOut = image.GetPixel(0u, y);
+			for (uint32_t x = 0; x < uint32_t(width); x++, pOut += 4)
+			{
+				if (bitCount <= 8u)
+				{
+					const uint32_t bit = x * bitCount;
+					const uint32_t index = (pRow[bit / 8u] >> (8u - bitCount - bit % 8u)) & ((1u << bitCount) - 1u);
+					if (index * 4u >= palette.size())
+					{
+						throw IMAGE_EXCEPT("Bitmap palette index is out of range");
+					}
+					pOut[0] = palette[index * 4u + 2u];
+					pOut[1] = palette[index * 4u + 1u];
+					pOut[2] = palette[index * 4u];
+					pOut[3] = 255u;
+				}
+				else if (bitCount == 24u)
+				{
+					pOut[0] = pRow[x * 3u + 2u];
+					pOut[1] = pRow[x * 3u + 1u];
+					pOut[2] = pRow[x * 3u];
+					pOut[3] = 255u;
+				}
+				else
+				{
+					const uint32_t pixel = bitCount == 16u ? ReadU16(pRow + x * 2u) : ReadU32(pRow + x * 4u);
+					pOut[0] = channels[0](pixel);
+					pOut[1] = channels[1](pixel);
+					pOut[2] = channels[2](pixel);
+					pOut[3] = channels[3](pixel);
+					anyAlpha = anyAlpha || (pixel & masks[3]) != 0u;
+				}
+			}
+		}
+
+		const bool hasAlpha = masks[3] != 0u && anyAlpha;
+		if (!hasAlpha)
+		{
+			// writers commonly leave the alpha byte of 32-bit pixels zero
+			for (uint32_t i = 0; i < image.GetWidth() * image.GetHeight(); i++)
+			{
+				image.GetPixels()[i * 4u + 3u] = 255u;
+			}
+		}
+		if (icon && !hasAlpha)
+		{
+			// set bits in the mask are transparent, older icons may leave it out
+			const size_t maskStride = (size_t(width) + 31u) / 32u * 4u;
+			const size_t maskOffset = bitsOffset + stride * size_t(height);
+			if ((size - maskOffset) / maskStride >= size_t(height))
+			{
+				for (uint32_t y = 0; y < uint32_t(height); y++)
+				{
+					const uint8_t* pRow = p + maskOffset + maskStride * (uint32_t(height) - 1u - y);
+					for (uint32_t x = 0; x < uint32_t(width); x++)
+					{
+						if ((pRow[x / 8u] >> (7u - x % 8u)) & 1u)
+						{
+							std::memset(image.GetPixel(x, y), 0, 4u);
+						}
+					}
+				}
+			}
+		}
+		return image;
+	}
+
+	Image DecodeBmp(const uint8_t* p, size_t size)
+	{
+		if (size < 14u)
+		{
+			throw IMAGE_EXCEPT("Bitmap file header is truncated");
+		}
+		const uint32_t bitsOffset = ReadU32(p + 10);
+		if (bitsOffset < 14u)
+		{
+			throw IMAGE_EXCEPT("Bitmap pixel offset is invalid");
+		}
+		return DecodeDib(p + 14, size - 14u, bitsOffset - 14u, false);
+	}
+
+	Image DecodeIco(const uint8_t* p, size_t size)
+	{
+		const uint16_t count = ReadU16(p + 4);
+		if (count == 0u || size < 6u + count * 16u)
+		{
+			throw IMAGE_EXCEPT("Icon directory is truncated");
+		}
+		// the largest image, the deepest one of those
+		size_t best = 0u;
+		uint64_t bestScore = 0u;
+		for (size_t i = 0; i < count; i++)
+		{
+			const uint8_t* pEntry = p + 6u + i * 16u;
+			const uint32_t w = pEntry[0] == 0u ? 256u : pEntry[0];
+			const uint32_t h = pEntry[1] == 0u ? 256u : pEntry[1];
+			const uint64_t score = (uint64_t(w) * h << 8) | std::min<uint32_t>(ReadU16(pEntry + 6), 255u);
+			if (score > bestScore)
+			{
+				best = i;
+				bestScore = score;
+			}
+		}
+		const uint8_t* pEntry = p + 6u + best * 16u;
+		const uint32_t bytes = ReadU32(pEntry + 8);
+		const uint32_t offset = ReadU32(pEntry + 12);
+		if (offset > size || bytes > size - offset)
+		{
+			throw IMAGE_EXCEPT("Icon image lies outside the file");
+		}
+		if (IsPng(p + offset, bytes))
+		{
+			throw IMAGE_EXCEPT("PNG images inside icons are not supported, save the icon with BMP entries");
+		}
+		return DecodeDib(p + offset, bytes, 0u, true);
+	}
+
+	bool IsTga(const uint8_t* p, size_t size) noexcept
+	{
+		if (size < 18u || p[1] > 1u)
+		{
+			return false;
+		}
+		const uint8_t type = p[2];
+		const uint8_t bits = p[16];
+		const bool color = (type == 2u || type == 10u) && (bits == 16u || bits == 24u || bits == 32u);
+		const bool gray = (type == 3u || type == 11u) && bits == 8u;
+		return (color || gray) && ReadU16(p + 12) > 0u && ReadU16(p + 14) > 0u;
+	}
+
+	Image DecodeTga(const uint8_t* p, size_t size)
+	{
+		const uint8_t type = p[2];
+		const uint32_t width = ReadU16(p + 12);
+		const uint32_t height = ReadU16(p + 14);
+		const uint32_t bytesPerPixel = p[16] / 8u;
+		const uint8_t descriptor = p[17];
+		CheckSize(width, height);
+		// an attribute bit count of zero means the fourth byte is not alpha
+		const bool hasAlpha = (bytesPerPixel == 4u && (descriptor & 0x0fu) != 0u) ||
+			(bytesPerPixel == 2u && (descriptor & 0x0fu) != 0u);
+		size_t offset = 18u + p[0];
+		if (p[1] == 1u)
+		{
+			// a palette an unmapped image does not use
+			offset += size_t(ReadU16(p + 5)) * ((p[7] + 7u) / 8u);
+		}
+		if (offset > size)
+		{
+			throw IMAGE_EXCEPT("TGA header is truncated");
+		}
+
+		Image image(width, height);
+		const auto convert = [&](const uint8_t* pIn, uint8_t* pOut)
+		{
+			switch (bytesPerPixel)
+			{
+			case 1u:
+				pOut[0] = pOut[1] = pOut[2] = pIn[0];
+				pOut[3] = 255u;
+				break;
+			case 2u:
+			{
+				const uint16_t v = ReadU16(pIn);
+				pOut[0] = uint8_t(((v >> 10) & 31u) * 255u / 31u);
+				pOut[1] = uint8_t(((v >> 5) & 31u) * 255u / 31u);
+				pOut[2] = uint8_t((v & 31u) * 255u / 31u);
+				pOut[3] = hasAlpha && (v & 0x8000u) == 0u ? 0u : 255u;
+				break;
+			}
+			default:
+				pOut[0] = pIn[2];
+				pOut[1] = pIn[1];
+				pOut[2] = pIn[0];
+				pOut[3] = hasAlpha ? pIn[3] : 255u;
+				break;
+			}
+		};
+		// pixels arrive in file order, mapped to the image by the origin bits
+		const bool topDown = (descriptor & 0x20u) != 0u;
+		const bool rightToLeft = (descriptor & 0x10u) != 0u;
+		const auto target = [&](size_t i)
+		{
+			const uint32_t x = uint32_t(i % width);
+			const uint32_t y = uint32_t(i / width);
+			return image.GetPixel(rightToLeft ? width - 1u - x : x, topDown ? y : height - 1u - y);
+		};
+
+		const size_t count = size_t(width) * height;
+		if (type == 2u || type == 3u)
+		{
+			if ((size - offset) / bytesPerPixel < count)
+			{
+				throw IMAGE_EXCEPT("TGA pixels are truncated");
+			}
+			for (size_t i = 0; i < count; i++)
+			{
+				convert(p + offset + i * bytesPerPixel, target(i));
+			}
+			return image;
+		}
+		// run length packets, which may cross rows
+		size_t i = 0u;
+		while (i < count)
+		{
+			if (offset >= size)
+			{
+				throw IMAGE_EXCEPT("TGA pixels are truncated");
+			}
+			const uint8_t packet = p[offset++];
+			const size_t run = std::min<size_t>((packet & 0x7fu) + 1u, count - i);
+			const bool repeat = (packet & 0x80u) != 0u;
+			const size_t needed = repeat ? bytesPerPixel : run * bytesPerPixel;
+			if (size - offset < needed)
+			{
+				throw IMAGE_EXCEPT("TGA pixels are truncated");
+			}
+			for (size_t j = 0; j < run; j++, i++)
+			{
+				convert(p + offset + (repeat ? 0u : j * bytesPerPixel), target(i));
+			}
+			offset += needed;
+		}
+		return image;
+	}
+}
+
+Image::Image(uint32_t width, uint32_t height)
+	:
+	width(width),
+	height(height),
+	pixels(size_t(width) * height * 4u, 0u)
+{
+	for (size_t i = 3u; i < pixels.size(); i += 4u)
+	{
+		pixels[i] = 255u;
+	}
+}
+
+Image Image::Load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		throw IMAGE_EXCEPT("Cannot read " + path);
+	}
+	std::vector<std::byte> data(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size())))
+	{
+		throw IMAGE_EXCEPT("Cannot read " + path);
+	}
+	try
+	{
+		return Decode(data.data(), data.size());
+	}
+	catch (const Exception& e)
+	{
+		throw IMAGE_EXCEPT(path + ": " + e.GetNote());
+	}
+}
+
+Image Image::Decode(const std::byte* pData, size_t size)
+{
+	const uint8_t* p = reinterpret_cast<const uint8_t*>(pData);
+	if (IsPng(p, size))
+	{
+		throw IMAGE_EXCEPT("PNG images are not supported, convert to TGA or BMP");
+	}
+	if (size >= 2u && p[0] == 'B' && p[1] == 'M')
+	{
+		return DecodeBmp(p, size);
+	}
+	if (size >= 6u && ReadU16(p) == 0u && ReadU16(p + 2) == 1u)
+	{
+		return DecodeIco(p, size);
+	}
+	// TGA has no signature, check the header makes sense
+	if (IsTga(p, size))
+	{
+		return DecodeTga(p, size);
+	}
+	throw IMAGE_EXCEPT("Unknown image format");
+}
+
+uint32_t Image::GetWidth() const noexcept
+{
+	return width;
+}
+
+uint32_t Image::GetHeight() const noexcept
+{
+	return height;
+}
+
+uint8_t* Image::GetPixels() noexcept
+{
+	return pixels.data();
+}
+
+const uint8_t* Image::GetPixels() const noexcept
+{
+	return pixels.data();
+}
+
+uint8_t* Image::GetPixel(uint32_t x, uint32_t y) noexcept
+{
+	return pixels.data() + (size_t(y) * width + x) * 4u;
+}
+
+const uint8_t* Image::GetPixel(uint32_t x, uint32_t y) const noexcept
+{
+	return pixels.data() + (size_t(y) * width + x) * 4u;
+}
+
+bool Image::IsOpaque() const noexcept
+{
+	for (size_t i = 3u; i < pixels.size(); i += 4u)
+	{
+		if (pixels[i] != 255u)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Image exception
+Image::Exception::Exception(int line, const char* file, std::string note) noexcept
+	:
+	OException(line, file),
+	note(std::move(note))
+{
+}
+
+const char* Image::Exception::what() const noexcept
+{
+	std::ostringstream oss;
+	oss << GetType() << std::endl
+		<< "[Note] " << GetNote() << std::endl
+		<< GetOriginString();
+	whatBuffer = oss.str();
+	return whatBuffer.c_str();
+}
+
+const char* Image::Exception::GetType() const noexcept
+{
+	return "O Image Exception";
+}
+
+const std::string& Image::Exception::GetNote() const noexcept
+{
+	return note;
+}
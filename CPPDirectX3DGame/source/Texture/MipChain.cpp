@@ -0,0 +1,257 @@
+#include "Texture/MipChain.h"
+#include "Math/OMath.h"
+#include "Profile/Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	using namespace OMath;
+
+	constexpr float kaiserRadius = 3.0f;
+	constexpr float kaiserAlpha = 4.0f;
+
+	struct Tables
+	{
+		Tables() noexcept
+		{
+			for (int i = 0; i < 256; i++)
+			{
+				const float c = float(i) / 255.0f;
+				toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+			for (int i = 0; i < 4096; i++)
+			{
+				const float l = float(i) / 4095.0f;
+				const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+				toSrgb[i] = uint8_t(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+			}
+		}
+		float toLinear[256];
+		uint8_t toSrgb[4096];
+	};
+
+	const Tables& GetTables() noexcept
+	{
+		static const Tables tables;
+		return tables;
+	}
+
+	// A level as linear floats, one XMFLOAT4 per pixel
+	struct Level
+	{
+		uint32_t width;
+		uint32_t height;
+		std::vector<XMFLOAT4> pixels;
+	};
+
+	// Source pixels and weights for each output pixel along one axis,
+	// already clamped to the edge and normalized
+	struct Taps
+	{
+		std::vector<uint32_t> first;
+		std::vector<uint32_t> index;
+		std::vector<float> weight;
+	};
+
+	double BesselI0(double x) noexcept
+	{
+		double sum = 1.0;
+		double term = 1.0;
+		const double half = x * 0.5;
+		for (int k = 1; k < 32; k++)
+		{
+			term *= half / k;
+			sum += term * term;
+		}
+		return sum;
+	}
+
+	float Kaiser(float x) noexcept
+	{
+		const float t = x / kaiserRadius;
+		if (t <= -1.0f || t >= 1.0f)
+		{
+			return 0.0f;
+		}
+		const float window = float(BesselI0(kaiserAlpha * std::sqrt(1.0 - t * t)) / BesselI0(kaiserAlpha));
+		const float sinc = std::abs(x) < 1e-6f ? 1.0f : std::sin(XM_PI * x) / (XM_PI * x);
+		return sinc * window;
+	}
+
+	Taps MakeTaps(uint32_t source, uint32_t destination, MipChain::Filter filter)
+	{
+		Taps taps;
+		const float scale = float(source) / float(destination);
+		for (uint32_t i = 0; i < destination; i++)
+		{
+			taps.first.push_back(uint32_t(taps.index.size()));
+			const float center = (float(i) + 0.5f) * scale;
+			const auto add = [&](int64_t j, float w)
+			{
+				const uint32_t clamped = uint32_t(std::clamp<int64_t>(j, 0, int64_t(source) - 1));
+				// clamping repeats the edge texel, fold those into one tap
+				if (taps.index.size() > taps.first.back() && taps.index.back() == clamped)
+				{
+					taps.weight.back() += w;
+				}
+				else
+				{
+					taps.index.push_back(clamped);
+					taps.weight.push_back(w);
+				}
+			};
+			if (filter == MipChain::Filter::Box)
+			{
+				const float lo = center - 0.5f * scale;
+				const float hi = center + 0.5f * scale;
+				for (int64_t j = int64_t(std::floor(lo)); float(j) < hi; j++)
+				{
+					const float w = std::min(hi, float(j + 1)) - std::max(lo, float(j));
+					if (w > 0.0f)
+					{
+						add(j, w);
+					}
+				}
+			}
+			else
+			{
+				const float radius = kaiserRadius * scale;
+				for (int64_t j = int64_t(std::floor(center - radius)); float(j) < center + radius; j++)
+				{
+					const float w = Kaiser((float(j) + 0.5f - center) / scale);
+					if (w != 0.0f)
+					{
+						add(j, w);
+					}
+				}
+			}
+			float sum = 0.0f;
+			for (size_t k = taps.first.back(); k < taps.weight.size(); k++)
+			{
+				sum += taps.weight[k];
+			}
+			for (size_t k = taps.first.back(); k < taps.weight.size(); k++)
+			{
+				taps.weight[k] /= sum;
+			}
+		}
+		taps.first.push_back(uint32_t(taps.index.size()));
+		return taps;
+	}
+
+	Level ToLinear(const Image& image, const MipChain::Options& options)
+	{
+		const Tables& tables = GetTables();
+		Level level{ image.GetWidth(), image.GetHeight(), {} };
+		level.pixels.resize(size_t(level.width) * level.height);
+		const uint8_t* p = image.GetPixels();
+		for (XMFLOAT4& out : level.pixels)
+		{
+			const auto decode = [&](uint8_t value)
+			{
+				return options.srgb ? tables.toLinear[value] : float(value) / 255.0f;
+			};
+			const float a = float(p[3]) / 255.0f;
+			const float w = options.alphaWeighted ? a : 1.0f;
+			out = { decode(p[0]) * w, decode(p[1]) * w, decode(p[2]) * w, a };
+			p += 4;
+		}
+		return level;
+	}
+
+	Image ToImage(const Level& level, const MipChain::Options& options)
+	{
+		const Tables& tables = GetTables();
+		Image image(level.width, level.height);
+		uint8_t* p = image.GetPixels();
+		for (const XMFLOAT4& in : level.pixels)
+		{
+			const float a = std::clamp(in.w, 0.0f, 1.0f);
+			const float scale = options.alphaWeighted ? (a > 0.0f ? 1.0f / a : 0.0f) : 1.0f;
+			const auto encode = [&](float value)
+			{
+				value = std::clamp(value * scale, 0.0f, 1.0f);
+				return options.srgb ? tables.toSrgb[int(value * 4095.0f + 0.5f)] : uint8_t(value * 255.0f + 0.5f);
+			};
+			p[0] = encode(in.x);
+			p[1] = encode(in.y);
+			p[2] = encode(in.z);
+			p[3] = uint8_t(a * 255.0f + 0.5f);
+			p += 4;
+		}
+		return image;
+	}
+
+	// separable: rows to the new width first, then the columns of that
+	Level Resample(const Level& source, uint32_t width, uint32_t height, MipChain::Filter filter)
+	{
+		const Taps horizontal = MakeTaps(source.width, width, filter);
+		const Taps vertical = MakeTaps(source.height, height, filter);
+		std::vector<XMFLOAT4> rows(size_t(width) * source.height);
+		for (uint32_t y = 0; y < source.height; y++)
+		{
+			const XMFLOAT4* pIn = source.pixels.data() + size_t(y) * source.width;
+			XMFLOAT4* pOut = rows.data() + size_t(y) * width;
+			for (uint32_t x = 0; x < width; x++)
+			{
+				XMVECTOR sum = XMVectorZero();
+				for (uint32_t k = horizontal.first[x]; k < horizontal.first[x + 1u]; k++)
+				{
+					sum = XMVectorMultiplyAdd(XMLoadFloat4(&pIn[horizontal.index[k]]), XMVectorReplicate(horizontal.weight[k]), sum);
+				}
+				XMStoreFloat4(&pOut[x], sum);
+			}
+		}
+		Level level{ width, height, std::vector<XMFLOAT4>(size_t(width) * height, XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f)) };
+		for (uint32_t y = 0; y < height; y++)
+		{
+			XMFLOAT4* pOut = level.pixels.data() + size_t(y) * width;
+			// whole rows at a time keeps the reads sequential
+			for (uint32_t k = vertical.first[y]; k < vertical.first[y + 1u]; k++)
+			{
+				const XMFLOAT4* pIn = rows.data() + size_t(vertical.index[k]) * width;
+				const XMVECTOR w = XMVectorReplicate(vertical.weight[k]);
+				for (uint32_t x = 0; x < width; x++)
+				{
+					XMStoreFloat4(&pOut[x], XMVectorMultiplyAdd(XMLoadFloat4(&pIn[x]), w, XMLoadFloat4(&pOut[x])));
+				}
+			}
+		}
+		return level;
+	}
+}
+
+uint32_t MipChain::GetLevelCount(uint32_t width, uint32_t height) noexcept
+{
+	uint32_t levels = 1u;
+	for (uint32_t side = std::max(width, height); side > 1u; side /= 2u)
+	{
+		levels++;
+	}
+	return levels;
+}
+
+std::vector<Image> MipChain::Build(const Image& image, const Options& options)
+{
+	O_PROFILE_FUNCTION();
+	uint32_t count = GetLevelCount(image.GetWidth(), image.GetHeight());
+	if (options.maxLevels > 0u)
+	{
+		count = std::min(count, options.maxLevels);
+	}
+	std::vector<Image> levels;
+	levels.reserve(count);
+	levels.push_back(image);
+	if (count == 1u)
+	{
+		return levels;
+	}
+	Level level = ToLinear(image, options);
+	for (uint32_t i = 1; i < count; i++)
+	{
+		level = Resample(level, std::max(level.width / 2u, 1u), std::max(level.height / 2u, 1u), options.filter);
+		levels.push_back(ToImage(level, options));
+	}
+	return levels;
+}
@@ -0,0 +1,163 @@
+#include "Time/OClock.h"
+#include <algorithm>
+#include <cmath>
+
+OClock::OClock(double stepSeconds, unsigned int maxStepsPerFrame) noexcept
+	:
+	step(std::max(ToTicks(stepSeconds), Ticks(1))),
+	maxStepsPerFrame(std::max(maxStepsPerFrame, 1u))
+{
+}
+
+unsigned int OClock::Advance() noexcept
+{
+	// always mark so resuming or leaving deterministic mode does not see a huge frame
+	const Ticks real = timer.MarkTicks();
+	const Ticks elapsed = deterministic ? syntheticFrame : real;
+	realTicks += elapsed;
+	realFrameTicks = elapsed;
+	if (paused)
+	{
+		frameTicks = 0;
+		return 0u;
+	}
+
+	if (timeScale == 1.0)
+	{
+		frameTicks = elapsed;
+	}
+	else
+	{
+		const double scaled = double(elapsed) * timeScale + scaleCarry;
+		frameTicks = Ticks(std::floor(scaled));
+		scaleCarry = scaled - double(frameTicks);
+	}
+	accumulator += frameTicks;
+
+	Ticks steps = accumulator / step;
+	if (steps > Ticks(maxStepsPerFrame))
+	{
+		// can't catch up, drop whole steps but keep the phase for interpolation
+		droppedTicks += (steps - maxStepsPerFrame) * step;
+		steps = maxStepsPerFrame;
+	}
+	accumulator -= steps * step;
+	accumulator %= step;
+	simTicks += steps * step;
+	stepIndex += uint64_t(steps);
+	return static_cast<unsigned int>(steps);
+}
+
+float OClock::GetAlpha() const noexcept
+{
+	return float(double(accumulator) / double(step));
+}
+
+float OClock::GetFrameSeconds() const noexcept
+{
+	return float(double(frameTicks) / double(ticksPerSecond));
+}
+
+float OClock::GetRealFrameSeconds() const noexcept
+{
+	return float(double(realFrameTicks) / double(ticksPerSecond));
+}
+
+float OClock::GetStepSeconds() const noexcept
+{
+	return float(double(step) / double(ticksPerSecond));
+}
+
+OClock::Ticks OClock::GetStepTicks() const noexcept
+{
+	return step;
+}
+
+OClock::Ticks OClock::GetSimTicks() const noexcept
+{
+	return simTicks;
+}
+
+double OClock::GetSimSeconds() const noexcept
+{
+	return double(simTicks) / double(ticksPerSecond);
+}
+
+double OClock::GetInterpolatedSeconds() const noexcept
+{
+	// previous state is one step behind the current one
+	return double(std::max(simTicks - step + accumulator, Ticks(0))) / double(ticksPerSecond);
+}
+
+uint64_t OClock::GetStepIndex() const noexcept
+{
+	return stepIndex;
+}
+
+OClock::Ticks OClock::GetRealTicks() const noexcept
+{
+	return realTicks;
+}
+
+OClock::Ticks OClock::GetDroppedTicks() const noexcept
+{
+	return droppedTicks;
+}
+
+void OClock::SetStep(double stepSeconds) noexcept
+{
+	step = std::max(ToTicks(stepSeconds), Ticks(1));
+	accumulator %= step;
+}
+
+void OClock::SetMaxStepsPerFrame(unsigned int maxSteps) noexcept
+{
+	maxStepsPerFrame = std::max(maxSteps, 1u);
+}
+
+void OClock::SetTimeScale(double scale) noexcept
+{
+	timeScale = std::max(scale, 0.0);
+	scaleCarry = 0.0;
+}
+
+double OClock::GetTimeScale() const noexcept
+{
+	return timeScale;
+}
+
+void OClock::Pause() noexcept
+{
+	paused = true;
+}
+
+void OClock::Resume() noexcept
+{
+	paused = false;
+}
+
+bool OClock::IsPaused() const noexcept
+{
+	return paused;
+}
+
+void OClock::EnableDeterministic(double frameSeconds) noexcept
+{
+	deterministic = true;
+	syntheticFrame = std::max(ToTicks(frameSeconds), Ticks(0));
+}
+
+void OClock::DisableDeterministic() noexcept
+{
+	deterministic = false;
+}
+
+bool OClock::IsDeterministic() const noexcept
+{
+	return deterministic;
+}
+
+OClock::Ticks OClock::ToTicks(double seconds) noexcept
+{
+	return Ticks(std::llround(seconds * double(ticksPerSecond)));
+}
@@ -7,6 +7,11 @@ OTimer::OTimer() noexcept
 	last = steady_clock::now();
 }
 
+OTimer::Ticks OTimer::Now() noexcept
+{
+	return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
 float OTimer::Mark() noexcept
 {
 	const auto old = last;
@@ -18,4 +23,16 @@ float OTimer::Mark() noexcept
 float OTimer::Peek() const noexcept
 {
 	return duration<float>(steady_clock::now() - last).count();
-}
\ No newline at end of file
+}
+
+OTimer::Ticks OTimer::MarkTicks() noexcept
+{
+	const auto old = last;
+	last = steady_clock::now();
+	return duration_cast<nanoseconds>(last - old).count();
+}
+
+OTimer::Ticks OTimer::PeekTicks() const noexcept
+{
+	return duration_cast<nanoseconds>(steady_clock::now() - last).count();
+}
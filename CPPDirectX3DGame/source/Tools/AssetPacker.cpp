@@ -0,0 +1,105 @@
+// Packs a directory tree into a .pak archive for PackArchive. Entries are
+// named by their path relative to the input directory with '/' separators.
+//   AssetPacker [--store] [--align N] [--verify] <output.pak> <input directory>
+#include "Asset/PackArchive.h"
+#include "Asset/PackWriter.h"
+#include "Time/OTimer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		PackWriter::Options options;
+		bool verify = false;
+		std::vector<const char*> positional;
+		for (int i = 1; i < argc; i++)
+		{
+			if (std::strcmp(argv[i], "--store") == 0)
+			{
+				options.compress = false;
+			}
+			else if (std::strcmp(argv[i], "--align") == 0 && i + 1 < argc)
+			{
+				options.alignment = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+			}
+			else if (std::strcmp(argv[i], "--verify") == 0)
+			{
+				verify = true;
+			}
+			else
+			{
+				positional.push_back(argv[i]);
+			}
+		}
+		if (positional.size() != 2u)
+		{
+			std::fprintf(stderr, "usage: %s [--store] [--align N] [--verify] <output.pak> <input directory>\n", argv[0]);
+			return 2;
+		}
+		const std::string output = positional[0];
+		const fs::path input = positional[1];
+
+		OTimer timer;
+		// sorted so the same tree always gives the same archive
+		std::vector<fs::path> files;
+		for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input))
+		{
+			if (entry.is_regular_file())
+			{
+				files.push_back(entry.path());
+			}
+		}
+		std::sort(files.begin(), files.end());
+		PackWriter writer(options);
+		for (const fs::path& path : files)
+		{
+			writer.AddFile(fs::relative(path, input).generic_string(), path.string());
+		}
+		const PackWriter::Stats stats = writer.Write(output);
+		const float seconds = timer.Mark();
+		std::printf("%s: %zu entries (%zu compressed), %llu bytes stored as %llu, file %llu bytes, %.3fs\n",
+			output.c_str(), stats.entries, stats.compressed,
+			static_cast<unsigned long long>(stats.bytes), static_cast<unsigned long long>(stats.storedBytes),
+			static_cast<unsigned long long>(stats.fileSize), seconds);
+
+		if (verify)
+		{
+			const PackArchive archive(output);
+			size_t bad = 0u;
+			for (size_t i = 0; i < archive.GetEntryCount(); i++)
+			{
+				if (!archive.Verify(i))
+				{
+					std::fprintf(stderr, "%.*s does not match its hash\n",
+						int(archive.GetEntry(i).name.size()), archive.GetEntry(i).name.data());
+					bad++;
+				}
+			}
+			if (bad > 0u)
+			{
+				return 1;
+			}
+			std::printf("verified %zu entries\n", archive.GetEntryCount());
+		}
+		return 0;
+	}
+	catch (const OException& e)
+	{
+		std::fprintf(stderr, "%s\n%s\n", e.GetType(), e.what());
+	}
+	catch (const std::exception& e)
+	{
+		std::fprintf(stderr, "Standard Exception\n%s\n", e.what());
+	}
+	return -1;
+}
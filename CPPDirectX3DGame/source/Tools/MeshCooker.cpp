@@ -0,0 +1,90 @@
+// Cooks an OBJ or glTF model into a mesh blob: welded, reordered for the
+// vertex cache, overdraw and vertex fetch, and packed into the compact
+// quantized vertex format unless asked otherwise. Prints the vertex cache,
+// fetch and overdraw figures before and after, and the bytes per vertex.
+//   MeshCooker [--format compact|float] [--cache forsyth|tipsify]
+//              [--no-overdraw] [--no-optimize] <output> <input .obj/.gltf/.glb>
+#include "Mesh/MeshBlob.h"
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		MeshBlob::Options options;
+		std::vector<const char*> positional;
+		for (int i = 1; i < argc; i++)
+		{
+			const bool hasValue = i + 1 < argc;
+			if (std::strcmp(argv[i], "--format") == 0 && hasValue)
+			{
+				const std::string name = argv[++i];
+				if (name == "compact")
+				{
+					options.format = MeshBlob::Format::Compact;
+				}
+				else if (name == "float")
+				{
+					options.format = MeshBlob::Format::Float;
+				}
+				else
+				{
+					std::fprintf(stderr, "unknown format '%s'\n", name.c_str());
+					return 2;
+				}
+			}
+			else if (std::strcmp(argv[i], "--cache") == 0 && hasValue)
+			{
+				options.cache = std::strcmp(argv[++i], "tipsify") == 0 ? MeshOptimize::CacheAlgorithm::Tipsify : MeshOptimize::CacheAlgorithm::Forsyth;
+			}
+			else if (std::strcmp(argv[i], "--no-overdraw") == 0)
+			{
+				options.overdraw = false;
+			}
+			else if (std::strcmp(argv[i], "--no-optimize") == 0)
+			{
+				options.optimize = false;
+			}
+			else
+			{
+				positional.push_back(argv[i]);
+			}
+		}
+		if (positional.size() != 2u)
+		{
+			std::fprintf(stderr,
+				"usage: %s [--format compact|float] [--cache forsyth|tipsify] [--no-overdraw] [--no-optimize] <output> <input .obj/.gltf/.glb>\n",
+				argv[0]);
+			return 2;
+		}
+		const std::string output = positional[0];
+		const Mesh mesh = Mesh::Load(positional[1]);
+		const MeshBlob blob = MeshBlob::Cook(mesh, options);
+		blob.Write(output);
+
+		const MeshBlob::Stats& stats = blob.GetStats();
+		std::printf("%s: %u vertices, %zu triangles, %s format, %u byte vertices, %s indices, %.2f bytes per vertex with indices (%zu bytes), optimized in %.3fms\n",
+			output.c_str(), blob.GetVertexCount(), mesh.GetTriangleCount(), MeshBlob::GetFormatName(blob.GetFormat()),
+			blob.GetStride(), blob.GetIndexFormat() == 57u ? "16-bit" : "32-bit", blob.GetBytesPerVertex(), blob.GetData().size(),
+			stats.optimizeSeconds * 1000.0);
+		std::printf("  vertex cache: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+			stats.cacheBefore.acmr, stats.cacheAfter.acmr, stats.cacheBefore.atvr, stats.cacheAfter.atvr);
+		std::printf("  vertex fetch: overfetch %.3f -> %.3f\n", stats.fetchBefore.overfetch, stats.fetchAfter.overfetch);
+		std::printf("  overdraw:     %.3f -> %.3f\n", stats.overdrawBefore.overdraw, stats.overdrawAfter.overdraw);
+		std::printf("  max position error %g\n", stats.maxPositionError);
+		return 0;
+	}
+	catch (const OException& e)
+	{
+		std::fprintf(stderr, "%s\n%s\n", e.GetType(), e.what());
+	}
+	catch (const std::exception& e)
+	{
+		std::fprintf(stderr, "Standard Exception\n%s\n", e.what());
+	}
+	return -1;
+}
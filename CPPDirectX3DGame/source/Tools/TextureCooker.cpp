@@ -0,0 +1,130 @@
+// Cooks a source image into a .dds texture with a full mip chain, block
+// compressed unless asked otherwise. --psnr decodes every level again and
+// prints how far it is from the uncompressed mip.
+//   TextureCooker [--format auto|bc1|bc3|bc7|rgba8] [--filter kaiser|box] [--linear]
+//                 [--levels N] [--threads N] [--psnr] <output.dds> <input image>
+#include "Job/JobSystem.h"
+#include "Texture/CookedTexture.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		CookedTexture::Options options;
+		// 0 for one per core
+		unsigned int threads = 0u;
+		bool psnr = false;
+		std::vector<const char*> positional;
+		for (int i = 1; i < argc; i++)
+		{
+			const bool hasValue = i + 1 < argc;
+			if (std::strcmp(argv[i], "--format") == 0 && hasValue)
+			{
+				const std::string name = argv[++i];
+				if (name == "auto")
+				{
+					options.format = CookedTexture::Format::Auto;
+				}
+				else if (name == "bc1")
+				{
+					options.format = CookedTexture::Format::BC1;
+				}
+				else if (name == "bc3")
+				{
+					options.format = CookedTexture::Format::BC3;
+				}
+				else if (name == "bc7")
+				{
+					options.format = CookedTexture::Format::BC7;
+				}
+				else if (name == "rgba8")
+				{
+					options.format = CookedTexture::Format::RGBA8;
+				}
+				else
+				{
+					std::fprintf(stderr, "unknown format '%s'\n", name.c_str());
+					return 2;
+				}
+			}
+			else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+			{
+				options.mips.filter = std::strcmp(argv[++i], "box") == 0 ? MipChain::Filter::Box : MipChain::Filter::Kaiser;
+			}
+			else if (std::strcmp(argv[i], "--linear") == 0)
+			{
+				options.mips.srgb = false;
+			}
+			else if (std::strcmp(argv[i], "--levels") == 0 && hasValue)
+			{
+				options.mips.maxLevels = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+			}
+			else if (std::strcmp(argv[i], "--threads") == 0 && hasValue)
+			{
+				threads = unsigned(std::strtoul(argv[++i], nullptr, 10));
+			}
+			else if (std::strcmp(argv[i], "--psnr") == 0)
+			{
+				psnr = true;
+			}
+			else
+			{
+				positional.push_back(argv[i]);
+			}
+		}
+		if (positional.size() != 2u)
+		{
+			std::fprintf(stderr,
+				"usage: %s [--format auto|bc1|bc3|bc7|rgba8] [--filter kaiser|box] [--linear] [--levels N] [--threads N] [--psnr] <output.dds> <input image>\n",
+				argv[0]);
+			return 2;
+		}
+		const std::string output = positional[0];
+		const Image image = Image::Load(positional[1]);
+		JobSystem jobs(threads);
+		options.pJobs = &jobs;
+		const CookedTexture texture = CookedTexture::Cook(image, options);
+		texture.WriteDds(output);
+
+		const CookedTexture::Stats& stats = texture.GetStats();
+		// over every level, the rate the encoder ran at
+		double pixels = 0.0;
+		for (size_t i = 0; i < texture.GetLevelCount(); i++)
+		{
+			pixels += double(texture.GetLevel(i).width) * texture.GetLevel(i).height;
+		}
+		std::printf("%s: %ux%u %s%s, %zu levels, %zu bytes (%.1fx smaller than RGBA8), mips %.3fms, encode %.3fms on %u threads (%.1f MPix/s)\n",
+			output.c_str(), image.GetWidth(), image.GetHeight(), CookedTexture::GetFormatName(texture.GetFormat()),
+			texture.IsSrgb() ? " sRGB" : "", texture.GetLevelCount(), texture.GetData().size(), texture.GetCompressionRatio(),
+			stats.mipSeconds * 1000.0, stats.encodeSeconds * 1000.0, stats.threads,
+			stats.encodeSeconds > 0.0 ? pixels / stats.encodeSeconds / 1e6 : 0.0);
+
+		if (psnr)
+		{
+			const std::vector<Image> mips = MipChain::Build(image, options.mips);
+			const bool alpha = texture.GetFormat() != CookedTexture::Format::BC1;
+			for (size_t i = 0; i < texture.GetLevelCount(); i++)
+			{
+				const CookedTexture::Level& level = texture.GetLevel(i);
+				std::printf("  level %zu %ux%u: PSNR %.2f dB\n", i, level.width, level.height,
+					Bc::ComputePsnr(mips[i], texture.DecodeLevel(i), alpha));
+			}
+		}
+		return 0;
+	}
+	catch (const OException& e)
+	{
+		std::fprintf(stderr, "%s\n%s\n", e.GetType(), e.what());
+	}
+	catch (const std::exception& e)
+	{
+		std::fprintf(stderr, "Standard Exception\n%s\n", e.what());
+	}
+	return -1;
+}
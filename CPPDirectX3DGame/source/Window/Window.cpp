@@ -3,6 +3,7 @@
 #include "Window/WindowThrowMacros.h"
 #include "Exception/OException.h"
 #include "Resource/resource.h"
+#include "Profile/Profiler.h"
 #include <sstream>
 //#include "imgui/imgui_impl_win32.h"
 
@@ -93,9 +94,37 @@ Window::~Window() {
 }
 
 void Window::SetTitle(const std::string &title) {
-	if (SetWindowText(hWnd, title.c_str()) == 0) {
+	SetTitle(title.c_str());
+}
+
+void Window::SetTitle(const char* title) {
+	if (SetWindowText(hWnd, title) == 0) {
+		throw O_LAST_EXCEPT();
+	}
+}
+
+void Window::Resize(int width, int height) {
+	RECT wr;
+	wr.left = 0;
+	wr.right = width;
+	wr.top = 0;
+	wr.bottom = height;
+	if (AdjustWindowRect(&wr, WS_CAPTION | WS_MINIMIZEBOX | WS_SYSMENU, FALSE) == 0) {
+		throw O_LAST_EXCEPT();
+	}
+	if (SetWindowPos(hWnd, nullptr, 0, 0, wr.right - wr.left, wr.bottom - wr.top, SWP_NOMOVE | SWP_NOZORDER) == 0) {
 		throw O_LAST_EXCEPT();
 	}
+	this->width = width;
+	this->height = height;
+}
+
+int Window::GetWidth() const noexcept {
+	return width;
+}
+
+int Window::GetHeight() const noexcept {
+	return height;
 }
 
 void Window::EnableCursor() noexcept {
@@ -118,6 +147,7 @@ bool Window::CursorEnabled() const noexcept {
 
 std::optional<int> Window::ProcessMessages() noexcept
 {
+	O_PROFILE_FUNCTION();
 	MSG msg;
 	// while queue has messages, remove and dispatch them (but do not block on empty queue)
 	while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
@@ -392,37 +422,20 @@ LRESULT Window::HandleMsg(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) noe
 			{
 				break;
 			}
-			UINT size = NULL;
-			// first get the size of the input data
-			if (GetRawInputData(
-				reinterpret_cast<HRAWINPUT>(lParam),
-				RID_INPUT,
-				nullptr,
-				&size,
-				sizeof(RAWINPUTHEADER)) == -1)
-			{
-				// bail msg processing if error
-				break;
-			}
-			rawBuffer.resize(size);
-			// read in the input data
+			// mouse reports always fit a RAWINPUT, so one call into fixed storage
+			UINT size = sizeof(RAWINPUT);
 			if (GetRawInputData(
 				reinterpret_cast<HRAWINPUT>(lParam),
 				RID_INPUT,
 				rawBuffer.data(),
 				&size,
-				sizeof(RAWINPUTHEADER)) != size)
+				sizeof(RAWINPUTHEADER)) != UINT(-1))
 			{
-				// bail msg processing if error
-				break;
-			}
-			// process the raw input data
-			auto& ri = reinterpret_cast<const RAWINPUT&>(*rawBuffer.data());
-			if (ri.header.dwType == RIM_TYPEMOUSE &&
-				(ri.data.mouse.lLastX != 0 || ri.data.mouse.lLastY != 0))
-			{
-				mouse.OnRawDelta(ri.data.mouse.lLastX, ri.data.mouse.lLastY);
+				ProcessRawInput(rawBuffer[0]);
 			}
+			// high polling rate mice queue many more reports behind this one,
+			// take them all now instead of one message each
+			ReadRawInputBatch();
 			break;
 		}
 		/* End Raw Mouse Messages */
@@ -431,6 +444,34 @@ LRESULT Window::HandleMsg(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) noe
 	return DefWindowProc(hWnd, msg, wParam, lParam);
 }
 
+void Window::ReadRawInputBatch() noexcept
+{
+	while (true)
+	{
+		UINT size = UINT(sizeof(RAWINPUT) * rawBuffer.size());
+		const UINT count = GetRawInputBuffer(rawBuffer.data(), &size, sizeof(RAWINPUTHEADER));
+		if (count == 0u || count == UINT(-1))
+		{
+			break;
+		}
+		const RAWINPUT* pInput = rawBuffer.data();
+		for (UINT i = 0; i < count; i++)
+		{
+			ProcessRawInput(*pInput);
+			pInput = NEXTRAWINPUTBLOCK(pInput);
+		}
+	}
+}
+
+void Window::ProcessRawInput(const RAWINPUT& ri) noexcept
+{
+	if (ri.header.dwType == RIM_TYPEMOUSE &&
+		(ri.data.mouse.lLastX != 0 || ri.data.mouse.lLastY != 0))
+	{
+		mouse.OnRawDelta(ri.data.mouse.lLastX, ri.data.mouse.lLastY);
+	}
+}
+
 // Window Exception
 std::string Window::Exception::TranslateErrorCode(HRESULT hr) noexcept {
 	char *pMsgBuf = nullptr;